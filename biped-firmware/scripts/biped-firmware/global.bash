@@ -103,14 +103,6 @@ eigen_version_patch=3
 eigen_version="$eigen_version_major.$eigen_version_minor.$eigen_version_patch"
 eigen_author="hideakitai"
 
-# Declare Kalman Filter Library variables
-kalman_filter_library_name="Kalman_Filter_Library"
-kalman_filter_library_version_major=1
-kalman_filter_library_version_minor=0
-kalman_filter_library_version_patch=2
-kalman_filter_library_version="$kalman_filter_library_version_major.$kalman_filter_library_version_minor.$kalman_filter_library_version_patch"
-kalman_filter_library_author="TKJElectronics"
-
 # Declare MCP23018 variables
 mcp23018_name="MCP23018"
 mcp23018_version="cc0b968e3deea9c68adecfd1ce99a14d29f3d486"
@@ -187,22 +187,6 @@ function install_mcp23018()
 	assert_warn $? "Failed to remove temporary directory"
 }
 
-function configure_kalman_filter_library()
-{
-	# Verify installation
-	if [ ! -d "$project_dir_libraries/$kalman_filter_library_name" ]
-	then
-		echo "[ERROR]: \"$kalman_filter_library_name\" installation not found. Quit."
-		exit 1
-	fi
-
-	# Configure Kalman Filter Library
-	echo "[INFO]: Configuring \"$kalman_filter_library_name $kalman_filter_library_version\"..."
-	cd "$project_dir_libraries/$kalman_filter_library_name"
-	git apply -v "$project_dir_configs/libraries/$kalman_filter_library_name/double.patch"
-	assert_error $? "Failed to configure \"$kalman_filter_library_name $kalman_filter_library_version\""
-}
-
 function configure_stm32duino_vl53l4cx()
 {
 	# Verify installation
@@ -244,9 +228,6 @@ function install_libraries()
 	# Install Eigen
 	install_arduino_library "$eigen_name" "$eigen_version" "$eigen_author"
 
-	# Install Kalman Filter Library
-	install_arduino_library "$kalman_filter_library_name" "$kalman_filter_library_version" "$kalman_filter_library_author" "configure_kalman_filter_library"
-
 	# Install MCP23018
 	install_mcp23018
 
@@ -77,23 +77,23 @@ ActuationCommand
 Actuator::getActuationCommand() const
 {
     /*
-     *  Return the class member actuation command struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Read the actuation command struct snapshot from the class
+     *  member actuation command struct sequence lock and return
+     *  the struct.
      */
-    return actuation_command_;
+    return seqlock_actuation_command_.read();
 }
 
 void
 Actuator::actuate(const ActuationCommand& actuation_command)
 {
     /*
-     *  Store the given actuation command struct in the function
-     *  parameter to the class member actuation command struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Publish the given actuation command struct in the function
+     *  parameter to the class member actuation command struct
+     *  sequence lock. The actuation is performed only by the
+     *  real-time task, the single writer of the sequence lock.
      */
-	actuation_command_ = actuation_command;
+	seqlock_actuation_command_.write(actuation_command);
 
     /*
      *  Using the I/O expander digitalWritePort functions, write
@@ -104,7 +104,7 @@ Actuator::actuate(const ActuationCommand& actuation_command)
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
-	io_expander_a_->digitalWritePortB(IOExpanderAPortBPin::motor_enable, actuation_command_.motor_enable);
+	io_expander_a_->digitalWritePortB(IOExpanderAPortBPin::motor_enable, actuation_command.motor_enable);
 
     /*
      *  Using the I/O expander digitalWritePort functions, write
@@ -118,8 +118,8 @@ Actuator::actuate(const ActuationCommand& actuation_command)
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
-	io_expander_a_->digitalWritePortA(IOExpanderAPortAPin::motor_left_direction, !actuation_command_.motor_left_forward);
-	io_expander_a_->digitalWritePortA(IOExpanderAPortAPin::motor_right_direction, actuation_command_.motor_right_forward);
+	io_expander_a_->digitalWritePortA(IOExpanderAPortAPin::motor_left_direction, !actuation_command.motor_left_forward);
+	io_expander_a_->digitalWritePortA(IOExpanderAPortAPin::motor_right_direction, actuation_command.motor_right_forward);
 
     /*
      *  Using the clamp function from the math header, clamp
@@ -150,8 +150,8 @@ Actuator::actuate(const ActuationCommand& actuation_command)
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
-	double clamped_motor_left_pwm = clamp(actuation_command_.motor_left_pwm, static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
-	double clamped_motor_right_pwm = clamp(actuation_command_.motor_right_pwm, static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
+	double clamped_motor_left_pwm = clamp(actuation_command.motor_left_pwm, static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
+	double clamped_motor_right_pwm = clamp(actuation_command.motor_right_pwm, static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
 
 	analogWrite(ESP32Pin::motor_left_pwm, static_cast<int>(clamped_motor_left_pwm));
 	analogWrite(ESP32Pin::motor_right_pwm, static_cast<int>(clamped_motor_right_pwm));
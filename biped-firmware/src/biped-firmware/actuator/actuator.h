@@ -17,6 +17,7 @@
  *  Project headers.
  */
 #include "common/type.h"
+#include "utility/seqlock.hpp"
 
 /*
  *  Biped namespace.
@@ -51,7 +52,8 @@ public:
      *  @return Actuation command struct.
      *  @brief  Get the class member actuation command struct.
      *
-     *  This function returns the class member actuation command struct.
+     *  This function returns a snapshot of the class member actuation
+     *  command struct, as published by the last actuation.
      */
     ActuationCommand
     getActuationCommand() const;
@@ -69,7 +71,7 @@ public:
 
 private:
 
-    ActuationCommand actuation_command_;    //!< Actuation command struct.
+    Seqlock<ActuationCommand> seqlock_actuation_command_;   //!< Actuation command struct sequence lock.
 };
 }   // namespace firmware
 }   // namespace biped
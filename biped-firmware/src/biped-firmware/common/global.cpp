@@ -7,6 +7,11 @@
  *  This file initializes the global variables.
  */
 
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+
 /*
  *  Project headers.
  */
@@ -27,6 +32,7 @@ namespace firmware
  */
 std::shared_ptr<Actuator> actuator_ = nullptr;
 std::shared_ptr<Camera> camera_ = nullptr;
+std::shared_ptr<CameraRateController> camera_rate_controller_ = nullptr;
 std::shared_ptr<Controller> controller_ = nullptr;
 std::shared_ptr<IOExpander> io_expander_a_ = nullptr;
 std::shared_ptr<IOExpander> io_expander_b_ = nullptr;
@@ -48,6 +54,9 @@ std::unique_lock<std::mutex> lock_wire_ = std::unique_lock<std::mutex>(mutex_wir
 /*
  *  Initialize task handles to null pointers.
  */
+#ifdef ARDUINO
+TaskHandle_t task_handle_camera_capture_ = nullptr;
+TaskHandle_t task_handle_camera_encode_ = nullptr;
 TaskHandle_t task_handle_io_expander_a_interrupt_service_ = nullptr;
 TaskHandle_t task_handle_io_expander_b_interrupt_service_ = nullptr;
 TaskHandle_t task_handle_network_ = nullptr;
@@ -57,11 +66,76 @@ TaskHandle_t task_handle_udp_write_biped_message_ = nullptr;
 TaskHandle_t task_handle_udp_write_camera_ = nullptr;
 
 /*
- *  Initialize timing variables to 0.
+ *  Initialize the camera pipeline shared pointer to a null pointer.
+ */
+std::shared_ptr<CameraPipeline<Camera, FreeRTOSQueue, CameraParameter::frame_buffer_count>> camera_pipeline_ = nullptr;
+#endif
+
+/*
+ *  Initialize timing variables to 0, and the real-time task
+ *  scheduler with the Arduino microsecond clock.
  */
 unsigned long execution_time_real_time_task_ = 0;
 unsigned long interval_real_time_task_ = 0;
-double timer_domain_ = 0;
+RateMonotonicScheduler<SchedulerParameter::job_count, SchedulerParameter::group_count,
+        SchedulerParameter::histogram_bin_count, SchedulerParameter::histogram_bin_width> scheduler_real_time_task_(
+        &micros);
+
+/*
+ *  Initialize the real-time task deadline miss count to 0 and
+ *  the timing histograms with their ranges.
+ */
+std::atomic<unsigned long> deadline_miss_real_time_task_(0);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_actuate_(0,
+        TelemetryParameter::histogram_bin_width_stage);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_control_(0,
+        TelemetryParameter::histogram_bin_width_stage);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_real_time_task_(
+        0, TelemetryParameter::histogram_bin_width_execution_time);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_sense_fast_(0,
+        TelemetryParameter::histogram_bin_width_stage);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_sense_slow_(0,
+        TelemetryParameter::histogram_bin_width_stage);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_interval_real_time_task_(
+        TelemetryParameter::histogram_lower_bound_interval,
+        TelemetryParameter::histogram_bin_width_interval);
+
+/*
+ *  Initialize the camera frame counts to 0 and the camera pipeline
+ *  timing histograms with their ranges.
+ */
+std::atomic<unsigned long> frame_count_camera_(0);
+std::atomic<unsigned long> frame_count_dropped_camera_(0);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_capture_(0,
+        TelemetryParameter::histogram_bin_width_camera);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_encode_(0,
+        TelemetryParameter::histogram_bin_width_camera);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_transmit_(0,
+        TelemetryParameter::histogram_bin_width_camera);
+TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_latency_camera_(0,
+        TelemetryParameter::histogram_bin_width_camera);
+
+/*
+ *  Initialize the telemetry sample ring buffer to be empty.
+ */
+RingBuffer<TelemetrySample, TelemetryParameter::ring_buffer_capacity> ring_buffer_telemetry_sample_;
+
+/*
+ *  Initialize the telemetry subscription to all fields at every tick.
+ */
+Seqlock<TelemetrySubscription> seqlock_telemetry_subscription_;
+
+/*
+ *  Initialize the command acknowledgement to no session.
+ */
+Seqlock<CommandAcknowledgement> seqlock_command_acknowledgement_;
+
+/*
+ *  Initialize the camera bandwidth budget to 0 and the camera setting
+ *  to no setting, until the camera rate controller is created.
+ */
+std::atomic<uint32_t> budget_camera_(0);
+Seqlock<CameraSetting> seqlock_camera_setting_;
 
 /*
  *  Initialize Biped serial number to 0.
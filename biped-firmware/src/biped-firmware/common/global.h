@@ -16,11 +16,27 @@
 /*
  *  External headers.
  */
+#ifdef ARDUINO
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#endif
+#include <atomic>
 #include <memory>
 #include <mutex>
 
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "utility/camera_pipeline.hpp"
+#ifdef ARDUINO
+#include "utility/freertos_queue.hpp"
+#endif
+#include "utility/rate_monotonic_scheduler.hpp"
+#include "utility/ring_buffer.hpp"
+#include "utility/seqlock.hpp"
+#include "utility/timing_histogram.hpp"
+
 /*
  *  Biped namespace.
  */
@@ -36,7 +52,9 @@ namespace firmware
  */
 class Actuator;
 class Camera;
-class Controller;
+class CameraRateController;
+template<typename Type>
+class BasicController;
 class IOExpander;
 class NeoPixel;
 class Planner;
@@ -45,8 +63,11 @@ class Timer;
 class UDP;
 class WiFi;
 
+using Controller = BasicController<TypeParameter::Scalar>;  //!< Controller class for the scalar type.
+
 extern std::shared_ptr<Actuator> actuator_; //!< Actuator shared pointer.
 extern std::shared_ptr<Camera> camera_; //!< Camera shared pointer.
+extern std::shared_ptr<CameraRateController> camera_rate_controller_;   //!< Camera rate controller shared pointer.
 extern std::shared_ptr<Controller> controller_; //!< Controller shared pointer.
 extern std::shared_ptr<IOExpander> io_expander_a_;  //!< I/O expander A shared pointer.
 extern std::shared_ptr<IOExpander> io_expander_b_;  //!< I/O expander B shared pointer.
@@ -61,6 +82,9 @@ extern std::shared_ptr<WiFi> wifi_; //!< Wi-Fi shared pointer.
 extern std::mutex mutex_wire_;  //!< I2C driver object mutex.
 extern std::unique_lock<std::mutex> lock_wire_; //!< I2C driver object mutex lock.
 
+#ifdef ARDUINO
+extern TaskHandle_t task_handle_camera_capture_;    //!< Camera capture task handle.
+extern TaskHandle_t task_handle_camera_encode_; //!< Camera encode task handle.
 extern TaskHandle_t task_handle_io_expander_a_interrupt_service_; //!< I/O expander A interrupt service task handle.
 extern TaskHandle_t task_handle_io_expander_b_interrupt_service_; //!< I/O expander B interrupt service task handle.
 extern TaskHandle_t task_handle_network_;  //!< Network task handle.
@@ -70,14 +94,85 @@ extern TaskHandle_t task_handle_udp_write_biped_message_;    //!< Biped message
 extern TaskHandle_t task_handle_udp_write_camera_;    //!< Camera UDP write task handle.
 
 /*
- *  The period domain timer below is used in the real-time task
- *  function for determining whether a full slow domain period
- *  has passed since the last reset of the timer. The slow domain
- *  period is a multiple of fast domain period.
+ *  The camera pipeline below runs the capture, encode, and transmit
+ *  stages in the camera capture, camera encode, and camera UDP write
+ *  tasks, respectively, handing the camera frames through FreeRTOS
+ *  queues.
+ */
+extern std::shared_ptr<CameraPipeline<Camera, FreeRTOSQueue, CameraParameter::frame_buffer_count>> camera_pipeline_;   //!< Camera pipeline shared pointer.
+#endif
+
+/*
+ *  The real-time task scheduler below runs the periodic sensing
+ *  and control jobs of the real-time task, one tick per fast domain
+ *  period. The jobs are registered once before the timer starts.
  */
 extern unsigned long execution_time_real_time_task_; //!< Real-time task execution time, in microseconds.
 extern unsigned long interval_real_time_task_;  //!< Real-time task interval, in microseconds.
-extern double timer_domain_;    //!< Period domain timer, in seconds.
+extern RateMonotonicScheduler<SchedulerParameter::job_count, SchedulerParameter::group_count,
+        SchedulerParameter::histogram_bin_count, SchedulerParameter::histogram_bin_width> scheduler_real_time_task_;   //!< Real-time task scheduler.
+
+/*
+ *  The timing histograms below are recorded by the real-time task,
+ *  or the timer interrupt handler for the interval histogram, and
+ *  are read and reset by the Biped message UDP write task for the
+ *  telemetry. A real-time task deadline miss is counted whenever
+ *  an iteration takes longer than the fast domain period, or a
+ *  timer interrupt passes without a real-time task iteration.
+ */
+extern std::atomic<unsigned long> deadline_miss_real_time_task_;    //!< Real-time task deadline miss count.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_actuate_; //!< Actuation execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_control_; //!< Control execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_real_time_task_; //!< Real-time task execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_sense_fast_;  //!< Fast domain sensing execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_sense_slow_;  //!< Slow domain sensing execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_interval_real_time_task_;  //!< Real-time task interval histogram.
+
+/*
+ *  The camera pipeline statistics below are recorded by the camera
+ *  UDP write task for every transmitted camera frame, and are read,
+ *  and the histograms reset, by the Biped message UDP write task for
+ *  the telemetry.
+ */
+extern std::atomic<unsigned long> frame_count_camera_;  //!< Transmitted camera frame count.
+extern std::atomic<unsigned long> frame_count_dropped_camera_;  //!< Dropped camera frame count.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_capture_;   //!< Camera capture stage execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_encode_;    //!< Camera encode stage execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_execution_time_camera_transmit_;  //!< Camera transmit stage execution time histogram.
+extern TimingHistogram<TelemetryParameter::histogram_bin_count> histogram_latency_camera_;  //!< Camera capture to transmission latency histogram.
+
+/*
+ *  The telemetry sample ring buffer below is pushed by the
+ *  real-time task every fast domain tick, and drained by the
+ *  Biped message UDP write task into telemetry frames.
+ */
+extern RingBuffer<TelemetrySample, TelemetryParameter::ring_buffer_capacity> ring_buffer_telemetry_sample_;  //!< Telemetry sample ring buffer.
+
+/*
+ *  The telemetry subscription sequence lock below is written by
+ *  the Biped message UDP read task upon a subscription message,
+ *  and read by the Biped message UDP write task for every new
+ *  telemetry frame.
+ */
+extern Seqlock<TelemetrySubscription> seqlock_telemetry_subscription_;  //!< Telemetry subscription sequence lock.
+
+/*
+ *  The command acknowledgement sequence lock below is written by
+ *  the Biped message UDP read task upon a command message, and
+ *  read by the Biped message UDP write task for every status
+ *  message.
+ */
+extern Seqlock<CommandAcknowledgement> seqlock_command_acknowledgement_;  //!< Command acknowledgement sequence lock.
+
+/*
+ *  The camera setting sequence lock and the camera bandwidth budget
+ *  below are written by the Biped message UDP read task upon a camera
+ *  feedback message, and read by the camera capture task for every
+ *  camera frame and by the Biped message UDP write task for every
+ *  status message, respectively.
+ */
+extern std::atomic<uint32_t> budget_camera_;    //!< Camera bandwidth budget, in bytes per second.
+extern Seqlock<CameraSetting> seqlock_camera_setting_;  //!< Camera setting sequence lock.
 
 extern unsigned serial_number_; //!< Biped serial number.
 }   // namespace firmware
@@ -18,8 +18,10 @@
  */
 #include <cstddef>
 #include <cstdint>
+#ifdef ARDUINO
 #include <freertos/FreeRTOS.h>
 #include <hal/timer_types.h>
+#endif
 
 /*
  *  Project headers.
@@ -51,14 +53,54 @@ constexpr uint8_t time_of_flight_middle = 0x41; //!< Middle time-of-flight I2C a
 constexpr uint8_t time_of_flight_right = 0x42;  //!< Right time-of-flight I2C address.
 }   // namespace AddressParameter
 
+/*
+ *  Attitude estimator parameter namespace.
+ */
+namespace AttitudeEstimatorParameter
+{
+constexpr double gain_integral = 0.1;   //!< Integral gain, in radians per second squared.
+constexpr double gain_proportional = 1; //!< Proportional gain, in radians per second.
+}   // namespace AttitudeEstimatorParameter
+
 /*
  *  Camera parameter namespace.
+ *
+ *  The camera rate controller keeps the camera bandwidth
+ *  within a budget, cut multiplicatively on chunk loss above
+ *  the high loss ratio and raised additively after consecutive
+ *  camera feedback messages below the low loss ratio. The
+ *  budget never exceeds the link bandwidth less the Biped
+ *  message bandwidth. The bytes per pixel at the reference
+ *  JPEG quality seed the camera frame size model, scaled by the
+ *  observed camera frame sizes.
  */
 namespace CameraParameter
 {
-constexpr size_t frame_buffer_count = 1;    //!< Number of frame buffers.
+constexpr double bandwidth_increase = 20000;    //!< Camera bandwidth budget additive increase, in bytes per second.
+constexpr double bandwidth_link = 1000000;  //!< Link bandwidth, in bytes per second.
+constexpr double bandwidth_min = 4000;  //!< Minimum camera bandwidth budget, in bytes per second.
+constexpr double bytes_per_pixel = 0.12;    //!< JPG bytes per pixel at the reference JPEG quality.
+constexpr double calibration_gain = 0.25;   //!< Camera frame size model calibration gain, from 0 to 1.
+constexpr double calibration_max = 4;   //!< Maximum camera frame size model calibration.
+constexpr double calibration_min = 0.25;    //!< Minimum camera frame size model calibration.
+constexpr double factor_decrease = 0.8; //!< Camera bandwidth budget multiplicative decrease factor.
+constexpr unsigned feedback_count_increase = 2; //!< Number of consecutive low loss camera feedback messages before an increase.
+constexpr unsigned feedback_count_settle = 2;   //!< Number of camera feedback messages after a camera setting change without calibration.
+constexpr size_t frame_buffer_count = 2;    //!< Number of frame buffers, i.e., the number of camera frames in the camera pipeline.
 constexpr int jpeg_quality = 12;    //!< JPEG image quality.
 constexpr int jpeg_quality_conversion = 80;    //!< JPEG image conversion quality.
+constexpr int jpeg_quality_reference = 12;  //!< Reference JPEG quality of the bytes per pixel.
+constexpr double loss_high = 0.05;  //!< High chunk loss ratio, above which the camera bandwidth budget is cut.
+constexpr double loss_low = 0.01;   //!< Low chunk loss ratio, below which the camera bandwidth budget is raised.
+constexpr CameraSetting settings[] = {
+        CameraSetting(CameraFrameSize::qqvga, 40, 5),
+        CameraSetting(CameraFrameSize::qqvga, 30, 10),
+        CameraSetting(CameraFrameSize::qvga, 30, 10),
+        CameraSetting(CameraFrameSize::qvga, 20, 15),
+        CameraSetting(CameraFrameSize::qvga, 12, 20),
+        CameraSetting(CameraFrameSize::hvga, 12, 20),
+        CameraSetting(CameraFrameSize::hvga, jpeg_quality, 25) };   //!< Camera settings of the camera rate controller, from the lowest to the highest bandwidth.
+constexpr size_t setting_count = sizeof(settings) / sizeof(settings[0]);    //!< Number of camera settings.
 constexpr int xclk_frequency = 20000000;    //!< X clock frequency, in Hertz.
 }   // namespace CameraParameter
 
@@ -92,10 +134,22 @@ constexpr size_t size = 4;  //!< EEPROM size, in bytes.
  */
 namespace EncoderParameter
 {
-constexpr double low_pass_filter_beta = 0.7;    //!< Low-pass filter beta.
+constexpr double low_pass_filter_beta = 0.5;    //!< Low-pass filter beta, for the fast domain.
 constexpr unsigned steps_per_meter = 7400;  //!< Number of encoder steps per meter.
+constexpr double velocity_timeout = 0.1; //!< Velocity estimator timeout, in seconds.
 }   // namespace EncoderParameter
 
+/*
+ *  IMU parameter namespace.
+ */
+namespace IMUParameter
+{
+constexpr double acceleration_cutoff = 20;  //!< Accelerometer low-pass filter cutoff frequency, in Hertz.
+constexpr double angular_velocity_cutoff = 60;  //!< Gyroscope low-pass filter cutoff frequency, in Hertz.
+constexpr size_t channel_count = 6; //!< Number of accelerometer and gyroscope channels.
+constexpr double quality_factor = 0.7071067811865476;   //!< Low-pass filter quality factor (Butterworth).
+}   // namespace IMUParameter
+
 /*
  *  I/O expander parameter namespace.
  */
@@ -149,7 +203,7 @@ namespace NetworkParameter
 {
 constexpr size_t buffer_size_biped_message = 1024; //!< Biped message buffer size.
 constexpr size_t buffer_size_camera = 1460; //!< Camera buffer size.
-constexpr char camera_frame_boundary[] = "123456789000000000000987654321"; //!< Camera frame magic boundary string.
+constexpr size_t buffer_size_telemetry_frame = 1460;  //!< Telemetry frame buffer size.
 constexpr char ip_ground_station[] = "192.168.1.10";   //!< Biped ground station IP address.
 constexpr char passphrase[] = "s4srxcF3";   //!< Wi-Fi passphrase.
 constexpr uint16_t port_udp_biped_message = 4431;  //!< Biped message UDP port.
@@ -177,6 +231,32 @@ constexpr double fast = 0.005;  //!< Fast domain period, in seconds.
 constexpr double slow = 0.04;   //!< Slow domain period, in seconds.
 }   // namespace PeriodParameter
 
+/*
+ *  Scheduler parameter namespace.
+ *
+ *  The real-time task runs sensing and control as periodic jobs
+ *  of the rate-monotonic scheduler, which ticks every fast domain
+ *  period. The job periods are integer tick divisors, and the phase
+ *  offsets spread the slow domain jobs over different ticks, e.g.,
+ *  the time-of-flight reads away from the slow domain control. The
+ *  job execution times are summed per job group for the telemetry.
+ */
+namespace SchedulerParameter
+{
+constexpr uint32_t divisor_fast = 1;    //!< Fast domain job tick divisor.
+constexpr uint32_t divisor_slow = static_cast<uint32_t>(PeriodParameter::slow
+        / PeriodParameter::fast + 0.5); //!< Slow domain job tick divisor.
+constexpr size_t group_control = 0;    //!< Control job group index.
+constexpr size_t group_count = 3;  //!< Number of job groups.
+constexpr size_t group_sense_fast = 1; //!< Fast domain sensing job group index.
+constexpr size_t group_sense_slow = 2; //!< Slow domain sensing job group index.
+constexpr size_t histogram_bin_count = 32;  //!< Number of job timing histogram bins.
+constexpr uint32_t histogram_bin_width = 5;   //!< Job timing histogram bin width, in microseconds.
+constexpr size_t job_count = 8;    //!< Maximum number of jobs.
+constexpr uint32_t phase_control_slow = 0;  //!< Slow domain control job phase, in ticks.
+constexpr uint32_t phase_time_of_flight = divisor_slow / 2;    //!< Time-of-flight sensing job phase, in ticks.
+}   // namespace SchedulerParameter
+
 /*
  *  Serial parameter namespace.
  */
@@ -194,19 +274,78 @@ namespace TaskParameter
 constexpr int core_0 = 0;   //!< CPU core 0.
 constexpr int core_1 = 1;   //!< CPU core 1.
 constexpr unsigned int priority_min = 0;    //!< Minimum priority.
+#ifdef ARDUINO
 constexpr unsigned int priority_max = configMAX_PRIORITIES; //!< Maximum priority.
+#endif
 constexpr uint32_t stack_size = 4096;   //!< Task stack size, in bytes.
 }   // namespace TaskParameter
 
+/*
+ *  Telemetry parameter namespace.
+ *
+ *  The real-time task timing histograms are linear, with
+ *  the interval histogram centered around the fast domain
+ *  period. Samples outside the histogram range are counted
+ *  in the first or the last bin.
+ *
+ *  The real-time task pushes a telemetry sample every fast
+ *  domain tick into the telemetry sample ring buffer. The
+ *  Biped message UDP write task drains it every frame period,
+ *  packing the samples of one frame period into one telemetry
+ *  frame, and writes the status message every status message
+ *  period and the parameter message every parameter message
+ *  period. The ring buffer absorbs Wi-Fi stalls of up to its
+ *  capacity in ticks.
+ */
+namespace TelemetryParameter
+{
+constexpr size_t histogram_bin_count = 128;  //!< Number of timing histogram bins.
+constexpr uint32_t histogram_bin_width_camera = 1000;  //!< Camera pipeline stage execution time and latency histogram bin width, in microseconds.
+constexpr uint32_t histogram_bin_width_execution_time = 20;   //!< Real-time task execution time histogram bin width, in microseconds.
+constexpr uint32_t histogram_bin_width_interval = 10;   //!< Real-time task interval histogram bin width, in microseconds.
+constexpr uint32_t histogram_bin_width_stage = 5;   //!< Real-time task stage execution time histogram bin width, in microseconds.
+constexpr uint32_t histogram_lower_bound_interval = static_cast<uint32_t>(PeriodParameter::fast
+        * 1e6) - histogram_bin_count / 2 * histogram_bin_width_interval;   //!< Real-time task interval histogram lower bound, in microseconds.
+constexpr double period_frame = 0.025;  //!< Telemetry frame period, in seconds.
+constexpr double period_parameter_message = 1;  //!< Parameter message period, in seconds.
+constexpr double period_status_message = 0.1;   //!< Status message period, in seconds.
+constexpr size_t ring_buffer_capacity = 64; //!< Telemetry sample ring buffer capacity, a power of two.
+constexpr uint32_t divisor_parameter_message = static_cast<uint32_t>(period_parameter_message
+        / period_frame + 0.5);  //!< Parameter message period, in frame periods.
+constexpr uint32_t divisor_status_message = static_cast<uint32_t>(period_status_message
+        / period_frame + 0.5);  //!< Status message period, in frame periods.
+constexpr uint32_t sample_count_frame = static_cast<uint32_t>(period_frame
+        / PeriodParameter::fast + 0.5);  //!< Number of telemetry samples per frame.
+constexpr double bandwidth_biped_message = NetworkParameter::buffer_size_telemetry_frame
+        / period_frame + NetworkParameter::buffer_size_biped_message / period_status_message
+        + NetworkParameter::buffer_size_biped_message / period_parameter_message; //!< Worst case Biped message bandwidth, in bytes per second.
+}   // namespace TelemetryParameter
+
 /*
  *  Timer parameter namespace.
  */
 namespace TimerParameter
 {
+#ifdef ARDUINO
 constexpr timer_group_t group = TIMER_GROUP_1; //!< Timer group.
 constexpr timer_idx_t index = TIMER_1; //!< Timer index.
+#endif
 constexpr size_t prescaler = 80;  //!< Timer prescaler.
 }   // namespace TimerParameter
+
+/*
+ *  Type parameter namespace.
+ *
+ *  The scalar type specifies the arithmetic type of the
+ *  control pipeline, i.e., the controllers and the attitude
+ *  and velocity filters. The ESP32 floating-point unit only
+ *  supports single precision, and double precision arithmetic
+ *  is emulated in software.
+ */
+namespace TypeParameter
+{
+using Scalar = float;   //!< Control pipeline scalar type.
+}   // namespace TypeParameter
 }   // namespace firmware
 }   // namespace biped
 
@@ -0,0 +1,177 @@
+/**
+ *  @file   camera_rate_controller.cpp
+ *  @author Simon Yu
+ *  @date   02/03/2022
+ *  @brief  Camera rate controller class source.
+ *
+ *  This file implements the camera rate controller class.
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "controller/camera_rate_controller.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+CameraRateController::CameraRateController() : budget_(CameraParameter::bandwidth_link
+        - TelemetryParameter::bandwidth_biped_message), calibration_(1),
+        feedback_count_clean_(0), feedback_count_setting_(0),
+        index_(CameraParameter::setting_count - 1)
+{
+}
+
+double
+CameraRateController::getBandwidth(const CameraSetting& setting) const
+{
+    /*
+     *  Model the camera frame size from the number of pixels, scaled
+     *  inversely by the JPEG quality, since a higher JPEG quality value
+     *  means a coarser quantization.
+     */
+    const double size = setting.getPixelCount() * CameraParameter::bytes_per_pixel
+            * CameraParameter::jpeg_quality_reference
+            / std::max<double>(setting.jpeg_quality, 1);
+
+    /*
+     *  Account for the camera chunk header of every chunk.
+     */
+    const double overhead = static_cast<double>(NetworkParameter::buffer_size_camera)
+            / (NetworkParameter::buffer_size_camera - CameraChunkHeader::size);
+
+    return size * overhead * setting.frame_rate * calibration_;
+}
+
+double
+CameraRateController::getBudget() const
+{
+    return budget_;
+}
+
+CameraSetting
+CameraRateController::getSetting() const
+{
+    return CameraParameter::settings[index_];
+}
+
+bool
+CameraRateController::update(const CameraFeedbackMessage& feedback)
+{
+    /*
+     *  Calculate the maximum budget, leaving the Biped message bandwidth
+     *  as headroom on the link.
+     */
+    const double budget_max = CameraParameter::bandwidth_link
+            - TelemetryParameter::bandwidth_biped_message;
+    const double loss = feedback.getLoss();
+
+    /*
+     *  Calibrate the camera frame size model, once the camera frames of
+     *  the previous camera setting are out of the feedback window.
+     */
+    if (feedback_count_setting_ < CameraParameter::feedback_count_settle)
+    {
+        feedback_count_setting_ ++;
+    }
+    else
+    {
+        calibrate(feedback);
+    }
+
+    /*
+     *  Cut the budget on high loss, raise it on consecutive low loss,
+     *  and hold it otherwise.
+     */
+    if (loss > CameraParameter::loss_high)
+    {
+        budget_ = std::min(budget_, feedback.getThroughput()) * CameraParameter::factor_decrease;
+        feedback_count_clean_ = 0;
+    }
+    else if (loss < CameraParameter::loss_low)
+    {
+        if (++ feedback_count_clean_ >= CameraParameter::feedback_count_increase)
+        {
+            budget_ += CameraParameter::bandwidth_increase;
+        }
+    }
+    else
+    {
+        feedback_count_clean_ = 0;
+    }
+
+    budget_ = std::max(CameraParameter::bandwidth_min, std::min(budget_, budget_max));
+
+    /*
+     *  Find the highest camera setting within the budget, or the lowest
+     *  camera setting if none is.
+     */
+    size_t index = 0;
+
+    for (size_t i = CameraParameter::setting_count; i > 0; i --)
+    {
+        if (getBandwidth(CameraParameter::settings[i - 1]) <= budget_)
+        {
+            index = i - 1;
+            break;
+        }
+    }
+
+    /*
+     *  Step down right away, but step up one camera setting at a time.
+     */
+    index = index > index_ ? index_ + 1 : index;
+
+    if (index == index_)
+    {
+        return false;
+    }
+
+    index_ = index;
+    feedback_count_setting_ = 0;
+
+    return true;
+}
+
+void
+CameraRateController::calibrate(const CameraFeedbackMessage& feedback)
+{
+    const uint32_t frame_count = feedback.frame_count_complete + feedback.frame_count_dropped;
+    const double size = getBandwidth(getSetting()) / calibration_ / getSetting().frame_rate;
+
+    /*
+     *  If no camera frames or chunks were received, there is nothing to
+     *  calibrate against.
+     */
+    if (frame_count == 0 || feedback.chunk_count_received == 0 || size <= 0)
+    {
+        return;
+    }
+
+    /*
+     *  Estimate the sent bytes from the received bytes and the chunk loss,
+     *  and compare the observed camera frame size to the modelled one.
+     */
+    const double byte_count = static_cast<double>(feedback.byte_count)
+            * (feedback.chunk_count_received + feedback.chunk_count_lost)
+            / feedback.chunk_count_received;
+    const double ratio = std::max(CameraParameter::calibration_min,
+            std::min(byte_count / frame_count / size, CameraParameter::calibration_max));
+
+    calibration_ += CameraParameter::calibration_gain * (ratio - calibration_);
+}
+}   // namespace firmware
+}   // namespace biped
@@ -0,0 +1,137 @@
+/**
+ *  @file   camera_rate_controller.h
+ *  @author Simon Yu
+ *  @date   02/03/2022
+ *  @brief  Camera rate controller class header.
+ *
+ *  This file defines the camera rate controller class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef CONTROLLER_CAMERA_RATE_CONTROLLER_H_
+#define CONTROLLER_CAMERA_RATE_CONTROLLER_H_
+
+/*
+ *  External headers.
+ */
+#include <cstddef>
+
+/*
+ *  Project headers.
+ */
+#include "common/type.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Camera rate controller class.
+ *
+ *  This class provides functions for creating a camera
+ *  rate controller, which selects the camera frame size,
+ *  JPEG quality, and frame rate from the camera settings,
+ *  such that the camera bandwidth stays within a budget.
+ *
+ *  The budget follows the chunk loss and the throughput
+ *  reported by the camera feedback messages from the Biped
+ *  ground station. On high loss, the budget is cut to a
+ *  fraction of the smaller of the budget and the received
+ *  throughput. On low loss over consecutive camera feedback
+ *  messages, the budget is raised additively, up to the link
+ *  bandwidth less the Biped message bandwidth, such that the
+ *  camera never crowds out the Biped message channel.
+ *
+ *  The bandwidth of a camera setting is modelled from its
+ *  number of pixels, JPEG quality, and frame rate, scaled by a
+ *  calibration that tracks the observed camera frame sizes.
+ *  The controller selects the highest camera setting within
+ *  the budget, stepping down right away but up one camera
+ *  setting per camera feedback message.
+ */
+class CameraRateController
+{
+public:
+
+    /**
+     *  @brief  Camera rate controller class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  with the highest camera setting and the maximum budget.
+     */
+    CameraRateController();
+
+    /**
+     *  @param  setting Camera setting struct.
+     *  @return Modelled bandwidth, in bytes per second.
+     *  @brief  Get the modelled bandwidth of a camera setting.
+     *
+     *  This function returns the calibrated bandwidth of the given
+     *  camera setting, including the camera chunk headers.
+     */
+    double
+    getBandwidth(const CameraSetting& setting) const;
+
+    /**
+     *  @return Camera bandwidth budget, in bytes per second.
+     *  @brief  Get the camera bandwidth budget.
+     *
+     *  This function returns the camera bandwidth budget.
+     */
+    double
+    getBudget() const;
+
+    /**
+     *  @return Camera setting struct.
+     *  @brief  Get the selected camera setting.
+     *
+     *  This function returns the selected camera setting.
+     */
+    CameraSetting
+    getSetting() const;
+
+    /**
+     *  @param  feedback Camera feedback message struct.
+     *  @return Whether the selected camera setting changed.
+     *  @brief  Execute the camera rate controller.
+     *
+     *  This function calibrates the camera frame size model,
+     *  adjusts the budget, and selects the camera setting, given
+     *  a camera feedback message. This function is expected to be
+     *  called for every camera feedback message received.
+     */
+    bool
+    update(const CameraFeedbackMessage& feedback);
+
+private:
+
+    /**
+     *  @param  feedback Camera feedback message struct.
+     *  @brief  Calibrate the camera frame size model.
+     *
+     *  This function compares the camera frame size observed by
+     *  the Biped ground station to the modelled camera frame size
+     *  of the selected camera setting, and low-pass filters the
+     *  ratio into the calibration.
+     */
+    void
+    calibrate(const CameraFeedbackMessage& feedback);
+
+    double budget_; //!< Camera bandwidth budget, in bytes per second.
+    double calibration_;    //!< Camera frame size model calibration.
+    unsigned feedback_count_clean_; //!< Number of consecutive low loss camera feedback messages.
+    unsigned feedback_count_setting_;   //!< Number of camera feedback messages since the last camera setting change.
+    size_t index_;  //!< Index of the selected camera setting.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // CONTROLLER_CAMERA_RATE_CONTROLLER_H_
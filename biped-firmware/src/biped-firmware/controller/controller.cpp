@@ -7,14 +7,19 @@
  *  This file implements the controller class.
  */
 
+/*
+ *  External headers.
+ */
+#include <cmath>
+
 /*
  *  Project headers.
  */
 #include "common/global.h"
 #include "common/parameter.h"
 #include "controller/controller.h"
-#include "platform/display.h"
 #include "sensor/sensor.h"
+#include "utility/fixed_point.hpp"
 #include "utility/math.h"
 
 /*
@@ -27,8 +32,11 @@ namespace biped
  */
 namespace firmware
 {
-Controller::Controller() : active_(false), output_position_x_(0), output_attitude_y_(0),
-        output_attitude_z_(0)
+template<typename Type>
+BasicController<Type>::BasicController() : active_(false), attitude_z_origin_(0),
+        attitude_z_origin_pending_(true), attitude_z_reference_origin_(0), output_position_x_(0),
+        output_attitude_y_(0), output_attitude_z_(0), state_feedback_gain_ { },
+        sequence_controller_parameter_(0), sequence_controller_reference_(0)
 {
     /*
      *  Set entries in the X position (forward/backward) PID controller gain
@@ -82,8 +90,8 @@ Controller::Controller() : active_(false), output_position_x_(0), output_attitud
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    controller_parameter_.pid_controller_gain_position_x.proportional = 800;
-    controller_parameter_.pid_controller_gain_position_x.differential = 1600;
+    controller_parameter_.pid_controller_gain_position_x.proportional = 400;
+    controller_parameter_.pid_controller_gain_position_x.differential = 700;
     controller_parameter_.pid_controller_gain_position_x.integral = 50;
     controller_parameter_.pid_controller_gain_position_x.integral_max = 50;
 
@@ -226,6 +234,20 @@ Controller::Controller() : active_(false), output_position_x_(0), output_attitud
     controller_parameter_.pid_controller_saturation_position_x.input_lower = -0.4;
     controller_parameter_.pid_controller_saturation_position_x.input_upper = 0.2;
 
+    /*
+     *  Set the state-feedback controller gain struct in the class member
+     *  controller parameter struct, used in the state-feedback controller
+     *  mode. The gains are the discrete-time linear-quadratic regulator
+     *  gains of the linearized two-wheeled inverted pendulum model for
+     *  the fast domain period, computed offline by the state-feedback
+     *  harness in the simulator directory. The Z angular velocity
+     *  gain is 0, as the Z angular velocity of the model follows the
+     *  turning output within the fast domain period.
+     */
+    controller_parameter_.state_feedback_gain.forward = { -217.999, -418.233, 668.702, 86.4422, 0,
+            0 };
+    controller_parameter_.state_feedback_gain.turning = { 0, 0, 0, 0, 249.405, 0 };
+
     /*
      *  Using the setControllerParameter class member function, set the
      *  controller parameter to be the class member controller parameter struct.
@@ -242,6 +264,13 @@ Controller::Controller() : active_(false), output_position_x_(0), output_attitud
      */
     setControllerReference(controller_reference_);
 
+    /*
+     *  Apply the controller parameter and reference set above
+     *  to all controllers.
+     */
+    updateControllerParameter();
+    updateControllerReference();
+
     /*
      *  Initialize NeoPixel frame for controller active status.
      */
@@ -261,19 +290,20 @@ Controller::Controller() : active_(false), output_position_x_(0), output_attitud
     neopixel_frame_inactive_->push_back(Eigen::Vector3i(0, 0, 255));
 }
 
+template<typename Type>
 ActuationCommand
-Controller::getActuationCommand() const
+BasicController<Type>::getActuationCommand() const
 {
     /*
-     *  Return the class member actuation command struct.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
+     *  Return the actuation command struct snapshot from the class
+     *  member actuation command struct sequence lock.
      */
-    return actuation_command_;
+    return seqlock_actuation_command_.read();
 }
 
+template<typename Type>
 bool
-Controller::getActiveStatus() const
+BasicController<Type>::getActiveStatus() const
 {
     /*
      *  Return the class member controller active flag.
@@ -283,102 +313,61 @@ Controller::getActiveStatus() const
     return active_;
 }
 
+template<typename Type>
 ControllerParameter
-Controller::getControllerParameter() const
+BasicController<Type>::getControllerParameter() const
 {
     /*
-     *  Return the class member controller parameter struct.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
+     *  Return the controller parameter struct snapshot from the class
+     *  member controller parameter struct sequence lock.
      */
-    return controller_parameter_;
+    return seqlock_controller_parameter_.read();
 }
 
+template<typename Type>
 ControllerReference
-Controller::getControllerReference() const
+BasicController<Type>::getControllerReference() const
 {
     /*
-     *  Return the class member controller reference struct.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
+     *  Return the controller reference struct snapshot from the class
+     *  member controller reference struct sequence lock.
      */
-    return controller_reference_;
+    return seqlock_controller_reference_.read();
 }
 
+template<typename Type>
 void
-Controller::setControllerParameter(const ControllerParameter& controller_parameter)
+BasicController<Type>::setControllerParameter(const ControllerParameter& controller_parameter)
 {
     /*
-     *  Store the given controller parameter struct in the
-     *  function parameter to the class member controller
-     *  parameter struct.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
-     */
-    controller_parameter_ = controller_parameter;
-
-    /*
-     *  Set the Z attitude open-loop controller gain entry in the class member
-     *  controller parameter struct to the class member Z attitude open-loop
-     *  controller.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
-     */
-    open_loop_controller_attitude_z_.setGain(controller_parameter_.attitude_z_gain_open_loop);
-
-    /*
-     *  Set the PID controller gain structs in the class member controller
-     *  parameter struct to the corresponding class member PID controllers.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
-     */
-    pid_controller_attitude_y_.setGain(controller_parameter_.pid_controller_gain_attitude_y);
-    pid_controller_attitude_z_.setGain(controller_parameter_.pid_controller_gain_attitude_z);
-    pid_controller_position_x_.setGain(controller_parameter_.pid_controller_gain_position_x);
-
-    /*
-     *  Set the controller saturation structs in the class member controller
-     *  parameter struct to the corresponding class member controllers.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
+     *  Lock the sequence lock writing mutex, since the sequence
+     *  locks only support a single writer at a time, and publish
+     *  the given controller parameter struct in the function
+     *  parameter to the class member controller parameter struct
+     *  sequence lock.
      */
-    pid_controller_attitude_y_.setSaturation(controller_parameter_.pid_controller_saturation_attitude_y);
-    pid_controller_attitude_z_.setSaturation(controller_parameter_.pid_controller_saturation_attitude_z);
-    pid_controller_position_x_.setSaturation(controller_parameter_.pid_controller_saturation_position_x);
+    std::lock_guard<std::mutex> lock(mutex_seqlock_write_);
+    seqlock_controller_parameter_.write(controller_parameter);
 }
 
+template<typename Type>
 void
-Controller::setControllerReference(const ControllerReference& controller_reference)
+BasicController<Type>::setControllerReference(const ControllerReference& controller_reference)
 {
     /*
-     *  Store the given controller reference struct in the
-     *  function parameter to the class member controller
-     *  reference struct.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
+     *  Lock the sequence lock writing mutex, since the sequence
+     *  locks only support a single writer at a time, and publish
+     *  the given controller reference struct in the function
+     *  parameter to the class member controller reference struct
+     *  sequence lock.
      */
-    controller_reference_ = controller_reference;
-
-    /*
-     *  Set the entries in the class member controller reference
-     *  struct to the corresponding class member controllers.
-     *
-     *  You should set the Z attitude (yaw) controller reference
-     *  in the class member controller reference struct to both the
-     *  class member Z attitude (yaw) open-loop controller and the
-     *  class member Z attitude (yaw) PID controller.
-     *
-     *  TODO LAB 7 YOUR CODE HERE.
-     */
-    open_loop_controller_attitude_z_.setReference(controller_reference_.attitude_z);
-    pid_controller_attitude_z_.setReference(controller_reference_.attitude_z);
-
-    pid_controller_attitude_y_.setReference(controller_reference_.attitude_y);
-    pid_controller_position_x_.setReference(controller_reference_.position_x);
+    std::lock_guard<std::mutex> lock(mutex_seqlock_write_);
+    seqlock_controller_reference_.write(controller_reference);
 }
 
+template<typename Type>
 void
-Controller::setPeriod(const double& period, const bool& fast_domain)
+BasicController<Type>::setPeriod(const double& period, const bool& fast_domain)
 {
     /*
      *  The reason behind the fast and slow time domain setup here
@@ -420,8 +409,9 @@ Controller::setPeriod(const double& period, const bool& fast_domain)
     }
 }
 
+template<typename Type>
 void
-Controller::control(const bool& fast_domain)
+BasicController<Type>::control(const bool& fast_domain)
 {
     /*
      *  Get the encoder and IMU data
@@ -431,12 +421,37 @@ Controller::control(const bool& fast_domain)
      */
 	IMUData current_imu_data=sensor_->getIMUData();
 	EncoderData current_encoder_data=sensor_->getEncoderData();
+
+    /*
+     *  Execute the controller using the sensor data.
+     */
+    control(fast_domain, current_imu_data, current_encoder_data);
+}
+
+template<typename Type>
+void
+BasicController<Type>::control(const bool& fast_domain, const IMUData& imu_data,
+        const EncoderData& encoder_data)
+{
+    /*
+     *  Use the standard absolute value function unless a scalar
+     *  type specific one is found by argument-dependent lookup.
+     */
+    using std::fabs;
+
+    /*
+     *  Apply the controller parameter and reference
+     *  set since the last controller execution.
+     */
+    updateControllerParameter();
+    updateControllerReference();
+
     /*
      *  Update the controller active status using the IMU data struct.
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-	updateActiveStatus(current_imu_data);
+	updateActiveStatus(imu_data);
     /*
      *  The reason behind the fast and slow time domain setup here
      *  is similar to the explanation provided in the sensor header.
@@ -447,7 +462,18 @@ Controller::control(const bool& fast_domain)
      *  as they are less mission-critical and their sensor data is
      *  also noisier.
      */
-    if (fast_domain)
+    if (controller_parameter_.mode == ControllerMode::state_feedback)
+    {
+        /*
+         *  The state-feedback controller controls all states
+         *  at once, in the fast domain only.
+         */
+        if (fast_domain)
+        {
+            controlStateFeedback(imu_data, encoder_data);
+        }
+    }
+    else if (fast_domain)
     {
         /*
          *  Set the plant state input (Y) of the class member Y attitude
@@ -456,7 +482,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	pid_controller_attitude_y_.setState(current_imu_data.attitude_y);
+    	pid_controller_attitude_y_.setState(Type(imu_data.attitude_y));
         /*
          *  Set the error differential input (delta e) of the class member
          *  Y attitude (pitch) PID controller to be the Y angular velocity
@@ -464,7 +490,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	pid_controller_attitude_y_.setErrorDifferential(current_imu_data.angular_velocity_y);
+    	pid_controller_attitude_y_.setErrorDifferential(Type(imu_data.angular_velocity_y));
         /*
          *  Execute the class member Y attitude (pitch) PID controller
          *  and store the output into the class member Y attitude (pitch)
@@ -483,7 +509,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	pid_controller_position_x_.setState(current_encoder_data.position_x);
+    	pid_controller_position_x_.setState(Type(encoder_data.position_x));
         /*
          *  Set the error differential input (delta e) of the class member
          *  X position (forward/backward) PID controller to be the X
@@ -491,7 +517,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	pid_controller_position_x_.setErrorDifferential(current_encoder_data.velocity_x);
+    	pid_controller_position_x_.setErrorDifferential(Type(encoder_data.velocity_x));
         /*
          *  Set the error differential input (delta e) of the class member
          *  Z attitude (yaw) PID controller to be the Z angular velocity in
@@ -499,7 +525,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	pid_controller_attitude_z_.setErrorDifferential(current_imu_data.angular_velocity_z);
+    	pid_controller_attitude_z_.setErrorDifferential(Type(imu_data.angular_velocity_z));
         /*
          *  Execute the class member X position (forward/backward) PID
          *  controller and store the output into the class member X position
@@ -528,7 +554,7 @@ Controller::control(const bool& fast_domain)
          *
          *  TODO LAB 7 YOUR CODE HERE.
          */
-    	output_attitude_z_=open_loop_controller_attitude_z_.control()*fabs(current_encoder_data.velocity_x)+pid_controller_attitude_z_.control();
+    	output_attitude_z_=open_loop_controller_attitude_z_.control()*fabs(Type(encoder_data.velocity_x))+pid_controller_attitude_z_.control();
     }
 
     /*
@@ -537,7 +563,7 @@ Controller::control(const bool& fast_domain)
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double left_motor_output= output_position_x_ + output_attitude_y_ + output_attitude_z_;
+    Type left_motor_output= output_position_x_ + output_attitude_y_ + output_attitude_z_;
     /*
      *  Produce the right motor output by adding the
      *  class member X position controller output with the
@@ -546,7 +572,7 @@ Controller::control(const bool& fast_domain)
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double right_motor_output= output_position_x_ + output_attitude_y_ - output_attitude_z_;
+    Type right_motor_output= output_position_x_ + output_attitude_y_ - output_attitude_z_;
     /*
      *  If the controller is inactive, stop the motors
      *  by setting both the motor outputs to 0.
@@ -555,8 +581,8 @@ Controller::control(const bool& fast_domain)
      */
     if(!active_)
     {
-    	left_motor_output=0;
-    	right_motor_output=0;
+    	left_motor_output=Type(0);
+    	right_motor_output=Type(0);
     }
     /*
      *  Set the motor enable in the class member actuation
@@ -577,14 +603,14 @@ Controller::control(const bool& fast_domain)
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    actuation_command_.motor_left_forward = (left_motor_output >= static_cast<double>(MotorParameter::pwm_min));
-    actuation_command_.motor_right_forward = (right_motor_output >= static_cast<double>(MotorParameter::pwm_min));
+    actuation_command_.motor_left_forward = (left_motor_output >= Type(MotorParameter::pwm_min));
+    actuation_command_.motor_right_forward = (right_motor_output >= Type(MotorParameter::pwm_min));
 
     /*
      *  Using the clamp function from the math header, clamp the
      *  magnitude of the motor output values to be within the
      *  minimum and maximum motor PWM values. Remember to
-     *  static_cast the motor parameter values to double before
+     *  convert the motor parameter values to the scalar type before
      *  passing them to the clamp function.
      *
      *  Note that one should always use C++ explicit type casts
@@ -601,12 +627,78 @@ Controller::control(const bool& fast_domain)
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    actuation_command_.motor_left_pwm = clamp(fabs(left_motor_output), static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
-    actuation_command_.motor_right_pwm = clamp(fabs(right_motor_output), static_cast<double>(MotorParameter::pwm_min), static_cast<double>(MotorParameter::pwm_max));
+    actuation_command_.motor_left_pwm = static_cast<double>(clamp(fabs(left_motor_output), Type(MotorParameter::pwm_min), Type(MotorParameter::pwm_max)));
+    actuation_command_.motor_right_pwm = static_cast<double>(clamp(fabs(right_motor_output), Type(MotorParameter::pwm_min), Type(MotorParameter::pwm_max)));
+
+    /*
+     *  Publish the class member actuation command struct to
+     *  the class member actuation command struct sequence lock.
+     */
+    seqlock_actuation_command_.write(actuation_command_);
+}
+
+template<typename Type>
+void
+BasicController<Type>::controlStateFeedback(const IMUData& imu_data,
+        const EncoderData& encoder_data)
+{
+    /*
+     *  Take the current Z attitude as the origin of the Z attitude
+     *  error, if requested since the last execution.
+     */
+    if (attitude_z_origin_pending_)
+    {
+        attitude_z_origin_ = imu_data.attitude_z;
+        attitude_z_origin_pending_ = false;
+    }
+
+    /*
+     *  Calculate the state error vector. The X position error is
+     *  saturated by the X position PID controller input saturation
+     *  bounds, for the same reason as in the X position PID controller.
+     *  The Z attitude error is the Z attitude turned since the origin
+     *  minus the Z attitude reference change since the origin, wrapped
+     *  to within half a turn. The angular velocities are corrected by
+     *  the estimated gyroscope biases.
+     */
+    const Type error[6] = {
+            Type(clamp(encoder_data.position_x - controller_reference_.position_x,
+                    controller_parameter_.pid_controller_saturation_position_x.input_lower,
+                    controller_parameter_.pid_controller_saturation_position_x.input_upper)),
+            Type(encoder_data.velocity_x),
+            Type(imu_data.attitude_y - controller_reference_.attitude_y),
+            Type(imu_data.angular_velocity_y - imu_data.angular_velocity_bias_y),
+            Type(std::remainder(imu_data.attitude_z - attitude_z_origin_
+                    - (controller_reference_.attitude_z - attitude_z_reference_origin_), 2 * M_PI)),
+            Type(imu_data.angular_velocity_z - imu_data.angular_velocity_bias_z) };
+
+    /*
+     *  Multiply the state-feedback gain matrix with the state error
+     *  vector (u = -K x).
+     */
+    Type output[2] = { Type(0), Type(0) };
+
+    for (size_t row = 0; row < 2; row ++)
+    {
+        for (size_t column = 0; column < 6; column ++)
+        {
+            output[row] -= state_feedback_gain_[row][column] * error[column];
+        }
+    }
+
+    /*
+     *  The forward output takes the place of the X position and
+     *  Y attitude controller outputs, and the turning output takes
+     *  the place of the Z attitude controller output.
+     */
+    output_position_x_ = Type(0);
+    output_attitude_y_ = output[0];
+    output_attitude_z_ = output[1];
 }
 
+template<typename Type>
 void
-Controller::updateActiveStatus(const IMUData& imu_data)
+BasicController<Type>::updateActiveStatus(const IMUData& imu_data)
 {
     /*
      *  Check Y attitude (pitch)
@@ -641,6 +733,13 @@ Controller::updateActiveStatus(const IMUData& imu_data)
             pid_controller_position_x_.resetErrorIntegral();
             pid_controller_attitude_y_.resetErrorIntegral();
             pid_controller_attitude_z_.resetErrorIntegral();
+
+            /*
+             *  Hold the current Z attitude in the state-feedback
+             *  controller mode.
+             */
+            attitude_z_origin_pending_ = true;
+            attitude_z_reference_origin_ = controller_reference_.attitude_z;
         }
 
         /*
@@ -658,5 +757,142 @@ Controller::updateActiveStatus(const IMUData& imu_data)
         }
     }
 }
+
+template<typename Type>
+void
+BasicController<Type>::updateControllerParameter()
+{
+    /*
+     *  Return if the controller parameter struct in the class member
+     *  controller parameter struct sequence lock has already been applied.
+     */
+    if (seqlock_controller_parameter_.getSequence() == sequence_controller_parameter_)
+    {
+        return;
+    }
+
+    /*
+     *  Keep the controller parameter struct applied so far, and read the
+     *  controller parameter struct snapshot from the class member controller
+     *  parameter struct sequence lock into the class member controller
+     *  parameter struct. The first update applies all entries.
+     */
+    const ControllerParameter controller_parameter_applied = controller_parameter_;
+    const bool initial = sequence_controller_parameter_ == 0;
+    sequence_controller_parameter_ = seqlock_controller_parameter_.read(controller_parameter_);
+
+    /*
+     *  Apply the Z attitude open-loop controller gain.
+     */
+    open_loop_controller_attitude_z_.setGain(controller_parameter_.attitude_z_gain_open_loop);
+
+    /*
+     *  Apply the PID controller gains. Setting the gain of a PID controller
+     *  resets its integrated error, so only the gains that differ from the
+     *  applied ones are set, such that an unchanged gain never disturbs its
+     *  PID controller.
+     */
+    if (initial || controller_parameter_.pid_controller_gain_attitude_y
+            != controller_parameter_applied.pid_controller_gain_attitude_y)
+    {
+        pid_controller_attitude_y_.setGain(controller_parameter_.pid_controller_gain_attitude_y);
+    }
+
+    if (initial || controller_parameter_.pid_controller_gain_attitude_z
+            != controller_parameter_applied.pid_controller_gain_attitude_z)
+    {
+        pid_controller_attitude_z_.setGain(controller_parameter_.pid_controller_gain_attitude_z);
+    }
+
+    if (initial || controller_parameter_.pid_controller_gain_position_x
+            != controller_parameter_applied.pid_controller_gain_position_x)
+    {
+        pid_controller_position_x_.setGain(controller_parameter_.pid_controller_gain_position_x);
+    }
+
+    /*
+     *  Apply the PID controller saturations.
+     */
+    pid_controller_attitude_y_.setSaturation(controller_parameter_.pid_controller_saturation_attitude_y);
+    pid_controller_attitude_z_.setSaturation(controller_parameter_.pid_controller_saturation_attitude_z);
+    pid_controller_position_x_.setSaturation(controller_parameter_.pid_controller_saturation_position_x);
+
+    /*
+     *  Convert the state-feedback gain struct in the class member
+     *  controller parameter struct to the class member state-feedback
+     *  gain matrix.
+     */
+    for (size_t column = 0; column < 6; column ++)
+    {
+        state_feedback_gain_[0][column] = Type(controller_parameter_.state_feedback_gain.forward[column]);
+        state_feedback_gain_[1][column] = Type(controller_parameter_.state_feedback_gain.turning[column]);
+    }
+}
+
+template<typename Type>
+void
+BasicController<Type>::updateControllerReference()
+{
+    /*
+     *  Return if the controller reference struct in the class member
+     *  controller reference struct sequence lock has already been applied.
+     */
+    if (seqlock_controller_reference_.getSequence() == sequence_controller_reference_)
+    {
+        return;
+    }
+
+    /*
+     *  Keep the controller reference struct applied so far, and read the
+     *  controller reference struct snapshot from the class member controller
+     *  reference struct sequence lock into the class member controller
+     *  reference struct. The first update applies all entries.
+     */
+    const ControllerReference controller_reference_applied = controller_reference_;
+    const bool initial = sequence_controller_reference_ == 0;
+    sequence_controller_reference_ = seqlock_controller_reference_.read(controller_reference_);
+
+    /*
+     *  Apply the controller references, the Z attitude reference to both
+     *  the Z attitude open-loop and PID controllers. Setting the reference
+     *  of a PID controller resets its integrated error, so only the
+     *  references that differ from the applied ones are set.
+     */
+    if (initial || controller_reference_.attitude_z != controller_reference_applied.attitude_z)
+    {
+        open_loop_controller_attitude_z_.setReference(controller_reference_.attitude_z);
+        pid_controller_attitude_z_.setReference(controller_reference_.attitude_z);
+
+        /*
+         *  Turn the state-feedback controller by the Z attitude
+         *  reference change from the current Z attitude, keeping
+         *  the reference of a pending origin.
+         */
+        if (!attitude_z_origin_pending_)
+        {
+            attitude_z_origin_pending_ = true;
+            attitude_z_reference_origin_ = initial ? controller_reference_.attitude_z :
+                    controller_reference_applied.attitude_z;
+        }
+    }
+
+    if (initial || controller_reference_.attitude_y != controller_reference_applied.attitude_y)
+    {
+        pid_controller_attitude_y_.setReference(controller_reference_.attitude_y);
+    }
+
+    if (initial || controller_reference_.position_x != controller_reference_applied.position_x)
+    {
+        pid_controller_position_x_.setReference(controller_reference_.position_x);
+    }
+}
+
+/*
+ *  Explicitly instantiate the controller class
+ *  for the supported scalar types.
+ */
+template class BasicController<double>;
+template class BasicController<float>;
+template class BasicController<Q16>;
 }   // namespace firmware
 }   // namespace biped
@@ -13,6 +13,11 @@
 #ifndef CONTROLLER_CONTROLLER_H_
 #define CONTROLLER_CONTROLLER_H_
 
+/*
+ *  External headers.
+ */
+#include <mutex>
+
 /*
  *  Project headers.
  */
@@ -20,6 +25,7 @@
 #include "controller/open_loop_controller.h"
 #include "controller/pid_controller.h"
 #include "platform/neopixel.h"
+#include "utility/seqlock.hpp"
 
 /*
  *  Biped namespace.
@@ -32,12 +38,33 @@ namespace biped
 namespace firmware
 {
 /**
+ *  @tparam Type Scalar type.
  *  @brief  Controller class.
  *
  *  This class provides functions for creating a controller,
  *  which produces actuation commands from a series of sensor data.
+ *
+ *  The controller, along with its PID and open-loop controllers,
+ *  is templated on the scalar type of its arithmetic. The sensor
+ *  data, parameter, and actuation command structs remain in double,
+ *  as they are shared with the ground station, and are converted
+ *  to and from the scalar type at the controller boundaries. Refer
+ *  to the parameter header for the scalar type used by the firmware.
+ *
+ *  The actuation command, controller parameter, and controller
+ *  reference structs are shared with other tasks through sequence
+ *  locks. The controller parameter and reference set by other tasks
+ *  are applied at the start of the next controller execution, such
+ *  that the real-time task never observes a partially set struct
+ *  and is never blocked by the other tasks.
+ *
+ *  In the state-feedback controller mode, the X position, Y attitude,
+ *  and Z attitude controllers are replaced by a single state-feedback
+ *  law, executed in the fast domain as a product of the state-feedback
+ *  gain matrix and the state error vector.
  */
-class Controller
+template<typename Type>
+class BasicController
 {
 public:
 
@@ -48,7 +75,7 @@ public:
      *  Additionally, the constructor initializes and configures
      *  all controllers.
      */
-    Controller();
+    BasicController();
 
     /**
      *  @return Actuation command struct.
@@ -73,7 +100,8 @@ public:
      *  @return Controller parameter struct.
      *  @brief  Get the class member controller parameter struct.
      *
-     *  This function returns the class member controller parameter struct.
+     *  This function returns a snapshot of the most recently set
+     *  controller parameter struct.
      */
     ControllerParameter
     getControllerParameter() const;
@@ -82,7 +110,8 @@ public:
      *  @return Controller reference struct.
      *  @brief  Get the class member controller reference struct.
      *
-     *  This function returns the class member controller reference struct.
+     *  This function returns a snapshot of the most recently set
+     *  controller reference struct.
      */
     ControllerReference
     getControllerReference() const;
@@ -91,7 +120,9 @@ public:
      *  @param  controller_parameter Controller parameter struct.
      *  @brief  Set the controller parameter.
      *
-     *  This function sets the controller parameter.
+     *  This function sets the controller parameter, which is applied
+     *  at the start of the next controller execution. This function
+     *  may be called from any task.
      */
     void
     setControllerParameter(const ControllerParameter& controller_parameter);
@@ -100,7 +131,9 @@ public:
      *  @param  controller_reference Controller reference struct.
      *  @brief  Set the controller reference.
      *
-     *  This function sets the controller reference.
+     *  This function sets the controller reference, which is applied
+     *  at the start of the next controller execution. This function
+     *  may be called from any task.
      */
     void
     setControllerReference(const ControllerReference& controller_reference);
@@ -127,6 +160,20 @@ public:
     void
     control(const bool& fast_domain);
 
+    /**
+     *  @param  fast_domain Whether to perform fast domain control.
+     *  @param  imu_data IMU data struct.
+     *  @param  encoder_data Encoder data struct.
+     *  @brief  Execute the controller using the given sensor data.
+     *
+     *  This function executes the controller, for fast or slow
+     *  domain, using the given sensor data instead of the sensor
+     *  data from the sensor object, and populates the class member
+     *  actuation command struct.
+     */
+    void
+    control(const bool& fast_domain, const IMUData& imu_data, const EncoderData& encoder_data);
+
 private:
 
     /**
@@ -139,19 +186,66 @@ private:
     void
     updateActiveStatus(const IMUData& imu_data);
 
+    /**
+     *  @param  imu_data IMU data struct.
+     *  @param  encoder_data Encoder data struct.
+     *  @brief  Execute the state-feedback controller.
+     *
+     *  This function computes the state error vector from the given
+     *  sensor data and the class member controller reference struct,
+     *  and multiplies it with the class member state-feedback gain
+     *  matrix into the forward and turning controller outputs. The
+     *  Z attitude error is relative to the Z attitude taken when the
+     *  controller became active or the Z attitude reference changed
+     *  last, such that the drift of the Z attitude estimate only adds
+     *  up since then.
+     */
+    void
+    controlStateFeedback(const IMUData& imu_data, const EncoderData& encoder_data);
+
+    /**
+     *  @brief  Update the controller parameter.
+     *
+     *  This function applies the controller parameter struct in
+     *  the class member controller parameter struct sequence lock
+     *  to all controllers, if it has been set since last applied.
+     */
+    void
+    updateControllerParameter();
+
+    /**
+     *  @brief  Update the controller reference.
+     *
+     *  This function applies the controller reference struct in
+     *  the class member controller reference struct sequence lock
+     *  to all controllers, if it has been set since last applied.
+     */
+    void
+    updateControllerReference();
+
     bool active_;   //!< Controller active flag.
     ActuationCommand actuation_command_;    //!< Actuation command struct.
+    double attitude_z_origin_;  //!< Z attitude the state-feedback Z attitude error is relative to, in radians.
+    bool attitude_z_origin_pending_;    //!< Whether to take the current Z attitude as the origin.
+    double attitude_z_reference_origin_;    //!< Z attitude reference at the origin, in radians.
     ControllerParameter controller_parameter_;    //!< Controller parameter struct.
     ControllerReference controller_reference_;    //!< Controller reference struct.
+    std::mutex mutex_seqlock_write_;    //!< Controller parameter and reference sequence lock writing mutex.
     std::shared_ptr<NeoPixel::Frame> neopixel_frame_active_; //!< NeoPixel frame for controller active status.
     std::shared_ptr<NeoPixel::Frame> neopixel_frame_inactive_; //!< NeoPixel frame for controller inactive status.
-    double output_position_x_;   //!< X position (forward/backward) controller output.
-    double output_attitude_y_;   //!< Y attitude (pitch) controller output.
-    double output_attitude_z_;   //!< Z attitude (yaw) controller output.
-    OpenLoopController open_loop_controller_attitude_z_; //!< Z attitude (yaw) open-loop controller object.
-    PIDController pid_controller_attitude_y_;   //!< Y attitude (pitch) PID controller object.
-    PIDController pid_controller_attitude_z_;   //!< Z attitude (yaw) PID controller object.
-    PIDController pid_controller_position_x_; //!< X position (forward/backward) PID controller object.
+    Type output_position_x_;   //!< X position (forward/backward) controller output.
+    Type output_attitude_y_;   //!< Y attitude (pitch) controller output.
+    Type output_attitude_z_;   //!< Z attitude (yaw) controller output.
+    OpenLoopController<Type> open_loop_controller_attitude_z_; //!< Z attitude (yaw) open-loop controller object.
+    PIDController<Type> pid_controller_attitude_y_;   //!< Y attitude (pitch) PID controller object.
+    PIDController<Type> pid_controller_attitude_z_;   //!< Z attitude (yaw) PID controller object.
+    PIDController<Type> pid_controller_position_x_; //!< X position (forward/backward) PID controller object.
+    Type state_feedback_gain_[2][6];    //!< State-feedback gain matrix, forward and turning rows.
+    Seqlock<ActuationCommand> seqlock_actuation_command_;   //!< Actuation command struct sequence lock.
+    Seqlock<ControllerParameter> seqlock_controller_parameter_; //!< Controller parameter struct sequence lock.
+    Seqlock<ControllerReference> seqlock_controller_reference_; //!< Controller reference struct sequence lock.
+    uint32_t sequence_controller_parameter_;    //!< Sequence number of the applied controller parameter struct.
+    uint32_t sequence_controller_reference_;    //!< Sequence number of the applied controller reference struct.
 };
 }   // namespace firmware
 }   // namespace biped
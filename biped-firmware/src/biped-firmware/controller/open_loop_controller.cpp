@@ -12,6 +12,7 @@
  */
 #include "common/parameter.h"
 #include "controller/open_loop_controller.h"
+#include "utility/fixed_point.hpp"
 #include "utility/math.h"
 
 /*
@@ -24,12 +25,16 @@ namespace biped
  */
 namespace firmware
 {
-OpenLoopController::OpenLoopController() : gain_(0), reference_(0)
+template<typename Type>
+OpenLoopController<Type>::OpenLoopController() : gain_(0), reference_(0),
+        saturation_input_lower_(0), saturation_input_upper_(0), saturation_output_lower_(0),
+        saturation_output_upper_(0)
 {
 }
 
-double
-OpenLoopController::getReference() const
+template<typename Type>
+Type
+OpenLoopController<Type>::getReference() const
 {
     /*
      *  Return the class member open-loop controller reference (R).
@@ -39,8 +44,9 @@ OpenLoopController::getReference() const
     return reference_;
 }
 
+template<typename Type>
 void
-OpenLoopController::setGain(const double& gain)
+OpenLoopController<Type>::setGain(const Type& gain)
 {
     /*
      *  Set the class member open-loop controller gain.
@@ -50,19 +56,24 @@ OpenLoopController::setGain(const double& gain)
     gain_ = gain;
 }
 
+template<typename Type>
 void
-OpenLoopController::setSaturation(const ControllerSaturation& saturation)
+OpenLoopController<Type>::setSaturation(const ControllerSaturation& saturation)
 {
     /*
      *  Set the class member open-loop controller saturation.
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    saturation_ = saturation;
+    saturation_input_lower_ = saturation.input_lower;
+    saturation_input_upper_ = saturation.input_upper;
+    saturation_output_lower_ = saturation.output_lower;
+    saturation_output_upper_ = saturation.output_upper;
 }
 
+template<typename Type>
 void
-OpenLoopController::setReference(const double& reference)
+OpenLoopController<Type>::setReference(const Type& reference)
 {
     /*
      *  Set the class member open-loop controller reference (R).
@@ -72,8 +83,9 @@ OpenLoopController::setReference(const double& reference)
     reference_ = reference;
 }
 
-double
-OpenLoopController::control()
+template<typename Type>
+Type
+OpenLoopController<Type>::control()
 {
     /*
      *  Calculate the open-loop controller output.
@@ -89,7 +101,7 @@ OpenLoopController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double output = gain_*clamp(reference_, saturation_.input_lower, saturation_.input_upper);
+    Type output = gain_*clamp(reference_, saturation_input_lower_, saturation_input_upper_);
 
     /*
      *  Return the output computed above clamped between the
@@ -99,7 +111,15 @@ OpenLoopController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    return clamp(output, saturation_.output_lower, saturation_.output_upper);
+    return clamp(output, saturation_output_lower_, saturation_output_upper_);
 }
+
+/*
+ *  Explicitly instantiate the open-loop controller class
+ *  for the supported scalar types.
+ */
+template class OpenLoopController<double>;
+template class OpenLoopController<float>;
+template class OpenLoopController<Q16>;
 }   // namespace firmware
 }   // namespace biped
@@ -30,14 +30,18 @@ namespace biped
 namespace firmware
 {
 /**
+ *  @tparam Type Scalar type.
  *  @brief  Open-loop controller class.
  *
  *  This class provides functions for creating
- *  an open-loop controller.
+ *  an open-loop controller. Same as the PID controller,
+ *  the controller is templated on the scalar type of its
+ *  arithmetic.
  *
  *  Learn more about open-loop controllers here:
  *  https://en.wikipedia.org/wiki/Open-loop_controller
  */
+template<typename Type>
 class OpenLoopController
 {
 public:
@@ -57,7 +61,7 @@ public:
      *
      *  Refer to Lecture 13 for the variable definitions.
      */
-    double
+    Type
     getReference() const;
 
     /**
@@ -67,7 +71,7 @@ public:
      *  This function sets the open-loop controller gain.
      */
     void
-    setGain(const double& gain);
+    setGain(const Type& gain);
 
     /**
      *  @param  saturation Controller saturation struct.
@@ -87,7 +91,7 @@ public:
      *  Refer to Lecture 13 for the variable definitions.
      */
     void
-    setReference(const double& reference);
+    setReference(const Type& reference);
 
     /**
      *  @return Output (u).
@@ -98,14 +102,17 @@ public:
      *
      *  Refer to Lecture 13 for the variable definitions.
      */
-    double
+    Type
     control();
 
 private:
 
-    double gain_; //!< Open-loop controller gain.
-    double reference_;  //!< Open-loop controller reference (R).
-    ControllerSaturation saturation_; //!< Controller saturation struct.
+    Type gain_; //!< Open-loop controller gain.
+    Type reference_;  //!< Open-loop controller reference (R).
+    Type saturation_input_lower_;   //!< Input saturation lower bound.
+    Type saturation_input_upper_;   //!< Input saturation upper bound.
+    Type saturation_output_lower_;  //!< Output saturation lower bound.
+    Type saturation_output_upper_;  //!< Output saturation upper bound.
 };
 }   // namespace firmware
 }   // namespace biped
@@ -13,6 +13,7 @@
 #include "common/parameter.h"
 #include "controller/pid_controller.h"
 #include "platform/serial.h"
+#include "utility/fixed_point.hpp"
 #include "utility/math.h"
 
 /*
@@ -25,13 +26,17 @@ namespace biped
  */
 namespace firmware
 {
-PIDController::PIDController() : state_(0), reference_(0), period_(0), error_differential_(0),
-        error_integral_(0)
+template<typename Type>
+PIDController<Type>::PIDController() : gain_proportional_(0), gain_integral_(0),
+        gain_differential_(0), gain_integral_max_(0), saturation_input_lower_(0),
+        saturation_input_upper_(0), saturation_output_lower_(0), saturation_output_upper_(0),
+        state_(0), reference_(0), period_(0), error_differential_(0), error_integral_(0)
 {
 }
 
-double
-PIDController::getReference() const
+template<typename Type>
+Type
+PIDController<Type>::getReference() const
 {
     /*
      *  Return the class member PID controller reference (R).
@@ -41,15 +46,19 @@ PIDController::getReference() const
     return reference_;
 }
 
+template<typename Type>
 void
-PIDController::setGain(const PIDControllerGain& gain)
+PIDController<Type>::setGain(const PIDControllerGain& gain)
 {
     /*
      *  Set the class member PID controller gain.
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-	gain_=gain;
+	gain_proportional_ = gain.proportional;
+	gain_integral_ = gain.integral;
+	gain_differential_ = gain.differential;
+	gain_integral_max_ = gain.integral_max;
     /*
      *  The existing integrated error (integral of e)
      *  becomes meaningless with new gains. Reset the
@@ -60,19 +69,24 @@ PIDController::setGain(const PIDControllerGain& gain)
 	error_integral_=0;
 }
 
+template<typename Type>
 void
-PIDController::setSaturation(const ControllerSaturation& saturation)
+PIDController<Type>::setSaturation(const ControllerSaturation& saturation)
 {
     /*
      *  Set the class member PID controller saturation.
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-	saturation_=saturation;
+	saturation_input_lower_ = saturation.input_lower;
+	saturation_input_upper_ = saturation.input_upper;
+	saturation_output_lower_ = saturation.output_lower;
+	saturation_output_upper_ = saturation.output_upper;
 }
 
+template<typename Type>
 void
-PIDController::setState(const double& state)
+PIDController<Type>::setState(const Type& state)
 {
     /*
      *  Set the class member plant state input (Y).
@@ -82,8 +96,9 @@ PIDController::setState(const double& state)
 	state_=state;
 }
 
+template<typename Type>
 void
-PIDController::setReference(const double& reference)
+PIDController<Type>::setReference(const Type& reference)
 {
     /*
      *  Set the PID controller reference (R).
@@ -101,8 +116,9 @@ PIDController::setReference(const double& reference)
 	error_integral_=0;
 }
 
+template<typename Type>
 void
-PIDController::setPeriod(const double& period)
+PIDController<Type>::setPeriod(const Type& period)
 {
     /*
      *  Set the class member PID controller period.
@@ -120,8 +136,9 @@ PIDController::setPeriod(const double& period)
 	error_integral_=0;
 }
 
+template<typename Type>
 void
-PIDController::setErrorDifferential(const double& error_differential)
+PIDController<Type>::setErrorDifferential(const Type& error_differential)
 {
     /*
      *  Set the class member error derivative input (delta e).
@@ -131,8 +148,9 @@ PIDController::setErrorDifferential(const double& error_differential)
 	error_differential_=error_differential;
 }
 
+template<typename Type>
 void
-PIDController::resetErrorIntegral()
+PIDController<Type>::resetErrorIntegral()
 {
     /*
      *  Reset the class member integrated error (integral of e) to 0.
@@ -142,16 +160,17 @@ PIDController::resetErrorIntegral()
 	error_integral_=0;
 }
 
-double
-PIDController::control()
+template<typename Type>
+Type
+PIDController<Type>::control()
 {
     /*
      *  Validate PID controller period.
      */
-    if (period_ <= 0)
+    if (period_ <= Type(0))
     {
         Serial(LogLevel::error) << "Invalid period.";
-        return 0;
+        return Type(0);
     }
 
     /*
@@ -168,7 +187,7 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double current_error=clamp(state_-reference_,saturation_.input_lower,saturation_.input_upper);
+    Type current_error=clamp(state_-reference_,saturation_input_lower_,saturation_input_upper_);
 
     /*
      *  Calculate the new discrete integral of error (integral of e).
@@ -189,7 +208,7 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    error_integral_=clamp(error_integral_+current_error*period_,-gain_.integral_max,gain_.integral_max);
+    error_integral_=clamp(error_integral_+current_error*period_,-gain_integral_max_,gain_integral_max_);
     /*
      *  Calculate the proportional output using the current error (e).
      *
@@ -197,7 +216,7 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double proportional_output=current_error*gain_.proportional;
+    Type proportional_output=current_error*gain_proportional_;
     /*
      *  Calculate the integral output using the new discrete integral
      *  of error (integral of e).
@@ -206,7 +225,7 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double integral_output=error_integral_*gain_.integral;
+    Type integral_output=error_integral_*gain_integral_;
     /*
      *  Calculate the differential output using the class member
      *  differential error variable.
@@ -228,14 +247,14 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double differential_output=error_differential_*gain_.differential;
+    Type differential_output=error_differential_*gain_differential_;
     /*
      *  Sum up all of the above proportional, integral, and
      *  differential output.
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    double pid_sum = proportional_output+integral_output+differential_output;
+    Type pid_sum = proportional_output+integral_output+differential_output;
 
     /*
      *  Using the clamp function in the math header, return the
@@ -245,7 +264,15 @@ PIDController::control()
      *
      *  TODO LAB 7 YOUR CODE HERE.
      */
-    return clamp(pid_sum,saturation_.output_lower,saturation_.output_upper);
+    return clamp(pid_sum,saturation_output_lower_,saturation_output_upper_);
 }
+
+/*
+ *  Explicitly instantiate the PID controller class
+ *  for the supported scalar types.
+ */
+template class PIDController<double>;
+template class PIDController<float>;
+template class PIDController<Q16>;
 }   // namespace firmware
 }   // namespace biped
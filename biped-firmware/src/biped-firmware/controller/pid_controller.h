@@ -30,6 +30,7 @@ namespace biped
 namespace firmware
 {
 /**
+ *  @tparam Type Scalar type.
  *  @brief  PID controller class.
  *
  *  This class provides functions for creating
@@ -37,9 +38,16 @@ namespace firmware
  *  minimizes the error between the plant state input
  *  (Y) and a reference (R) in a closed loop.
  *
+ *  The controller is templated on the scalar type of
+ *  its arithmetic, e.g., double, float, or a fixed-point
+ *  type, such that the control pipeline can run in the
+ *  native precision of the target. The gain and saturation
+ *  structs are converted to the scalar type when set.
+ *
  *  Refer to Lecture 13 for the definition of the PID
  *  controller.
  */
+template<typename Type>
 class PIDController
 {
 public:
@@ -59,7 +67,7 @@ public:
      *
      *  Refer to Lecture 13 for the variable definitions.
      */
-    double
+    Type
     getReference() const;
 
     /**
@@ -90,7 +98,7 @@ public:
      *  Refer to Lecture 13 for the variable definitions.
      */
     void
-    setState(const double& state);
+    setState(const Type& state);
 
     /**
      *  @param  reference PID controller reference (R).
@@ -101,7 +109,7 @@ public:
      *  Refer to Lecture 13 for the variable definitions.
      */
     void
-    setReference(const double& reference);
+    setReference(const Type& reference);
 
     /**
      *  @param  period PID controller period, in seconds.
@@ -110,7 +118,7 @@ public:
      *  This function sets the PID controller period.
      */
     void
-    setPeriod(const double& period);
+    setPeriod(const Type& period);
 
     /**
      *  @param  error_differential Error derivative input (delta e).
@@ -121,7 +129,7 @@ public:
      *  Refer to Lecture 13 for the variable definitions.
      */
     void
-    setErrorDifferential(const double& error_differential);
+    setErrorDifferential(const Type& error_differential);
 
     /**
      *  @brief  Reset the integrated error (integral of e).
@@ -142,18 +150,24 @@ public:
      *
      *  Refer to Lecture 13 for the variable definitions.
      */
-    double
+    Type
     control();
 
 private:
 
-    PIDControllerGain gain_; //!< PID controller gain struct.
-    ControllerSaturation saturation_; //!< Controller saturation struct.
-    double state_;   //!< Plant state input (Y).
-    double reference_;  //!< PID controller reference (R).
-    double period_;  //!< PID controller period, in seconds.
-    double error_differential_;  //!< Error derivative input (delta e).
-    double error_integral_;  //!< Integrated error (integral of e).
+    Type gain_proportional_;    //!< Proportional gain.
+    Type gain_integral_;    //!< Integral gain.
+    Type gain_differential_;    //!< Differential gain.
+    Type gain_integral_max_;    //!< Maximum integrated error.
+    Type saturation_input_lower_;   //!< Input saturation lower bound.
+    Type saturation_input_upper_;   //!< Input saturation upper bound.
+    Type saturation_output_lower_;  //!< Output saturation lower bound.
+    Type saturation_output_upper_;  //!< Output saturation upper bound.
+    Type state_;   //!< Plant state input (Y).
+    Type reference_;  //!< PID controller reference (R).
+    Type period_;  //!< PID controller period, in seconds.
+    Type error_differential_;  //!< Error derivative input (delta e).
+    Type error_integral_;  //!< Integrated error (integral of e).
 };
 }   // namespace firmware
 }   // namespace biped
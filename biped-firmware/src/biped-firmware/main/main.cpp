@@ -22,6 +22,7 @@
 #include "actuator/actuator.h"
 #include "common/global.h"
 #include "common/pin.h"
+#include "controller/camera_rate_controller.h"
 #include "controller/controller.h"
 #include "network/udp.h"
 #include "platform/camera.h"
@@ -138,6 +139,21 @@ setup()
     camera_ = std::make_shared<Camera>();
     neopixel_ = std::make_shared<NeoPixel>();
 
+    /*
+     *  Instantiate the camera pipeline global object with the camera as its camera
+     *  frame source and the Arduino microsecond clock.
+     */
+    camera_pipeline_ = std::make_shared<CameraPipeline<Camera, FreeRTOSQueue,
+            CameraParameter::frame_buffer_count>>(*camera_, &micros);
+
+    /*
+     *  Instantiate the camera rate controller global object, and publish its
+     *  initial camera setting and camera bandwidth budget.
+     */
+    camera_rate_controller_ = std::make_shared<CameraRateController>();
+    seqlock_camera_setting_.write(camera_rate_controller_->getSetting());
+    budget_camera_ = static_cast<uint32_t>(camera_rate_controller_->getBudget());
+
     /*
      *  Instantiate the timer global object using the C++ STL
      *  std::make_shared function.
@@ -214,6 +230,12 @@ setup()
     controller_->setPeriod(PeriodParameter::fast, true);
     controller_->setPeriod(PeriodParameter::slow, false);
 
+    /*
+     *  Register the sensing and control jobs of the real-time task
+     *  to the real-time task scheduler, before the timer starts.
+     */
+    realTimeTaskInitialization();
+
     /*
      *  Instantiate the planner global object using the C++ STL std::make_shared
      *  function. Note that the planner global shared pointer is a base pointer
@@ -388,9 +410,18 @@ setup()
     xTaskCreatePinnedToCore(&realTimeTask, "realTimeTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_max-1, &task_handle_real_time_, TaskParameter::core_1);
     xTaskCreatePinnedToCore(&udpReadBipedMessageTask, "udpReadBipedMessageTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_udp_read_biped_message_, TaskParameter::core_1);
     xTaskCreatePinnedToCore(&udpWriteBipedMessageTask, "udpWriteBipedMessageTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_udp_write_biped_message_, TaskParameter::core_1);
-    xTaskCreatePinnedToCore(&udpWriteCameraTask, "udpWriteCameraTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_udp_write_camera_, TaskParameter::core_1);
     xTaskCreatePinnedToCore(&networkTask, "networkTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_network_, TaskParameter::core_1);
 
+    /*
+     *  Create the camera pipeline tasks, i.e., the camera capture and encode tasks along
+     *  with the camera UDP write task, with the lowest priority, and pin them to core 0,
+     *  such that the camera pipeline stages overlap one another and no longer share the
+     *  core of the real-time task.
+     */
+    xTaskCreatePinnedToCore(&cameraCaptureTask, "cameraCaptureTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_camera_capture_, TaskParameter::core_0);
+    xTaskCreatePinnedToCore(&cameraEncodeTask, "cameraEncodeTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_camera_encode_, TaskParameter::core_0);
+    xTaskCreatePinnedToCore(&udpWriteCameraTask, "udpWriteCameraTask", TaskParameter::stack_size, nullptr, TaskParameter::priority_min, &task_handle_udp_write_camera_, TaskParameter::core_0);
+
     /*
      *  Using the timer global shared pointer, set the hardware timer interval to be the fast
      *  domain period. Be aware of the unit conversions and use the appropriate functions
@@ -22,7 +22,7 @@ namespace biped
  */
 namespace firmware
 {
-UDP::UDP()
+UDP::UDP() : port_remote_(0), remote_(false)
 {
 }
 
@@ -140,5 +140,53 @@ UDP::writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8
      */
     return bytes;
 }
+
+size_t
+UDP::writeBuffer(const uint8_t* buffer, const size_t& size)
+{
+    /*
+     *  Lock the UDP write mutex.
+     */
+    std::lock_guard<std::mutex> lock(mutex_udp_write_);
+
+    /*
+     *  Validate the remote endpoint.
+     */
+    if (!remote_)
+    {
+        return 0;
+    }
+
+    /*
+     *  Write the given buffer to the cached remote endpoint in
+     *  a UDP packet.
+     */
+    udp_.beginPacket(ip_address_remote_, port_remote_);
+    const size_t bytes = udp_.write(buffer, size);
+    udp_.endPacket();
+
+    /*
+     *  Return the bytes written.
+     */
+    return bytes;
+}
+
+bool
+UDP::setRemote(const std::string& ip_remote, const uint16_t& port)
+{
+    /*
+     *  Lock the UDP write mutex.
+     */
+    std::lock_guard<std::mutex> lock(mutex_udp_write_);
+
+    /*
+     *  Convert the given remote IP address string to the class
+     *  member IP address object, and cache the given port.
+     */
+    remote_ = ip_address_remote_.fromString(ip_remote.c_str());
+    port_remote_ = port;
+
+    return remote_;
+}
 }   // namespace firmware
 }   // namespace biped
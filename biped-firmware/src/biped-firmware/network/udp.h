@@ -113,8 +113,39 @@ public:
     writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8_t* buffer,
             const size_t& size);
 
+    /**
+     *  @param  buffer Buffer pointer.
+     *  @param  size Size of the buffer, in bytes.
+     *  @return Size written, in bytes.
+     *  @brief  UDP buffer writing function to the remote endpoint.
+     *
+     *  This function writes a given buffer with the given size to
+     *  the remote endpoint set by the remote endpoint setting
+     *  function, without parsing the remote IP address or allocating
+     *  memory. This function writes nothing if the remote endpoint
+     *  has not been set.
+     */
+    size_t
+    writeBuffer(const uint8_t* buffer, const size_t& size);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @return Whether the remote IP address is valid.
+     *  @brief  Set the remote endpoint.
+     *
+     *  This function parses the given remote IP address once and
+     *  caches it, along with the given port, as the remote endpoint
+     *  for the buffer writing function to the remote endpoint.
+     */
+    bool
+    setRemote(const std::string& ip_remote, const uint16_t& port);
+
 private:
 
+    IPAddress ip_address_remote_;   //!< Remote endpoint IP address object.
+    uint16_t port_remote_;  //!< Remote endpoint UDP port.
+    bool remote_;   //!< Whether the remote endpoint has been set.
     WiFiUDP udp_;   //!< Arduino Wi-Fi UDP driver object.
     std::mutex mutex_udp_read_; //!< UDP reading mutex.
     std::mutex mutex_udp_write_;    //!< UDP writing mutex.
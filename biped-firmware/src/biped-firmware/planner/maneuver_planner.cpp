@@ -7,6 +7,11 @@
  *  This file implements the maneuver planner class.
  */
 
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+
 /*
  *  Project headers.
  */
@@ -65,7 +65,7 @@ Camera::Camera()
     camera_config.xclk_freq_hz = CameraParameter::xclk_frequency;
     camera_config.frame_size = FRAMESIZE_HVGA;
     camera_config.pixel_format = PIXFORMAT_JPEG;
-    camera_config.grab_mode = CAMERA_GRAB_WHEN_EMPTY;
+    camera_config.grab_mode = CAMERA_GRAB_LATEST;
     camera_config.fb_location = CAMERA_FB_IN_DRAM;
     camera_config.jpeg_quality = CameraParameter::jpeg_quality;
     camera_config.fb_count = CameraParameter::frame_buffer_count;
@@ -99,39 +99,103 @@ Camera::Camera()
     }
 }
 
-size_t
-Camera::SendJPGFrameOverUDP(const std::shared_ptr<UDP> udp, const std::string& ip_remote,
-        const uint16_t& port)
+bool
+Camera::capture(CameraFrame& frame)
 {
     /*
-     *  Declare variables.
+     *  Obtain the camera frame buffer pointer.
      */
-    size_t bytes = 0;
-    std::string frame_boundary = NetworkParameter::camera_frame_boundary;
-    camera_fb_t *frame_buffer = nullptr;
-    size_t frame_packet_count = 0;
-    uint8_t *jpg_buffer = nullptr;
-    size_t jpg_buffer_size = 0;
+    camera_fb_t *frame_buffer = esp_camera_fb_get();
 
     /*
-     *  If the given UDP shared pointer is a null pointer, return.
+     *  If the obtained camera frame buffer pointer is a null pointer, return.
      */
-    if (!udp)
+    if (!frame_buffer)
     {
-        return bytes;
+        return false;
     }
 
     /*
-     *  Obtain the camera frame buffer pointer.
+     *  Keep the frame buffer as the camera frame handle, and obtain the camera
+     *  frame capture timestamp, in microseconds.
      */
-    frame_buffer = esp_camera_fb_get();
+    frame.handle = frame_buffer;
+    frame.timestamp = static_cast<unsigned long long>(frame_buffer->timestamp.tv_sec) * 1000000
+            + frame_buffer->timestamp.tv_usec;
+
+    return true;
+}
 
+bool
+Camera::configure(const CameraSetting& setting)
+{
     /*
-     *  If the obtained camera frame buffer pointer is a null pointer, return.
+     *  Declare ESP-IDF camera frame size.
+     */
+    framesize_t frame_size = FRAMESIZE_HVGA;
+
+    /*
+     *  Obtain ESP-IDF camera sensor pointer.
+     */
+    sensor_t *camera_sensor = esp_camera_sensor_get();
+
+    /*
+     *  If the ESP-IDF camera sensor pointer is a null pointer, return.
+     */
+    if (!camera_sensor)
+    {
+        return false;
+    }
+
+    /*
+     *  Map the camera frame size to the ESP-IDF camera frame size.
+     */
+    switch (setting.frame_size)
+    {
+        case CameraFrameSize::qqvga:
+        {
+            frame_size = FRAMESIZE_QQVGA;
+            break;
+        }
+        case CameraFrameSize::qvga:
+        {
+            frame_size = FRAMESIZE_QVGA;
+            break;
+        }
+        case CameraFrameSize::hvga:
+        {
+            frame_size = FRAMESIZE_HVGA;
+            break;
+        }
+        default:
+        {
+            Serial(LogLevel::warn) << "Invalid camera frame size.";
+            return false;
+        }
+    }
+
+    /*
+     *  Using the ESP-IDF camera sensor pointer, set the camera frame size and
+     *  the JPEG quality.
      */
+    if (camera_sensor->set_framesize(camera_sensor, frame_size) != 0
+            || camera_sensor->set_quality(camera_sensor, setting.jpeg_quality) != 0)
+    {
+        Serial(LogLevel::warn) << "Failed to configure camera.";
+        return false;
+    }
+
+    return true;
+}
+
+bool
+Camera::encode(CameraFrame& frame)
+{
+    camera_fb_t *frame_buffer = static_cast<camera_fb_t*>(frame.handle);
+
     if (!frame_buffer)
     {
-        return bytes;
+        return false;
     }
 
     if (frame_buffer->format != PIXFORMAT_JPEG)
@@ -140,20 +204,24 @@ Camera::SendJPGFrameOverUDP(const std::shared_ptr<UDP> udp, const std::string& i
          *  Convert the current frame buffer into JPG and store in the JPG buffer.
          */
         bool converted = frame2jpg(frame_buffer, CameraParameter::jpeg_quality_conversion,
-                &jpg_buffer, &jpg_buffer_size);
+                &frame.buffer, &frame.size);
 
         /*
-         *  Free the frame buffer.
+         *  Free the frame buffer right away, such that the camera driver can capture
+         *  into it while the JPG buffer is being transmitted.
          */
         esp_camera_fb_return(frame_buffer);
-        frame_buffer = nullptr;
+        frame.handle = nullptr;
+        frame.converted = converted;
 
         /*
          *  If the JPG conversion failed, return.
          */
         if (!converted)
         {
-            return bytes;
+            frame.buffer = nullptr;
+            frame.size = 0;
+            return false;
         }
     }
     else
@@ -161,44 +229,83 @@ Camera::SendJPGFrameOverUDP(const std::shared_ptr<UDP> udp, const std::string& i
         /*
          *  Set the JPG frame buffer directly as the frame buffer.
          */
-        jpg_buffer = frame_buffer->buf;
-        jpg_buffer_size = frame_buffer->len;
+        frame.buffer = frame_buffer->buf;
+        frame.size = frame_buffer->len;
     }
 
+    return true;
+}
+
+void
+Camera::release(CameraFrame& frame)
+{
     /*
-     *  Compute the number of camera frame packets and append it to the camera
-     *  frame boundary.
+     *  Free buffers.
      */
-    frame_packet_count = std::ceil(
-            static_cast<double>(jpg_buffer_size) / NetworkParameter::buffer_size_camera);
-    frame_boundary += static_cast<char>(frame_packet_count);
+    if (frame.handle)
+    {
+        esp_camera_fb_return(static_cast<camera_fb_t*>(frame.handle));
+        frame.handle = nullptr;
+    }
+    else if (frame.converted && frame.buffer)
+    {
+        free(frame.buffer);
+    }
 
+    frame.buffer = nullptr;
+    frame.converted = false;
+}
+
+size_t
+Camera::transmit(const CameraFrame& frame, const std::shared_ptr<UDP> udp,
+        const std::string& ip_remote, const uint16_t& port)
+{
     /*
-     *  Write camera frame boundary packet to UDP with the given remote IP address
-     *  and UDP port.
+     *  If the given UDP shared pointer or the JPG buffer is a null pointer, return.
      */
-    bytes += udp->write(ip_remote, port, frame_boundary);
+    if (!udp || !frame.buffer)
+    {
+        return 0;
+    }
 
     /*
-     *  Write the JPG buffer to UDP with the given remote IP address and UDP port.
+     *  Using the class member camera chunker, write the JPG buffer in chunks to UDP
+     *  with the given remote IP address and UDP port, each chunk with a camera chunk
+     *  header, such that the Biped ground station can reassemble the camera frame
+     *  despite lost or reordered chunks.
      */
-    bytes += udp->writeBuffer(ip_remote, port, jpg_buffer, jpg_buffer_size);
+    return chunker_.write(*udp, ip_remote, port, frame.buffer, frame.size, frame.timestamp);
+}
 
+size_t
+Camera::SendJPGFrameOverUDP(const std::shared_ptr<UDP> udp, const std::string& ip_remote,
+        const uint16_t& port)
+{
     /*
-     *  Free buffers.
+     *  Declare variables.
+     */
+    size_t bytes = 0;
+    CameraFrame frame;
+
+    /*
+     *  If the given UDP shared pointer is a null pointer, return.
      */
-    if (frame_buffer)
+    if (!udp)
     {
-        esp_camera_fb_return(frame_buffer);
-        frame_buffer = nullptr;
-        jpg_buffer = nullptr;
+        return bytes;
     }
-    else if (jpg_buffer)
+
+    /*
+     *  Capture, encode, and transmit the camera frame one after another, and then
+     *  free its buffers.
+     */
+    if (capture(frame) && encode(frame))
     {
-        free(jpg_buffer);
-        jpg_buffer = nullptr;
+        bytes += transmit(frame, udp, ip_remote, port);
     }
 
+    release(frame);
+
     /*
      *  Return bytes written.
      */
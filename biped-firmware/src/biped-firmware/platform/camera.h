@@ -17,6 +17,14 @@
  *  External headers.
  */
 #include <memory>
+#include <string>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "utility/camera_chunker.hpp"
+#include "utility/camera_pipeline.hpp"
 
 /*
  *  Biped namespace.
@@ -38,6 +46,8 @@ class UDP;
  *
  *  This class provides functions for obtaining camera frames
  *  from the ESP-IDF camera driver and sending them over UDP.
+ *  The capture, encode, transmit, and release functions make the
+ *  camera the source of the camera pipeline.
  */
 class Camera
 {
@@ -52,6 +62,70 @@ public:
      */
     Camera();
 
+    /**
+     *  @param  frame Camera frame struct.
+     *  @return Whether a camera frame was captured.
+     *  @brief  Capture a camera frame.
+     *
+     *  This function obtains a camera frame buffer from the ESP-IDF
+     *  camera driver, i.e., the latest camera frame, waiting until a
+     *  camera frame buffer is free, and keeps it as the camera frame
+     *  handle.
+     */
+    bool
+    capture(CameraFrame& frame);
+
+    /**
+     *  @param  setting Camera setting struct.
+     *  @return Whether the camera setting was applied.
+     *  @brief  Configure the camera.
+     *
+     *  This function sets the camera frame size and JPEG quality of
+     *  the given camera setting on the ESP-IDF camera sensor. The
+     *  frame rate is paced by the camera capture task.
+     */
+    bool
+    configure(const CameraSetting& setting);
+
+    /**
+     *  @param  frame Camera frame struct.
+     *  @return Whether the camera frame was encoded.
+     *  @brief  Encode a camera frame into JPG.
+     *
+     *  This function uses the camera frame buffer directly if it is
+     *  already in JPG. Otherwise, this function converts it into an
+     *  allocated JPG buffer, and returns the camera frame buffer to
+     *  the ESP-IDF camera driver right away.
+     */
+    bool
+    encode(CameraFrame& frame);
+
+    /**
+     *  @param  frame Camera frame struct.
+     *  @brief  Release the buffers of a camera frame.
+     *
+     *  This function returns the camera frame buffer to the ESP-IDF
+     *  camera driver, or frees the converted JPG buffer.
+     */
+    void
+    release(CameraFrame& frame);
+
+    /**
+     *  @param  frame Encoded camera frame struct.
+     *  @param  udp UDP object shared pointer.
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @return Size sent, in bytes.
+     *  @brief  Transmit an encoded camera frame over the given UDP interface.
+     *
+     *  This function sends the JPG buffer of the given camera frame
+     *  over the given UDP interface, in chunks of the camera buffer
+     *  size, each with a camera chunk header.
+     */
+    size_t
+    transmit(const CameraFrame& frame, const std::shared_ptr<UDP> udp,
+            const std::string& ip_remote, const uint16_t& port);
+
     /**
      *  @param  udp UDP object shared pointer.
      *  @param  ip_remote Remote IP address.
@@ -59,13 +133,16 @@ public:
      *  @return Size sent, in bytes.
      *  @brief  Send the camera frame in JPG over the given UDP interface.
      *
-     *  This function obtains the camera frame from the ESP-IDF camera
-     *  driver and sends the obtained camera frame in JPG over the
-     *  given UDP interface.
+     *  This function captures, encodes, and transmits a camera frame
+     *  one after another, without the camera pipeline.
      */
     size_t
     SendJPGFrameOverUDP(const std::shared_ptr<UDP> udp, const std::string& ip_remote,
             const uint16_t& port);
+
+private:
+
+    CameraChunker<NetworkParameter::buffer_size_camera> chunker_;   //!< Camera chunker.
 };
 }   // namespace firmware
 }   // namespace biped
@@ -22,6 +22,7 @@
 #include "platform/encoder.h"
 #include "platform/serial.h"
 #include "task/interrupt.h"
+#include "utility/math.h"
 
 /*
  *  Biped namespace.
@@ -33,7 +34,7 @@ namespace biped
  */
 namespace firmware
 {
-Encoder::Encoder() : steps_left_(0), steps_right_(0)
+Encoder::Encoder()
 {
     /*
      *  Using the Arduino pinMode function, set pin mode for
@@ -55,8 +56,23 @@ Encoder::Encoder() : steps_left_(0), steps_right_(0)
     pinMode(ESP32Pin::motor_right_encoder_b, INPUT_PULLUP);
 
     /*
-     *  Configure X velocity low-pass filter.
+     *  Synchronize the quadrature decoders with the current
+     *  encoder pin states, before the encoder interrupts are
+     *  attached.
      */
+    quadrature_decoder_left_.setState(digitalReadPairFromISR(ESP32Pin::motor_left_encoder_a,
+            ESP32Pin::motor_left_encoder_b));
+    quadrature_decoder_right_.setState(digitalReadPairFromISR(ESP32Pin::motor_right_encoder_a,
+            ESP32Pin::motor_right_encoder_b));
+
+    /*
+     *  Configure the velocity estimators and the X velocity
+     *  low-pass filter.
+     */
+    velocity_estimator_left_.setTimeout(
+            secondsToMicroseconds(EncoderParameter::velocity_timeout));
+    velocity_estimator_right_.setTimeout(
+            secondsToMicroseconds(EncoderParameter::velocity_timeout));
     low_pass_filter_velocity_x_.setBeta(EncoderParameter::low_pass_filter_beta);
 }
 
@@ -76,8 +92,8 @@ Encoder::read()
 {
     /*
      *  Set the left and right encoder steps in the class
-     *  member encoder data struct to be the class member
-     *  left and right encoder steps.
+     *  member encoder data struct to be the steps from the
+     *  class member left and right quadrature decoders.
      *
      *  Set the overall encoder steps in the class member
      *  encoder data struct to be the average between the
@@ -93,21 +109,27 @@ Encoder::read()
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
-    data_.steps_left = steps_left_;
-    data_.steps_right = steps_right_;
-    data_.steps = (steps_left_+steps_right_)/2;
+    const long steps_left = quadrature_decoder_left_.getSteps();
+    const long steps_right = quadrature_decoder_right_.getSteps();
+
+    data_.steps_left = steps_left;
+    data_.steps_right = steps_right;
+    data_.steps = (steps_left+steps_right)/2;
     data_.position_x = (data_.steps/EncoderParameter::steps_per_meter);
 
+    /*
+     *  Set the left and right illegal transitions in the class
+     *  member encoder data struct to be the illegal transitions
+     *  from the class member left and right quadrature decoders.
+     */
+    data_.transition_errors_left = quadrature_decoder_left_.getTransitionErrors();
+    data_.transition_errors_right = quadrature_decoder_right_.getTransitionErrors();
+
 }
 
 void
 Encoder::calculateVelocity()
 {
-    /*
-     *  Declare last overall encoder steps and set to 0.
-     */
-    static long steps_last = 0;
-
     /*
      *  Read encoders.
      *
@@ -116,114 +138,89 @@ Encoder::calculateVelocity()
     read();
 
     /*
-     *  Using the current overall encoder steps in the class member
-     *  encoder data struct, calculate the step changes since the last
-     *  overall encoder steps, convert the steps changes into meters using
-     *  the encoder parameters in the parameter header, calculate the X
-     *  velocity using the slow domain period, filter the calculated X velocity
-     *  using the low-pass filter, and set the X velocity in the class member
-     *  encoder data struct to the calculated X velocity.
-     *
-     *  Refer to the type header for the encoder data struct, the low-pass filter
-     *  header for the low-pass filter functions, and the parameter header for the
-     *  encoder and period parameters.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Take coherent snapshots of the left and right encoder steps
+     *  along with the timestamps of their last steps, and the current
+     *  timestamp, and estimate the left and right velocities using the
+     *  class member velocity estimators.
      */
-    double meters_since_last = (data_.steps - static_cast<double>(steps_last))/static_cast<double>(EncoderParameter::steps_per_meter);
-    data_.velocity_x = low_pass_filter_velocity_x_.filter(meters_since_last/PeriodParameter::slow);
+    const QuadratureDecoderData data_left = quadrature_decoder_left_.getData();
+    const QuadratureDecoderData data_right = quadrature_decoder_right_.getData();
+    const uint32_t timestamp = micros();
+    const TypeParameter::Scalar velocity_left = velocity_estimator_left_.estimate(data_left.steps,
+            data_left.timestamp, timestamp);
+    const TypeParameter::Scalar velocity_right = velocity_estimator_right_.estimate(
+            data_right.steps, data_right.timestamp, timestamp);
 
     /*
-     *  Update the last overall encoder steps local variable to be the current
-     *  overall encoder steps in the class member encoder data struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Average the left and right velocities, convert the average
+     *  velocity from steps into meters per second using the encoder
+     *  parameters in the parameter header, filter the converted X
+     *  velocity using the low-pass filter, and set the X velocity in
+     *  the class member encoder data struct to the filtered X velocity.
      */
-    steps_last = data_.steps;
+    const TypeParameter::Scalar velocity_x = (velocity_left + velocity_right)
+            / TypeParameter::Scalar(2) / TypeParameter::Scalar(EncoderParameter::steps_per_meter);
+    data_.velocity_x = static_cast<double>(low_pass_filter_velocity_x_.filter(velocity_x));
 }
 
 void IRAM_ATTR
 Encoder::onLeftA()
 {
     /*
-     *  Using the digitalReadFromISR function from the interrupt header, read the
-     *  left encoder pins and update the left encoder steps based on the pins read.
-     *
-     *  Learn more about the incremental rotary encoder here:
-     *  https://lastminuteengineers.com/rotary-encoder-arduino-tutorial/
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Using the digitalReadPairFromISR function from the interrupt header,
+     *  sample both left encoder pins at once and decode the transition using
+     *  the class member left quadrature decoder, timestamping the transition
+     *  using the Arduino micros function. Both left encoder interrupts share
+     *  the same decoder, as the transition table covers the edges of both
+     *  channels.
      */
-    int a = digitalReadFromISR(ESP32Pin::motor_left_encoder_a);
-    int b = digitalReadFromISR(ESP32Pin::motor_left_encoder_b);
-    if (b != a) {
-        steps_left_ = steps_left_ + 1;
-    } else {
-        steps_left_ = steps_left_ - 1;
-    }
+    quadrature_decoder_left_.decode(digitalReadPairFromISR(ESP32Pin::motor_left_encoder_a,
+            ESP32Pin::motor_left_encoder_b), micros());
 }
 
 void IRAM_ATTR
 Encoder::onLeftB()
 {
     /*
-     *  Using the digitalReadFromISR function from the interrupt header, read the
-     *  left encoder pins and update the left encoder steps based on the pins read.
-     *
-     *  Learn more about the incremental rotary encoder here:
-     *  https://lastminuteengineers.com/rotary-encoder-arduino-tutorial/
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Using the digitalReadPairFromISR function from the interrupt header,
+     *  sample both left encoder pins at once and decode the transition using
+     *  the class member left quadrature decoder, timestamping the transition
+     *  using the Arduino micros function. Both left encoder interrupts share
+     *  the same decoder, as the transition table covers the edges of both
+     *  channels.
      */
-    int a = digitalReadFromISR(ESP32Pin::motor_left_encoder_a);
-    int b = digitalReadFromISR(ESP32Pin::motor_left_encoder_b);
-    if (b != a) {
-        steps_left_ = steps_left_ - 1;
-    } else {
-        steps_left_ = steps_left_ + 1;
-    }
+    quadrature_decoder_left_.decode(digitalReadPairFromISR(ESP32Pin::motor_left_encoder_a,
+            ESP32Pin::motor_left_encoder_b), micros());
 }
 
 void IRAM_ATTR
 Encoder::onRightA()
 {
     /*
-     *  Using the digitalReadFromISR function from the interrupt header, read the
-     *  right encoder pins and update the right encoder steps based on the pins read.
-     *
-     *  Learn more about the incremental rotary encoder here:
-     *  https://lastminuteengineers.com/rotary-encoder-arduino-tutorial/
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Using the digitalReadPairFromISR function from the interrupt header,
+     *  sample both right encoder pins at once and decode the transition using
+     *  the class member right quadrature decoder, timestamping the transition
+     *  using the Arduino micros function. Both right encoder interrupts share
+     *  the same decoder, as the transition table covers the edges of both
+     *  channels.
      */
-    int a = digitalReadFromISR(ESP32Pin::motor_right_encoder_a);
-    int b = digitalReadFromISR(ESP32Pin::motor_right_encoder_b);
-    if (b != a) {
-        steps_right_ = steps_right_ - 1;
-    } else {
-        steps_right_ = steps_right_ + 1;
-    }
+    quadrature_decoder_right_.decode(digitalReadPairFromISR(ESP32Pin::motor_right_encoder_a,
+            ESP32Pin::motor_right_encoder_b), micros());
 }
 
 void IRAM_ATTR
 Encoder::onRightB()
 {
     /*
-     *  Using the digitalReadFromISR function from the interrupt header, read the
-     *  right encoder pins and update the right encoder steps based on the pins read.
-     *
-     *  Learn more about the incremental rotary encoder here:
-     *  https://lastminuteengineers.com/rotary-encoder-arduino-tutorial/
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Using the digitalReadPairFromISR function from the interrupt header,
+     *  sample both right encoder pins at once and decode the transition using
+     *  the class member right quadrature decoder, timestamping the transition
+     *  using the Arduino micros function. Both right encoder interrupts share
+     *  the same decoder, as the transition table covers the edges of both
+     *  channels.
      */
-    int a = digitalReadFromISR(ESP32Pin::motor_right_encoder_a);
-    int b = digitalReadFromISR(ESP32Pin::motor_right_encoder_b);
-    if (b != a) {
-        steps_right_ = steps_right_ + 1;
-    } else {
-        steps_right_ = steps_right_ - 1;
-    }
+    quadrature_decoder_right_.decode(digitalReadPairFromISR(ESP32Pin::motor_right_encoder_a,
+            ESP32Pin::motor_right_encoder_b), micros());
 }
 }   // namespace firmware
 }   // namespace biped
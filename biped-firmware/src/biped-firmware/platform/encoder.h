@@ -21,8 +21,11 @@
 /*
  *  Project headers.
  */
+#include "common/parameter.h"
 #include "common/type.h"
 #include "utility/low_pass_filter.hpp"
+#include "utility/quadrature_decoder.hpp"
+#include "utility/velocity_estimator.hpp"
 
 /*
  *  Biped namespace.
@@ -41,6 +44,17 @@ namespace firmware
  *  The class also provides callback functions for the interrupts
  *  generated by the encoders, as well as functions for calculating
  *  the linear velocity.
+ *
+ *  The encoder steps are decoded by a lookup table-based quadrature
+ *  decoder for each motor, which also counts illegal transitions,
+ *  i.e., missed edges. Refer to the quadrature decoder header for
+ *  more details.
+ *
+ *  The linear velocity is estimated from the timestamps of the
+ *  encoder steps, taken by the encoder interrupt handlers, using
+ *  a velocity estimator for each motor, such that the velocity is
+ *  accurate enough to be calculated in the fast domain. Refer to
+ *  the velocity estimator header for more details.
  */
 class Encoder
 {
@@ -68,7 +82,7 @@ public:
      *  @brief  Encoder reading function.
      *
      *  This function reads and converts data from class member
-     *  encoder step variables set by the encoder interrupt
+     *  quadrature decoders updated by the encoder interrupt
      *  handlers and populates the corresponding entries in the
      *  class member encoder data struct.
      */
@@ -79,9 +93,11 @@ public:
      *  @brief  Velocity calculation function.
      *
      *  This function calculates linear velocity from encoder
-     *  data and populates the corresponding entries in the member
-     *  encoder data struct. The function also filters the calculated
-     *  data using the low-pass filter.
+     *  data and the timestamps of the encoder steps, and populates
+     *  the corresponding entries in the member encoder data struct.
+     *  The function also filters the calculated data using the
+     *  low-pass filter. This function is expected to be called
+     *  in the fast domain.
      */
     void
     calculateVelocity();
@@ -121,9 +137,11 @@ public:
 private:
 
     EncoderData data_;  //!< Encoder data struct.
-    LowPassFilter<double> low_pass_filter_velocity_x_;  //!< X velocity low-pass filter object.
-    long steps_left_;   //!< Left encoder steps.
-    long steps_right_;  //!< Right encoder steps.
+    LowPassFilter<TypeParameter::Scalar> low_pass_filter_velocity_x_;  //!< X velocity low-pass filter object.
+    QuadratureDecoder<false> quadrature_decoder_left_;  //!< Left encoder quadrature decoder object.
+    QuadratureDecoder<true> quadrature_decoder_right_;  //!< Right encoder quadrature decoder object.
+    VelocityEstimator<TypeParameter::Scalar> velocity_estimator_left_;  //!< Left encoder velocity estimator object.
+    VelocityEstimator<TypeParameter::Scalar> velocity_estimator_right_; //!< Right encoder velocity estimator object.
 };
 }   // namespace firmware
 }   // namespace biped
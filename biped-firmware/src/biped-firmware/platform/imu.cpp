@@ -27,6 +27,25 @@ namespace firmware
 {
 IMU::IMU()
 {
+    /*
+     *  Configure the accelerometer and gyroscope biquad filter bank
+     *  with low-pass filters designed at compile time for the fast
+     *  domain sample rate. The accelerometer channels come first.
+     */
+    constexpr BiquadCoefficients coefficients_acceleration = BiquadCoefficients::lowPass(
+            IMUParameter::acceleration_cutoff, 1 / PeriodParameter::fast,
+            IMUParameter::quality_factor);
+    constexpr BiquadCoefficients coefficients_angular_velocity = BiquadCoefficients::lowPass(
+            IMUParameter::angular_velocity_cutoff, 1 / PeriodParameter::fast,
+            IMUParameter::quality_factor);
+
+    for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+    {
+        mpu6050_biquad_filter_bank_.setCoefficients(0, channel,
+                channel < IMUParameter::channel_count / 2 ? coefficients_acceleration :
+                        coefficients_angular_velocity);
+    }
+
     /*
      *  Initialize IMU.
      *
@@ -104,6 +123,25 @@ IMU::read()
     mpu6050_data_.compass_z = 0;
     mpu6050_data_.temperature = temperature.temperature;
 
+    /*
+     *  Filter the accelerometer and gyroscope data in a single pass
+     *  using the class member biquad filter bank.
+     */
+    TypeParameter::Scalar data[IMUParameter::channel_count] = {
+            TypeParameter::Scalar(mpu6050_data_.acceleration_x),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_y),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_z),
+            TypeParameter::Scalar(mpu6050_data_.angular_velocity_x),
+            TypeParameter::Scalar(mpu6050_data_.angular_velocity_y),
+            TypeParameter::Scalar(mpu6050_data_.angular_velocity_z) };
+    mpu6050_biquad_filter_bank_.filter(data);
+    mpu6050_data_.acceleration_x = static_cast<double>(data[0]);
+    mpu6050_data_.acceleration_y = static_cast<double>(data[1]);
+    mpu6050_data_.acceleration_z = static_cast<double>(data[2]);
+    mpu6050_data_.angular_velocity_x = static_cast<double>(data[3]);
+    mpu6050_data_.angular_velocity_y = static_cast<double>(data[4]);
+    mpu6050_data_.angular_velocity_z = static_cast<double>(data[5]);
+
     /*
      *  Calculate the attitude.
      *
@@ -154,8 +192,8 @@ IMU::initialize()
      *  Do not call the class member calculateAttitude function here.
      *  Instead, repeat the steps noted in the calculateAttitude function
      *  and directly calculate the Y attitude here. The initial Y attitude
-     *  calculation should not be filtered by the Kalman filter as the Kalman
-     *  filter has not yet been set up.
+     *  calculation should not be filtered by the attitude estimator as the
+     *  attitude estimator has not yet been set up.
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
@@ -167,12 +205,16 @@ IMU::initialize()
     mpu6050_data_.attitude_y = attitude_y_raw;
 
     /*
-     *  Configure the Y attitude (pitch) Kalman filter.
+     *  Configure the attitude estimator and initialize its roll
+     *  and pitch from the initial accelerometer reading.
      */
-    mpu6050_kalman_filter_attitude_y_.setAngle(radiansToDegrees(mpu6050_data_.attitude_y));
-    mpu6050_kalman_filter_attitude_y_.setQangle(KalmanFilterParameter::q_angle);
-    mpu6050_kalman_filter_attitude_y_.setQbias(KalmanFilterParameter::q_bias);
-    mpu6050_kalman_filter_attitude_y_.setRmeasure(KalmanFilterParameter::r_measure);
+    mpu6050_attitude_estimator_.setGains(AttitudeEstimatorParameter::gain_proportional,
+            AttitudeEstimatorParameter::gain_integral);
+    mpu6050_attitude_estimator_.initialize(TypeParameter::Scalar(mpu6050_data_.acceleration_x),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_y),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_z));
+    mpu6050_data_.attitude_x = static_cast<double>(mpu6050_attitude_estimator_.getAttitudeX());
+    mpu6050_data_.attitude_z = 0;
 }
 
 void
@@ -199,8 +241,8 @@ IMU::calculateAttitude()
      *
      *  Remember to perform the same calculation in the initialize function as the
      *  initial Y attitude calculation. However, the initial Y attitude calculation
-     *  in the initialize function should not be filtered by the Kalman filter as
-     *  the Kalman filter has not yet been set up at that point.
+     *  in the initialize function should not be filtered by the attitude estimator
+     *  as the attitude estimator has not yet been set up at that point.
      *
      *  Learn about the standard body reference frame here:
      *  https://www.vectornav.com/resources/inertial-navigation-primer/math-fundamentals/math-refframes
@@ -211,26 +253,35 @@ IMU::calculateAttitude()
      *  TODO LAB 6 YOUR CODE HERE.
      */
 
-    double ax = mpu6050_data_.acceleration_x;
-    double az = mpu6050_data_.acceleration_z;
-    const double attitude_y_raw = -atan2(ax, az);
-
     /*
-     *  Filter the raw Y attitude data using the Kalman filter.
+     *  Fuse the linear accelerations, whose direction gives the raw
+     *  X and Y attitudes, with the angular velocities using the attitude
+     *  estimator, which runs in the fast domain.
      */
-    const double attitude_y_kalman_filter = mpu6050_kalman_filter_attitude_y_.getAngle(
-            radiansToDegrees(attitude_y_raw), radiansToDegrees(mpu6050_data_.angular_velocity_y),
-            PeriodParameter::fast);
+    mpu6050_attitude_estimator_.update(TypeParameter::Scalar(mpu6050_data_.angular_velocity_x),
+            TypeParameter::Scalar(mpu6050_data_.angular_velocity_y),
+            TypeParameter::Scalar(mpu6050_data_.angular_velocity_z),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_x),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_y),
+            TypeParameter::Scalar(mpu6050_data_.acceleration_z),
+            TypeParameter::Scalar(PeriodParameter::fast));
 
     /*
-     *  Convert the filtered Y attitude data back to radians
-     *  using the degreesToRadians function in the math header and populate
-     *  the Y attitude in the class member MPU6050 IMU data data struct.
+     *  Populate the attitudes and the gyroscope biases in the class
+     *  member MPU6050 IMU data data struct.
      *
      *  TODO LAB 6 YOUR CODE HERE.
      */
 
-    mpu6050_data_.attitude_y = degreesToRadians(attitude_y_kalman_filter);
+    mpu6050_data_.attitude_x = static_cast<double>(mpu6050_attitude_estimator_.getAttitudeX());
+    mpu6050_data_.attitude_y = static_cast<double>(mpu6050_attitude_estimator_.getAttitudeY());
+    mpu6050_data_.attitude_z = static_cast<double>(mpu6050_attitude_estimator_.getAttitudeZ());
+    mpu6050_data_.angular_velocity_bias_x = static_cast<double>(
+            mpu6050_attitude_estimator_.getBiasX());
+    mpu6050_data_.angular_velocity_bias_y = static_cast<double>(
+            mpu6050_attitude_estimator_.getBiasY());
+    mpu6050_data_.angular_velocity_bias_z = static_cast<double>(
+            mpu6050_attitude_estimator_.getBiasZ());
 }
 }   // namespace firmware
 }   // namespace biped
@@ -17,12 +17,14 @@
  *  External headers.
  */
 #include <Adafruit_MPU6050.h>
-#include <Kalman.h>
 
 /*
  *  Project headers.
  */
+#include "common/parameter.h"
 #include "common/type.h"
+#include "utility/attitude_estimator.hpp"
+#include "utility/biquad_filter_bank.hpp"
 
 /*
  *  Biped namespace.
@@ -40,6 +42,12 @@ namespace firmware
  *  This class provides functions for reading from the
  *  inertial measurement unit (IM). The class also
  *  provides functions for calculating the attitude.
+ *
+ *  The accelerometer and gyroscope channels are low-pass
+ *  filtered by a biquad filter bank in a single pass before
+ *  the attitude calculation. The attitude estimator then
+ *  estimates the roll, pitch, and yaw, as well as the
+ *  gyroscope biases, every fast domain period.
  */
 class IMU
 {
@@ -80,7 +88,7 @@ private:
      *
      *  This function initializes and configures the IMU driver, performs
      *  an initial read from the IMU and an initial attitude calculation,
-     *  and configures the Kalman filters.
+     *  and configures the attitude estimator.
      */
     void
     initialize();
@@ -90,15 +98,16 @@ private:
      *
      *  This function calculates attitude data from linear acceleration
      *  data and populates the corresponding entries in the member
-     *  IMU data struct. The function also filters attitude data using
-     *  the Kalman filter.
+     *  IMU data struct. The function fuses the linear acceleration data
+     *  with the angular velocity data using the attitude estimator.
      */
     void
     calculateAttitude();
 
     Adafruit_MPU6050 mpu6050_;  //!< Adafruit MPU6050 IMU driver object.
     IMUData mpu6050_data_;    //!< MPU6050 IMU data struct.
-    Kalman mpu6050_kalman_filter_attitude_y_;  //!< MPU6050 Y attitude (pitch) Kalman filter object.
+    BiquadFilterBank<TypeParameter::Scalar, IMUParameter::channel_count, 1> mpu6050_biquad_filter_bank_; //!< MPU6050 accelerometer and gyroscope biquad filter bank object.
+    AttitudeEstimator<TypeParameter::Scalar> mpu6050_attitude_estimator_;   //!< MPU6050 attitude estimator object.
 };
 }   // namespace firmware
 }   // namespace biped
@@ -32,7 +32,6 @@ namespace firmware
 {
 TimeOfFlight::TimeOfFlight(const uint8_t& address, const uint8_t& shutdown_pin,
         const std::shared_ptr<IOExpander> io_expander) :
-        median_filter_(MedianFilterParameter::window_size),
         vl53l4cx_(&Wire, shutdown_pin, io_expander->getRaw())
 {
     /*
@@ -21,6 +21,7 @@
 /*
  *  Project headers.
  */
+#include "common/parameter.h"
 #include "common/type.h"
 #include "platform/io_expander.h"
 #include "utility/median_filter.hpp"
@@ -70,7 +71,7 @@ public:
 
 private:
 
-    MedianFilter<double> median_filter_;    //!< Median filter object.
+    MedianFilter<double, MedianFilterParameter::window_size> median_filter_;    //!< Median filter object.
     VL53L4CX vl53l4cx_; //!< VL53L4CX time-of-flight sensor driver object.
 
 };
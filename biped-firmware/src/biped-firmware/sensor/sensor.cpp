@@ -84,35 +84,33 @@ EncoderData
 Sensor::getEncoderData() const
 {
     /*
-     *  Get encoder data struct from the class member encoder
-     *  object and return the struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Read the encoder data struct snapshot from the class
+     *  member encoder data struct sequence lock and return
+     *  the struct.
      */
-    return encoder_.getData();
+    return seqlock_encoder_data_.read();
 }
 
 IMUData
 Sensor::getIMUData() const
 {
     /*
-     *  Get IMU data struct from the class member IMU
-     *  object and return the struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Read the IMU data struct snapshot from the class
+     *  member IMU data struct sequence lock and return
+     *  the struct.
      */
-    return imu_.getData();
+    return seqlock_imu_data_.read();
 }
 
 TimeOfFlightData
 Sensor::getTimeOfFlightData() const
 {
     /*
-     *  Return the class member time-of-flight data struct.
-     *
-     *  TODO LAB 6 YOUR CODE HERE.
+     *  Read the time-of-flight data struct snapshot from the
+     *  class member time-of-flight data struct sequence lock
+     *  and return the struct.
      */
-    return time_of_flight_data_;
+    return seqlock_time_of_flight_data_.read();
 }
 
 void
@@ -126,68 +124,94 @@ Sensor::sense(const bool& fast_domain)
      *  the Biped's actual attitudes could have changed significantly in the interim.
      *  This delay in data acquisition can adversely affect the Biped's balance, as it
      *  relies on timely and accurate information to maintain the unstable equilibrium.
+     *  The X velocity is estimated from the timestamps of the encoder steps rather than
+     *  the number of encoder steps over time, which would be too noisy over a fast
+     *  domain period, and hence is calculated in the fast domain as well.
      *
      *  On the contrary, slow domain tasks are more suited to a lower execution frequency,
      *  often due to factors like sensor noise or performance considerations. For instance,
-     *  the calculation of X velocity, which is determined by the number of encoder
-     *  steps over time, illustrates this point well. A shorter measurement period results
-     *  in noisier velocity data. Furthermore, there's no necessity for frequent readings
-     *  of non-essential sensors such as the time-of-flight sensors. Operating these tasks
-     *  in the slow domain is more efficient and performance-friendly, balancing accuracy
-     *  and system resource utilization.
+     *  there's no necessity for frequent readings of non-essential sensors such as the
+     *  time-of-flight sensors. Operating these tasks in the slow domain is more efficient
+     *  and performance-friendly, balancing accuracy and system resource utilization.
      */
     if (fast_domain)
     {
-        /*
-         *  Perform encoder read using the class member encoder object.
-         *
-         *  Refer to the encoder header for the encoder functions.
-         *
-         *  TODO LAB 6 YOUR CODE HERE.
-         */
-
-    	encoder_.read();
-
-        /*
-         *  Perform IMU read using the class member IMU object.
-         *
-         *  Refer to the IMU header for the IMU functions.
-         *
-         *  TODO LAB 6 YOUR CODE HERE.
-         */
-
-    	imu_.read();
+        senseEncoder();
+        senseIMU();
     }
     else
     {
-        /*
-         *  Calculate velocity using the class member encoder object.
-         *
-         *  Refer to the encoder header for the encoder functions.
-         *
-         *  TODO LAB 6 YOUR CODE HERE.
-         */
-
-    	encoder_.calculateVelocity();
-
-        /*
-         *  Perform time-of-flight reads using the class member
-         *  time-of-flight objects, and store the read values
-         *  to the class member time-of-flight data struct.
-         *
-         *  Refer to the time-of-flight header for the time-of-flight
-         *  functions, and type header for the time-of-flight data struct.
-         *
-         *  TODO LAB 6 YOUR CODE HERE.
-         */
-
-    	time_of_flight_data_.range_left = time_of_flight_left_->read();
-    	time_of_flight_data_.range_middle = time_of_flight_middle_->read();
-    	time_of_flight_data_.range_right = time_of_flight_right_->read();
-
+        senseTimeOfFlight();
     }
 }
 
+void
+Sensor::senseEncoder()
+{
+    /*
+     *  Perform encoder read and calculate velocity using the class
+     *  member encoder object. The velocity calculation reads the
+     *  encoders.
+     *
+     *  Refer to the encoder header for the encoder functions.
+     *
+     *  TODO LAB 6 YOUR CODE HERE.
+     */
+
+	encoder_.calculateVelocity();
+
+    /*
+     *  Publish the encoder data struct to the class member sequence
+     *  lock. The sensing is performed only by the real-time task, the
+     *  single writer of the sequence locks.
+     */
+    seqlock_encoder_data_.write(encoder_.getData());
+}
+
+void
+Sensor::senseIMU()
+{
+    /*
+     *  Perform IMU read using the class member IMU object.
+     *
+     *  Refer to the IMU header for the IMU functions.
+     *
+     *  TODO LAB 6 YOUR CODE HERE.
+     */
+
+	imu_.read();
+
+    /*
+     *  Publish the IMU data struct to the class member sequence lock.
+     */
+    seqlock_imu_data_.write(imu_.getData());
+}
+
+void
+Sensor::senseTimeOfFlight()
+{
+    /*
+     *  Perform time-of-flight reads using the class member
+     *  time-of-flight objects, and store the read values
+     *  to the class member time-of-flight data struct.
+     *
+     *  Refer to the time-of-flight header for the time-of-flight
+     *  functions, and type header for the time-of-flight data struct.
+     *
+     *  TODO LAB 6 YOUR CODE HERE.
+     */
+
+	time_of_flight_data_.range_left = time_of_flight_left_->read();
+	time_of_flight_data_.range_middle = time_of_flight_middle_->read();
+	time_of_flight_data_.range_right = time_of_flight_right_->read();
+
+    /*
+     *  Publish the time-of-flight data struct to the class member
+     *  sequence lock.
+     */
+    seqlock_time_of_flight_data_.write(time_of_flight_data_);
+}
+
 void IRAM_ATTR
 Sensor::onEncoderLeftA()
 {
@@ -19,6 +19,7 @@
 #include "platform/encoder.h"
 #include "platform/imu.h"
 #include "platform/time_of_flight.h"
+#include "utility/seqlock.hpp"
 
 /*
  *  Biped namespace.
@@ -44,6 +45,11 @@ class Actuator;
  *  sensors, and for populating data into the sensor data
  *  structs. The class also provides callback functions
  *  for interrupt-based sensors, such as the encoders.
+ *
+ *  The sensor data structs are published through sequence
+ *  locks at the end of each sensing, such that tasks other
+ *  than the real-time task obtain coherent snapshots without
+ *  blocking the real-time task.
  */
 class Sensor
 {
@@ -62,8 +68,8 @@ public:
      *  @return Encoder data struct.
      *  @brief  Get the encoder data struct.
      *
-     *  This function returns the encoder data struct from the class
-     *  member encoder object.
+     *  This function returns a snapshot of the encoder data struct
+     *  published by the last sensing.
      */
     EncoderData
     getEncoderData() const;
@@ -72,8 +78,8 @@ public:
      *  @return IMU data struct.
      *  @brief  Get the IMU data struct.
      *
-     *  This function returns the IMU data struct from the class
-     *  member IMU object.
+     *  This function returns a snapshot of the IMU data struct
+     *  published by the last sensing.
      */
     IMUData
     getIMUData() const;
@@ -82,7 +88,8 @@ public:
      *  @return Time-of-flight data struct.
      *  @brief  Get the class member time-of-flight data struct.
      *
-     *  This function returns the class member time-of-flight data struct.
+     *  This function returns a snapshot of the time-of-flight data
+     *  struct published by the last sensing.
      */
     TimeOfFlightData
     getTimeOfFlightData() const;
@@ -92,12 +99,42 @@ public:
      *  @brief  Sensor data acquisition function.
      *
      *  This function performs acquisition of data from all sensors, for
-     *  fast or slow domain. This function is expected to be called
-     *  periodically.
+     *  fast or slow domain, using the sensing functions below. This
+     *  function is expected to be called periodically.
      */
     void
     sense(const bool& fast_domain);
 
+    /**
+     *  @brief  Encoder sensing function.
+     *
+     *  This function reads the encoders, calculates the X velocity,
+     *  and publishes the encoder data struct. This function is a fast
+     *  domain job of the real-time task scheduler.
+     */
+    void
+    senseEncoder();
+
+    /**
+     *  @brief  IMU sensing function.
+     *
+     *  This function reads the IMU, estimates the attitudes, and
+     *  publishes the IMU data struct. This function is a fast domain
+     *  job of the real-time task scheduler.
+     */
+    void
+    senseIMU();
+
+    /**
+     *  @brief  Time-of-flight sensing function.
+     *
+     *  This function reads the time-of-flight sensors and publishes
+     *  the time-of-flight data struct. This function is a slow domain
+     *  job of the real-time task scheduler.
+     */
+    void
+    senseTimeOfFlight();
+
     /**
      *  @brief  Left encoder A callback function.
      *
@@ -134,6 +171,9 @@ private:
 
     Encoder encoder_;   //!< Encoder object.
     IMU imu_;   //!< IMU object.
+    Seqlock<EncoderData> seqlock_encoder_data_; //!< Encoder data struct sequence lock.
+    Seqlock<IMUData> seqlock_imu_data_; //!< IMU data struct sequence lock.
+    Seqlock<TimeOfFlightData> seqlock_time_of_flight_data_; //!< Time-of-flight data struct sequence lock.
     TimeOfFlightData time_of_flight_data_;  //!< Time-of-flight data struct.
     std::unique_ptr<TimeOfFlight> time_of_flight_left_; //!< Left time-of-flight object unique pointer.
     std::unique_ptr<TimeOfFlight> time_of_flight_middle_; //!< Middle time-of-flight object unique pointer.
@@ -0,0 +1,81 @@
+/**
+ *  @file   Arduino.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated Arduino core header.
+ *
+ *  This file defines the subset of the Arduino core used by
+ *  the hardware-independent firmware. The timing functions
+ *  are backed by the simulated clock and the serial driver
+ *  object writes to the standard error stream.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_ARDUINO_H_
+#define SIMULATOR_ARDUINO_H_
+
+/**
+ *  @brief  Simulated Arduino serial driver class.
+ *
+ *  This class mirrors the Arduino hardware serial driver
+ *  functions used by the firmware serial class.
+ */
+class HardwareSerial
+{
+public:
+
+    /**
+     *  @param  baud_rate Baud rate.
+     *  @brief  Initialize the serial driver.
+     *
+     *  This function does nothing in the simulator.
+     */
+    void
+    begin(const unsigned long& baud_rate);
+
+    /**
+     *  @param  string Null-terminated string.
+     *  @brief  Print a string.
+     *
+     *  This function writes the given string to the standard
+     *  error stream.
+     */
+    void
+    print(const char* string);
+
+    /**
+     *  @param  string Null-terminated string.
+     *  @brief  Print a string followed by a new line.
+     *
+     *  This function writes the given string and a new line to
+     *  the standard error stream.
+     */
+    void
+    println(const char* string);
+};
+
+extern HardwareSerial Serial;   //!< Simulated Arduino serial driver object.
+
+/**
+ *  @return Simulated time, in milliseconds.
+ *  @brief  Get the simulated time in milliseconds.
+ *
+ *  This function returns the simulated time since the start
+ *  of the simulation, in milliseconds.
+ */
+unsigned long
+millis();
+
+/**
+ *  @return Simulated time, in microseconds.
+ *  @brief  Get the simulated time in microseconds.
+ *
+ *  This function returns the simulated time since the start
+ *  of the simulation, in microseconds.
+ */
+unsigned long
+micros();
+
+#endif  // SIMULATOR_ARDUINO_H_
@@ -0,0 +1,412 @@
+/**
+ *  @file   accuracy.cpp
+ *  @author Simon Yu
+ *  @date   01/19/2022
+ *  @brief  Scalar type accuracy harness source.
+ *
+ *  This file implements the scalar type accuracy harness. The
+ *  harness runs the simulated plant in closed loop with a double
+ *  precision reference controller and, every iteration, feeds the
+ *  same sensor data to the float and the fixed-point instantiations
+ *  of the controller, the Kalman filter, and the low-pass filter.
+ *  It then reports the maximum and the root-mean-square errors of
+ *  each instantiation against the double precision reference, along
+ *  with the mean host execution time of each instantiation.
+ *
+ *  Usage: biped-accuracy [duration] [none|waypoint|maneuver]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "planner/maneuver_planner.h"
+#include "planner/waypoint_planner.h"
+#include "sensor/sensor.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "utility/fixed_point.hpp"
+#include "utility/kalman_filter.hpp"
+#include "utility/low_pass_filter.hpp"
+#include "utility/math.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @brief  Error statistics class.
+ *
+ *  This class accumulates the errors of an instantiation against
+ *  the double precision reference, as well as its host execution
+ *  time.
+ */
+class Statistics
+{
+public:
+
+    /**
+     *  @brief  Error statistics class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    Statistics() : count_error_(0), count_execution_time_(0), error_max_(0),
+            error_squared_total_(0), execution_time_total_(0)
+    {
+    }
+
+    /**
+     *  @param  reference Reference data.
+     *  @param  data Data under test.
+     *  @brief  Add an error sample.
+     *
+     *  This function adds the error between the given data and
+     *  reference.
+     */
+    void
+    addError(const double& reference, const double& data)
+    {
+        const double error = std::fabs(data - reference);
+
+        count_error_ ++;
+        error_max_ = std::max(error_max_, error);
+        error_squared_total_ += error * error;
+    }
+
+    /**
+     *  @tparam Function Type of the function to execute.
+     *  @param  function Function to execute.
+     *  @brief  Execute a function and add its execution time sample.
+     *
+     *  This function executes the given function and adds its
+     *  host execution time.
+     */
+    template<typename Function>
+    void
+    measure(const Function& function)
+    {
+        const auto time_point_start = std::chrono::steady_clock::now();
+        function();
+        execution_time_total_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - time_point_start).count();
+        count_execution_time_ ++;
+    }
+
+    /**
+     *  @param  name Instantiation name.
+     *  @param  unit Data unit.
+     *  @brief  Print the error statistics.
+     *
+     *  This function prints the maximum and root-mean-square
+     *  errors and the mean host execution time.
+     */
+    void
+    print(const std::string& name, const std::string& unit) const
+    {
+        std::cout << "  " << std::left << std::setw(8) << name << "max error "
+                << std::setw(12) << error_max_ << " rms error " << std::setw(12)
+                << (count_error_ ? std::sqrt(error_squared_total_ / count_error_) : 0) << " "
+                << unit << ", mean "
+                << (count_execution_time_ ? execution_time_total_ / count_execution_time_ : 0)
+                << " ns" << std::endl;
+    }
+
+private:
+
+    uint64_t count_error_;  //!< Number of error samples.
+    uint64_t count_execution_time_; //!< Number of execution time samples.
+    double error_max_;  //!< Maximum error.
+    double error_squared_total_;    //!< Sum of squared errors.
+    uint64_t execution_time_total_; //!< Total host execution time, in nanoseconds.
+};
+
+/**
+ *  @param  actuation_command Actuation command struct.
+ *  @param  left Whether to return the left motor output.
+ *  @return Signed motor PWM.
+ *  @brief  Get the signed motor PWM from an actuation command.
+ */
+static double
+getSignedPWM(const ActuationCommand& actuation_command, const bool& left)
+{
+    if (left)
+    {
+        return (actuation_command.motor_left_forward ? 1 : -1) * actuation_command.motor_left_pwm;
+    }
+
+    return (actuation_command.motor_right_forward ? 1 : -1) * actuation_command.motor_right_pwm;
+}
+
+/**
+ *  @tparam Type Scalar type.
+ *  @param  kalman_filter Kalman filter.
+ *  @brief  Configure a Kalman filter the same way as the IMU did.
+ */
+template<typename Type>
+static void
+configureKalmanFilter(KalmanFilter<Type>& kalman_filter)
+{
+    kalman_filter.setAngle(radiansToDegrees(plant_->getAttitudeY()));
+    kalman_filter.setQangle(KalmanFilterParameter::q_angle);
+    kalman_filter.setQbias(KalmanFilterParameter::q_bias);
+    kalman_filter.setRmeasure(KalmanFilterParameter::r_measure);
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Accuracy harness main function.
+ *
+ *  This function runs the simulated plant in closed loop with
+ *  the double precision reference controller for the given
+ *  simulated duration and prints the error statistics of the
+ *  float and fixed-point instantiations.
+ */
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10;
+    const std::string planner = argc > 2 ? argv[2] : "waypoint";
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Instantiate the simulated plant and the global objects. The
+     *  global controller is the firmware controller, whose controller
+     *  reference is set by the planner and copied to all other
+     *  controllers.
+     */
+    instantiateGlobalObjects();
+
+    if (planner == "waypoint")
+    {
+        planner_ = std::make_shared<WaypointPlanner>();
+    }
+    else if (planner == "maneuver")
+    {
+        planner_ = std::make_shared<ManeuverPlanner>();
+    }
+    else if (planner != "none")
+    {
+        std::cerr << "Invalid planner." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (planner_)
+    {
+        planner_->start();
+    }
+
+    /*
+     *  Instantiate the controllers and the filters under test
+     *  alongside their double precision references.
+     */
+    BasicController<double> controller_double;
+    BasicController<float> controller_float;
+    BasicController<Q16> controller_q16;
+    KalmanFilter<double> kalman_filter_double;
+    KalmanFilter<float> kalman_filter_float;
+    KalmanFilter<Q16> kalman_filter_q16;
+    LowPassFilter<double> low_pass_filter_double;
+    LowPassFilter<float> low_pass_filter_float;
+    LowPassFilter<Q16> low_pass_filter_q16;
+
+    controller_double.setPeriod(PeriodParameter::fast, true);
+    controller_double.setPeriod(PeriodParameter::slow, false);
+    controller_float.setPeriod(PeriodParameter::fast, true);
+    controller_float.setPeriod(PeriodParameter::slow, false);
+    controller_q16.setPeriod(PeriodParameter::fast, true);
+    controller_q16.setPeriod(PeriodParameter::slow, false);
+
+    configureKalmanFilter(kalman_filter_double);
+    configureKalmanFilter(kalman_filter_float);
+    configureKalmanFilter(kalman_filter_q16);
+
+    low_pass_filter_double.setBeta(EncoderParameter::low_pass_filter_beta);
+    low_pass_filter_float.setBeta(EncoderParameter::low_pass_filter_beta);
+    low_pass_filter_q16.setBeta(EncoderParameter::low_pass_filter_beta);
+
+    Statistics statistics_controller_double;
+    Statistics statistics_controller_float;
+    Statistics statistics_controller_q16;
+    Statistics statistics_kalman_filter_double;
+    Statistics statistics_kalman_filter_float;
+    Statistics statistics_kalman_filter_q16;
+    Statistics statistics_low_pass_filter_double;
+    Statistics statistics_low_pass_filter_float;
+    Statistics statistics_low_pass_filter_q16;
+
+    /*
+     *  Run the closed loop. The slow domain runs once every
+     *  slow domain period, the same way as the real-time task.
+     */
+    const unsigned long iterations = static_cast<unsigned long>(duration / PeriodParameter::fast);
+    const unsigned long iterations_slow = static_cast<unsigned long>(PeriodParameter::slow
+            / PeriodParameter::fast);
+    double steps_last = 0;
+
+    for (unsigned long i = 0; i < iterations; ++i)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+
+        const bool slow_domain = i % iterations_slow == 0;
+
+        if (slow_domain && planner_)
+        {
+            planner_->plan();
+        }
+
+        /*
+         *  Copy the controller reference set by the planner.
+         */
+        const ControllerReference controller_reference = controller_->getControllerReference();
+        controller_double.setControllerReference(controller_reference);
+        controller_float.setControllerReference(controller_reference);
+        controller_q16.setControllerReference(controller_reference);
+
+        for (const bool fast_domain : { true, false })
+        {
+            if (!fast_domain && !slow_domain)
+            {
+                break;
+            }
+
+            /*
+             *  Sense and run all controllers with the same sensor data.
+             */
+            sensor_->sense(fast_domain);
+
+            const IMUData imu_data = sensor_->getIMUData();
+            const EncoderData encoder_data = sensor_->getEncoderData();
+
+            /*
+             *  Run the firmware controller as well, as the planner
+             *  pauses whenever the firmware controller is inactive.
+             */
+            controller_->control(fast_domain, imu_data, encoder_data);
+
+            statistics_controller_double.measure([&]
+            {   controller_double.control(fast_domain, imu_data, encoder_data);});
+            statistics_controller_float.measure([&]
+            {   controller_float.control(fast_domain, imu_data, encoder_data);});
+            statistics_controller_q16.measure([&]
+            {   controller_q16.control(fast_domain, imu_data, encoder_data);});
+
+            for (const bool left : { true, false })
+            {
+                const double reference = getSignedPWM(controller_double.getActuationCommand(), left);
+
+                statistics_controller_float.addError(reference,
+                        getSignedPWM(controller_float.getActuationCommand(), left));
+                statistics_controller_q16.addError(reference,
+                        getSignedPWM(controller_q16.getActuationCommand(), left));
+            }
+
+            if (fast_domain)
+            {
+                /*
+                 *  Filter the raw accelerometer attitude with all
+                 *  Kalman filters, the same way as the IMU did.
+                 */
+                const double attitude_y_raw = radiansToDegrees(
+                        -std::atan2(imu_data.acceleration_x, imu_data.acceleration_z));
+                const double angular_velocity_y = radiansToDegrees(imu_data.angular_velocity_y);
+                double attitude_y_double = 0;
+                float attitude_y_float = 0;
+                Q16 attitude_y_q16;
+
+                statistics_kalman_filter_double.measure([&]
+                {   attitude_y_double = kalman_filter_double.getAngle(attitude_y_raw,
+                            angular_velocity_y, PeriodParameter::fast);});
+                statistics_kalman_filter_float.measure([&]
+                {   attitude_y_float = kalman_filter_float.getAngle(attitude_y_raw,
+                            angular_velocity_y, PeriodParameter::fast);});
+                statistics_kalman_filter_q16.measure([&]
+                {   attitude_y_q16 = kalman_filter_q16.getAngle(attitude_y_raw,
+                            angular_velocity_y, PeriodParameter::fast);});
+                statistics_kalman_filter_float.addError(attitude_y_double, attitude_y_float);
+                statistics_kalman_filter_q16.addError(attitude_y_double,
+                        static_cast<double>(attitude_y_q16));
+            }
+            else
+            {
+                /*
+                 *  Filter the raw encoder velocity with all low-pass
+                 *  filters, the same way as the encoder.
+                 */
+                const double velocity_x_raw = (encoder_data.steps - steps_last)
+                        / EncoderParameter::steps_per_meter / PeriodParameter::slow;
+                double velocity_x_double = 0;
+                float velocity_x_float = 0;
+                Q16 velocity_x_q16;
+
+                steps_last = encoder_data.steps;
+
+                statistics_low_pass_filter_double.measure([&]
+                {   velocity_x_double = low_pass_filter_double.filter(velocity_x_raw);});
+                statistics_low_pass_filter_float.measure([&]
+                {   velocity_x_float = low_pass_filter_float.filter(velocity_x_raw);});
+                statistics_low_pass_filter_q16.measure([&]
+                {   velocity_x_q16 = low_pass_filter_q16.filter(velocity_x_raw);});
+                statistics_low_pass_filter_float.addError(velocity_x_double, velocity_x_float);
+                statistics_low_pass_filter_q16.addError(velocity_x_double,
+                        static_cast<double>(velocity_x_q16));
+            }
+        }
+
+        /*
+         *  Actuate the simulated plant using the double
+         *  precision reference controller.
+         */
+        actuator_->actuate(controller_double.getActuationCommand());
+    }
+
+    /*
+     *  Print the error statistics.
+     */
+    std::cout << "Simulated time: " << microsecondsToSeconds(micros()) << " s, final position: "
+            << plant_->getPositionX() << " m, pitch: "
+            << radiansToDegrees(plant_->getAttitudeY()) << " deg" << std::endl;
+    std::cout << "Controller (signed motor PWM):" << std::endl;
+    statistics_controller_double.print("double", "");
+    statistics_controller_float.print("float", "");
+    statistics_controller_q16.print("Q16", "");
+    std::cout << "Kalman filter (Y attitude):" << std::endl;
+    statistics_kalman_filter_double.print("double", "deg");
+    statistics_kalman_filter_float.print("float", "deg");
+    statistics_kalman_filter_q16.print("Q16", "deg");
+    std::cout << "Low-pass filter (X velocity):" << std::endl;
+    statistics_low_pass_filter_double.print("double", "m/s");
+    statistics_low_pass_filter_float.print("float", "m/s");
+    statistics_low_pass_filter_q16.print("Q16", "m/s");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/**
+ *  @file   actuator.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated actuator class source.
+ *
+ *  This file implements the actuator class on top of the
+ *  simulated plant.
+ */
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/parameter.h"
+#include "simulator/plant.h"
+#include "utility/math.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+Actuator::Actuator()
+{
+}
+
+ActuationCommand
+Actuator::getActuationCommand() const
+{
+    /*
+     *  Return the actuation command struct snapshot.
+     */
+    return seqlock_actuation_command_.read();
+}
+
+void
+Actuator::actuate(const ActuationCommand& actuation_command)
+{
+    /*
+     *  Publish the given actuation command struct.
+     */
+    seqlock_actuation_command_.write(actuation_command);
+
+    /*
+     *  Validate the simulated plant.
+     */
+    if (!plant_)
+    {
+        return;
+    }
+
+    /*
+     *  Disabled motors produce no output.
+     */
+    if (!actuation_command.motor_enable)
+    {
+        plant_->setMotorOutput(0, 0);
+        return;
+    }
+
+    /*
+     *  Clamp the motor PWM duty cycles, the same as the actuator
+     *  does, and apply the motor directions as signs.
+     */
+    const double motor_left_pwm = clamp(actuation_command.motor_left_pwm,
+            MotorParameter::pwm_min, MotorParameter::pwm_max);
+    const double motor_right_pwm = clamp(actuation_command.motor_right_pwm,
+            MotorParameter::pwm_min, MotorParameter::pwm_max);
+
+    plant_->setMotorOutput(actuation_command.motor_left_forward ? motor_left_pwm : -motor_left_pwm,
+            actuation_command.motor_right_forward ? motor_right_pwm : -motor_right_pwm);
+}
+}   // namespace firmware
+}   // namespace biped
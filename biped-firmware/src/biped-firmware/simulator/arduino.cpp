@@ -0,0 +1,68 @@
+/**
+ *  @file   arduino.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated Arduino core source.
+ *
+ *  This file implements the subset of the Arduino core used
+ *  by the hardware-independent firmware.
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <cstdio>
+
+/*
+ *  Project headers.
+ */
+#include "simulator/clock.h"
+
+void
+HardwareSerial::begin(const unsigned long& baud_rate)
+{
+}
+
+void
+HardwareSerial::print(const char* string)
+{
+    /*
+     *  Write the string to the standard error stream.
+     */
+    std::fputs(string, stderr);
+}
+
+void
+HardwareSerial::println(const char* string)
+{
+    /*
+     *  Write the string and a new line to the standard
+     *  error stream.
+     */
+    std::fputs(string, stderr);
+    std::fputc('\n', stderr);
+}
+
+/*
+ *  Instantiate simulated Arduino serial driver object.
+ */
+HardwareSerial Serial;
+
+unsigned long
+millis()
+{
+    /*
+     *  Return the simulated time in milliseconds.
+     */
+    return biped::firmware::Clock::getMicroseconds() / 1000;
+}
+
+unsigned long
+micros()
+{
+    /*
+     *  Return the simulated time in microseconds.
+     */
+    return biped::firmware::Clock::getMicroseconds();
+}
@@ -0,0 +1,322 @@
+/**
+ *  @file   attitude_estimator.cpp
+ *  @author Simon Yu
+ *  @date   01/26/2022
+ *  @brief  Attitude estimator benchmark source.
+ *
+ *  This file implements the attitude estimator benchmark. The
+ *  benchmark first validates the attitude estimator against a
+ *  synthetic IMU trace, generated from known roll, pitch, and yaw
+ *  oscillations with gyroscope biases, sensor noise, and a forward
+ *  acceleration disturbance. It reports the root-mean-square error
+ *  of each attitude and the final error of each gyroscope bias,
+ *  alongside the Y attitude Kalman filter and the integrated Z
+ *  angular velocity the IMU used before. It then measures the time
+ *  per update of the attitude estimator and the Kalman filter with
+ *  Google Benchmark.
+ *
+ *  The benchmark exits with failure if the attitude estimator is
+ *  not more accurate than the estimates it replaced, or does not
+ *  converge to the X and Y gyroscope biases.
+ *
+ *  Usage: biped-attitude-estimator [benchmark options]
+ */
+
+/*
+ *  External headers.
+ */
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "simulator/parameter.h"
+#include "utility/attitude_estimator.hpp"
+#include "utility/kalman_filter.hpp"
+#include "utility/math.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Synthetic IMU trace parameters.
+ */
+constexpr double duration = 60; //!< Trace duration, in seconds.
+constexpr double duration_settling = 10;    //!< Settling duration excluded from the errors, in seconds.
+constexpr double bias[3] = { 0.02, -0.015, 0.01 };  //!< Gyroscope biases, in radians per second.
+
+/**
+ *  @brief  IMU sample struct.
+ *
+ *  This struct contains a synthetic IMU sample and the true
+ *  attitudes at the time of the sample.
+ */
+struct Sample
+{
+    double acceleration[3]; //!< Accelerations, in meters per second squared.
+    double angular_velocity[3]; //!< Angular velocities, in radians per second.
+    double attitude[3]; //!< True attitudes, in radians.
+};
+
+/**
+ *  @return Synthetic IMU samples, one per fast domain period.
+ *  @brief  Generate a synthetic IMU trace.
+ *
+ *  This function generates the IMU samples of a body oscillating
+ *  in roll, pitch, and yaw at different frequencies, while
+ *  accelerating back and forth along its X axis. The angular
+ *  velocities are the body rates of the Z-Y-X Euler angle
+ *  derivatives, offset by the gyroscope biases, and the
+ *  accelerations are the gravity in the body frame plus the
+ *  forward acceleration. Both include white noise.
+ */
+std::vector<Sample>
+generate()
+{
+    std::mt19937 random_number_generator(SimulatedSensorParameter::seed);
+    std::normal_distribution<double> noise_acceleration(0,
+            SimulatedSensorParameter::acceleration_noise);
+    std::normal_distribution<double> noise_angular_velocity(0,
+            SimulatedSensorParameter::angular_velocity_noise);
+    std::vector<Sample> samples(static_cast<size_t>(duration / PeriodParameter::fast));
+
+    for (size_t i = 0; i < samples.size(); i ++)
+    {
+        Sample& sample = samples[i];
+        const double time = (i + 1) * PeriodParameter::fast;
+        const double w_x = 2 * M_PI * 0.3;
+        const double w_y = 2 * M_PI * 0.5;
+        const double w_z = 2 * M_PI * 0.1;
+        const double roll = 0.2 * std::sin(w_x * time);
+        const double pitch = 0.3 * std::sin(w_y * time + 1);
+        const double yaw = 0.5 * std::sin(w_z * time);
+        const double roll_rate = 0.2 * w_x * std::cos(w_x * time);
+        const double pitch_rate = 0.3 * w_y * std::cos(w_y * time + 1);
+        const double yaw_rate = 0.5 * w_z * std::cos(w_z * time);
+
+        sample.attitude[0] = roll;
+        sample.attitude[1] = pitch;
+        sample.attitude[2] = yaw;
+
+        sample.angular_velocity[0] = roll_rate - yaw_rate * std::sin(pitch);
+        sample.angular_velocity[1] = pitch_rate * std::cos(roll)
+                + yaw_rate * std::cos(pitch) * std::sin(roll);
+        sample.angular_velocity[2] = -pitch_rate * std::sin(roll)
+                + yaw_rate * std::cos(pitch) * std::cos(roll);
+
+        sample.acceleration[0] = -PlantParameter::gravity * std::sin(pitch)
+                + 0.5 * std::sin(2 * M_PI * time);
+        sample.acceleration[1] = PlantParameter::gravity * std::cos(pitch) * std::sin(roll);
+        sample.acceleration[2] = PlantParameter::gravity * std::cos(pitch) * std::cos(roll);
+
+        for (size_t axis = 0; axis < 3; axis ++)
+        {
+            sample.angular_velocity[axis] += bias[axis]
+                    + noise_angular_velocity(random_number_generator);
+            sample.acceleration[axis] += noise_acceleration(random_number_generator);
+        }
+    }
+
+    return samples;
+}
+
+/**
+ *  @param  angle Angle, in radians.
+ *  @return Angle wrapped between negative pi and pi, in radians.
+ *  @brief  Wrap an angle.
+ */
+double
+wrap(const double& angle)
+{
+    return std::atan2(std::sin(angle), std::cos(angle));
+}
+
+/**
+ *  @return Whether the attitude estimator passed the validation.
+ *  @brief  Validate the attitude estimator.
+ *
+ *  This function runs the attitude estimator, the Y attitude Kalman
+ *  filter, and the integration of the Z angular velocity over the
+ *  synthetic IMU trace, the same way as the IMU does and did, and
+ *  compares their errors.
+ */
+bool
+validate()
+{
+    const std::vector<Sample> samples = generate();
+    AttitudeEstimator<TypeParameter::Scalar> attitude_estimator;
+    KalmanFilter<TypeParameter::Scalar> kalman_filter;
+    double attitude_z_integrated = 0;
+    double error_squared[3] = { };
+    double error_squared_kalman_filter = 0;
+    double error_squared_integrated = 0;
+    size_t count = 0;
+
+    attitude_estimator.setGains(AttitudeEstimatorParameter::gain_proportional,
+            AttitudeEstimatorParameter::gain_integral);
+    attitude_estimator.initialize(TypeParameter::Scalar(samples[0].acceleration[0]),
+            TypeParameter::Scalar(samples[0].acceleration[1]),
+            TypeParameter::Scalar(samples[0].acceleration[2]));
+    kalman_filter.setAngle(radiansToDegrees(
+            -std::atan2(samples[0].acceleration[0], samples[0].acceleration[2])));
+    kalman_filter.setQangle(KalmanFilterParameter::q_angle);
+    kalman_filter.setQbias(KalmanFilterParameter::q_bias);
+    kalman_filter.setRmeasure(KalmanFilterParameter::r_measure);
+
+    for (size_t i = 0; i < samples.size(); i ++)
+    {
+        const Sample& sample = samples[i];
+
+        attitude_estimator.update(TypeParameter::Scalar(sample.angular_velocity[0]),
+                TypeParameter::Scalar(sample.angular_velocity[1]),
+                TypeParameter::Scalar(sample.angular_velocity[2]),
+                TypeParameter::Scalar(sample.acceleration[0]),
+                TypeParameter::Scalar(sample.acceleration[1]),
+                TypeParameter::Scalar(sample.acceleration[2]),
+                TypeParameter::Scalar(PeriodParameter::fast));
+        const double attitude_y_kalman_filter = degreesToRadians(static_cast<double>(
+                kalman_filter.getAngle(radiansToDegrees(
+                        -std::atan2(sample.acceleration[0], sample.acceleration[2])),
+                        radiansToDegrees(sample.angular_velocity[1]), PeriodParameter::fast)));
+        attitude_z_integrated += sample.angular_velocity[2] * PeriodParameter::fast;
+
+        if ((i + 1) * PeriodParameter::fast < duration_settling)
+        {
+            continue;
+        }
+
+        const double attitude[3] = {
+                static_cast<double>(attitude_estimator.getAttitudeX()),
+                static_cast<double>(attitude_estimator.getAttitudeY()),
+                static_cast<double>(attitude_estimator.getAttitudeZ()) };
+
+        for (size_t axis = 0; axis < 3; axis ++)
+        {
+            error_squared[axis] += std::pow(wrap(attitude[axis] - sample.attitude[axis]), 2);
+        }
+
+        error_squared_kalman_filter += std::pow(attitude_y_kalman_filter - sample.attitude[1], 2);
+        error_squared_integrated += std::pow(wrap(attitude_z_integrated - sample.attitude[2]), 2);
+        count ++;
+    }
+
+    const double error[3] = { std::sqrt(error_squared[0] / count),
+            std::sqrt(error_squared[1] / count), std::sqrt(error_squared[2] / count) };
+    const double error_kalman_filter = std::sqrt(error_squared_kalman_filter / count);
+    const double error_integrated = std::sqrt(error_squared_integrated / count);
+    const double error_bias[3] = {
+            static_cast<double>(attitude_estimator.getBiasX()) - bias[0],
+            static_cast<double>(attitude_estimator.getBiasY()) - bias[1],
+            static_cast<double>(attitude_estimator.getBiasZ()) - bias[2] };
+
+    std::cout << std::setw(24) << "Estimate" << std::setw(16) << "RMS error (deg)" << std::endl;
+    std::cout << std::setw(24) << "X attitude" << std::setw(16) << radiansToDegrees(error[0])
+            << std::endl;
+    std::cout << std::setw(24) << "Y attitude" << std::setw(16) << radiansToDegrees(error[1])
+            << std::endl;
+    std::cout << std::setw(24) << "  (Kalman filter)" << std::setw(16)
+            << radiansToDegrees(error_kalman_filter) << std::endl;
+    std::cout << std::setw(24) << "Z attitude" << std::setw(16) << radiansToDegrees(error[2])
+            << std::endl;
+    std::cout << std::setw(24) << "  (integrated)" << std::setw(16)
+            << radiansToDegrees(error_integrated) << std::endl;
+    std::cout << "Gyroscope bias errors: " << error_bias[0] << ", " << error_bias[1] << ", "
+            << error_bias[2] << " rad/s" << std::endl;
+
+    return error[0] < degreesToRadians(1) && error[1] < error_kalman_filter
+            && error[2] < error_integrated && std::fabs(error_bias[0]) < 0.1 * std::fabs(bias[0])
+            && std::fabs(error_bias[1]) < 0.1 * std::fabs(bias[1]);
+}
+
+/**
+ *  @tparam Type Type of data for estimation.
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark the attitude estimator.
+ */
+template<typename Type>
+void
+benchmarkAttitudeEstimator(benchmark::State& state)
+{
+    const std::vector<Sample> samples = generate();
+    AttitudeEstimator<Type> attitude_estimator;
+    size_t index = 0;
+
+    attitude_estimator.setGains(AttitudeEstimatorParameter::gain_proportional,
+            AttitudeEstimatorParameter::gain_integral);
+
+    for (auto _ : state)
+    {
+        const Sample& sample = samples[index ++ % samples.size()];
+        attitude_estimator.update(Type(sample.angular_velocity[0]),
+                Type(sample.angular_velocity[1]), Type(sample.angular_velocity[2]),
+                Type(sample.acceleration[0]), Type(sample.acceleration[1]),
+                Type(sample.acceleration[2]), Type(PeriodParameter::fast));
+        benchmark::DoNotOptimize(attitude_estimator.getAttitudeX());
+        benchmark::DoNotOptimize(attitude_estimator.getAttitudeY());
+        benchmark::DoNotOptimize(attitude_estimator.getAttitudeZ());
+    }
+}
+
+/**
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark the Y attitude Kalman filter.
+ */
+void
+benchmarkKalmanFilter(benchmark::State& state)
+{
+    const std::vector<Sample> samples = generate();
+    KalmanFilter<float> kalman_filter;
+    size_t index = 0;
+
+    kalman_filter.setQangle(KalmanFilterParameter::q_angle);
+    kalman_filter.setQbias(KalmanFilterParameter::q_bias);
+    kalman_filter.setRmeasure(KalmanFilterParameter::r_measure);
+
+    for (auto _ : state)
+    {
+        const Sample& sample = samples[index ++ % samples.size()];
+        benchmark::DoNotOptimize(kalman_filter.getAngle(radiansToDegrees(
+                -std::atan2(sample.acceleration[0], sample.acceleration[2])),
+                radiansToDegrees(sample.angular_velocity[1]), PeriodParameter::fast));
+    }
+}
+
+/*
+ *  Register the benchmarks.
+ */
+BENCHMARK_TEMPLATE(benchmarkAttitudeEstimator, float);
+BENCHMARK_TEMPLATE(benchmarkAttitudeEstimator, double);
+BENCHMARK(benchmarkKalmanFilter);
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Validate the attitude estimator.
+     */
+    const bool passed = validate();
+    std::cout << "Attitude estimator " << (passed ? "passed" : "FAILED") << std::endl;
+
+    if (!passed)
+    {
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Run the benchmarks.
+     */
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return EXIT_SUCCESS;
+}
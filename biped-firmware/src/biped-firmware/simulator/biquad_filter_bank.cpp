@@ -0,0 +1,298 @@
+/**
+ *  @file   biquad_filter_bank.cpp
+ *  @author Simon Yu
+ *  @date   01/25/2022
+ *  @brief  Biquad filter bank benchmark source.
+ *
+ *  This file implements the biquad filter bank benchmark. The
+ *  benchmark first verifies the biquad filter bank against a
+ *  per-channel reference biquad filter, and the frequency responses
+ *  of the compile-time designed low-pass, high-pass, and notch
+ *  filters. It then measures the time per filtered sample of all
+ *  IMU channels, using the biquad filter bank with one and two
+ *  stages and using one low-pass filter per channel, with Google
+ *  Benchmark.
+ *
+ *  The benchmark exits with failure if any verification fails.
+ *
+ *  Usage: biped-biquad-filter-bank [benchmark options]
+ */
+
+/*
+ *  External headers.
+ */
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "simulator/parameter.h"
+#include "utility/biquad_filter_bank.hpp"
+#include "utility/low_pass_filter.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Design the filters at compile time.
+ */
+constexpr double sample_rate = 1 / PeriodParameter::fast;
+constexpr BiquadCoefficients coefficients_low_pass = BiquadCoefficients::lowPass(
+        IMUParameter::acceleration_cutoff, sample_rate, IMUParameter::quality_factor);
+constexpr BiquadCoefficients coefficients_high_pass = BiquadCoefficients::highPass(
+        IMUParameter::acceleration_cutoff, sample_rate, IMUParameter::quality_factor);
+constexpr BiquadCoefficients coefficients_notch = BiquadCoefficients::notch(
+        IMUParameter::acceleration_cutoff, sample_rate, 5);
+
+/**
+ *  @param  count Number of samples.
+ *  @return Random IMU samples, one array of all channels per sample.
+ *  @brief  Generate random IMU samples.
+ *
+ *  This function generates random accelerometer and gyroscope
+ *  samples around the gravity on the Z axis.
+ */
+std::vector<std::array<float, IMUParameter::channel_count>>
+generate(const size_t& count)
+{
+    std::mt19937 random_number_generator(SimulatedSensorParameter::seed);
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<std::array<float, IMUParameter::channel_count>> samples(count);
+
+    for (auto& sample : samples)
+    {
+        for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+        {
+            sample[channel] = (channel == 2 ? 9.81f : 0) + noise(random_number_generator);
+        }
+    }
+
+    return samples;
+}
+
+/**
+ *  @param  coefficients Biquad filter coefficients struct.
+ *  @param  frequency Frequency, in Hertz.
+ *  @return Steady state gain at the frequency.
+ *  @brief  Measure the gain of a biquad filter.
+ *
+ *  This function filters a sinusoid of the given frequency using
+ *  a single channel biquad filter bank and returns the ratio of
+ *  the output to the input amplitudes after the transient.
+ */
+double
+measureGain(const BiquadCoefficients& coefficients, const double& frequency)
+{
+    BiquadFilterBank<double, 1, 1> biquad_filter_bank;
+    double amplitude = 0;
+    biquad_filter_bank.setCoefficients(0, coefficients);
+
+    for (size_t i = 0; i < 4000; i ++)
+    {
+        double data[1] = { std::sin(2 * M_PI * frequency * i / sample_rate) };
+        biquad_filter_bank.filter(data);
+
+        if (i >= 2000)
+        {
+            amplitude = std::fmax(amplitude, std::fabs(data[0]));
+        }
+    }
+
+    return amplitude;
+}
+
+/**
+ *  @return Whether the biquad filter bank passed the verification.
+ *  @brief  Verify the biquad filter bank.
+ *
+ *  This function compares the biquad filter bank with two stages
+ *  against a per-channel reference biquad filter in the direct
+ *  form I, and checks the gains of the designed filters at and
+ *  away from their cutoff and center frequencies.
+ */
+bool
+verify()
+{
+    BiquadFilterBank<double, IMUParameter::channel_count, 2> biquad_filter_bank;
+    double x[IMUParameter::channel_count][2][2] = { };
+    double y[IMUParameter::channel_count][2][2] = { };
+    const BiquadCoefficients coefficients[2] = { coefficients_low_pass, coefficients_notch };
+    double error_max = 0;
+    bool first = true;
+
+    biquad_filter_bank.setCoefficients(0, coefficients[0]);
+    biquad_filter_bank.setCoefficients(1, coefficients[1]);
+
+    for (const auto& sample : generate(1000))
+    {
+        double data[IMUParameter::channel_count];
+
+        for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+        {
+            data[channel] = sample[channel];
+        }
+
+        /*
+         *  Start the reference filters at zero, with the filter
+         *  bank reset to the same state.
+         */
+        if (first)
+        {
+            const double zero[IMUParameter::channel_count] = { };
+            biquad_filter_bank.reset(zero);
+            first = false;
+        }
+
+        biquad_filter_bank.filter(data);
+
+        for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+        {
+            double input = sample[channel];
+
+            for (size_t stage = 0; stage < 2; stage ++)
+            {
+                const BiquadCoefficients& c = coefficients[stage];
+                const double output = c.b0 * input + c.b1 * x[channel][stage][0]
+                        + c.b2 * x[channel][stage][1] - c.a1 * y[channel][stage][0]
+                        - c.a2 * y[channel][stage][1];
+                x[channel][stage][1] = x[channel][stage][0];
+                x[channel][stage][0] = input;
+                y[channel][stage][1] = y[channel][stage][0];
+                y[channel][stage][0] = output;
+                input = output;
+            }
+
+            error_max = std::fmax(error_max, std::fabs(input - data[channel]));
+        }
+    }
+
+    /*
+     *  Measure the gains of the designed filters.
+     */
+    const double cutoff = IMUParameter::acceleration_cutoff;
+    const double gain_low_pass_pass = measureGain(coefficients_low_pass, cutoff / 10);
+    const double gain_low_pass_cutoff = measureGain(coefficients_low_pass, cutoff);
+    const double gain_low_pass_stop = measureGain(coefficients_low_pass, cutoff * 4);
+    const double gain_high_pass_cutoff = measureGain(coefficients_high_pass, cutoff);
+    const double gain_high_pass_stop = measureGain(coefficients_high_pass, cutoff / 10);
+    const double gain_notch_center = measureGain(coefficients_notch, cutoff);
+    const double gain_notch_pass = measureGain(coefficients_notch, cutoff * 2);
+
+    std::cout << "Reference maximum error: " << error_max << std::endl;
+    std::cout << "Low-pass gain: " << gain_low_pass_pass << " at " << cutoff / 10 << " Hz, "
+            << gain_low_pass_cutoff << " at " << cutoff << " Hz, " << gain_low_pass_stop << " at "
+            << cutoff * 4 << " Hz" << std::endl;
+    std::cout << "High-pass gain: " << gain_high_pass_stop << " at " << cutoff / 10 << " Hz, "
+            << gain_high_pass_cutoff << " at " << cutoff << " Hz" << std::endl;
+    std::cout << "Notch gain: " << gain_notch_center << " at " << cutoff << " Hz, "
+            << gain_notch_pass << " at " << cutoff * 2 << " Hz" << std::endl;
+
+    return error_max < 1e-9 && std::fabs(gain_low_pass_pass - 1) < 0.01
+            && std::fabs(gain_low_pass_cutoff - M_SQRT1_2) < 0.01 && gain_low_pass_stop < 0.1
+            && std::fabs(gain_high_pass_cutoff - M_SQRT1_2) < 0.01 && gain_high_pass_stop < 0.02
+            && gain_notch_center < 0.01 && gain_notch_pass > 0.9;
+}
+
+/**
+ *  @tparam Stages Number of cascaded biquad stages per channel.
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark the biquad filter bank.
+ */
+template<size_t Stages>
+void
+benchmarkBiquadFilterBank(benchmark::State& state)
+{
+    BiquadFilterBank<float, IMUParameter::channel_count, Stages> biquad_filter_bank;
+    const auto samples = generate(1024);
+    size_t index = 0;
+
+    for (size_t stage = 0; stage < Stages; stage ++)
+    {
+        biquad_filter_bank.setCoefficients(stage, coefficients_low_pass);
+    }
+
+    for (auto _ : state)
+    {
+        float data[IMUParameter::channel_count];
+        const auto& sample = samples[index ++ & 1023];
+
+        for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+        {
+            data[channel] = sample[channel];
+        }
+
+        biquad_filter_bank.filter(data);
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+/**
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark one low-pass filter per channel.
+ */
+void
+benchmarkLowPassFilters(benchmark::State& state)
+{
+    LowPassFilter<float> low_pass_filters[IMUParameter::channel_count];
+    const auto samples = generate(1024);
+    size_t index = 0;
+
+    for (auto& low_pass_filter : low_pass_filters)
+    {
+        low_pass_filter.setBeta(EncoderParameter::low_pass_filter_beta);
+    }
+
+    for (auto _ : state)
+    {
+        float data[IMUParameter::channel_count];
+        const auto& sample = samples[index ++ & 1023];
+
+        for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+        {
+            data[channel] = low_pass_filters[channel].filter(sample[channel]);
+        }
+
+        benchmark::DoNotOptimize(data);
+    }
+}
+
+/*
+ *  Register the benchmarks.
+ */
+BENCHMARK_TEMPLATE(benchmarkBiquadFilterBank, 1);
+BENCHMARK_TEMPLATE(benchmarkBiquadFilterBank, 2);
+BENCHMARK(benchmarkLowPassFilters);
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Verify the biquad filter bank.
+     */
+    const bool passed = verify();
+    std::cout << "Biquad filter bank " << (passed ? "passed" : "FAILED") << std::endl;
+
+    if (!passed)
+    {
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Run the benchmarks.
+     */
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,516 @@
+/**
+ *  @file   camera.cpp
+ *  @author Simon Yu
+ *  @date   02/01/2022
+ *  @brief  Camera chunk harness source.
+ *
+ *  This file implements the camera chunk harness. The harness splits
+ *  synthetic camera frames of various sizes, including sizes that are
+ *  exact multiples of the chunk payload size and sizes that need more
+ *  than 255 chunks, using the camera chunker. It verifies that every
+ *  datagram fits the camera buffer size and carries a valid camera
+ *  chunk header, and that the chunks cover each camera frame exactly.
+ *
+ *  It then delivers the chunks of interleaved camera frames over a
+ *  simulated lossy link, which drops, duplicates, and reorders the
+ *  datagrams, and reassembles them by their camera chunk headers into
+ *  a fixed number of slots the same way as the Biped ground station
+ *  camera daemon. It verifies that every completed camera frame is
+ *  identical to the one sent, and reports the per-frame loss
+ *  statistics.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-camera [frames] [loss]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "common/type.h"
+#include "utility/camera_chunker.hpp"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Camera chunker type.
+ */
+using Chunker = CameraChunker<NetworkParameter::buffer_size_camera>;
+
+/*
+ *  Datagram type.
+ */
+using Datagram = std::vector<uint8_t>;
+
+/**
+ *  @brief  Link struct.
+ *
+ *  This struct records the datagrams written by the camera chunker
+ *  in place of the UDP interface.
+ */
+struct Link
+{
+    std::vector<Datagram> datagrams;    //!< Written datagrams.
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  buffer Datagram buffer pointer.
+     *  @param  size Size of the datagram buffer, in bytes.
+     *  @return Size written, in bytes.
+     *  @brief  Record a datagram.
+     */
+    size_t
+    writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8_t* buffer,
+            const size_t& size)
+    {
+        datagrams.emplace_back(buffer, buffer + size);
+        return size;
+    }
+};
+
+/**
+ *  @brief  Slot struct.
+ *
+ *  This struct contains a preallocated camera frame reassembly slot,
+ *  the same as that of the Biped ground station camera daemon.
+ */
+struct Slot
+{
+    bool active = false;    //!< Whether the slot holds a camera frame.
+    std::vector<uint8_t> buffer;    //!< Camera frame buffer.
+    std::vector<bool> chunk_received;   //!< Whether each chunk was received.
+    size_t chunk_count_duplicate = 0;   //!< Number of duplicate chunks.
+    size_t chunk_count_received = 0;    //!< Number of received chunks.
+    CameraChunkHeader header;   //!< Camera chunk header of the camera frame.
+};
+
+/**
+ *  @brief  Statistics struct.
+ *
+ *  This struct contains the reassembly statistics.
+ */
+struct Statistics
+{
+    size_t chunk_count_lost = 0;    //!< Number of chunks lost from dropped camera frames.
+    size_t frame_count_complete = 0;    //!< Number of completed camera frames.
+    size_t frame_count_corrupted = 0;   //!< Number of completed camera frames that differ.
+    size_t frame_count_dropped = 0; //!< Number of dropped incomplete camera frames.
+    size_t frame_count_stale = 0;   //!< Number of datagrams of stale camera frames.
+};
+
+/**
+ *  @param  size Camera frame size, in bytes.
+ *  @param  random Random number generator.
+ *  @return Synthetic camera frame.
+ *  @brief  Generate a synthetic camera frame.
+ */
+static std::vector<uint8_t>
+generate(const size_t& size, std::mt19937& random)
+{
+    std::vector<uint8_t> frame(size);
+
+    for (auto& byte : frame)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    return frame;
+}
+
+/**
+ *  @param  frame Synthetic camera frame.
+ *  @param  datagrams Datagrams of the camera frame.
+ *  @param  frame_id Expected camera frame ID.
+ *  @return Whether the datagrams passed the verification.
+ *  @brief  Verify the datagrams of a camera frame.
+ *
+ *  This function verifies that every datagram fits the camera
+ *  buffer size, that its camera chunk header deserializes with the
+ *  expected camera frame ID, chunk index, and number of chunks, and
+ *  that the chunk payloads cover the camera frame exactly and in
+ *  order.
+ */
+static bool
+verifyDatagrams(const std::vector<uint8_t>& frame, const std::vector<Datagram>& datagrams,
+        const uint32_t& frame_id)
+{
+    size_t offset = 0;
+
+    for (size_t index = 0; index < datagrams.size(); index ++)
+    {
+        const Datagram& datagram = datagrams[index];
+        CameraChunkHeader header;
+        zpp::serializer::memory_view_input_archive deserializer(datagram.data(),
+                datagram.size());
+
+        if (datagram.size() > NetworkParameter::buffer_size_camera || !deserializer(header)
+                || header.frame_id != frame_id || header.chunk_index != index
+                || header.chunk_count != datagrams.size() || header.frame_size != frame.size()
+                || header.getOffset() != offset
+                || datagram.size() != CameraChunkHeader::size + header.getPayloadSize()
+                || !std::equal(datagram.begin() + CameraChunkHeader::size, datagram.end(),
+                        frame.begin() + offset))
+        {
+            std::cerr << "Invalid chunk " << index << " of camera frame " << frame_id << "."
+                    << std::endl;
+            return false;
+        }
+
+        offset += header.getPayloadSize();
+    }
+
+    if (offset != frame.size())
+    {
+        std::cerr << "Chunks of camera frame " << frame_id << " cover " << offset << " of "
+                << frame.size() << " bytes." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  @param  random Random number generator.
+ *  @return Whether the chunking passed the verification.
+ *  @brief  Verify the camera frame chunking.
+ *
+ *  This function chunks camera frames of edge case sizes and random
+ *  sizes, verifies their datagrams, and verifies that empty and
+ *  oversized camera frames are rejected.
+ */
+static bool
+verifyChunking(std::mt19937& random)
+{
+    const size_t payload_size_max = Chunker::payload_size_max;
+    std::vector<size_t> sizes = { 1, payload_size_max - 1, payload_size_max, payload_size_max + 1,
+            2 * payload_size_max, 2 * payload_size_max + 1, 7 * payload_size_max,
+            255 * payload_size_max, 255 * payload_size_max + 1, 400 * payload_size_max + 17 };
+    std::uniform_int_distribution<size_t> distribution(1, 64 * payload_size_max);
+    Chunker chunker;
+    size_t chunk_count_max = 0;
+
+    for (size_t i = 0; i < 100; i ++)
+    {
+        sizes.push_back(distribution(random));
+    }
+
+    for (const auto& size : sizes)
+    {
+        const std::vector<uint8_t> frame = generate(size, random);
+        const uint32_t frame_id = chunker.getFrameID();
+        Link link;
+
+        const size_t bytes = chunker.write(link, NetworkParameter::ip_ground_station,
+                NetworkParameter::port_udp_camera, frame.data(), frame.size(), size);
+
+        if (bytes != size + link.datagrams.size() * CameraChunkHeader::size
+                || link.datagrams.size()
+                        != CameraChunkHeader::getChunkCount(size, payload_size_max)
+                || !verifyDatagrams(frame, link.datagrams, frame_id))
+        {
+            std::cerr << "Failed to chunk camera frame of " << size << " bytes." << std::endl;
+            return false;
+        }
+
+        chunk_count_max = std::max(chunk_count_max, link.datagrams.size());
+    }
+
+    Link link;
+
+    if (chunker.write(link, NetworkParameter::ip_ground_station, NetworkParameter::port_udp_camera,
+            nullptr, 0, 0) != 0 || !link.datagrams.empty()
+            || CameraChunkHeader::getChunkCount(0, payload_size_max) != 0
+            || CameraChunkHeader::getChunkCount(
+                    (std::numeric_limits<uint16_t>::max() + 1) * payload_size_max,
+                    payload_size_max) != 0)
+    {
+        std::cerr << "Failed to reject empty or oversized camera frames." << std::endl;
+        return false;
+    }
+
+    std::cout << "Chunking: " << sizes.size() << " camera frames, up to " << chunk_count_max
+            << " chunks of at most " << NetworkParameter::buffer_size_camera << " bytes ("
+            << CameraChunkHeader::size << "-byte header)." << std::endl;
+
+    return true;
+}
+
+/**
+ *  @param  slot Slot of the camera frame.
+ *  @param  statistics Reassembly statistics.
+ *  @brief  Drop an incomplete camera frame.
+ */
+static void
+drop(Slot& slot, Statistics& statistics)
+{
+    slot.active = false;
+    statistics.chunk_count_lost += slot.header.chunk_count - slot.chunk_count_received;
+    statistics.frame_count_dropped ++;
+}
+
+/**
+ *  @param  frames Number of camera frames.
+ *  @param  loss Datagram loss probability.
+ *  @param  reorder Maximum datagram reordering distance, in datagrams.
+ *  @param  random Random number generator.
+ *  @return Whether the reassembly passed the verification.
+ *  @brief  Verify the camera frame reassembly.
+ *
+ *  This function chunks the given number of camera frames, delivers
+ *  their datagrams over a simulated lossy link that also duplicates
+ *  and reorders datagrams across neighboring camera frames, and
+ *  reassembles them into a fixed number of slots. A completed camera
+ *  frame drops all older incomplete ones, and datagrams of camera
+ *  frames not newer than the last completed one are stale. Without
+ *  loss or reordering, every camera frame must be completed.
+ */
+static bool
+verifyReassembly(const unsigned long& frames, const double& loss, const double& reorder,
+        std::mt19937& random)
+{
+    constexpr size_t slot_count = 4;
+    std::uniform_int_distribution<size_t> distribution_size(1, 24 * Chunker::payload_size_max);
+    std::bernoulli_distribution distribution_loss(loss);
+    std::bernoulli_distribution distribution_duplicate(reorder > 0 ? 0.02 : 0);
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<Datagram> datagrams;
+    std::array<Slot, slot_count> slots;
+    Statistics statistics;
+    Chunker chunker;
+    bool frame_id_last_valid = false;
+    uint32_t frame_id_last = 0;
+    size_t chunk_count_sent = 0;
+
+    for (auto& slot : slots)
+    {
+        slot.buffer.resize(24 * Chunker::payload_size_max);
+    }
+
+    /*
+     *  Chunk every camera frame, drop and duplicate datagrams, and
+     *  then reorder the datagrams by up to the given distance.
+     */
+    for (unsigned long i = 0; i < frames; i ++)
+    {
+        Link link;
+
+        sent.push_back(generate(distribution_size(random), random));
+        chunker.write(link, NetworkParameter::ip_ground_station, NetworkParameter::port_udp_camera,
+                sent.back().data(), sent.back().size(), i);
+        chunk_count_sent += link.datagrams.size();
+
+        for (auto& datagram : link.datagrams)
+        {
+            if (distribution_loss(random))
+            {
+                continue;
+            }
+
+            datagrams.push_back(datagram);
+
+            if (distribution_duplicate(random))
+            {
+                datagrams.push_back(datagram);
+            }
+        }
+    }
+
+    std::vector<std::pair<double, size_t>> order;
+    std::uniform_real_distribution<double> distribution_jitter(0, reorder);
+    std::vector<Datagram> datagrams_reordered;
+
+    for (size_t i = 0; i < datagrams.size(); i ++)
+    {
+        order.emplace_back(i + distribution_jitter(random), i);
+    }
+
+    std::sort(order.begin(), order.end());
+
+    for (const auto& entry : order)
+    {
+        datagrams_reordered.push_back(datagrams[entry.second]);
+    }
+
+    datagrams.swap(datagrams_reordered);
+
+    for (const auto& datagram : datagrams)
+    {
+        CameraChunkHeader header;
+        zpp::serializer::memory_view_input_archive deserializer(datagram.data(), datagram.size());
+
+        if (!deserializer(header)
+                || datagram.size() != CameraChunkHeader::size + header.getPayloadSize())
+        {
+            std::cerr << "Failed to deserialize camera chunk header." << std::endl;
+            return false;
+        }
+
+        if (frame_id_last_valid && static_cast<int32_t>(frame_id_last - header.frame_id) >= 0)
+        {
+            statistics.frame_count_stale ++;
+            continue;
+        }
+
+        /*
+         *  Find the slot of the camera frame, or a free slot, or evict
+         *  the oldest camera frame.
+         */
+        Slot* slot_found = nullptr;
+        Slot* slot_free = nullptr;
+        Slot* slot_oldest = nullptr;
+
+        for (auto& slot : slots)
+        {
+            if (!slot.active)
+            {
+                slot_free = slot_free ? slot_free : &slot;
+            }
+            else if (slot.header.frame_id == header.frame_id)
+            {
+                slot_found = &slot;
+            }
+            else if (!slot_oldest
+                    || static_cast<int32_t>(slot.header.frame_id - slot_oldest->header.frame_id)
+                            < 0)
+            {
+                slot_oldest = &slot;
+            }
+        }
+
+        Slot* slot = slot_found;
+
+        if (!slot)
+        {
+            slot = slot_free ? slot_free : slot_oldest;
+
+            if (slot->active)
+            {
+                drop(*slot, statistics);
+            }
+
+            slot->active = true;
+            slot->chunk_received.assign(header.chunk_count, false);
+            slot->chunk_count_duplicate = 0;
+            slot->chunk_count_received = 0;
+            slot->header = header;
+        }
+
+        if (slot->chunk_received[header.chunk_index])
+        {
+            slot->chunk_count_duplicate ++;
+            continue;
+        }
+
+        std::copy(datagram.begin() + CameraChunkHeader::size, datagram.end(),
+                slot->buffer.begin() + header.getOffset());
+        slot->chunk_received[header.chunk_index] = true;
+        slot->chunk_count_received ++;
+
+        if (slot->chunk_count_received < slot->header.chunk_count)
+        {
+            continue;
+        }
+
+        /*
+         *  Complete the camera frame, compare it against the one sent,
+         *  and drop all older incomplete camera frames.
+         */
+        const std::vector<uint8_t>& frame = sent[header.frame_id];
+
+        slot->active = false;
+        frame_id_last = header.frame_id;
+        frame_id_last_valid = true;
+        statistics.frame_count_complete ++;
+
+        if (!std::equal(frame.begin(), frame.end(), slot->buffer.begin()))
+        {
+            statistics.frame_count_corrupted ++;
+        }
+
+        for (auto& slot_older : slots)
+        {
+            if (slot_older.active
+                    && static_cast<int32_t>(frame_id_last - slot_older.header.frame_id) > 0)
+            {
+                drop(slot_older, statistics);
+            }
+        }
+    }
+
+    std::cout << "Reassembly: " << frames << " camera frames, " << chunk_count_sent
+            << " chunks, " << datagrams.size() << " datagrams delivered at " << loss * 100
+            << "% loss, reordered by up to " << reorder << "." << std::endl;
+    std::cout << "Frames: " << statistics.frame_count_complete << " complete, "
+            << statistics.frame_count_dropped << " dropped (" << statistics.chunk_count_lost
+            << " chunks missing), " << statistics.frame_count_corrupted << " corrupted, "
+            << statistics.frame_count_stale << " stale datagrams." << std::endl;
+
+    if (statistics.frame_count_corrupted > 0)
+    {
+        std::cerr << "Reassembled camera frames differ from those sent." << std::endl;
+        return false;
+    }
+
+    if (loss == 0 && reorder == 0 && statistics.frame_count_complete < frames)
+    {
+        std::cerr << "Camera frames went missing without loss or reordering." << std::endl;
+        return false;
+    }
+
+    if (statistics.frame_count_complete == 0)
+    {
+        std::cerr << "No camera frame was reassembled." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Camera chunk harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long frames = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const double loss = argc > 2 ? std::atof(argv[2]) : 0.01;
+
+    if (frames == 0 || loss < 0 || loss >= 1)
+    {
+        std::cerr << "Invalid number of camera frames or loss." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(431);
+
+    if (!verifyChunking(random) || !verifyReassembly(frames, 0, 0, random)
+            || !verifyReassembly(frames, 0, 8, random) || !verifyReassembly(frames, loss, 8, random))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,504 @@
+/**
+ *  @file   camera_pipeline.cpp
+ *  @author Simon Yu
+ *  @date   02/02/2022
+ *  @brief  Camera pipeline harness source.
+ *
+ *  This file implements the camera pipeline harness. The harness
+ *  runs the camera pipeline against a fake camera, which produces a
+ *  camera frame every sensor period the same way as the ESP-IDF
+ *  camera driver grabbing the latest camera frame, and spends the
+ *  given times encoding and transmitting each camera frame.
+ *
+ *  It first runs the capture, encode, and transmit stages one after
+ *  another in a single thread, the same way as the camera UDP write
+ *  task did before the camera pipeline. It then runs each stage in
+ *  its own thread, with two and three camera frame buffers, handing
+ *  the camera frames through host queues in place of the FreeRTOS
+ *  queues. For each run, it reports the frame rate, the latency, and
+ *  the per-stage execution times, and verifies that every camera
+ *  frame is transmitted in order and released exactly once, and
+ *  that no more camera frames are in flight than camera frame
+ *  buffers. Finally, it injects encode failures and verifies that
+ *  the dropped camera frames are counted and their buffers reused.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-camera-pipeline [frames] [encode time] [transmit time]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "utility/camera_pipeline.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Host clock type.
+ */
+using HostClock = std::chrono::steady_clock;
+
+/*
+ *  Sensor period, in microseconds.
+ */
+static constexpr unsigned long period_sensor = 8000;
+
+/*
+ *  Host clock start time point.
+ */
+static const HostClock::time_point time_point_start = HostClock::now();
+
+/**
+ *  @return Host clock time since the start, in microseconds.
+ *  @brief  Host microsecond clock function.
+ */
+static unsigned long
+clockHost()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(HostClock::now()
+            - time_point_start).count();
+}
+
+/**
+ *  @param  time Host clock time, in microseconds.
+ *  @brief  Sleep until the given host clock time.
+ */
+static void
+sleepUntil(const unsigned long& time)
+{
+    std::this_thread::sleep_until(time_point_start + std::chrono::microseconds(time));
+}
+
+/**
+ *  @tparam Type Type of the elements.
+ *  @tparam Length Maximum number of elements.
+ *  @brief  Host queue templated class.
+ *
+ *  This templated class stands in for the FreeRTOS queue on the
+ *  host. Sending to a full queue and receiving from an empty queue
+ *  block until the other side catches up.
+ */
+template<typename Type, size_t Length>
+class HostQueue
+{
+public:
+
+    /**
+     *  @param  element Received element.
+     *  @return Whether an element was received.
+     *  @brief  Receive the oldest element, waiting until one is available.
+     */
+    bool
+    receive(Type& element)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !elements_.empty(); });
+        element = elements_.front();
+        elements_.pop_front();
+        condition_.notify_all();
+        return true;
+    }
+
+    /**
+     *  @param  element Element to be sent.
+     *  @return Whether the element was sent.
+     *  @brief  Send an element, waiting until there is room.
+     */
+    bool
+    send(const Type& element)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return elements_.size() < Length; });
+        elements_.push_back(element);
+        condition_.notify_all();
+        return true;
+    }
+
+private:
+
+    std::condition_variable condition_; //!< Queue condition variable.
+    std::deque<Type> elements_; //!< Queue elements.
+    std::mutex mutex_;  //!< Queue mutex.
+};
+
+/**
+ *  @brief  Fake camera class.
+ *
+ *  This class provides the camera frame source functions of the
+ *  camera, with a sensor producing a camera frame every sensor
+ *  period, and the given encode and transmit times. It counts the
+ *  camera frame buffers in flight and their releases.
+ */
+class FakeCamera
+{
+public:
+
+    /**
+     *  @param  time_encode Encode time, in microseconds.
+     *  @param  time_transmit Transmit time, in microseconds.
+     *  @param  divisor_failure Encode failure period, in camera frames, or 0 for none.
+     *  @brief  Fake camera class constructor.
+     */
+    FakeCamera(const unsigned long& time_encode, const unsigned long& time_transmit,
+            const uint32_t& divisor_failure) : divisor_failure_(divisor_failure),
+            frame_count_captured_(0), frame_count_released_(0), in_flight_(0),
+            in_flight_max_(0), time_encode_(time_encode), time_sensor_(0),
+            time_transmit_(time_transmit)
+    {
+    }
+
+    /**
+     *  @param  frame Camera frame struct.
+     *  @return Whether a camera frame was captured.
+     *  @brief  Capture the latest camera frame.
+     *
+     *  This function waits for the next sensor frame after the last
+     *  captured one, unless a newer one is already available.
+     */
+    bool
+    capture(CameraFrame& frame)
+    {
+        const unsigned long time = clockHost();
+        time_sensor_ = std::max(time_sensor_ + period_sensor,
+                time / period_sensor * period_sensor);
+
+        if (time_sensor_ > time)
+        {
+            sleepUntil(time_sensor_);
+        }
+
+        frame.handle = &buffer_;
+        frame.timestamp = time_sensor_;
+        frame_count_captured_ ++;
+
+        const unsigned long in_flight = ++ in_flight_;
+        unsigned long in_flight_max = in_flight_max_;
+
+        while (in_flight > in_flight_max
+                && !in_flight_max_.compare_exchange_weak(in_flight_max, in_flight))
+        {
+        }
+
+        return true;
+    }
+
+    /**
+     *  @param  frame Camera frame struct.
+     *  @return Whether the camera frame was encoded.
+     *  @brief  Encode a camera frame, failing periodically if so given.
+     */
+    bool
+    encode(CameraFrame& frame)
+    {
+        sleepUntil(clockHost() + time_encode_);
+
+        if (divisor_failure_ > 0 && frame.index % divisor_failure_ == divisor_failure_ - 1)
+        {
+            return false;
+        }
+
+        frame.buffer = buffer_.data();
+        frame.size = buffer_.size();
+        return true;
+    }
+
+    /**
+     *  @param  frame Camera frame struct.
+     *  @brief  Release the buffers of a camera frame.
+     */
+    void
+    release(CameraFrame& frame)
+    {
+        if (frame.handle)
+        {
+            frame.handle = nullptr;
+            frame_count_released_ ++;
+            in_flight_ --;
+        }
+
+        frame.buffer = nullptr;
+    }
+
+    /**
+     *  @param  frame Encoded camera frame struct.
+     *  @return Size sent, in bytes.
+     *  @brief  Transmit an encoded camera frame.
+     */
+    size_t
+    transmit(const CameraFrame& frame)
+    {
+        sleepUntil(clockHost() + time_transmit_);
+        return frame.buffer ? frame.size : 0;
+    }
+
+    /**
+     *  @return Number of captured camera frames.
+     */
+    unsigned long
+    getFrameCountCaptured() const
+    {
+        return frame_count_captured_;
+    }
+
+    /**
+     *  @return Number of released camera frames.
+     */
+    unsigned long
+    getFrameCountReleased() const
+    {
+        return frame_count_released_;
+    }
+
+    /**
+     *  @return Maximum number of camera frames in flight.
+     */
+    unsigned long
+    getInFlightMaximum() const
+    {
+        return in_flight_max_;
+    }
+
+private:
+
+    std::vector<uint8_t> buffer_ = std::vector<uint8_t>(16384);    //!< Camera frame buffer.
+    const uint32_t divisor_failure_;    //!< Encode failure period, in camera frames.
+    std::atomic<unsigned long> frame_count_captured_;   //!< Number of captured camera frames.
+    std::atomic<unsigned long> frame_count_released_;   //!< Number of released camera frames.
+    std::atomic<unsigned long> in_flight_;  //!< Number of camera frames in flight.
+    std::atomic<unsigned long> in_flight_max_;  //!< Maximum number of camera frames in flight.
+    const unsigned long time_encode_;   //!< Encode time, in microseconds.
+    unsigned long time_sensor_; //!< Time of the last captured sensor frame, in microseconds.
+    const unsigned long time_transmit_; //!< Transmit time, in microseconds.
+};
+
+/**
+ *  @param  samples Samples, sorted in place.
+ *  @param  percentile Percentile, between 0 and 1.
+ *  @return Percentile of the samples.
+ *  @brief  Compute a percentile of the samples.
+ */
+static unsigned long
+percentile(std::vector<unsigned long>& samples, const double& percentile)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1,
+            static_cast<size_t>(percentile * samples.size()))];
+}
+
+/**
+ *  @tparam Depth Number of camera frame buffers.
+ *  @param  name Run name.
+ *  @param  frames Number of camera frames.
+ *  @param  time_encode Encode time, in microseconds.
+ *  @param  time_transmit Transmit time, in microseconds.
+ *  @param  threaded Whether each stage runs in its own thread.
+ *  @param  divisor_failure Encode failure period, in camera frames, or 0 for none.
+ *  @param  frame_rate Measured frame rate, in frames per second.
+ *  @return Whether the run passed the verification.
+ *  @brief  Run the camera pipeline against the fake camera.
+ */
+template<size_t Depth>
+static bool
+run(const std::string& name, const unsigned long& frames, const unsigned long& time_encode,
+        const unsigned long& time_transmit, const bool& threaded, const uint32_t& divisor_failure,
+        double& frame_rate)
+{
+    FakeCamera camera(time_encode, time_transmit, divisor_failure);
+    CameraPipeline<FakeCamera, HostQueue, Depth> pipeline(camera, &clockHost);
+    const unsigned long drops = divisor_failure > 0 ? frames / divisor_failure : 0;
+    std::vector<CameraFrame> transmitted;
+    bool ordered = true;
+
+    transmitted.reserve(frames);
+
+    /*
+     *  Run the transmit stage, verifying that the camera frames arrive in order,
+     *  skipping only the dropped ones.
+     */
+    auto transmit = [&]
+    {
+        for (unsigned long i = 0; i < frames - drops; i ++)
+        {
+            CameraFrame frame;
+
+            if (!pipeline.transmit(frame))
+            {
+                ordered = false;
+                return;
+            }
+
+            if (!transmitted.empty() && frame.index <= transmitted.back().index)
+            {
+                ordered = false;
+            }
+
+            transmitted.push_back(frame);
+        }
+    };
+
+    const unsigned long time_start = clockHost();
+
+    if (threaded)
+    {
+        std::thread thread_capture([&]
+        {
+            for (unsigned long i = 0; i < frames; i ++)
+            {
+                pipeline.capture();
+            }
+        });
+
+        std::thread thread_encode([&]
+        {
+            for (unsigned long i = 0; i < frames; i ++)
+            {
+                pipeline.encode();
+            }
+        });
+
+        transmit();
+        thread_capture.join();
+        thread_encode.join();
+    }
+    else
+    {
+        for (unsigned long i = 0; i < frames; i ++)
+        {
+            if (pipeline.capture() && pipeline.encode())
+            {
+                CameraFrame frame;
+
+                if (pipeline.transmit(frame))
+                {
+                    if (!transmitted.empty() && frame.index <= transmitted.back().index)
+                    {
+                        ordered = false;
+                    }
+
+                    transmitted.push_back(frame);
+                }
+            }
+        }
+    }
+
+    const unsigned long duration = clockHost() - time_start;
+    std::vector<unsigned long> latency, capture, encode, send;
+
+    for (const auto& frame : transmitted)
+    {
+        latency.push_back(frame.latency);
+        capture.push_back(frame.execution_time_capture);
+        encode.push_back(frame.execution_time_encode);
+        send.push_back(frame.execution_time_transmit);
+    }
+
+    frame_rate = transmitted.size() * 1e6 / duration;
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(8) << frame_rate << " frames/s"
+            << std::setw(8) << percentile(latency, 0.5) / 1e3 << std::setw(8)
+            << percentile(latency, 1) / 1e3 << " ms latency (50th/max)" << std::setw(8)
+            << percentile(capture, 0.5) / 1e3 << std::setw(8) << percentile(encode, 0.5) / 1e3
+            << std::setw(8) << percentile(send, 0.5) / 1e3
+            << " ms capture/encode/transmit (50th)" << std::setw(4)
+            << camera.getInFlightMaximum() << " in flight, " << pipeline.getDropCount()
+            << " dropped" << std::endl;
+
+    if (!ordered || transmitted.size() != frames - drops || pipeline.getDropCount() != drops)
+    {
+        std::cerr << name << ": " << transmitted.size() << " of " << frames - drops
+                << " camera frames transmitted in order, " << pipeline.getDropCount() << " of "
+                << drops << " dropped." << std::endl;
+        return false;
+    }
+
+    if (camera.getFrameCountReleased() != camera.getFrameCountCaptured()
+            || camera.getInFlightMaximum() > Depth)
+    {
+        std::cerr << name << ": " << camera.getFrameCountReleased() << " of "
+                << camera.getFrameCountCaptured() << " camera frames released, up to "
+                << camera.getInFlightMaximum() << " of " << Depth << " in flight." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Camera pipeline harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long frames = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    const unsigned long time_encode = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+    const unsigned long time_transmit = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 12000;
+
+    if (frames == 0)
+    {
+        std::cerr << "Invalid number of camera frames." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Sensor period " << period_sensor / 1e3 << " ms, encode " << time_encode / 1e3
+            << " ms, transmit " << time_transmit / 1e3 << " ms, " << frames
+            << " camera frames." << std::endl;
+
+    double frame_rate_serial = 0;
+    double frame_rate_pipeline = 0;
+    double frame_rate_pipeline_deep = 0;
+    double frame_rate_failure = 0;
+
+    if (!run<1>("Serial", frames, time_encode, time_transmit, false, 0, frame_rate_serial)
+            || !run<CameraParameter::frame_buffer_count>("Pipeline", frames, time_encode,
+                    time_transmit, true, 0, frame_rate_pipeline)
+            || !run<CameraParameter::frame_buffer_count + 1>("Pipeline (one more buffer)",
+                    frames, time_encode, time_transmit, true, 0, frame_rate_pipeline_deep)
+            || !run<CameraParameter::frame_buffer_count>("Pipeline (encode failures)", frames,
+                    time_encode, time_transmit, true, 7, frame_rate_failure))
+    {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Pipeline speedup: " << std::setprecision(2)
+            << frame_rate_pipeline / frame_rate_serial << "x (" << frame_rate_pipeline_deep
+            / frame_rate_serial << "x with one more buffer)." << std::endl;
+
+    if (frame_rate_pipeline < frame_rate_serial * 1.2)
+    {
+        std::cerr << "Pipeline frame rate not above the serial frame rate." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
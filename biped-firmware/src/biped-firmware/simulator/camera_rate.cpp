@@ -0,0 +1,463 @@
+/**
+ *  @file   camera_rate.cpp
+ *  @author Simon Yu
+ *  @date   02/03/2022
+ *  @brief  Camera rate controller harness source.
+ *
+ *  This file implements the camera rate controller harness. The
+ *  harness streams synthetic camera frames, chunked the same way as
+ *  the camera chunker, alongside the Biped message datagrams over a
+ *  simulated link, i.e., a drop-tail queue drained at the link
+ *  bandwidth of a synthetic link trace, with a small background
+ *  loss. The camera frame sizes deliberately deviate from the camera
+ *  frame size model of the camera rate controller.
+ *
+ *  Every feedback period, the harness serializes a camera feedback
+ *  message of the camera frames reassembled over the period, the same
+ *  way as the Biped ground station camera daemon, and applies it using
+ *  the camera feedback message read function, such that the camera
+ *  setting takes effect one feedback period later.
+ *
+ *  For every link trace, i.e., a constant link, a step drop and
+ *  recovery, a ramp down and up, and random fading, the harness runs
+ *  the camera rate controller against the highest camera setting held
+ *  fixed. It verifies that the camera rate controller keeps the Biped
+ *  message loss low, that it completes more camera frames than the
+ *  fixed camera setting, or nearly as many on the constant link, and
+ *  that it reaches the highest camera setting on the constant link.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-camera-rate [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/global.h"
+#include "common/parameter.h"
+#include "common/type.h"
+#include "controller/camera_rate_controller.h"
+#include "task/task.h"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Link trace type, returning the link bandwidth, in bytes per second,
+ *  at the given time, in seconds.
+ */
+using Trace = std::function<double(const double&)>;
+
+/*
+ *  Simulated link and camera constants.
+ */
+constexpr double loss_background = 0.001;   //!< Background datagram loss ratio.
+constexpr double period_feedback = 0.5; //!< Camera feedback message period, in seconds.
+constexpr size_t queue_size = 32768;    //!< Link drop-tail queue size, in bytes.
+constexpr double rate_sender = 2000000; //!< Rate at which the chunks of a camera frame leave the camera UDP write task, in bytes per second.
+constexpr double size_factor = 1.4; //!< Ratio of the synthetic camera frame sizes to the camera frame size model.
+constexpr double size_spread = 0.15;    //!< Standard deviation of the logarithm of the synthetic camera frame sizes.
+
+/**
+ *  @brief  Datagram struct.
+ *
+ *  This struct contains a datagram on the simulated link, either a
+ *  chunk of a camera frame or a Biped message.
+ */
+struct Datagram
+{
+    bool camera;    //!< Whether the datagram is a camera chunk.
+    size_t frame;   //!< Index of the camera frame of the camera chunk.
+    size_t size;    //!< Datagram size, in bytes.
+    double time;    //!< Send time, in seconds.
+};
+
+/**
+ *  @brief  Run statistics struct.
+ *
+ *  This struct contains the statistics of a run over a link trace.
+ */
+struct Statistics
+{
+    double budget = 0;  //!< Average camera bandwidth budget, in bytes per second.
+    unsigned long byte_count_complete = 0;  //!< Payload bytes of the completed camera frames.
+    unsigned long datagram_count_biped_lost = 0;    //!< Lost Biped message datagrams.
+    unsigned long datagram_count_biped_sent = 0;    //!< Sent Biped message datagrams.
+    unsigned long frame_count_complete = 0; //!< Completed camera frames.
+    unsigned long frame_count_sent = 0; //!< Sent camera frames.
+    unsigned long setting_change_count = 0; //!< Camera setting changes.
+    size_t setting_index_max = 0;   //!< Highest camera setting index selected.
+};
+
+/**
+ *  @param  setting Camera setting struct.
+ *  @return Camera setting index.
+ *  @brief  Get the index of a camera setting in the camera settings.
+ */
+static size_t
+getSettingIndex(const CameraSetting& setting)
+{
+    for (size_t i = 0; i < CameraParameter::setting_count; i ++)
+    {
+        if (CameraParameter::settings[i] == setting)
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ *  @param  feedback Camera feedback message struct.
+ *  @return Whether the camera feedback message was applied.
+ *  @brief  Serialize a camera feedback message and apply it.
+ */
+static bool
+sendFeedback(const CameraFeedbackMessage& feedback)
+{
+    std::array<unsigned char, NetworkParameter::buffer_size_biped_message> buffer;
+    zpp::serializer::memory_view_output_archive serializer(buffer.data(), buffer.size());
+
+    if (!serializer(feedback))
+    {
+        return false;
+    }
+
+    return readCameraFeedbackMessage(buffer.data(), serializer.offset());
+}
+
+/**
+ *  @param  trace Link trace.
+ *  @param  duration Duration, in seconds.
+ *  @param  adaptive Whether to run the camera rate controller, or the highest camera setting fixed.
+ *  @param  random Random number generator.
+ *  @return Run statistics struct.
+ *  @brief  Stream camera frames and Biped messages over a link trace.
+ */
+static Statistics
+run(const Trace& trace, const double& duration, const bool& adaptive, std::mt19937& random)
+{
+    const size_t payload_size_max = NetworkParameter::buffer_size_camera - CameraChunkHeader::size;
+    std::bernoulli_distribution distribution_loss(loss_background);
+    std::normal_distribution<double> distribution_size(0, size_spread);
+    double queue = 0;
+    double time_biped = 0;
+    double time_frame = 0;
+    double time_queue = 0;
+    unsigned long window_count = 0;
+    Statistics statistics;
+
+    camera_rate_controller_ = std::make_shared<CameraRateController>();
+    seqlock_camera_setting_.write(camera_rate_controller_->getSetting());
+
+    for (double time_window = 0; time_window + period_feedback <= duration + 1e-9;
+            time_window += period_feedback)
+    {
+        const CameraSetting setting = adaptive ? seqlock_camera_setting_.read()
+                : CameraParameter::settings[CameraParameter::setting_count - 1];
+        const double time_end = time_window + period_feedback;
+        std::vector<Datagram> datagrams;
+        std::vector<size_t> frame_chunk_count;
+        std::vector<size_t> frame_chunk_count_received;
+        std::vector<size_t> frame_size;
+
+        statistics.setting_index_max = std::max(statistics.setting_index_max,
+                getSettingIndex(setting));
+
+        /*
+         *  Emit the camera frames of the window at the camera frame rate,
+         *  each chunk after the previous one at the sender rate.
+         */
+        for (; time_frame < time_end; time_frame += 1.0 / setting.frame_rate)
+        {
+            const double size_model = setting.getPixelCount() * CameraParameter::bytes_per_pixel
+                    * CameraParameter::jpeg_quality_reference / setting.jpeg_quality;
+            const size_t size = static_cast<size_t>(size_model * size_factor
+                    * std::exp(distribution_size(random)));
+            const size_t chunk_count = CameraChunkHeader::getChunkCount(size, payload_size_max);
+            double time_chunk = time_frame;
+
+            for (size_t i = 0; i < chunk_count; i ++)
+            {
+                const size_t chunk_size = CameraChunkHeader::size + size / chunk_count;
+
+                datagrams.push_back({true, frame_size.size(), chunk_size, time_chunk});
+                time_chunk += chunk_size / rate_sender;
+            }
+
+            frame_chunk_count.push_back(chunk_count);
+            frame_chunk_count_received.push_back(0);
+            frame_size.push_back(size);
+        }
+
+        /*
+         *  Emit the Biped message datagrams of the window, i.e., a telemetry frame
+         *  every frame period, plus the status and parameter messages.
+         */
+        for (; time_biped < time_end; time_biped += TelemetryParameter::period_frame)
+        {
+            const unsigned long frame_index = static_cast<unsigned long>(time_biped
+                    / TelemetryParameter::period_frame + 0.5);
+
+            datagrams.push_back({false, 0, NetworkParameter::buffer_size_telemetry_frame,
+                    time_biped});
+
+            if (frame_index % TelemetryParameter::divisor_status_message == 0)
+            {
+                datagrams.push_back({false, 0, NetworkParameter::buffer_size_biped_message,
+                        time_biped});
+            }
+
+            if (frame_index % TelemetryParameter::divisor_parameter_message == 0)
+            {
+                datagrams.push_back({false, 0, NetworkParameter::buffer_size_biped_message,
+                        time_biped});
+            }
+        }
+
+        std::stable_sort(datagrams.begin(), datagrams.end(),
+                [](const Datagram& a, const Datagram& b)
+                {
+                    return a.time < b.time;
+                });
+
+        /*
+         *  Deliver the datagrams through the drop-tail queue, drained at the link
+         *  bandwidth of the link trace.
+         */
+        CameraFeedbackMessage feedback;
+
+        for (const auto& datagram : datagrams)
+        {
+            queue = std::max(0.0, queue - trace(datagram.time) * (datagram.time - time_queue));
+            time_queue = std::max(time_queue, datagram.time);
+
+            const bool lost = queue + datagram.size > queue_size || distribution_loss(random);
+
+            if (!lost)
+            {
+                queue += datagram.size;
+            }
+
+            if (!datagram.camera)
+            {
+                statistics.datagram_count_biped_sent ++;
+                statistics.datagram_count_biped_lost += lost ? 1 : 0;
+                continue;
+            }
+
+            if (!lost)
+            {
+                feedback.byte_count += datagram.size;
+                feedback.chunk_count_received ++;
+                frame_chunk_count_received[datagram.frame] ++;
+            }
+        }
+
+        /*
+         *  Account the camera frames of the window the same way as the camera daemon.
+         */
+        for (size_t i = 0; i < frame_size.size(); i ++)
+        {
+            statistics.frame_count_sent ++;
+
+            if (frame_chunk_count_received[i] == frame_chunk_count[i])
+            {
+                feedback.frame_count_complete ++;
+                statistics.frame_count_complete ++;
+                statistics.byte_count_complete += frame_size[i];
+            }
+            else
+            {
+                feedback.chunk_count_lost += frame_chunk_count[i] - frame_chunk_count_received[i];
+                feedback.frame_count_dropped ++;
+            }
+        }
+
+        feedback.window = static_cast<uint32_t>(period_feedback * 1000);
+
+        /*
+         *  Apply the camera feedback message, taking effect at the next window.
+         */
+        if (adaptive)
+        {
+            const CameraSetting setting_previous = seqlock_camera_setting_.read();
+
+            sendFeedback(feedback);
+
+            if (seqlock_camera_setting_.read() != setting_previous)
+            {
+                statistics.setting_change_count ++;
+            }
+        }
+
+        statistics.budget += budget_camera_;
+        window_count ++;
+    }
+
+    statistics.budget /= std::max<unsigned long>(window_count, 1);
+
+    return statistics;
+}
+
+/**
+ *  @param  name Link trace name.
+ *  @param  trace Link trace.
+ *  @param  duration Duration, in seconds.
+ *  @param  constant Whether the link trace is constant above the highest camera setting.
+ *  @param  random Random number generator.
+ *  @return Whether the verification passed.
+ *  @brief  Verify the camera rate controller against the fixed highest camera setting.
+ */
+static bool
+verifyTrace(const std::string& name, const Trace& trace, const double& duration,
+        const bool& constant, std::mt19937& random)
+{
+    const Statistics statistics_fixed = run(trace, duration, false, random);
+    const Statistics statistics_adaptive = run(trace, duration, true, random);
+
+    const auto report = [&](const std::string& label, const Statistics& statistics)
+    {
+        std::cout << name << " (" << label << "): Biped message loss "
+                << 100.0 * statistics.datagram_count_biped_lost
+                        / std::max<unsigned long>(statistics.datagram_count_biped_sent, 1)
+                << "%, " << statistics.frame_count_complete << " of "
+                << statistics.frame_count_sent << " camera frames complete, goodput "
+                << statistics.byte_count_complete / duration / 1000 << " kB/s";
+
+        if (&statistics == &statistics_adaptive)
+        {
+            std::cout << ", average budget " << statistics.budget / 1000 << " kB/s, "
+                    << statistics.setting_change_count << " camera setting changes";
+        }
+
+        std::cout << "." << std::endl;
+    };
+
+    report("fixed", statistics_fixed);
+    report("adaptive", statistics_adaptive);
+
+    const double loss = static_cast<double>(statistics_adaptive.datagram_count_biped_lost)
+            / std::max<unsigned long>(statistics_adaptive.datagram_count_biped_sent, 1);
+
+    if (loss > CameraParameter::loss_low * 2)
+    {
+        std::cerr << name << ": Biped message loss too high with the camera rate controller."
+                << std::endl;
+        return false;
+    }
+
+    /*
+     *  On the constant link, the fixed highest camera setting fits, and the camera rate
+     *  controller only gives up the camera frames of its probing.
+     */
+    const double ratio = constant ? 0.95 : 1;
+
+    if (statistics_adaptive.frame_count_complete < statistics_fixed.frame_count_complete * ratio)
+    {
+        std::cerr << name << ": Fewer camera frames complete with the camera rate controller."
+                << std::endl;
+        return false;
+    }
+
+    if (constant && statistics_adaptive.setting_index_max != CameraParameter::setting_count - 1)
+    {
+        std::cerr << name << ": Highest camera setting never selected on a constant link."
+                << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Camera rate controller harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::atof(argv[1]) : 60;
+
+    if (duration < period_feedback * 10)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(431);
+
+    /*
+     *  Verify that a camera feedback message with an empty window is rejected.
+     */
+    camera_rate_controller_ = std::make_shared<CameraRateController>();
+
+    if (sendFeedback(CameraFeedbackMessage()))
+    {
+        std::cerr << "Camera feedback message with an empty window applied." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Generate the random fading link trace, i.e., a new link bandwidth every
+     *  two seconds.
+     */
+    std::vector<double> fading;
+    std::uniform_real_distribution<double> distribution_fading(120000, 800000);
+
+    for (double time = 0; time <= duration; time += 2)
+    {
+        fading.push_back(distribution_fading(random));
+    }
+
+    const std::vector<std::pair<std::string, Trace>> traces = {
+            {"Constant", [](const double& time)
+            {
+                return 800000.0;
+            }},
+            {"Step", [duration](const double& time)
+            {
+                return time >= duration / 3 && time < duration * 2 / 3 ? 150000.0 : 800000.0;
+            }},
+            {"Ramp", [duration](const double& time)
+            {
+                return 120000 + 680000 * std::abs(1 - 2 * time / duration);
+            }},
+            {"Fading", [&fading](const double& time)
+            {
+                return fading[std::min(static_cast<size_t>(time / 2), fading.size() - 1)];
+            }}};
+
+    for (const auto& trace : traces)
+    {
+        if (!verifyTrace(trace.first, trace.second, duration, trace.first == "Constant", random))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/**
+ *  @file   clock.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated clock class source.
+ *
+ *  This file implements the simulated clock class.
+ */
+
+/*
+ *  Project headers.
+ */
+#include "simulator/clock.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+void
+Clock::advance(const uint64_t& microseconds)
+{
+    /*
+     *  Advance the simulated time.
+     */
+    microseconds_ += microseconds;
+}
+
+uint64_t
+Clock::getMicroseconds()
+{
+    /*
+     *  Return the simulated time.
+     */
+    return microseconds_;
+}
+
+/*
+ *  Initialize static class member variables.
+ */
+uint64_t Clock::microseconds_ = 0;
+}   // namespace firmware
+}   // namespace biped
@@ -0,0 +1,71 @@
+/**
+ *  @file   clock.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated clock class header.
+ *
+ *  This file defines the simulated clock class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_CLOCK_H_
+#define SIMULATOR_CLOCK_H_
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated clock class.
+ *
+ *  This class keeps the simulated time. The simulated time
+ *  only advances when the simulated timer fires, which lets
+ *  the simulator run the real-time task faster than real time
+ *  while the firmware timing functions, e.g., the Arduino millis
+ *  and micros functions, observe a consistent time base.
+ */
+class Clock
+{
+public:
+
+    /**
+     *  @param  microseconds Time to advance, in microseconds.
+     *  @brief  Advance the simulated time.
+     *
+     *  This function advances the simulated time by the given
+     *  time.
+     */
+    static void
+    advance(const uint64_t& microseconds);
+
+    /**
+     *  @return Simulated time, in microseconds.
+     *  @brief  Get the simulated time.
+     *
+     *  This function returns the simulated time since the start
+     *  of the simulation.
+     */
+    static uint64_t
+    getMicroseconds();
+
+private:
+
+    static uint64_t microseconds_;  //!< Simulated time, in microseconds.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // SIMULATOR_CLOCK_H_
@@ -0,0 +1,540 @@
+/**
+ *  @file   command.cpp
+ *  @author Simon Yu
+ *  @date   01/31/2022
+ *  @brief  Command message harness source.
+ *
+ *  This file implements the command message harness. The harness
+ *  first serializes a command message of every command type, verifies
+ *  that each round-trips, and reports their sizes against the size of
+ *  a full Biped message.
+ *
+ *  It then delivers a series of command messages over a simulated
+ *  lossy link, which drops, duplicates, and swaps the command messages
+ *  as well as the status messages carrying the acknowledgements, with
+ *  the Biped ground station retransmitting every unacknowledged command
+ *  message. It verifies that every command message is applied exactly
+ *  once and in order, that a restarted firmware acknowledges no session,
+ *  and that a new session starts over while a delayed command message of
+ *  the previous session is dropped.
+ *
+ *  Finally, the harness runs the firmware real-time task against the
+ *  simulated plant, alongside a shadow controller fed the same sensor
+ *  data. It sends command messages and full controller parameter and
+ *  reference uploads that leave the values unchanged, and verifies that
+ *  the actuation commands of both controllers stay identical, i.e., that
+ *  no integrated error was reset, and that a changed gain does diverge
+ *  them.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-command [commands] [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "network/udp.h"
+#include "sensor/sensor.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "task/task.h"
+#include "utility/math.h"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Serialized command message buffer type.
+ */
+using Buffer = std::array<unsigned char, NetworkParameter::buffer_size_biped_message>;
+
+/**
+ *  @param  message Command message struct.
+ *  @param  buffer Serialized command message buffer.
+ *  @return Size of the serialized command message, in bytes, or 0 upon failure.
+ *  @brief  Serialize a command message.
+ */
+static size_t
+serialize(const CommandMessage& message, Buffer& buffer)
+{
+    zpp::serializer::memory_view_output_archive serializer(buffer);
+
+    return serializer(message) ? serializer.offset() : 0;
+}
+
+/**
+ *  @param  message Command message struct.
+ *  @return Whether the command message was applied.
+ *  @brief  Send a command message to the firmware.
+ *
+ *  This function serializes the given command message and reads it
+ *  using the command message read function, the same way as the Biped
+ *  message UDP read task function.
+ */
+static bool
+send(const CommandMessage& message)
+{
+    Buffer buffer;
+    const size_t size = serialize(message, buffer);
+
+    return size > 0 && readCommandMessage(buffer.data(), size);
+}
+
+/**
+ *  @param  acknowledgement Received command acknowledgement struct.
+ *  @return Whether the status message was received.
+ *  @brief  Receive the command acknowledgement.
+ *
+ *  This function writes a status message using the status message
+ *  UDP write task iteration function, and deserializes its command
+ *  acknowledgement struct.
+ */
+static bool
+receive(CommandAcknowledgement& acknowledgement)
+{
+    udpWriteStatusMessageTaskIteration();
+
+    zpp::serializer::memory_view_input_archive deserializer(udp_biped_message_->getPacket(),
+            udp_biped_message_->getPacketSize());
+    StatusMessage message;
+
+    if (!deserializer(message))
+    {
+        return false;
+    }
+
+    acknowledgement = message.acknowledgement;
+    return true;
+}
+
+/**
+ *  @return Whether the command messages passed the verification.
+ *  @brief  Verify the command message serialization.
+ *
+ *  This function serializes a command message of every command type,
+ *  verifies that each deserializes to the same entries and that an
+ *  invalid command type is rejected, and reports the sizes.
+ */
+static bool
+verifyMessages()
+{
+    const CommandType types[] = { CommandType::set_gain_attitude_y,
+            CommandType::set_gain_attitude_z, CommandType::set_gain_open_loop_attitude_z,
+            CommandType::set_gain_position_x, CommandType::set_mode, CommandType::set_reference,
+            CommandType::set_saturation_position_x, CommandType::start_plan };
+    bool passed = true;
+    size_t size_max = 0;
+
+    for (const auto& type : types)
+    {
+        CommandMessage message(type);
+        message.gain.proportional = -1.5;
+        message.gain_open_loop = 2.5;
+        message.mode = ControllerMode::state_feedback;
+        message.reference.position_x = 0.25;
+        message.saturation.input_lower = -0.4;
+        message.sequence = 7;
+        message.session = 431;
+
+        Buffer buffer;
+        const size_t size = serialize(message, buffer);
+        zpp::serializer::memory_view_input_archive deserializer(buffer.data(), size);
+        CommandMessage message_deserialized;
+
+        passed &= size > 0 && deserializer(message_deserialized)
+                && deserializer.offset() == size && message_deserialized.type == type
+                && message_deserialized.sequence == 7 && message_deserialized.session == 431;
+
+        switch (type)
+        {
+            case CommandType::set_gain_attitude_y:
+            case CommandType::set_gain_attitude_z:
+            case CommandType::set_gain_position_x:
+            {
+                passed &= message_deserialized.gain == message.gain;
+                break;
+            }
+            case CommandType::set_gain_open_loop_attitude_z:
+            {
+                passed &= message_deserialized.gain_open_loop == message.gain_open_loop;
+                break;
+            }
+            case CommandType::set_mode:
+            {
+                passed &= message_deserialized.mode == message.mode;
+                break;
+            }
+            case CommandType::set_reference:
+            {
+                passed &= message_deserialized.reference.position_x
+                        == message.reference.position_x;
+                break;
+            }
+            case CommandType::set_saturation_position_x:
+            {
+                passed &= message_deserialized.saturation == message.saturation;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        size_max = std::max(size_max, size);
+    }
+
+    /*
+     *  Verify that an invalid command type is rejected.
+     */
+    CommandMessage message;
+    Buffer buffer;
+    const size_t size = serialize(message, buffer);
+    buffer[10] = 0xFF;
+    zpp::serializer::memory_view_input_archive deserializer(buffer.data(), size);
+    passed &= !deserializer(message);
+
+    /*
+     *  Serialize a full Biped message for comparison.
+     */
+    std::vector<unsigned char> message_serialized;
+    zpp::serializer::memory_output_archive serializer(message_serialized);
+    passed &= static_cast<bool>(serializer(BipedMessage()));
+
+    std::cout << "Command message size: " << size << " to " << size_max << " bytes, Biped message "
+            << message_serialized.size() << " bytes" << std::endl;
+
+    return passed && size_max * 10 < message_serialized.size();
+}
+
+/**
+ *  @param  count Number of command messages.
+ *  @return Whether the command messages were delivered exactly once and in order.
+ *  @brief  Verify the command message delivery over a lossy link.
+ *
+ *  This function sends the given number of X position gain command
+ *  messages, each with a distinct maximum integrated error, over a
+ *  simulated link that drops, duplicates, and swaps messages, and
+ *  retransmits all unacknowledged command messages every round, the
+ *  same way as the Biped ground station.
+ */
+static bool
+verifyDelivery(const unsigned long& count)
+{
+    std::mt19937_64 generator(431);
+    std::bernoulli_distribution drop(0.3);
+    std::bernoulli_distribution duplicate(0.1);
+    std::bernoulli_distribution swap(0.1);
+    const uint32_t session = 0x5EED;
+    std::deque<CommandMessage> pending;
+    unsigned long applied = 0;
+    unsigned long rounds = 0;
+    double integral_max_last = -1;
+    bool ordered = true;
+
+    for (uint32_t sequence = 1; sequence <= count; sequence ++)
+    {
+        CommandMessage message(CommandType::set_gain_position_x);
+        message.gain = controller_->getControllerParameter().pid_controller_gain_position_x;
+        message.gain.integral_max = sequence;
+        message.sequence = sequence;
+        message.session = session;
+        pending.push_back(message);
+    }
+
+    for (; !pending.empty() && rounds < 100 * count; rounds ++)
+    {
+        /*
+         *  Retransmit at most a window of the unacknowledged command
+         *  messages, dropping, duplicating, and swapping some of them.
+         */
+        std::vector<CommandMessage> window(pending.begin(),
+                pending.begin() + std::min<size_t>(pending.size(), 8));
+
+        for (size_t i = 0; i + 1 < window.size(); i ++)
+        {
+            if (swap(generator))
+            {
+                std::swap(window[i], window[i + 1]);
+            }
+        }
+
+        for (const auto& message : window)
+        {
+            for (int copy = duplicate(generator) ? 2 : 1; copy > 0; copy --)
+            {
+                if (drop(generator))
+                {
+                    continue;
+                }
+
+                if (send(message))
+                {
+                    const double integral_max = controller_->getControllerParameter()
+                            .pid_controller_gain_position_x.integral_max;
+
+                    ordered &= integral_max == integral_max_last + 1 || applied == 0;
+                    integral_max_last = integral_max;
+                    applied ++;
+                }
+            }
+        }
+
+        /*
+         *  Receive the acknowledgement, unless its status message is
+         *  dropped, and stop retransmitting the acknowledged ones.
+         */
+        CommandAcknowledgement acknowledgement;
+
+        if (drop(generator) || !receive(acknowledgement) || acknowledgement.session != session)
+        {
+            continue;
+        }
+
+        while (!pending.empty() && pending.front().sequence <= acknowledgement.sequence)
+        {
+            pending.pop_front();
+        }
+    }
+
+    std::cout << "Delivered " << count << " command messages in " << rounds
+            << " rounds, applied " << applied << std::endl;
+
+    bool passed = pending.empty() && applied == count && ordered
+            && controller_->getControllerParameter().pid_controller_gain_position_x.integral_max
+                    == count;
+
+    /*
+     *  Restart the firmware in the middle of the session, such that the next
+     *  command message of the session is neither applied nor acknowledged.
+     */
+    seqlock_command_acknowledgement_.write(CommandAcknowledgement());
+
+    CommandMessage message(CommandType::set_reference);
+    message.reference = controller_->getControllerReference();
+    message.sequence = count + 1;
+    message.session = session;
+    CommandAcknowledgement acknowledgement;
+    passed &= !send(message) && receive(acknowledgement) && acknowledgement.session != session;
+
+    /*
+     *  Start a new session, the same way as the Biped ground station upon an
+     *  acknowledgement of another session, and verify that a delayed command
+     *  message of the previous session neither applies nor changes the session.
+     */
+    message.sequence = 1;
+    message.session = session + 1;
+    passed &= send(message) && !send(message);
+
+    CommandMessage message_delayed(CommandType::set_gain_position_x);
+    message_delayed.sequence = count;
+    message_delayed.session = session;
+    passed &= !send(message_delayed);
+
+    message.sequence = 2;
+    passed &= send(message) && receive(acknowledgement)
+            && acknowledgement.session == session + 1 && acknowledgement.sequence == 2;
+
+    return passed;
+}
+
+/**
+ *  @param  duration Simulated duration, in seconds.
+ *  @return Whether unchanged commands left the controller undisturbed.
+ *  @brief  Verify that unchanged commands leave the controller undisturbed.
+ *
+ *  This function runs the firmware real-time task against the simulated
+ *  plant, alongside a shadow controller fed the same sensor data, and
+ *  periodically sends command messages and full controller parameter and
+ *  reference uploads with unchanged values to the firmware controller
+ *  only. It then sends a changed gain, which must diverge the actuation
+ *  commands.
+ */
+static bool
+verifyUndisturbed(const double& duration)
+{
+    Controller controller_shadow;
+    controller_shadow.setPeriod(PeriodParameter::fast, true);
+    controller_shadow.setPeriod(PeriodParameter::slow, false);
+    controller_shadow.setControllerParameter(controller_->getControllerParameter());
+    controller_shadow.setControllerReference(controller_->getControllerReference());
+
+    const uint32_t ticks = static_cast<uint32_t>(duration / PeriodParameter::fast);
+    const uint32_t ticks_changed = ticks * 3 / 4;
+    const uint32_t session = 0xB1BED;
+    uint32_t sequence = 0;
+    uint32_t ticks_identical = 0;
+    bool identical = true;
+    bool diverged = false;
+
+    for (uint32_t i = 0; i < ticks; i ++)
+    {
+        /*
+         *  Every half second, send the unchanged gains, saturation, mode,
+         *  and reference as command messages, and as full uploads.
+         */
+        if (i % static_cast<uint32_t>(0.5 / PeriodParameter::fast) == 0 && i < ticks_changed)
+        {
+            const ControllerParameter controller_parameter = controller_->getControllerParameter();
+            const CommandType types[] = { CommandType::set_gain_attitude_y,
+                    CommandType::set_gain_attitude_z, CommandType::set_gain_open_loop_attitude_z,
+                    CommandType::set_gain_position_x, CommandType::set_mode,
+                    CommandType::set_reference, CommandType::set_saturation_position_x };
+            const PIDControllerGain gains[] = { controller_parameter.pid_controller_gain_attitude_y,
+                    controller_parameter.pid_controller_gain_attitude_z, PIDControllerGain(),
+                    controller_parameter.pid_controller_gain_position_x };
+
+            for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t ++)
+            {
+                CommandMessage message(types[t]);
+                message.gain = t < 4 ? gains[t] : PIDControllerGain();
+                message.gain_open_loop = controller_parameter.attitude_z_gain_open_loop;
+                message.mode = controller_parameter.mode;
+                message.reference = controller_->getControllerReference();
+                message.saturation = controller_parameter.pid_controller_saturation_position_x;
+                message.sequence = ++ sequence;
+                message.session = session;
+                identical &= send(message);
+            }
+
+            controller_->setControllerParameter(controller_->getControllerParameter());
+            controller_->setControllerReference(controller_->getControllerReference());
+        }
+
+        /*
+         *  Change the X position maximum integrated error, which resets
+         *  the X position integrated error of the firmware controller only.
+         */
+        if (i == ticks_changed)
+        {
+            CommandMessage message(CommandType::set_gain_position_x);
+            message.gain = controller_->getControllerParameter().pid_controller_gain_position_x;
+            message.gain.integral_max += 1;
+            message.sequence = ++ sequence;
+            message.session = session;
+            identical &= send(message);
+        }
+
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+
+        /*
+         *  Run the shadow controller on the same sensor data, in the same
+         *  domains as the real-time task did in this tick.
+         */
+        const uint32_t tick = scheduler_real_time_task_.getTick() - 1;
+        const IMUData imu_data = sensor_->getIMUData();
+        const EncoderData encoder_data = sensor_->getEncoderData();
+
+        controller_shadow.control(true, imu_data, encoder_data);
+
+        if (tick % SchedulerParameter::divisor_slow == SchedulerParameter::phase_control_slow)
+        {
+            controller_shadow.control(false, imu_data, encoder_data);
+        }
+
+        const ActuationCommand actuation_command = controller_->getActuationCommand();
+        const ActuationCommand actuation_command_shadow = controller_shadow.getActuationCommand();
+        const bool equal = actuation_command.motor_left_pwm == actuation_command_shadow.motor_left_pwm
+                && actuation_command.motor_right_pwm == actuation_command_shadow.motor_right_pwm
+                && actuation_command.motor_enable == actuation_command_shadow.motor_enable;
+
+        if (i < ticks_changed)
+        {
+            identical &= equal;
+            ticks_identical += equal ? 1 : 0;
+        }
+        else
+        {
+            diverged |= !equal;
+        }
+    }
+
+    std::cout << "Identical actuation commands: " << ticks_identical << " of " << ticks_changed
+            << " ticks, " << sequence << " command messages, diverged after change: "
+            << (diverged ? "yes" : "no") << std::endl;
+
+    return identical && diverged && controller_->getActiveStatus();
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Command message harness main function.
+ *
+ *  This function verifies the command message serialization, the
+ *  delivery over a lossy link, and the undisturbed controller, and
+ *  prints the results.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long commands = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const double duration = argc > 2 ? std::atof(argv[2]) : 10;
+
+    if (commands == 0 || duration <= 0)
+    {
+        std::cerr << "Invalid number of commands or duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    udp_biped_message_ = std::make_shared<UDP>();
+    udp_biped_message_->initialize(NetworkParameter::port_udp_biped_message);
+
+    if (!udp_biped_message_->setRemote(NetworkParameter::ip_ground_station,
+            NetworkParameter::port_udp_biped_message))
+    {
+        std::cerr << "Invalid Biped ground station IP address." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    realTimeTaskInitialization();
+
+    const bool passed_messages = verifyMessages();
+    std::cout << "Command messages " << (passed_messages ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_delivery = verifyDelivery(commands);
+    std::cout << "Command delivery " << (passed_delivery ? "passed" : "FAILED") << std::endl;
+
+    /*
+     *  Restore the X position gain changed by the delivery verification.
+     */
+    ControllerParameter controller_parameter = controller_->getControllerParameter();
+    controller_parameter.pid_controller_gain_position_x.integral_max = Controller()
+            .getControllerParameter().pid_controller_gain_position_x.integral_max;
+    controller_->setControllerParameter(controller_parameter);
+
+    const bool passed_undisturbed = verifyUndisturbed(duration);
+    std::cout << "Undisturbed controller " << (passed_undisturbed ? "passed" : "FAILED")
+            << std::endl;
+
+    return passed_messages && passed_delivery && passed_undisturbed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,307 @@
+/**
+ *  @file   deadline_miss.cpp
+ *  @author Simon Yu
+ *  @date   01/22/2022
+ *  @brief  Deadline miss harness source.
+ *
+ *  This file implements the deadline miss harness. The harness runs
+ *  the real-time task loop against a simulated timer and a simulated
+ *  FreeRTOS task notification, i.e., a counter incremented by every
+ *  timer interrupt, with synthetic iteration execution times that
+ *  build up backlogs of timer interrupts, from a single overrun to a
+ *  stall of several fast domain periods.
+ *
+ *  For every backlog, it counts the timer interrupts that arrived
+ *  while an iteration was still running, i.e., the deadline misses,
+ *  and verifies that the real-time task wait function counts exactly
+ *  as many. It also reports the count of the previous loop, which
+ *  took one notification at a time, ran an iteration for each, and
+ *  counted both the notifications pending and the overruns.
+ *
+ *  The harness exits with failure if any count differs.
+ *
+ *  Usage: biped-deadline-miss
+ */
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+/*
+ *  Project headers.
+ */
+#include "common/global.h"
+#include "common/parameter.h"
+#include "task/task.h"
+#include "utility/math.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Simulation constants.
+ */
+constexpr unsigned long tick_count = 2000;  //!< Number of timer interrupts simulated per backlog.
+
+/**
+ *  @brief  Simulated timer struct.
+ *
+ *  This struct contains the simulated time, the timer interrupts,
+ *  the task notification value, and the deadline misses, i.e., the
+ *  timer interrupts that arrived while an iteration was running.
+ */
+struct SimulatedTimer
+{
+    unsigned long deadline_miss = 0;    //!< Timer interrupts arrived during an iteration.
+    unsigned long iteration_count = 0;  //!< Iterations run.
+    uint32_t notification = 0;  //!< Task notification value.
+    unsigned long period = 0;   //!< Timer period, in microseconds.
+    unsigned long tick = 0; //!< Timer interrupts given so far.
+    unsigned long time = 0; //!< Simulated time, in microseconds.
+
+    /**
+     *  @return Whether the simulated timer is still running.
+     *  @brief  Get whether the simulated timer is still running.
+     */
+    bool
+    running() const
+    {
+        return tick < tick_count;
+    }
+
+    /**
+     *  @param  duration Iteration execution time, in microseconds.
+     *  @brief  Run an iteration.
+     *
+     *  This function advances the simulated time by the given
+     *  execution time, giving a notification for, and counting as
+     *  deadline misses, the timer interrupts arriving meanwhile.
+     */
+    void
+    run(const unsigned long& duration)
+    {
+        time += duration;
+        iteration_count ++;
+
+        while ((tick + 1) * period <= time)
+        {
+            tick ++;
+            notification ++;
+            deadline_miss ++;
+        }
+    }
+
+    /**
+     *  @brief  Sleep until the next timer interrupt.
+     */
+    void
+    sleep()
+    {
+        tick ++;
+        notification ++;
+        time = tick * period;
+    }
+};
+
+/*
+ *  Simulated timer of the real-time task wait function, which only
+ *  takes a plain function pointer.
+ */
+static SimulatedTimer* timer_wait = nullptr;
+
+/**
+ *  @param  block Whether to block until a notification is given.
+ *  @return Number of notifications taken.
+ *  @brief  Take the simulated task notifications.
+ *
+ *  This function takes and clears the notifications of the simulated
+ *  timer, as the FreeRTOS ulTaskNotifyTake function does with pdTRUE.
+ */
+static uint32_t
+takeNotification(const bool& block)
+{
+    if (block && timer_wait->notification == 0)
+    {
+        timer_wait->sleep();
+    }
+
+    const uint32_t notification = timer_wait->notification;
+    timer_wait->notification = 0;
+
+    return notification;
+}
+
+/**
+ *  @param  timer Simulated timer.
+ *  @param  duration Iteration execution time function, in microseconds.
+ *  @return Number of deadline misses counted.
+ *  @brief  Run the real-time task loop.
+ *
+ *  This function runs the real-time task loop with the real-time task
+ *  wait function until the simulated timer stops.
+ */
+static unsigned long
+runLoop(SimulatedTimer& timer, const std::function<unsigned long(const unsigned long&)>& duration)
+{
+    timer_wait = &timer;
+    deadline_miss_real_time_task_ = 0;
+
+    while (timer.running())
+    {
+        realTimeTaskWait(&takeNotification);
+        timer.run(duration(timer.tick));
+    }
+
+    return deadline_miss_real_time_task_;
+}
+
+/**
+ *  @param  timer Simulated timer.
+ *  @param  duration Iteration execution time function, in microseconds.
+ *  @return Number of deadline misses counted.
+ *  @brief  Run the previous real-time task loop.
+ *
+ *  This function runs the previous real-time task loop, which took a
+ *  single notification at a time, as the FreeRTOS ulTaskNotifyTake
+ *  function does with pdFALSE, until the simulated timer stops.
+ */
+static unsigned long
+runLoopPrevious(SimulatedTimer& timer, const std::function<unsigned long(const unsigned long&)>& duration)
+{
+    unsigned long deadline_miss = 0;
+
+    while (timer.running())
+    {
+        if (timer.notification == 0)
+        {
+            timer.sleep();
+        }
+
+        const uint32_t notification = timer.notification --;
+
+        if (notification > 1)
+        {
+            deadline_miss += notification - 1;
+        }
+
+        const unsigned long execution_time = duration(timer.tick);
+        timer.run(execution_time);
+
+        if (execution_time > timer.period)
+        {
+            deadline_miss ++;
+        }
+    }
+
+    return deadline_miss;
+}
+
+/**
+ *  @param  name Backlog name.
+ *  @param  duration Iteration execution time function of the timer interrupt, in microseconds.
+ *  @return Whether the deadline misses were counted exactly.
+ *  @brief  Run a backlog.
+ *
+ *  This function runs the real-time task loop and the previous one
+ *  through the given backlog, and prints the deadline misses and the
+ *  counts of both.
+ */
+static bool
+runBacklog(const std::string& name, const std::function<unsigned long(const unsigned long&)>& duration)
+{
+    const unsigned long period = static_cast<unsigned long>(secondsToMicroseconds(PeriodParameter::fast));
+    SimulatedTimer timer;
+    SimulatedTimer timer_previous;
+
+    timer.period = period;
+    timer_previous.period = period;
+
+    const unsigned long deadline_miss = runLoop(timer, duration);
+    const unsigned long deadline_miss_previous = runLoopPrevious(timer_previous, duration);
+    const bool passed = deadline_miss == timer.deadline_miss;
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << timer.deadline_miss
+            << std::setw(10) << deadline_miss << std::setw(12) << timer.iteration_count << std::setw(12)
+            << timer_previous.deadline_miss << std::setw(10) << deadline_miss_previous << std::setw(12)
+            << timer_previous.iteration_count << (passed ? "" : "  FAILED") << std::endl;
+
+    return passed;
+}
+
+int
+main()
+{
+    const unsigned long period = static_cast<unsigned long>(secondsToMicroseconds(PeriodParameter::fast));
+    std::mt19937 random(431);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    bool passed = true;
+
+    std::cout << std::left << std::setw(28) << "Backlog" << std::right << std::setw(10) << "Missed"
+            << std::setw(10) << "Counted" << std::setw(12) << "Iterations" << std::setw(12) << "Missed"
+            << std::setw(10) << "Counted" << std::setw(12) << "Iterations" << std::endl;
+    std::cout << std::left << std::setw(28) << "" << std::right << std::setw(32) << "(wait)"
+            << std::setw(34) << "(previous)" << std::endl;
+
+    /*
+     *  Nominal iterations, well within the fast domain period.
+     */
+    passed &= runBacklog("nominal", [&](const unsigned long& tick)
+    {
+        return period * 2 / 5;
+    });
+
+    /*
+     *  A single overrun of one and a half fast domain periods, which
+     *  delays the next iteration without skipping a timer interrupt.
+     */
+    passed &= runBacklog("overrun 1.5 periods", [&](const unsigned long& tick)
+    {
+        return tick == 100 ? period * 3 / 2 : period * 2 / 5;
+    });
+
+    /*
+     *  A single overrun of two and a half fast domain periods.
+     */
+    passed &= runBacklog("overrun 2.5 periods", [&](const unsigned long& tick)
+    {
+        return tick == 100 ? period * 5 / 2 : period * 2 / 5;
+    });
+
+    /*
+     *  A stall of ten fast domain periods, e.g., a flash write.
+     */
+    passed &= runBacklog("stall 10.3 periods", [&](const unsigned long& tick)
+    {
+        return tick == 100 ? period * 103 / 10 : period * 2 / 5;
+    });
+
+    /*
+     *  Iterations slightly shorter than the fast domain period after an
+     *  overrun, each starting late and running into the next interrupt.
+     */
+    passed &= runBacklog("late starts 0.9 periods", [&](const unsigned long& tick)
+    {
+        return tick == 100 ? period * 3 / 2 : period * 9 / 10;
+    });
+
+    /*
+     *  Random iterations, with one in twenty overrunning by up to
+     *  four fast domain periods.
+     */
+    passed &= runBacklog("random", [&](const unsigned long& tick)
+    {
+        return static_cast<unsigned long>(period * (distribution(random) < 0.05 ?
+                1 + 3 * distribution(random) : 0.2 + 0.6 * distribution(random)));
+    });
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
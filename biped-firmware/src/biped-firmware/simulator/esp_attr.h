@@ -0,0 +1,19 @@
+/**
+ *  @file   esp_attr.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated ESP32 attribute header.
+ *
+ *  This file defines the ESP32 attribute macros used by the
+ *  hardware-independent firmware as empty macros.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_ESP_ATTR_H_
+#define SIMULATOR_ESP_ATTR_H_
+
+#define IRAM_ATTR
+
+#endif  // SIMULATOR_ESP_ATTR_H_
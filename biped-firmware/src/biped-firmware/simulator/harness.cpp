@@ -0,0 +1,58 @@
+/**
+ *  @file   harness.cpp
+ *  @author Simon Yu
+ *  @date   01/28/2022
+ *  @brief  Simulator harness function source.
+ *
+ *  This file implements the functions shared by the simulator and
+ *  the harnesses that run the firmware against the simulated plant.
+ */
+
+/*
+ *  External headers.
+ */
+#include <memory>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "platform/neopixel.h"
+#include "sensor/sensor.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+void
+instantiateGlobalObjects()
+{
+    /*
+     *  Instantiate the simulated plant before the simulated
+     *  sensor and actuator, which read and drive it.
+     */
+    plant_ = std::make_shared<Plant>();
+
+    /*
+     *  Instantiate the global objects.
+     */
+    neopixel_ = std::make_shared<NeoPixel>();
+    sensor_ = std::make_shared<Sensor>();
+    actuator_ = std::make_shared<Actuator>();
+    controller_ = std::make_shared<Controller>();
+    controller_->setPeriod(PeriodParameter::fast, true);
+    controller_->setPeriod(PeriodParameter::slow, false);
+}
+}   // namespace firmware
+}   // namespace biped
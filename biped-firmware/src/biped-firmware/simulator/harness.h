@@ -0,0 +1,40 @@
+/**
+ *  @file   harness.h
+ *  @author Simon Yu
+ *  @date   01/28/2022
+ *  @brief  Simulator harness function header.
+ *
+ *  This file defines the functions shared by the simulator and
+ *  the harnesses that run the firmware against the simulated plant.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_HARNESS_H_
+#define SIMULATOR_HARNESS_H_
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Instantiate the simulated plant and the global objects.
+ *
+ *  This function instantiates the simulated plant before the
+ *  simulated sensor and actuator, and then the NeoPixel, sensor,
+ *  actuator, and controller global objects, replacing any previous
+ *  ones, and sets the fast and slow domain periods of the controller.
+ */
+void
+instantiateGlobalObjects();
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // SIMULATOR_HARNESS_H_
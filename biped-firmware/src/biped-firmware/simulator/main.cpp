@@ -0,0 +1,212 @@
+/**
+ *  @file   main.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulator main program source.
+ *
+ *  This file implements the simulator main program. The
+ *  simulator runs the hardware-independent firmware core
+ *  against the simulated plant, firing the simulated timer
+ *  back-to-back, i.e., faster than real time.
+ *
+ *  Usage: biped-simulator [duration] [none|waypoint|maneuver] [trace]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "planner/maneuver_planner.h"
+#include "planner/waypoint_planner.h"
+#include "platform/timer.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "task/task.h"
+#include "utility/math.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Host execution time statistics of the real-time task
+ *  iteration function, in nanoseconds.
+ */
+static uint64_t execution_time_max_ = 0;    //!< Maximum execution time, in nanoseconds.
+static uint64_t execution_time_total_ = 0;  //!< Total execution time, in nanoseconds.
+
+/**
+ *  @param  arg Interrupt handler function argument pointer.
+ *  @brief  Simulated timer interrupt handler function.
+ *
+ *  This function updates the real-time task interval, the
+ *  same way as the timer interrupt handler does, and then runs
+ *  the real-time task iteration directly instead of notifying
+ *  the real-time task.
+ */
+static void
+timerInterruptHandler(void* arg)
+{
+    /*
+     *  Calculate the real-time task interval using the
+     *  simulated clock.
+     */
+    static unsigned long time_point_start = 0;
+    const unsigned long current_real_time = micros();
+    interval_real_time_task_ = current_real_time - time_point_start;
+    time_point_start = current_real_time;
+    histogram_interval_real_time_task_.record(interval_real_time_task_);
+
+    /*
+     *  Run the real-time task iteration and measure its
+     *  execution time on the host.
+     */
+    const auto time_point_host_start = std::chrono::steady_clock::now();
+    realTimeTaskIteration();
+    const uint64_t execution_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - time_point_host_start).count();
+
+    execution_time_max_ = std::max(execution_time_max_, execution_time);
+    execution_time_total_ += execution_time;
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Simulator main function.
+ *
+ *  This function instantiates the firmware core and the
+ *  simulated hardware, runs the simulation for the given
+ *  simulated duration, and prints a summary.
+ */
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10;
+    const std::string planner = argc > 2 ? argv[2] : "none";
+    const bool trace = argc > 3 && std::string(argv[3]) == "trace";
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    timer_ = std::make_shared<Timer>();
+    realTimeTaskInitialization();
+
+    if (planner == "waypoint")
+    {
+        planner_ = std::make_shared<WaypointPlanner>();
+    }
+    else if (planner == "maneuver")
+    {
+        planner_ = std::make_shared<ManeuverPlanner>();
+    }
+    else if (planner != "none")
+    {
+        std::cerr << "Invalid planner." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (planner_)
+    {
+        planner_->start();
+    }
+
+    /*
+     *  Configure the simulated timer the same way as the
+     *  hardware timer.
+     */
+    timer_->setInterval(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+    timer_->attachInterrupt(&timerInterruptHandler, nullptr);
+    timer_->enable();
+
+    /*
+     *  Run the simulation. The plant is advanced by a fast domain
+     *  period before each timer interrupt. The planner runs once
+     *  every slow domain period, in place of the best-effort task.
+     */
+    const unsigned long iterations = static_cast<unsigned long>(duration / PeriodParameter::fast);
+    const unsigned long iterations_slow = static_cast<unsigned long>(PeriodParameter::slow
+            / PeriodParameter::fast);
+
+    if (trace)
+    {
+        std::cout << "time\tposition_x\tvelocity_x\tattitude_y\tattitude_z\tpwm_left\tpwm_right"
+                << std::endl;
+    }
+
+    const auto time_point_start = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < iterations; ++i)
+    {
+        plant_->step(PeriodParameter::fast);
+        timer_->fire();
+
+        if (i % iterations_slow == 0)
+        {
+            if (planner_)
+            {
+                planner_->plan();
+            }
+
+            if (trace)
+            {
+                const ActuationCommand actuation_command = actuator_->getActuationCommand();
+
+                std::cout << millisecondsToSeconds(millis()) << "\t" << plant_->getPositionX()
+                        << "\t" << plant_->getVelocityX() << "\t" << plant_->getAttitudeY()
+                        << "\t" << plant_->getAttitudeZ() << "\t"
+                        << (actuation_command.motor_left_forward ? 1 : -1)
+                                * actuation_command.motor_left_pwm << "\t"
+                        << (actuation_command.motor_right_forward ? 1 : -1)
+                                * actuation_command.motor_right_pwm << std::endl;
+            }
+        }
+    }
+
+    const double time_wall = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - time_point_start).count();
+
+    /*
+     *  Print the simulation summary.
+     */
+    std::cerr << "Simulated time: " << microsecondsToSeconds(micros()) << " s" << std::endl;
+    std::cerr << "Wall time: " << time_wall << " s (" << microsecondsToSeconds(micros()) / time_wall
+            << "x real time)" << std::endl;
+    std::cerr << "Real-time task iterations: " << iterations << ", mean "
+            << execution_time_total_ / iterations << " ns, max " << execution_time_max_ << " ns"
+            << std::endl;
+    std::cerr << "Final position: " << plant_->getPositionX() << " m, pitch: "
+            << radiansToDegrees(plant_->getAttitudeY()) << " deg, yaw: "
+            << radiansToDegrees(plant_->getAttitudeZ()) << " deg" << std::endl;
+    std::cerr << "Controller: " << (controller_->getActiveStatus() ? "active" : "inactive")
+            << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/**
+ *  @file   median_filter.cpp
+ *  @author Simon Yu
+ *  @date   01/24/2022
+ *  @brief  Median filter benchmark source.
+ *
+ *  This file implements the median filter benchmark. The benchmark
+ *  first verifies that the streaming median filter produces the same
+ *  medians as the sorting median filter it replaced, over random data
+ *  with repeated values, for a range of window sizes. It then measures
+ *  the time per filtered data of both median filters using Google
+ *  Benchmark, at the time-of-flight window size and larger ones.
+ *
+ *  The benchmark exits with failure if any median differs.
+ *
+ *  Usage: biped-median-filter [benchmark options]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "simulator/parameter.h"
+#include "utility/median_filter.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @tparam Type Type of data for filtering.
+ *  @brief  Sorting median filter templated class.
+ *
+ *  This templated class filters data the same way as the median
+ *  filter did before, i.e., by copying the window into a vector
+ *  and sorting it for every data.
+ */
+template<typename Type>
+class SortingMedianFilter
+{
+public:
+
+    /**
+     *  @param  window_size Median filter window size.
+     *  @brief  Sorting median filter templated class constructor.
+     *
+     *  This constructor initializes all class member variables and
+     *  the median filter window.
+     */
+    SortingMedianFilter(const size_t& window_size) : window_size_(window_size)
+    {
+        for (size_t i = 0; i < window_size; i ++)
+        {
+            window_.push_front(Type());
+        }
+    }
+
+    /**
+     *  @param  data New data.
+     *  @return Filtered data.
+     *  @brief  Filter data using the sorting median filter.
+     *
+     *  This function filters the new data by sorting a copy
+     *  of the window.
+     */
+    Type
+    filter(const Type& data)
+    {
+        window_.push_front(data);
+        window_.pop_back();
+
+        std::vector<Type> window_sorted(window_.begin(), window_.end());
+        const size_t median_index = static_cast<size_t>(std::floor(window_size_ / 2.0));
+        std::sort(window_sorted.begin(), window_sorted.end());
+
+        return window_sorted[median_index];
+    }
+
+private:
+
+    std::list<Type> window_;    //!< Median filter window.
+    size_t window_size_;    //!< Median filter window size.
+};
+
+/**
+ *  @param  count Number of data.
+ *  @return Random ranges, in meters.
+ *  @brief  Generate random ranges.
+ *
+ *  This function generates random time-of-flight ranges, rounded
+ *  to millimeters such that the window contains repeated values,
+ *  with occasional outliers.
+ */
+std::vector<double>
+generate(const size_t& count)
+{
+    std::mt19937 random_number_generator(SimulatedSensorParameter::seed);
+    std::normal_distribution<double> range(0.5, 0.01);
+    std::bernoulli_distribution outlier(0.05);
+    std::vector<double> ranges(count);
+
+    for (auto& data : ranges)
+    {
+        data = outlier(random_number_generator) ? 0 :
+                std::round(range(random_number_generator) * 1000) / 1000;
+    }
+
+    return ranges;
+}
+
+/**
+ *  @tparam WindowSize Median filter window size.
+ *  @return Whether both median filters produced the same medians.
+ *  @brief  Verify the streaming median filter.
+ *
+ *  This function filters the same random ranges using both
+ *  median filters and compares the medians.
+ */
+template<size_t WindowSize>
+bool
+verify()
+{
+    MedianFilter<double, WindowSize> median_filter;
+    SortingMedianFilter<double> sorting_median_filter(WindowSize);
+
+    for (const auto& data : generate(10000))
+    {
+        if (median_filter.filter(data) != sorting_median_filter.filter(data))
+        {
+            std::cerr << "Median filter mismatch at window size " << WindowSize << "." << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ *  @tparam WindowSize Median filter window size.
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark the streaming median filter.
+ */
+template<size_t WindowSize>
+void
+benchmarkMedianFilter(benchmark::State& state)
+{
+    MedianFilter<double, WindowSize> median_filter;
+    const std::vector<double> ranges = generate(1024);
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(median_filter.filter(ranges[index ++ & 1023]));
+    }
+}
+
+/**
+ *  @tparam WindowSize Median filter window size.
+ *  @param  state Benchmark state.
+ *  @brief  Benchmark the sorting median filter.
+ */
+template<size_t WindowSize>
+void
+benchmarkSortingMedianFilter(benchmark::State& state)
+{
+    SortingMedianFilter<double> sorting_median_filter(WindowSize);
+    const std::vector<double> ranges = generate(1024);
+    size_t index = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sorting_median_filter.filter(ranges[index ++ & 1023]));
+    }
+}
+
+/*
+ *  Register the benchmarks at the time-of-flight window size
+ *  and larger window sizes.
+ */
+BENCHMARK_TEMPLATE(benchmarkMedianFilter, MedianFilterParameter::window_size);
+BENCHMARK_TEMPLATE(benchmarkSortingMedianFilter, MedianFilterParameter::window_size);
+BENCHMARK_TEMPLATE(benchmarkMedianFilter, 31);
+BENCHMARK_TEMPLATE(benchmarkSortingMedianFilter, 31);
+BENCHMARK_TEMPLATE(benchmarkMedianFilter, 101);
+BENCHMARK_TEMPLATE(benchmarkSortingMedianFilter, 101);
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Verify the streaming median filter against the sorting
+     *  median filter, for odd and even window sizes.
+     */
+    const bool passed = verify<1>() && verify<2>() && verify<3>() && verify<4>()
+            && verify<MedianFilterParameter::window_size>() && verify<31>() && verify<101>();
+    std::cout << "Median filter " << (passed ? "passed" : "FAILED") << std::endl;
+
+    if (!passed)
+    {
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Run the benchmarks.
+     */
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return EXIT_SUCCESS;
+}
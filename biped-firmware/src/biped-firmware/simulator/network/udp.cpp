@@ -0,0 +1,143 @@
+/**
+ *  @file   udp.cpp
+ *  @author Simon Yu
+ *  @date   01/29/2022
+ *  @brief  Simulated UDP class source.
+ *
+ *  This file implements the simulated UDP class.
+ */
+
+/*
+ *  External headers.
+ */
+#include <arpa/inet.h>
+#include <cstring>
+
+/*
+ *  Project headers.
+ */
+#include "network/udp.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+UDP::UDP() : byte_count_(0), packet_ { }, packet_count_(0), packet_size_(0), port_(0),
+        receiver_(nullptr), remote_(false)
+{
+}
+
+void
+UDP::initialize(const uint16_t& port)
+{
+    port_ = port;
+}
+
+std::string
+UDP::read(const std::string& ip_remote, const uint16_t& port, const size_t& size)
+{
+    return "";
+}
+
+std::shared_ptr<std::vector<char>>
+UDP::readBuffer(const std::string& ip_remote, const uint16_t& port, const size_t& size)
+{
+    return nullptr;
+}
+
+size_t
+UDP::write(const std::string& ip_remote, const uint16_t& port, const std::string& data)
+{
+    return writeBuffer(ip_remote, port, reinterpret_cast<const uint8_t*>(data.c_str()), data.size());
+}
+
+size_t
+UDP::writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8_t* buffer,
+        const size_t& size)
+{
+    /*
+     *  Parse the given remote IP address on every write, the
+     *  same way as the UDP class does.
+     */
+    return validate(ip_remote) ? record(buffer, size) : 0;
+}
+
+size_t
+UDP::writeBuffer(const uint8_t* buffer, const size_t& size)
+{
+    return remote_ ? record(buffer, size) : 0;
+}
+
+bool
+UDP::setRemote(const std::string& ip_remote, const uint16_t& port)
+{
+    remote_ = validate(ip_remote);
+
+    return remote_;
+}
+
+void
+UDP::setReceiver(const Receiver& receiver)
+{
+    receiver_ = receiver;
+}
+
+unsigned long long
+UDP::getByteCount() const
+{
+    return byte_count_;
+}
+
+const uint8_t*
+UDP::getPacket() const
+{
+    return packet_;
+}
+
+unsigned long long
+UDP::getPacketCount() const
+{
+    return packet_count_;
+}
+
+size_t
+UDP::getPacketSize() const
+{
+    return packet_size_;
+}
+
+bool
+UDP::validate(const std::string& ip_remote)
+{
+    in_addr address;
+
+    return inet_pton(AF_INET, ip_remote.c_str(), &address) == 1;
+}
+
+size_t
+UDP::record(const uint8_t* buffer, const size_t& size)
+{
+    /*
+     *  Truncate the packet to the size of the preallocated
+     *  buffer, as the UDP payload would be.
+     */
+    packet_size_ = size < sizeof(packet_) ? size : sizeof(packet_);
+    std::memcpy(packet_, buffer, packet_size_);
+    byte_count_ += packet_size_;
+    packet_count_ ++;
+
+    if (receiver_)
+    {
+        receiver_(packet_, packet_size_);
+    }
+
+    return packet_size_;
+}
+}   // namespace firmware
+}   // namespace biped
@@ -0,0 +1,211 @@
+/**
+ *  @file   udp.h
+ *  @author Simon Yu
+ *  @date   01/29/2022
+ *  @brief  Simulated UDP class header.
+ *
+ *  This file defines the simulated UDP class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef NETWORK_UDP_H_
+#define NETWORK_UDP_H_
+
+/*
+ *  External headers.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated UDP class.
+ *
+ *  This class mirrors the UDP class. Instead of sending packets
+ *  over Wi-Fi, it counts the written packets and bytes and keeps
+ *  a copy of the last written packet in a preallocated buffer, such
+ *  that writing does not allocate memory. Reading returns nothing.
+ */
+class UDP
+{
+public:
+
+    /**
+     *  @brief  Receiver function type.
+     *
+     *  The receiver function takes every written packet and its
+     *  size, in bytes, as if received by the remote endpoint.
+     */
+    using Receiver = void (*)(const uint8_t*, const size_t&);
+
+    /**
+     *  @brief  Simulated UDP class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    UDP();
+
+    /**
+     *  @param  port UDP port.
+     *  @brief  Initialize UDP.
+     *
+     *  This function stores the given port.
+     */
+    void
+    initialize(const uint16_t& port);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  size Read size, in bytes.
+     *  @return Empty string.
+     *  @brief  UDP string reading function.
+     */
+    std::string
+    read(const std::string& ip_remote, const uint16_t& port, const size_t& size);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  size Read size, in bytes.
+     *  @return Null pointer.
+     *  @brief  UDP buffer reading function.
+     */
+    std::shared_ptr<std::vector<char>>
+    readBuffer(const std::string& ip_remote, const uint16_t& port, const size_t& size);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  data Data as a string.
+     *  @return Size written, in bytes.
+     *  @brief  UDP string writing function.
+     */
+    size_t
+    write(const std::string& ip_remote, const uint16_t& port, const std::string& data);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  buffer Buffer pointer.
+     *  @param  size Size of the buffer, in bytes.
+     *  @return Size written, in bytes.
+     *  @brief  UDP buffer writing function.
+     *
+     *  This function validates the given remote IP address, the same
+     *  way as the UDP class parses it, and records the given buffer.
+     */
+    size_t
+    writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8_t* buffer,
+            const size_t& size);
+
+    /**
+     *  @param  buffer Buffer pointer.
+     *  @param  size Size of the buffer, in bytes.
+     *  @return Size written, in bytes.
+     *  @brief  UDP buffer writing function to the remote endpoint.
+     *
+     *  This function records the given buffer if the remote endpoint
+     *  has been set.
+     */
+    size_t
+    writeBuffer(const uint8_t* buffer, const size_t& size);
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @return Whether the remote IP address is valid.
+     *  @brief  Set the remote endpoint.
+     */
+    bool
+    setRemote(const std::string& ip_remote, const uint16_t& port);
+
+    /**
+     *  @param  receiver Receiver function, or null pointer.
+     *  @brief  Set the receiver function.
+     *
+     *  This function sets the function that every written packet
+     *  is passed to, such that packets written in a burst can all
+     *  be inspected, not only the last one.
+     */
+    void
+    setReceiver(const Receiver& receiver);
+
+    /**
+     *  @return Number of bytes written.
+     *  @brief  Get the number of bytes written.
+     */
+    unsigned long long
+    getByteCount() const;
+
+    /**
+     *  @return Pointer to the last written packet.
+     *  @brief  Get the last written packet.
+     */
+    const uint8_t*
+    getPacket() const;
+
+    /**
+     *  @return Number of packets written.
+     *  @brief  Get the number of packets written.
+     */
+    unsigned long long
+    getPacketCount() const;
+
+    /**
+     *  @return Size of the last written packet, in bytes.
+     *  @brief  Get the size of the last written packet.
+     */
+    size_t
+    getPacketSize() const;
+
+private:
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @return Whether the remote IP address is a valid IPv4 address.
+     *  @brief  Validate a remote IP address.
+     */
+    static bool
+    validate(const std::string& ip_remote);
+
+    /**
+     *  @param  buffer Buffer pointer.
+     *  @param  size Size of the buffer, in bytes.
+     *  @return Size written, in bytes.
+     *  @brief  Record a written packet.
+     */
+    size_t
+    record(const uint8_t* buffer, const size_t& size);
+
+    unsigned long long byte_count_; //!< Number of bytes written.
+    uint8_t packet_[NetworkParameter::buffer_size_camera];  //!< Last written packet.
+    unsigned long long packet_count_;   //!< Number of packets written.
+    size_t packet_size_;    //!< Size of the last written packet, in bytes.
+    uint16_t port_; //!< Local UDP port.
+    Receiver receiver_; //!< Receiver function.
+    bool remote_;   //!< Whether the remote endpoint has been set.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // NETWORK_UDP_H_
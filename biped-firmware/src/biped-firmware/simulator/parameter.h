@@ -0,0 +1,86 @@
+/**
+ *  @file   parameter.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulator parameter constant expression header.
+ *
+ *  This file defines the simulator parameter constant expressions.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_PARAMETER_H_
+#define SIMULATOR_PARAMETER_H_
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/*
+ *  Plant parameter namespace.
+ *
+ *  The plant is modeled as an inverted pendulum on two
+ *  wheels driven by DC motors. The motor force is linear
+ *  in the PWM duty cycle, minus a back-EMF term linear in
+ *  the wheel velocity. Turning is further damped by the
+ *  wheels scrubbing on the ground.
+ */
+namespace PlantParameter
+{
+constexpr double attitude_y_initial = 0.05; //!< Initial Y attitude (pitch), in radians.
+constexpr double damping_z = 1;   //!< Wheel scrub damping around the Z axis, in newton meter seconds.
+constexpr double gravity = 9.81;    //!< Gravitational acceleration, in meters per second squared.
+constexpr double inertia_z = 0.001; //!< Moment of inertia around the Z axis, in kilogram square meters.
+constexpr double length = 0.08; //!< Half length of the body, in meters.
+constexpr double mass_body = 0.4;   //!< Mass of the body, in kilograms.
+constexpr double mass_wheel = 0.1;  //!< Mass of both wheels, in kilograms.
+constexpr double motor_damping = 10; //!< Motor back-EMF damping, in newton seconds per meter.
+constexpr double motor_force_gain = 0.04;  //!< Motor force per PWM duty cycle step, in newtons.
+constexpr double period = 0.0005;   //!< Plant integration period, in seconds.
+constexpr double range_side = 1;    //!< Left and right obstacle range, in meters.
+constexpr double range_wall = 2;    //!< Initial range to the wall in front, in meters.
+constexpr double track = 0.1;   //!< Distance between the wheels, in meters.
+}   // namespace PlantParameter
+
+/*
+ *  Simulated encoder parameter namespace.
+ *
+ *  The encoders are modeled as ideal quadrature signals
+ *  with occasional contact bounces, sampled by a single
+ *  GPIO interrupt handler shared by all encoder pins.
+ */
+namespace SimulatedEncoderParameter
+{
+constexpr double bounce_duration = 20e-6;   //!< Maximum contact bounce duration, in seconds.
+constexpr double bounce_probability = 0.05; //!< Probability of a contact bounce after an edge.
+constexpr double interrupt_duration = 2e-6; //!< Interrupt handler execution time, in seconds.
+constexpr double interrupt_latency = 3e-6;  //!< Interrupt latency, from edge to pin sampling, in seconds.
+constexpr double rpm_max = 400; //!< Maximum wheel revolutions per minute.
+constexpr double wheel_circumference = 0.21;    //!< Wheel circumference, in meters.
+}   // namespace SimulatedEncoderParameter
+
+/*
+ *  Simulated sensor parameter namespace.
+ */
+namespace SimulatedSensorParameter
+{
+constexpr double acceleration_noise = 0.05; //!< Accelerometer noise standard deviation, in meters per second squared.
+constexpr double angular_velocity_noise = 0.005;    //!< Gyroscope noise standard deviation, in radians per second.
+constexpr uint32_t seed = 431;  //!< Noise random number generator seed.
+}   // namespace SimulatedSensorParameter
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // SIMULATOR_PARAMETER_H_
@@ -0,0 +1,193 @@
+/**
+ *  @file   plant.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated plant class source.
+ *
+ *  This file implements the simulated plant class.
+ */
+
+/*
+ *  External headers.
+ */
+#include <cmath>
+
+/*
+ *  Project headers.
+ */
+#include "simulator/parameter.h"
+#include "simulator/plant.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+Plant::Plant() : acceleration_x_(0), angular_velocity_y_(0), angular_velocity_z_(0),
+        attitude_y_(PlantParameter::attitude_y_initial), attitude_z_(0), motor_output_left_(0),
+        motor_output_right_(0), position_left_(0), position_right_(0), position_x_(0),
+        velocity_x_(0)
+{
+}
+
+double
+Plant::getAccelerationX() const
+{
+    return acceleration_x_;
+}
+
+double
+Plant::getAngularVelocityY() const
+{
+    return angular_velocity_y_;
+}
+
+double
+Plant::getAngularVelocityZ() const
+{
+    return angular_velocity_z_;
+}
+
+double
+Plant::getAttitudeY() const
+{
+    return attitude_y_;
+}
+
+double
+Plant::getAttitudeZ() const
+{
+    return attitude_z_;
+}
+
+double
+Plant::getPositionLeft() const
+{
+    return position_left_;
+}
+
+double
+Plant::getPositionRight() const
+{
+    return position_right_;
+}
+
+double
+Plant::getPositionX() const
+{
+    return position_x_;
+}
+
+double
+Plant::getVelocityX() const
+{
+    return velocity_x_;
+}
+
+void
+Plant::disturb(const double& angular_velocity_y, const double& angular_velocity_z)
+{
+    angular_velocity_y_ += angular_velocity_y;
+    angular_velocity_z_ += angular_velocity_z;
+}
+
+void
+Plant::setMotorOutput(const double& left, const double& right)
+{
+    motor_output_left_ = left;
+    motor_output_right_ = right;
+}
+
+void
+Plant::step(const double& period)
+{
+    /*
+     *  Integrate in steps of the plant integration period,
+     *  followed by the remainder, if any.
+     */
+    double remainder = period;
+
+    while (remainder > PlantParameter::period)
+    {
+        integrate(PlantParameter::period);
+        remainder -= PlantParameter::period;
+    }
+
+    if (remainder > 0)
+    {
+        integrate(remainder);
+    }
+}
+
+void
+Plant::integrate(const double& period)
+{
+    /*
+     *  Calculate the wheel velocities and the motor forces.
+     */
+    const double velocity_left = velocity_x_ + angular_velocity_z_ * PlantParameter::track / 2;
+    const double velocity_right = velocity_x_ - angular_velocity_z_ * PlantParameter::track / 2;
+    const double force_left = PlantParameter::motor_force_gain * motor_output_left_
+            - PlantParameter::motor_damping * velocity_left;
+    const double force_right = PlantParameter::motor_force_gain * motor_output_right_
+            - PlantParameter::motor_damping * velocity_right;
+
+    /*
+     *  Inverted pendulum dynamics in terms of the lean angle
+     *  towards the positive X axis, i.e., the negative Y attitude.
+     */
+    const double mass_total = PlantParameter::mass_body + PlantParameter::mass_wheel;
+    const double lean = -attitude_y_;
+    const double lean_rate = -angular_velocity_y_;
+    const double force_term = (force_left + force_right
+            + PlantParameter::mass_body * PlantParameter::length * lean_rate * lean_rate
+                    * std::sin(lean)) / mass_total;
+    const double lean_acceleration = (PlantParameter::gravity * std::sin(lean)
+            - std::cos(lean) * force_term)
+            / (PlantParameter::length
+                    * (4.0 / 3.0
+                            - PlantParameter::mass_body * std::cos(lean) * std::cos(lean)
+                                    / mass_total));
+    acceleration_x_ = force_term
+            - PlantParameter::mass_body * PlantParameter::length * lean_acceleration
+                    * std::cos(lean) / mass_total;
+
+    /*
+     *  Yaw dynamics.
+     */
+    const double angular_acceleration_z = ((force_left - force_right) * PlantParameter::track / 2
+            - PlantParameter::damping_z * angular_velocity_z_) / PlantParameter::inertia_z;
+
+    /*
+     *  Semi-implicit Euler integration.
+     */
+    velocity_x_ += acceleration_x_ * period;
+    position_x_ += velocity_x_ * period;
+    angular_velocity_y_ -= lean_acceleration * period;
+    attitude_y_ += angular_velocity_y_ * period;
+    angular_velocity_z_ += angular_acceleration_z * period;
+    attitude_z_ += angular_velocity_z_ * period;
+    position_left_ += (velocity_x_ + angular_velocity_z_ * PlantParameter::track / 2) * period;
+    position_right_ += (velocity_x_ - angular_velocity_z_ * PlantParameter::track / 2) * period;
+
+    /*
+     *  The body rests on the ground once it has fallen over.
+     */
+    if (std::fabs(attitude_y_) >= M_PI / 2)
+    {
+        attitude_y_ = std::copysign(M_PI / 2, attitude_y_);
+        angular_velocity_y_ = 0;
+    }
+}
+
+/*
+ *  Initialize simulated plant shared pointer to null pointer.
+ */
+std::shared_ptr<Plant> plant_ = nullptr;
+}   // namespace firmware
+}   // namespace biped
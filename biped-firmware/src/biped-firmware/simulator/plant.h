@@ -0,0 +1,178 @@
+/**
+ *  @file   plant.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated plant class header.
+ *
+ *  This file defines the simulated plant class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SIMULATOR_PLANT_H_
+#define SIMULATOR_PLANT_H_
+
+/*
+ *  External headers.
+ */
+#include <memory>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated plant class.
+ *
+ *  This class models the Biped as an inverted pendulum on
+ *  two wheels. The simulated actuator sets the motor outputs
+ *  and the simulated sensor reads the plant states.
+ *
+ *  The X axis points in the direction the wheels travel
+ *  for positive motor outputs. Following the firmware IMU
+ *  convention, a positive Y attitude (pitch) means that the
+ *  body leans towards the negative X axis.
+ */
+class Plant
+{
+public:
+
+    /**
+     *  @brief  Simulated plant class constructor.
+     *
+     *  This constructor initializes all plant states.
+     */
+    Plant();
+
+    /**
+     *  @return X acceleration, in meters per second squared.
+     *  @brief  Get the X acceleration of the wheels.
+     */
+    double
+    getAccelerationX() const;
+
+    /**
+     *  @return Y angular velocity, in radians per second.
+     *  @brief  Get the Y angular velocity (pitch rate).
+     */
+    double
+    getAngularVelocityY() const;
+
+    /**
+     *  @return Z angular velocity, in radians per second.
+     *  @brief  Get the Z angular velocity (yaw rate).
+     */
+    double
+    getAngularVelocityZ() const;
+
+    /**
+     *  @return Y attitude, in radians.
+     *  @brief  Get the Y attitude (pitch).
+     */
+    double
+    getAttitudeY() const;
+
+    /**
+     *  @return Z attitude, in radians.
+     *  @brief  Get the Z attitude (yaw).
+     */
+    double
+    getAttitudeZ() const;
+
+    /**
+     *  @return Left wheel position, in meters.
+     *  @brief  Get the distance traveled by the left wheel.
+     */
+    double
+    getPositionLeft() const;
+
+    /**
+     *  @return Right wheel position, in meters.
+     *  @brief  Get the distance traveled by the right wheel.
+     */
+    double
+    getPositionRight() const;
+
+    /**
+     *  @return X position, in meters.
+     *  @brief  Get the X position.
+     */
+    double
+    getPositionX() const;
+
+    /**
+     *  @return X velocity, in meters per second.
+     *  @brief  Get the X velocity.
+     */
+    double
+    getVelocityX() const;
+
+    /**
+     *  @param  angular_velocity_y Y angular velocity change, in radians per second.
+     *  @param  angular_velocity_z Z angular velocity change, in radians per second.
+     *  @brief  Disturb the plant.
+     *
+     *  This function changes the Y and Z angular velocities
+     *  instantaneously, as an impulsive push on the body would.
+     */
+    void
+    disturb(const double& angular_velocity_y, const double& angular_velocity_z);
+
+    /**
+     *  @param  left Signed left motor output, in PWM duty cycle steps.
+     *  @param  right Signed right motor output, in PWM duty cycle steps.
+     *  @brief  Set the motor outputs.
+     *
+     *  This function sets the motor outputs that are applied
+     *  until the next call.
+     */
+    void
+    setMotorOutput(const double& left, const double& right);
+
+    /**
+     *  @param  period Time to simulate, in seconds.
+     *  @brief  Advance the plant.
+     *
+     *  This function integrates the plant dynamics over the
+     *  given time, in steps of the plant integration period.
+     */
+    void
+    step(const double& period);
+
+private:
+
+    /**
+     *  @param  period Integration period, in seconds.
+     *  @brief  Integrate the plant dynamics over a single period.
+     *
+     *  This function integrates the plant dynamics over a single
+     *  period using the semi-implicit Euler method.
+     */
+    void
+    integrate(const double& period);
+
+    double acceleration_x_; //!< X acceleration, in meters per second squared.
+    double angular_velocity_y_; //!< Y angular velocity, in radians per second.
+    double angular_velocity_z_; //!< Z angular velocity, in radians per second.
+    double attitude_y_; //!< Y attitude, in radians.
+    double attitude_z_; //!< Z attitude, in radians.
+    double motor_output_left_;  //!< Signed left motor output, in PWM duty cycle steps.
+    double motor_output_right_; //!< Signed right motor output, in PWM duty cycle steps.
+    double position_left_;  //!< Left wheel position, in meters.
+    double position_right_; //!< Right wheel position, in meters.
+    double position_x_; //!< X position, in meters.
+    double velocity_x_; //!< X velocity, in meters per second.
+};
+
+extern std::shared_ptr<Plant> plant_;   //!< Simulated plant shared pointer.
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // SIMULATOR_PLANT_H_
@@ -0,0 +1,61 @@
+/**
+ *  @file   neopixel.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated NeoPixel class source.
+ *
+ *  This file implements the simulated NeoPixel class.
+ */
+
+/*
+ *  Project headers.
+ */
+#include "platform/neopixel.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+NeoPixel::NeoPixel() : brightness_(0), frame_(nullptr)
+{
+}
+
+void
+NeoPixel::setBrightness(const int& brightness)
+{
+    /*
+     *  Set the class member brightness.
+     */
+    brightness_ = brightness;
+}
+
+void
+NeoPixel::setFrame(const std::shared_ptr<Frame> frame)
+{
+    /*
+     *  Set the class member frame.
+     */
+    frame_ = frame;
+}
+
+void
+NeoPixel::clear()
+{
+    /*
+     *  Clear the class member frame.
+     */
+    frame_ = nullptr;
+}
+
+void
+NeoPixel::show()
+{
+}
+}   // namespace firmware
+}   // namespace biped
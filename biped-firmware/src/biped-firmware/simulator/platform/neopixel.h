@@ -0,0 +1,95 @@
+/**
+ *  @file   neopixel.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated NeoPixel class header.
+ *
+ *  This file defines the simulated NeoPixel class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef PLATFORM_NEOPIXEL_H_
+#define PLATFORM_NEOPIXEL_H_
+
+/*
+ *  External headers.
+ */
+#include <Eigen/Dense>
+#include <memory>
+#include <vector>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated NeoPixel class.
+ *
+ *  This class mirrors the NeoPixel class. The simulated
+ *  NeoPixel only keeps the current frame and brightness.
+ */
+class NeoPixel
+{
+public:
+
+    using Frame = std::vector<Eigen::Vector3i>; //!< NeoPixel frame type.
+
+    /**
+     *  @brief  Simulated NeoPixel class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    NeoPixel();
+
+    /**
+     *  @param  brightness LED brightness.
+     *  @brief  Set the brightness of the NeoPixel LED array.
+     *
+     *  This function sets the brightness of the NeoPixel
+     *  LED array.
+     */
+    void
+    setBrightness(const int& brightness);
+
+    /**
+     *  @param  frame NeoPixel frame shared pointer.
+     *  @brief  Set the NeoPixel frame.
+     *
+     *  This function sets the NeoPixel frame.
+     */
+    void
+    setFrame(const std::shared_ptr<Frame> frame);
+
+    /**
+     *  @brief  Clear the NeoPixel LED array.
+     *
+     *  This function clears the NeoPixel frame.
+     */
+    void
+    clear();
+
+    /**
+     *  @brief  Show the NeoPixel frame.
+     *
+     *  This function does nothing in the simulator.
+     */
+    void
+    show();
+
+private:
+
+    int brightness_;    //!< LED brightness.
+    std::shared_ptr<Frame> frame_;  //!< NeoPixel frame shared pointer.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // PLATFORM_NEOPIXEL_H_
@@ -0,0 +1,112 @@
+/**
+ *  @file   timer.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated timer class source.
+ *
+ *  This file implements the simulated timer class.
+ */
+
+/*
+ *  Project headers.
+ */
+#include "platform/timer.h"
+#include "simulator/clock.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+Timer::Timer() : enable_(false), handler_(nullptr), handler_arg_(nullptr), interval_(0)
+{
+}
+
+bool
+Timer::attachInterrupt(void
+(*handler)(void*), void* arg)
+{
+    /*
+     *  Validate the given interrupt handler.
+     */
+    if (!handler)
+    {
+        return false;
+    }
+
+    /*
+     *  Attach the given interrupt handler and argument.
+     */
+    handler_ = handler;
+    handler_arg_ = arg;
+
+    return true;
+}
+
+void
+Timer::clearInterrupt()
+{
+}
+
+bool
+Timer::detachInterrupt()
+{
+    /*
+     *  Detach the interrupt handler.
+     */
+    handler_ = nullptr;
+    handler_arg_ = nullptr;
+
+    return true;
+}
+
+void
+Timer::disable()
+{
+    /*
+     *  Disable the timer.
+     */
+    enable_ = false;
+}
+
+void
+Timer::enable()
+{
+    /*
+     *  Enable the timer.
+     */
+    enable_ = true;
+}
+
+void
+Timer::fire()
+{
+    /*
+     *  Advance the simulated clock by the timer interval.
+     */
+    Clock::advance(interval_);
+
+    /*
+     *  Call the interrupt handler if the timer is enabled.
+     */
+    if (enable_ && handler_)
+    {
+        handler_(handler_arg_);
+    }
+}
+
+void
+Timer::setInterval(const uint64_t& interval)
+{
+    /*
+     *  Set the timer interval.
+     */
+    interval_ = interval;
+}
+}   // namespace firmware
+}   // namespace biped
@@ -0,0 +1,127 @@
+/**
+ *  @file   timer.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated timer class header.
+ *
+ *  This file defines the simulated timer class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef PLATFORM_TIMER_H_
+#define PLATFORM_TIMER_H_
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated timer class.
+ *
+ *  This class mirrors the hardware timer class. Instead of
+ *  a hardware alarm, the simulator fires the timer explicitly,
+ *  which advances the simulated clock by the timer interval
+ *  and calls the attached interrupt handler.
+ */
+class Timer
+{
+public:
+
+    /**
+     *  @brief  Simulated timer class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    Timer();
+
+    /**
+     *  @param  handler Interrupt handler function pointer.
+     *  @param  arg Interrupt handler function argument pointer, default to a null pointer.
+     *  @return Whether the given interrupt handler was attached successfully.
+     *  @brief  Attach an interrupt handler to the timer.
+     *
+     *  This function attaches the given interrupt handler to the
+     *  timer. The given function argument pointer is passed to the
+     *  given interrupt handler when it is called.
+     */
+    bool
+    attachInterrupt(void
+    (*handler)(void*), void* arg = nullptr);
+
+    /**
+     *  @brief  Clear the timer interrupt.
+     *
+     *  This function does nothing in the simulator.
+     */
+    void
+    clearInterrupt();
+
+    /**
+     *  @return Whether the interrupt handler was detached successfully.
+     *  @brief  Detach the interrupt handler from the timer.
+     *
+     *  This function detaches the interrupt handler from the timer.
+     */
+    bool
+    detachInterrupt();
+
+    /**
+     *  @brief  Disable the timer.
+     *
+     *  This function disables the timer.
+     */
+    void
+    disable();
+
+    /**
+     *  @brief  Enable the timer.
+     *
+     *  This function enables the timer.
+     */
+    void
+    enable();
+
+    /**
+     *  @brief  Fire the timer.
+     *
+     *  This function advances the simulated clock by the timer
+     *  interval and, if the timer is enabled, calls the attached
+     *  interrupt handler.
+     */
+    void
+    fire();
+
+    /**
+     *  @param  interval Timer interval, in microseconds.
+     *  @brief  Set the timer interval.
+     *
+     *  This function sets the timer interval, i.e., the period
+     *  at which the timer alarm is triggered.
+     */
+    void
+    setInterval(const uint64_t& interval);
+
+private:
+
+    bool enable_;   //!< Timer enable flag.
+    void (*handler_)(void*);    //!< Interrupt handler function pointer.
+    void* handler_arg_; //!< Interrupt handler function argument pointer.
+    uint64_t interval_; //!< Timer interval, in microseconds.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // PLATFORM_TIMER_H_
@@ -0,0 +1,372 @@
+/**
+ *  @file   quadrature.cpp
+ *  @author Simon Yu
+ *  @date   01/22/2022
+ *  @brief  Quadrature decoder harness source.
+ *
+ *  This file implements the quadrature decoder harness. The harness
+ *  generates the edge sequences of both encoders, including contact
+ *  bounces, at wheel speeds up to the maximum wheel speed, and feeds
+ *  them through a model of the GPIO interrupt handler, which samples
+ *  the encoder pins after the interrupt latency and coalesces repeated
+ *  edges of a pin whose interrupt is still pending. The sampled pin
+ *  states are decoded by both the lookup table-based quadrature decoder
+ *  and the per-channel branching decoder it replaced, and the decoded
+ *  steps are compared against the true steps.
+ *
+ *  Alternatively, the harness replays a recorded edge sequence of a
+ *  single encoder from a file, with one "time a b" line per edge, the
+ *  time being in seconds, through the same interrupt handler model.
+ *
+ *  The harness exits with failure if the quadrature decoder loses any
+ *  step or detects any illegal transition at the generated speeds.
+ *
+ *  Usage: biped-quadrature [duration] [recording]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "simulator/parameter.h"
+#include "utility/quadrature_decoder.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @brief  Edge struct.
+ *
+ *  This struct contains the entries of an edge of an encoder channel.
+ */
+struct Edge
+{
+    double time;    //!< Edge time, in seconds.
+    unsigned encoder;   //!< Encoder index, 0 for left and 1 for right.
+    unsigned channel;   //!< Channel index, 0 for A and 1 for B.
+};
+
+/**
+ *  @brief  Decoding result struct.
+ *
+ *  This struct contains the decoding results of both decoders
+ *  for an encoder.
+ */
+struct Result
+{
+    long steps_branching;   //!< Steps decoded by the branching decoder.
+    long steps_quadrature;  //!< Steps decoded by the quadrature decoder.
+    long steps_true;    //!< True steps.
+    unsigned long transition_errors;    //!< Illegal transitions detected by the quadrature decoder.
+};
+
+/**
+ *  @param  state Channel states, with channel A in bit 1 and B in bit 0.
+ *  @param  channel Channel index of the interrupt.
+ *  @param  reversed Whether the encoder counts in the reversed direction.
+ *  @return Step decoded by the branching decoder.
+ *  @brief  Decode a step using the branching decoder.
+ *
+ *  This function decodes a step the same way as the per-channel
+ *  branching encoder interrupt callbacks did, i.e., assuming
+ *  that every interrupt corresponds to exactly one step.
+ */
+long
+decodeBranching(const uint8_t& state, const unsigned& channel, const bool& reversed)
+{
+    const bool a = state & 0b10;
+    const bool b = state & 0b01;
+    const long step = (channel == 0) == (a != b) ? 1 : -1;
+
+    return reversed ? -step : step;
+}
+
+/**
+ *  @param  edges Edges of both encoders, sorted by time.
+ *  @param  states Initial channel states of both encoders.
+ *  @param  results Decoding results of both encoders.
+ *  @brief  Feed edges through the interrupt handler model.
+ *
+ *  This function feeds the given edges through the model of the GPIO
+ *  interrupt handler, which is shared by all encoder pins, and decodes
+ *  the pin states sampled by each interrupt using both decoders.
+ */
+void
+feed(const std::vector<Edge>& edges, uint8_t states[2], Result results[2])
+{
+    QuadratureDecoder<false> quadrature_decoder_left;
+    QuadratureDecoder<true> quadrature_decoder_right;
+    std::deque<Edge> interrupts;
+    bool pending[2][2] = { { false, false }, { false, false } };
+    double time_free = 0;
+    size_t index = 0;
+
+    quadrature_decoder_left.setState(states[0]);
+    quadrature_decoder_right.setState(states[1]);
+
+    while (index < edges.size() || !interrupts.empty())
+    {
+        const double time_edge =
+                index < edges.size() ? edges[index].time : std::numeric_limits<double>::max();
+        const double time_interrupt = interrupts.empty() ? std::numeric_limits<double>::max() :
+                std::max(time_free, interrupts.front().time
+                        + SimulatedEncoderParameter::interrupt_latency);
+
+        if (time_edge <= time_interrupt)
+        {
+            /*
+             *  Toggle the channel, and raise its interrupt unless
+             *  it is still pending, in which case the edge is
+             *  coalesced into the pending interrupt.
+             */
+            const Edge& edge = edges[index ++];
+            states[edge.encoder] ^= edge.channel == 0 ? 0b10 : 0b01;
+
+            if (!pending[edge.encoder][edge.channel])
+            {
+                pending[edge.encoder][edge.channel] = true;
+                interrupts.push_back(edge);
+            }
+        }
+        else
+        {
+            /*
+             *  Service the interrupt, sampling the pins of its encoder
+             *  after all edges up to the sampling time.
+             */
+            const Edge interrupt = interrupts.front();
+            const uint8_t state = states[interrupt.encoder];
+            const uint32_t timestamp = static_cast<uint32_t>(time_interrupt * 1e6);
+            interrupts.pop_front();
+            pending[interrupt.encoder][interrupt.channel] = false;
+            time_free = time_interrupt + SimulatedEncoderParameter::interrupt_duration;
+
+            results[interrupt.encoder].steps_branching += decodeBranching(state, interrupt.channel,
+                    interrupt.encoder == 1);
+
+            if (interrupt.encoder == 0)
+            {
+                quadrature_decoder_left.decode(state, timestamp);
+            }
+            else
+            {
+                quadrature_decoder_right.decode(state, timestamp);
+            }
+        }
+    }
+
+    results[0].steps_quadrature = quadrature_decoder_left.getSteps();
+    results[0].transition_errors = quadrature_decoder_left.getTransitionErrors();
+    results[1].steps_quadrature = quadrature_decoder_right.getSteps();
+    results[1].transition_errors = quadrature_decoder_right.getTransitionErrors();
+}
+
+/**
+ *  @param  duration Duration, in seconds.
+ *  @param  rpm Wheel revolutions per minute, negative for backward.
+ *  @param  encoder Encoder index.
+ *  @param  random_number_generator Random number generator.
+ *  @param  edges Generated edges.
+ *  @return True steps.
+ *  @brief  Generate the edges of an encoder.
+ *
+ *  This function generates the edges of an encoder turning at
+ *  the given speed, with a timing jitter of 10 percent of the
+ *  edge period and occasional contact bounces.
+ */
+long
+generate(const double& duration, const double& rpm, const unsigned& encoder,
+        std::mt19937& random_number_generator, std::vector<Edge>& edges)
+{
+    const double steps_per_revolution = EncoderParameter::steps_per_meter
+            * SimulatedEncoderParameter::wheel_circumference;
+    const double period = 60 / (std::abs(rpm) * steps_per_revolution);
+    const bool forward = rpm > 0;
+    std::uniform_real_distribution<double> jitter(-0.1 * period, 0.1 * period);
+    std::uniform_real_distribution<double> bounce(0, SimulatedEncoderParameter::bounce_duration / 2);
+    std::bernoulli_distribution bouncing(SimulatedEncoderParameter::bounce_probability);
+    long steps = 0;
+
+    for (double time = period; time < duration; time += period)
+    {
+        /*
+         *  Starting from both channels low, the forward Gray code
+         *  sequence toggles channel A first, and the backward one
+         *  toggles channel B first.
+         */
+        const unsigned channel = (steps & 1) == (forward ? 0 : 1) ? 0 : 1;
+        const double time_edge = time + jitter(random_number_generator);
+        edges.push_back({ time_edge, encoder, channel });
+
+        if (bouncing(random_number_generator))
+        {
+            const double time_bounce = time_edge + bounce(random_number_generator);
+            edges.push_back({ time_bounce, encoder, channel });
+            edges.push_back({ time_bounce + bounce(random_number_generator), encoder, channel });
+        }
+
+        steps ++;
+    }
+
+    /*
+     *  The right encoder counts in the reversed direction.
+     */
+    return (forward ? steps : -steps) * (encoder == 1 ? -1 : 1);
+}
+
+/**
+ *  @param  path Recording file path.
+ *  @return Whether the recording was replayed.
+ *  @brief  Replay a recorded edge sequence.
+ *
+ *  This function replays the recorded edge sequence of a single
+ *  encoder as the left encoder, with the true steps decoded from
+ *  every recorded state, and prints the decoding results.
+ */
+bool
+replay(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file)
+    {
+        std::cerr << "Failed to open recording " << path << "." << std::endl;
+        return false;
+    }
+
+    std::vector<Edge> edges;
+    QuadratureDecoder<false> quadrature_decoder_true;
+    uint8_t states[2] = { 0, 0 };
+    uint8_t state_last = 0;
+    double time = 0;
+    unsigned a = 0;
+    unsigned b = 0;
+    bool first = true;
+
+    while (file >> time >> a >> b)
+    {
+        const uint8_t state = ((a & 1) << 1) | (b & 1);
+
+        if (first)
+        {
+            states[0] = state;
+            quadrature_decoder_true.setState(state);
+            first = false;
+        }
+        else
+        {
+            /*
+             *  Generate an edge for each channel that changed.
+             */
+            if ((state ^ state_last) & 0b10)
+            {
+                edges.push_back({ time, 0, 0 });
+            }
+
+            if ((state ^ state_last) & 0b01)
+            {
+                edges.push_back({ time, 0, 1 });
+            }
+
+            quadrature_decoder_true.decode(state, static_cast<uint32_t>(time * 1e6));
+        }
+
+        state_last = state;
+    }
+
+    Result results[2] = { };
+    results[0].steps_true = quadrature_decoder_true.getSteps();
+    feed(edges, states, results);
+
+    std::cout << "Recording " << path << ": " << edges.size() << " edges, true steps "
+            << results[0].steps_true << ", quadrature decoder " << results[0].steps_quadrature
+            << " (" << results[0].transition_errors << " illegal transitions), branching decoder "
+            << results[0].steps_branching << std::endl;
+
+    return true;
+}
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 1;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (argc > 2)
+    {
+        return replay(argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /*
+     *  Sweep the wheel speed up to the maximum wheel speed, in
+     *  both directions, with the left and the right encoders
+     *  turning in opposite directions.
+     */
+    std::mt19937 random_number_generator(SimulatedSensorParameter::seed);
+    bool passed = true;
+
+    std::cout << std::setw(8) << "RPM" << std::setw(12) << "true" << std::setw(12) << "quadrature"
+            << std::setw(10) << "illegal" << std::setw(12) << "branching" << std::endl;
+
+    for (int percent = -100; percent <= 100; percent += 10)
+    {
+        if (percent == 0)
+        {
+            continue;
+        }
+
+        const double rpm = SimulatedEncoderParameter::rpm_max * percent / 100;
+        std::vector<Edge> edges;
+        Result results[2] = { };
+        uint8_t states[2] = { 0, 0 };
+
+        results[0].steps_true = generate(duration, rpm, 0, random_number_generator, edges);
+        results[1].steps_true = generate(duration, -rpm, 1, random_number_generator, edges);
+        std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs)
+        {
+            return lhs.time < rhs.time;
+        });
+        feed(edges, states, results);
+
+        for (const auto& result : results)
+        {
+            std::cout << std::setw(8) << rpm << std::setw(12) << result.steps_true << std::setw(12)
+                    << result.steps_quadrature << std::setw(10) << result.transition_errors
+                    << std::setw(12) << result.steps_branching << std::endl;
+
+            if (result.steps_quadrature != result.steps_true || result.transition_errors != 0)
+            {
+                passed = false;
+            }
+        }
+    }
+
+    std::cout << "Quadrature decoder " << (passed ? "passed" : "FAILED") << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,315 @@
+/**
+ *  @file   scheduler.cpp
+ *  @author Simon Yu
+ *  @date   01/28/2022
+ *  @brief  Rate-monotonic scheduler harness source.
+ *
+ *  This file implements the rate-monotonic scheduler harness. The
+ *  harness first runs synthetic jobs with known periods, phases, and
+ *  execution times on a scheduler against the simulated clock, where
+ *  each job advances the simulated clock by its execution time. It
+ *  verifies the ticks and the order at which the jobs run, the job
+ *  timing statistics, the utilization, and the rejection of invalid
+ *  jobs, and reports the peak execution time per tick with and without
+ *  the phase offsets.
+ *
+ *  It then runs the firmware real-time task, with its jobs registered
+ *  by the real-time task initialization function, against the simulated
+ *  plant, and verifies the number of runs of each job and that the
+ *  Biped stays upright.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-scheduler [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/global.h"
+#include "common/parameter.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "task/task.h"
+#include "utility/math.h"
+#include "utility/rate_monotonic_scheduler.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Synthetic scheduler type, with two job groups.
+ */
+using SyntheticScheduler = RateMonotonicScheduler<8, 2, 64, 10>;
+
+/**
+ *  @brief  Synthetic job struct.
+ *
+ *  This struct contains the parameters of a synthetic job,
+ *  as well as the ticks at which it ran.
+ */
+struct SyntheticJob
+{
+    const char* name;   //!< Job name.
+    uint32_t divisor;   //!< Job period, in ticks.
+    uint32_t phase; //!< Job phase, in ticks.
+    size_t group;   //!< Job group index.
+    uint32_t execution_time;    //!< Execution time, in microseconds.
+    std::vector<uint32_t> ticks;    //!< Ticks at which the job ran.
+};
+
+/*
+ *  Current tick of the synthetic scheduler and the divisors
+ *  of the jobs in their running order within the tick.
+ */
+static uint32_t tick_ = 0;  //!< Current tick.
+static std::vector<uint32_t> divisors_tick_;    //!< Divisors of the jobs run in the current tick.
+static bool ordered_ = true;    //!< Whether all ticks ran their jobs in the rate-monotonic order.
+
+/**
+ *  @param  argument Synthetic job struct pointer.
+ *  @brief  Synthetic job function.
+ *
+ *  This function records the current tick, checks the rate-monotonic
+ *  order, and advances the simulated clock by the execution time of
+ *  the job.
+ */
+static void
+runSyntheticJob(void* argument)
+{
+    SyntheticJob& job = *static_cast<SyntheticJob*>(argument);
+
+    if (!divisors_tick_.empty() && divisors_tick_.back() > job.divisor)
+    {
+        ordered_ = false;
+    }
+
+    divisors_tick_.push_back(job.divisor);
+    job.ticks.push_back(tick_);
+    Clock::advance(job.execution_time);
+}
+
+/**
+ *  @param  jobs Synthetic job structs.
+ *  @param  ticks Number of ticks.
+ *  @param  phased Whether to apply the phase offsets.
+ *  @param  peak Peak execution time per tick, in microseconds.
+ *  @return Whether the synthetic scheduler passed the verification.
+ *  @brief  Run and verify the synthetic scheduler.
+ *
+ *  This function registers the given jobs on a synthetic scheduler,
+ *  runs the given number of ticks, and verifies the ticks, the order,
+ *  and the timing statistics of the jobs.
+ */
+static bool
+runSynthetic(std::vector<SyntheticJob>& jobs, const uint32_t& ticks, const bool& phased,
+        uint32_t& peak)
+{
+    SyntheticScheduler scheduler(&micros);
+    bool passed = true;
+    peak = 0;
+    ordered_ = true;
+
+    for (auto& job : jobs)
+    {
+        job.ticks.clear();
+        passed &= scheduler.registerJob(job.name, &runSyntheticJob, &job, job.divisor,
+                phased ? job.phase : 0, job.group);
+    }
+
+    for (tick_ = 0; tick_ < ticks; tick_ ++)
+    {
+        divisors_tick_.clear();
+        scheduler.tick();
+        peak = std::max(peak, scheduler.getExecutionTime(0) + scheduler.getExecutionTime(1));
+    }
+
+    /*
+     *  Verify that every job ran exactly at the ticks of its
+     *  period and phase, with the expected timing statistics.
+     */
+    for (size_t index = 0; index < scheduler.getJobCount(); index ++)
+    {
+        for (const auto& job : jobs)
+        {
+            if (job.name != scheduler.getJobName(index))
+            {
+                continue;
+            }
+
+            const uint32_t phase = phased ? job.phase : 0;
+            const TimingStatistics timing_statistics = scheduler.getJobStatistics(index);
+            bool ticks_correct = job.ticks.size()
+                    == (ticks - phase + job.divisor - 1) / job.divisor;
+
+            for (size_t i = 0; i < job.ticks.size() && ticks_correct; i ++)
+            {
+                ticks_correct = job.ticks[i] == phase + i * job.divisor;
+            }
+
+            passed &= ticks_correct && timing_statistics.count == job.ticks.size()
+                    && timing_statistics.mean == job.execution_time
+                    && timing_statistics.maximum == job.execution_time;
+        }
+    }
+
+    /*
+     *  Verify the utilization against the execution times over
+     *  the periods.
+     */
+    const double period = secondsToMicroseconds(PeriodParameter::fast);
+    double utilization = 0;
+
+    for (const auto& job : jobs)
+    {
+        utilization += job.execution_time / (job.divisor * period);
+    }
+
+    return passed && ordered_ && scheduler.getTick() == ticks
+            && std::fabs(scheduler.getUtilization(period) - utilization) < 1e-9;
+}
+
+/**
+ *  @return Whether the synthetic scheduler passed the verification.
+ *  @brief  Verify the synthetic scheduler.
+ *
+ *  This function runs synthetic jobs, registered out of the
+ *  rate-monotonic order, with and without phase offsets, and
+ *  verifies that invalid jobs are rejected.
+ */
+static bool
+verifySynthetic()
+{
+    std::vector<SyntheticJob> jobs = {
+            { "slow A", 8, 0, 1, 300, { } },
+            { "fast", 1, 0, 0, 100, { } },
+            { "medium", 4, 1, 1, 150, { } },
+            { "slow B", 8, 4, 1, 300, { } },
+            { "fast last", 1, 0, 0, 50, { } } };
+    const uint32_t ticks = 803;
+    uint32_t peak_phased = 0;
+    uint32_t peak_unphased = 0;
+
+    bool passed = runSynthetic(jobs, ticks, true, peak_phased);
+    passed &= runSynthetic(jobs, ticks, false, peak_unphased);
+
+    /*
+     *  Verify that invalid jobs are rejected.
+     */
+    SyntheticScheduler scheduler(&micros);
+    SyntheticJob job = { "invalid", 1, 0, 0, 0, { } };
+    const bool rejected = !scheduler.registerJob(job.name, nullptr, &job, 1, 0, 0)
+            && !scheduler.registerJob(job.name, &runSyntheticJob, &job, 0, 0, 0)
+            && !scheduler.registerJob(job.name, &runSyntheticJob, &job, 4, 4, 0)
+            && !scheduler.registerJob(job.name, &runSyntheticJob, &job, 1, 0, 2);
+
+    for (size_t i = 0; i < 8; i ++)
+    {
+        passed &= scheduler.registerJob(job.name, &runSyntheticJob, &job, 1, 0, 0);
+    }
+
+    passed &= rejected && !scheduler.registerJob(job.name, &runSyntheticJob, &job, 1, 0, 0);
+
+    std::cout << "Synthetic peak execution time per tick: " << peak_phased
+            << " us with phase offsets, " << peak_unphased << " us without" << std::endl;
+
+    return passed && peak_phased < peak_unphased;
+}
+
+/**
+ *  @param  duration Simulated duration, in seconds.
+ *  @return Whether the real-time task passed the verification.
+ *  @brief  Verify the firmware real-time task.
+ *
+ *  This function runs the firmware real-time task iterations
+ *  against the simulated plant, and verifies the number of runs
+ *  of each real-time task job.
+ */
+static bool
+verifyRealTimeTask(const double& duration)
+{
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    realTimeTaskInitialization();
+
+    const uint32_t ticks = static_cast<uint32_t>(duration / PeriodParameter::fast);
+    double attitude_y_peak = 0;
+
+    for (uint32_t i = 0; i < ticks; i ++)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+        attitude_y_peak = std::max(attitude_y_peak, std::fabs(plant_->getAttitudeY()));
+    }
+
+    /*
+     *  Print the real-time task jobs in their rate-monotonic
+     *  priority order and verify their numbers of runs.
+     */
+    bool passed = scheduler_real_time_task_.getJobCount() == 5;
+
+    std::cout << std::setw(24) << "Job" << std::setw(10) << "divisor" << std::setw(10)
+            << "runs" << std::endl;
+
+    for (size_t index = 0; index < scheduler_real_time_task_.getJobCount(); index ++)
+    {
+        const uint32_t divisor = scheduler_real_time_task_.getJobDivisor(index);
+        const unsigned long long count = scheduler_real_time_task_.getJobStatistics(index).count;
+
+        std::cout << std::setw(24) << scheduler_real_time_task_.getJobName(index)
+                << std::setw(10) << divisor << std::setw(10) << count << std::endl;
+        passed &= count >= ticks / divisor && count <= ticks / divisor + 1;
+    }
+
+    std::cout << "Peak Y attitude: " << radiansToDegrees(attitude_y_peak) << " deg" << std::endl;
+
+    return passed && scheduler_real_time_task_.getTick() == ticks && attitude_y_peak < M_PI / 4;
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Rate-monotonic scheduler harness main function.
+ *
+ *  This function verifies the synthetic scheduler and the firmware
+ *  real-time task, and prints the results.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::atof(argv[1]) : 10;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const bool passed_synthetic = verifySynthetic();
+    std::cout << "Synthetic scheduler " << (passed_synthetic ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_real_time_task = verifyRealTimeTask(duration);
+    std::cout << "Real-time task " << (passed_real_time_task ? "passed" : "FAILED") << std::endl;
+
+    return passed_synthetic && passed_real_time_task ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,680 @@
+/**
+ *  @file   schema.cpp
+ *  @author Simon Yu
+ *  @date   01/30/2022
+ *  @brief  Wire schema harness source.
+ *
+ *  This file implements the wire schema harness. The harness first
+ *  verifies the quantization of the telemetry sample, including the
+ *  rounding, the saturation, and values that are not a number. It then
+ *  round-trips random telemetry samples, covering the ranges of their
+ *  entries, through serialization and deserialization, and verifies
+ *  that every quantized entry is within half of its resolution, that
+ *  every single precision entry is within the single precision rounding
+ *  error, and that all other entries are exact.
+ *
+ *  It then runs the firmware real-time task against the simulated plant,
+ *  round-trips the telemetry sample of every tick, and reports the maximum
+ *  error per entry against the sensor, controller, and actuator data. It
+ *  verifies that messages with a different schema version and truncated
+ *  messages are rejected, that parameter messages round-trip exactly,
+ *  that telemetry frames carry exactly the fields of their telemetry
+ *  subscriptions, and reports the bytes per sample of the previous full precision
+ *  sample and of the compact telemetry sample.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-schema [samples] [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "sensor/sensor.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "task/task.h"
+#include "utility/math.h"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Serialization buffer type, large enough for any message.
+ */
+using Buffer = std::array<unsigned char, 2048>;
+
+/**
+ *  @brief  Error struct.
+ *
+ *  This struct contains the maximum absolute round-trip
+ *  errors of the telemetry sample entries.
+ */
+struct Error
+{
+    double acceleration;    //!< Maximum acceleration error, in meters per second squared.
+    double angular_velocity;    //!< Maximum angular velocity error, in radians per second.
+    double attitude_xy; //!< Maximum X and Y attitude error, in radians.
+    double attitude_z;  //!< Maximum Z attitude error, in radians.
+    double position_x;  //!< Maximum X position error, in meters.
+    double pwm; //!< Maximum motor PWM error.
+    double range;   //!< Maximum time-of-flight range error, in meters.
+    double reference;   //!< Maximum controller reference error.
+    double steps;   //!< Maximum encoder steps error.
+    double velocity_x;  //!< Maximum X velocity error, in meters per second.
+
+    /**
+     *  @brief  Error struct constructor
+     *
+     *  This constructor initializes all error struct entries to 0.
+     */
+    Error() : acceleration(0), angular_velocity(0), attitude_xy(0), attitude_z(0),
+            position_x(0), pwm(0), range(0), reference(0), steps(0), velocity_x(0)
+    {
+    }
+};
+
+/**
+ *  @param  maximum Maximum error.
+ *  @param  expected Expected value.
+ *  @param  actual Actual value.
+ *  @brief  Update a maximum error.
+ */
+static void
+updateError(double& maximum, const double& expected, const double& actual)
+{
+    maximum = std::max(maximum, std::fabs(actual - expected));
+}
+
+/**
+ *  @param  value Value.
+ *  @param  actual Round-tripped value.
+ *  @return Whether the round-tripped value is within the single precision rounding error.
+ *  @brief  Check a single precision entry.
+ */
+static bool
+checkFloat(const double& value, const double& actual)
+{
+    return std::fabs(actual - value) <= std::fabs(value) * std::ldexp(1.0, -24);
+}
+
+/**
+ *  @tparam Type Type of the struct.
+ *  @param  object Struct to be serialized.
+ *  @param  buffer Serialization buffer.
+ *  @return Serialized size, in bytes, or 0 if the serialization failed.
+ *  @brief  Serialize a struct into a buffer.
+ */
+template<typename Type>
+static size_t
+serialize(const Type& object, Buffer& buffer)
+{
+    zpp::serializer::memory_view_output_archive serializer(buffer);
+    return serializer(object) ? serializer.offset() : 0;
+}
+
+/**
+ *  @tparam Type Type of the struct.
+ *  @param  buffer Serialization buffer.
+ *  @param  size Serialized size, in bytes.
+ *  @param  object Deserialized struct.
+ *  @return Whether the deserialization succeeded.
+ *  @brief  Deserialize a struct from a buffer.
+ */
+template<typename Type>
+static bool
+deserialize(const Buffer& buffer, const size_t& size, Type& object)
+{
+    zpp::serializer::memory_view_input_archive deserializer(buffer.data(), size);
+    return static_cast<bool>(deserializer(object));
+}
+
+/**
+ *  @param  sample Telemetry sample struct.
+ *  @param  encoder_data Encoder data struct.
+ *  @param  imu_data IMU data struct.
+ *  @param  time_of_flight_data Time-of-flight data struct.
+ *  @param  controller_reference Controller reference struct.
+ *  @param  actuation_command Actuation command struct.
+ *  @param  error Error struct.
+ *  @return Whether all entries are within their bounds.
+ *  @brief  Check a round-tripped telemetry sample.
+ *
+ *  This function compares the entries of the given round-tripped
+ *  telemetry sample against the given source data, updates the
+ *  maximum errors, and checks every entry against its bound.
+ */
+static bool
+check(const TelemetrySample& sample, const EncoderData& encoder_data, const IMUData& imu_data,
+        const TimeOfFlightData& time_of_flight_data,
+        const ControllerReference& controller_reference,
+        const ActuationCommand& actuation_command, Error& error)
+{
+    const EncoderData encoder_data_actual = sample.getEncoderData();
+    const IMUData imu_data_actual = sample.getIMUData();
+    const TimeOfFlightData time_of_flight_data_actual = sample.getTimeOfFlightData();
+    const ControllerReference controller_reference_actual = sample.getControllerReference();
+    const ActuationCommand actuation_command_actual = sample.getActuationCommand();
+    const double bound_acceleration = TelemetrySample::resolution_acceleration / 2 + 1e-12;
+    const double bound_angular_velocity = TelemetrySample::resolution_angular_velocity / 2
+            + 1e-12;
+    const double bound_attitude = TelemetrySample::resolution_attitude / 2 + 1e-12;
+    const double bound_pwm = TelemetrySample::resolution_pwm / 2 + 1e-12;
+    const double bound_range = TelemetrySample::resolution_range / 2 + 1e-12;
+    const double bound_velocity = TelemetrySample::resolution_velocity / 2 + 1e-12;
+
+    updateError(error.acceleration, imu_data.acceleration_x, imu_data_actual.acceleration_x);
+    updateError(error.acceleration, imu_data.acceleration_y, imu_data_actual.acceleration_y);
+    updateError(error.acceleration, imu_data.acceleration_z, imu_data_actual.acceleration_z);
+    updateError(error.angular_velocity, imu_data.angular_velocity_x,
+            imu_data_actual.angular_velocity_x);
+    updateError(error.angular_velocity, imu_data.angular_velocity_y,
+            imu_data_actual.angular_velocity_y);
+    updateError(error.angular_velocity, imu_data.angular_velocity_z,
+            imu_data_actual.angular_velocity_z);
+    updateError(error.attitude_xy, imu_data.attitude_x, imu_data_actual.attitude_x);
+    updateError(error.attitude_xy, imu_data.attitude_y, imu_data_actual.attitude_y);
+    updateError(error.attitude_z, imu_data.attitude_z, imu_data_actual.attitude_z);
+    updateError(error.position_x, encoder_data.position_x, encoder_data_actual.position_x);
+    updateError(error.pwm, actuation_command.motor_left_pwm,
+            actuation_command_actual.motor_left_pwm);
+    updateError(error.pwm, actuation_command.motor_right_pwm,
+            actuation_command_actual.motor_right_pwm);
+    updateError(error.range, time_of_flight_data.range_left,
+            time_of_flight_data_actual.range_left);
+    updateError(error.range, time_of_flight_data.range_middle,
+            time_of_flight_data_actual.range_middle);
+    updateError(error.range, time_of_flight_data.range_right,
+            time_of_flight_data_actual.range_right);
+    updateError(error.reference, controller_reference.attitude_y,
+            controller_reference_actual.attitude_y);
+    updateError(error.reference, controller_reference.attitude_z,
+            controller_reference_actual.attitude_z);
+    updateError(error.reference, controller_reference.position_x,
+            controller_reference_actual.position_x);
+    updateError(error.steps, encoder_data.steps_left, encoder_data_actual.steps_left);
+    updateError(error.steps, encoder_data.steps_right, encoder_data_actual.steps_right);
+    updateError(error.velocity_x, encoder_data.velocity_x, encoder_data_actual.velocity_x);
+
+    return std::fabs(imu_data_actual.acceleration_x - imu_data.acceleration_x) <= bound_acceleration
+            && std::fabs(imu_data_actual.acceleration_y - imu_data.acceleration_y) <= bound_acceleration
+            && std::fabs(imu_data_actual.acceleration_z - imu_data.acceleration_z) <= bound_acceleration
+            && std::fabs(imu_data_actual.angular_velocity_x - imu_data.angular_velocity_x)
+                    <= bound_angular_velocity
+            && std::fabs(imu_data_actual.angular_velocity_y - imu_data.angular_velocity_y)
+                    <= bound_angular_velocity
+            && std::fabs(imu_data_actual.angular_velocity_z - imu_data.angular_velocity_z)
+                    <= bound_angular_velocity
+            && std::fabs(imu_data_actual.attitude_x - imu_data.attitude_x) <= bound_attitude
+            && std::fabs(imu_data_actual.attitude_y - imu_data.attitude_y) <= bound_attitude
+            && checkFloat(imu_data.attitude_z, imu_data_actual.attitude_z)
+            && checkFloat(encoder_data.position_x, encoder_data_actual.position_x)
+            && std::fabs(encoder_data_actual.velocity_x - encoder_data.velocity_x) <= bound_velocity
+            && std::fabs(time_of_flight_data_actual.range_left - time_of_flight_data.range_left)
+                    <= bound_range
+            && std::fabs(time_of_flight_data_actual.range_middle
+                    - time_of_flight_data.range_middle) <= bound_range
+            && std::fabs(time_of_flight_data_actual.range_right - time_of_flight_data.range_right)
+                    <= bound_range
+            && encoder_data_actual.steps_left == encoder_data.steps_left
+            && encoder_data_actual.steps_right == encoder_data.steps_right
+            && encoder_data_actual.steps == std::trunc((encoder_data.steps_left
+                    + encoder_data.steps_right) / 2)
+            && checkFloat(controller_reference.attitude_y, controller_reference_actual.attitude_y)
+            && checkFloat(controller_reference.attitude_z, controller_reference_actual.attitude_z)
+            && checkFloat(controller_reference.position_x, controller_reference_actual.position_x)
+            && actuation_command_actual.motor_enable == actuation_command.motor_enable
+            && actuation_command_actual.motor_left_forward == actuation_command.motor_left_forward
+            && actuation_command_actual.motor_right_forward
+                    == actuation_command.motor_right_forward
+            && std::fabs(actuation_command_actual.motor_left_pwm - actuation_command.motor_left_pwm)
+                    <= bound_pwm
+            && std::fabs(actuation_command_actual.motor_right_pwm
+                    - actuation_command.motor_right_pwm) <= bound_pwm;
+}
+
+/**
+ *  @param  error Error struct.
+ *  @brief  Print the maximum errors.
+ */
+static void
+print(const Error& error)
+{
+    std::cout << std::setw(24) << "Entry" << std::setw(16) << "max error" << std::setw(16)
+            << "resolution" << std::endl;
+    std::cout << std::setw(24) << "acceleration" << std::setw(16) << error.acceleration
+            << std::setw(16) << TelemetrySample::resolution_acceleration << std::endl;
+    std::cout << std::setw(24) << "angular velocity" << std::setw(16)
+            << error.angular_velocity << std::setw(16)
+            << TelemetrySample::resolution_angular_velocity << std::endl;
+    std::cout << std::setw(24) << "attitude X and Y" << std::setw(16) << error.attitude_xy
+            << std::setw(16) << TelemetrySample::resolution_attitude << std::endl;
+    std::cout << std::setw(24) << "attitude Z" << std::setw(16) << error.attitude_z
+            << std::setw(16) << "float" << std::endl;
+    std::cout << std::setw(24) << "position X" << std::setw(16) << error.position_x
+            << std::setw(16) << "float" << std::endl;
+    std::cout << std::setw(24) << "velocity X" << std::setw(16) << error.velocity_x
+            << std::setw(16) << TelemetrySample::resolution_velocity << std::endl;
+    std::cout << std::setw(24) << "encoder steps" << std::setw(16) << error.steps
+            << std::setw(16) << "exact" << std::endl;
+    std::cout << std::setw(24) << "time-of-flight range" << std::setw(16) << error.range
+            << std::setw(16) << TelemetrySample::resolution_range << std::endl;
+    std::cout << std::setw(24) << "controller reference" << std::setw(16) << error.reference
+            << std::setw(16) << "float" << std::endl;
+    std::cout << std::setw(24) << "motor PWM" << std::setw(16) << error.pwm << std::setw(16)
+            << TelemetrySample::resolution_pwm << std::endl;
+}
+
+/**
+ *  @return Whether the quantization passed the verification.
+ *  @brief  Verify the quantization.
+ *
+ *  This function verifies the rounding to the nearest multiple of
+ *  the resolution, the saturation at the range of the 16-bit integer,
+ *  and the quantization of values that are not a number.
+ */
+static bool
+verifyQuantization()
+{
+    const double resolution = TelemetrySample::resolution_attitude;
+    const double maximum = std::numeric_limits<int16_t>::max() * resolution;
+    const double minimum = std::numeric_limits<int16_t>::min() * resolution;
+
+    return TelemetrySample::quantize(0, resolution) == 0
+            && TelemetrySample::quantize(0.26 * resolution, resolution) == 0
+            && TelemetrySample::quantize(0.74 * resolution, resolution) == 1
+            && TelemetrySample::quantize(-0.74 * resolution, resolution) == -1
+            && TelemetrySample::quantize(maximum, resolution)
+                    == std::numeric_limits<int16_t>::max()
+            && TelemetrySample::quantize(minimum, resolution)
+                    == std::numeric_limits<int16_t>::min()
+            && TelemetrySample::quantize(10 * maximum, resolution)
+                    == std::numeric_limits<int16_t>::max()
+            && TelemetrySample::quantize(10 * minimum, resolution)
+                    == std::numeric_limits<int16_t>::min()
+            && TelemetrySample::quantize(std::numeric_limits<double>::infinity(), resolution)
+                    == std::numeric_limits<int16_t>::max()
+            && TelemetrySample::quantize(-std::numeric_limits<double>::infinity(), resolution)
+                    == std::numeric_limits<int16_t>::min()
+            && TelemetrySample::quantize(std::nan(""), resolution) == 0
+            && TelemetrySample::dequantize(TelemetrySample::quantize(M_PI, resolution),
+                    resolution) - M_PI <= resolution / 2;
+}
+
+/**
+ *  @param  samples Number of random samples.
+ *  @return Whether the random samples passed the verification.
+ *  @brief  Verify random telemetry samples.
+ *
+ *  This function round-trips the given number of random telemetry
+ *  samples, with a fixed seed, and verifies their entries.
+ */
+static bool
+verifyRandom(const unsigned long& samples)
+{
+    std::mt19937_64 generator(431);
+    std::uniform_real_distribution<double> acceleration(-60, 60);
+    std::uniform_real_distribution<double> angular_velocity(-30, 30);
+    std::uniform_real_distribution<double> attitude(-M_PI, M_PI);
+    std::uniform_real_distribution<double> position(-1000, 1000);
+    std::uniform_real_distribution<double> pwm(0, 255);
+    std::uniform_real_distribution<double> range(0, 4);
+    std::uniform_real_distribution<double> velocity(-30, 30);
+    std::uniform_int_distribution<int32_t> steps(std::numeric_limits<int32_t>::min(),
+            std::numeric_limits<int32_t>::max());
+    std::uniform_int_distribution<uint32_t> counter;
+    std::bernoulli_distribution flag;
+    Buffer buffer;
+    Error error;
+    bool passed = true;
+
+    for (unsigned long i = 0; i < samples; i ++)
+    {
+        EncoderData encoder_data;
+        IMUData imu_data;
+        TimeOfFlightData time_of_flight_data;
+        ControllerReference controller_reference;
+        ActuationCommand actuation_command;
+
+        encoder_data.position_x = position(generator);
+        encoder_data.steps_left = steps(generator);
+        encoder_data.steps_right = steps(generator);
+        encoder_data.velocity_x = velocity(generator);
+        imu_data.acceleration_x = acceleration(generator);
+        imu_data.acceleration_y = acceleration(generator);
+        imu_data.acceleration_z = acceleration(generator);
+        imu_data.angular_velocity_x = angular_velocity(generator);
+        imu_data.angular_velocity_y = angular_velocity(generator);
+        imu_data.angular_velocity_z = angular_velocity(generator);
+        imu_data.attitude_x = attitude(generator);
+        imu_data.attitude_y = attitude(generator);
+        imu_data.attitude_z = position(generator);
+        time_of_flight_data.range_left = range(generator);
+        time_of_flight_data.range_middle = range(generator);
+        time_of_flight_data.range_right = range(generator);
+        controller_reference.attitude_y = attitude(generator);
+        controller_reference.attitude_z = position(generator);
+        controller_reference.position_x = position(generator);
+        actuation_command.motor_enable = flag(generator);
+        actuation_command.motor_left_forward = flag(generator);
+        actuation_command.motor_right_forward = flag(generator);
+        actuation_command.motor_left_pwm = pwm(generator);
+        actuation_command.motor_right_pwm = pwm(generator);
+
+        TelemetrySample sample;
+        sample.setEncoderData(encoder_data);
+        sample.setIMUData(imu_data);
+        sample.setTimeOfFlightData(time_of_flight_data);
+        sample.setControllerReference(controller_reference);
+        sample.setActuationCommand(actuation_command);
+        sample.tick = counter(generator);
+        sample.timestamp = counter(generator);
+
+        TelemetrySample sample_actual;
+        const size_t size = serialize(sample, buffer);
+
+        passed &= size > 0 && deserialize(buffer, size, sample_actual)
+                && sample_actual.tick == sample.tick
+                && sample_actual.timestamp == sample.timestamp
+                && check(sample_actual, encoder_data, imu_data, time_of_flight_data,
+                        controller_reference, actuation_command, error);
+    }
+
+    std::cout << "Random samples: " << samples << std::endl;
+    print(error);
+
+    return passed;
+}
+
+/**
+ *  @param  duration Simulated duration, in seconds.
+ *  @return Whether the plant samples passed the verification.
+ *  @brief  Verify the telemetry samples of the simulated plant.
+ *
+ *  This function runs the firmware real-time task against the
+ *  simulated plant, round-trips the telemetry sample pushed in
+ *  every tick, and verifies it against the current sensor,
+ *  controller, and actuator data.
+ */
+static bool
+verifyPlant(const double& duration)
+{
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    realTimeTaskInitialization();
+
+    const uint32_t ticks = static_cast<uint32_t>(duration / PeriodParameter::fast);
+    Buffer buffer;
+    Error error;
+    bool passed = true;
+
+    for (uint32_t i = 0; i < ticks; i ++)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+
+        TelemetrySample sample;
+        TelemetrySample sample_actual;
+
+        if (!ring_buffer_telemetry_sample_.pop(sample))
+        {
+            passed = false;
+            continue;
+        }
+
+        const size_t size = serialize(sample, buffer);
+
+        passed &= size > 0 && deserialize(buffer, size, sample_actual) && sample_actual.tick == i
+                && check(sample_actual, sensor_->getEncoderData(), sensor_->getIMUData(),
+                        sensor_->getTimeOfFlightData(), controller_->getControllerReference(), actuator_->getActuationCommand(),
+                        error);
+    }
+
+    std::cout << "Plant samples: " << ticks << std::endl;
+    print(error);
+
+    return passed;
+}
+
+/**
+ *  @return Whether the messages passed the verification.
+ *  @brief  Verify the message headers and the parameter message.
+ *
+ *  This function verifies that status messages and telemetry frames
+ *  with a different schema version and truncated status messages are
+ *  rejected, and that parameter messages round-trip exactly.
+ */
+static bool
+verifyMessages()
+{
+    Buffer buffer;
+    Buffer buffer_actual;
+    StatusMessage status_message;
+    TelemetryFrame frame;
+    bool passed = true;
+
+    status_message.sequence = 431;
+    status_message.temperature = 25;
+    frame.sample_count = 3;
+
+    /*
+     *  Verify the round trip, the rejection of a different schema
+     *  version, and the rejection of a truncated status message.
+     */
+    size_t size = serialize(status_message, buffer);
+    passed &= size > 0 && deserialize(buffer, size, status_message)
+            && status_message.sequence == 431 && status_message.temperature == 25;
+
+    buffer[1] = MessageHeader::version_current + 1;
+    passed &= !deserialize(buffer, size, status_message);
+
+    buffer[1] = MessageHeader::version_current;
+    passed &= !deserialize(buffer, size - 1, status_message);
+
+    size = serialize(frame, buffer);
+    buffer[1] = MessageHeader::version_current + 1;
+    passed &= size > 0 && !deserialize(buffer, size, frame);
+
+    /*
+     *  Verify the exact round trip of a parameter message with
+     *  non-default controller parameters.
+     */
+    ParameterMessage parameter_message;
+    ParameterMessage parameter_message_actual;
+
+    parameter_message.sequence = 7;
+    parameter_message.controller_parameter.pid_controller_gain_attitude_y.proportional = 1.0 / 3;
+    parameter_message.controller_parameter.pid_controller_gain_position_x.integral = -M_PI;
+
+    size = serialize(parameter_message, buffer);
+    passed &= size > 0 && deserialize(buffer, size, parameter_message_actual)
+            && serialize(parameter_message_actual, buffer_actual) == size
+            && std::equal(buffer.begin(), buffer.begin() + size, buffer_actual.begin());
+
+    return passed;
+}
+
+/**
+ *  @return Whether the telemetry frames passed the verification.
+ *  @brief  Verify the telemetry frames with telemetry subscriptions.
+ *
+ *  This function round-trips telemetry frames of random samples,
+ *  with random telemetry subscriptions, and verifies that every field
+ *  that the telemetry subscription includes at the tick of a sample
+ *  is exact, that every other field is 0, and that invalid telemetry
+ *  subscriptions are rejected.
+ */
+static bool
+verifySubscription()
+{
+    std::mt19937_64 generator(431);
+    std::uniform_int_distribution<uint32_t> mask(0, TelemetrySubscription::field_mask_all);
+    std::uniform_int_distribution<unsigned> divisor(1, 10);
+    std::uniform_int_distribution<unsigned> byte(0, 255);
+    Buffer buffer;
+    bool passed = true;
+
+    for (unsigned long i = 0; i < 1000; i ++)
+    {
+        TelemetryFrame frame;
+        TelemetryFrame frame_actual;
+
+        frame.subscription.field_mask = mask(generator);
+        frame.sample_count = TelemetryParameter::sample_count_frame;
+
+        for (auto& divisor_field : frame.subscription.divisors)
+        {
+            divisor_field = divisor(generator);
+        }
+
+        for (uint32_t j = 0; j < frame.sample_count; j ++)
+        {
+            unsigned char* pointer = reinterpret_cast<unsigned char*>(&frame.samples[j]);
+
+            for (size_t k = 0; k < sizeof(TelemetrySample); k ++)
+            {
+                pointer[k] = byte(generator);
+            }
+
+            frame.samples[j].tick = static_cast<uint32_t>(i * frame.sample_count + j);
+        }
+
+        const size_t size = serialize(frame, buffer);
+        passed &= size > 0 && deserialize(buffer, size, frame_actual)
+                && frame_actual.subscription.field_mask == frame.subscription.field_mask;
+
+        for (uint32_t j = 0; passed && j < frame.sample_count; j ++)
+        {
+            const TelemetrySample& sample = frame.samples[j];
+            const TelemetrySample& sample_actual = frame_actual.samples[j];
+            passed &= sample_actual.tick == sample.tick;
+
+            for (size_t field = 0; field < TelemetrySubscription::field_count; field ++)
+            {
+                const TelemetryField telemetry_field = static_cast<TelemetryField>(field);
+                const bool equal = sample_actual.getField(telemetry_field)
+                        == sample.getField(telemetry_field)
+                        || std::isnan(sample.getField(telemetry_field));
+
+                passed &= frame.subscription.includes(field, sample.tick) ? equal :
+                        sample_actual.getField(telemetry_field) == 0;
+            }
+        }
+    }
+
+    /*
+     *  Verify that telemetry subscriptions with unknown fields or
+     *  zero divisors are rejected on both ends.
+     */
+    TelemetryFrame frame;
+    frame.subscription.field_mask = TelemetrySubscription::field_mask_all + 1;
+    passed &= serialize(frame, buffer) == 0;
+
+    frame.subscription.field_mask = TelemetrySubscription::field_mask_all;
+    frame.subscription.divisors[0] = 0;
+    passed &= serialize(frame, buffer) == 0;
+
+    return passed;
+}
+
+/**
+ *  @return Whether the compact telemetry sample is at least three times smaller.
+ *  @brief  Compare the bytes per sample.
+ *
+ *  This function compares the serialized size of the previous full
+ *  precision sample, i.e., the full sensor, controller reference, and
+ *  actuation command structs, to that of the compact telemetry sample.
+ */
+static bool
+compareSize()
+{
+    Buffer buffer;
+    zpp::serializer::memory_view_output_archive serializer(buffer);
+    const uint32_t tick = 0;
+    const uint32_t timestamp = 0;
+
+    if (!serializer(ActuationCommand(), ControllerReference(), EncoderData(), IMUData(), tick,
+            timestamp))
+    {
+        return false;
+    }
+
+    const size_t size_full = serializer.offset();
+    const size_t size_compact = serialize(TelemetrySample(), buffer);
+
+    std::cout << "Bytes per sample: " << size_full << " full, " << size_compact << " compact, "
+            << static_cast<double>(size_full) / size_compact << " times smaller" << std::endl;
+
+    return size_compact > 0 && size_full >= 3 * size_compact;
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Wire schema harness main function.
+ *
+ *  This function verifies the quantization, the random and the
+ *  plant telemetry samples, the messages, the telemetry subscriptions,
+ *  and the bytes per sample, and prints the results.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const double duration = argc > 2 ? std::atof(argv[2]) : 20;
+
+    if (samples == 0 || duration <= 0)
+    {
+        std::cerr << "Invalid number of samples or duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const bool passed_quantization = verifyQuantization();
+    std::cout << "Quantization " << (passed_quantization ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_random = verifyRandom(samples);
+    std::cout << "Random samples " << (passed_random ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_plant = verifyPlant(duration);
+    std::cout << "Plant samples " << (passed_plant ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_messages = verifyMessages();
+    std::cout << "Messages " << (passed_messages ? "passed" : "FAILED") << std::endl;
+
+    const bool passed_subscription = verifySubscription();
+    std::cout << "Telemetry subscriptions " << (passed_subscription ? "passed" : "FAILED")
+            << std::endl;
+
+    const bool passed_size = compareSize();
+    std::cout << "Bytes per sample " << (passed_size ? "passed" : "FAILED") << std::endl;
+
+    return passed_quantization && passed_random && passed_plant && passed_messages
+            && passed_subscription && passed_size ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,295 @@
+/**
+ *  @file   sensor.cpp
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated sensor class source.
+ *
+ *  This file implements the simulated sensor class.
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <cmath>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "sensor/sensor.h"
+#include "simulator/parameter.h"
+#include "simulator/plant.h"
+#include "utility/math.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+Sensor::Sensor() : noise_acceleration_(0, SimulatedSensorParameter::acceleration_noise),
+        noise_angular_velocity_(0, SimulatedSensorParameter::angular_velocity_noise),
+        random_number_generator_(SimulatedSensorParameter::seed), position_left_last_(0),
+        position_right_last_(0), timestamp_last_(0), timestamp_step_left_(0),
+        timestamp_step_right_(0)
+{
+    /*
+     *  Configure the velocity estimators and the velocity
+     *  low-pass filter, same as the encoder.
+     */
+    velocity_estimator_left_.setTimeout(
+            secondsToMicroseconds(EncoderParameter::velocity_timeout));
+    velocity_estimator_right_.setTimeout(
+            secondsToMicroseconds(EncoderParameter::velocity_timeout));
+    low_pass_filter_velocity_x_.setBeta(EncoderParameter::low_pass_filter_beta);
+
+    /*
+     *  Configure the accelerometer and gyroscope biquad filter
+     *  bank, same as the IMU.
+     */
+    constexpr BiquadCoefficients coefficients_acceleration = BiquadCoefficients::lowPass(
+            IMUParameter::acceleration_cutoff, 1 / PeriodParameter::fast,
+            IMUParameter::quality_factor);
+    constexpr BiquadCoefficients coefficients_angular_velocity = BiquadCoefficients::lowPass(
+            IMUParameter::angular_velocity_cutoff, 1 / PeriodParameter::fast,
+            IMUParameter::quality_factor);
+
+    for (size_t channel = 0; channel < IMUParameter::channel_count; channel ++)
+    {
+        biquad_filter_bank_imu_.setCoefficients(0, channel,
+                channel < IMUParameter::channel_count / 2 ? coefficients_acceleration :
+                        coefficients_angular_velocity);
+    }
+
+    /*
+     *  Configure the attitude estimator, same as the IMU.
+     */
+    attitude_estimator_.setGains(AttitudeEstimatorParameter::gain_proportional,
+            AttitudeEstimatorParameter::gain_integral);
+
+    /*
+     *  Initialize the attitude from the gravity direction of the
+     *  simulated plant, as the IMU does from its first accelerometer
+     *  reading.
+     */
+    if (plant_)
+    {
+        imu_data_.attitude_y = plant_->getAttitudeY();
+        attitude_estimator_.initialize(
+                TypeParameter::Scalar(-std::sin(imu_data_.attitude_y)), TypeParameter::Scalar(0),
+                TypeParameter::Scalar(std::cos(imu_data_.attitude_y)));
+    }
+}
+
+EncoderData
+Sensor::getEncoderData() const
+{
+    /*
+     *  Return the class member encoder data struct.
+     */
+    return encoder_data_;
+}
+
+IMUData
+Sensor::getIMUData() const
+{
+    /*
+     *  Return the class member IMU data struct.
+     */
+    return imu_data_;
+}
+
+TimeOfFlightData
+Sensor::getTimeOfFlightData() const
+{
+    /*
+     *  Return the class member time-of-flight data struct.
+     */
+    return time_of_flight_data_;
+}
+
+void
+Sensor::sense(const bool& fast_domain)
+{
+    if (fast_domain)
+    {
+        senseEncoder();
+        senseIMU();
+    }
+    else
+    {
+        senseTimeOfFlight();
+    }
+}
+
+void
+Sensor::senseEncoder()
+{
+    /*
+     *  Validate the simulated plant, and sample the encoders.
+     */
+    if (plant_)
+    {
+        readEncoder();
+    }
+}
+
+void
+Sensor::senseIMU()
+{
+    /*
+     *  Validate the simulated plant, and sample the IMU.
+     */
+    if (plant_)
+    {
+        readIMU();
+    }
+}
+
+void
+Sensor::senseTimeOfFlight()
+{
+    /*
+     *  Validate the simulated plant.
+     */
+    if (!plant_)
+    {
+        return;
+    }
+
+    /*
+     *  Populate the time-of-flight data struct with a wall in
+     *  front and constant ranges to the left and right.
+     */
+    time_of_flight_data_.range_left = PlantParameter::range_side;
+    time_of_flight_data_.range_middle = std::fmax(
+            PlantParameter::range_wall - plant_->getPositionX(), 0);
+    time_of_flight_data_.range_right = PlantParameter::range_side;
+}
+
+long
+Sensor::quantizeSteps(const double& position, double& position_last, uint32_t& timestamp_step)
+{
+    /*
+     *  Quantize the wheel positions into encoder steps.
+     */
+    const double steps_exact = position * EncoderParameter::steps_per_meter;
+    const double steps_exact_last = position_last * EncoderParameter::steps_per_meter;
+    const long steps = std::lround(steps_exact);
+    const long steps_last = std::lround(steps_exact_last);
+    position_last = position;
+
+    /*
+     *  Interpolate the time at which the wheel crossed the boundary
+     *  of the last step, halfway between the steps.
+     */
+    if (steps != steps_last)
+    {
+        const double boundary = steps + (steps > steps_last ? -0.5 : 0.5);
+        const double fraction = (steps_exact - boundary) / (steps_exact - steps_exact_last);
+        timestamp_step = micros() - static_cast<uint32_t>(fraction * (micros() - timestamp_last_));
+    }
+
+    return steps;
+}
+
+void
+Sensor::readEncoder()
+{
+    /*
+     *  Quantize the wheel positions into encoder steps, along
+     *  with the timestamps of the last steps.
+     */
+    const long steps_left = quantizeSteps(plant_->getPositionLeft(), position_left_last_,
+            timestamp_step_left_);
+    const long steps_right = quantizeSteps(plant_->getPositionRight(), position_right_last_,
+            timestamp_step_right_);
+    const uint32_t timestamp = micros();
+    timestamp_last_ = timestamp;
+
+    /*
+     *  Populate the encoder data struct.
+     */
+    encoder_data_.steps_left = steps_left;
+    encoder_data_.steps_right = steps_right;
+    encoder_data_.steps = (steps_left + steps_right) / 2;
+    encoder_data_.position_x = encoder_data_.steps / EncoderParameter::steps_per_meter;
+
+    /*
+     *  Estimate the X velocity from the timestamps of the steps,
+     *  the same way as the encoder does.
+     */
+    const TypeParameter::Scalar velocity_left = velocity_estimator_left_.estimate(steps_left,
+            timestamp_step_left_, timestamp);
+    const TypeParameter::Scalar velocity_right = velocity_estimator_right_.estimate(steps_right,
+            timestamp_step_right_, timestamp);
+    encoder_data_.velocity_x = static_cast<double>(low_pass_filter_velocity_x_.filter(
+            (velocity_left + velocity_right) / TypeParameter::Scalar(2)
+                    / TypeParameter::Scalar(EncoderParameter::steps_per_meter)));
+}
+
+void
+Sensor::readIMU()
+{
+    /*
+     *  Populate the accelerometer and gyroscope data from the
+     *  simulated plant with added noise. A positive Y attitude
+     *  tilts gravity towards the negative X axis of the IMU.
+     */
+    const double attitude_y = plant_->getAttitudeY();
+    imu_data_.acceleration_x = -PlantParameter::gravity * std::sin(attitude_y)
+            + plant_->getAccelerationX() * std::cos(attitude_y)
+            + noise_acceleration_(random_number_generator_);
+    imu_data_.acceleration_y = noise_acceleration_(random_number_generator_);
+    imu_data_.acceleration_z = PlantParameter::gravity * std::cos(attitude_y)
+            + noise_acceleration_(random_number_generator_);
+    imu_data_.angular_velocity_x = noise_angular_velocity_(random_number_generator_);
+    imu_data_.angular_velocity_y = plant_->getAngularVelocityY()
+            + noise_angular_velocity_(random_number_generator_);
+    imu_data_.angular_velocity_z = plant_->getAngularVelocityZ()
+            + noise_angular_velocity_(random_number_generator_);
+
+    /*
+     *  Filter the accelerometer and gyroscope data in a single
+     *  pass using the biquad filter bank, the same way as the IMU does.
+     */
+    TypeParameter::Scalar data[IMUParameter::channel_count] = {
+            TypeParameter::Scalar(imu_data_.acceleration_x),
+            TypeParameter::Scalar(imu_data_.acceleration_y),
+            TypeParameter::Scalar(imu_data_.acceleration_z),
+            TypeParameter::Scalar(imu_data_.angular_velocity_x),
+            TypeParameter::Scalar(imu_data_.angular_velocity_y),
+            TypeParameter::Scalar(imu_data_.angular_velocity_z) };
+    biquad_filter_bank_imu_.filter(data);
+    imu_data_.acceleration_x = static_cast<double>(data[0]);
+    imu_data_.acceleration_y = static_cast<double>(data[1]);
+    imu_data_.acceleration_z = static_cast<double>(data[2]);
+    imu_data_.angular_velocity_x = static_cast<double>(data[3]);
+    imu_data_.angular_velocity_y = static_cast<double>(data[4]);
+    imu_data_.angular_velocity_z = static_cast<double>(data[5]);
+
+    /*
+     *  Estimate the attitudes and the gyroscope biases using the
+     *  attitude estimator, the same way as the IMU does.
+     */
+    attitude_estimator_.update(TypeParameter::Scalar(imu_data_.angular_velocity_x),
+            TypeParameter::Scalar(imu_data_.angular_velocity_y),
+            TypeParameter::Scalar(imu_data_.angular_velocity_z),
+            TypeParameter::Scalar(imu_data_.acceleration_x),
+            TypeParameter::Scalar(imu_data_.acceleration_y),
+            TypeParameter::Scalar(imu_data_.acceleration_z),
+            TypeParameter::Scalar(PeriodParameter::fast));
+    imu_data_.attitude_x = static_cast<double>(attitude_estimator_.getAttitudeX());
+    imu_data_.attitude_y = static_cast<double>(attitude_estimator_.getAttitudeY());
+    imu_data_.attitude_z = static_cast<double>(attitude_estimator_.getAttitudeZ());
+    imu_data_.angular_velocity_bias_x = static_cast<double>(attitude_estimator_.getBiasX());
+    imu_data_.angular_velocity_bias_y = static_cast<double>(attitude_estimator_.getBiasY());
+    imu_data_.angular_velocity_bias_z = static_cast<double>(attitude_estimator_.getBiasZ());
+}
+}   // namespace firmware
+}   // namespace biped
@@ -0,0 +1,186 @@
+/**
+ *  @file   sensor.h
+ *  @author Simon Yu
+ *  @date   01/12/2022
+ *  @brief  Simulated sensor class header.
+ *
+ *  This file defines the simulated sensor class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef SENSOR_SENSOR_H_
+#define SENSOR_SENSOR_H_
+
+/*
+ *  External headers.
+ */
+#include <random>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "common/type.h"
+#include "utility/attitude_estimator.hpp"
+#include "utility/biquad_filter_bank.hpp"
+#include "utility/low_pass_filter.hpp"
+#include "utility/velocity_estimator.hpp"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Simulated sensor class.
+ *
+ *  This class mirrors the sensor class. Instead of reading
+ *  the hardware, the simulated sensor samples the simulated
+ *  plant, quantizes the wheel positions into encoder steps,
+ *  timestamped by interpolating the wheel positions between
+ *  samples, and adds noise to the IMU data.
+ */
+class Sensor
+{
+public:
+
+    /**
+     *  @brief  Simulated sensor class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    Sensor();
+
+    /**
+     *  @return Encoder data struct.
+     *  @brief  Get the encoder data struct.
+     *
+     *  This function returns the class member encoder data struct.
+     */
+    EncoderData
+    getEncoderData() const;
+
+    /**
+     *  @return IMU data struct.
+     *  @brief  Get the IMU data struct.
+     *
+     *  This function returns the class member IMU data struct.
+     */
+    IMUData
+    getIMUData() const;
+
+    /**
+     *  @return Time-of-flight data struct.
+     *  @brief  Get the class member time-of-flight data struct.
+     *
+     *  This function returns the class member time-of-flight data struct.
+     */
+    TimeOfFlightData
+    getTimeOfFlightData() const;
+
+    /**
+     *  @param  fast_domain Whether to perform fast domain sensing.
+     *  @brief  Sensor data acquisition function.
+     *
+     *  This function samples the simulated plant, for fast or slow
+     *  domain, using the sensing functions below. This function is
+     *  expected to be called periodically.
+     */
+    void
+    sense(const bool& fast_domain);
+
+    /**
+     *  @brief  Encoder sensing function.
+     *
+     *  This function samples the simulated wheel positions into the
+     *  encoder data struct.
+     */
+    void
+    senseEncoder();
+
+    /**
+     *  @brief  IMU sensing function.
+     *
+     *  This function samples the simulated IMU into the IMU data struct.
+     */
+    void
+    senseIMU();
+
+    /**
+     *  @brief  Time-of-flight sensing function.
+     *
+     *  This function populates the time-of-flight data struct.
+     */
+    void
+    senseTimeOfFlight();
+
+private:
+
+    /**
+     *  @param  position Wheel position, in meters.
+     *  @param  position_last Wheel position at the last sample, in meters.
+     *  @param  timestamp_step Timestamp of the last step, in microseconds.
+     *  @return Encoder steps.
+     *  @brief  Quantize a wheel position into encoder steps.
+     *
+     *  This function quantizes the given wheel position into encoder
+     *  steps. If the steps changed since the last sample, the function
+     *  updates the timestamp of the last step by linearly interpolating
+     *  the time at which the wheel crossed the last step, as the encoder
+     *  interrupt handlers would have timestamped it. The function then
+     *  updates the wheel position at the last sample.
+     */
+    long
+    quantizeSteps(const double& position, double& position_last, uint32_t& timestamp_step);
+
+    /**
+     *  @brief  Sample the encoders.
+     *
+     *  This function quantizes the simulated wheel positions into
+     *  encoder steps, populates the encoder data struct, and
+     *  estimates the X velocity from the timestamps of the steps,
+     *  the same way as the encoder does.
+     */
+    void
+    readEncoder();
+
+    /**
+     *  @brief  Sample the IMU.
+     *
+     *  This function populates the IMU data struct from the
+     *  simulated plant with added noise, filtered by the biquad filter
+     *  bank, the same way as the IMU does. The attitudes and the gyroscope
+     *  biases are estimated using the attitude estimator, the same way
+     *  as the IMU does.
+     */
+    void
+    readIMU();
+
+    EncoderData encoder_data_;  //!< Encoder data struct.
+    IMUData imu_data_;  //!< IMU data struct.
+    TimeOfFlightData time_of_flight_data_;  //!< Time-of-flight data struct.
+    AttitudeEstimator<TypeParameter::Scalar> attitude_estimator_;   //!< Attitude estimator.
+    BiquadFilterBank<TypeParameter::Scalar, IMUParameter::channel_count, 1> biquad_filter_bank_imu_; //!< Accelerometer and gyroscope biquad filter bank.
+    LowPassFilter<TypeParameter::Scalar> low_pass_filter_velocity_x_;  //!< X velocity low-pass filter.
+    std::normal_distribution<double> noise_acceleration_;   //!< Accelerometer noise distribution.
+    std::normal_distribution<double> noise_angular_velocity_;   //!< Gyroscope noise distribution.
+    std::mt19937 random_number_generator_;  //!< Noise random number generator.
+    VelocityEstimator<TypeParameter::Scalar> velocity_estimator_left_;  //!< Left encoder velocity estimator.
+    VelocityEstimator<TypeParameter::Scalar> velocity_estimator_right_; //!< Right encoder velocity estimator.
+    double position_left_last_; //!< Left wheel position at the last sample, in meters.
+    double position_right_last_;    //!< Right wheel position at the last sample, in meters.
+    uint32_t timestamp_last_;   //!< Timestamp of the last sample, in microseconds.
+    uint32_t timestamp_step_left_;  //!< Timestamp of the last left encoder step, in microseconds.
+    uint32_t timestamp_step_right_; //!< Timestamp of the last right encoder step, in microseconds.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // SENSOR_SENSOR_H_
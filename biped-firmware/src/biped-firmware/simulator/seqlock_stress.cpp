@@ -0,0 +1,269 @@
+/**
+ *  @file   seqlock_stress.cpp
+ *  @author Simon Yu
+ *  @date   01/21/2022
+ *  @brief  Sequence lock stress harness source.
+ *
+ *  This file implements the sequence lock stress harness. The
+ *  harness publishes data through a sequence lock from a single
+ *  writer thread as fast as possible, while multiple reader threads
+ *  continuously read snapshots and check that every snapshot is
+ *  coherent, i.e., all of its entries come from the same write, and
+ *  that the snapshots never go backwards. It then repeats the check
+ *  through the controller, with two threads setting the controller
+ *  reference, as the planner and the network tasks do, while another
+ *  thread executes the controller and reads the controller reference.
+ *
+ *  The harness exits with failure on the first torn or stale snapshot.
+ *
+ *  Usage: biped-seqlock-stress [duration] [reader count]
+ */
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "utility/seqlock.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @brief  Stress payload struct.
+ *
+ *  This struct contains a number of words, all of which are set
+ *  to the same value by every write, such that a torn snapshot
+ *  is detected by comparing the words.
+ */
+struct Payload
+{
+    uint64_t words[64]; //!< Payload words.
+};
+
+/**
+ *  @param  duration Stress duration, in seconds.
+ *  @param  reader_count Number of reader threads.
+ *  @return Whether all snapshots were coherent.
+ *  @brief  Stress the sequence lock.
+ *
+ *  This function stresses the sequence lock with a single writer
+ *  thread and the given number of reader threads.
+ */
+bool
+stressSeqlock(const double& duration, const unsigned& reader_count)
+{
+    Seqlock<Payload> seqlock;
+    std::atomic<bool> done(false);
+    std::atomic<bool> failed(false);
+    std::atomic<uint64_t> read_count(0);
+    uint64_t write_count = 0;
+    std::vector<std::thread> readers;
+
+    for (unsigned i = 0; i < reader_count; i ++)
+    {
+        readers.emplace_back([&]()
+        {
+            uint64_t value_last = 0;
+            uint64_t count = 0;
+
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const Payload payload = seqlock.read();
+                count ++;
+
+                for (const auto& word : payload.words)
+                {
+                    if (word != payload.words[0])
+                    {
+                        std::cerr << "Torn snapshot: " << payload.words[0] << " and " << word
+                                << "." << std::endl;
+                        failed = true;
+                        break;
+                    }
+                }
+
+                if (payload.words[0] < value_last)
+                {
+                    std::cerr << "Stale snapshot: " << payload.words[0] << " after " << value_last
+                            << "." << std::endl;
+                    failed = true;
+                }
+
+                value_last = payload.words[0];
+            }
+
+            read_count += count;
+        });
+    }
+
+    /*
+     *  Write from the main thread until the duration elapses.
+     */
+    const auto start = std::chrono::steady_clock::now();
+    Payload payload;
+
+    while (!failed && std::chrono::steady_clock::now() - start < std::chrono::duration<double>(duration))
+    {
+        write_count ++;
+
+        for (auto& word : payload.words)
+        {
+            word = write_count;
+        }
+
+        seqlock.write(payload);
+    }
+
+    done = true;
+
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    std::cout << "Sequence lock: " << write_count << " writes, " << read_count << " reads, "
+            << (failed ? "FAILED" : "passed") << std::endl;
+
+    return !failed;
+}
+
+/**
+ *  @param  duration Stress duration, in seconds.
+ *  @return Whether all snapshots were coherent.
+ *  @brief  Stress the controller reference.
+ *
+ *  This function stresses the controller reference with two setter
+ *  threads, a controller execution thread, and a reader thread.
+ */
+bool
+stressController(const double& duration)
+{
+    BasicController<TypeParameter::Scalar> controller;
+    std::atomic<bool> done(false);
+    std::atomic<bool> failed(false);
+    std::atomic<uint64_t> write_count(0);
+    uint64_t read_count = 0;
+    uint64_t control_count = 0;
+    std::vector<std::thread> threads;
+
+    controller.setPeriod(PeriodParameter::fast, true);
+    controller.setPeriod(PeriodParameter::slow, false);
+
+    /*
+     *  Set the controller reference from two threads, with all
+     *  entries set to the same value by every set.
+     */
+    for (unsigned i = 0; i < 2; i ++)
+    {
+        threads.emplace_back([&]()
+        {
+            ControllerReference controller_reference;
+
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const double value = static_cast<double>(++ write_count);
+                controller_reference.attitude_y = value;
+                controller_reference.attitude_z = value;
+                controller_reference.position_x = value;
+                controller.setControllerReference(controller_reference);
+            }
+        });
+    }
+
+    /*
+     *  Execute the controller, alternating between the fast and
+     *  slow domains, applying the controller reference set by the
+     *  setter threads.
+     */
+    threads.emplace_back([&]()
+    {
+        const IMUData imu_data;
+        const EncoderData encoder_data;
+
+        while (!done.load(std::memory_order_relaxed))
+        {
+            controller.control(control_count % 2 == 0, imu_data, encoder_data);
+            control_count ++;
+        }
+    });
+
+    /*
+     *  Read the controller reference from the main thread until
+     *  the duration elapses.
+     */
+    const auto start = std::chrono::steady_clock::now();
+
+    while (!failed && std::chrono::steady_clock::now() - start < std::chrono::duration<double>(duration))
+    {
+        const ControllerReference controller_reference = controller.getControllerReference();
+        read_count ++;
+
+        if (controller_reference.attitude_y != controller_reference.position_x
+                || controller_reference.attitude_z != controller_reference.position_x)
+        {
+            std::cerr << "Torn controller reference: " << controller_reference.attitude_y << ", "
+                    << controller_reference.attitude_z << ", " << controller_reference.position_x
+                    << "." << std::endl;
+            failed = true;
+        }
+    }
+
+    done = true;
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << "Controller reference: " << write_count << " sets, " << control_count
+            << " executions, " << read_count << " reads, " << (failed ? "FAILED" : "passed")
+            << std::endl;
+
+    return !failed;
+}
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 5;
+    const int reader_count = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (reader_count <= 0)
+    {
+        std::cerr << "Invalid reader count." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Stress the sequence lock and then the controller reference,
+     *  each for half of the duration.
+     */
+    const bool passed_seqlock = stressSeqlock(duration / 2, reader_count);
+    const bool passed_controller = stressController(duration / 2);
+
+    return passed_seqlock && passed_controller ? EXIT_SUCCESS : EXIT_FAILURE;
+}
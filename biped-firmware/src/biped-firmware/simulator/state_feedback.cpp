@@ -0,0 +1,513 @@
+/**
+ *  @file   state_feedback.cpp
+ *  @author Simon Yu
+ *  @date   01/27/2022
+ *  @brief  State-feedback harness source.
+ *
+ *  This file implements the state-feedback harness. The harness
+ *  first designs the state-feedback gain matrix offline, i.e., it
+ *  linearizes the two-wheeled inverted pendulum model of the
+ *  simulated plant around the upright equilibrium, discretizes it
+ *  for the fast domain period, and solves the discrete-time algebraic
+ *  Riccati equation for the linear-quadratic regulator gains, which
+ *  it prints in the form of the controller parameter struct entries.
+ *
+ *  It then runs the simulated plant in closed loop with the controller
+ *  in the PID and in the state-feedback controller modes, pushing the
+ *  body forward and around the Z axis, then backward and around the
+ *  Z axis in the opposite direction. It reports the peak Y attitude
+ *  and X position deviations after the pushes, the Z attitude error
+ *  at the end, and the mean host execution time per controller
+ *  execution of each mode.
+ *
+ *  The harness exits with failure if the state-feedback controller
+ *  mode falls over or deviates further in the Y attitude or in the
+ *  X position than the PID controller mode.
+ *
+ *  Usage: biped-state-feedback [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "sensor/sensor.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/parameter.h"
+#include "simulator/plant.h"
+#include "utility/math.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @tparam Rows Number of rows.
+ *  @tparam Columns Number of columns.
+ *  @brief  Fixed-size matrix type.
+ */
+template<size_t Rows, size_t Columns>
+using Matrix = std::array<std::array<double, Columns>, Rows>;
+
+/*
+ *  Linear-quadratic regulator weights, i.e., the inverse squares of
+ *  the acceptable state errors and controller outputs, in the order
+ *  of the state error vector of the state-feedback gain struct. The
+ *  Z angular velocity is not a state of the linearized plant, and
+ *  is not weighted.
+ */
+constexpr double weight_state[6] = { 1 / (0.03 * 0.03), 1 / (0.3 * 0.3), 1 / (0.02 * 0.02),
+        1 / (0.1 * 0.1), 1 / (0.2 * 0.2), 0 };   //!< State weights.
+constexpr double weight_output[2] = { 1 / (50.0 * 50.0), 1 / (50.0 * 50.0) };  //!< Output weights.
+
+/**
+ *  @tparam Rows Number of rows of the left-hand side matrix.
+ *  @tparam Inner Number of columns of the left-hand side matrix.
+ *  @tparam Columns Number of columns of the right-hand side matrix.
+ *  @param  lhs Left-hand side matrix.
+ *  @param  rhs Right-hand side matrix.
+ *  @return Matrix product.
+ *  @brief  Multiply two matrices.
+ */
+template<size_t Rows, size_t Inner, size_t Columns>
+Matrix<Rows, Columns>
+multiply(const Matrix<Rows, Inner>& lhs, const Matrix<Inner, Columns>& rhs)
+{
+    Matrix<Rows, Columns> product { };
+
+    for (size_t row = 0; row < Rows; row ++)
+    {
+        for (size_t column = 0; column < Columns; column ++)
+        {
+            for (size_t inner = 0; inner < Inner; inner ++)
+            {
+                product[row][column] += lhs[row][inner] * rhs[inner][column];
+            }
+        }
+    }
+
+    return product;
+}
+
+/**
+ *  @tparam Rows Number of rows.
+ *  @tparam Columns Number of columns.
+ *  @param  matrix Matrix.
+ *  @return Matrix transpose.
+ *  @brief  Transpose a matrix.
+ */
+template<size_t Rows, size_t Columns>
+Matrix<Columns, Rows>
+transpose(const Matrix<Rows, Columns>& matrix)
+{
+    Matrix<Columns, Rows> transposed { };
+
+    for (size_t row = 0; row < Rows; row ++)
+    {
+        for (size_t column = 0; column < Columns; column ++)
+        {
+            transposed[column][row] = matrix[row][column];
+        }
+    }
+
+    return transposed;
+}
+
+/**
+ *  @param  a Continuous-time state matrix.
+ *  @param  b Continuous-time input matrix.
+ *  @brief  Linearize the simulated plant.
+ *
+ *  This function linearizes the inverted pendulum and yaw dynamics
+ *  of the simulated plant around the upright equilibrium, with the
+ *  state vector of the state-feedback gain struct and the forward
+ *  and turning outputs as inputs, i.e., the left motor output being
+ *  their sum and the right motor output being their difference.
+ */
+void
+linearize(Matrix<6, 6>& a, Matrix<6, 2>& b)
+{
+    const double mass_total = PlantParameter::mass_body + PlantParameter::mass_wheel;
+    const double denominator = PlantParameter::length
+            * (4.0 / 3.0 - PlantParameter::mass_body / mass_total);
+    const double coupling = PlantParameter::mass_body * PlantParameter::length / mass_total;
+
+    /*
+     *  The sum of the motor forces is linear in the forward output
+     *  and the X velocity. The Y angular acceleration follows from
+     *  the gravity and the sum of the motor forces, and the X
+     *  acceleration from the sum of the motor forces and the
+     *  reaction to the Y angular acceleration.
+     */
+    const double force_output = 2 * PlantParameter::motor_force_gain / mass_total;
+    const double force_velocity = -2 * PlantParameter::motor_damping / mass_total;
+
+    a = { };
+    b = { };
+    a[0][1] = 1;
+    a[2][3] = 1;
+
+    a[3][1] = force_velocity / denominator;
+    a[3][2] = PlantParameter::gravity / denominator;
+    b[3][0] = force_output / denominator;
+
+    a[1][1] = force_velocity + coupling * a[3][1];
+    a[1][2] = coupling * a[3][2];
+    b[1][0] = force_output + coupling * b[3][0];
+
+    /*
+     *  The difference of the motor forces turns the body, damped
+     *  by the motors and by the wheels scrubbing on the ground. The
+     *  damping settles the Z angular velocity within a fraction of
+     *  the fast domain period, such that the Z angular velocity
+     *  follows the turning output rather than being a state of its
+     *  own, and the Z attitude integrates it. The Z angular velocity
+     *  row is left empty, with a zero weight, giving it a zero gain.
+     */
+    const double damping_z = PlantParameter::motor_damping * PlantParameter::track
+            * PlantParameter::track / 2 + PlantParameter::damping_z;
+    b[4][1] = PlantParameter::motor_force_gain * PlantParameter::track / damping_z;
+}
+
+/**
+ *  @param  a State matrix, continuous-time on input and discrete-time on output.
+ *  @param  b Input matrix, continuous-time on input and discrete-time on output.
+ *  @param  period Sampling period, in seconds.
+ *  @brief  Discretize a linear system.
+ *
+ *  This function discretizes the given linear system with a
+ *  zero-order hold on the inputs, using the series expansion of
+ *  the matrix exponential of the augmented system matrix.
+ */
+void
+discretize(Matrix<6, 6>& a, Matrix<6, 2>& b, const double& period)
+{
+    Matrix<8, 8> augmented { };
+    Matrix<8, 8> term { };
+    Matrix<8, 8> exponential { };
+
+    for (size_t row = 0; row < 6; row ++)
+    {
+        for (size_t column = 0; column < 6; column ++)
+        {
+            augmented[row][column] = a[row][column] * period;
+        }
+
+        for (size_t column = 0; column < 2; column ++)
+        {
+            augmented[row][6 + column] = b[row][column] * period;
+        }
+    }
+
+    for (size_t i = 0; i < 8; i ++)
+    {
+        term[i][i] = 1;
+        exponential[i][i] = 1;
+    }
+
+    for (size_t order = 1; order < 60; order ++)
+    {
+        term = multiply(term, augmented);
+
+        for (size_t row = 0; row < 8; row ++)
+        {
+            for (size_t column = 0; column < 8; column ++)
+            {
+                term[row][column] /= order;
+                exponential[row][column] += term[row][column];
+            }
+        }
+    }
+
+    for (size_t row = 0; row < 6; row ++)
+    {
+        for (size_t column = 0; column < 6; column ++)
+        {
+            a[row][column] = exponential[row][column];
+        }
+
+        for (size_t column = 0; column < 2; column ++)
+        {
+            b[row][column] = exponential[row][6 + column];
+        }
+    }
+}
+
+/**
+ *  @param  a Discrete-time state matrix.
+ *  @param  b Discrete-time input matrix.
+ *  @return Linear-quadratic regulator gain matrix.
+ *  @brief  Design the linear-quadratic regulator.
+ *
+ *  This function iterates the discrete-time Riccati difference
+ *  equation until its solution converges, and returns the gain
+ *  matrix of the corresponding linear-quadratic regulator.
+ */
+Matrix<2, 6>
+design(const Matrix<6, 6>& a, const Matrix<6, 2>& b)
+{
+    const Matrix<6, 6> a_transposed = transpose(a);
+    const Matrix<2, 6> b_transposed = transpose(b);
+    Matrix<6, 6> p { };
+    Matrix<2, 6> k { };
+
+    for (size_t i = 0; i < 6; i ++)
+    {
+        p[i][i] = weight_state[i];
+    }
+
+    for (size_t iteration = 0; iteration < 100000; iteration ++)
+    {
+        /*
+         *  K = (R + B' P B)^-1 B' P A.
+         */
+        const Matrix<2, 6> b_transposed_p = multiply(b_transposed, p);
+        Matrix<2, 2> s = multiply(b_transposed_p, b);
+        s[0][0] += weight_output[0];
+        s[1][1] += weight_output[1];
+
+        const double determinant = s[0][0] * s[1][1] - s[0][1] * s[1][0];
+        const Matrix<2, 2> s_inverse = { { { s[1][1] / determinant, -s[0][1] / determinant },
+                { -s[1][0] / determinant, s[0][0] / determinant } } };
+        k = multiply(s_inverse, multiply(b_transposed_p, a));
+
+        /*
+         *  P = Q + A' P (A - B K).
+         */
+        Matrix<6, 6> a_closed_loop = a;
+        const Matrix<6, 6> b_k = multiply(b, k);
+
+        for (size_t row = 0; row < 6; row ++)
+        {
+            for (size_t column = 0; column < 6; column ++)
+            {
+                a_closed_loop[row][column] -= b_k[row][column];
+            }
+        }
+
+        Matrix<6, 6> p_next = multiply(multiply(a_transposed, p), a_closed_loop);
+        double change = 0;
+
+        for (size_t row = 0; row < 6; row ++)
+        {
+            p_next[row][row] += weight_state[row];
+
+            for (size_t column = 0; column < 6; column ++)
+            {
+                change = std::fmax(change, std::fabs(p_next[row][column] - p[row][column])
+                        / std::fmax(1, std::fabs(p[row][column])));
+            }
+        }
+
+        p = p_next;
+
+        if (change < 1e-12)
+        {
+            break;
+        }
+    }
+
+    return k;
+}
+
+/**
+ *  @brief  Closed-loop result struct.
+ *
+ *  This struct contains the disturbance rejection and execution
+ *  time results of a closed-loop run.
+ */
+struct Result
+{
+    bool fallen;    //!< Whether the body fell over.
+    double attitude_y_peak; //!< Peak Y attitude magnitude after the pushes, in radians.
+    double position_x_peak; //!< Peak X position magnitude after the pushes, in meters.
+    double attitude_z_final;    //!< Final Z attitude magnitude, in radians.
+    double execution_time;  //!< Mean host execution time per controller execution, in nanoseconds.
+};
+
+/**
+ *  @param  controller_parameter Controller parameter struct.
+ *  @param  duration Simulated duration, in seconds.
+ *  @return Closed-loop result struct.
+ *  @brief  Run the closed loop.
+ *
+ *  This function runs the simulated plant in closed loop with the
+ *  controller using the given controller parameter, the same way
+ *  as the real-time task, pushing the body once a quarter and once
+ *  at half of the given duration.
+ */
+Result
+run(const ControllerParameter& controller_parameter, const double& duration)
+{
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    controller_->setControllerParameter(controller_parameter);
+
+    const unsigned long iterations = static_cast<unsigned long>(duration / PeriodParameter::fast);
+    const unsigned long iterations_slow = static_cast<unsigned long>(PeriodParameter::slow
+            / PeriodParameter::fast);
+    const unsigned long iteration_push_first = iterations / 4;
+    const unsigned long iteration_push_second = iterations / 2;
+    Result result { false, 0, 0, 0, 0 };
+    unsigned long executions = 0;
+    double execution_time_total = 0;
+
+    for (unsigned long i = 0; i < iterations; ++i)
+    {
+        if (i == iteration_push_first)
+        {
+            plant_->disturb(-1, 2);
+        }
+        else if (i == iteration_push_second)
+        {
+            plant_->disturb(1, -2);
+        }
+
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+
+        for (const bool fast_domain : { true, false })
+        {
+            if (!fast_domain && i % iterations_slow != 0)
+            {
+                break;
+            }
+
+            sensor_->sense(fast_domain);
+
+            const IMUData imu_data = sensor_->getIMUData();
+            const EncoderData encoder_data = sensor_->getEncoderData();
+            const auto time_start = std::chrono::steady_clock::now();
+            controller_->control(fast_domain, imu_data, encoder_data);
+            execution_time_total += std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - time_start).count();
+            executions ++;
+        }
+
+        actuator_->actuate(controller_->getActuationCommand());
+
+        if (std::fabs(plant_->getAttitudeY()) >= M_PI / 2)
+        {
+            result.fallen = true;
+        }
+
+        if (i >= iteration_push_first)
+        {
+            result.attitude_y_peak = std::fmax(result.attitude_y_peak,
+                    std::fabs(plant_->getAttitudeY()));
+            result.position_x_peak = std::fmax(result.position_x_peak,
+                    std::fabs(plant_->getPositionX()));
+        }
+    }
+
+    result.attitude_z_final = std::fabs(std::remainder(plant_->getAttitudeZ(), 2 * M_PI));
+    result.execution_time = execution_time_total / executions;
+
+    return result;
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  State-feedback harness main function.
+ *
+ *  This function designs the state-feedback gain matrix and
+ *  compares the controller modes in closed loop.
+ */
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 8;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Design the state-feedback gain matrix and print it.
+     */
+    Matrix<6, 6> a;
+    Matrix<6, 2> b;
+    linearize(a, b);
+    discretize(a, b, PeriodParameter::fast);
+    const Matrix<2, 6> k = design(a, b);
+
+    std::cout << std::setprecision(6);
+
+    for (size_t row = 0; row < 2; row ++)
+    {
+        std::cout << "controller_parameter_.state_feedback_gain."
+                << (row == 0 ? "forward" : "turning") << " = { ";
+
+        for (size_t column = 0; column < 6; column ++)
+        {
+            std::cout << k[row][column] << (column < 5 ? ", " : " };");
+        }
+
+        std::cout << std::endl;
+    }
+
+    /*
+     *  Run the closed loop in both controller modes, starting from
+     *  the default controller parameter of the controller.
+     */
+    const ControllerParameter controller_parameter_pid = Controller().getControllerParameter();
+    ControllerParameter controller_parameter_state_feedback = controller_parameter_pid;
+    controller_parameter_state_feedback.mode = ControllerMode::state_feedback;
+
+    for (size_t column = 0; column < 6; column ++)
+    {
+        controller_parameter_state_feedback.state_feedback_gain.forward[column] = k[0][column];
+        controller_parameter_state_feedback.state_feedback_gain.turning[column] = k[1][column];
+    }
+
+    const Result result_pid = run(controller_parameter_pid, duration);
+    const Result result_state_feedback = run(controller_parameter_state_feedback, duration);
+
+    std::cout << std::setw(16) << "Mode" << std::setw(14) << "pitch (deg)" << std::setw(14)
+            << "position (m)" << std::setw(14) << "yaw (deg)" << std::setw(14) << "time (ns)"
+            << std::endl;
+
+    for (const bool state_feedback : { false, true })
+    {
+        const Result& result = state_feedback ? result_state_feedback : result_pid;
+        std::cout << std::setw(16) << (state_feedback ? "State feedback" : "PID")
+                << std::setw(14) << radiansToDegrees(result.attitude_y_peak) << std::setw(14)
+                << result.position_x_peak << std::setw(14)
+                << radiansToDegrees(result.attitude_z_final) << std::setw(14)
+                << result.execution_time << (result.fallen ? "  (fallen)" : "") << std::endl;
+    }
+
+    const bool passed = !result_state_feedback.fallen
+            && result_state_feedback.attitude_y_peak < result_pid.attitude_y_peak
+            && result_state_feedback.position_x_peak < result_pid.position_x_peak;
+    std::cout << "State feedback " << (passed ? "passed" : "FAILED") << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
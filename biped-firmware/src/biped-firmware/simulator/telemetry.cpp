@@ -0,0 +1,686 @@
+/**
+ *  @file   telemetry.cpp
+ *  @author Simon Yu
+ *  @date   01/29/2022
+ *  @brief  Telemetry harness source.
+ *
+ *  This file implements the telemetry harness. The harness counts
+ *  the heap allocations of the whole program by replacing the global
+ *  allocation functions. It runs the firmware real-time task against
+ *  the simulated plant, and then writes status messages to the simulated
+ *  UDP, using the status message UDP write task iteration function, and
+ *  Biped messages using the previous path, which serialized the full
+ *  Biped message into a vector, copied it into a string, and parsed the
+ *  Biped ground station IP address per message. It reports the heap
+ *  allocations, the host execution time, and the size per message of
+ *  each path, and verifies the written status and parameter messages
+ *  by deserializing them.
+ *
+ *  The harness then runs the real-time task, draining the telemetry
+ *  sample ring buffer using the telemetry frame UDP write task iteration
+ *  function at a jittered period with stalls, after an initial stall
+ *  longer than the ring buffer. It receives every written telemetry
+ *  frame, and verifies that every real-time task tick is delivered
+ *  exactly once, in order, except for the ticks dropped by the ring
+ *  buffer, which must match the overflow count in the frames.
+ *
+ *  Finally, the harness applies a subscription message selecting a
+ *  few fields at different rates, verifies that an invalid subscription
+ *  message is rejected, that the following frames carry exactly the
+ *  subscribed fields, and reports the bytes per tick before and after.
+ *
+ *  The harness exits with failure if the status message UDP write task
+ *  iteration function allocates any memory, if a written message does
+ *  not deserialize to the expected status or parameter message struct,
+ *  or if the telemetry frame or subscription verification fails.
+ *
+ *  Usage: biped-telemetry [messages] [ticks]
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "network/udp.h"
+#include "sensor/sensor.h"
+#include "simulator/clock.h"
+#include "simulator/harness.h"
+#include "simulator/plant.h"
+#include "task/task.h"
+#include "utility/math.h"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Heap allocation counter, incremented by the replaced
+ *  global allocation functions.
+ */
+static unsigned long long allocation_count_ = 0;    //!< Heap allocation count.
+
+/*
+ *  Telemetry frame receiver state, updated by the receiver
+ *  function for every written telemetry frame.
+ */
+static unsigned long long duplicate_count_ = 0; //!< Number of duplicate or out-of-order samples.
+static unsigned long long frame_count_ = 0; //!< Number of received telemetry frames.
+static TelemetryFrame frame_received_;  //!< Last received telemetry frame.
+static bool frame_valid_ = true;    //!< Whether all received telemetry frames were valid.
+static unsigned long long gap_count_ = 0;   //!< Number of ticks missing between samples.
+static unsigned long long overflow_ = 0;    //!< Overflow count in the last received frame.
+static unsigned long long sample_count_ = 0;    //!< Number of received samples.
+static long long tick_last_ = -1;   //!< Tick index of the last received sample.
+static TelemetrySubscription subscription_;  //!< Expected telemetry subscription.
+static TelemetrySubscription subscription_previous_;    //!< Previous telemetry subscription.
+static bool subscription_switched_ = true;  //!< Whether the frames switched to the expected subscription.
+
+/**
+ *  @param  size Allocation size, in bytes.
+ *  @return Allocated memory pointer.
+ *  @brief  Global allocation function.
+ *
+ *  This function counts and performs a heap allocation.
+ */
+void*
+operator new(std::size_t size)
+{
+    allocation_count_ ++;
+
+    if (void* pointer = std::malloc(size ? size : 1))
+    {
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+/**
+ *  @param  size Allocation size, in bytes.
+ *  @return Allocated memory pointer.
+ *  @brief  Global array allocation function.
+ */
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+/**
+ *  @param  pointer Allocated memory pointer.
+ *  @brief  Global deallocation function.
+ */
+void
+operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+/**
+ *  @param  pointer Allocated memory pointer.
+ *  @brief  Global array deallocation function.
+ */
+void
+operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+/**
+ *  @param  pointer Allocated memory pointer.
+ *  @param  size Allocation size, in bytes.
+ *  @brief  Global sized deallocation function.
+ */
+void
+operator delete(void* pointer, std::size_t size) noexcept
+{
+    std::free(pointer);
+}
+
+/**
+ *  @param  pointer Allocated memory pointer.
+ *  @param  size Allocation size, in bytes.
+ *  @brief  Global sized array deallocation function.
+ */
+void
+operator delete[](void* pointer, std::size_t size) noexcept
+{
+    std::free(pointer);
+}
+
+/**
+ *  @brief  Previous Biped message UDP write function.
+ *
+ *  This function populates and writes a Biped message struct the
+ *  way the Biped message UDP write task did, i.e., serializing into
+ *  a vector, copying the vector into a string, and writing the string
+ *  to the Biped ground station IP address string.
+ */
+static void
+writeBipedMessagePrevious()
+{
+    static unsigned long long sequence = 0;
+    BipedMessage message;
+    std::vector<unsigned char> message_serialized;
+    zpp::serializer::memory_output_archive serializer(message_serialized);
+
+    message.sequence = sequence ++;
+    message.timestamp = micros();
+    message.encoder_data = sensor_->getEncoderData();
+    message.imu_data = sensor_->getIMUData();
+    message.time_of_flight_data = sensor_->getTimeOfFlightData();
+    message.controller_parameter = controller_->getControllerParameter();
+    message.controller_reference = controller_->getControllerReference();
+    message.actuation_command = actuator_->getActuationCommand();
+    message.telemetry.deadline_miss = deadline_miss_real_time_task_;
+    message.telemetry.execution_time = histogram_execution_time_real_time_task_.getStatistics();
+    message.telemetry.execution_time_actuate = histogram_execution_time_actuate_.getStatistics();
+    message.telemetry.execution_time_control = histogram_execution_time_control_.getStatistics();
+    message.telemetry.execution_time_sense_fast =
+            histogram_execution_time_sense_fast_.getStatistics();
+    message.telemetry.execution_time_sense_slow =
+            histogram_execution_time_sense_slow_.getStatistics();
+    message.telemetry.interval = histogram_interval_real_time_task_.getStatistics();
+
+    if (serializer(message))
+    {
+        std::string data(message_serialized.begin(), message_serialized.end());
+        udp_biped_message_->write(NetworkParameter::ip_ground_station,
+                NetworkParameter::port_udp_biped_message, data);
+    }
+}
+
+/**
+ *  @param  subscription Telemetry subscription struct.
+ *  @param  subscription_other Other telemetry subscription struct.
+ *  @return Whether both telemetry subscriptions carry the same fields.
+ *  @brief  Compare telemetry subscriptions.
+ *
+ *  This function compares the field masks and the divisors of
+ *  the subscribed fields only, since the divisors of the other
+ *  fields are not serialized.
+ */
+static bool
+compare(const TelemetrySubscription& subscription, const TelemetrySubscription& subscription_other)
+{
+    if (subscription.field_mask != subscription_other.field_mask)
+    {
+        return false;
+    }
+
+    for (size_t field = 0; field < TelemetrySubscription::field_count; field ++)
+    {
+        if ((subscription.field_mask >> field & 1)
+                && subscription.divisors[field] != subscription_other.divisors[field])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ *  @param  frame Telemetry frame struct.
+ *  @return Expected serialized size, in bytes.
+ *  @brief  Compute the expected serialized size of a telemetry frame.
+ *
+ *  This function sums the sizes of the frame entries and, for every
+ *  sample, the tick index and the fields that the telemetry
+ *  subscription includes at its tick, using the telemetry field table.
+ */
+static size_t
+computeSize(const TelemetryFrame& frame)
+{
+    size_t size = sizeof(MessageType) + sizeof(uint8_t) + sizeof(frame.overflow)
+            + sizeof(frame.sequence) + sizeof(frame.subscription.field_mask)
+            + sizeof(frame.sample_count);
+
+    for (size_t field = 0; field < TelemetrySubscription::field_count; field ++)
+    {
+        size += (frame.subscription.field_mask >> field & 1) ? sizeof(uint8_t) : 0;
+    }
+
+    for (uint32_t i = 0; i < frame.sample_count; i ++)
+    {
+        size += sizeof(frame.samples[i].tick);
+
+        for (size_t field = 0; field < TelemetrySubscription::field_count; field ++)
+        {
+            size += frame.subscription.includes(field, frame.samples[i].tick) ?
+                    telemetry_field_table[field].size : 0;
+        }
+    }
+
+    return size;
+}
+
+/**
+ *  @param  packet Packet pointer.
+ *  @param  size Size of the packet, in bytes.
+ *  @brief  Telemetry frame receiver function.
+ *
+ *  This function deserializes a written telemetry frame without
+ *  allocating memory, skipping other messages, verifies its sequence,
+ *  sample count, telemetry subscription, and size, and counts the gaps
+ *  and duplicates between the ticks of its samples and those of the
+ *  previous samples. Once a frame carries the expected telemetry
+ *  subscription, all following frames must carry it as well.
+ */
+static void
+receive(const uint8_t* packet, const size_t& size)
+{
+    if (size == 0 || packet[0] != static_cast<uint8_t>(MessageType::telemetry_frame))
+    {
+        return;
+    }
+
+    zpp::serializer::memory_view_input_archive deserializer(packet, size);
+
+    if (!deserializer(frame_received_) || frame_received_.sequence != frame_count_
+            || frame_received_.sample_count != TelemetryParameter::sample_count_frame
+            || size > NetworkParameter::buffer_size_telemetry_frame
+            || deserializer.offset() != size || computeSize(frame_received_) != size)
+    {
+        frame_valid_ = false;
+        return;
+    }
+
+    if (compare(frame_received_.subscription, subscription_))
+    {
+        subscription_switched_ = true;
+    }
+    else if (subscription_switched_ || !compare(frame_received_.subscription,
+            subscription_previous_))
+    {
+        frame_valid_ = false;
+        return;
+    }
+
+    frame_count_ ++;
+    overflow_ = frame_received_.overflow;
+
+    for (uint32_t i = 0; i < frame_received_.sample_count; i ++)
+    {
+        const long long tick = frame_received_.samples[i].tick;
+
+        if (tick <= tick_last_)
+        {
+            duplicate_count_ ++;
+            continue;
+        }
+
+        gap_count_ += tick - tick_last_ - 1;
+        tick_last_ = tick;
+        sample_count_ ++;
+    }
+}
+
+/**
+ *  @brief  Result struct.
+ *
+ *  This struct contains the heap allocations and the host
+ *  execution time per message of a message write path.
+ */
+struct Result
+{
+    double allocations; //!< Heap allocations per message.
+    double execution_time;  //!< Host execution time per message, in nanoseconds.
+};
+
+/**
+ *  @param  write Message write function.
+ *  @param  messages Number of messages.
+ *  @return Result struct.
+ *  @brief  Measure a message write path.
+ *
+ *  This function writes the given number of messages using
+ *  the given function, after one warm-up message, and counts the
+ *  heap allocations and the host execution time.
+ */
+static Result
+measure(void (*write)(), const unsigned long& messages)
+{
+    write();
+
+    const unsigned long long allocation_count_start = allocation_count_;
+    const auto time_point_start = std::chrono::steady_clock::now();
+
+    for (unsigned long i = 0; i < messages; i ++)
+    {
+        write();
+    }
+
+    const double execution_time = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - time_point_start).count();
+
+    return { static_cast<double>(allocation_count_ - allocation_count_start) / messages,
+            execution_time / messages };
+}
+
+/**
+ *  @param  sequence_expected Expected sequence number.
+ *  @return Whether the last written status message is valid.
+ *  @brief  Verify the last written status message.
+ *
+ *  This function deserializes the last status message written to
+ *  the simulated UDP and compares it against the expected sequence
+ *  number and the current sensor data, within the quantization
+ *  resolutions of the telemetry sample.
+ */
+static bool
+verify(const unsigned long long& sequence_expected)
+{
+    zpp::serializer::memory_view_input_archive deserializer(udp_biped_message_->getPacket(),
+            udp_biped_message_->getPacketSize());
+    StatusMessage message;
+
+    if (!deserializer(message))
+    {
+        return false;
+    }
+
+    const EncoderData encoder_data = sensor_->getEncoderData();
+    const IMUData imu_data = sensor_->getIMUData();
+    const BipedMessage message_assembled = message.getBipedMessage(
+            controller_->getControllerParameter());
+
+    return message.sequence == sequence_expected && message.timestamp == micros()
+            && message_assembled.encoder_data.steps == encoder_data.steps
+            && std::fabs(message_assembled.imu_data.attitude_y - imu_data.attitude_y)
+                    <= TelemetrySample::resolution_attitude / 2
+            && udp_biped_message_->getPacketSize() <= NetworkParameter::buffer_size_biped_message;
+}
+
+/**
+ *  @return Whether the written parameter message is valid.
+ *  @brief  Write and verify a parameter message.
+ *
+ *  This function writes a parameter message using the parameter
+ *  message UDP write task iteration function, deserializes it, and
+ *  compares it against the current controller parameters.
+ */
+static bool
+verifyParameter()
+{
+    udpWriteParameterMessageTaskIteration();
+
+    zpp::serializer::memory_view_input_archive deserializer(udp_biped_message_->getPacket(),
+            udp_biped_message_->getPacketSize());
+    ParameterMessage message;
+
+    if (!deserializer(message))
+    {
+        return false;
+    }
+
+    std::cout << "Parameter message size: " << udp_biped_message_->getPacketSize() << " bytes"
+            << std::endl;
+
+    return message.sequence == 0
+            && message.controller_parameter.pid_controller_gain_attitude_y.proportional
+                    == controller_->getControllerParameter().pid_controller_gain_attitude_y.proportional
+            && udp_biped_message_->getPacketSize() <= NetworkParameter::buffer_size_biped_message;
+}
+
+/**
+ *  @param  ticks Number of real-time task ticks.
+ *  @param  overflow_expected Expected overflow count.
+ *  @param  bytes_per_tick Bytes per tick of the telemetry frames.
+ *  @return Whether the telemetry frames passed the verification.
+ *  @brief  Verify the telemetry frames.
+ *
+ *  This function runs the given number of real-time task ticks,
+ *  drains the telemetry sample ring buffer at a jittered period
+ *  with occasional stalls shorter than the ring buffer, counts the
+ *  heap allocations, and verifies the received telemetry frames.
+ */
+static bool
+verifyFrames(const unsigned long& ticks, const unsigned long long& overflow_expected,
+        double& bytes_per_tick)
+{
+    /*
+     *  Drain periods, in ticks, around the telemetry frame period,
+     *  with stalls, e.g., of the Wi-Fi.
+     */
+    const unsigned long periods[] = { 5, 4, 6, 5, 3, 7, 5, 20, 5, 1, 9, 40 };
+    const unsigned long tick_start = scheduler_real_time_task_.getTick();
+    const unsigned long long allocation_count_start = allocation_count_;
+    const unsigned long long packet_count_start = udp_biped_message_->getPacketCount();
+    const unsigned long long byte_count_start = udp_biped_message_->getByteCount();
+    unsigned long tick_drain = 0;
+    size_t period_index = 0;
+
+    /*
+     *  Drain the samples buffered during the initial stall.
+     */
+    udpWriteTelemetryFrameTaskIteration();
+
+    for (unsigned long i = 1; i <= ticks; i ++)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+
+        if (i - tick_drain >= periods[period_index])
+        {
+            udpWriteTelemetryFrameTaskIteration();
+            tick_drain = i;
+            period_index = (period_index + 1) % (sizeof(periods) / sizeof(periods[0]));
+        }
+    }
+
+    udpWriteTelemetryFrameTaskIteration();
+
+    const unsigned long long allocations = allocation_count_ - allocation_count_start;
+    const unsigned long long packets = udp_biped_message_->getPacketCount() - packet_count_start;
+    const unsigned long long bytes = udp_biped_message_->getByteCount() - byte_count_start;
+    const long long tick_end = static_cast<long long>(tick_start + ticks) - 1;
+
+    bytes_per_tick = static_cast<double>(bytes) / ticks;
+
+    std::cout << "Telemetry frames: " << frame_count_ << " frames, " << sample_count_
+            << " samples, " << gap_count_ << " gaps, " << duplicate_count_ << " duplicates, "
+            << overflow_ << " overflows, " << allocations << " allocations" << std::endl;
+    std::cout << "Telemetry frame rate: " << static_cast<double>(packets) / (ticks
+            * PeriodParameter::fast) << " packets/s, " << bytes_per_tick << " bytes per tick"
+            << std::endl;
+
+    /*
+     *  Every tick must be received exactly once, except for the
+     *  ticks dropped by the ring buffer during the initial stall,
+     *  and all but the ticks of the last partial frame must have
+     *  been written.
+     */
+    return frame_valid_ && duplicate_count_ == 0 && allocations == 0
+            && overflow_ == overflow_expected && gap_count_ == overflow_
+            && sample_count_ + overflow_ == static_cast<unsigned long long>(tick_last_ + 1)
+            && tick_end - tick_last_ < static_cast<long long>(TelemetryParameter::sample_count_frame);
+}
+
+/**
+ *  @param  ticks Number of real-time task ticks.
+ *  @param  bytes_per_tick_all Bytes per tick of the telemetry frames with all fields.
+ *  @return Whether the telemetry subscription passed the verification.
+ *  @brief  Verify the telemetry subscription.
+ *
+ *  This function applies a subscription message selecting the Y
+ *  attitude and Y angular velocity at every tick and the X position
+ *  every ten ticks, as for balance tuning, after verifying that an
+ *  invalid subscription message is rejected. It then runs the given
+ *  number of real-time task ticks, drains the telemetry sample ring
+ *  buffer every telemetry frame period, and compares the bytes per
+ *  tick against those of the telemetry frames with all fields.
+ */
+static bool
+verifySubscription(const unsigned long& ticks, const double& bytes_per_tick_all)
+{
+    SubscriptionMessage message;
+    std::array<unsigned char, NetworkParameter::buffer_size_biped_message> message_serialized;
+    zpp::serializer::memory_view_output_archive serializer(message_serialized);
+
+    message.subscription.field_mask = 0;
+    message.subscription.subscribe(TelemetryField::attitude_y);
+    message.subscription.subscribe(TelemetryField::angular_velocity_y);
+    message.subscription.subscribe(TelemetryField::position_x, 10);
+
+    if (!serializer(message))
+    {
+        return false;
+    }
+
+    /*
+     *  Verify that a subscription message with a zero divisor, i.e.,
+     *  the first divisor after the header, the sequence, and the field
+     *  mask, is rejected.
+     */
+    const size_t offset_divisor = sizeof(MessageType) + sizeof(uint8_t)
+            + sizeof(message.sequence) + sizeof(message.subscription.field_mask);
+    message_serialized[offset_divisor] = 0;
+    const bool rejected = !readSubscriptionMessage(message_serialized.data(), serializer.offset());
+    message_serialized[offset_divisor] = 1;
+
+    /*
+     *  Apply the subscription message, and expect the frames to switch
+     *  to its telemetry subscription once the partial frame completes.
+     */
+    const unsigned long long byte_count_start = udp_biped_message_->getByteCount();
+    const unsigned long long frame_count_start = frame_count_;
+
+    subscription_previous_ = subscription_;
+    subscription_ = message.subscription;
+    subscription_switched_ = false;
+
+    const bool applied = readSubscriptionMessage(message_serialized.data(), serializer.offset());
+
+    for (unsigned long i = 1; i <= ticks; i ++)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+
+        if (i % TelemetryParameter::sample_count_frame == 0)
+        {
+            udpWriteTelemetryFrameTaskIteration();
+        }
+    }
+
+    const double bytes_per_tick = static_cast<double>(udp_biped_message_->getByteCount()
+            - byte_count_start) / ticks;
+
+    std::cout << "Telemetry subscription: " << frame_count_ - frame_count_start << " frames, "
+            << bytes_per_tick << " bytes per tick, " << bytes_per_tick_all
+            << " bytes per tick with all fields" << std::endl;
+
+    return rejected && applied && frame_valid_ && subscription_switched_
+            && duplicate_count_ == 0 && 3 * bytes_per_tick < bytes_per_tick_all;
+}
+
+/**
+ *  @param  argc Number of command-line arguments.
+ *  @param  argv Command-line arguments.
+ *  @return Exit status.
+ *  @brief  Telemetry harness main function.
+ *
+ *  This function runs the firmware real-time task against the
+ *  simulated plant, measures both message write paths, and
+ *  prints the results.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const unsigned long ticks = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+
+    if (messages == 0 || ticks == 0)
+    {
+        std::cerr << "Invalid number of messages or ticks." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Instantiate the simulated plant and the global objects.
+     */
+    instantiateGlobalObjects();
+    udp_biped_message_ = std::make_shared<UDP>();
+    udp_biped_message_->initialize(NetworkParameter::port_udp_biped_message);
+
+    if (!udp_biped_message_->setRemote(NetworkParameter::ip_ground_station,
+            NetworkParameter::port_udp_biped_message))
+    {
+        std::cerr << "Invalid Biped ground station IP address." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    udp_biped_message_->setReceiver(&receive);
+
+    /*
+     *  Run the real-time task for a second, such that the
+     *  Biped messages carry non-trivial data, without draining
+     *  the telemetry sample ring buffer, such that it overflows.
+     */
+    realTimeTaskInitialization();
+
+    for (unsigned long i = 0; i < 200; i ++)
+    {
+        plant_->step(PeriodParameter::fast);
+        Clock::advance(static_cast<uint64_t>(secondsToMicroseconds(PeriodParameter::fast)));
+        realTimeTaskIteration();
+    }
+
+    /*
+     *  Measure both paths and verify the last message written
+     *  by the status message UDP write task iteration function.
+     */
+    const Result result_previous = measure(&writeBipedMessagePrevious, messages);
+    const size_t size_previous = udp_biped_message_->getPacketSize();
+    const Result result = measure(&udpWriteStatusMessageTaskIteration, messages);
+    const size_t size_status = udp_biped_message_->getPacketSize();
+    const bool valid = verify(messages) && verifyParameter();
+
+    std::cout << std::setw(16) << "Path" << std::setw(14) << "allocations" << std::setw(14)
+            << "time (ns)" << std::endl;
+    std::cout << std::setw(16) << "Previous" << std::setw(14) << result_previous.allocations
+            << std::setw(14) << result_previous.execution_time << std::endl;
+    std::cout << std::setw(16) << "Preallocated" << std::setw(14) << result.allocations
+            << std::setw(14) << result.execution_time << std::endl;
+    std::cout << "Message size: " << size_previous << " bytes previous, " << size_status
+            << " bytes status, " << udp_biped_message_->getPacketCount() << " messages written"
+            << std::endl;
+
+    /*
+     *  Verify the telemetry frames, with the ticks of the initial
+     *  stall beyond the ring buffer capacity dropped.
+     */
+    double bytes_per_tick = 0;
+    const bool valid_frames = verifyFrames(ticks,
+            200 - TelemetryParameter::ring_buffer_capacity, bytes_per_tick);
+
+    const bool valid_subscription = verifySubscription(ticks, bytes_per_tick);
+
+    const bool passed = valid && valid_frames && valid_subscription && result.allocations == 0;
+    std::cout << "Telemetry " << (passed ? "passed" : "FAILED") << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,299 @@
+/**
+ *  @file   timing_histogram.cpp
+ *  @author Simon Yu
+ *  @date   01/22/2022
+ *  @brief  Timing histogram harness source.
+ *
+ *  This file implements the timing histogram harness. The harness
+ *  records synthetic timing samples, both within and beyond the
+ *  histogram range, and verifies the count, the minimum, maximum,
+ *  and mean, and the percentiles against those computed from the
+ *  sorted samples, i.e., the middle of the bin of the sample at the
+ *  percentile, clamped between the minimum and maximum.
+ *
+ *  It then verifies the statistics windows of the collected timing
+ *  statistics, first step by step, and then with a writer thread
+ *  recording as fast as possible while a reader thread collects,
+ *  checking that every sample recorded is collected exactly once.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-timing-histogram [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "utility/timing_histogram.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/*
+ *  Histogram constants.
+ */
+constexpr size_t bin_count = 64;    //!< Number of histogram bins.
+constexpr uint32_t bin_width = 10;  //!< Histogram bin width, in microseconds.
+constexpr uint32_t lower_bound = 100;   //!< Histogram lower bound, in microseconds.
+
+/*
+ *  Histogram type.
+ */
+using Histogram = TimingHistogram<bin_count>;
+
+/**
+ *  @param  samples Timing samples, in microseconds, sorted.
+ *  @param  percentile Percentile, between 0 and 1.
+ *  @return Expected percentile, in microseconds.
+ *  @brief  Compute the expected percentile.
+ *
+ *  This function finds the sample at the given percentile and returns
+ *  the middle of its bin, with the out-of-range samples in the first
+ *  or the last bin, clamped between the minimum and maximum.
+ */
+static double
+getPercentile(const std::vector<uint32_t>& samples, const double& percentile)
+{
+    const size_t rank = static_cast<size_t>(std::ceil(percentile * samples.size()));
+    const uint32_t sample = samples[rank > 0 ? rank - 1 : 0];
+    const uint32_t offset = sample > lower_bound ? sample - lower_bound : 0;
+    const size_t index = std::min<size_t>(offset / bin_width, bin_count - 1);
+    const double middle = lower_bound + (index + 0.5) * bin_width;
+
+    return std::max<double>(samples.front(), std::min<double>(samples.back(), middle));
+}
+
+/**
+ *  @param  name Distribution name.
+ *  @param  samples Timing samples, in microseconds.
+ *  @return Whether the timing statistics match.
+ *  @brief  Verify the timing statistics of a set of samples.
+ *
+ *  This function records the given samples and verifies the timing
+ *  statistics, both peeked and collected, against the sorted samples.
+ */
+static bool
+verifyStatistics(const std::string& name, std::vector<uint32_t> samples)
+{
+    Histogram histogram(lower_bound, bin_width);
+    double sum = 0;
+
+    for (const auto& sample : samples)
+    {
+        histogram.record(sample);
+        sum += sample;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    /*
+     *  Collect twice, with a sample in between to let the writer swap
+     *  the banks, such that the second collection holds the samples.
+     */
+    const TimingStatistics timing_statistics = histogram.getStatistics();
+    const bool empty = histogram.collectStatistics().count == 0;
+    histogram.record(samples.front());
+    const TimingStatistics timing_statistics_collected = histogram.collectStatistics();
+
+    const double percentile_50 = getPercentile(samples, 0.5);
+    const double percentile_90 = getPercentile(samples, 0.9);
+    const double percentile_99 = getPercentile(samples, 0.99);
+    const float mean = static_cast<float>(sum / samples.size());
+
+    bool passed = empty;
+
+    for (const auto& statistics : { timing_statistics, timing_statistics_collected })
+    {
+        passed &= statistics.count == samples.size() && statistics.minimum == samples.front()
+                && statistics.maximum == samples.back() && statistics.mean == mean
+                && statistics.percentile_50 == static_cast<float>(percentile_50)
+                && statistics.percentile_90 == static_cast<float>(percentile_90)
+                && statistics.percentile_99 == static_cast<float>(percentile_99);
+    }
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::setw(8) << timing_statistics.count
+            << std::setw(8) << timing_statistics.minimum << std::setw(8) << timing_statistics.maximum
+            << std::setw(10) << timing_statistics.mean << std::setw(8) << timing_statistics.percentile_50
+            << std::setw(8) << timing_statistics.percentile_90 << std::setw(8)
+            << timing_statistics.percentile_99 << (passed ? "" : "  FAILED") << std::endl;
+
+    return passed;
+}
+
+/**
+ *  @return Whether the statistics windows match.
+ *  @brief  Verify the statistics windows step by step.
+ *
+ *  This function records and collects in a fixed order and verifies
+ *  the sample count of every collection, each covering the samples
+ *  recorded between the previous two swaps.
+ */
+static bool
+verifyWindows()
+{
+    Histogram histogram(lower_bound, bin_width);
+    std::vector<uint32_t> counts;
+
+    for (size_t i = 0; i < 5; i ++)
+    {
+        histogram.record(200);
+    }
+
+    counts.push_back(histogram.collectStatistics().count);
+
+    for (size_t i = 0; i < 3; i ++)
+    {
+        histogram.record(300);
+    }
+
+    counts.push_back(histogram.collectStatistics().count);
+    counts.push_back(histogram.collectStatistics().count);
+
+    for (size_t i = 0; i < 2; i ++)
+    {
+        histogram.record(400);
+    }
+
+    const uint32_t count_peeked = histogram.getStatistics().count;
+    const TimingStatistics timing_statistics = histogram.collectStatistics();
+    counts.push_back(timing_statistics.count);
+
+    const bool passed = counts == std::vector<uint32_t>({ 0, 5, 0, 3 }) && count_peeked == 2
+            && timing_statistics.minimum == 300 && timing_statistics.maximum == 300;
+
+    std::cout << "Windows: " << counts[0] << ", " << counts[1] << ", " << counts[2] << ", " << counts[3]
+            << (passed ? "" : "  FAILED") << std::endl;
+
+    return passed;
+}
+
+/**
+ *  @param  duration Stress duration, in seconds.
+ *  @return Whether every sample was collected exactly once.
+ *  @brief  Stress the statistics windows.
+ *
+ *  This function records samples from a writer thread as fast as
+ *  possible while a reader thread collects the timing statistics, and
+ *  verifies that the samples collected, along with those left in the
+ *  histogram, add up to the samples recorded.
+ */
+static bool
+stressWindows(const double& duration)
+{
+    Histogram histogram(lower_bound, bin_width);
+    std::atomic<bool> done(false);
+    unsigned long long record_count = 0;
+    unsigned long long collect_count = 0;
+    unsigned long long window_count = 0;
+    bool valid = true;
+
+    std::thread reader([&]()
+    {
+        std::mt19937 random(431);
+        std::uniform_int_distribution<int> distribution(0, 200);
+
+        while (!done.load(std::memory_order_acquire))
+        {
+            const TimingStatistics timing_statistics = histogram.collectStatistics();
+
+            collect_count += timing_statistics.count;
+            window_count ++;
+            valid &= timing_statistics.count == 0 || (timing_statistics.minimum >= lower_bound
+                    && timing_statistics.maximum < lower_bound + bin_count * bin_width);
+            std::this_thread::sleep_for(std::chrono::microseconds(distribution(random)));
+        }
+    });
+
+    const auto time_point_end = std::chrono::steady_clock::now() + std::chrono::duration<double>(duration);
+
+    while (std::chrono::steady_clock::now() < time_point_end)
+    {
+        for (size_t i = 0; i < 1000; i ++)
+        {
+            histogram.record(lower_bound + record_count % (bin_count * bin_width));
+            record_count ++;
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    /*
+     *  The samples recorded since the last swap remain in the histogram,
+     *  and the samples of the bank swapped out last are collected now.
+     */
+    collect_count += histogram.collectStatistics().count;
+    collect_count += histogram.getStatistics().count;
+
+    const bool passed = valid && collect_count == record_count;
+
+    std::cout << "Stress: " << record_count << " recorded, " << collect_count << " collected in "
+            << window_count << " windows" << (passed ? "" : "  FAILED") << std::endl;
+
+    return passed;
+}
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 1;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(431);
+    std::vector<uint32_t> samples_uniform;
+    std::vector<uint32_t> samples_exponential;
+    std::vector<uint32_t> samples_range;
+    std::exponential_distribution<double> distribution_exponential(1.0 / 80);
+    std::uniform_int_distribution<uint32_t> distribution_range(0, 2 * lower_bound + bin_count * bin_width);
+    bool passed = true;
+
+    for (uint32_t sample = lower_bound; sample < lower_bound + 150; sample ++)
+    {
+        samples_uniform.push_back(sample);
+    }
+
+    for (size_t i = 0; i < 10000; i ++)
+    {
+        samples_exponential.push_back(lower_bound + static_cast<uint32_t>(distribution_exponential(random)));
+        samples_range.push_back(distribution_range(random));
+    }
+
+    std::cout << std::left << std::setw(20) << "Samples" << std::right << std::setw(8) << "Count" << std::setw(8)
+            << "Min" << std::setw(8) << "Max" << std::setw(10) << "Mean" << std::setw(8) << "P50"
+            << std::setw(8) << "P90" << std::setw(8) << "P99" << std::endl;
+
+    passed &= verifyStatistics("uniform", samples_uniform);
+    passed &= verifyStatistics("exponential", samples_exponential);
+    passed &= verifyStatistics("out of range", samples_range);
+    passed &= verifyStatistics("single", { 4321 });
+    passed &= verifyWindows();
+    passed &= stressWindows(duration);
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+/**
+ *  @file   velocity.cpp
+ *  @author Simon Yu
+ *  @date   01/23/2022
+ *  @brief  Velocity estimator harness source.
+ *
+ *  This file implements the velocity estimator harness. The harness
+ *  generates a synthetic encoder edge stream, with microsecond edge
+ *  timestamps, from a velocity profile consisting of an oscillation,
+ *  a slow creep, a ramp, and a stop, with every other edge offset
+ *  by a quadrature phase error. It then estimates the velocity
+ *  every fast domain period using the edge timestamp-based velocity
+ *  estimator, as the encoder does, and every slow domain period using
+ *  the step differences over the slow domain period, as the encoder
+ *  did. It reports the root-mean-square error of each estimate against
+ *  the true velocity, and the delay of each estimate, i.e., the time
+ *  shift of the true velocity that best matches the estimate. The
+ *  edge timestamp-based estimate is also reported before the low-pass
+ *  filter.
+ *
+ *  The harness exits with failure if the edge timestamp-based estimate
+ *  is not more accurate and less delayed than the step differences.
+ *
+ *  Usage: biped-velocity [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "utility/low_pass_filter.hpp"
+#include "utility/math.h"
+#include "utility/velocity_estimator.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::firmware;
+
+/**
+ *  @param  time Time, in seconds.
+ *  @param  duration Duration of the profile, in seconds.
+ *  @return True velocity, in meters per second.
+ *  @brief  Velocity profile function.
+ *
+ *  This function returns the true velocity of the profile at
+ *  the given time. The profile is divided into four equally long
+ *  segments: an oscillation, a slow creep, a ramp, and a stop.
+ */
+double
+getVelocity(const double& time, const double& duration)
+{
+    const double segment = duration / 4;
+
+    if (time < segment)
+    {
+        return 0.2 * std::sin(2 * M_PI * time);
+    }
+    else if (time < 2 * segment)
+    {
+        return 0.005;
+    }
+    else if (time < 3 * segment)
+    {
+        return 0.5 * (time - 2 * segment) / segment;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ *  @param  estimates Estimated velocities, one per fast domain period.
+ *  @param  velocities True velocities, one per fast domain period.
+ *  @param  error Root-mean-square error, in meters per second.
+ *  @param  delay Delay, in seconds.
+ *  @brief  Evaluate the estimated velocities.
+ *
+ *  This function computes the root-mean-square error of the given
+ *  estimated velocities against the true velocities, and the delay
+ *  of the estimated velocities, i.e., the shift, in fast domain
+ *  periods, of the true velocities that minimizes the error.
+ */
+void
+evaluate(const std::vector<double>& estimates, const std::vector<double>& velocities,
+        double& error, double& delay)
+{
+    const size_t shift_max = static_cast<size_t>(0.2 / PeriodParameter::fast);
+    double error_min = std::numeric_limits<double>::max();
+    size_t shift_min = 0;
+
+    for (size_t shift = 0; shift <= shift_max; shift ++)
+    {
+        double error_squared_total = 0;
+
+        for (size_t i = shift_max; i < estimates.size(); i ++)
+        {
+            error_squared_total += std::pow(estimates[i] - velocities[i - shift], 2);
+        }
+
+        const double error_shift = std::sqrt(error_squared_total / (estimates.size() - shift_max));
+
+        if (shift == 0)
+        {
+            error = error_shift;
+        }
+
+        if (error_shift < error_min)
+        {
+            error_min = error_shift;
+            shift_min = shift;
+        }
+    }
+
+    delay = shift_min * PeriodParameter::fast;
+}
+
+int
+main(int argc, char** argv)
+{
+    /*
+     *  Parse the command-line arguments.
+     */
+    const double duration = argc > 1 ? std::atof(argv[1]) : 8;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    /*
+     *  Configure the velocity estimator and the low-pass filters,
+     *  the same as the encoder does now in the fast domain and did
+     *  before in the slow domain.
+     */
+    VelocityEstimator<TypeParameter::Scalar> velocity_estimator;
+    LowPassFilter<TypeParameter::Scalar> low_pass_filter_fast;
+    LowPassFilter<TypeParameter::Scalar> low_pass_filter_slow;
+    velocity_estimator.setTimeout(secondsToMicroseconds(EncoderParameter::velocity_timeout));
+    low_pass_filter_fast.setBeta(EncoderParameter::low_pass_filter_beta);
+    low_pass_filter_slow.setBeta(0.7);
+
+    /*
+     *  Integrate the velocity profile every microsecond, timestamping
+     *  the steps, and estimate the velocity every fast domain period.
+     */
+    const uint32_t period_fast = secondsToMicroseconds(PeriodParameter::fast);
+    const uint32_t ratio = static_cast<uint32_t>(PeriodParameter::slow / PeriodParameter::fast);
+    const uint64_t timestamp_end = secondsToMicroseconds(duration);
+    const double phase_error = 0.1;
+    std::vector<double> estimates_fast;
+    std::vector<double> estimates_raw;
+    std::vector<double> estimates_slow;
+    std::vector<double> velocities;
+    double estimate_slow = 0;
+    double position = 0;
+    long steps = 0;
+    long steps_last = 0;
+    uint32_t timestamp_step = 0;
+
+    for (uint64_t timestamp = 1; timestamp <= timestamp_end; timestamp ++)
+    {
+        const double time = microsecondsToSeconds(timestamp);
+        position += getVelocity(time, duration) * 1e-6;
+
+        /*
+         *  Offset every other edge by the quadrature phase error,
+         *  as the channels of a real encoder are not exactly 90
+         *  degrees apart.
+         */
+        const double steps_exact = position * EncoderParameter::steps_per_meter;
+        long steps_current = std::floor(steps_exact);
+
+        if ((steps_current & 1) && steps_exact - steps_current < phase_error)
+        {
+            steps_current --;
+        }
+
+        if (steps_current != steps)
+        {
+            steps = steps_current;
+            timestamp_step = timestamp;
+        }
+
+        if (timestamp % period_fast != 0)
+        {
+            continue;
+        }
+
+        /*
+         *  Estimate the velocity from the edge timestamps, before
+         *  and after the low-pass filter.
+         */
+        const TypeParameter::Scalar estimate_raw = velocity_estimator.estimate(steps,
+                timestamp_step, timestamp) / TypeParameter::Scalar(EncoderParameter::steps_per_meter);
+        estimates_raw.push_back(static_cast<double>(estimate_raw));
+        estimates_fast.push_back(static_cast<double>(low_pass_filter_fast.filter(estimate_raw)));
+
+        /*
+         *  Estimate the velocity from the step differences every slow
+         *  domain period, holding the estimate in between.
+         */
+        if ((timestamp / period_fast) % ratio == 0)
+        {
+            estimate_slow = static_cast<double>(low_pass_filter_slow.filter(
+                    TypeParameter::Scalar(static_cast<double>(steps - steps_last))
+                            / TypeParameter::Scalar(EncoderParameter::steps_per_meter)
+                            / TypeParameter::Scalar(PeriodParameter::slow)));
+            steps_last = steps;
+        }
+
+        estimates_slow.push_back(estimate_slow);
+        velocities.push_back(getVelocity(time, duration));
+    }
+
+    /*
+     *  Evaluate both estimates.
+     */
+    double error_fast = 0;
+    double error_raw = 0;
+    double error_slow = 0;
+    double delay_fast = 0;
+    double delay_raw = 0;
+    double delay_slow = 0;
+    evaluate(estimates_fast, velocities, error_fast, delay_fast);
+    evaluate(estimates_raw, velocities, error_raw, delay_raw);
+    evaluate(estimates_slow, velocities, error_slow, delay_slow);
+
+    std::cout << std::setw(20) << "Estimator" << std::setw(16) << "RMS error (m/s)"
+            << std::setw(12) << "delay (ms)" << std::endl;
+    std::cout << std::setw(20) << "Edge timestamps" << std::setw(16) << error_fast << std::setw(12)
+            << secondsToMilliseconds(delay_fast) << std::endl;
+    std::cout << std::setw(20) << "  (unfiltered)" << std::setw(16) << error_raw << std::setw(12)
+            << secondsToMilliseconds(delay_raw) << std::endl;
+    std::cout << std::setw(20) << "Step differences" << std::setw(16) << error_slow << std::setw(12)
+            << secondsToMilliseconds(delay_slow) << std::endl;
+
+    const bool passed = error_fast < error_slow && delay_fast < delay_slow;
+    std::cout << "Velocity estimator " << (passed ? "passed" : "FAILED") << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -138,6 +138,36 @@ digitalReadFromISR(uint8_t pin)
     }
 }
 
+uint8_t IRAM_ATTR
+digitalReadPairFromISR(uint8_t pin_a, uint8_t pin_b)
+{
+    /*
+     *  static_cast the given ESP32 pins into 32-bit unsigned integers.
+     */
+    const uint32_t pin_gpio_a = static_cast<uint32_t>(pin_a);
+    const uint32_t pin_gpio_b = static_cast<uint32_t>(pin_b);
+
+    /*
+     *  If both pins are in the same GPIO input register, read the
+     *  register once and extract the states of both pins. Otherwise,
+     *  read the pins individually.
+     */
+    if (pin_gpio_a < 32 && pin_gpio_b < 32)
+    {
+        const uint32_t in = GPIO.in;
+        return (((in >> pin_gpio_a) & 0x1) << 1) | ((in >> pin_gpio_b) & 0x1);
+    }
+    else if (pin_gpio_a >= 32 && pin_gpio_b >= 32)
+    {
+        const uint32_t in = HAL_FORCE_READ_U32_REG_FIELD(GPIO.in1, data);
+        return (((in >> (pin_gpio_a - 32)) & 0x1) << 1) | ((in >> (pin_gpio_b - 32)) & 0x1);
+    }
+    else
+    {
+        return (digitalReadFromISR(pin_a) << 1) | digitalReadFromISR(pin_b);
+    }
+}
+
 void IRAM_ATTR
 encoderLeftAInterruptHandler()
 {
@@ -362,6 +392,11 @@ timerInterruptHandler(void* arg)
     interval_real_time_task_ = current_real_time - time_point_start;
     time_point_start = current_real_time;
 
+    /*
+     *  Record the real-time task interval.
+     */
+    histogram_interval_real_time_task_.record(interval_real_time_task_);
+
     /*
      *  If the real-time task handle global pointer is not a null pointer, wake
      *  the real-time task using the FreeRTOS vTaskNotifyGiveFromISR function.
@@ -65,6 +65,23 @@ attachInterrupt(const uint8_t& pin, void
 int IRAM_ATTR
 digitalReadFromISR(uint8_t pin);
 
+/**
+ *  @param  pin_a First ESP32 pin.
+ *  @param  pin_b Second ESP32 pin.
+ *  @return States of the given ESP32 pins, with the first in bit 1 and the second in bit 0.
+ *  @brief  Perform a digital read from the given pair of ESP32 pins.
+ *
+ *  This function performs a digital read from the given pair of
+ *  ESP32 pins, using a single GPIO input register read if both pins
+ *  are in the same register, such that both states are sampled at
+ *  the same instant, e.g., for the A and B channels of an encoder.
+ *
+ *  Unlike the Arduino BSP digital read, this function is safe to be
+ *  called from an interrupt context.
+ */
+uint8_t IRAM_ATTR
+digitalReadPairFromISR(uint8_t pin_a, uint8_t pin_b);
+
 /**
  *  @brief  Left encoder A interrupt handler.
  *
@@ -0,0 +1,215 @@
+/**
+ *  @file   real_time.cpp
+ *  @author Simon Yu
+ *  @date   12/03/2022
+ *  @brief  Real-time task iteration function source.
+ *
+ *  This file implements the hardware-independent real-time
+ *  task iteration function.
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/controller.h"
+#include "platform/serial.h"
+#include "sensor/sensor.h"
+#include "task/task.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @param  argument Job function argument pointer.
+ *  @brief  Control job function.
+ *
+ *  This function performs fast or slow domain control, as given
+ *  by the boolean pointed to by the argument pointer.
+ */
+static void
+controlJob(void* argument)
+{
+    if (controller_)
+    {
+        controller_->control(*static_cast<const bool*>(argument));
+    }
+}
+
+/**
+ *  @param  argument Job function argument pointer, unused.
+ *  @brief  Encoder sensing job function.
+ */
+static void
+senseEncoderJob(void* argument)
+{
+    if (sensor_)
+    {
+        sensor_->senseEncoder();
+    }
+}
+
+/**
+ *  @param  argument Job function argument pointer, unused.
+ *  @brief  IMU sensing job function.
+ */
+static void
+senseIMUJob(void* argument)
+{
+    if (sensor_)
+    {
+        sensor_->senseIMU();
+    }
+}
+
+/**
+ *  @param  argument Job function argument pointer, unused.
+ *  @brief  Time-of-flight sensing job function.
+ */
+static void
+senseTimeOfFlightJob(void* argument)
+{
+    if (sensor_)
+    {
+        sensor_->senseTimeOfFlight();
+    }
+}
+
+void
+realTimeTaskInitialization()
+{
+    /*
+     *  Domain flags passed to the control job function.
+     */
+    static bool fast_domain = true;
+    static bool slow_domain = false;
+
+    /*
+     *  Register the jobs, with sensing before control within each
+     *  domain. The scheduler runs the fast domain jobs before the slow
+     *  domain jobs, and the time-of-flight reads are phase-shifted
+     *  away from the slow domain control.
+     */
+    const bool registered = scheduler_real_time_task_.registerJob("sense encoder",
+            &senseEncoderJob, nullptr, SchedulerParameter::divisor_fast, 0,
+            SchedulerParameter::group_sense_fast)
+            && scheduler_real_time_task_.registerJob("sense IMU", &senseIMUJob, nullptr,
+                    SchedulerParameter::divisor_fast, 0, SchedulerParameter::group_sense_fast)
+            && scheduler_real_time_task_.registerJob("control fast", &controlJob, &fast_domain,
+                    SchedulerParameter::divisor_fast, 0, SchedulerParameter::group_control)
+            && scheduler_real_time_task_.registerJob("sense time-of-flight",
+                    &senseTimeOfFlightJob, nullptr, SchedulerParameter::divisor_slow,
+                    SchedulerParameter::phase_time_of_flight, SchedulerParameter::group_sense_slow)
+            && scheduler_real_time_task_.registerJob("control slow", &controlJob, &slow_domain,
+                    SchedulerParameter::divisor_slow, SchedulerParameter::phase_control_slow,
+                    SchedulerParameter::group_control);
+
+    if (!registered)
+    {
+        Serial(LogLevel::error) << "Failed to register real-time task jobs.";
+    }
+}
+
+void
+realTimeTaskIteration()
+{
+    /*
+     *  Perform the sensing and control jobs due at this tick
+     *  using the real-time task scheduler.
+     */
+    const uint32_t tick = scheduler_real_time_task_.getTick();
+    scheduler_real_time_task_.tick();
+
+    /*
+     *  Record the per-stage execution times, in microseconds, for
+     *  the real-time task timing histograms.
+     */
+    histogram_execution_time_sense_fast_.record(scheduler_real_time_task_.getExecutionTime(
+            SchedulerParameter::group_sense_fast));
+
+    if (scheduler_real_time_task_.getGroupRan(SchedulerParameter::group_sense_slow))
+    {
+        histogram_execution_time_sense_slow_.record(scheduler_real_time_task_.getExecutionTime(
+                SchedulerParameter::group_sense_slow));
+    }
+
+    histogram_execution_time_control_.record(scheduler_real_time_task_.getExecutionTime(
+            SchedulerParameter::group_control));
+    const unsigned long time_point_stage = micros();
+
+    /*
+     *  Perform actuation using the actuation command
+     *  struct from the controller.
+     */
+    if (controller_ && actuator_)
+    {
+        actuator_->actuate(controller_->getActuationCommand());
+    }
+
+    histogram_execution_time_actuate_.record(micros() - time_point_stage);
+
+    /*
+     *  Sample the sensor data, the controller reference, and the
+     *  actuation command of this tick into a compact telemetry sample,
+     *  and push it into the telemetry sample ring buffer. If the ring
+     *  buffer is full, the sample is dropped and counted, without
+     *  blocking.
+     */
+    TelemetrySample sample;
+    sample.tick = tick;
+    sample.timestamp = micros();
+
+    if (sensor_)
+    {
+        sample.setEncoderData(sensor_->getEncoderData());
+        sample.setIMUData(sensor_->getIMUData());
+        sample.setTimeOfFlightData(sensor_->getTimeOfFlightData());
+    }
+
+    if (controller_)
+    {
+        sample.setControllerReference(controller_->getControllerReference());
+    }
+
+    if (actuator_)
+    {
+        sample.setActuationCommand(actuator_->getActuationCommand());
+    }
+
+    ring_buffer_telemetry_sample_.push(sample);
+}
+
+void
+realTimeTaskWait(uint32_t (*take)(const bool& block))
+{
+    /*
+     *  Take the notifications given during the last iteration without blocking
+     *  and count each as a deadline miss, or sleep until the next one if none.
+     */
+    const uint32_t notification = take(false);
+
+    if (notification > 0)
+    {
+        deadline_miss_real_time_task_ += notification;
+    }
+    else
+    {
+        take(true);
+    }
+}
+}   // namespace firmware
+}   // namespace biped
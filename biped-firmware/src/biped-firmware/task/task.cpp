@@ -10,6 +10,7 @@
 /*
  *  External headers.
  */
+#include <algorithm>
 #include <Esp.h>
 #include <esp32-hal-gpio.h>
 #include <freertos/FreeRTOS.h>
@@ -38,6 +39,7 @@
 #include "sensor/sensor.h"
 #include "task/interrupt.h"
 #include "task/task.h"
+#include "utility/math.h"
 
 /*
  *  Biped namespace.
@@ -201,6 +203,7 @@ bestEffortTask()
     {
         biped::firmware::Display(5) << "Planner: stage " << planner_stage;
     }
+    biped::firmware::Display(6) << "Deadline Miss: " << biped::firmware::deadline_miss_real_time_task_.load();
 //    biped::firmware::Display(6) << "Waddap";
     // prints state of push button a to OLED
 //    biped::firmware::Display(6) << "A State: " << io_expander_a_->digitalReadPortA(IOExpanderAPortAPin::push_button_a);
@@ -241,6 +244,102 @@ bestEffortTask()
 //    actuator_->actuate(lab6);
 }
 
+void
+cameraCaptureTask(void* pvParameters)
+{
+    /*
+     *  Sleep until woken, the same way as the camera UDP write task.
+     */
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+    /*
+     *  Declare the applied camera setting, initialized to no setting, and the
+     *  wake time, initialized to the current tick count.
+     */
+    CameraSetting setting;
+    TickType_t time_wake = xTaskGetTickCount();
+
+    /*
+     *  Task loop.
+     */
+    for (;;)
+    {
+        /*
+         *  If the camera pipeline global shared pointer is not a null pointer, using the
+         *  camera pipeline global shared pointer, execute the capture stage. Otherwise,
+         *  wait for a fast domain period before checking again.
+         */
+        if (camera_pipeline_ && camera_)
+        {
+            /*
+             *  Apply the camera setting of the camera rate controller if it changed.
+             */
+            const CameraSetting setting_published = seqlock_camera_setting_.read();
+
+            if (setting_published != setting)
+            {
+                camera_->configure(setting_published);
+                setting = setting_published;
+            }
+
+            /*
+             *  Sleep until the next camera frame period of the camera setting, if any,
+             *  such that the camera bandwidth follows the camera frame rate.
+             */
+            if (setting.frame_rate > 0)
+            {
+                vTaskDelayUntil(&time_wake,
+                        std::max<TickType_t>(millisecondsToTicks(1000.0 / setting.frame_rate), 1));
+            }
+
+            camera_pipeline_->capture();
+        }
+        else
+        {
+            vTaskDelay(millisecondsToTicks(secondsToMilliseconds(PeriodParameter::fast)));
+        }
+    }
+
+    /*
+     *  Delete this task upon exit.
+     */
+    vTaskDelete(nullptr);
+}
+
+void
+cameraEncodeTask(void* pvParameters)
+{
+    /*
+     *  Sleep until woken, the same way as the camera UDP write task.
+     */
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+    /*
+     *  Task loop.
+     */
+    for (;;)
+    {
+        /*
+         *  If the camera pipeline global shared pointer is not a null pointer, using the
+         *  camera pipeline global shared pointer, execute the encode stage. Otherwise,
+         *  wait for a fast domain period before checking again.
+         */
+        if (camera_pipeline_)
+        {
+            camera_pipeline_->encode();
+        }
+        else
+        {
+            vTaskDelay(millisecondsToTicks(secondsToMilliseconds(PeriodParameter::fast)));
+        }
+    }
+
+    /*
+     *  Delete this task upon exit.
+     */
+    vTaskDelete(nullptr);
+}
+
 void
 ioExpanderAInterruptServiceTask(void* pvParameters)
 {
@@ -428,6 +527,16 @@ networkTask(void* pvParameters)
          */
         udp_biped_message_->initialize(NetworkParameter::port_udp_biped_message);
 
+        /*
+         *  Cache the Biped ground station as the remote endpoint of the Biped
+         *  message UDP, such that its IP address is parsed only once.
+         */
+        if (!udp_biped_message_->setRemote(NetworkParameter::ip_ground_station,
+                NetworkParameter::port_udp_biped_message))
+        {
+            Serial(LogLevel::error) << "Invalid Biped ground station IP address.";
+        }
+
         /*
          *  Using the FreeRTOS xTaskNotifyGive function, wake up the Biped message UDP
          *  read and write tasks.
@@ -464,6 +573,13 @@ networkTask(void* pvParameters)
          */
 
     	xTaskNotifyGive(task_handle_udp_write_camera_);
+
+        /*
+         *  Wake up the camera capture and encode tasks, such that the camera pipeline
+         *  starts along with its transmit stage.
+         */
+        xTaskNotifyGive(task_handle_camera_capture_);
+        xTaskNotifyGive(task_handle_camera_encode_);
     }
 
     /*
@@ -484,6 +600,28 @@ networkTask(void* pvParameters)
     vTaskDelete(nullptr);
 }
 
+/**
+ *  @param  block Whether to block until a notification is given.
+ *  @return Number of notifications taken.
+ *  @brief  Take the real-time task notifications.
+ *
+ *  This function takes and clears the pending notifications of the
+ *  real-time task, blocking until the next one if the given flag is
+ *  set, or returning right away otherwise.
+ */
+static uint32_t
+takeRealTimeTaskNotification(const bool& block)
+{
+    /*
+     *  Take the notifications using the FreeRTOS ulTaskNotifyTake function, clearing the
+     *  notification value on exit (pdTRUE), such that the notification value counts the
+     *  timer interrupts given since the last take. Wait up to the maximum delay if blocking,
+     *  or not at all otherwise, returning 0 if no notification is pending. The real-time
+     *  task wait function counts the notifications taken without blocking as deadline misses.
+     */
+    return ulTaskNotifyTake(pdTRUE, block ? portMAX_DELAY : 0);
+}
+
 void
 realTimeTask(void* pvParameters)
 {
@@ -495,18 +633,12 @@ realTimeTask(void* pvParameters)
     for (;;)
     {
         /*
-         *  Sleep until woken using the FreeRTOS ulTaskNotifyTake function. Set clear count on exit
-         *  (either pdFALSE or pdTRUE defined in the FreeRTOS projdefs header) such that the
-         *  notification value acts like a binary semaphore. Set the maximum task wait time to be
-         *  maximum delay (i.e., portMAX_DELAY defined in the FreeRTOS portmacro header).
+         *  Sleep until the next fast domain period, counting the timer interrupts
+         *  that arrived during the last iteration as deadline misses.
          *
-         *  Refer to the FreeRTOS projdefs header for the project definition macros, the FreeRTOS
-         *  portmacro header for the port macros, and the FreeRTOS task header for the task functions.
-         *
-         *  TODO LAB 3 YOUR CODE HERE.
+         *  Refer to the task header for the real-time task wait function.
          */
-
-    	ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        realTimeTaskWait(&takeRealTimeTaskNotification);
 
         /*
          *  Using the Arduino micros timing function, update the start time point local variable to
@@ -518,104 +650,11 @@ realTimeTask(void* pvParameters)
     	time_point_start = micros();
 
         /*
-         *  If the sensor global shared pointer is not a null pointer, using the sensor global shared
-         *  pointer, perform fast domain sensing.
-         *
-         *  Refer to the global header for the global variables and the sensor header for the sensor
-         *  functions.
+         *  Perform a single fast domain period of sensing, control, and actuation.
          *
-         *  TODO LAB 6 YOUR CODE HERE.
+         *  Refer to the task header for the real-time task iteration function.
          */
-
-    	if (sensor_) {
-    		sensor_->sense(true);
-    	}
-
-        /*
-         *  If the controller global shared pointer is not a null pointer, using the controller global
-         *  shared pointer, perform fast domain control.
-         *
-         *  Refer to the global header for the global variables and the controller header for the
-         *  controller functions.
-         *
-         *  TODO LAB 7 YOUR CODE HERE.
-         */
-    	if (controller_) {
-    	    controller_->control(true);
-    	}
-
-        /*
-         *  Slow domain tasks.
-         */
-        if (timer_domain_ >= PeriodParameter::slow)
-        {
-            /*
-             *  If the sensor global shared pointer is not a null pointer, using the sensor global shared
-             *  pointer, perform slow domain sensing.
-             *
-             *  Refer to the global header for the global variables and the sensor header for the sensor
-             *  functions.
-             *
-             *  TODO LAB 6 YOUR CODE HERE.
-             */
-
-        	if (sensor_) {
-        		sensor_->sense(false);
-        	}
-
-            /*
-             *  If the controller global shared pointer is not a null pointer, using the controller global
-             *  shared pointer, perform slow domain control.
-             *
-             *  Refer to the global header for the global variables and the controller header for the
-             *  controller functions.
-             *
-             *  TODO LAB 7 YOUR CODE HERE.
-             */
-        	if (controller_) {
-        	    controller_->control(false);
-        	}
-
-            /*
-             *  Reset period domain timer global variable to 0.
-             *
-             *  Refer to the global header for the global variables.
-             *
-             *  TODO LAB 6 YOUR CODE HERE.
-             */
-
-        	timer_domain_ = 0;
-        }
-
-        /*
-         *  If the controller global shared pointer is not a null pointer, using the controller global
-         *  shared pointer, obtain the actuation command struct.
-         *
-         *  If the actuator global shared pointer is not a null pointer, using the actuator global
-         *  shared pointer, perform actuation using the obtained actuation command struct.
-         *
-         *  Refer to the global header for the global variables, the controller header for the
-         *  controller functions, and the actuator header for the actuator functions.
-         *
-         *  TODO LAB 7 YOUR CODE HERE.
-         */
-        if (controller_) {
-            ActuationCommand a = controller_->getActuationCommand();
-            if (actuator_) {
-                actuator_->actuate(a);
-            }
-        }
-
-        /*
-         *  Add the fast domain period to the period domain timer global variable.
-         *
-         *  Refer to the global header for the global variables and the parameter header for the
-         *  period parameters.
-         *
-         *  TODO LAB 6 YOUR CODE HERE.
-         */
-
-        timer_domain_ += PeriodParameter::fast;
+        realTimeTaskIteration();
 
         /*
          *  Calculate the real-time task execution time by subtracting the current time in microseconds,
@@ -628,6 +667,11 @@ realTimeTask(void* pvParameters)
          */
 //        delayMicroseconds(2500);
         execution_time_real_time_task_ = micros() - time_point_start;
+
+        /*
+         *  Record the real-time task execution time.
+         */
+        histogram_execution_time_real_time_task_.record(execution_time_real_time_task_);
     }
 
     /*
@@ -704,6 +748,35 @@ udpReadBipedMessageTask(void* pvParameters)
             continue;
         }
 
+        /*
+         *  Apply a command message, and skip the current iteration.
+         */
+        if (static_cast<uint8_t>(message.front()) == static_cast<uint8_t>(MessageType::command_message))
+        {
+            readCommandMessage(reinterpret_cast<const unsigned char*>(message.data()), message.size());
+            continue;
+        }
+
+        /*
+         *  Apply the telemetry subscription of a subscription message, and
+         *  skip the current iteration.
+         */
+        if (static_cast<uint8_t>(message.front()) == static_cast<uint8_t>(MessageType::subscription_message))
+        {
+            readSubscriptionMessage(reinterpret_cast<const unsigned char*>(message.data()), message.size());
+            continue;
+        }
+
+        /*
+         *  Execute the camera rate controller upon a camera feedback message,
+         *  and skip the current iteration.
+         */
+        if (static_cast<uint8_t>(message.front()) == static_cast<uint8_t>(MessageType::camera_feedback_message))
+        {
+            readCameraFeedbackMessage(reinterpret_cast<const unsigned char*>(message.data()), message.size());
+            continue;
+        }
+
         /*
          *  Declare deserialized Biped message struct, serialized message buffer,
          *  and the deserializer.
@@ -779,11 +852,26 @@ udpWriteBipedMessageTask(void* pvParameters)
 
 	ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
 
+    /*
+     *  Declare the wake time, initialized to the current tick count, and the
+     *  numbers of frame periods since the last status and parameter messages.
+     */
+    TickType_t time_wake = xTaskGetTickCount();
+    uint32_t frame_count_parameter_message = 0;
+    uint32_t frame_count_status_message = 0;
+
     /*
      *  Task loop.
      */
     for (;;)
     {
+        /*
+         *  Sleep until the next telemetry frame period, such that the telemetry is
+         *  written at a fixed rate instead of as fast as the task can loop.
+         */
+        vTaskDelayUntil(&time_wake,
+                millisecondsToTicks(secondsToMilliseconds(TelemetryParameter::period_frame)));
+
         /*
          *  Skip the current iteration if the Wi-Fi global shared pointer is a null pointer or the
          *  Wi-Fi status is not connected (i.e., not WL_CONNECTED defined in wl_status_t enum in the
@@ -799,108 +887,27 @@ udpWriteBipedMessageTask(void* pvParameters)
         }
 
         /*
-         *  Declare Biped message struct, serialized message buffer, static message sequence,
-         *  and the serializer.
+         *  Drain the telemetry samples of the real-time task ticks since the last
+         *  iteration into telemetry frames, and write them.
          */
-        BipedMessage message;
-        std::vector<unsigned char> message_serialized;
-        static unsigned long long sequence = 0;
-        zpp::serializer::memory_output_archive serializer(message_serialized);
+        udpWriteTelemetryFrameTaskIteration();
 
         /*
-         *  Set the sequence in the Biped message struct as the static message sequence local
-         *  variable and the timestamp in the Biped message struct local variable as the current
-         *  time in microseconds, obtained using the Arduino micros timing function.
-         *
-         *  TODO LAB 5 YOUR CODE HERE.
+         *  Populate, serialize, and write the status message struct every status
+         *  message period, and the parameter message struct every parameter
+         *  message period.
          */
-        message.sequence = sequence;
-        message.timestamp = micros();
-
-        /*
-         *  If the sensor global shared pointer is not a null pointer, using the sensor global
-         *  shared pointer, obtain the encoder, IMU, and time-of-flight data structs and set
-         *  them to the encoder, IMU, and time-of-flight data structs in the Biped message struct
-         *  local variable.
-         *
-         *  Refer to the sensor header for the sensor functions, the type header for Biped
-         *  message struct entries, and the global header for the global variables.
-         *
-         *  TODO LAB 5 YOUR CODE HERE.
-         */
-        if (sensor_) {
-            message.encoder_data = sensor_->getEncoderData();
-            message.imu_data = sensor_->getIMUData();
-            message.time_of_flight_data = sensor_->getTimeOfFlightData();
-        }
-
-        /*
-         *  If the controller global shared pointer is not a null pointer, using the controller global
-         *  shared pointer, obtain the controller parameter and controller reference structs and set
-         *  them to the controller parameter and controller reference structs in the Biped message struct
-         *  local variable.
-         *
-         *  Refer to the controller header for the controller functions, the type header for Biped
-         *  message struct entries, and the global header for the global variables.
-         *
-         *  TODO LAB 5 YOUR CODE HERE.
-         */
-        if (controller_) {
-            message.controller_parameter = controller_->getControllerParameter();
-            message.controller_reference = controller_->getControllerReference();
-        }
-
-        /*
-         *  If the actuator global shared pointer is not a null pointer, using the actuator global
-         *  shared pointer, obtain the actuation command struct and set it to the actuation command
-         *  struct in the Biped message struct local variable.
-         *
-         *  Refer to the actuator header for the actuator functions, the type header for Biped
-         *  message struct entries, and the global header for the global variables.
-         *
-         *  TODO LAB 5 YOUR CODE HERE.
-         */
-        if (actuator_) {
-            message.actuation_command = actuator_->getActuationCommand();
-        }
-
-        /*
-         *  Serialize the Biped message struct into the serialized message buffer.
-         */
-        const auto result = serializer(message);
-
-        if (result)
+        if (++ frame_count_status_message >= TelemetryParameter::divisor_status_message)
         {
-            /*
-             *  Using the Biped message UDP global shared pointer, write the serialized message buffer
-             *  to the Biped ground station.
-             *
-             *  Note that the serialized message buffer can be converted into a string using its iterator.
-             *
-             *  Refer to the UDP header for the UDP functions, the parameter header for the network
-             *  parameters, and the global header for the global variables.
-             *
-             *  TODO LAB 5 YOUR CODE HERE.
-             */
-
-            std::string res(message_serialized.begin(), message_serialized.end());
-
-            udp_biped_message_->write(NetworkParameter::ip_ground_station, NetworkParameter::port_udp_biped_message, res);
+            frame_count_status_message = 0;
+            udpWriteStatusMessageTaskIteration();
         }
-        else
+
+        if (++ frame_count_parameter_message >= TelemetryParameter::divisor_parameter_message)
         {
-            /*
-             *  Print warning message to serial upon serialization failure. Otherwise,
-             */
-            Serial(LogLevel::warn) << "Failed to serialize Biped message.";
+            frame_count_parameter_message = 0;
+            udpWriteParameterMessageTaskIteration();
         }
-
-        /*
-         *  Increment the static message sequence local variable.
-         *
-         *  TODO LAB 5 YOUR CODE HERE.
-         */
-        sequence++;
     }
 
     /*
@@ -953,7 +960,29 @@ udpWriteCameraTask(void* pvParameters)
          *
          *  TODO LAB 5 YOUR CODE HERE.
          */
-        if (camera_) {
+        if (camera_pipeline_)
+        {
+            /*
+             *  Execute the transmit stage of the camera pipeline, and record the
+             *  per-stage execution times and the latency of the transmitted camera
+             *  frame.
+             */
+            CameraFrame frame;
+
+            if (camera_pipeline_->transmit(frame, udp_camera_, NetworkParameter::ip_ground_station,
+                    NetworkParameter::port_udp_camera))
+            {
+                histogram_execution_time_camera_capture_.record(frame.execution_time_capture);
+                histogram_execution_time_camera_encode_.record(frame.execution_time_encode);
+                histogram_execution_time_camera_transmit_.record(frame.execution_time_transmit);
+                histogram_latency_camera_.record(frame.latency);
+                frame_count_camera_ ++;
+            }
+
+            frame_count_dropped_camera_ = camera_pipeline_->getDropCount();
+        }
+        else if (camera_)
+        {
             camera_->SendJPGFrameOverUDP(udp_camera_, NetworkParameter::ip_ground_station, NetworkParameter::port_udp_camera);
         }
     }
@@ -13,6 +13,11 @@
 #ifndef TASK_TASK_H_
 #define TASK_TASK_H_
 
+/*
+ *  External headers.
+ */
+#include <cstdint>
+
 /*
  *  Biped namespace.
  */
@@ -36,6 +41,35 @@ namespace firmware
 void
 bestEffortTask();
 
+/**
+ *  @param  pvParameters Function argument pointer.
+ *  @brief  Camera capture task function.
+ *
+ *  This function executes the capture stage of the camera
+ *  pipeline, i.e., waits for a free camera frame buffer and
+ *  captures the latest camera frame into it, at the frame rate of
+ *  the camera setting published by the camera rate controller,
+ *  which the function applies to the camera upon a change. The
+ *  camera capture task has the lowest priority and runs on the
+ *  core opposite to the real-time task. The function goes to sleep
+ *  until woken.
+ */
+void
+cameraCaptureTask(void* pvParameters);
+
+/**
+ *  @param  pvParameters Function argument pointer.
+ *  @brief  Camera encode task function.
+ *
+ *  This function executes the encode stage of the camera
+ *  pipeline, i.e., converts each captured camera frame into JPG
+ *  if necessary. The camera encode task has the lowest priority
+ *  and runs on the core opposite to the real-time task. The
+ *  function goes to sleep until woken.
+ */
+void
+cameraEncodeTask(void* pvParameters);
+
 /**
  *  @param  pvParameters Function argument pointer.
  *  @brief  I/O expander A interrupt service task function.
@@ -79,8 +113,8 @@ networkTask(void* pvParameters);
  *  @brief  Real-time task function.
  *
  *  This function performs the real-time task with strict timing
- *  deadlines. There are two timing domains, a fast domain and
- *  a slow domain. The real-time task has a high priority but
+ *  deadlines. The real-time task scheduler ticks every fast domain
+ *  period and runs the periodic jobs at multiples of it. The real-time task has a high priority but
  *  may be preempted by any tasks with the same or higher
  *  priorities or by priority inheritance. The function goes to
  *  sleep until woken.
@@ -96,6 +130,49 @@ networkTask(void* pvParameters);
 void
 realTimeTask(void* pvParameters);
 
+/**
+ *  @brief  Real-time task initialization function.
+ *
+ *  This function registers the sensing and control jobs of the
+ *  real-time task to the real-time task scheduler, with their
+ *  periods and phases from the scheduler parameters. The function
+ *  must be called once, before the timer starts.
+ */
+void
+realTimeTaskInitialization();
+
+/**
+ *  @brief  Real-time task iteration function.
+ *
+ *  This function performs a single fast domain period of the
+ *  real-time task, i.e., a tick of the real-time task scheduler,
+ *  running the sensing and control jobs due at the tick, followed
+ *  by actuation. The function does not depend on the hardware or
+ *  on FreeRTOS and is called both by the real-time task function
+ *  and by the host simulator.
+ */
+void
+realTimeTaskIteration();
+
+/**
+ *  @param  take Task notification take function, taking and clearing the
+ *  pending notifications of the real-time task, and blocking until the next
+ *  one if the given flag is set.
+ *  @brief  Real-time task wait function.
+ *
+ *  This function waits for the next fast domain period of the real-time
+ *  task. The notifications pending upon the call were given by the timer
+ *  interrupts that arrived while the last iteration was still running, each
+ *  a deadline miss. They are counted once and cleared, and the function
+ *  returns right away, such that the real-time task runs one late iteration
+ *  rather than catching up on every missed period. Otherwise, the function
+ *  blocks until the next timer interrupt. The function does not depend on
+ *  FreeRTOS and is called both by the real-time task function and by the
+ *  host deadline miss harness.
+ */
+void
+realTimeTaskWait(uint32_t (*take)(const bool& block));
+
 /**
  *  @param  pvParameters Function argument pointer.
  *  @brief  Biped message UDP read task function.
@@ -116,17 +193,111 @@ udpReadBipedMessageTask(void* pvParameters);
  *  Biped message struct to the UDP. The Biped message UDP write task has
  *  the lowest priority and may be preempted by any tasks with the same or
  *  higher priorities.
+ *
+ *  The task writes the telemetry frames every telemetry frame period, the
+ *  status message every status message period, and the parameter message
+ *  every parameter message period.
  */
 void
 udpWriteBipedMessageTask(void* pvParameters);
 
+/**
+ *  @brief  Parameter message UDP write task iteration function.
+ *
+ *  This function populates a parameter message struct with the
+ *  controller parameter struct, and writes it the same way as the
+ *  status message UDP write task iteration function.
+ */
+void
+udpWriteParameterMessageTaskIteration();
+
+/**
+ *  @brief  Status message UDP write task iteration function.
+ *
+ *  This function populates a status message struct, serializes it
+ *  into a preallocated static buffer, and writes the serialized
+ *  bytes to the remote endpoint of the Biped message UDP, without
+ *  allocating memory. The function does not depend on the hardware
+ *  or on FreeRTOS and is called both by the Biped message UDP write
+ *  task function and by the host telemetry harness.
+ */
+void
+udpWriteStatusMessageTaskIteration();
+
+/**
+ *  @param  message Serialized command message pointer.
+ *  @param  size Size of the serialized command message, in bytes.
+ *  @return Whether the command message was applied.
+ *  @brief  Command message read function.
+ *
+ *  This function deserializes a command message from the Biped
+ *  ground station without allocating memory, applies it only if
+ *  it is the next command message of its session, and publishes
+ *  the command acknowledgement to the status message UDP write
+ *  task iteration function. Duplicated and out-of-order command
+ *  messages are ignored, such that the Biped ground station may
+ *  retransmit until acknowledged. The function is called both by
+ *  the Biped message UDP read task function and by the host command
+ *  harness.
+ */
+bool
+readCommandMessage(const unsigned char* message, const size_t& size);
+
+/**
+ *  @param  message Serialized subscription message pointer.
+ *  @param  size Size of the serialized subscription message, in bytes.
+ *  @return Whether the subscription message was applied.
+ *  @brief  Subscription message read function.
+ *
+ *  This function deserializes a subscription message from the
+ *  Biped ground station without allocating memory, and publishes
+ *  its telemetry subscription to the telemetry frame UDP write task
+ *  iteration function. The function is called both by the Biped
+ *  message UDP read task function and by the host telemetry harness.
+ */
+bool
+readSubscriptionMessage(const unsigned char* message, const size_t& size);
+
+/**
+ *  @param  message Serialized camera feedback message pointer.
+ *  @param  size Size of the serialized camera feedback message, in bytes.
+ *  @return Whether the camera feedback message was applied.
+ *  @brief  Camera feedback message read function.
+ *
+ *  This function deserializes a camera feedback message from the
+ *  Biped ground station without allocating memory, executes the
+ *  camera rate controller, and publishes the camera setting to the
+ *  camera capture task function. The function is called both by the
+ *  Biped message UDP read task function and by the host camera rate
+ *  harness.
+ */
+bool
+readCameraFeedbackMessage(const unsigned char* message, const size_t& size);
+
+/**
+ *  @brief  Telemetry frame UDP write task iteration function.
+ *
+ *  This function drains the telemetry sample ring buffer, packs
+ *  the samples into telemetry frames of the telemetry frame sample
+ *  count, and writes each full frame, carrying only the fields of
+ *  the current telemetry subscription, to the remote endpoint of the
+ *  Biped message UDP, without allocating memory. A partial frame is
+ *  kept until the next call. The function does not depend on the
+ *  hardware or on FreeRTOS and is called both by the Biped message
+ *  UDP write task function and by the host telemetry harness.
+ */
+void
+udpWriteTelemetryFrameTaskIteration();
+
 /**
  *  @param  pvParameters Function argument pointer.
  *  @brief  Camera UDP write task function.
  *
- *  This function serializes camera frames and writes serialized camera
- *  frames to the UDP. The camera UDP write task has the lowest priority
- *  and may be preempted by any tasks with the same or higher priorities.
+ *  This function executes the transmit stage of the camera pipeline,
+ *  i.e., writes each encoded camera frame to the UDP, and records the
+ *  camera pipeline statistics. The camera UDP write task has the lowest
+ *  priority, runs on the core opposite to the real-time task, and may
+ *  be preempted by any tasks with the same or higher priorities.
  */
 void
 udpWriteCameraTask(void* pvParameters);
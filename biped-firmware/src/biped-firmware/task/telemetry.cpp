@@ -0,0 +1,449 @@
+/**
+ *  @file   telemetry.cpp
+ *  @author Simon Yu
+ *  @date   01/29/2022
+ *  @brief  Biped message UDP write task iteration function source.
+ *
+ *  This file implements the hardware-independent status message,
+ *  parameter message, and telemetry frame UDP write task iteration
+ *  functions, as well as the command, subscription, and camera
+ *  feedback message read functions.
+ */
+
+/*
+ *  External headers.
+ */
+#include <Arduino.h>
+#include <array>
+
+/*
+ *  Project headers.
+ */
+#include "actuator/actuator.h"
+#include "common/global.h"
+#include "common/parameter.h"
+#include "controller/camera_rate_controller.h"
+#include "controller/controller.h"
+#include "network/udp.h"
+#include "planner/planner.h"
+#include "platform/serial.h"
+#include "sensor/sensor.h"
+#include "task/task.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+void
+udpWriteParameterMessageTaskIteration()
+{
+    /*
+     *  Declare parameter message struct, static serialized message buffer, static message
+     *  sequence, and the serializer, the same way as the status message.
+     */
+    ParameterMessage message;
+    static std::array<unsigned char, NetworkParameter::buffer_size_biped_message> message_serialized;
+    static unsigned long long sequence = 0;
+    zpp::serializer::memory_view_output_archive serializer(message_serialized);
+
+    message.sequence = sequence ++;
+
+    if (controller_)
+    {
+        message.controller_parameter = controller_->getControllerParameter();
+    }
+
+    if (!serializer(message))
+    {
+        Serial(LogLevel::warn) << "Failed to serialize parameter message.";
+        return;
+    }
+
+    if (udp_biped_message_)
+    {
+        udp_biped_message_->writeBuffer(message_serialized.data(), serializer.offset());
+    }
+}
+
+void
+udpWriteStatusMessageTaskIteration()
+{
+    /*
+     *  Declare status message struct, static serialized message buffer, static message
+     *  sequence, and the serializer. The serializer writes into the preallocated static
+     *  serialized message buffer, such that no memory is allocated per message.
+     */
+    StatusMessage message;
+    static std::array<unsigned char, NetworkParameter::buffer_size_biped_message> message_serialized;
+    static unsigned long long sequence = 0;
+    zpp::serializer::memory_view_output_archive serializer(message_serialized);
+
+    /*
+     *  Set the sequence in the status message struct as the static message sequence local
+     *  variable and the timestamp in the status message struct local variable as the current
+     *  time in microseconds, obtained using the Arduino micros timing function.
+     *
+     *  TODO LAB 5 YOUR CODE HERE.
+     */
+    message.sequence = sequence;
+    message.timestamp = micros();
+
+    /*
+     *  If the sensor global shared pointer is not a null pointer, using the sensor global
+     *  shared pointer, obtain the encoder, IMU, and time-of-flight data structs and set
+     *  them to the sensor entries in the status message struct local variable.
+     *
+     *  Refer to the sensor header for the sensor functions, the type header for status
+     *  message struct entries, and the global header for the global variables.
+     *
+     *  TODO LAB 5 YOUR CODE HERE.
+     */
+    if (sensor_) {
+        message.setSensorData(sensor_->getEncoderData(), sensor_->getIMUData(),
+                sensor_->getTimeOfFlightData());
+    }
+
+    /*
+     *  If the controller global shared pointer is not a null pointer, using the controller global
+     *  shared pointer, obtain the controller reference struct and set it to the telemetry sample
+     *  in the status message struct local variable. The controller parameter struct is sent in
+     *  the parameter message instead.
+     *
+     *  Refer to the controller header for the controller functions, the type header for status
+     *  message struct entries, and the global header for the global variables.
+     *
+     *  TODO LAB 5 YOUR CODE HERE.
+     */
+    if (controller_) {
+        message.sample.setControllerReference(controller_->getControllerReference());
+    }
+
+    /*
+     *  If the actuator global shared pointer is not a null pointer, using the actuator global
+     *  shared pointer, obtain the actuation command struct and set it to the telemetry sample
+     *  in the status message struct local variable.
+     *
+     *  Refer to the actuator header for the actuator functions, the type header for status
+     *  message struct entries, and the global header for the global variables.
+     *
+     *  TODO LAB 5 YOUR CODE HERE.
+     */
+    if (actuator_) {
+        message.sample.setActuationCommand(actuator_->getActuationCommand());
+    }
+
+    /*
+     *  Acknowledge the last applied command message.
+     */
+    message.acknowledgement = seqlock_command_acknowledgement_.read();
+
+    /*
+     *  Populate the telemetry struct with the real-time task timing statistics
+     *  collected from the timing histograms, such that each status message covers
+     *  the window between the previous two, without losing a sample in between.
+     */
+    message.telemetry.deadline_miss = deadline_miss_real_time_task_;
+    message.telemetry.execution_time = histogram_execution_time_real_time_task_.collectStatistics();
+    message.telemetry.execution_time_actuate = histogram_execution_time_actuate_.collectStatistics();
+    message.telemetry.execution_time_control = histogram_execution_time_control_.collectStatistics();
+    message.telemetry.execution_time_sense_fast = histogram_execution_time_sense_fast_.collectStatistics();
+    message.telemetry.execution_time_sense_slow = histogram_execution_time_sense_slow_.collectStatistics();
+    message.telemetry.interval = histogram_interval_real_time_task_.collectStatistics();
+
+    /*
+     *  Populate the camera telemetry struct the same way, such that the real-time
+     *  task interference of the camera pipeline shows in the same status message.
+     */
+    message.telemetry.camera.frame_count = frame_count_camera_;
+    message.telemetry.camera.frame_count_dropped = frame_count_dropped_camera_;
+    message.telemetry.camera.execution_time_capture = histogram_execution_time_camera_capture_.collectStatistics();
+    message.telemetry.camera.execution_time_encode = histogram_execution_time_camera_encode_.collectStatistics();
+    message.telemetry.camera.execution_time_transmit = histogram_execution_time_camera_transmit_.collectStatistics();
+    message.telemetry.camera.latency = histogram_latency_camera_.collectStatistics();
+    message.telemetry.camera.setting = seqlock_camera_setting_.read();
+    message.telemetry.camera.budget = budget_camera_;
+
+    /*
+     *  Serialize the status message struct into the serialized message buffer.
+     */
+    const auto result = serializer(message);
+
+    if (result)
+    {
+        /*
+         *  Using the Biped message UDP global shared pointer, write the serialized message buffer
+         *  to the Biped ground station.
+         *
+         *  Write only the serialized bytes of the serialized message buffer to the remote
+         *  endpoint cached by the network task, without copying the buffer into a string or
+         *  parsing the Biped ground station IP address per message.
+         *
+         *  Refer to the UDP header for the UDP functions, the parameter header for the network
+         *  parameters, and the global header for the global variables.
+         *
+         *  TODO LAB 5 YOUR CODE HERE.
+         */
+        if (udp_biped_message_)
+        {
+            udp_biped_message_->writeBuffer(message_serialized.data(), serializer.offset());
+        }
+    }
+    else
+    {
+        /*
+         *  Print warning message to serial upon serialization failure. Otherwise,
+         */
+        Serial(LogLevel::warn) << "Failed to serialize status message.";
+    }
+
+    /*
+     *  Increment the static message sequence local variable.
+     *
+     *  TODO LAB 5 YOUR CODE HERE.
+     */
+    sequence++;
+}
+
+bool
+readCommandMessage(const unsigned char* message, const size_t& size)
+{
+    CommandMessage message_deserialized;
+    zpp::serializer::memory_view_input_archive deserializer(message, size);
+
+    /*
+     *  Deserialize the command message, which fails if its command type is
+     *  invalid. Session 0 is reserved for no session.
+     */
+    if (!deserializer(message_deserialized) || message_deserialized.session == 0)
+    {
+        Serial(LogLevel::warn) << "Failed to deserialize command message.";
+        return false;
+    }
+
+    /*
+     *  Start over upon the first command message of a new session, e.g., a
+     *  restarted Biped ground station, and apply the command message only if
+     *  it is the next one of the session. Duplicated command messages have
+     *  been applied already, and those after a lost one, or delayed ones of
+     *  a previous session, wait for their retransmission or are dropped, such
+     *  that the command messages of a session are applied exactly once and in
+     *  order. The acknowledgement is published either way, such that the
+     *  Biped ground station starts a new session if the Biped firmware
+     *  restarted in the middle of its session.
+     */
+    CommandAcknowledgement acknowledgement = seqlock_command_acknowledgement_.read();
+
+    if (message_deserialized.session != acknowledgement.session
+            && message_deserialized.sequence == 1)
+    {
+        acknowledgement.sequence = 0;
+        acknowledgement.session = message_deserialized.session;
+    }
+
+    const bool applied = message_deserialized.session == acknowledgement.session
+            && message_deserialized.sequence == acknowledgement.sequence + 1;
+
+    if (applied && message_deserialized.type == CommandType::start_plan)
+    {
+        if (planner_)
+        {
+            planner_->start();
+        }
+    }
+    else if (applied && message_deserialized.type == CommandType::set_reference)
+    {
+        if (controller_)
+        {
+            controller_->setControllerReference(message_deserialized.reference);
+        }
+    }
+    else if (applied && controller_)
+    {
+        /*
+         *  Change only the entry of the command type in the current controller
+         *  parameter struct, such that the controller only resets the integrated
+         *  error of the PID controller whose gain changed.
+         */
+        ControllerParameter controller_parameter = controller_->getControllerParameter();
+
+        switch (message_deserialized.type)
+        {
+            case CommandType::set_gain_attitude_y:
+            {
+                controller_parameter.pid_controller_gain_attitude_y = message_deserialized.gain;
+                break;
+            }
+            case CommandType::set_gain_attitude_z:
+            {
+                controller_parameter.pid_controller_gain_attitude_z = message_deserialized.gain;
+                break;
+            }
+            case CommandType::set_gain_open_loop_attitude_z:
+            {
+                controller_parameter.attitude_z_gain_open_loop = message_deserialized.gain_open_loop;
+                break;
+            }
+            case CommandType::set_gain_position_x:
+            {
+                controller_parameter.pid_controller_gain_position_x = message_deserialized.gain;
+                break;
+            }
+            case CommandType::set_mode:
+            {
+                controller_parameter.mode = message_deserialized.mode;
+                break;
+            }
+            case CommandType::set_saturation_position_x:
+            {
+                controller_parameter.pid_controller_saturation_position_x = message_deserialized.saturation;
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        controller_->setControllerParameter(controller_parameter);
+    }
+
+    if (applied)
+    {
+        acknowledgement.sequence = message_deserialized.sequence;
+    }
+
+    seqlock_command_acknowledgement_.write(acknowledgement);
+    return applied;
+}
+
+bool
+readSubscriptionMessage(const unsigned char* message, const size_t& size)
+{
+    SubscriptionMessage message_deserialized;
+    zpp::serializer::memory_view_input_archive deserializer(message, size);
+
+    /*
+     *  Deserialize the subscription message, which fails if its telemetry
+     *  subscription is invalid, and publish the telemetry subscription.
+     */
+    if (!deserializer(message_deserialized))
+    {
+        Serial(LogLevel::warn) << "Failed to deserialize subscription message.";
+        return false;
+    }
+
+    seqlock_telemetry_subscription_.write(message_deserialized.subscription);
+    return true;
+}
+
+bool
+readCameraFeedbackMessage(const unsigned char* message, const size_t& size)
+{
+    CameraFeedbackMessage message_deserialized;
+    zpp::serializer::memory_view_input_archive deserializer(message, size);
+
+    /*
+     *  If the camera rate controller shared pointer is a null pointer, return.
+     */
+    if (!camera_rate_controller_)
+    {
+        return false;
+    }
+
+    /*
+     *  Deserialize the camera feedback message, which fails if its window is
+     *  empty.
+     */
+    if (!deserializer(message_deserialized))
+    {
+        Serial(LogLevel::warn) << "Failed to deserialize camera feedback message.";
+        return false;
+    }
+
+    /*
+     *  Execute the camera rate controller, and publish the camera setting and
+     *  the camera bandwidth budget.
+     */
+    if (camera_rate_controller_->update(message_deserialized))
+    {
+        seqlock_camera_setting_.write(camera_rate_controller_->getSetting());
+    }
+
+    budget_camera_ = static_cast<uint32_t>(camera_rate_controller_->getBudget());
+    return true;
+}
+
+void
+udpWriteTelemetryFrameTaskIteration()
+{
+    static_assert(TelemetryParameter::sample_count_frame > 0
+            && TelemetryParameter::sample_count_frame <= TelemetryFrame::capacity,
+            "Invalid number of telemetry samples per frame.");
+
+    /*
+     *  Declare the static telemetry frame struct, static serialized frame buffer, and
+     *  static frame sequence. The telemetry frame struct is static, such that a partial
+     *  frame is kept and completed by the next call.
+     */
+    static TelemetryFrame frame;
+    static std::array<unsigned char, NetworkParameter::buffer_size_telemetry_frame> frame_serialized;
+    static unsigned long long sequence = 0;
+
+    for (;;)
+    {
+        /*
+         *  Read the current telemetry subscription when starting a new telemetry
+         *  frame, such that all samples of a frame carry the same fields.
+         */
+        if (frame.sample_count == 0)
+        {
+            seqlock_telemetry_subscription_.read(frame.subscription);
+        }
+
+        /*
+         *  Pop the telemetry samples from the ring buffer into the telemetry
+         *  frame until it is full, or until the ring buffer is empty.
+         */
+        while (frame.sample_count < TelemetryParameter::sample_count_frame
+                && ring_buffer_telemetry_sample_.pop(frame.samples[frame.sample_count]))
+        {
+            frame.sample_count ++;
+        }
+
+        if (frame.sample_count < TelemetryParameter::sample_count_frame)
+        {
+            break;
+        }
+
+        /*
+         *  Serialize the subscribed fields of the full telemetry frame struct into the
+         *  serialized frame buffer and write it to the remote endpoint of the Biped
+         *  message UDP.
+         */
+        zpp::serializer::memory_view_output_archive serializer(frame_serialized);
+        frame.overflow = ring_buffer_telemetry_sample_.getOverflow();
+        frame.sequence = sequence ++;
+
+        if (serializer(frame))
+        {
+            if (udp_biped_message_)
+            {
+                udp_biped_message_->writeBuffer(frame_serialized.data(), serializer.offset());
+            }
+        }
+        else
+        {
+            Serial(LogLevel::warn) << "Failed to serialize telemetry frame.";
+        }
+
+        frame.sample_count = 0;
+    }
+}
+}   // namespace firmware
+}   // namespace biped
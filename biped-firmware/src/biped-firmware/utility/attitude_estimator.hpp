@@ -0,0 +1,301 @@
+/**
+ *  @file   attitude_estimator.hpp
+ *  @author Simon Yu
+ *  @date   01/26/2022
+ *  @brief  Attitude estimator templated class header.
+ *
+ *  This file defines and implements the attitude estimator
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_ATTITUDE_ESTIMATOR_H_
+#define UTILITY_ATTITUDE_ESTIMATOR_H_
+
+/*
+ *  External headers.
+ */
+#include <cmath>
+#include <cstddef>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of data for estimation.
+ *  @brief  Attitude estimator templated class.
+ *
+ *  This templated class provides functions for estimating the
+ *  three-axis attitude (roll, pitch, and yaw) and the gyroscope
+ *  biases using a Mahony complementary filter on the unit
+ *  quaternion, fusing the angular velocities measured by the
+ *  gyroscope with the gravity direction measured by the
+ *  accelerometer.
+ *
+ *  Every update rotates the quaternion by the angular velocities,
+ *  corrected by a proportional-integral feedback of the error
+ *  between the measured and the estimated gravity directions. The
+ *  integral feedback converges to the negated gyroscope biases. The
+ *  state is a quaternion and three biases on the stack, and an
+ *  update costs a few dozen multiplications and a square root.
+ *
+ *  The attitudes follow the standard body reference frame with the
+ *  Z axis pointing up, i.e., the accelerometer measures positive
+ *  Z acceleration at rest, and the roll, pitch, and yaw angles are
+ *  the Z-Y-X Euler angles. Without a compass, the Z attitude (yaw)
+ *  is the integral of the corrected angular velocities, and the Z
+ *  gyroscope bias is only observable while the body is tilted.
+ *
+ *  Learn more about the Mahony filter here:
+ *  https://hal.science/hal-00488376/document
+ */
+template<typename Type>
+class AttitudeEstimator
+{
+public:
+
+    /**
+     *  @brief  Attitude estimator templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  with the body level and the biases zero.
+     */
+    inline
+    AttitudeEstimator() : q_ { 1, 0, 0, 0 }, integral_ { }, gain_integral_(0),
+            gain_proportional_(0)
+    {
+    }
+
+    /**
+     *  @param  gain_proportional Proportional gain, in radians per second.
+     *  @param  gain_integral Integral gain, in radians per second squared.
+     *  @brief  Set the feedback gains.
+     *
+     *  This function sets the proportional and integral gains of the
+     *  gravity direction error feedback. The proportional gain is the
+     *  crossover frequency between the gyroscope and the accelerometer.
+     */
+    inline void
+    setGains(const Type& gain_proportional, const Type& gain_integral)
+    {
+        gain_proportional_ = gain_proportional;
+        gain_integral_ = gain_integral;
+    }
+
+    /**
+     *  @param  acceleration_x X acceleration.
+     *  @param  acceleration_y Y acceleration.
+     *  @param  acceleration_z Z acceleration.
+     *  @brief  Initialize the attitude from the accelerometer.
+     *
+     *  This function sets the X and Y attitudes directly from the
+     *  given accelerations, assuming the body is at rest, and resets
+     *  the Z attitude and the biases to zero.
+     */
+    inline void
+    initialize(const Type& acceleration_x, const Type& acceleration_y, const Type& acceleration_z)
+    {
+        using std::atan2;
+        using std::cos;
+        using std::sin;
+        using std::sqrt;
+
+        const Type attitude_x = atan2(acceleration_y, acceleration_z);
+        const Type attitude_y = atan2(-acceleration_x,
+                sqrt(acceleration_y * acceleration_y + acceleration_z * acceleration_z));
+        const Type cos_x = cos(attitude_x / 2);
+        const Type sin_x = sin(attitude_x / 2);
+        const Type cos_y = cos(attitude_y / 2);
+        const Type sin_y = sin(attitude_y / 2);
+
+        q_[0] = cos_x * cos_y;
+        q_[1] = sin_x * cos_y;
+        q_[2] = cos_x * sin_y;
+        q_[3] = -sin_x * sin_y;
+
+        for (auto& integral : integral_)
+        {
+            integral = 0;
+        }
+    }
+
+    /**
+     *  @param  angular_velocity_x X angular velocity, in radians per second.
+     *  @param  angular_velocity_y Y angular velocity, in radians per second.
+     *  @param  angular_velocity_z Z angular velocity, in radians per second.
+     *  @param  acceleration_x X acceleration.
+     *  @param  acceleration_y Y acceleration.
+     *  @param  acceleration_z Z acceleration.
+     *  @param  period Period since the last update, in seconds.
+     *  @brief  Update the attitude estimate.
+     *
+     *  This function corrects the given angular velocities using the
+     *  gravity direction measured by the given accelerations, and
+     *  integrates the corrected angular velocities over the given period.
+     *  The accelerations may be in any unit, as only their direction is
+     *  used. With zero accelerations, e.g., in free fall, the angular
+     *  velocities are integrated without correction.
+     */
+    inline void
+    update(const Type& angular_velocity_x, const Type& angular_velocity_y,
+            const Type& angular_velocity_z, const Type& acceleration_x,
+            const Type& acceleration_y, const Type& acceleration_z, const Type& period)
+    {
+        using std::sqrt;
+
+        Type omega[3] = { angular_velocity_x, angular_velocity_y, angular_velocity_z };
+        const Type norm = sqrt(acceleration_x * acceleration_x + acceleration_y * acceleration_y
+                + acceleration_z * acceleration_z);
+
+        if (norm > Type(0))
+        {
+            /*
+             *  Estimate the gravity direction in the body frame, i.e.,
+             *  the third row of the rotation matrix of the quaternion.
+             */
+            const Type gravity[3] = {
+                    2 * (q_[1] * q_[3] - q_[0] * q_[2]),
+                    2 * (q_[0] * q_[1] + q_[2] * q_[3]),
+                    q_[0] * q_[0] - q_[1] * q_[1] - q_[2] * q_[2] + q_[3] * q_[3] };
+            const Type acceleration[3] = {
+                    acceleration_x / norm, acceleration_y / norm, acceleration_z / norm };
+
+            /*
+             *  The error is the cross product of the measured and the
+             *  estimated gravity directions, i.e., the axis and the sine
+             *  of the angle rotating the estimate onto the measurement.
+             */
+            const Type error[3] = {
+                    acceleration[1] * gravity[2] - acceleration[2] * gravity[1],
+                    acceleration[2] * gravity[0] - acceleration[0] * gravity[2],
+                    acceleration[0] * gravity[1] - acceleration[1] * gravity[0] };
+
+            for (size_t i = 0; i < 3; i ++)
+            {
+                integral_[i] += gain_integral_ * error[i] * period;
+                omega[i] += gain_proportional_ * error[i] + integral_[i];
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < 3; i ++)
+            {
+                omega[i] += integral_[i];
+            }
+        }
+
+        /*
+         *  Integrate the quaternion derivative, i.e., half the
+         *  quaternion multiplied by the corrected angular velocities.
+         */
+        const Type half_period = period / 2;
+        const Type q[4] = { q_[0], q_[1], q_[2], q_[3] };
+        q_[0] += (-q[1] * omega[0] - q[2] * omega[1] - q[3] * omega[2]) * half_period;
+        q_[1] += (q[0] * omega[0] + q[2] * omega[2] - q[3] * omega[1]) * half_period;
+        q_[2] += (q[0] * omega[1] - q[1] * omega[2] + q[3] * omega[0]) * half_period;
+        q_[3] += (q[0] * omega[2] + q[1] * omega[1] - q[2] * omega[0]) * half_period;
+
+        /*
+         *  Renormalize the quaternion.
+         */
+        const Type norm_q = sqrt(q_[0] * q_[0] + q_[1] * q_[1] + q_[2] * q_[2] + q_[3] * q_[3]);
+
+        for (auto& q_i : q_)
+        {
+            q_i /= norm_q;
+        }
+    }
+
+    /**
+     *  @return X attitude (roll), in radians.
+     *  @brief  Get the X attitude.
+     */
+    inline Type
+    getAttitudeX() const
+    {
+        using std::atan2;
+
+        return atan2(2 * (q_[0] * q_[1] + q_[2] * q_[3]),
+                1 - 2 * (q_[1] * q_[1] + q_[2] * q_[2]));
+    }
+
+    /**
+     *  @return Y attitude (pitch), in radians.
+     *  @brief  Get the Y attitude.
+     */
+    inline Type
+    getAttitudeY() const
+    {
+        using std::asin;
+
+        const Type sine = 2 * (q_[0] * q_[2] - q_[3] * q_[1]);
+
+        /*
+         *  Clamp the sine against rounding beyond the poles.
+         */
+        return asin(sine > Type(1) ? Type(1) : (sine < Type(-1) ? Type(-1) : sine));
+    }
+
+    /**
+     *  @return Z attitude (yaw), in radians.
+     *  @brief  Get the Z attitude.
+     */
+    inline Type
+    getAttitudeZ() const
+    {
+        using std::atan2;
+
+        return atan2(2 * (q_[0] * q_[3] + q_[1] * q_[2]),
+                1 - 2 * (q_[2] * q_[2] + q_[3] * q_[3]));
+    }
+
+    /**
+     *  @return X gyroscope bias, in radians per second.
+     *  @brief  Get the X gyroscope bias.
+     */
+    inline Type
+    getBiasX() const
+    {
+        return -integral_[0];
+    }
+
+    /**
+     *  @return Y gyroscope bias, in radians per second.
+     *  @brief  Get the Y gyroscope bias.
+     */
+    inline Type
+    getBiasY() const
+    {
+        return -integral_[1];
+    }
+
+    /**
+     *  @return Z gyroscope bias, in radians per second.
+     *  @brief  Get the Z gyroscope bias.
+     */
+    inline Type
+    getBiasZ() const
+    {
+        return -integral_[2];
+    }
+
+private:
+
+    Type q_[4]; //!< Attitude unit quaternion, scalar first.
+    Type integral_[3];  //!< Integral feedback, the negated gyroscope biases, in radians per second.
+    Type gain_integral_;    //!< Integral gain, in radians per second squared.
+    Type gain_proportional_;    //!< Proportional gain, in radians per second.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_ATTITUDE_ESTIMATOR_H_
@@ -0,0 +1,359 @@
+/**
+ *  @file   biquad_filter_bank.hpp
+ *  @author Simon Yu
+ *  @date   01/25/2022
+ *  @brief  Biquad filter bank templated class header.
+ *
+ *  This file defines and implements the biquad filter
+ *  coefficients struct and the biquad filter bank
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_BIQUAD_FILTER_BANK_H_
+#define UTILITY_BIQUAD_FILTER_BANK_H_
+
+/*
+ *  External headers.
+ */
+#include <cstddef>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Biquad filter coefficients struct.
+ *
+ *  This struct contains the coefficients of a biquad filter,
+ *  normalized such that the leading denominator coefficient
+ *  is 1, as well as constant expression functions for designing
+ *  low-pass, high-pass, and notch filters, such that the
+ *  coefficients can be computed at compile time.
+ *
+ *  Learn more about the biquad filter designs here:
+ *  https://www.w3.org/TR/audio-eq-cookbook/
+ */
+struct BiquadCoefficients
+{
+    double b0;  //!< Numerator coefficient 0.
+    double b1;  //!< Numerator coefficient 1.
+    double b2;  //!< Numerator coefficient 2.
+    double a1;  //!< Denominator coefficient 1.
+    double a2;  //!< Denominator coefficient 2.
+
+    /**
+     *  @param  cutoff Cutoff frequency, in Hertz.
+     *  @param  sample_rate Sample rate, in Hertz.
+     *  @param  quality_factor Quality factor, 1 over the square root of 2 for Butterworth.
+     *  @return Biquad filter coefficients struct.
+     *  @brief  Design a low-pass filter.
+     *
+     *  This function designs a second-order low-pass filter with
+     *  the given cutoff frequency and quality factor.
+     */
+    static constexpr BiquadCoefficients
+    lowPass(const double& cutoff, const double& sample_rate, const double& quality_factor)
+    {
+        const double cosine_w0 = cosine(2 * pi_ * cutoff / sample_rate);
+        const double alpha = sine(2 * pi_ * cutoff / sample_rate) / (2 * quality_factor);
+
+        return normalize((1 - cosine_w0) / 2, 1 - cosine_w0, (1 - cosine_w0) / 2, 1 + alpha,
+                -2 * cosine_w0, 1 - alpha);
+    }
+
+    /**
+     *  @param  cutoff Cutoff frequency, in Hertz.
+     *  @param  sample_rate Sample rate, in Hertz.
+     *  @param  quality_factor Quality factor, 1 over the square root of 2 for Butterworth.
+     *  @return Biquad filter coefficients struct.
+     *  @brief  Design a high-pass filter.
+     *
+     *  This function designs a second-order high-pass filter with
+     *  the given cutoff frequency and quality factor.
+     */
+    static constexpr BiquadCoefficients
+    highPass(const double& cutoff, const double& sample_rate, const double& quality_factor)
+    {
+        const double cosine_w0 = cosine(2 * pi_ * cutoff / sample_rate);
+        const double alpha = sine(2 * pi_ * cutoff / sample_rate) / (2 * quality_factor);
+
+        return normalize((1 + cosine_w0) / 2, -(1 + cosine_w0), (1 + cosine_w0) / 2, 1 + alpha,
+                -2 * cosine_w0, 1 - alpha);
+    }
+
+    /**
+     *  @param  center Center frequency, in Hertz.
+     *  @param  sample_rate Sample rate, in Hertz.
+     *  @param  quality_factor Quality factor, the center frequency over the bandwidth.
+     *  @return Biquad filter coefficients struct.
+     *  @brief  Design a notch filter.
+     *
+     *  This function designs a second-order notch filter with
+     *  the given center frequency and quality factor.
+     */
+    static constexpr BiquadCoefficients
+    notch(const double& center, const double& sample_rate, const double& quality_factor)
+    {
+        const double cosine_w0 = cosine(2 * pi_ * center / sample_rate);
+        const double alpha = sine(2 * pi_ * center / sample_rate) / (2 * quality_factor);
+
+        return normalize(1, -2 * cosine_w0, 1, 1 + alpha, -2 * cosine_w0, 1 - alpha);
+    }
+
+    /**
+     *  @return Biquad filter coefficients struct.
+     *  @brief  Design a pass-through filter.
+     *
+     *  This function designs a filter that passes the data unchanged.
+     */
+    static constexpr BiquadCoefficients
+    passThrough()
+    {
+        return { 1, 0, 0, 0, 0 };
+    }
+
+private:
+
+    static constexpr double pi_ = 3.14159265358979323846;   //!< Pi.
+
+    /**
+     *  @param  b0 Numerator coefficient 0.
+     *  @param  b1 Numerator coefficient 1.
+     *  @param  b2 Numerator coefficient 2.
+     *  @param  a0 Denominator coefficient 0.
+     *  @param  a1 Denominator coefficient 1.
+     *  @param  a2 Denominator coefficient 2.
+     *  @return Biquad filter coefficients struct.
+     *  @brief  Normalize the biquad filter coefficients.
+     *
+     *  This function divides the given coefficients by the
+     *  leading denominator coefficient.
+     */
+    static constexpr BiquadCoefficients
+    normalize(const double& b0, const double& b1, const double& b2, const double& a0,
+            const double& a1, const double& a2)
+    {
+        return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+    }
+
+    /**
+     *  @param  radians Angle, in radians, between 0 and pi.
+     *  @return Sine of the angle.
+     *  @brief  Calculate the sine at compile time.
+     *
+     *  This function calculates the sine of the given angle using
+     *  its Taylor series, since the standard sine function is not
+     *  a constant expression.
+     */
+    static constexpr double
+    sine(const double& radians)
+    {
+        /*
+         *  Reflect the angle into the first quadrant, where
+         *  the series converges quickly.
+         */
+        const double x = radians > pi_ / 2 ? pi_ - radians : radians;
+        double term = x;
+        double sum = x;
+
+        for (unsigned i = 1; i < 12; i ++)
+        {
+            term *= -x * x / ((2 * i) * (2 * i + 1));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    /**
+     *  @param  radians Angle, in radians, between 0 and pi.
+     *  @return Cosine of the angle.
+     *  @brief  Calculate the cosine at compile time.
+     *
+     *  This function calculates the cosine of the given angle
+     *  from the sine of its complement.
+     */
+    static constexpr double
+    cosine(const double& radians)
+    {
+        return radians > pi_ / 2 ? -sine(radians - pi_ / 2) : sine(pi_ / 2 - radians);
+    }
+};
+
+/**
+ *  @tparam Type Type of data for filtering.
+ *  @tparam Channels Number of channels.
+ *  @tparam Stages Number of cascaded biquad stages per channel.
+ *  @brief  Biquad filter bank templated class.
+ *
+ *  This templated class provides functions for filtering
+ *  multiple channels of data, each using a cascade of biquad
+ *  filters in the transposed direct form II.
+ *
+ *  The coefficients and the states of all channels are stored
+ *  in a structure-of-arrays layout, i.e., one contiguous array
+ *  per coefficient or state and stage, indexed by channel, such
+ *  that filtering all channels is a single pass over contiguous
+ *  memory, with the inner loop over the channels being free of
+ *  dependencies.
+ *
+ *  The first data initializes the states of each stage to
+ *  their steady state for the data, avoiding a startup
+ *  transient, e.g., from the gravity on an accelerometer.
+ *
+ *  Learn more about the biquad filter here:
+ *  https://en.wikipedia.org/wiki/Digital_biquad_filter#Transposed_direct_forms
+ */
+template<typename Type, size_t Channels, size_t Stages>
+class BiquadFilterBank
+{
+    static_assert(Channels > 0 && Stages > 0,
+            "Biquad filter bank must have at least one channel and stage.");
+
+public:
+
+    /**
+     *  @brief  Biquad filter bank templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  with all stages of all channels passing the data unchanged.
+     */
+    inline
+    BiquadFilterBank() : b0_ { }, b1_ { }, b2_ { }, a1_ { }, a2_ { }, z1_ { }, z2_ { },
+            initialized_(false)
+    {
+        for (size_t stage = 0; stage < Stages; stage ++)
+        {
+            setCoefficients(stage, BiquadCoefficients::passThrough());
+        }
+    }
+
+    /**
+     *  @param  stage Stage index.
+     *  @param  coefficients Biquad filter coefficients struct.
+     *  @brief  Set the coefficients of a stage for all channels.
+     *
+     *  This function sets the coefficients of the given stage
+     *  of all channels to the given coefficients.
+     */
+    inline void
+    setCoefficients(const size_t& stage, const BiquadCoefficients& coefficients)
+    {
+        for (size_t channel = 0; channel < Channels; channel ++)
+        {
+            setCoefficients(stage, channel, coefficients);
+        }
+    }
+
+    /**
+     *  @param  stage Stage index.
+     *  @param  channel Channel index.
+     *  @param  coefficients Biquad filter coefficients struct.
+     *  @brief  Set the coefficients of a stage for a channel.
+     *
+     *  This function sets the coefficients of the given stage
+     *  of the given channel to the given coefficients.
+     */
+    inline void
+    setCoefficients(const size_t& stage, const size_t& channel,
+            const BiquadCoefficients& coefficients)
+    {
+        if (stage >= Stages || channel >= Channels)
+        {
+            return;
+        }
+
+        b0_[stage][channel] = Type(coefficients.b0);
+        b1_[stage][channel] = Type(coefficients.b1);
+        b2_[stage][channel] = Type(coefficients.b2);
+        a1_[stage][channel] = Type(coefficients.a1);
+        a2_[stage][channel] = Type(coefficients.a2);
+    }
+
+    /**
+     *  @param  data Data of all channels, to be filtered in place.
+     *  @brief  Filter data using the biquad filter bank.
+     *
+     *  This function filters the given data of all channels through
+     *  all stages, and replaces the data with the filtered data.
+     */
+    inline void
+    filter(Type (&data)[Channels])
+    {
+        if (!initialized_)
+        {
+            reset(data);
+            initialized_ = true;
+        }
+
+        for (size_t stage = 0; stage < Stages; stage ++)
+        {
+            for (size_t channel = 0; channel < Channels; channel ++)
+            {
+                const Type input = data[channel];
+                const Type output = b0_[stage][channel] * input + z1_[stage][channel];
+                z1_[stage][channel] = b1_[stage][channel] * input - a1_[stage][channel] * output
+                        + z2_[stage][channel];
+                z2_[stage][channel] = b2_[stage][channel] * input - a2_[stage][channel] * output;
+                data[channel] = output;
+            }
+        }
+    }
+
+    /**
+     *  @param  data Data of all channels.
+     *  @brief  Reset the biquad filter bank states.
+     *
+     *  This function sets the states of all stages to their
+     *  steady state for the given constant data of all channels.
+     */
+    inline void
+    reset(const Type (&data)[Channels])
+    {
+        for (size_t channel = 0; channel < Channels; channel ++)
+        {
+            Type input = data[channel];
+
+            for (size_t stage = 0; stage < Stages; stage ++)
+            {
+                /*
+                 *  The steady state output is the input scaled by
+                 *  the direct current gain of the stage.
+                 */
+                const Type output = input
+                        * (b0_[stage][channel] + b1_[stage][channel] + b2_[stage][channel])
+                        / (Type(1) + a1_[stage][channel] + a2_[stage][channel]);
+                z2_[stage][channel] = b2_[stage][channel] * input - a2_[stage][channel] * output;
+                z1_[stage][channel] = b1_[stage][channel] * input - a1_[stage][channel] * output
+                        + z2_[stage][channel];
+                input = output;
+            }
+        }
+
+        initialized_ = true;
+    }
+
+private:
+
+    Type b0_[Stages][Channels]; //!< Numerator coefficients 0.
+    Type b1_[Stages][Channels]; //!< Numerator coefficients 1.
+    Type b2_[Stages][Channels]; //!< Numerator coefficients 2.
+    Type a1_[Stages][Channels]; //!< Denominator coefficients 1.
+    Type a2_[Stages][Channels]; //!< Denominator coefficients 2.
+    Type z1_[Stages][Channels]; //!< States 1.
+    Type z2_[Stages][Channels]; //!< States 2.
+    bool initialized_;  //!< Initialization flag.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_BIQUAD_FILTER_BANK_H_
@@ -0,0 +1,158 @@
+/**
+ *  @file   camera_chunker.hpp
+ *  @author Simon Yu
+ *  @date   02/01/2022
+ *  @brief  Camera chunker templated class header.
+ *
+ *  This file defines and implements the camera chunker
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_CAMERA_CHUNKER_H_
+#define UTILITY_CAMERA_CHUNKER_H_
+
+/*
+ *  External headers.
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/*
+ *  Project headers.
+ */
+#include "common/type.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam DatagramSize Maximum datagram size, in bytes, within the MTU.
+ *  @brief  Camera chunker templated class.
+ *
+ *  This templated class provides functions for splitting a JPG
+ *  camera frame into chunks of at most the datagram size, each
+ *  prefixed with a camera chunk header carrying the camera frame
+ *  ID, the chunk index, the number of chunks, and the capture
+ *  timestamp, and writing every chunk as its own datagram, such that
+ *  the Biped ground station can reassemble the chunks in any order
+ *  and tell lost chunks and stale camera frames apart.
+ *
+ *  The chunks are assembled in a preallocated chunk buffer, such
+ *  that no memory is allocated per camera frame.
+ */
+template<size_t DatagramSize>
+class CameraChunker
+{
+    static_assert(DatagramSize > CameraChunkHeader::size,
+            "Datagram size must exceed the camera chunk header size.");
+
+public:
+
+    static constexpr size_t payload_size_max = DatagramSize - CameraChunkHeader::size; //!< Maximum chunk payload size, in bytes.
+
+    /**
+     *  @brief  Camera chunker templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  starting from camera frame ID 0.
+     */
+    inline
+    CameraChunker() : chunk_ { }, frame_id_(0)
+    {
+    }
+
+    /**
+     *  @return ID of the next camera frame.
+     *  @brief  Get the ID of the next camera frame.
+     */
+    inline uint32_t
+    getFrameID() const
+    {
+        return frame_id_;
+    }
+
+    /**
+     *  @tparam UDPType Type of the UDP interface.
+     *  @param  udp UDP interface.
+     *  @param  ip_remote Remote IP address.
+     *  @param  port UDP port.
+     *  @param  frame JPG camera frame buffer pointer.
+     *  @param  size Size of the JPG camera frame buffer, in bytes.
+     *  @param  timestamp Camera frame capture timestamp, in microseconds.
+     *  @return Size written, including the camera chunk headers, in bytes.
+     *  @brief  Write a camera frame in chunks.
+     *
+     *  This function splits the given JPG camera frame evenly into the
+     *  fewest chunks that fit the datagram size, and writes each chunk
+     *  with its camera chunk header over the given UDP interface. The
+     *  camera frame ID is incremented for every camera frame, including
+     *  those not written. This function fails if the camera frame is
+     *  empty or needs too many chunks.
+     */
+    template<typename UDPType>
+    inline size_t
+    write(UDPType& udp, const std::string& ip_remote, const uint16_t& port, const uint8_t* frame,
+            const size_t& size, const unsigned long long& timestamp)
+    {
+        CameraChunkHeader header;
+        header.chunk_count = static_cast<uint16_t>(CameraChunkHeader::getChunkCount(size,
+                payload_size_max));
+        header.frame_id = frame_id_ ++;
+        header.frame_size = static_cast<uint32_t>(size);
+        header.timestamp = timestamp;
+
+        if (!frame || header.chunk_count == 0)
+        {
+            return 0;
+        }
+
+        size_t bytes = 0;
+
+        for (size_t index = 0; index < header.chunk_count; index ++)
+        {
+            header.chunk_index = static_cast<uint16_t>(index);
+
+            /*
+             *  Serialize the camera chunk header, and copy the chunk
+             *  payload right after it.
+             */
+            zpp::serializer::memory_view_output_archive serializer(chunk_);
+
+            if (!serializer(header) || serializer.offset() != CameraChunkHeader::size)
+            {
+                return bytes;
+            }
+
+            const size_t payload_size = header.getPayloadSize();
+            std::memcpy(chunk_.data() + CameraChunkHeader::size, frame + header.getOffset(),
+                    payload_size);
+
+            bytes += udp.writeBuffer(ip_remote, port, chunk_.data(),
+                    CameraChunkHeader::size + payload_size);
+        }
+
+        return bytes;
+    }
+
+private:
+
+    std::array<uint8_t, DatagramSize> chunk_;   //!< Chunk buffer.
+    uint32_t frame_id_; //!< ID of the next camera frame.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_CAMERA_CHUNKER_H_
@@ -0,0 +1,293 @@
+/**
+ *  @file   camera_pipeline.hpp
+ *  @author Simon Yu
+ *  @date   02/02/2022
+ *  @brief  Camera pipeline templated class header.
+ *
+ *  This file defines the camera frame struct, and defines and
+ *  implements the camera pipeline templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_CAMERA_PIPELINE_H_
+#define UTILITY_CAMERA_PIPELINE_H_
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Camera frame struct.
+ *
+ *  This struct contains a camera frame handed between the camera
+ *  pipeline stages, i.e., its buffers and its per-stage timing.
+ */
+struct CameraFrame
+{
+    uint8_t* buffer;    //!< JPG camera frame buffer pointer.
+    bool converted; //!< Whether the JPG buffer was converted, i.e., allocated by the encode stage.
+    unsigned long execution_time_capture;   //!< Capture stage execution time, in microseconds.
+    unsigned long execution_time_encode;    //!< Encode stage execution time, in microseconds.
+    unsigned long execution_time_transmit;  //!< Transmit stage execution time, in microseconds.
+    void* handle;   //!< Camera driver frame buffer handle, or a null pointer once returned.
+    uint32_t index; //!< Camera frame index, incremented for every captured camera frame.
+    unsigned long latency;  //!< Latency from capture to transmission, in microseconds.
+    size_t size;    //!< Size of the JPG camera frame buffer, in bytes.
+    size_t size_transmitted;    //!< Size transmitted, in bytes.
+    unsigned long time_captured;    //!< Time the capture stage completed, in microseconds.
+    unsigned long long timestamp;   //!< Camera frame capture timestamp, in microseconds.
+
+    /**
+     *  @brief  Camera frame struct constructor
+     *
+     *  This constructor initializes all camera frame struct entries.
+     */
+    CameraFrame() : buffer(nullptr), converted(false), execution_time_capture(0),
+            execution_time_encode(0), execution_time_transmit(0), handle(nullptr), index(0),
+            latency(0), size(0), size_transmitted(0), time_captured(0), timestamp(0)
+    {
+    }
+};
+
+/**
+ *  @tparam Source Type of the camera frame source, e.g., the camera.
+ *  @tparam Queue Type of the queue templated class, taking the element type and the length.
+ *  @tparam Depth Number of camera frames in flight, i.e., the number of camera frame buffers.
+ *  @brief  Camera pipeline templated class.
+ *
+ *  This templated class provides functions for the capture,
+ *  encode, and transmit stages of a camera pipeline, each called
+ *  in a loop by its own task, such that capturing the next camera
+ *  frame overlaps encoding and transmitting the previous ones.
+ *
+ *  The camera frames live in a ring of preallocated slots, one per
+ *  camera frame buffer. The slot indices are handed between the
+ *  stages through queues, i.e., the free, captured, and encoded
+ *  queues, such that each slot is owned by exactly one stage at a
+ *  time and the camera frames stay in order. A stage blocks on its
+ *  input queue, e.g., the capture stage blocks until a slot is free,
+ *  such that no camera frame is queued beyond the camera frame
+ *  buffers.
+ *
+ *  The source provides the capture, encode, transmit, and release
+ *  functions on a camera frame, e.g., the camera with the ESP-IDF
+ *  camera driver on the firmware, or a fake camera on the host.
+ *  The per-stage execution times and the latency are measured
+ *  using the clock function given to the constructor, the same way
+ *  as the rate-monotonic scheduler.
+ *
+ *  Each stage function must be called by a single task.
+ */
+template<typename Source, template<typename, size_t> class Queue, size_t Depth>
+class CameraPipeline
+{
+    static_assert(Depth > 0, "Invalid number of camera frames in flight.");
+
+public:
+
+    /**
+     *  @brief  Clock function type.
+     *
+     *  The clock function returns the current time, in microseconds.
+     */
+    using Clock = unsigned long (*)();
+
+    /**
+     *  @param  source Camera frame source.
+     *  @param  clock Clock function, in microseconds.
+     *  @brief  Camera pipeline templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  with all slots free.
+     */
+    inline
+    CameraPipeline(Source& source, const Clock& clock) : clock_(clock), drop_count_(0), index_(0),
+            source_(source)
+    {
+        for (size_t slot = 0; slot < Depth; slot ++)
+        {
+            queue_free_.send(slot);
+        }
+    }
+
+    /**
+     *  @brief  Camera pipeline templated class copy constructor (deleted).
+     */
+    CameraPipeline(const CameraPipeline&) = delete;
+
+    /**
+     *  @brief  Camera pipeline templated class copy assignment operator (deleted).
+     */
+    CameraPipeline&
+    operator=(const CameraPipeline&) = delete;
+
+    /**
+     *  @return Number of dropped camera frames.
+     *  @brief  Get the number of dropped camera frames.
+     *
+     *  This function returns the number of camera frames that failed
+     *  to be captured, encoded, or transmitted.
+     */
+    inline unsigned long
+    getDropCount() const
+    {
+        return drop_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  @return Whether a camera frame was captured.
+     *  @brief  Execute the capture stage.
+     *
+     *  This function waits for a free slot, captures a camera frame
+     *  into it using the source, and hands it to the encode stage.
+     */
+    inline bool
+    capture()
+    {
+        size_t slot = 0;
+
+        if (!queue_free_.receive(slot))
+        {
+            return false;
+        }
+
+        CameraFrame& frame = frames_[slot];
+        const unsigned long time_start = clock_();
+
+        frame = CameraFrame();
+
+        if (!source_.capture(frame))
+        {
+            drop(slot);
+            return false;
+        }
+
+        frame.index = index_ ++;
+        frame.time_captured = clock_();
+        frame.execution_time_capture = frame.time_captured - time_start;
+
+        return queue_captured_.send(slot);
+    }
+
+    /**
+     *  @return Whether a camera frame was encoded.
+     *  @brief  Execute the encode stage.
+     *
+     *  This function waits for a captured camera frame, encodes it
+     *  into JPG using the source, if necessary, and hands it to the
+     *  transmit stage.
+     */
+    inline bool
+    encode()
+    {
+        size_t slot = 0;
+
+        if (!queue_captured_.receive(slot))
+        {
+            return false;
+        }
+
+        CameraFrame& frame = frames_[slot];
+        const unsigned long time_start = clock_();
+
+        if (!source_.encode(frame))
+        {
+            drop(slot);
+            return false;
+        }
+
+        frame.execution_time_encode = clock_() - time_start;
+
+        return queue_encoded_.send(slot);
+    }
+
+    /**
+     *  @tparam Args Types of the source transmit function arguments.
+     *  @param  transmitted Copy of the transmitted camera frame.
+     *  @param  args Source transmit function arguments, e.g., the UDP interface.
+     *  @return Whether a camera frame was transmitted.
+     *  @brief  Execute the transmit stage.
+     *
+     *  This function waits for an encoded camera frame, transmits it
+     *  using the source, releases its buffers, and frees its slot. The
+     *  transmitted camera frame, including its per-stage timing, is
+     *  copied into the given camera frame.
+     */
+    template<typename... Args>
+    inline bool
+    transmit(CameraFrame& transmitted, Args&&... args)
+    {
+        size_t slot = 0;
+
+        if (!queue_encoded_.receive(slot))
+        {
+            return false;
+        }
+
+        CameraFrame& frame = frames_[slot];
+        const unsigned long time_start = clock_();
+
+        frame.size_transmitted = source_.transmit(frame, std::forward<Args>(args)...);
+
+        if (frame.size_transmitted == 0)
+        {
+            drop(slot);
+            return false;
+        }
+
+        source_.release(frame);
+
+        const unsigned long time_transmitted = clock_();
+        frame.execution_time_transmit = time_transmitted - time_start;
+        frame.latency = time_transmitted - frame.time_captured;
+        transmitted = frame;
+
+        return queue_free_.send(slot);
+    }
+
+private:
+
+    /**
+     *  @param  slot Slot of the dropped camera frame.
+     *  @brief  Drop a camera frame.
+     *
+     *  This function releases the buffers of the camera frame in the
+     *  given slot, frees the slot, and counts the drop.
+     */
+    inline void
+    drop(const size_t& slot)
+    {
+        source_.release(frames_[slot]);
+        drop_count_.fetch_add(1, std::memory_order_relaxed);
+        queue_free_.send(slot);
+    }
+
+    const Clock clock_; //!< Clock function.
+    std::atomic<unsigned long> drop_count_; //!< Number of dropped camera frames.
+    CameraFrame frames_[Depth]; //!< Camera frame slots.
+    uint32_t index_;    //!< Index of the next captured camera frame.
+    Queue<size_t, Depth> queue_captured_;   //!< Captured camera frame slot queue.
+    Queue<size_t, Depth> queue_encoded_;    //!< Encoded camera frame slot queue.
+    Queue<size_t, Depth> queue_free_;   //!< Free slot queue.
+    Source& source_;    //!< Camera frame source.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_CAMERA_PIPELINE_H_
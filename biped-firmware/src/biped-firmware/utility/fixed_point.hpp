@@ -0,0 +1,282 @@
+/**
+ *  @file   fixed_point.hpp
+ *  @author Simon Yu
+ *  @date   01/19/2022
+ *  @brief  Fixed-point templated class header.
+ *
+ *  This file defines and implements the fixed-point
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_FIXED_POINT_H_
+#define UTILITY_FIXED_POINT_H_
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+#include <limits>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam FractionalBits Number of fractional bits.
+ *  @brief  Fixed-point templated class.
+ *
+ *  This templated class provides a signed 32-bit Q-format
+ *  fixed-point number with the given number of fractional
+ *  bits, e.g., Q15.16 for 16 fractional bits. Products and
+ *  quotients are computed with 64-bit intermediates, and all
+ *  results saturate at the representable range instead of
+ *  wrapping around.
+ *
+ *  The class converts implicitly from arithmetic types, so
+ *  that generic code written for floating-point types, e.g.,
+ *  the controllers and the filters, can be instantiated with
+ *  it. Conversions back to floating-point types are explicit.
+ *
+ *  Learn more about the Q format here:
+ *  https://en.wikipedia.org/wiki/Q_(number_format)
+ */
+template<unsigned FractionalBits>
+class FixedPoint
+{
+    static_assert(FractionalBits > 0 && FractionalBits < 31, "Invalid number of fractional bits.");
+
+public:
+
+    /**
+     *  @brief  Fixed-point class constructor.
+     *
+     *  This constructor initializes the fixed-point number to 0.
+     */
+    constexpr
+    FixedPoint() : raw_(0)
+    {
+    }
+
+    /**
+     *  @param  data Data.
+     *  @brief  Fixed-point class constructor.
+     *
+     *  This constructor converts the given data to the nearest
+     *  fixed-point number, saturated at the representable range.
+     */
+    constexpr
+    FixedPoint(const double& data) : raw_(saturate(data * one + (data < 0 ? -0.5 : 0.5)))
+    {
+    }
+
+    /**
+     *  @param  raw Raw fixed-point representation.
+     *  @return Fixed-point number.
+     *  @brief  Create a fixed-point number from its raw representation.
+     *
+     *  This function creates a fixed-point number from the given
+     *  raw representation.
+     */
+    static constexpr FixedPoint
+    fromRaw(const int32_t& raw)
+    {
+        FixedPoint fixed_point;
+        fixed_point.raw_ = raw;
+        return fixed_point;
+    }
+
+    /**
+     *  @return Raw fixed-point representation.
+     *  @brief  Get the raw fixed-point representation.
+     *
+     *  This function returns the raw fixed-point representation.
+     */
+    constexpr int32_t
+    getRaw() const
+    {
+        return raw_;
+    }
+
+    /**
+     *  @return Fixed-point number as a double.
+     *  @brief  Convert to double.
+     */
+    explicit constexpr
+    operator double() const
+    {
+        return static_cast<double>(raw_) / one;
+    }
+
+    /**
+     *  @return Fixed-point number as a float.
+     *  @brief  Convert to float.
+     */
+    explicit constexpr
+    operator float() const
+    {
+        return static_cast<float>(raw_) / one;
+    }
+
+    /*
+     *  Arithmetic operators.
+     */
+    friend constexpr FixedPoint
+    operator+(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return fromRaw(saturate(static_cast<int64_t>(lhs.raw_) + rhs.raw_));
+    }
+
+    friend constexpr FixedPoint
+    operator-(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return fromRaw(saturate(static_cast<int64_t>(lhs.raw_) - rhs.raw_));
+    }
+
+    friend constexpr FixedPoint
+    operator*(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        /*
+         *  Round the 64-bit product to the nearest fixed-point number.
+         */
+        return fromRaw(saturate((static_cast<int64_t>(lhs.raw_) * rhs.raw_
+                + (static_cast<int64_t>(1) << (FractionalBits - 1))) >> FractionalBits));
+    }
+
+    friend constexpr FixedPoint
+    operator/(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        /*
+         *  Saturate division by 0 towards the sign of the dividend.
+         */
+        if (rhs.raw_ == 0)
+        {
+            return fromRaw(lhs.raw_ < 0 ? std::numeric_limits<int32_t>::min() :
+                    std::numeric_limits<int32_t>::max());
+        }
+
+        return fromRaw(saturate((static_cast<int64_t>(lhs.raw_) << FractionalBits) / rhs.raw_));
+    }
+
+    constexpr FixedPoint
+    operator-() const
+    {
+        return fromRaw(saturate(-static_cast<int64_t>(raw_)));
+    }
+
+    constexpr FixedPoint&
+    operator+=(const FixedPoint& rhs)
+    {
+        return *this = *this + rhs;
+    }
+
+    constexpr FixedPoint&
+    operator-=(const FixedPoint& rhs)
+    {
+        return *this = *this - rhs;
+    }
+
+    constexpr FixedPoint&
+    operator*=(const FixedPoint& rhs)
+    {
+        return *this = *this * rhs;
+    }
+
+    constexpr FixedPoint&
+    operator/=(const FixedPoint& rhs)
+    {
+        return *this = *this / rhs;
+    }
+
+    /*
+     *  Comparison operators.
+     */
+    friend constexpr bool
+    operator==(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ == rhs.raw_;
+    }
+
+    friend constexpr bool
+    operator!=(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ != rhs.raw_;
+    }
+
+    friend constexpr bool
+    operator<(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ < rhs.raw_;
+    }
+
+    friend constexpr bool
+    operator<=(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ <= rhs.raw_;
+    }
+
+    friend constexpr bool
+    operator>(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ > rhs.raw_;
+    }
+
+    friend constexpr bool
+    operator>=(const FixedPoint& lhs, const FixedPoint& rhs)
+    {
+        return lhs.raw_ >= rhs.raw_;
+    }
+
+    /**
+     *  @param  data Fixed-point number.
+     *  @return Absolute value of the given fixed-point number.
+     *  @brief  Absolute value function, found by argument-dependent lookup.
+     */
+    friend constexpr FixedPoint
+    fabs(const FixedPoint& data)
+    {
+        return data.raw_ < 0 ? -data : data;
+    }
+
+private:
+
+    static constexpr double one = static_cast<double>(static_cast<int64_t>(1) << FractionalBits);  //!< Raw representation of 1.
+
+    /**
+     *  @param  raw Wide raw representation.
+     *  @return Raw representation saturated to 32 bits.
+     *  @brief  Saturate a wide raw representation.
+     */
+    template<typename Wide>
+    static constexpr int32_t
+    saturate(const Wide& raw)
+    {
+        if (raw > static_cast<Wide>(std::numeric_limits<int32_t>::max()))
+        {
+            return std::numeric_limits<int32_t>::max();
+        }
+
+        if (raw < static_cast<Wide>(std::numeric_limits<int32_t>::min()))
+        {
+            return std::numeric_limits<int32_t>::min();
+        }
+
+        return static_cast<int32_t>(raw);
+    }
+
+    int32_t raw_;   //!< Raw fixed-point representation.
+};
+
+using Q16 = FixedPoint<16>; //!< Q15.16 fixed-point type.
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_FIXED_POINT_H_
@@ -0,0 +1,109 @@
+/**
+ *  @file   freertos_queue.hpp
+ *  @author Simon Yu
+ *  @date   02/02/2022
+ *  @brief  FreeRTOS queue templated class header.
+ *
+ *  This file defines and implements the FreeRTOS queue
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_FREERTOS_QUEUE_H_
+#define UTILITY_FREERTOS_QUEUE_H_
+
+/*
+ *  External headers.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <type_traits>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of the elements.
+ *  @tparam Length Maximum number of elements.
+ *  @brief  FreeRTOS queue templated class.
+ *
+ *  This templated class wraps a statically allocated FreeRTOS
+ *  queue, such that the queue is created without any heap
+ *  allocations. Sending to a full queue and receiving from an
+ *  empty queue block until the other side catches up.
+ */
+template<typename Type, size_t Length>
+class FreeRTOSQueue
+{
+    static_assert(Length > 0, "Invalid FreeRTOS queue length.");
+    static_assert(std::is_trivially_copyable<Type>::value,
+            "FreeRTOS queue elements must be trivially copyable.");
+
+public:
+
+    /**
+     *  @brief  FreeRTOS queue templated class constructor.
+     *
+     *  This constructor creates the FreeRTOS queue in the class
+     *  member storage.
+     */
+    inline
+    FreeRTOSQueue() : storage_ { }
+    {
+        handle_ = xQueueCreateStatic(Length, sizeof(Type), storage_, &queue_);
+    }
+
+    /**
+     *  @brief  FreeRTOS queue templated class copy constructor (deleted).
+     */
+    FreeRTOSQueue(const FreeRTOSQueue&) = delete;
+
+    /**
+     *  @brief  FreeRTOS queue templated class copy assignment operator (deleted).
+     */
+    FreeRTOSQueue&
+    operator=(const FreeRTOSQueue&) = delete;
+
+    /**
+     *  @param  element Received element.
+     *  @return Whether an element was received.
+     *  @brief  Receive the oldest element, waiting until one is available.
+     */
+    inline bool
+    receive(Type& element)
+    {
+        return xQueueReceive(handle_, &element, portMAX_DELAY) == pdTRUE;
+    }
+
+    /**
+     *  @param  element Element to be sent.
+     *  @return Whether the element was sent.
+     *  @brief  Send an element, waiting until there is room.
+     */
+    inline bool
+    send(const Type& element)
+    {
+        return xQueueSend(handle_, &element, portMAX_DELAY) == pdTRUE;
+    }
+
+private:
+
+    QueueHandle_t handle_;  //!< FreeRTOS queue handle.
+    StaticQueue_t queue_;   //!< FreeRTOS queue struct.
+    uint8_t storage_[Length * sizeof(Type)];    //!< FreeRTOS queue storage.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_FREERTOS_QUEUE_H_
@@ -0,0 +1,200 @@
+/**
+ *  @file   kalman_filter.hpp
+ *  @author Simon Yu
+ *  @date   01/19/2022
+ *  @brief  Kalman filter templated class header.
+ *
+ *  This file defines and implements the Kalman filter
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_KALMAN_FILTER_H_
+#define UTILITY_KALMAN_FILTER_H_
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of data for filtering.
+ *  @brief  Kalman filter templated class.
+ *
+ *  This templated class provides functions for filtering
+ *  an angle using a two-state (angle and angular velocity
+ *  bias) Kalman filter, fusing the angle measured by the
+ *  accelerometer with the angular velocity measured by the
+ *  gyroscope. The interface follows the Arduino Kalman filter
+ *  library, and the angles are expected to be in degrees.
+ *
+ *  Learn more about the Kalman filter here:
+ *  https://en.wikipedia.org/wiki/Kalman_filter
+ */
+template<typename Type>
+class KalmanFilter
+{
+public:
+
+    /**
+     *  @brief  Kalman filter templated class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    inline
+    KalmanFilter() : angle_(0), bias_(0), q_angle_(0.001), q_bias_(0.003), r_measure_(0.03),
+            rate_(0)
+    {
+        /*
+         *  Initialize the error covariance matrix, assuming
+         *  the bias and the starting angle are known.
+         */
+        p_[0][0] = 0;
+        p_[0][1] = 0;
+        p_[1][0] = 0;
+        p_[1][1] = 0;
+    }
+
+    /**
+     *  @param  angle Angle, in degrees.
+     *  @brief  Set the angle.
+     *
+     *  This function sets the starting angle.
+     */
+    inline void
+    setAngle(const Type& angle)
+    {
+        angle_ = angle;
+    }
+
+    /**
+     *  @param  q_angle Process noise variance for the angle.
+     *  @brief  Set the process noise variance for the angle.
+     *
+     *  This function sets the process noise variance for the angle.
+     */
+    inline void
+    setQangle(const Type& q_angle)
+    {
+        q_angle_ = q_angle;
+    }
+
+    /**
+     *  @param  q_bias Process noise variance for the angular velocity bias.
+     *  @brief  Set the process noise variance for the angular velocity bias.
+     *
+     *  This function sets the process noise variance for the angular
+     *  velocity bias.
+     */
+    inline void
+    setQbias(const Type& q_bias)
+    {
+        q_bias_ = q_bias;
+    }
+
+    /**
+     *  @param  r_measure Measurement noise variance.
+     *  @brief  Set the measurement noise variance.
+     *
+     *  This function sets the measurement noise variance.
+     */
+    inline void
+    setRmeasure(const Type& r_measure)
+    {
+        r_measure_ = r_measure;
+    }
+
+    /**
+     *  @param  angle Measured angle, in degrees.
+     *  @param  rate Measured angular velocity, in degrees per second.
+     *  @param  period Filter period, in seconds.
+     *  @return Filtered angle, in degrees.
+     *  @brief  Filter the angle using the Kalman filter.
+     *
+     *  This function predicts the angle using the measured angular
+     *  velocity, corrects the prediction using the measured angle,
+     *  and returns the filtered angle. This function is expected to
+     *  be called periodically.
+     */
+    inline Type
+    getAngle(const Type& angle, const Type& rate, const Type& period)
+    {
+        /*
+         *  Predict the angle using the unbiased angular velocity.
+         */
+        rate_ = rate - bias_;
+        angle_ += period * rate_;
+
+        /*
+         *  Update the estimation error covariance.
+         */
+        p_[0][0] += period * (period * p_[1][1] - p_[0][1] - p_[1][0] + q_angle_);
+        p_[0][1] -= period * p_[1][1];
+        p_[1][0] -= period * p_[1][1];
+        p_[1][1] += q_bias_ * period;
+
+        /*
+         *  Calculate the Kalman gain.
+         */
+        const Type s = p_[0][0] + r_measure_;
+        const Type k_0 = p_[0][0] / s;
+        const Type k_1 = p_[1][0] / s;
+
+        /*
+         *  Correct the angle and the angular velocity bias
+         *  using the innovation.
+         */
+        const Type innovation = angle - angle_;
+        angle_ += k_0 * innovation;
+        bias_ += k_1 * innovation;
+
+        /*
+         *  Update the error covariance.
+         */
+        const Type p_0_0 = p_[0][0];
+        const Type p_0_1 = p_[0][1];
+        p_[0][0] -= k_0 * p_0_0;
+        p_[0][1] -= k_0 * p_0_1;
+        p_[1][0] -= k_1 * p_0_0;
+        p_[1][1] -= k_1 * p_0_1;
+
+        /*
+         *  Return the filtered angle.
+         */
+        return angle_;
+    }
+
+    /**
+     *  @return Unbiased angular velocity, in degrees per second.
+     *  @brief  Get the unbiased angular velocity.
+     *
+     *  This function returns the unbiased angular velocity
+     *  computed by the last call to the getAngle function.
+     */
+    inline Type
+    getRate() const
+    {
+        return rate_;
+    }
+
+private:
+
+    Type angle_;    //!< Filtered angle, in degrees.
+    Type bias_; //!< Angular velocity bias, in degrees per second.
+    Type p_[2][2];  //!< Error covariance matrix.
+    Type q_angle_;  //!< Process noise variance for the angle.
+    Type q_bias_;   //!< Process noise variance for the angular velocity bias.
+    Type r_measure_;    //!< Measurement noise variance.
+    Type rate_; //!< Unbiased angular velocity, in degrees per second.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_KALMAN_FILTER_H_
@@ -57,7 +57,7 @@ public:
      *  This function sets the low-pass filter beta.
      */
     inline void
-    setBeta(const double& beta)
+    setBeta(const Type& beta)
     {
         /*
          *  Set the class member low-pass filter beta.
@@ -81,7 +81,7 @@ public:
          *  Learn more about discrete low-pass filters here:
          *  https://en.wikipedia.org/wiki/Low-pass_filter#Difference_equation_through_discrete_time_sampling
          */
-        data_filtered_ = beta_ * data_filtered_ + (1 - beta_) * data;
+        data_filtered_ = beta_ * data_filtered_ + (Type(1) - beta_) * data;
 
         /*
          *  Return filtered data.
@@ -92,7 +92,7 @@ public:
 private:
 
     Type data_filtered_;    //!< Templated filtered data.
-    double beta_;    //!< Low-pass filter beta.
+    Type beta_;    //!< Low-pass filter beta.
 };
 }   // namespace firmware
 }   // namespace biped
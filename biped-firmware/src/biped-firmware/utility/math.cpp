@@ -72,6 +72,7 @@ millisecondsToSeconds(const double& milliseconds)
     return milliseconds / 1000;
 }
 
+#ifdef ARDUINO
 TickType_t
 millisecondsToTicks(const double& milliseconds)
 {
@@ -80,6 +81,7 @@ millisecondsToTicks(const double& milliseconds)
      */
     return pdMS_TO_TICKS(milliseconds);
 }
+#endif
 
 double
 radiansToDegrees(const double& radians)
@@ -108,6 +110,7 @@ secondsToMilliseconds(const double& seconds)
     return seconds * 1000;
 }
 
+#ifdef ARDUINO
 double
 ticksToMilliseconds(const TickType_t& ticks)
 {
@@ -116,5 +119,6 @@ ticksToMilliseconds(const TickType_t& ticks)
      */
     return ticks * portTICK_PERIOD_MS;
 }
+#endif
 }   // namespace firmware
 }   // namespace biped
@@ -16,7 +16,9 @@
 /*
  *  External headers.
  */
+#ifdef ARDUINO
 #include <freertos/FreeRTOS.h>
+#endif
 
 /*
  *  Biped namespace.
@@ -41,6 +43,28 @@ namespace firmware
 double
 clamp(const double& data, const double& lower_bound, const double& upper_bound);
 
+/**
+ *  @tparam Type Type of data.
+ *  @param  data Data.
+ *  @param  lower_bound Lower bound.
+ *  @param  upper_bound Upper bound.
+ *  @return Data clamped between the given lower and upper bound.
+ *  @brief  Clamp data between the lower and upper bound.
+ *
+ *  This function clamps the given data between the given
+ *  lower and upper bound, without converting the data to
+ *  double, e.g., for float or fixed-point data.
+ */
+template<typename Type>
+inline Type
+clamp(const Type& data, const Type& lower_bound, const Type& upper_bound)
+{
+    /*
+     *  Clamp the given data between the given lower and upper bound.
+     */
+    return data < lower_bound ? lower_bound : (data > upper_bound ? upper_bound : data);
+}
+
 /**
  *  @param  degrees Data in degrees.
  *  @return Data in radians.
@@ -81,6 +105,7 @@ microsecondsToSeconds(const double& microseconds);
 double
 millisecondsToSeconds(const double& milliseconds);
 
+#ifdef ARDUINO
 /**
  *  @param  milliseconds Data in milliseconds.
  *  @return Data in ticks.
@@ -90,6 +115,7 @@ millisecondsToSeconds(const double& milliseconds);
  */
 TickType_t
 millisecondsToTicks(const double& milliseconds);
+#endif
 
 /**
  *  @param  radians Data in radians.
@@ -121,6 +147,7 @@ secondsToMicroseconds(const double& seconds);
 double
 secondsToMilliseconds(const double& seconds);
 
+#ifdef ARDUINO
 /**
  *  @param  ticks Data in ticks.
  *  @return Data in milliseconds.
@@ -130,6 +157,7 @@ secondsToMilliseconds(const double& seconds);
  */
 double
 ticksToMilliseconds(const TickType_t& ticks);
+#endif
 }   // namespace firmware
 }   // namespace biped
 
@@ -17,10 +17,7 @@
 /*
  *  External headers.
  */
-#include <algorithm>
-#include <cmath>
-#include <list>
-#include <vector>
+#include <cstddef>
 
 /*
  *  Biped namespace.
@@ -34,46 +31,61 @@ namespace firmware
 {
 /**
  *  @tparam Type Type of data for filtering.
+ *  @tparam WindowSize Median filter window size.
  *  @brief  Median filter templated class.
  *
  *  This templated class provides functions for
- *  filtering data using a simple median filter.
+ *  filtering data using a streaming median filter.
+ *
+ *  The window is a fixed ring buffer, and the window entries
+ *  are ordered by two heaps of ring buffer slots: a max-heap
+ *  of the lower entries, up to and including the median, and
+ *  a min-heap of the upper entries. Each new data replaces the
+ *  oldest entry in its slot, which is then sifted within its
+ *  heap, and at most one exchange of the heap tops restores the
+ *  order between the heaps. Filtering thus costs O(log n) time
+ *  per data, with the median at the top of the lower heap, and
+ *  never allocates memory.
  *
  *  Learn more about the median filter here:
  *  https://en.wikipedia.org/wiki/Median_filter#Worked_one-dimensional_example
  */
-template<typename Type>
+template<typename Type, size_t WindowSize>
 class MedianFilter
 {
+    static_assert(WindowSize > 0, "Median filter window size must be positive.");
+
 public:
 
     /**
-     *  @param  window_size Median filter window size.
      *  @brief  Median filter templated class constructor.
      *
      *  This constructor initializes all class member variables and
-     *  the median filter window.
+     *  the median filter window, with all entries value-initialized.
      */
     inline
-    MedianFilter(const size_t& window_size) : window_size_(window_size)
+    MedianFilter() : window_ { }, index_(0)
     {
         /*
-         *  Initialize the median filter window.
+         *  Initialize the heaps. With all entries being equal,
+         *  any assignment of the slots is ordered.
          */
-        for (size_t i = 0; i < window_size; i ++)
+        for (size_t i = 0; i < WindowSize; i ++)
         {
-            window_.push_front(Type());
+            heap_[i] = i;
+            position_[i] = i;
         }
     }
 
     /**
-     *  @tparam Type Type of filtered data.
      *  @param  data New data.
      *  @return Templated filtered data.
      *  @brief  Filter data using the median filter.
      *
-     *  This function filters the new data using a simple
-     *  median filter implementation.
+     *  This function replaces the oldest data in the window with
+     *  the new data and returns the median of the window, i.e., the
+     *  entry with the window size divided by 2, rounded down, entries
+     *  below it.
      *
      *  Learn more about the median filter here:
      *  https://en.wikipedia.org/wiki/Median_filter#Worked_one-dimensional_example
@@ -82,32 +94,182 @@ public:
     filter(const Type& data)
     {
         /*
-         *  Push new data onto the window and pop the oldest data.
+         *  Replace the oldest data with the new data.
          */
-        window_.push_front(data);
-        window_.pop_back();
+        const size_t slot = index_;
+        window_[slot] = data;
+        index_ = index_ + 1 < WindowSize ? index_ + 1 : 0;
 
         /*
-         *  Copy the window into a vector and calculate the median index.
+         *  Restore the order within the heap containing the slot.
          */
-        std::vector<Type> window_sorted(window_.begin(), window_.end());
-        const size_t median_index = static_cast<size_t>(std::floor(window_size_ / 2.0));
+        const size_t position = position_[slot];
 
         /*
-         *  Sort the window.
+         *  Heaps of a single entry are always ordered, and leaving
+         *  them out at compile time keeps the small windows free of
+         *  heap accesses beyond the arrays.
          */
-        std::sort(window_sorted.begin(), window_sorted.end());
+        if (position < size_lower_)
+        {
+            if constexpr (size_lower_ > 1)
+            {
+                siftDown<true>(siftUp<true>(position));
+            }
+        }
+        else if constexpr (size_upper_ > 1)
+        {
+            siftDown<false>(siftUp<false>(position));
+        }
+
+        /*
+         *  Restore the order between the heaps, by exchanging the
+         *  heap tops if the lower top exceeds the upper top. Since
+         *  only a single entry changed, a single exchange suffices.
+         */
+        if constexpr (size_upper_ > 0)
+        {
+            if (window_[heap_[size_lower_]] < window_[heap_[0]])
+            {
+                exchange(0, size_lower_);
+
+                if constexpr (size_lower_ > 1)
+                {
+                    siftDown<true>(0);
+                }
+
+                if constexpr (size_upper_ > 1)
+                {
+                    siftDown<false>(size_lower_);
+                }
+            }
+        }
 
         /*
-         *  Return the median value in the sorted window.
+         *  Return the median value at the top of the lower heap.
          */
-        return window_sorted[median_index];
+        return window_[heap_[0]];
     }
 
 private:
 
-    std::list<Type> window_;    //!< Median filter window.
-    size_t window_size_;    //!< Median filter window size.
+    static constexpr size_t size_lower_ = WindowSize / 2 + 1; //!< Lower heap size.
+    static constexpr size_t size_upper_ = WindowSize - size_lower_; //!< Upper heap size.
+
+    /**
+     *  @tparam Lower Whether the heap is the lower (max) or the upper (min) heap.
+     *  @param  lhs Left-hand side heap position.
+     *  @param  rhs Right-hand side heap position.
+     *  @return Whether the left-hand side entry belongs above the right-hand side entry.
+     *  @brief  Compare the heap entries.
+     *
+     *  This function compares the window entries at the given heap
+     *  positions, according to the order of the given heap.
+     */
+    template<bool Lower>
+    inline bool
+    above(const size_t& lhs, const size_t& rhs) const
+    {
+        return Lower ? window_[heap_[rhs]] < window_[heap_[lhs]] :
+                window_[heap_[lhs]] < window_[heap_[rhs]];
+    }
+
+    /**
+     *  @param  lhs Left-hand side heap position.
+     *  @param  rhs Right-hand side heap position.
+     *  @brief  Exchange the heap entries.
+     *
+     *  This function exchanges the slots at the given heap positions
+     *  and updates the heap positions of the slots accordingly.
+     */
+    inline void
+    exchange(const size_t& lhs, const size_t& rhs)
+    {
+        const size_t slot = heap_[lhs];
+        heap_[lhs] = heap_[rhs];
+        heap_[rhs] = slot;
+        position_[heap_[lhs]] = lhs;
+        position_[heap_[rhs]] = rhs;
+    }
+
+    /**
+     *  @tparam Lower Whether the heap is the lower (max) or the upper (min) heap.
+     *  @param  position Heap position.
+     *  @return Heap position after sifting.
+     *  @brief  Sift a heap entry towards the top.
+     *
+     *  This function sifts the entry at the given heap position
+     *  towards the top of the given heap, while it belongs above
+     *  its parent. The heaps are stored back-to-back in the heap
+     *  array, with the upper heap starting after the lower heap.
+     */
+    template<bool Lower>
+    inline size_t
+    siftUp(size_t position)
+    {
+        const size_t offset = Lower ? 0 : size_lower_;
+
+        while (position > offset)
+        {
+            const size_t parent = offset + (position - offset - 1) / 2;
+
+            if (!above<Lower>(position, parent))
+            {
+                break;
+            }
+
+            exchange(position, parent);
+            position = parent;
+        }
+
+        return position;
+    }
+
+    /**
+     *  @tparam Lower Whether the heap is the lower (max) or the upper (min) heap.
+     *  @param  position Heap position.
+     *  @brief  Sift a heap entry towards the bottom.
+     *
+     *  This function sifts the entry at the given heap position
+     *  towards the bottom of the given heap, while one of its
+     *  children belongs above it.
+     */
+    template<bool Lower>
+    inline void
+    siftDown(size_t position)
+    {
+        const size_t offset = Lower ? 0 : size_lower_;
+        const size_t end = Lower ? size_lower_ : WindowSize;
+
+        for (;;)
+        {
+            const size_t left = offset + 2 * (position - offset) + 1;
+            size_t child = position;
+
+            if (left < end && above<Lower>(left, child))
+            {
+                child = left;
+            }
+
+            if (left + 1 < end && above<Lower>(left + 1, child))
+            {
+                child = left + 1;
+            }
+
+            if (child == position)
+            {
+                return;
+            }
+
+            exchange(position, child);
+            position = child;
+        }
+    }
+
+    Type window_[WindowSize];   //!< Median filter window ring buffer.
+    size_t heap_[WindowSize];   //!< Lower and upper heaps of window slots.
+    size_t position_[WindowSize];   //!< Heap positions of the window slots.
+    size_t index_;  //!< Window slot of the oldest data.
 };
 }   // namespace firmware
 }   // namespace biped
@@ -0,0 +1,242 @@
+/**
+ *  @file   quadrature_decoder.hpp
+ *  @author Simon Yu
+ *  @date   01/22/2022
+ *  @brief  Quadrature decoder templated class header.
+ *
+ *  This file defines and implements the quadrature decoder
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_QUADRATURE_DECODER_H_
+#define UTILITY_QUADRATURE_DECODER_H_
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <cstdint>
+#include <esp_attr.h>
+
+/*
+ *  Project headers.
+ */
+#include "utility/seqlock.hpp"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @brief  Quadrature decoder data struct.
+ *
+ *  This struct contains the decoded encoder steps and
+ *  the timestamp of the last step.
+ */
+struct QuadratureDecoderData
+{
+    long steps; //!< Encoder steps.
+    uint32_t timestamp; //!< Timestamp of the last step, in microseconds.
+};
+
+/**
+ *  @tparam Reversed Whether to count the steps in the reversed direction.
+ *  @brief  Quadrature decoder templated class.
+ *
+ *  This templated class provides functions for decoding the
+ *  steps of an incremental rotary encoder from the states of
+ *  its A and B channels, using a state machine driven by a
+ *  16-entry transition lookup table indexed by the last and
+ *  the current channel states, instead of branching on the
+ *  individual channels. The same decoding function serves
+ *  the interrupts of both channels.
+ *
+ *  A transition to the same state, e.g., from a contact bounce
+ *  that settled before the interrupt was serviced, produces no
+ *  step. A transition of both channels at once cannot occur on
+ *  a working encoder, and indicates that an edge was missed.
+ *  Such illegal transitions produce no step and are counted
+ *  instead, with the state machine resynchronized to the current
+ *  state.
+ *
+ *  The decoding function is expected to be called from a single
+ *  interrupt context at a time, e.g., the GPIO interrupt handler.
+ *  The steps are published along with the timestamp of the last
+ *  step through a sequence lock, and the illegal transitions are
+ *  a single-writer atomic counter. Both are safe to be read from
+ *  any task.
+ *
+ *  Learn more about the incremental rotary encoder here:
+ *  https://lastminuteengineers.com/rotary-encoder-arduino-tutorial/
+ */
+template<bool Reversed>
+class QuadratureDecoder
+{
+public:
+
+    /**
+     *  @brief  Quadrature decoder templated class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    inline
+    QuadratureDecoder() : state_(0), steps_(0), transition_errors_(0)
+    {
+    }
+
+    /**
+     *  @return Quadrature decoder data struct.
+     *  @brief  Get the quadrature decoder data struct.
+     *
+     *  This function returns a coherent snapshot of the decoded
+     *  encoder steps and the timestamp of the last step.
+     */
+    inline QuadratureDecoderData
+    getData() const
+    {
+        return seqlock_data_.read();
+    }
+
+    /**
+     *  @return Encoder steps.
+     *  @brief  Get the encoder steps.
+     *
+     *  This function returns the decoded encoder steps.
+     */
+    inline long
+    getSteps() const
+    {
+        return getData().steps;
+    }
+
+    /**
+     *  @return Number of illegal transitions.
+     *  @brief  Get the number of illegal transitions.
+     *
+     *  This function returns the number of illegal transitions,
+     *  i.e., transitions of both channels at once, decoded so far.
+     */
+    inline unsigned long
+    getTransitionErrors() const
+    {
+        return transition_errors_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  @param  state Current channel states, with channel A in bit 1 and B in bit 0.
+     *  @brief  Set the current channel states.
+     *
+     *  This function sets the current channel states without
+     *  decoding a step, e.g., to synchronize the state machine
+     *  with the encoder before its interrupts are attached.
+     */
+    inline void
+    setState(const uint8_t& state)
+    {
+        state_ = state & 0b11;
+    }
+
+    /**
+     *  @param  state Current channel states, with channel A in bit 1 and B in bit 0.
+     *  @param  timestamp Current timestamp, in microseconds.
+     *  @brief  Decode the current channel states.
+     *
+     *  This function decodes the transition from the last channel
+     *  states to the given current channel states, and updates the
+     *  encoder steps, along with the timestamp of the last step, or
+     *  the illegal transitions accordingly. This function is safe to
+     *  be called from an interrupt service routine, but must only be
+     *  called by a single writer.
+     */
+    inline void IRAM_ATTR
+    decode(const uint8_t& state, const uint32_t& timestamp)
+    {
+        /*
+         *  Look up the transition table entry of the transition
+         *  from the last to the current channel states.
+         */
+        const uint8_t state_current = state & 0b11;
+        const uint8_t entry = (transition_table_ >> (((state_ << 2) | state_current) << 1)) & 0b11;
+        state_ = state_current;
+
+        /*
+         *  Since there is only a single writer, plain relaxed loads
+         *  and stores suffice and avoid read-modify-write operations.
+         */
+        if (entry == entry_illegal_)
+        {
+            transition_errors_.store(transition_errors_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+        }
+        else if (entry != entry_none_)
+        {
+            /*
+             *  Publish the steps along with the timestamp of the step.
+             */
+            const long step = entry == entry_backward_ ? -1 : 1;
+            steps_ += Reversed ? -step : step;
+            seqlock_data_.write({ steps_, timestamp });
+        }
+    }
+
+private:
+
+    static constexpr uint8_t entry_backward_ = 0b11; //!< Transition table entry for backward steps.
+    static constexpr uint8_t entry_forward_ = 0b01;  //!< Transition table entry for forward steps.
+    static constexpr uint8_t entry_illegal_ = 0b10;  //!< Transition table entry for illegal transitions.
+    static constexpr uint8_t entry_none_ = 0b00; //!< Transition table entry for no steps.
+
+    /**
+     *  @param  entries Transition table entries.
+     *  @return Packed transition table.
+     *  @brief  Pack the transition table entries.
+     *
+     *  This function packs the 2-bit transition table entries
+     *  into a 32-bit word, the first entry being the least
+     *  significant, such that the table lives in a register
+     *  instead of in flash, which might be inaccessible from
+     *  interrupt service routines.
+     */
+    static constexpr uint32_t
+    pack(const uint8_t (&entries)[16])
+    {
+        uint32_t table = 0;
+
+        for (unsigned i = 0; i < 16; i ++)
+        {
+            table |= static_cast<uint32_t>(entries[i]) << (i << 1);
+        }
+
+        return table;
+    }
+
+    /*
+     *  Transition table, indexed by the last state in bits 3 and 2
+     *  and the current state in bits 1 and 0, with channel A being
+     *  the upper bit of each state. The forward direction follows
+     *  the Gray code sequence 00, 10, 11, 01.
+     */
+    static constexpr uint32_t transition_table_ = pack({
+            entry_none_, entry_backward_, entry_forward_, entry_illegal_,
+            entry_forward_, entry_none_, entry_illegal_, entry_backward_,
+            entry_backward_, entry_illegal_, entry_none_, entry_forward_,
+            entry_illegal_, entry_forward_, entry_backward_, entry_none_ });  //!< Packed transition table.
+
+    Seqlock<QuadratureDecoderData> seqlock_data_;   //!< Quadrature decoder data struct sequence lock.
+    uint8_t state_; //!< Last channel states.
+    long steps_;    //!< Encoder steps, private to the writer.
+    std::atomic<unsigned long> transition_errors_;  //!< Number of illegal transitions.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_QUADRATURE_DECODER_H_
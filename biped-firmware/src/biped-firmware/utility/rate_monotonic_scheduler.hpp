@@ -0,0 +1,380 @@
+/**
+ *  @file   rate_monotonic_scheduler.hpp
+ *  @author Simon Yu
+ *  @date   01/28/2022
+ *  @brief  Rate-monotonic scheduler templated class header.
+ *
+ *  This file defines and implements the rate-monotonic
+ *  scheduler templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_RATE_MONOTONIC_SCHEDULER_H_
+#define UTILITY_RATE_MONOTONIC_SCHEDULER_H_
+
+/*
+ *  External headers.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <esp_attr.h>
+
+/*
+ *  Project headers.
+ */
+#include "utility/timing_histogram.hpp"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam JobCount Maximum number of jobs.
+ *  @tparam GroupCount Number of job groups.
+ *  @tparam BinCount Number of job timing histogram bins.
+ *  @tparam BinWidth Job timing histogram bin width, in microseconds.
+ *  @brief  Rate-monotonic scheduler templated class.
+ *
+ *  This templated class provides functions for registering
+ *  periodic jobs and executing them from a periodic tick, e.g.,
+ *  the real-time task. Each job has an integer tick divisor, i.e.,
+ *  its period in ticks, and a phase offset, i.e., the tick within
+ *  its period at which it runs, such that jobs with the same period
+ *  can be spread over different ticks. Since the periods are counted
+ *  in integer ticks, they never drift.
+ *
+ *  Within a tick, the due jobs run in rate-monotonic priority order,
+ *  i.e., jobs with shorter periods first, and jobs with the same
+ *  period in their registration order, such that, e.g., sensing
+ *  registered before control runs before it.
+ *
+ *  The execution time of every job is recorded into its own timing
+ *  histogram, and summed per tick into the group of the job, e.g.,
+ *  sensing or control, for the per-stage telemetry. The times are
+ *  measured using the clock function given to the constructor, such
+ *  that the scheduler can run against a simulated clock on the host.
+ *
+ *  The scheduler is allocation-free. Jobs must be registered
+ *  before the ticks start, while the timing statistics may be read
+ *  and reset by another task, the same way as timing histograms.
+ */
+template<size_t JobCount, size_t GroupCount, size_t BinCount, uint32_t BinWidth>
+class RateMonotonicScheduler
+{
+    static_assert(JobCount > 0 && GroupCount > 0, "Invalid number of jobs or job groups.");
+
+public:
+
+    /**
+     *  @brief  Job function type.
+     *
+     *  The job function takes the argument pointer given at
+     *  registration, the same way as the task functions.
+     */
+    using Function = void (*)(void*);
+
+    /**
+     *  @brief  Clock function type.
+     *
+     *  The clock function returns the current time, in microseconds.
+     */
+    using Clock = unsigned long (*)();
+
+    /**
+     *  @param  clock Clock function, in microseconds.
+     *  @brief  Rate-monotonic scheduler templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  without any registered jobs.
+     */
+    inline explicit
+    RateMonotonicScheduler(const Clock& clock) : clock_(clock), execution_time_group_ { },
+            group_ran_ { }, job_count_(0), tick_(0)
+    {
+    }
+
+    /**
+     *  @param  name Job name, with static storage duration.
+     *  @param  function Job function.
+     *  @param  argument Job function argument pointer.
+     *  @param  divisor Job period, in ticks.
+     *  @param  phase Tick within the job period at which the job runs.
+     *  @param  group Job group index.
+     *  @return Whether the job was registered.
+     *  @brief  Register a periodic job.
+     *
+     *  This function inserts the given job after all jobs with
+     *  shorter or equal periods, maintaining the rate-monotonic
+     *  priority order. The job first runs at the given phase
+     *  from the next tick. This function fails if the scheduler
+     *  is full, or if the job function, divisor, phase, or group
+     *  is invalid.
+     */
+    inline bool
+    registerJob(const char* name, const Function& function, void* argument,
+            const uint32_t& divisor, const uint32_t& phase, const size_t& group)
+    {
+        if (job_count_ >= JobCount || !function || divisor == 0 || phase >= divisor
+                || group >= GroupCount)
+        {
+            return false;
+        }
+
+        /*
+         *  Shift the jobs with longer periods back by one.
+         */
+        size_t index = job_count_;
+
+        for (; index > 0 && jobs_[index - 1].divisor > divisor; index --)
+        {
+            jobs_[index].assign(jobs_[index - 1]);
+        }
+
+        Job& job = jobs_[index];
+        job.argument = argument;
+        job.countdown = phase;
+        job.divisor = divisor;
+        job.function = function;
+        job.group = group;
+        job.name = name;
+        job.histogram.reset();
+        job_count_ ++;
+
+        return true;
+    }
+
+    /**
+     *  @brief  Execute a tick.
+     *
+     *  This function runs all jobs due at this tick, in the
+     *  rate-monotonic priority order, and records their execution
+     *  times. This function is expected to be called periodically.
+     */
+    inline void IRAM_ATTR
+    tick()
+    {
+        for (size_t group = 0; group < GroupCount; group ++)
+        {
+            execution_time_group_[group] = 0;
+            group_ran_[group] = false;
+        }
+
+        for (size_t index = 0; index < job_count_; index ++)
+        {
+            Job& job = jobs_[index];
+
+            /*
+             *  Count down to the next run of the job, without
+             *  any modulo of a wrapping tick counter.
+             */
+            if (job.countdown > 0)
+            {
+                job.countdown --;
+                continue;
+            }
+
+            job.countdown = job.divisor - 1;
+
+            const unsigned long time_point_start = clock_();
+            job.function(job.argument);
+            const uint32_t execution_time = static_cast<uint32_t>(clock_() - time_point_start);
+
+            job.histogram.record(execution_time);
+            execution_time_group_[job.group] += execution_time;
+            group_ran_[job.group] = true;
+        }
+
+        tick_ ++;
+    }
+
+    /**
+     *  @param  group Job group index.
+     *  @return Execution time of the group in the last tick, in microseconds.
+     *  @brief  Get the execution time of a job group.
+     *
+     *  This function returns the summed execution time of the jobs
+     *  of the given group that ran in the last tick.
+     */
+    inline uint32_t
+    getExecutionTime(const size_t& group) const
+    {
+        return group < GroupCount ? execution_time_group_[group] : 0;
+    }
+
+    /**
+     *  @param  group Job group index.
+     *  @return Whether any job of the group ran in the last tick.
+     *  @brief  Get whether a job group ran.
+     */
+    inline bool
+    getGroupRan(const size_t& group) const
+    {
+        return group < GroupCount && group_ran_[group];
+    }
+
+    /**
+     *  @return Number of registered jobs.
+     *  @brief  Get the number of registered jobs.
+     */
+    inline size_t
+    getJobCount() const
+    {
+        return job_count_;
+    }
+
+    /**
+     *  @param  index Job index, in the rate-monotonic priority order.
+     *  @return Job period, in ticks.
+     *  @brief  Get the period of a job.
+     */
+    inline uint32_t
+    getJobDivisor(const size_t& index) const
+    {
+        return index < job_count_ ? jobs_[index].divisor : 0;
+    }
+
+    /**
+     *  @param  index Job index, in the rate-monotonic priority order.
+     *  @return Job name.
+     *  @brief  Get the name of a job.
+     */
+    inline const char*
+    getJobName(const size_t& index) const
+    {
+        return index < job_count_ ? jobs_[index].name : "";
+    }
+
+    /**
+     *  @param  index Job index, in the rate-monotonic priority order.
+     *  @return Job timing statistics struct.
+     *  @brief  Get the timing statistics of a job.
+     *
+     *  This function computes the execution time statistics of the
+     *  given job since the last reset. This function must not be
+     *  called from an interrupt service routine.
+     */
+    inline TimingStatistics
+    getJobStatistics(const size_t& index) const
+    {
+        return index < job_count_ ? jobs_[index].histogram.getStatistics() : TimingStatistics();
+    }
+
+    /**
+     *  @return Number of executed ticks.
+     *  @brief  Get the number of executed ticks.
+     */
+    inline uint32_t
+    getTick() const
+    {
+        return tick_;
+    }
+
+    /**
+     *  @param  period Tick period, in microseconds.
+     *  @return Processor utilization, between 0 and 1 if schedulable.
+     *  @brief  Get the processor utilization.
+     *
+     *  This function sums the mean execution times of all jobs over
+     *  their periods since the last reset. The Liu and Layland bound
+     *  does not apply within a single tick, as all due jobs must
+     *  complete before the next tick, but the utilization shows the
+     *  headroom left for the lower priority tasks.
+     */
+    inline double
+    getUtilization(const double& period) const
+    {
+        double utilization = 0;
+
+        for (size_t index = 0; index < job_count_; index ++)
+        {
+            utilization += jobs_[index].histogram.getStatistics().mean
+                    / (jobs_[index].divisor * period);
+        }
+
+        return utilization;
+    }
+
+    /**
+     *  @brief  Reset the job timing statistics.
+     *
+     *  This function requests the timing histograms of all jobs
+     *  to be cleared, starting a new statistics window.
+     */
+    inline void
+    reset()
+    {
+        for (size_t index = 0; index < job_count_; index ++)
+        {
+            jobs_[index].histogram.reset();
+        }
+    }
+
+private:
+
+    /**
+     *  @brief  Job struct.
+     *
+     *  This struct contains the entries of a registered job,
+     *  as well as its execution time histogram.
+     */
+    struct Job
+    {
+        void* argument; //!< Job function argument pointer.
+        uint32_t countdown; //!< Ticks until the next run.
+        uint32_t divisor;   //!< Job period, in ticks.
+        Function function;  //!< Job function.
+        size_t group;   //!< Job group index.
+        TimingHistogram<BinCount> histogram;    //!< Execution time histogram.
+        const char* name;   //!< Job name.
+
+        /**
+         *  @brief  Job struct constructor.
+         *
+         *  This constructor initializes all job struct entries.
+         */
+        inline
+        Job() : argument(nullptr), countdown(0), divisor(0), function(nullptr), group(0),
+                histogram(0, BinWidth), name("")
+        {
+        }
+
+        /**
+         *  @param  job Job struct.
+         *  @brief  Assign the entries of a job.
+         *
+         *  This function copies the entries of the given job, except for
+         *  the execution time histogram, which is not copyable and is
+         *  reset instead.
+         */
+        inline void
+        assign(const Job& job)
+        {
+            argument = job.argument;
+            countdown = job.countdown;
+            divisor = job.divisor;
+            function = job.function;
+            group = job.group;
+            name = job.name;
+            histogram.reset();
+        }
+    };
+
+    Clock clock_;   //!< Clock function, in microseconds.
+    uint32_t execution_time_group_[GroupCount]; //!< Execution times of the job groups in the last tick, in microseconds.
+    bool group_ran_[GroupCount];    //!< Whether the job groups ran in the last tick.
+    size_t job_count_;  //!< Number of registered jobs.
+    Job jobs_[JobCount];    //!< Registered jobs, in the rate-monotonic priority order.
+    uint32_t tick_; //!< Number of executed ticks.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_RATE_MONOTONIC_SCHEDULER_H_
@@ -0,0 +1,192 @@
+/**
+ *  @file   ring_buffer.hpp
+ *  @author Simon Yu
+ *  @date   01/30/2022
+ *  @brief  Ring buffer templated class header.
+ *
+ *  This file defines and implements the single-producer
+ *  single-consumer ring buffer templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_RING_BUFFER_H_
+#define UTILITY_RING_BUFFER_H_
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <cstddef>
+#include <esp_attr.h>
+#include <type_traits>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of the elements.
+ *  @tparam Capacity Number of elements, a power of two.
+ *  @brief  Ring buffer templated class.
+ *
+ *  This templated class provides functions for passing a
+ *  stream of elements from a single producer task to a single
+ *  consumer task, in order and without any element being
+ *  consumed twice, e.g., the real-time task samples to the
+ *  Biped message UDP write task.
+ *
+ *  The producer owns the head index and the consumer owns the
+ *  tail index. Both indices run freely and are masked into the
+ *  element array, such that a full ring buffer can be told apart
+ *  from an empty one. Pushing and popping are lock-free and never
+ *  wait for the other side. When the ring buffer is full, pushing
+ *  drops the new element and counts the overflow, such that the
+ *  producer, e.g., the real-time task, never blocks.
+ *
+ *  The producer and the consumer must each be unique.
+ */
+template<typename Type, size_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+            "Ring buffer capacity must be a power of two.");
+    static_assert(std::is_trivially_copyable<Type>::value,
+            "Ring buffer elements must be trivially copyable.");
+
+public:
+
+    /**
+     *  @brief  Ring buffer templated class constructor.
+     *
+     *  This constructor initializes all class member variables,
+     *  with an empty ring buffer.
+     */
+    inline
+    RingBuffer() : elements_ { }, head_(0), overflow_(0), tail_(0)
+    {
+    }
+
+    /**
+     *  @brief  Ring buffer templated class copy constructor (deleted).
+     */
+    RingBuffer(const RingBuffer&) = delete;
+
+    /**
+     *  @brief  Ring buffer templated class copy assignment operator (deleted).
+     */
+    RingBuffer&
+    operator=(const RingBuffer&) = delete;
+
+    /**
+     *  @return Number of dropped elements.
+     *  @brief  Get the number of dropped elements.
+     *
+     *  This function returns the number of elements dropped
+     *  by pushing into a full ring buffer.
+     */
+    inline unsigned long
+    getOverflow() const
+    {
+        return overflow_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     *  @return Number of elements in the ring buffer.
+     *  @brief  Get the number of elements in the ring buffer.
+     *
+     *  This function may be called by either side, and the number
+     *  might have changed by the other side once it returns.
+     */
+    inline size_t
+    getSize() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     *  @param  element Popped element.
+     *  @return Whether an element was popped.
+     *  @brief  Pop the oldest element.
+     *
+     *  This function copies the oldest element into the given
+     *  element and removes it from the ring buffer. This function
+     *  fails if the ring buffer is empty, and must only be called
+     *  by the consumer.
+     */
+    inline bool
+    pop(Type& element)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+
+        /*
+         *  Acquire the element published by the producer.
+         */
+        if (head_.load(std::memory_order_acquire) == tail)
+        {
+            return false;
+        }
+
+        element = elements_[tail & (Capacity - 1)];
+
+        /*
+         *  Release the slot back to the producer only after
+         *  the copy completes.
+         */
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     *  @param  element Element to be pushed.
+     *  @return Whether the element was pushed.
+     *  @brief  Push an element.
+     *
+     *  This function copies the given element into the ring buffer.
+     *  If the ring buffer is full, this function drops the element
+     *  and counts the overflow. This function is safe to be called
+     *  from an interrupt service routine, but must only be called by
+     *  the producer.
+     */
+    inline bool IRAM_ATTR
+    push(const Type& element)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+
+        /*
+         *  Acquire the slot released by the consumer.
+         */
+        if (head - tail_.load(std::memory_order_acquire) >= Capacity)
+        {
+            overflow_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        elements_[head & (Capacity - 1)] = element;
+
+        /*
+         *  Publish the element to the consumer only after
+         *  the copy completes.
+         */
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    Type elements_[Capacity];   //!< Element array.
+    std::atomic<size_t> head_;  //!< Head index, i.e., the number of pushed elements.
+    std::atomic<unsigned long> overflow_;   //!< Number of dropped elements.
+    std::atomic<size_t> tail_;  //!< Tail index, i.e., the number of popped elements.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_RING_BUFFER_H_
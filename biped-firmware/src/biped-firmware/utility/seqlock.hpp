@@ -0,0 +1,195 @@
+/**
+ *  @file   seqlock.hpp
+ *  @author Simon Yu
+ *  @date   01/21/2022
+ *  @brief  Sequence lock templated class header.
+ *
+ *  This file defines and implements the sequence lock
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_SEQLOCK_H_
+#define UTILITY_SEQLOCK_H_
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <esp_attr.h>
+#include <type_traits>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of data to be shared.
+ *  @brief  Sequence lock templated class.
+ *
+ *  This templated class provides functions for publishing
+ *  data from a single writer task to any number of reader
+ *  tasks, such that the readers always obtain a coherent
+ *  snapshot of the data, i.e., never a mix of two writes.
+ *
+ *  The class keeps two copies of the data and a sequence
+ *  number, whose lowest bit selects the copy that the writer
+ *  is not modifying. Writing is wait-free and never waits for
+ *  the readers, making it suitable for the real-time task.
+ *  Reading copies the stable copy in constant time, and only
+ *  retries if the writer published twice during the copy.
+ *
+ *  The writer must be unique. Multiple writer tasks must be
+ *  serialized externally, e.g., using a mutex.
+ *
+ *  Learn more about sequence locks here:
+ *  https://en.wikipedia.org/wiki/Seqlock
+ */
+template<typename Type>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable<Type>::value,
+            "Sequence lock data must be trivially copyable.");
+
+public:
+
+    /**
+     *  @brief  Sequence lock templated class constructor.
+     *
+     *  This constructor initializes all class member variables
+     *  and value-initializes both copies of the data.
+     */
+    inline
+    Seqlock() : data_ { }, sequence_(0)
+    {
+    }
+
+    /**
+     *  @brief  Sequence lock templated class copy constructor (deleted).
+     */
+    Seqlock(const Seqlock&) = delete;
+
+    /**
+     *  @brief  Sequence lock templated class copy assignment operator (deleted).
+     */
+    Seqlock&
+    operator=(const Seqlock&) = delete;
+
+    /**
+     *  @return Sequence number.
+     *  @brief  Get the sequence number.
+     *
+     *  This function returns the sequence number, which
+     *  increases by 2 for every write. Readers may compare
+     *  sequence numbers to detect newly published data.
+     */
+    inline uint32_t
+    getSequence() const
+    {
+        return sequence_.load(std::memory_order_acquire);
+    }
+
+    /**
+     *  @return Snapshot of the data.
+     *  @brief  Read a snapshot of the data.
+     *
+     *  This function returns a coherent snapshot of the most
+     *  recently published data.
+     */
+    inline Type
+    read() const
+    {
+        Type data;
+        read(data);
+        return data;
+    }
+
+    /**
+     *  @param  data Snapshot of the data.
+     *  @return Sequence number of the snapshot.
+     *  @brief  Read a snapshot of the data.
+     *
+     *  This function copies a coherent snapshot of the most
+     *  recently published data into the given data, and returns
+     *  the sequence number of the snapshot.
+     */
+    inline uint32_t
+    read(Type& data) const
+    {
+        uint32_t sequence = sequence_.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            /*
+             *  Copy the copy that the writer is not modifying,
+             *  byte-wise, since the writer might have moved on to
+             *  it by the time the copy completes.
+             */
+            std::memcpy(&data, &data_[sequence & 1], sizeof(Type));
+
+            /*
+             *  Order the copy before the sequence number check, and
+             *  retry if the writer has since started modifying the
+             *  copied copy.
+             */
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint32_t sequence_check = sequence_.load(std::memory_order_relaxed);
+
+            if (sequence_check == sequence)
+            {
+                return sequence;
+            }
+
+            sequence = sequence_check;
+        }
+    }
+
+    /**
+     *  @param  data Data to be published.
+     *  @brief  Publish the data.
+     *
+     *  This function publishes the given data to the readers.
+     *  This function is safe to be called from an interrupt service
+     *  routine, but must only be called by a single writer.
+     */
+    inline void IRAM_ATTR
+    write(const Type& data)
+    {
+        const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+
+        /*
+         *  Direct the readers to the second copy and update
+         *  the first copy.
+         */
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&data_[0], &data, sizeof(Type));
+
+        /*
+         *  Direct the readers to the updated first copy and
+         *  update the second copy.
+         */
+        sequence_.store(sequence + 2, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&data_[1], &data, sizeof(Type));
+    }
+
+private:
+
+    Type data_[2];  //!< Data copies.
+    std::atomic<uint32_t> sequence_;    //!< Sequence number.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_SEQLOCK_H_
@@ -0,0 +1,339 @@
+/**
+ *  @file   timing_histogram.hpp
+ *  @author Simon Yu
+ *  @date   01/20/2022
+ *  @brief  Timing histogram templated class header.
+ *
+ *  This file defines and implements the timing histogram
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_TIMING_HISTOGRAM_H_
+#define UTILITY_TIMING_HISTOGRAM_H_
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <esp_attr.h>
+#include <limits>
+
+/*
+ *  Project headers.
+ */
+#include "common/type.h"
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam BinCount Number of histogram bins.
+ *  @brief  Timing histogram templated class.
+ *
+ *  This templated class provides functions for recording
+ *  timing samples, in microseconds, into a fixed-size linear
+ *  histogram, and for computing the minimum, maximum, mean,
+ *  and percentiles of the recorded samples.
+ *
+ *  The histogram is allocation-free and lock-free. Samples
+ *  may be recorded by a single writer, including from an
+ *  interrupt service routine, while another task reads the
+ *  statistics. The writer only performs atomic loads and
+ *  stores on 32-bit words, which are native on the ESP32.
+ *
+ *  The samples are recorded into one of two banks. Collecting
+ *  the statistics reads the bank the writer swapped out last
+ *  and requests the writer to swap again, such that every
+ *  sample is collected exactly once, one window late.
+ *
+ *  Samples below the lower bound or beyond the last bin are
+ *  counted in the first or the last bin, respectively, while
+ *  the minimum and maximum are always exact. Percentiles are
+ *  interpolated to the middle of their bin and clamped between
+ *  the minimum and maximum.
+ */
+template<size_t BinCount>
+class TimingHistogram
+{
+    static_assert(BinCount > 0, "Invalid number of histogram bins.");
+
+public:
+
+    /**
+     *  @param  lower_bound Lower bound of the first bin, in microseconds.
+     *  @param  bin_width Bin width, in microseconds.
+     *  @brief  Timing histogram templated class constructor.
+     *
+     *  This constructor initializes all class member variables
+     *  and clears both banks.
+     */
+    inline
+    TimingHistogram(const uint32_t& lower_bound, const uint32_t& bin_width) :
+            bin_width_(bin_width > 0 ? bin_width : 1), index_(0), lower_bound_(lower_bound),
+            swap_(false)
+    {
+        clear(banks_[0]);
+        clear(banks_[1]);
+    }
+
+    /**
+     *  @return Timing statistics struct.
+     *  @brief  Collect the timing statistics.
+     *
+     *  This function computes the timing statistics of the bank
+     *  the writer swapped out last, clears it, and requests the
+     *  writer to swap the banks before recording its next sample.
+     *  The statistics returned therefore cover the samples recorded
+     *  between the previous two swaps. If the writer has not swapped
+     *  since the last request, i.e., recorded no sample since, the
+     *  statistics are empty. This function must not be called from
+     *  an interrupt service routine, and must only be called by a
+     *  single reader.
+     */
+    inline TimingStatistics
+    collectStatistics()
+    {
+        /*
+         *  The acquire load pairs with the release store of the
+         *  writer acknowledging the swap, after which the writer
+         *  no longer writes to the bank swapped out.
+         */
+        if (swap_.load(std::memory_order_acquire))
+        {
+            return TimingStatistics();
+        }
+
+        Bank& bank = banks_[1 - index_.load(std::memory_order_relaxed)];
+        const TimingStatistics timing_statistics = getStatistics(bank);
+
+        clear(bank);
+        swap_.store(true, std::memory_order_release);
+
+        return timing_statistics;
+    }
+
+    /**
+     *  @return Timing statistics struct.
+     *  @brief  Get the timing statistics.
+     *
+     *  This function computes the timing statistics of the samples
+     *  recorded since the last swap, without collecting them. This
+     *  function must not be called from an interrupt service routine.
+     */
+    inline TimingStatistics
+    getStatistics() const
+    {
+        return getStatistics(banks_[index_.load(std::memory_order_relaxed)]);
+    }
+
+    /**
+     *  @param  sample Timing sample, in microseconds.
+     *  @brief  Record a timing sample.
+     *
+     *  This function records the given timing sample into the
+     *  histogram, and swaps the banks beforehand if requested.
+     *  This function is safe to be called from an interrupt
+     *  service routine, but must only be called by a single writer.
+     */
+    inline void IRAM_ATTR
+    record(const uint32_t& sample)
+    {
+        /*
+         *  Swap the banks as requested by the reader. The bank
+         *  swapped in has been cleared by the reader beforehand.
+         */
+        uint32_t index = index_.load(std::memory_order_relaxed);
+
+        if (swap_.load(std::memory_order_acquire))
+        {
+            index = 1 - index;
+            index_.store(index, std::memory_order_relaxed);
+            swap_.store(false, std::memory_order_release);
+        }
+
+        Bank& bank = banks_[index];
+
+        /*
+         *  Find the bin of the sample, with the out-of-range
+         *  samples counted in the first or the last bin.
+         */
+        const uint32_t offset = sample > lower_bound_ ? sample - lower_bound_ : 0;
+        const size_t index_bin = offset / bin_width_ < BinCount ? offset / bin_width_ : BinCount - 1;
+
+        /*
+         *  Since there is only a single writer, plain relaxed loads
+         *  and stores suffice and avoid read-modify-write operations.
+         *  The sum saturates instead of wrapping around.
+         */
+        const uint32_t sum = bank.sum.load(std::memory_order_relaxed);
+
+        bank.bins[index_bin].store(bank.bins[index_bin].load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+        bank.count.store(bank.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        bank.sum.store(sum > std::numeric_limits<uint32_t>::max() - sample ?
+                std::numeric_limits<uint32_t>::max() : sum + sample, std::memory_order_relaxed);
+
+        if (sample < bank.minimum.load(std::memory_order_relaxed))
+        {
+            bank.minimum.store(sample, std::memory_order_relaxed);
+        }
+
+        if (sample > bank.maximum.load(std::memory_order_relaxed))
+        {
+            bank.maximum.store(sample, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     *  @brief  Reset the histogram.
+     *
+     *  This function collects the timing statistics and discards
+     *  them, starting a new statistics window.
+     */
+    inline void
+    reset()
+    {
+        collectStatistics();
+    }
+
+private:
+
+    /**
+     *  @brief  Bank struct.
+     *
+     *  This struct contains the bins and statistics of a bank.
+     */
+    struct Bank
+    {
+        std::atomic<uint32_t> bins[BinCount];   //!< Histogram bins.
+        std::atomic<uint32_t> count;    //!< Sample count.
+        std::atomic<uint32_t> maximum;  //!< Maximum, in microseconds.
+        std::atomic<uint32_t> minimum;  //!< Minimum, in microseconds.
+        std::atomic<uint32_t> sum;  //!< Saturating sample sum, in microseconds.
+    };
+
+    /**
+     *  @param  bank Bank struct.
+     *  @brief  Clear a bank.
+     *
+     *  This function clears all bins and statistics of the given bank.
+     */
+    inline void
+    clear(Bank& bank)
+    {
+        for (size_t i = 0; i < BinCount; i ++)
+        {
+            bank.bins[i].store(0, std::memory_order_relaxed);
+        }
+
+        bank.count.store(0, std::memory_order_relaxed);
+        bank.maximum.store(0, std::memory_order_relaxed);
+        bank.minimum.store(std::numeric_limits<uint32_t>::max(), std::memory_order_relaxed);
+        bank.sum.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     *  @param  bins Snapshot of the bins.
+     *  @param  count Number of samples in the snapshot.
+     *  @param  percentile Percentile, between 0 and 1.
+     *  @param  minimum Minimum, in microseconds.
+     *  @param  maximum Maximum, in microseconds.
+     *  @return Percentile, in microseconds.
+     *  @brief  Compute a percentile from a snapshot of the bins.
+     *
+     *  This function finds the bin containing the given percentile
+     *  and returns the middle of the bin, clamped between the given
+     *  minimum and maximum.
+     */
+    inline double
+    getPercentile(const uint32_t* bins, const uint32_t& count, const double& percentile,
+            const uint32_t& minimum, const uint32_t& maximum) const
+    {
+        const double rank = percentile * count;
+        uint32_t count_cumulative = 0;
+        size_t index = 0;
+
+        for (; index < BinCount - 1; index ++)
+        {
+            count_cumulative += bins[index];
+
+            if (count_cumulative >= rank)
+            {
+                break;
+            }
+        }
+
+        const double middle = lower_bound_ + (index + 0.5) * bin_width_;
+
+        return middle < minimum ? minimum : (middle > maximum ? maximum : middle);
+    }
+
+    /**
+     *  @param  bank Bank struct.
+     *  @return Timing statistics struct.
+     *  @brief  Compute the timing statistics of a bank.
+     *
+     *  This function computes the timing statistics of the samples
+     *  recorded into the given bank.
+     */
+    inline TimingStatistics
+    getStatistics(const Bank& bank) const
+    {
+        TimingStatistics timing_statistics;
+        uint32_t bins[BinCount];
+        uint32_t count = 0;
+
+        /*
+         *  Take a snapshot of the bins and count the samples
+         *  in the snapshot, such that the percentiles are
+         *  consistent with the snapshot.
+         */
+        for (size_t i = 0; i < BinCount; i ++)
+        {
+            bins[i] = bank.bins[i].load(std::memory_order_relaxed);
+            count += bins[i];
+        }
+
+        if (count == 0)
+        {
+            return timing_statistics;
+        }
+
+        const uint32_t count_sum = bank.count.load(std::memory_order_relaxed);
+        const uint32_t minimum = bank.minimum.load(std::memory_order_relaxed);
+        const uint32_t maximum = bank.maximum.load(std::memory_order_relaxed);
+
+        timing_statistics.count = count;
+        timing_statistics.maximum = maximum;
+        timing_statistics.mean = count_sum > 0 ?
+                static_cast<double>(bank.sum.load(std::memory_order_relaxed)) / count_sum : 0;
+        timing_statistics.minimum = minimum;
+        timing_statistics.percentile_50 = getPercentile(bins, count, 0.5, minimum, maximum);
+        timing_statistics.percentile_90 = getPercentile(bins, count, 0.9, minimum, maximum);
+        timing_statistics.percentile_99 = getPercentile(bins, count, 0.99, minimum, maximum);
+
+        return timing_statistics;
+    }
+
+    Bank banks_[2]; //!< Banks, one recorded into and the other swapped out.
+    const uint32_t bin_width_;  //!< Bin width, in microseconds.
+    std::atomic<uint32_t> index_;   //!< Index of the bank recorded into.
+    const uint32_t lower_bound_;    //!< Lower bound of the first bin, in microseconds.
+    std::atomic<bool> swap_;    //!< Bank swap request flag.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_TIMING_HISTOGRAM_H_
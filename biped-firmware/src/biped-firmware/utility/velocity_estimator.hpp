@@ -0,0 +1,192 @@
+/**
+ *  @file   velocity_estimator.hpp
+ *  @author Simon Yu
+ *  @date   01/23/2022
+ *  @brief  Velocity estimator templated class header.
+ *
+ *  This file defines and implements the velocity estimator
+ *  templated class.
+ */
+
+/*
+ *  Include guard.
+ */
+#ifndef UTILITY_VELOCITY_ESTIMATOR_H_
+#define UTILITY_VELOCITY_ESTIMATOR_H_
+
+/*
+ *  External headers.
+ */
+#include <cstdint>
+
+/*
+ *  Biped namespace.
+ */
+namespace biped
+{
+/*
+ *  Firmware namespace.
+ */
+namespace firmware
+{
+/**
+ *  @tparam Type Type of data for estimation.
+ *  @brief  Velocity estimator templated class.
+ *
+ *  This templated class provides functions for estimating the
+ *  velocity of an encoder from its steps and the timestamp of
+ *  its last step, taken by the encoder interrupt handlers.
+ *
+ *  The velocity is the number of steps since the last estimate,
+ *  divided by the time between the last step before and the
+ *  last step since the last estimate. At high speed, this
+ *  counts many steps over an exact time interval, and at low
+ *  speed, this measures the period of a single step, i.e., the
+ *  velocity is the reciprocal of the step period. Unlike the
+ *  step differences over a fixed period, the estimate is not
+ *  quantized to multiples of one step per period.
+ *
+ *  The velocity is 0 until the second step after a stop or a
+ *  direction change, such that an encoder dithering around a
+ *  step does not produce spurious velocities.
+ *
+ *  If no step occurred since the last estimate, the velocity
+ *  cannot exceed one step over the time since the last step,
+ *  and the estimate decays accordingly, down to 0 once the
+ *  time since the last step exceeds the timeout.
+ */
+template<typename Type>
+class VelocityEstimator
+{
+public:
+
+    /**
+     *  @brief  Velocity estimator templated class constructor.
+     *
+     *  This constructor initializes all class member variables.
+     */
+    inline
+    VelocityEstimator() : forward_(true), initialized_(false), stopped_(true), steps_last_(0),
+            timeout_(0), timestamp_last_(0), velocity_(0)
+    {
+    }
+
+    /**
+     *  @param  timeout Timeout, in microseconds.
+     *  @brief  Set the timeout.
+     *
+     *  This function sets the timeout, i.e., the time since the
+     *  last step after which the encoder is considered stopped.
+     *  The timeout must be shorter than the wrap-around period of
+     *  the timestamps.
+     */
+    inline void
+    setTimeout(const uint32_t& timeout)
+    {
+        timeout_ = timeout;
+    }
+
+    /**
+     *  @param  steps Encoder steps.
+     *  @param  timestamp_step Timestamp of the last step, in microseconds.
+     *  @param  timestamp Current timestamp, in microseconds.
+     *  @return Estimated velocity, in steps per second.
+     *  @brief  Estimate the velocity.
+     *
+     *  This function estimates the velocity from the given encoder
+     *  steps and timestamps. The encoder steps and the timestamp of
+     *  the last step must be a coherent snapshot. This function is
+     *  expected to be called periodically.
+     */
+    inline Type
+    estimate(const long& steps, const uint32_t& timestamp_step, const uint32_t& timestamp)
+    {
+        /*
+         *  Take the first steps as the reference.
+         */
+        if (!initialized_)
+        {
+            steps_last_ = steps;
+            timestamp_last_ = timestamp_step;
+            initialized_ = true;
+            return velocity_;
+        }
+
+        const long steps_delta = steps - steps_last_;
+
+        /*
+         *  A new timestamp indicates steps since the last estimate,
+         *  even if the steps cancel out after a direction change.
+         */
+        if (timestamp_step != timestamp_last_)
+        {
+            /*
+             *  Divide the steps by the time between the last steps.
+             *  The first step after a stop or a direction change only
+             *  restarts the timing, since the time between a step and
+             *  a step in the opposite direction, e.g., of an encoder
+             *  dithering around a step, does not reflect the velocity.
+             *  The unsigned timestamp differences are wrap-around safe.
+             */
+            const uint32_t period = timestamp_step - timestamp_last_;
+            const bool forward = steps_delta > 0;
+
+            if (stopped_ || steps_delta == 0 || forward != forward_)
+            {
+                stopped_ = false;
+                velocity_ = Type(0);
+            }
+            else if (period > 0)
+            {
+                velocity_ = Type(steps_delta) / Type(1e-6f * period);
+            }
+
+            forward_ = forward;
+            steps_last_ = steps;
+            timestamp_last_ = timestamp_step;
+        }
+        else
+        {
+            /*
+             *  Without a step since the last estimate, the velocity is
+             *  at most one step over the time since the last step.
+             */
+            const uint32_t elapsed = timestamp - timestamp_last_;
+
+            if (stopped_ || elapsed >= timeout_)
+            {
+                stopped_ = true;
+                velocity_ = Type(0);
+            }
+            else if (elapsed > 0)
+            {
+                const Type velocity_max = Type(1) / Type(1e-6f * elapsed);
+
+                if (velocity_ > velocity_max)
+                {
+                    velocity_ = velocity_max;
+                }
+                else if (velocity_ < -velocity_max)
+                {
+                    velocity_ = -velocity_max;
+                }
+            }
+        }
+
+        return velocity_;
+    }
+
+private:
+
+    bool forward_;  //!< Direction of the last steps.
+    bool initialized_;  //!< Initialization flag.
+    bool stopped_;  //!< Stopped flag.
+    long steps_last_;   //!< Encoder steps at the last step.
+    uint32_t timeout_;  //!< Timeout, in microseconds.
+    uint32_t timestamp_last_;   //!< Timestamp of the last step, in microseconds.
+    Type velocity_; //!< Estimated velocity, in steps per second.
+};
+}   // namespace firmware
+}   // namespace biped
+
+#endif  // UTILITY_VELOCITY_ESTIMATOR_H_
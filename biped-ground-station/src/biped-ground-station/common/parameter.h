@@ -8,35 +8,64 @@ namespace biped
 {
 namespace ground_station
 {
+namespace CameraDaemonParameter
+{
+constexpr size_t decode_thread_count = 2;
+constexpr uint32_t frame_id_window = 64;
+constexpr size_t frame_size_max = 262144;
+constexpr int period_feedback = 500;
+constexpr size_t slot_count = 4;
+constexpr size_t buffer_count = slot_count + 2 * decode_thread_count;
+}
+
 namespace JoypadDaemonParameter
 {
 constexpr double deadzone_factor = 0.01;
 constexpr char path_device_default[] = "/dev/input/js0";
+constexpr int period_reconnect = 1000;
 constexpr size_t timeout = 200000;
 constexpr size_t value_limit = 32767;
 }
 
 namespace LoggingDaemonParameter
 {
+constexpr size_t block_size_logging_data = 1048576;
+constexpr bool compression_logging_data = true;
 constexpr char path_logging[] = "~/Downloads";
 constexpr char directory_name_logging[] = "biped";
 constexpr char directory_name_logging_camera[] = "camera";
 constexpr char directory_name_logging_data[] = "data";
-constexpr char file_extension_logging_camera[] = ".jpg";
+constexpr char file_extension_logging_camera[] = ".mjpeg";
 constexpr char file_extension_logging_data[] = ".log";
+constexpr char file_extension_logging_data_binary[] = ".bin";
+constexpr char file_name_suffix_logging_camera[] = "-camera";
+constexpr char file_name_suffix_logging_sample[] = "-sample";
+constexpr int period_flush_logging_data = 1000;
 }
 
 namespace NetworkParameter
 {
+constexpr size_t batch_size_receive = 32;
 constexpr size_t buffer_size_biped_message = 1024;
 constexpr size_t buffer_size_camera = 1460;
-constexpr char camera_frame_boundary[] = "123456789000000000000987654321";
+constexpr size_t buffer_size_telemetry_frame = 1460;
+constexpr size_t buffer_size_datagram = 1500;
+constexpr int buffer_size_socket_receive = 1048576;
 constexpr char ip_biped_default[] = "192.168.0.100";
 constexpr uint16_t port_udp_biped_message = 4431;
 constexpr uint16_t port_udp_camera = 4432;
+constexpr size_t ring_size_receive = 256;
+constexpr int retransmission_period_command = 200;
 constexpr size_t timeout = 200;
 }
 
+namespace TelemetryBusParameter
+{
+constexpr size_t capacity = 1024;
+constexpr size_t capacity_frame = 256;
+constexpr size_t consumer_count = 4;
+}
+
 namespace UIParameter
 {
 constexpr double confirm_dialog_text_resize_factor = 1.1;
@@ -45,11 +74,14 @@ constexpr size_t confirm_dialog_button_width_minimum = 70;
 constexpr size_t parameter_dialog_text_edit_height_fixed = 90;
 constexpr char parameter_set_push_button_pin_style_pinned[] = "background-color: rgb(223, 106, 106); color: rgb(246, 246, 227);";
 constexpr unsigned rolling_plot_rolling_window_capacity_default = 50;
+constexpr unsigned window_controller_response_plot_rolling_window_capacity = 1000;
 constexpr unsigned window_parameter_label_current_style_reset_delay = 5000;
 constexpr char window_parameter_label_current_style_updated[] = "color: rgb(0, 200, 0);";
 constexpr unsigned window_rendering_fps_cap_default_biped_message = 60;
 constexpr unsigned window_rendering_fps_cap_default_camera_frame = 60;
 constexpr double window_rendering_value_limit = 9999;
+constexpr uint8_t window_telemetry_divisor_balance_position = 10;
+constexpr uint8_t window_telemetry_divisor_navigation = 8;
 }
 }
 }
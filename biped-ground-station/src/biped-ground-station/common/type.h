@@ -16,8 +16,15 @@
 /*
  *  External headers.
  */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <type_traits>
 
 /*
  *  Project headers.
@@ -84,6 +91,207 @@ struct ActuationCommand
     }
 };
 
+/**
+ *  @brief  Camera frame size enum class.
+ *
+ *  This enum class defines the camera frame sizes that the
+ *  camera rate controller may select, from the smallest to the
+ *  largest, i.e., the frame size the camera driver starts with.
+ */
+enum class CameraFrameSize : uint8_t
+{
+    qqvga = 0,  //!< 160 by 120 pixels.
+    qvga,   //!< 320 by 240 pixels.
+    hvga,   //!< 480 by 320 pixels.
+    count   //!< Number of camera frame sizes.
+};
+
+/**
+ *  @brief  Camera setting struct.
+ *
+ *  This struct contains the camera frame size, JPEG quality, and
+ *  frame rate selected by the camera rate controller. A frame rate
+ *  of 0 denotes no setting, i.e., the camera driver defaults.
+ */
+struct CameraSetting
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    CameraFrameSize frame_size; //!< Camera frame size.
+    uint8_t frame_rate; //!< Maximum frame rate, in frames per second.
+    uint8_t jpeg_quality;   //!< JPEG quality, from 0 (best) to 63 (worst).
+
+    /**
+     *  @brief  Camera setting struct constructor.
+     *
+     *  This constructor initializes all camera setting struct
+     *  entries to no setting.
+     */
+    CameraSetting() : frame_size(CameraFrameSize::hvga), frame_rate(0), jpeg_quality(0)
+    {
+    }
+
+    /**
+     *  @param  frame_size Camera frame size.
+     *  @param  jpeg_quality JPEG quality, from 0 (best) to 63 (worst).
+     *  @param  frame_rate Maximum frame rate, in frames per second.
+     *  @brief  Camera setting struct constructor.
+     */
+    constexpr
+    CameraSetting(const CameraFrameSize& frame_size, const uint8_t& jpeg_quality,
+            const uint8_t& frame_rate) : frame_size(frame_size), frame_rate(frame_rate),
+            jpeg_quality(jpeg_quality)
+    {
+    }
+
+    /**
+     *  @return Number of pixels of the camera frame size.
+     *  @brief  Get the number of pixels of the camera frame size.
+     */
+    inline size_t
+    getPixelCount() const
+    {
+        switch (frame_size)
+        {
+            case CameraFrameSize::qqvga:
+            {
+                return 160 * 120;
+            }
+            case CameraFrameSize::qvga:
+            {
+                return 320 * 240;
+            }
+            case CameraFrameSize::hvga:
+            {
+                return 480 * 320;
+            }
+            default:
+            {
+                return 0;
+            }
+        }
+    }
+
+    /**
+     *  @param  other Other camera setting struct.
+     *  @return Whether both camera setting structs are equal.
+     */
+    inline bool
+    operator==(const CameraSetting& other) const
+    {
+        return frame_size == other.frame_size && frame_rate == other.frame_rate
+                && jpeg_quality == other.jpeg_quality;
+    }
+
+    /**
+     *  @param  other Other camera setting struct.
+     *  @return Whether both camera setting structs differ.
+     */
+    inline bool
+    operator!=(const CameraSetting& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Camera setting serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.frame_size, self.frame_rate, self.jpeg_quality);
+    }
+};
+
+/**
+ *  @brief  Command acknowledgement struct.
+ *
+ *  This struct contains the session and the sequence number of
+ *  the last command message that the Biped firmware applied, such
+ *  that the Biped ground station stops retransmitting the command
+ *  messages up to and including that sequence number.
+ */
+struct CommandAcknowledgement
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    uint32_t sequence;  //!< Sequence number of the last applied command message.
+    uint32_t session;   //!< Session of the Biped ground station.
+
+    /**
+     *  @brief  Command acknowledgement struct constructor.
+     *
+     *  This constructor initializes all command acknowledgement struct
+     *  entries to 0, i.e., no session and no applied command message.
+     */
+    CommandAcknowledgement() : sequence(0), session(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Command acknowledgement serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.sequence, self.session);
+    }
+};
+
+/**
+ *  @brief  Command type enum class.
+ *
+ *  This enum class defines the types of the command messages
+ *  from the Biped ground station, each of which changes a single
+ *  controller parameter, the controller reference, or the planner.
+ */
+enum class CommandType : uint8_t
+{
+    set_gain_attitude_y = 0,    //!< Set the Y attitude (pitch) PID controller gain struct.
+    set_gain_attitude_z,    //!< Set the Z attitude (yaw) PID controller gain struct.
+    set_gain_open_loop_attitude_z,  //!< Set the Z attitude (yaw) open-loop controller gain.
+    set_gain_position_x,    //!< Set the X position PID controller gain struct.
+    set_mode,   //!< Set the controller mode.
+    set_reference,  //!< Set the controller reference struct.
+    set_saturation_position_x,  //!< Set the X position PID controller saturation struct.
+    start_plan  //!< Start the planner.
+};
+
+/**
+ *  @brief  Controller mode enum class.
+ *
+ *  This enum class defines controller modes.
+ */
+enum class ControllerMode
+{
+    pid = 0,    //!< Cascaded PID and open-loop controller mode.
+    state_feedback  //!< Full state-feedback controller mode.
+};
+
 /**
  *  @brief  Controller reference struct.
  *
@@ -165,6 +373,30 @@ struct ControllerSaturation
     {
     }
 
+    /**
+     *  @param  saturation Controller saturation struct.
+     *  @return Whether all entries equal those of the given struct.
+     *  @brief  Controller saturation equality operator.
+     */
+    inline bool
+    operator==(const ControllerSaturation& saturation) const
+    {
+        return input_upper == saturation.input_upper && input_lower == saturation.input_lower
+                && output_upper == saturation.output_upper
+                && output_lower == saturation.output_lower;
+    }
+
+    /**
+     *  @param  saturation Controller saturation struct.
+     *  @return Whether any entry differs from that of the given struct.
+     *  @brief  Controller saturation inequality operator.
+     */
+    inline bool
+    operator!=(const ControllerSaturation& saturation) const
+    {
+        return !(*this == saturation);
+    }
+
     /**
      *  @tparam Archive Type of archive.
      *  @tparam Self Type of this struct.
@@ -205,6 +437,8 @@ struct EncoderData
     double steps;   //!< Overall encoder steps.
     double steps_left;  //!< Left encoder steps.
     double steps_right; //!< Right encoder steps.
+    unsigned long long transition_errors_left; //!< Left encoder illegal transitions.
+    unsigned long long transition_errors_right;    //!< Right encoder illegal transitions.
     double velocity_x;   //!< X velocity, in meters per second.
 
     /**
@@ -212,7 +446,8 @@ struct EncoderData
      *
      *  This constructor initializes all encoder data struct entries to 0.
      */
-    EncoderData() : position_x(0), steps(0), steps_left(0), steps_right(0), velocity_x(0)
+    EncoderData() : position_x(0), steps(0), steps_left(0), steps_right(0),
+            transition_errors_left(0), transition_errors_right(0), velocity_x(0)
     {
     }
 
@@ -231,7 +466,7 @@ struct EncoderData
     serialize(Archive& archive, Self& self)
     {
         return archive(self.position_x, self.steps, self.steps_left, self.steps_right,
-                self.velocity_x);
+                self.transition_errors_left, self.transition_errors_right, self.velocity_x);
     }
 };
 
@@ -267,6 +502,9 @@ struct IMUData
     double angular_velocity_x;   //!< X angular velocity, or roll rate, in radians per second.
     double angular_velocity_y;   //!< Y angular velocity, or pitch rate, in radians per second.
     double angular_velocity_z;   //!< Z angular velocity, or yaw rate, in radians per second.
+    double angular_velocity_bias_x;  //!< X gyroscope bias, in radians per second.
+    double angular_velocity_bias_y;  //!< Y gyroscope bias, in radians per second.
+    double angular_velocity_bias_z;  //!< Z gyroscope bias, in radians per second.
     double compass_x;   //!< X compass field strength, in micro Tesla.
     double compass_y;   ///!< Y compass field strength, In micro Tesla.
     double compass_z;   //!< Z compass field strength, In micro Tesla.
@@ -279,7 +517,8 @@ struct IMUData
      */
     IMUData() : acceleration_x(0), acceleration_y(0), acceleration_z(0), attitude_x(0),
             attitude_y(0), attitude_z(0), angular_velocity_x(0), angular_velocity_y(0),
-            angular_velocity_z(0), compass_x(0), compass_y(0), compass_z(0), temperature(0)
+            angular_velocity_z(0), angular_velocity_bias_x(0), angular_velocity_bias_y(0),
+            angular_velocity_bias_z(0), compass_x(0), compass_y(0), compass_z(0), temperature(0)
     {
     }
 
@@ -299,8 +538,9 @@ struct IMUData
     {
         return archive(self.acceleration_x, self.acceleration_y, self.acceleration_z,
                 self.attitude_x, self.attitude_y, self.attitude_z, self.angular_velocity_x,
-                self.angular_velocity_y, self.angular_velocity_z, self.compass_x, self.compass_y,
-                self.compass_z, self.temperature);
+                self.angular_velocity_y, self.angular_velocity_z, self.angular_velocity_bias_x,
+                self.angular_velocity_bias_y, self.angular_velocity_bias_z, self.compass_x,
+                self.compass_y, self.compass_z, self.temperature);
     }
 };
 
@@ -381,6 +621,87 @@ struct Maneuver
     }
 };
 
+/**
+ *  @brief  Message type enum class.
+ *
+ *  This enum class defines the types of the messages exchanged
+ *  between the Biped firmware and the Biped ground station over
+ *  the Biped message UDP. Every message begins with a message
+ *  header, and its type is serialized as the first byte.
+ */
+enum class MessageType : uint8_t
+{
+    biped_message = 0,  //!< Biped message, from the Biped ground station.
+    telemetry_frame,    //!< Telemetry frame.
+    status_message, //!< Status message.
+    parameter_message,  //!< Parameter message.
+    subscription_message,   //!< Subscription message, from the Biped ground station.
+    command_message,    //!< Command message, from the Biped ground station.
+    camera_chunk,   //!< Camera frame chunk, over the camera UDP.
+    camera_feedback_message //!< Camera feedback message, from the Biped ground station.
+};
+
+/**
+ *  @brief  Message header struct.
+ *
+ *  This struct contains the message type and the schema
+ *  version, which is incremented whenever the serialization
+ *  of any message changes, such that the Biped firmware and
+ *  the Biped ground station reject each other's messages if
+ *  their schemas differ.
+ */
+struct MessageHeader
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    static constexpr uint8_t version_current = 6;  //!< Current schema version.
+
+    MessageType type;   //!< Message type.
+    uint8_t version;    //!< Schema version.
+
+    /**
+     *  @param  type Message type.
+     *  @brief  Message header struct constructor
+     *
+     *  This constructor initializes all message header struct
+     *  entries, with the current schema version.
+     */
+    MessageHeader(const MessageType& type = MessageType::biped_message) : type(type),
+            version(version_current)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Message header serialization function.
+     *
+     *  This function performs serialization of all entries in this
+     *  struct. Deserialization fails if the schema version differs
+     *  from the current schema version.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        auto result = archive(self.type, self.version);
+
+        if (result && self.version != version_current)
+        {
+            return decltype(result)(zpp::serializer::error::out_of_range);
+        }
+
+        return result;
+    }
+};
+
 /**
  *  @brief  PID controller gain struct.
  *
@@ -412,6 +733,29 @@ struct PIDControllerGain
     {
     }
 
+    /**
+     *  @param  gain PID controller gain struct.
+     *  @return Whether all entries equal those of the given struct.
+     *  @brief  PID controller gain equality operator.
+     */
+    inline bool
+    operator==(const PIDControllerGain& gain) const
+    {
+        return differential == gain.differential && integral == gain.integral
+                && integral_max == gain.integral_max && proportional == gain.proportional;
+    }
+
+    /**
+     *  @param  gain PID controller gain struct.
+     *  @return Whether any entry differs from that of the given struct.
+     *  @brief  PID controller gain inequality operator.
+     */
+    inline bool
+    operator!=(const PIDControllerGain& gain) const
+    {
+        return !(*this == gain);
+    }
+
     /**
      *  @tparam Archive Type of archive.
      *  @tparam Self Type of this struct.
@@ -430,6 +774,56 @@ struct PIDControllerGain
     }
 };
 
+/**
+ *  @brief  State-feedback gain struct.
+ *
+ *  This struct contains the rows of the state-feedback
+ *  gain matrix (K), mapping the state errors, i.e., the
+ *  X position, X velocity, Y attitude (pitch), Y angular
+ *  velocity, Z attitude (yaw), and Z angular velocity minus
+ *  their references, to the forward and turning motor
+ *  outputs (u = -K x), in that order. The Z attitude error
+ *  is relative to the Z attitude when the controller became
+ *  active or the Z attitude reference last changed.
+ */
+struct StateFeedbackGain
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    std::array<double, 6> forward;  //!< Forward output gain row, added to both motors.
+    std::array<double, 6> turning;  //!< Turning output gain row, added to the left and subtracted from the right motor.
+
+    /**
+     *  @brief  State-feedback gain struct constructor.
+     *
+     *  This constructor initializes all state-feedback gain entries to 0.
+     */
+    StateFeedbackGain() : forward { }, turning { }
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  State-feedback gain serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.forward, self.turning);
+    }
+};
+
 /**
  *  @brief  Controller parameter struct.
  *
@@ -446,6 +840,7 @@ struct ControllerParameter
 
     double attitude_y_active; //!< Maximum Y attitude (pitch) for the controller to remain active, in degrees.
     double attitude_z_gain_open_loop;    //!< Z attitude open-loop controller gain.
+    ControllerMode mode;    //!< Controller mode.
     ControllerSaturation open_loop_controller_saturation_attitude_z; //!< Z attitude (yaw) open-loop controller saturation struct.
     PIDControllerGain pid_controller_gain_attitude_y; //!< Y attitude (pitch) PID controller gain struct.
     PIDControllerGain pid_controller_gain_attitude_z; //!< Z attitude (yaw) PID controller gain struct.
@@ -453,13 +848,15 @@ struct ControllerParameter
     ControllerSaturation pid_controller_saturation_attitude_y; //!< Y attitude (pitch) PID controller saturation struct.
     ControllerSaturation pid_controller_saturation_attitude_z; //!< Z attitude (yaw) PID controller saturation struct.
     ControllerSaturation pid_controller_saturation_position_x; //!< X position (forward/backward) PID controller saturation struct.
+    StateFeedbackGain state_feedback_gain;  //!< State-feedback controller gain struct.
 
     /**
      *  @brief  Controller parameter struct constructor.
      *
      *  This constructor initializes controller parameter struct entries.
      */
-    ControllerParameter() : attitude_y_active(20), attitude_z_gain_open_loop(0)
+    ControllerParameter() : attitude_y_active(20), attitude_z_gain_open_loop(0),
+            mode(ControllerMode::pid)
     {
     }
 
@@ -477,12 +874,12 @@ struct ControllerParameter
     inline static auto
     serialize(Archive& archive, Self& self)
     {
-        return archive(self.attitude_y_active, self.attitude_z_gain_open_loop,
+        return archive(self.attitude_y_active, self.attitude_z_gain_open_loop, self.mode,
                 self.open_loop_controller_saturation_attitude_z,
                 self.pid_controller_gain_attitude_y, self.pid_controller_gain_attitude_z,
                 self.pid_controller_gain_position_x, self.pid_controller_saturation_attitude_y,
                 self.pid_controller_saturation_attitude_z,
-                self.pid_controller_saturation_position_x);
+                self.pid_controller_saturation_position_x, self.state_feedback_gain);
     }
 };
 
@@ -543,39 +940,67 @@ struct TimeOfFlightData
 };
 
 /**
- *  @brief  Planner waypoint struct
+ *  @brief  Timing statistics struct.
  *
- *  This struct contains planner waypoint entries,
- *  such as controller reference, waypoint duration,
- *  and the shared pointer to the next waypoint. The
- *  waypoints can be chained up in a linked list fashion.
+ *  This struct contains timing statistics entries, such as
+ *  the sample count, minimum, maximum, mean, and percentiles
+ *  of a timing histogram over a statistics window.
  */
-struct Waypoint
+struct TimingStatistics
 {
-    ControllerReference controller_reference; //!< Controller reference.
-    double duration; //!< Transition to the next waypoint after this time duration, in seconds.
-    std::shared_ptr<Waypoint> next; //!< Shared pointer to the next waypoint.
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    uint32_t count; //!< Sample count.
+    float maximum;  //!< Maximum, in microseconds.
+    float mean; //!< Mean, in microseconds.
+    float minimum;  //!< Minimum, in microseconds.
+    float percentile_50;    //!< 50th percentile (median), in microseconds.
+    float percentile_90;    //!< 90th percentile, in microseconds.
+    float percentile_99;    //!< 99th percentile, in microseconds.
 
     /**
-     *  @brief  Planner waypoint struct constructor
+     *  @brief  Timing statistics struct constructor
      *
-     *  This constructor initializes all planner waypoint struct entries.
+     *  This constructor initializes all timing statistics struct entries.
      */
-    Waypoint() : controller_reference(), duration(0), next(nullptr)
+    TimingStatistics() : count(0), maximum(0), mean(0), minimum(0), percentile_50(0),
+            percentile_90(0), percentile_99(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Timing statistics serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
     {
+        return archive(self.count, self.maximum, self.mean, self.minimum, self.percentile_50,
+                self.percentile_90, self.percentile_99);
     }
 };
 
 /**
- *  @brief  Biped message struct.
+ *  @brief  Camera telemetry struct.
  *
- *  This struct contains various entries,
- *  such as the actuation command struct, controller structs,
- *  sensor data structs, and etc. This struct is typically used
- *  as a data communication protocol between the Biped firmware
- *  and the Biped ground station.
+ *  This struct contains the camera pipeline statistics, i.e., the
+ *  number of transmitted and dropped camera frames, and the timing
+ *  statistics of each stage and of the latency from capture to
+ *  transmission, along with the camera setting and the bandwidth
+ *  budget of the camera rate controller.
  */
-struct BipedMessage
+struct CameraTelemetry
 {
     /*
      *  This struct is a friend of the zpp serializer
@@ -583,21 +1008,21 @@ struct BipedMessage
      */
     friend zpp::serializer::access;
 
-    ActuationCommand actuation_command;    //!< Actuation command struct.
-    ControllerParameter controller_parameter;  //!< Controller parameter struct.
-    ControllerReference controller_reference;  //!< Controller reference struct.
-    EncoderData encoder_data;  //!< Encoder data struct.
-    IMUData imu_data;   //!< IMU data struct.
-    unsigned long long sequence;   //!< Message sequence number.
-    unsigned long long timestamp;   //!< Message timestamp, in microseconds.
-    TimeOfFlightData time_of_flight_data; //!< Time-of-flight data struct.
+    uint32_t budget;    //!< Camera bandwidth budget of the camera rate controller, in bytes per second.
+    TimingStatistics execution_time_capture;    //!< Capture stage execution time statistics.
+    TimingStatistics execution_time_encode; //!< Encode stage execution time statistics.
+    TimingStatistics execution_time_transmit;   //!< Transmit stage execution time statistics.
+    uint32_t frame_count;   //!< Transmitted camera frame count.
+    uint32_t frame_count_dropped;   //!< Dropped camera frame count.
+    TimingStatistics latency;   //!< Capture to transmission latency statistics.
+    CameraSetting setting;  //!< Camera setting struct.
 
     /**
-     *  @brief  Biped message constructor
+     *  @brief  Camera telemetry struct constructor
      *
-     *  This constructor initializes all Biped message struct entries.
+     *  This constructor initializes all camera telemetry struct entries.
      */
-    BipedMessage() : sequence(0), timestamp(0)
+    CameraTelemetry() : budget(0), frame_count(0), frame_count_dropped(0)
     {
     }
 
@@ -607,7 +1032,7 @@ struct BipedMessage
      *  @param  archive Serialization archive.
      *  @param  self This struct.
      *  @return Serialization archive.
-     *  @brief  Biped message serialization function.
+     *  @brief  Camera telemetry serialization function.
      *
      *  This function performs serialization of all entries in this struct.
      */
@@ -615,9 +1040,1389 @@ struct BipedMessage
     inline static auto
     serialize(Archive& archive, Self& self)
     {
-        return archive(self.actuation_command, self.controller_parameter, self.controller_reference,
-                self.encoder_data, self.imu_data, self.sequence, self.timestamp,
-                self.time_of_flight_data);
+        return archive(self.execution_time_capture, self.execution_time_encode,
+                self.execution_time_transmit, self.frame_count, self.frame_count_dropped,
+                self.latency, self.setting, self.budget);
+    }
+};
+
+/**
+ *  @brief  Telemetry struct.
+ *
+ *  This struct contains real-time task telemetry entries,
+ *  such as the timing statistics of the real-time task
+ *  interval, execution time, and per-stage execution times,
+ *  the real-time task deadline miss count, and the camera
+ *  telemetry, such that the interference of the camera pipeline
+ *  with the real-time task can be told from the same message.
+ */
+struct Telemetry
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    CameraTelemetry camera; //!< Camera telemetry struct.
+    uint32_t deadline_miss; //!< Real-time task deadline miss count.
+    TimingStatistics execution_time;    //!< Real-time task execution time statistics.
+    TimingStatistics execution_time_actuate;    //!< Actuation execution time statistics.
+    TimingStatistics execution_time_control;    //!< Control execution time statistics.
+    TimingStatistics execution_time_sense_fast; //!< Fast domain sensing execution time statistics.
+    TimingStatistics execution_time_sense_slow; //!< Slow domain sensing execution time statistics.
+    TimingStatistics interval;  //!< Real-time task interval statistics.
+
+    /**
+     *  @brief  Telemetry struct constructor
+     *
+     *  This constructor initializes all telemetry struct entries.
+     */
+    Telemetry() : deadline_miss(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Telemetry serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.deadline_miss, self.execution_time, self.execution_time_actuate,
+                self.execution_time_control, self.execution_time_sense_fast,
+                self.execution_time_sense_slow, self.interval, self.camera);
+    }
+};
+
+/**
+ *  @brief  Telemetry field enum class.
+ *
+ *  This enum class defines the entries of the telemetry
+ *  sample struct that telemetry frames may carry, in their
+ *  serialization order, indexing the telemetry field table.
+ */
+enum class TelemetryField : uint8_t
+{
+    acceleration_x = 0, //!< Quantized X acceleration.
+    acceleration_y, //!< Quantized Y acceleration.
+    acceleration_z, //!< Quantized Z acceleration.
+    actuation_flags,    //!< Motor enable and direction flags.
+    angular_velocity_x, //!< Quantized X angular velocity.
+    angular_velocity_y, //!< Quantized Y angular velocity.
+    angular_velocity_z, //!< Quantized Z angular velocity.
+    attitude_x, //!< Quantized X attitude.
+    attitude_y, //!< Quantized Y attitude.
+    attitude_z, //!< Z attitude.
+    motor_left_pwm, //!< Quantized left motor PWM.
+    motor_right_pwm,    //!< Quantized right motor PWM.
+    position_x, //!< X position.
+    range_left, //!< Quantized left time-of-flight range.
+    range_middle,   //!< Quantized middle time-of-flight range.
+    range_right,    //!< Quantized right time-of-flight range.
+    reference_attitude_y,   //!< Y attitude controller reference.
+    reference_attitude_z,   //!< Z attitude controller reference.
+    reference_position_x,   //!< X position controller reference.
+    steps_left, //!< Left encoder steps.
+    steps_right,    //!< Right encoder steps.
+    timestamp,  //!< Sample timestamp.
+    velocity_x, //!< Quantized X velocity.
+    count   //!< Number of telemetry fields.
+};
+
+/**
+ *  @brief  Telemetry field type enum class.
+ *
+ *  This enum class defines the wire types of the telemetry fields.
+ */
+enum class TelemetryFieldType : uint8_t
+{
+    float32 = 0,    //!< Single precision floating-point value.
+    int16,  //!< Signed 16-bit integer, possibly quantized.
+    int32,  //!< Signed 32-bit integer.
+    uint8,  //!< Unsigned 8-bit integer.
+    uint32  //!< Unsigned 32-bit integer.
+};
+
+/**
+ *  @brief  Telemetry sample struct.
+ *
+ *  This struct contains the entries sampled by the real-time
+ *  task at the end of every fast domain tick, such as the sensor
+ *  data, the controller reference, and the actuation command,
+ *  as well as the index of the tick, in the compact wire schema.
+ *
+ *  The entries with a bounded range are quantized into scaled
+ *  16-bit integers of the given resolutions, and saturated at the
+ *  ends of their ranges, e.g., the X and Y attitudes. The unbounded
+ *  entries, e.g., the Z attitude and the X position, are stored as
+ *  single precision floating-point values. The encoder steps and
+ *  the direction and enable flags are stored exactly. The entries
+ *  that are constant or change slowly, e.g., the compass field, the
+ *  gyroscope biases, and the encoder illegal transitions, are not
+ *  sampled, and are sent in the status message instead.
+ *
+ *  Every entry except for the tick index is a telemetry field,
+ *  described by the telemetry field table, such that telemetry
+ *  frames may carry only the subscribed fields.
+ */
+struct TelemetrySample
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    static constexpr double resolution_acceleration = 0.002;    //!< Acceleration resolution, in meters per second squared.
+    static constexpr double resolution_angular_velocity = 0.001;    //!< Angular velocity resolution, in radians per second.
+    static constexpr double resolution_attitude = 0.0001;  //!< X and Y attitude resolution, in radians.
+    static constexpr double resolution_pwm = 0.01;  //!< Motor PWM resolution.
+    static constexpr double resolution_range = 0.001;   //!< Time-of-flight range resolution, in meters.
+    static constexpr double resolution_velocity = 0.001;    //!< X velocity resolution, in meters per second.
+
+    static constexpr uint8_t flag_motor_enable = 1 << 0;   //!< Motor enable flag.
+    static constexpr uint8_t flag_motor_left_forward = 1 << 1; //!< Left motor direction flag.
+    static constexpr uint8_t flag_motor_right_forward = 1 << 2;    //!< Right motor direction flag.
+
+    int16_t acceleration_x; //!< Quantized X acceleration.
+    int16_t acceleration_y; //!< Quantized Y acceleration.
+    int16_t acceleration_z; //!< Quantized Z acceleration.
+    uint8_t actuation_flags;    //!< Motor enable and direction flags.
+    int16_t angular_velocity_x; //!< Quantized X angular velocity.
+    int16_t angular_velocity_y; //!< Quantized Y angular velocity.
+    int16_t angular_velocity_z; //!< Quantized Z angular velocity.
+    int16_t attitude_x; //!< Quantized X attitude.
+    int16_t attitude_y; //!< Quantized Y attitude.
+    float attitude_z;   //!< Z attitude, in radians.
+    int16_t motor_left_pwm; //!< Quantized left motor PWM.
+    int16_t motor_right_pwm;    //!< Quantized right motor PWM.
+    float position_x;   //!< X position, in meters.
+    int16_t range_left; //!< Quantized left time-of-flight range.
+    int16_t range_middle;   //!< Quantized middle time-of-flight range.
+    int16_t range_right;    //!< Quantized right time-of-flight range.
+    float reference_attitude_y; //!< Y attitude controller reference, in radians.
+    float reference_attitude_z; //!< Z attitude controller reference, in radians.
+    float reference_position_x; //!< X position controller reference, in meters.
+    int32_t steps_left; //!< Left encoder steps.
+    int32_t steps_right;    //!< Right encoder steps.
+    uint32_t tick;  //!< Real-time task tick index.
+    uint32_t timestamp; //!< Sample timestamp, in microseconds, wrapping around.
+    int16_t velocity_x; //!< Quantized X velocity.
+
+    /**
+     *  @brief  Telemetry sample struct constructor
+     *
+     *  This constructor initializes all telemetry sample struct entries to 0.
+     */
+    TelemetrySample() : acceleration_x(0), acceleration_y(0), acceleration_z(0),
+            actuation_flags(0), angular_velocity_x(0), angular_velocity_y(0),
+            angular_velocity_z(0), attitude_x(0), attitude_y(0), attitude_z(0),
+            motor_left_pwm(0), motor_right_pwm(0), position_x(0), range_left(0),
+            range_middle(0), range_right(0), reference_attitude_y(0), reference_attitude_z(0),
+            reference_position_x(0), steps_left(0), steps_right(0), tick(0), timestamp(0),
+            velocity_x(0)
+    {
+    }
+
+    /**
+     *  @param  value Value.
+     *  @param  resolution Resolution.
+     *  @return Quantized value.
+     *  @brief  Quantize a value into a scaled 16-bit integer.
+     *
+     *  This function rounds the given value to the nearest multiple
+     *  of the given resolution, saturated at the range of the 16-bit
+     *  integer. A value that is not a number is quantized to 0.
+     */
+    inline static int16_t
+    quantize(const double& value, const double& resolution)
+    {
+        const double steps = std::round(value / resolution);
+
+        if (std::isnan(steps))
+        {
+            return 0;
+        }
+
+        if (steps >= std::numeric_limits<int16_t>::max())
+        {
+            return std::numeric_limits<int16_t>::max();
+        }
+
+        if (steps <= std::numeric_limits<int16_t>::min())
+        {
+            return std::numeric_limits<int16_t>::min();
+        }
+
+        return static_cast<int16_t>(steps);
+    }
+
+    /**
+     *  @param  value Quantized value.
+     *  @param  resolution Resolution.
+     *  @return Value.
+     *  @brief  Dequantize a scaled 16-bit integer.
+     */
+    inline static double
+    dequantize(const int16_t& value, const double& resolution)
+    {
+        return value * resolution;
+    }
+
+    /**
+     *  @return Actuation command struct.
+     *  @brief  Get the actuation command struct.
+     */
+    inline ActuationCommand
+    getActuationCommand() const
+    {
+        ActuationCommand actuation_command;
+
+        actuation_command.motor_enable = actuation_flags & flag_motor_enable;
+        actuation_command.motor_left_forward = actuation_flags & flag_motor_left_forward;
+        actuation_command.motor_right_forward = actuation_flags & flag_motor_right_forward;
+        actuation_command.motor_left_pwm = dequantize(motor_left_pwm, resolution_pwm);
+        actuation_command.motor_right_pwm = dequantize(motor_right_pwm, resolution_pwm);
+
+        return actuation_command;
+    }
+
+    /**
+     *  @return Controller reference struct.
+     *  @brief  Get the controller reference struct.
+     */
+    inline ControllerReference
+    getControllerReference() const
+    {
+        ControllerReference controller_reference;
+
+        controller_reference.attitude_y = reference_attitude_y;
+        controller_reference.attitude_z = reference_attitude_z;
+        controller_reference.position_x = reference_position_x;
+
+        return controller_reference;
+    }
+
+    /**
+     *  @return Encoder data struct, without the illegal transitions.
+     *  @brief  Get the encoder data struct.
+     *
+     *  This function restores the overall encoder steps as the
+     *  truncated average of the left and right encoder steps,
+     *  the same way as the encoder computes them.
+     */
+    inline EncoderData
+    getEncoderData() const
+    {
+        EncoderData encoder_data;
+
+        encoder_data.position_x = position_x;
+        encoder_data.steps = (static_cast<long long>(steps_left) + steps_right) / 2;
+        encoder_data.steps_left = steps_left;
+        encoder_data.steps_right = steps_right;
+        encoder_data.velocity_x = dequantize(velocity_x, resolution_velocity);
+
+        return encoder_data;
+    }
+
+    /**
+     *  @param  field Telemetry field.
+     *  @return Value of the telemetry field, dequantized.
+     *  @brief  Get the value of a telemetry field.
+     *
+     *  This function reads the given telemetry field using the
+     *  telemetry field table, and dequantizes it if quantized.
+     */
+    inline double
+    getField(const TelemetryField& field) const;
+
+    /**
+     *  @return IMU data struct, without the gyroscope biases, the
+     *          compass field, and the temperature.
+     *  @brief  Get the IMU data struct.
+     */
+    inline IMUData
+    getIMUData() const
+    {
+        IMUData imu_data;
+
+        imu_data.acceleration_x = dequantize(acceleration_x, resolution_acceleration);
+        imu_data.acceleration_y = dequantize(acceleration_y, resolution_acceleration);
+        imu_data.acceleration_z = dequantize(acceleration_z, resolution_acceleration);
+        imu_data.angular_velocity_x = dequantize(angular_velocity_x, resolution_angular_velocity);
+        imu_data.angular_velocity_y = dequantize(angular_velocity_y, resolution_angular_velocity);
+        imu_data.angular_velocity_z = dequantize(angular_velocity_z, resolution_angular_velocity);
+        imu_data.attitude_x = dequantize(attitude_x, resolution_attitude);
+        imu_data.attitude_y = dequantize(attitude_y, resolution_attitude);
+        imu_data.attitude_z = attitude_z;
+
+        return imu_data;
+    }
+
+    /**
+     *  @return Time-of-flight data struct.
+     *  @brief  Get the time-of-flight data struct.
+     */
+    inline TimeOfFlightData
+    getTimeOfFlightData() const
+    {
+        TimeOfFlightData time_of_flight_data;
+
+        time_of_flight_data.range_left = dequantize(range_left, resolution_range);
+        time_of_flight_data.range_middle = dequantize(range_middle, resolution_range);
+        time_of_flight_data.range_right = dequantize(range_right, resolution_range);
+
+        return time_of_flight_data;
+    }
+
+    /**
+     *  @param  actuation_command Actuation command struct.
+     *  @brief  Set the actuation command entries.
+     */
+    inline void
+    setActuationCommand(const ActuationCommand& actuation_command)
+    {
+        actuation_flags = (actuation_command.motor_enable ? flag_motor_enable : 0)
+                | (actuation_command.motor_left_forward ? flag_motor_left_forward : 0)
+                | (actuation_command.motor_right_forward ? flag_motor_right_forward : 0);
+        motor_left_pwm = quantize(actuation_command.motor_left_pwm, resolution_pwm);
+        motor_right_pwm = quantize(actuation_command.motor_right_pwm, resolution_pwm);
+    }
+
+    /**
+     *  @param  controller_reference Controller reference struct.
+     *  @brief  Set the controller reference entries.
+     */
+    inline void
+    setControllerReference(const ControllerReference& controller_reference)
+    {
+        reference_attitude_y = static_cast<float>(controller_reference.attitude_y);
+        reference_attitude_z = static_cast<float>(controller_reference.attitude_z);
+        reference_position_x = static_cast<float>(controller_reference.position_x);
+    }
+
+    /**
+     *  @param  encoder_data Encoder data struct.
+     *  @brief  Set the encoder data entries.
+     */
+    inline void
+    setEncoderData(const EncoderData& encoder_data)
+    {
+        position_x = static_cast<float>(encoder_data.position_x);
+        steps_left = static_cast<int32_t>(encoder_data.steps_left);
+        steps_right = static_cast<int32_t>(encoder_data.steps_right);
+        velocity_x = quantize(encoder_data.velocity_x, resolution_velocity);
+    }
+
+    /**
+     *  @param  imu_data IMU data struct.
+     *  @brief  Set the IMU data entries.
+     */
+    inline void
+    setIMUData(const IMUData& imu_data)
+    {
+        acceleration_x = quantize(imu_data.acceleration_x, resolution_acceleration);
+        acceleration_y = quantize(imu_data.acceleration_y, resolution_acceleration);
+        acceleration_z = quantize(imu_data.acceleration_z, resolution_acceleration);
+        angular_velocity_x = quantize(imu_data.angular_velocity_x, resolution_angular_velocity);
+        angular_velocity_y = quantize(imu_data.angular_velocity_y, resolution_angular_velocity);
+        angular_velocity_z = quantize(imu_data.angular_velocity_z, resolution_angular_velocity);
+        attitude_x = quantize(imu_data.attitude_x, resolution_attitude);
+        attitude_y = quantize(imu_data.attitude_y, resolution_attitude);
+        attitude_z = static_cast<float>(imu_data.attitude_z);
+    }
+
+    /**
+     *  @param  time_of_flight_data Time-of-flight data struct.
+     *  @brief  Set the time-of-flight data entries.
+     */
+    inline void
+    setTimeOfFlightData(const TimeOfFlightData& time_of_flight_data)
+    {
+        range_left = quantize(time_of_flight_data.range_left, resolution_range);
+        range_middle = quantize(time_of_flight_data.range_middle, resolution_range);
+        range_right = quantize(time_of_flight_data.range_right, resolution_range);
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Telemetry sample serialization function.
+     *
+     *  This function performs serialization of all entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.acceleration_x, self.acceleration_y, self.acceleration_z,
+                self.actuation_flags, self.angular_velocity_x, self.angular_velocity_y,
+                self.angular_velocity_z, self.attitude_x, self.attitude_y, self.attitude_z,
+                self.motor_left_pwm, self.motor_right_pwm, self.position_x, self.range_left,
+                self.range_middle, self.range_right, self.reference_attitude_y,
+                self.reference_attitude_z, self.reference_position_x, self.steps_left,
+                self.steps_right, self.tick, self.timestamp, self.velocity_x);
+    }
+};
+
+/**
+ *  @brief  Telemetry field table entry struct.
+ *
+ *  This struct describes how a telemetry field is stored
+ *  in the telemetry sample struct, i.e., its name, offset,
+ *  size, type, and quantization resolution.
+ */
+struct TelemetryFieldEntry
+{
+    const char* name;   //!< Field name.
+    size_t offset;  //!< Offset in the telemetry sample struct, in bytes.
+    size_t size;    //!< Size, in bytes.
+    TelemetryFieldType type;    //!< Field type.
+    double resolution;  //!< Quantization resolution, or 1 if not quantized.
+};
+
+/*
+ *  Telemetry field table, indexed by the telemetry field enum class
+ *  and precomputed at compile time, such that the telemetry frames
+ *  are built from the subscribed fields without any per-field logic.
+ */
+constexpr TelemetryFieldEntry telemetry_field_table[] = {
+        { "acceleration_x", offsetof(TelemetrySample, acceleration_x), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_acceleration },
+        { "acceleration_y", offsetof(TelemetrySample, acceleration_y), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_acceleration },
+        { "acceleration_z", offsetof(TelemetrySample, acceleration_z), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_acceleration },
+        { "actuation_flags", offsetof(TelemetrySample, actuation_flags), sizeof(uint8_t),
+                TelemetryFieldType::uint8, 1 },
+        { "angular_velocity_x", offsetof(TelemetrySample, angular_velocity_x), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_angular_velocity },
+        { "angular_velocity_y", offsetof(TelemetrySample, angular_velocity_y), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_angular_velocity },
+        { "angular_velocity_z", offsetof(TelemetrySample, angular_velocity_z), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_angular_velocity },
+        { "attitude_x", offsetof(TelemetrySample, attitude_x), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_attitude },
+        { "attitude_y", offsetof(TelemetrySample, attitude_y), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_attitude },
+        { "attitude_z", offsetof(TelemetrySample, attitude_z), sizeof(float),
+                TelemetryFieldType::float32, 1 },
+        { "motor_left_pwm", offsetof(TelemetrySample, motor_left_pwm), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_pwm },
+        { "motor_right_pwm", offsetof(TelemetrySample, motor_right_pwm), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_pwm },
+        { "position_x", offsetof(TelemetrySample, position_x), sizeof(float),
+                TelemetryFieldType::float32, 1 },
+        { "range_left", offsetof(TelemetrySample, range_left), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_range },
+        { "range_middle", offsetof(TelemetrySample, range_middle), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_range },
+        { "range_right", offsetof(TelemetrySample, range_right), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_range },
+        { "reference_attitude_y", offsetof(TelemetrySample, reference_attitude_y), sizeof(float),
+                TelemetryFieldType::float32, 1 },
+        { "reference_attitude_z", offsetof(TelemetrySample, reference_attitude_z), sizeof(float),
+                TelemetryFieldType::float32, 1 },
+        { "reference_position_x", offsetof(TelemetrySample, reference_position_x), sizeof(float),
+                TelemetryFieldType::float32, 1 },
+        { "steps_left", offsetof(TelemetrySample, steps_left), sizeof(int32_t),
+                TelemetryFieldType::int32, 1 },
+        { "steps_right", offsetof(TelemetrySample, steps_right), sizeof(int32_t),
+                TelemetryFieldType::int32, 1 },
+        { "timestamp", offsetof(TelemetrySample, timestamp), sizeof(uint32_t),
+                TelemetryFieldType::uint32, 1 },
+        { "velocity_x", offsetof(TelemetrySample, velocity_x), sizeof(int16_t),
+                TelemetryFieldType::int16, TelemetrySample::resolution_velocity } };
+
+static_assert(sizeof(telemetry_field_table) / sizeof(telemetry_field_table[0])
+        == static_cast<size_t>(TelemetryField::count),
+        "Telemetry field table must describe every telemetry field.");
+
+inline double
+TelemetrySample::getField(const TelemetryField& field) const
+{
+    const TelemetryFieldEntry& entry = telemetry_field_table[static_cast<size_t>(field)];
+    const unsigned char* pointer = reinterpret_cast<const unsigned char*>(this) + entry.offset;
+
+    /*
+     *  Copy the field byte-wise, since the offset is not
+     *  known to the compiler.
+     */
+    switch (entry.type)
+    {
+        case TelemetryFieldType::float32:
+        {
+            float value;
+            std::memcpy(&value, pointer, sizeof(value));
+            return value;
+        }
+        case TelemetryFieldType::int16:
+        {
+            int16_t value;
+            std::memcpy(&value, pointer, sizeof(value));
+            return dequantize(value, entry.resolution);
+        }
+        case TelemetryFieldType::int32:
+        {
+            int32_t value;
+            std::memcpy(&value, pointer, sizeof(value));
+            return value;
+        }
+        case TelemetryFieldType::uint8:
+        {
+            return *pointer;
+        }
+        case TelemetryFieldType::uint32:
+        {
+            uint32_t value;
+            std::memcpy(&value, pointer, sizeof(value));
+            return value;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ *  @brief  Telemetry subscription struct.
+ *
+ *  This struct contains the set of telemetry fields that the
+ *  telemetry frames carry, as a bit mask indexed by the telemetry
+ *  field enum class, and a rate divisor per field, such that a
+ *  subscribed field is only carried by the samples whose tick index
+ *  is a multiple of its divisor. By default, all fields are carried
+ *  by every sample.
+ */
+struct TelemetrySubscription
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    static constexpr size_t field_count = static_cast<size_t>(TelemetryField::count);  //!< Number of telemetry fields.
+    static constexpr uint32_t field_mask_all = (1ul << field_count) - 1;   //!< Mask of all telemetry fields.
+
+    static_assert(field_count <= 32, "Telemetry field mask must fit 32 bits.");
+
+    std::array<uint8_t, field_count> divisors; //!< Rate divisors, in ticks.
+    uint32_t field_mask;    //!< Subscribed field mask.
+
+    /**
+     *  @brief  Telemetry subscription struct constructor
+     *
+     *  This constructor initializes all telemetry subscription
+     *  struct entries, with all fields subscribed at every tick.
+     */
+    TelemetrySubscription() : field_mask(field_mask_all)
+    {
+        divisors.fill(1);
+    }
+
+    /**
+     *  @param  field Telemetry field.
+     *  @param  divisor Rate divisor, in ticks.
+     *  @brief  Subscribe to a telemetry field.
+     */
+    inline void
+    subscribe(const TelemetryField& field, const uint8_t& divisor = 1)
+    {
+        field_mask |= 1ul << static_cast<size_t>(field);
+        divisors[static_cast<size_t>(field)] = divisor;
+    }
+
+    /**
+     *  @param  field Telemetry field.
+     *  @param  tick Tick index of the sample.
+     *  @return Whether the sample carries the telemetry field.
+     *  @brief  Get whether a sample carries a telemetry field.
+     */
+    inline bool
+    includes(const size_t& field, const uint32_t& tick) const
+    {
+        return (field_mask >> field & 1) && tick % divisors[field] == 0;
+    }
+
+    /**
+     *  @return Whether all subscribed fields exist and have a non-zero divisor.
+     *  @brief  Validate the telemetry subscription.
+     */
+    inline bool
+    isValid() const
+    {
+        if (field_mask & ~field_mask_all)
+        {
+            return false;
+        }
+
+        for (size_t field = 0; field < field_count; field ++)
+        {
+            if ((field_mask >> field & 1) && divisors[field] == 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Telemetry subscription serialization function.
+     *
+     *  This function performs serialization of the field mask,
+     *  followed by the divisors of the subscribed fields only.
+     *  Deserialization fails if the telemetry subscription is
+     *  invalid.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        auto result = archive(self.field_mask);
+
+        for (size_t field = 0; result && field < field_count; field ++)
+        {
+            if (self.field_mask >> field & 1)
+            {
+                result = archive(self.divisors[field]);
+            }
+        }
+
+        if (result && !self.isValid())
+        {
+            return decltype(result)(zpp::serializer::error::out_of_range);
+        }
+
+        return result;
+    }
+};
+
+/**
+ *  @brief  Telemetry frame struct.
+ *
+ *  This struct contains a batch of consecutive telemetry
+ *  samples, such that every real-time task tick reaches the
+ *  Biped ground station exactly once, in a single datagram
+ *  per batch. The capacity is chosen such that a full frame
+ *  fits in a single datagram. Only the valid samples are
+ *  serialized, each as its tick index followed by the fields
+ *  that the telemetry subscription of the frame includes at
+ *  that tick, copied byte-wise using the telemetry field table.
+ *  The fields that a sample does not carry are deserialized as 0.
+ */
+struct TelemetryFrame
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    static constexpr uint32_t capacity = 20;    //!< Maximum number of samples.
+
+    MessageHeader header;   //!< Message header struct.
+    uint32_t overflow;  //!< Number of samples dropped by the firmware so far.
+    uint32_t sample_count;  //!< Number of valid samples.
+    std::array<TelemetrySample, capacity> samples;  //!< Samples, in tick order.
+    unsigned long long sequence;   //!< Frame sequence number.
+    TelemetrySubscription subscription; //!< Telemetry subscription of the samples.
+
+    /**
+     *  @brief  Telemetry frame struct constructor
+     *
+     *  This constructor initializes all telemetry frame struct entries.
+     */
+    TelemetryFrame() : header(MessageType::telemetry_frame), overflow(0), sample_count(0),
+            sequence(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Telemetry frame serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct, and only the
+     *  fields of the valid samples that the telemetry subscription
+     *  includes. Deserialization fails if the number of valid samples
+     *  exceeds the capacity.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        using Byte = typename std::conditional<std::is_const<Self>::value, const unsigned char,
+                unsigned char>::type;
+
+        auto result = archive(self.header, self.overflow, self.sequence, self.subscription,
+                self.sample_count);
+
+        if (result && self.sample_count > capacity)
+        {
+            return decltype(result)(zpp::serializer::error::out_of_range);
+        }
+
+        for (uint32_t i = 0; result && i < self.sample_count; i ++)
+        {
+            auto& sample = self.samples[i];
+            Byte* pointer = reinterpret_cast<Byte*>(&sample);
+
+            result = archive(sample.tick);
+
+            for (size_t field = 0; result && field < TelemetrySubscription::field_count;
+                    field ++)
+            {
+                const TelemetryFieldEntry& entry = telemetry_field_table[field];
+
+                if (self.subscription.includes(field, sample.tick))
+                {
+                    result = archive(zpp::serializer::as_bytes(pointer + entry.offset,
+                            entry.size));
+                }
+                else if (!std::is_const<Self>::value)
+                {
+                    std::memset(const_cast<unsigned char*>(pointer + entry.offset), 0,
+                            entry.size);
+                }
+            }
+        }
+
+        return result;
+    }
+};
+
+/**
+ *  @brief  Planner waypoint struct
+ *
+ *  This struct contains planner waypoint entries,
+ *  such as controller reference, waypoint duration,
+ *  and the shared pointer to the next waypoint. The
+ *  waypoints can be chained up in a linked list fashion.
+ */
+struct Waypoint
+{
+    ControllerReference controller_reference; //!< Controller reference.
+    double duration; //!< Transition to the next waypoint after this time duration, in seconds.
+    std::shared_ptr<Waypoint> next; //!< Shared pointer to the next waypoint.
+
+    /**
+     *  @brief  Planner waypoint struct constructor
+     *
+     *  This constructor initializes all planner waypoint struct entries.
+     */
+    Waypoint() : controller_reference(), duration(0), next(nullptr)
+    {
+    }
+};
+
+/**
+ *  @brief  Biped message struct.
+ *
+ *  This struct contains various entries,
+ *  such as the actuation command struct, controller structs,
+ *  sensor data structs, and etc. This struct is typically used
+ *  as a data communication protocol between the Biped firmware
+ *  and the Biped ground station. The Biped ground station sends
+ *  it to the Biped firmware at full precision, and assembles it
+ *  from the compact status and parameter messages received from
+ *  the Biped firmware.
+ */
+struct BipedMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    ActuationCommand actuation_command;    //!< Actuation command struct.
+    ControllerParameter controller_parameter;  //!< Controller parameter struct.
+    ControllerReference controller_reference;  //!< Controller reference struct.
+    EncoderData encoder_data;  //!< Encoder data struct.
+    MessageHeader header;   //!< Message header struct.
+    IMUData imu_data;   //!< IMU data struct.
+    unsigned long long sequence;   //!< Message sequence number.
+    Telemetry telemetry;    //!< Telemetry struct.
+    unsigned long long timestamp;   //!< Message timestamp, in microseconds.
+    TimeOfFlightData time_of_flight_data; //!< Time-of-flight data struct.
+
+    /**
+     *  @brief  Biped message constructor
+     *
+     *  This constructor initializes all Biped message struct entries.
+     */
+    BipedMessage() : header(MessageType::biped_message), sequence(0), timestamp(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Biped message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.header, self.actuation_command, self.controller_parameter,
+                self.controller_reference, self.encoder_data, self.imu_data, self.sequence,
+                self.telemetry, self.timestamp, self.time_of_flight_data);
+    }
+};
+
+/**
+ *  @brief  Parameter message struct.
+ *
+ *  This struct contains the controller parameter struct, at
+ *  full precision, such that the Biped ground station can edit
+ *  and send it back unchanged. Since the controller parameters
+ *  rarely change, the Biped firmware sends this message at a low
+ *  rate, separate from the status message.
+ */
+struct ParameterMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    ControllerParameter controller_parameter;  //!< Controller parameter struct.
+    MessageHeader header;   //!< Message header struct.
+    unsigned long long sequence;   //!< Message sequence number.
+
+    /**
+     *  @brief  Parameter message constructor
+     *
+     *  This constructor initializes all parameter message struct entries.
+     */
+    ParameterMessage() : header(MessageType::parameter_message), sequence(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Parameter message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.header, self.controller_parameter, self.sequence);
+    }
+};
+
+/**
+ *  @brief  Status message struct.
+ *
+ *  This struct contains the latest telemetry sample, in the
+ *  compact wire schema, along with the slowly changing sensor
+ *  entries that the telemetry sample omits, the real-time task
+ *  telemetry struct, and the command acknowledgement struct. The
+ *  Biped firmware sends this message at a lower rate than the
+ *  telemetry frames.
+ */
+struct StatusMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    CommandAcknowledgement acknowledgement; //!< Command acknowledgement struct.
+    float angular_velocity_bias_x;  //!< X gyroscope bias, in radians per second.
+    float angular_velocity_bias_y;  //!< Y gyroscope bias, in radians per second.
+    float angular_velocity_bias_z;  //!< Z gyroscope bias, in radians per second.
+    MessageHeader header;   //!< Message header struct.
+    TelemetrySample sample; //!< Latest telemetry sample struct.
+    unsigned long long sequence;   //!< Message sequence number.
+    Telemetry telemetry;    //!< Telemetry struct.
+    float temperature;  //!< Temperature, in Celsius.
+    unsigned long long timestamp;   //!< Message timestamp, in microseconds.
+    uint32_t transition_errors_left;    //!< Left encoder illegal transitions.
+    uint32_t transition_errors_right;   //!< Right encoder illegal transitions.
+
+    /**
+     *  @brief  Status message constructor
+     *
+     *  This constructor initializes all status message struct entries.
+     */
+    StatusMessage() : angular_velocity_bias_x(0), angular_velocity_bias_y(0),
+            angular_velocity_bias_z(0), header(MessageType::status_message), sequence(0),
+            temperature(0), timestamp(0), transition_errors_left(0), transition_errors_right(0)
+    {
+    }
+
+    /**
+     *  @param  encoder_data Encoder data struct.
+     *  @param  imu_data IMU data struct.
+     *  @param  time_of_flight_data Time-of-flight data struct.
+     *  @brief  Set the sensor entries.
+     *
+     *  This function sets the sensor entries of the telemetry
+     *  sample struct, including the time-of-flight ranges, as well
+     *  as the slowly changing sensor entries. The compass field is
+     *  omitted.
+     */
+    inline void
+    setSensorData(const EncoderData& encoder_data, const IMUData& imu_data,
+            const TimeOfFlightData& time_of_flight_data)
+    {
+        sample.setEncoderData(encoder_data);
+        sample.setIMUData(imu_data);
+        sample.setTimeOfFlightData(time_of_flight_data);
+        angular_velocity_bias_x = static_cast<float>(imu_data.angular_velocity_bias_x);
+        angular_velocity_bias_y = static_cast<float>(imu_data.angular_velocity_bias_y);
+        angular_velocity_bias_z = static_cast<float>(imu_data.angular_velocity_bias_z);
+        temperature = static_cast<float>(imu_data.temperature);
+        transition_errors_left = static_cast<uint32_t>(encoder_data.transition_errors_left);
+        transition_errors_right = static_cast<uint32_t>(encoder_data.transition_errors_right);
+    }
+
+    /**
+     *  @param  controller_parameter Controller parameter struct.
+     *  @return Biped message struct.
+     *  @brief  Get the Biped message struct.
+     *
+     *  This function assembles a Biped message struct from the
+     *  entries of this struct and the given controller parameter
+     *  struct, e.g., from the latest parameter message.
+     */
+    inline BipedMessage
+    getBipedMessage(const ControllerParameter& controller_parameter) const
+    {
+        BipedMessage message;
+
+        message.actuation_command = sample.getActuationCommand();
+        message.controller_parameter = controller_parameter;
+        message.controller_reference = sample.getControllerReference();
+        message.encoder_data = sample.getEncoderData();
+        message.encoder_data.transition_errors_left = transition_errors_left;
+        message.encoder_data.transition_errors_right = transition_errors_right;
+        message.imu_data = sample.getIMUData();
+        message.imu_data.angular_velocity_bias_x = angular_velocity_bias_x;
+        message.imu_data.angular_velocity_bias_y = angular_velocity_bias_y;
+        message.imu_data.angular_velocity_bias_z = angular_velocity_bias_z;
+        message.imu_data.temperature = temperature;
+        message.sequence = sequence;
+        message.telemetry = telemetry;
+        message.timestamp = timestamp;
+        message.time_of_flight_data = sample.getTimeOfFlightData();
+
+        return message;
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Status message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.header, self.acknowledgement, self.angular_velocity_bias_x,
+                self.angular_velocity_bias_y, self.angular_velocity_bias_z, self.sample,
+                self.sequence, self.telemetry, self.temperature, self.timestamp,
+                self.transition_errors_left, self.transition_errors_right);
+    }
+};
+
+/**
+ *  @brief  Subscription message struct.
+ *
+ *  This struct contains the telemetry subscription that the
+ *  Biped ground station selects, such that the telemetry frames
+ *  only carry the fields that are being looked at, each at its
+ *  own rate.
+ */
+struct SubscriptionMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    MessageHeader header;   //!< Message header struct.
+    unsigned long long sequence;   //!< Message sequence number.
+    TelemetrySubscription subscription; //!< Telemetry subscription struct.
+
+    /**
+     *  @brief  Subscription message constructor
+     *
+     *  This constructor initializes all subscription message struct entries.
+     */
+    SubscriptionMessage() : header(MessageType::subscription_message), sequence(0)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Subscription message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        return archive(self.header, self.sequence, self.subscription);
+    }
+};
+
+/**
+ *  @brief  Command message struct.
+ *
+ *  This struct contains a single typed command from the Biped
+ *  ground station, e.g., setting the gains of one controller,
+ *  along with the session and the sequence number of the command.
+ *  Only the payload entry of the command type is serialized, such
+ *  that a command message is a few dozen bytes rather than a whole
+ *  Biped message.
+ *
+ *  The Biped firmware applies the command messages of a session
+ *  strictly in sequence and acknowledges the last applied sequence
+ *  number in the status messages. The Biped ground station
+ *  retransmits all unacknowledged command messages, and duplicates
+ *  are acknowledged again without being applied twice.
+ */
+struct CommandMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    PIDControllerGain gain; //!< PID controller gain struct payload.
+    double gain_open_loop;  //!< Open-loop controller gain payload.
+    MessageHeader header;   //!< Message header struct.
+    ControllerMode mode;    //!< Controller mode payload.
+    ControllerReference reference;  //!< Controller reference struct payload.
+    ControllerSaturation saturation;    //!< Controller saturation struct payload.
+    uint32_t sequence;  //!< Command sequence number, starting from 1 in each session.
+    uint32_t session;   //!< Session of the Biped ground station, other than 0.
+    CommandType type;   //!< Command type.
+
+    /**
+     *  @param  type Command type.
+     *  @brief  Command message constructor
+     *
+     *  This constructor initializes all command message struct entries.
+     */
+    CommandMessage(const CommandType& type = CommandType::start_plan) : gain_open_loop(0),
+            header(MessageType::command_message), mode(ControllerMode::pid), sequence(0),
+            session(0), type(type)
+    {
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Command message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by the session, sequence number, command type, and
+     *  only the payload entry of the command type. Deserialization
+     *  fails if the command type is invalid.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        auto result = archive(self.header, self.session, self.sequence, self.type);
+
+        if (!result)
+        {
+            return result;
+        }
+
+        switch (self.type)
+        {
+            case CommandType::set_gain_attitude_y:
+            case CommandType::set_gain_attitude_z:
+            case CommandType::set_gain_position_x:
+            {
+                return archive(self.gain);
+            }
+            case CommandType::set_gain_open_loop_attitude_z:
+            {
+                return archive(self.gain_open_loop);
+            }
+            case CommandType::set_mode:
+            {
+                return archive(self.mode);
+            }
+            case CommandType::set_reference:
+            {
+                return archive(self.reference);
+            }
+            case CommandType::set_saturation_position_x:
+            {
+                return archive(self.saturation);
+            }
+            case CommandType::start_plan:
+            {
+                return result;
+            }
+            default:
+            {
+                return decltype(result)(zpp::serializer::error::out_of_range);
+            }
+        }
+    }
+};
+
+/**
+ *  @brief  Camera chunk header struct.
+ *
+ *  This struct contains the header of every camera frame chunk,
+ *  i.e., every camera UDP datagram, followed by the chunk of the
+ *  JPG camera frame. A camera frame is split into chunks of equal
+ *  size, except for the last one, such that the offset of a chunk
+ *  follows from its index, and the chunks of a camera frame can be
+ *  reassembled in any order.
+ */
+struct CameraChunkHeader
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    static constexpr size_t size = 22;  //!< Serialized size, in bytes.
+
+    uint16_t chunk_count;   //!< Number of chunks of the camera frame.
+    uint16_t chunk_index;   //!< Index of this chunk.
+    uint32_t frame_id;  //!< Camera frame ID, incremented for every camera frame.
+    uint32_t frame_size;    //!< Camera frame size, in bytes.
+    MessageHeader header;   //!< Message header struct.
+    unsigned long long timestamp;   //!< Camera frame capture timestamp, in microseconds.
+
+    /**
+     *  @brief  Camera chunk header constructor
+     *
+     *  This constructor initializes all camera chunk header struct entries.
+     */
+    CameraChunkHeader() : chunk_count(0), chunk_index(0), frame_id(0), frame_size(0),
+            header(MessageType::camera_chunk), timestamp(0)
+    {
+    }
+
+    /**
+     *  @param  frame_size Camera frame size, in bytes.
+     *  @param  payload_size_max Maximum chunk payload size, in bytes.
+     *  @return Number of chunks, or 0 if the camera frame needs too many chunks.
+     *  @brief  Get the number of chunks of a camera frame.
+     */
+    inline static size_t
+    getChunkCount(const size_t& frame_size, const size_t& payload_size_max)
+    {
+        const size_t chunk_count = (frame_size + payload_size_max - 1) / payload_size_max;
+
+        return chunk_count > 0 && chunk_count <= std::numeric_limits<uint16_t>::max()
+                ? chunk_count : 0;
+    }
+
+    /**
+     *  @return Chunk payload size, in bytes, except for the last chunk.
+     *  @brief  Get the chunk payload size.
+     *
+     *  This function divides the camera frame evenly into the
+     *  number of chunks, rounding up.
+     */
+    inline size_t
+    getChunkSize() const
+    {
+        return chunk_count > 0 ? (frame_size + chunk_count - 1) / chunk_count : 0;
+    }
+
+    /**
+     *  @return Offset of this chunk in the camera frame, in bytes.
+     *  @brief  Get the offset of this chunk.
+     */
+    inline size_t
+    getOffset() const
+    {
+        return chunk_index * getChunkSize();
+    }
+
+    /**
+     *  @return Payload size of this chunk, in bytes.
+     *  @brief  Get the payload size of this chunk.
+     */
+    inline size_t
+    getPayloadSize() const
+    {
+        return getOffset() < frame_size ? std::min(getChunkSize(), frame_size - getOffset()) : 0;
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Camera chunk header serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct. Deserialization
+     *  fails if the chunk index or the number of chunks is invalid.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        auto result = archive(self.header, self.frame_id, self.chunk_index, self.chunk_count,
+                self.frame_size, self.timestamp);
+
+        if (result && (self.chunk_index >= self.chunk_count || self.getPayloadSize() == 0))
+        {
+            return decltype(result)(zpp::serializer::error::out_of_range);
+        }
+
+        return result;
+    }
+};
+
+/**
+ *  @brief  Camera feedback message struct.
+ *
+ *  This struct contains the camera frame reception statistics of
+ *  the Biped ground station over a window, e.g., the received bytes
+ *  and the received and lost chunks, sent periodically to the Biped
+ *  firmware for the camera rate controller. Camera feedback messages
+ *  are not acknowledged, since every camera feedback message covers
+ *  its own window.
+ */
+struct CameraFeedbackMessage
+{
+    /*
+     *  This struct is a friend of the zpp serializer
+     *  access class.
+     */
+    friend zpp::serializer::access;
+
+    uint32_t byte_count;    //!< Received camera chunk bytes, including the camera chunk headers.
+    uint32_t chunk_count_lost;  //!< Lost chunks of the dropped and completed camera frames.
+    uint32_t chunk_count_received;  //!< Received chunks, excluding duplicates.
+    uint32_t frame_count_complete;  //!< Completed camera frames.
+    uint32_t frame_count_dropped;   //!< Dropped camera frames, including those never received.
+    MessageHeader header;   //!< Message header struct.
+    uint32_t window;    //!< Window, in milliseconds.
+
+    /**
+     *  @brief  Camera feedback message constructor
+     *
+     *  This constructor initializes all camera feedback message struct entries.
+     */
+    CameraFeedbackMessage() : byte_count(0), chunk_count_lost(0), chunk_count_received(0),
+            frame_count_complete(0), frame_count_dropped(0),
+            header(MessageType::camera_feedback_message), window(0)
+    {
+    }
+
+    /**
+     *  @return Chunk loss ratio over the window, from 0 to 1.
+     *  @brief  Get the chunk loss ratio.
+     */
+    inline double
+    getLoss() const
+    {
+        const double chunk_count = static_cast<double>(chunk_count_received) + chunk_count_lost;
+
+        return chunk_count > 0 ? chunk_count_lost / chunk_count : 0;
+    }
+
+    /**
+     *  @return Received throughput over the window, in bytes per second.
+     *  @brief  Get the received throughput.
+     */
+    inline double
+    getThroughput() const
+    {
+        return window > 0 ? byte_count * 1000.0 / window : 0;
+    }
+
+    /**
+     *  @tparam Archive Type of archive.
+     *  @tparam Self Type of this struct.
+     *  @param  archive Serialization archive.
+     *  @param  self This struct.
+     *  @return Serialization archive.
+     *  @brief  Camera feedback message serialization function.
+     *
+     *  This function performs serialization of the header first,
+     *  followed by all other entries in this struct. Deserialization
+     *  fails if the window is empty.
+     */
+    template<typename Archive, typename Self>
+    inline static auto
+    serialize(Archive& archive, Self& self)
+    {
+        auto result = archive(self.header, self.window, self.byte_count,
+                self.chunk_count_received, self.chunk_count_lost, self.frame_count_complete,
+                self.frame_count_dropped);
+
+        if (result && self.window == 0)
+        {
+            return decltype(result)(zpp::serializer::error::out_of_range);
+        }
+
+        return result;
     }
 };
 }   // namespace firmware
@@ -1,113 +1,459 @@
+#include <algorithm>
+#include <cstring>
+#include <QBuffer>
+#include <QByteArray>
+#include <QImageReader>
+
 #include "common/global.h"
 #include "daemon/camera_daemon.h"
-#include "common/parameter.h"
 #include "network/udp.h"
 
 namespace biped
 {
 namespace ground_station
 {
-CameraDaemon::CameraDaemon(QObject *parent) : QObject(parent), started_(false)
+CameraDaemon::CameraDaemon(QObject *parent) : QObject(parent), datagram_(NetworkParameter::buffer_size_camera), decoding_(false), frame_id_frame_(0), frame_id_last_(0), frame_id_last_valid_(false), frame_id_newest_(0), frame_id_newest_valid_(false), frame_pending_(false), frame_valid_(false), height_display_(0), recording_(false), width_display_(0)
 {
+    for (size_t buffer = 0; buffer < buffers_.size(); buffer ++)
+    {
+        buffers_[buffer].resize(CameraDaemonParameter::frame_size_max);
+        buffers_free_.push_back(buffer);
+    }
+}
+
+CameraDaemon::~CameraDaemon()
+{
+    stop();
+}
+
+QImage
+CameraDaemon::getFrame()
+{
+    std::lock_guard<std::mutex> lock(mutex_frame_);
+
+    frame_pending_ = false;
+
+    return frame_;
+}
+
+void
+CameraDaemon::setDisplaySize(const QSize& size)
+{
+    height_display_ = size.height();
+    width_display_ = size.width();
+}
+
+void
+CameraDaemon::setRecording(const bool& recording)
+{
+    recording_ = recording;
 }
 
 void
 CameraDaemon::start()
 {
-    started_ = true;
+    feedback_ = biped::firmware::CameraFeedbackMessage();
+    time_point_feedback_ = std::chrono::steady_clock::now();
+    stop_token_.reset();
+
+    std::lock_guard<std::mutex> lock(mutex_decode_);
+
+    if (decoding_)
+    {
+        return;
+    }
+
+    decoding_ = true;
+
+    for (size_t i = 0; i < CameraDaemonParameter::decode_thread_count; i ++)
+    {
+        threads_decode_.emplace_back(&CameraDaemon::decode, this);
+    }
 }
 
 void
 CameraDaemon::stop()
 {
-    started_ = false;
+    stop_token_.request();
+
+    std::unique_lock<std::mutex> lock(mutex_decode_);
+    decoding_ = false;
+    lock.unlock();
+
+    condition_decode_.notify_all();
+
+    for (auto& thread : threads_decode_)
+    {
+        thread.join();
+    }
+
+    threads_decode_.clear();
+
+    lock.lock();
+
+    for (const auto& job : decode_jobs_)
+    {
+        releaseBuffer(job.buffer);
+    }
+
+    decode_jobs_.clear();
 }
 
 void
 CameraDaemon::operate()
 {
-    bool frame_boundary_received = false;
-    const std::string frame_boundary_reference = NetworkParameter::camera_frame_boundary;
-    bool frame_incomplete = false;
-    size_t frame_packet_count = 0;
+    while (!stop_token_.requested())
+    {
+        updateFeedback();
+
+        if (!udp_camera_ || !udp_camera_->bound())
+        {
+            stop_token_.waitFor(std::chrono::milliseconds(NetworkParameter::timeout));
+            continue;
+        }
+
+        const size_t size = udp_camera_->readBuffer(ip_biped_, NetworkParameter::port_udp_camera, datagram_.data(), datagram_.size());
+
+        if (size > 0)
+        {
+            reassemble(datagram_.data(), size);
+        }
+    }
+}
 
+bool
+CameraDaemon::acquireBuffer(size_t& buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_buffer_);
+
+    if (buffers_free_.empty())
+    {
+        return false;
+    }
+
+    buffer = buffers_free_.back();
+    buffers_free_.pop_back();
+
+    return true;
+}
+
+void
+CameraDaemon::complete(Slot& slot)
+{
+    slot.statistics.complete = true;
+    slot.active = false;
+    feedback_.frame_count_complete ++;
+
+    frame_id_last_ = slot.statistics.frame_id;
+    frame_id_last_valid_ = true;
+
+    for (auto& slot_older : slots_)
+    {
+        if (slot_older.active && isStale(slot_older.statistics.frame_id))
+        {
+            drop(slot_older);
+        }
+    }
+
+    /*
+     *  Hand the JPG camera frame, as received, to the logging daemon before the buffer goes to the decode threads.
+     */
+    if (recording_)
+    {
+        emit frameDataReceived(QByteArray(reinterpret_cast<const char*>(buffers_[slot.buffer].data()), static_cast<int>(slot.statistics.frame_size)), slot.statistics);
+    }
+
+    const DecodeJob job = {slot.buffer, slot.statistics.frame_id, slot.statistics.frame_size, getScaledSize(slot.buffer, slot.statistics.frame_size)};
+    std::unique_lock<std::mutex> lock(mutex_decode_);
+
+    if (!decoding_)
+    {
+        lock.unlock();
+        releaseBuffer(slot.buffer);
+    }
+    else if (!job.size_scaled.isValid())
+    {
+        /*
+         *  Without a downscale, handing the JPG camera frame to a decode thread costs more CPU time than the decode
+         *  threads save, so decode it here, before reassembling the next one.
+         */
+        lock.unlock();
+        decodeFrame(job);
+    }
+    else
+    {
+        if (decode_jobs_.size() >= CameraDaemonParameter::decode_thread_count)
+        {
+            releaseBuffer(decode_jobs_.front().buffer);
+            decode_jobs_.pop_front();
+        }
+
+        decode_jobs_.push_back(job);
+        lock.unlock();
+
+        condition_decode_.notify_one();
+    }
+
+    emit frameStatisticsUpdated(slot.statistics);
+}
+
+void
+CameraDaemon::decode()
+{
     for (;;)
     {
-        if (!started_)
+        std::unique_lock<std::mutex> lock(mutex_decode_);
+
+        condition_decode_.wait(lock, [this]()
+        {
+            return !decoding_ || !decode_jobs_.empty();
+        });
+
+        if (!decoding_)
         {
             break;
         }
 
-        if (!udp_camera_ || !udp_camera_->bound())
+        const DecodeJob job = decode_jobs_.front();
+        decode_jobs_.pop_front();
+        lock.unlock();
+
+        decodeFrame(job);
+    }
+}
+
+void
+CameraDaemon::decodeFrame(const DecodeJob& job)
+{
+    QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(buffers_[job.buffer].data()), static_cast<int>(job.frame_size));
+    QBuffer device(&data);
+    QImageReader reader(&device, "JPG");
+    QImage frame;
+
+    if (job.size_scaled.isValid())
+    {
+        reader.setScaledSize(job.size_scaled);
+    }
+
+    const bool decoded = reader.read(&frame);
+
+    releaseBuffer(job.buffer);
+
+    if (decoded)
+    {
+        post(job.frame_id, frame);
+    }
+}
+
+void
+CameraDaemon::drop(Slot& slot)
+{
+    slot.active = false;
+    feedback_.chunk_count_lost += slot.statistics.chunk_count - slot.statistics.chunk_count_received;
+    feedback_.frame_count_dropped ++;
+
+    releaseBuffer(slot.buffer);
+
+    emit frameStatisticsUpdated(slot.statistics);
+}
+
+CameraDaemon::Slot*
+CameraDaemon::findSlot(const biped::firmware::CameraChunkHeader& header)
+{
+    Slot* slot_free = nullptr;
+    Slot* slot_oldest = nullptr;
+
+    for (auto& slot : slots_)
+    {
+        if (!slot.active)
         {
+            slot_free = slot_free ? slot_free : &slot;
             continue;
         }
 
-        std::shared_ptr<std::vector<char>> buffer = udp_camera_->readBuffer(ip_biped_, NetworkParameter::port_udp_camera, NetworkParameter::buffer_size_camera);
+        if (slot.statistics.frame_id == header.frame_id)
+        {
+            return &slot;
+        }
 
-        if (buffer)
+        if (!slot_oldest || static_cast<int32_t>(slot.statistics.frame_id - slot_oldest->statistics.frame_id) < 0)
         {
-            if (!frame_boundary_received)
-            {
-                if (buffer->size() <= frame_boundary_reference.size())
-                {
-                    continue;
-                }
-
-                const std::string frame_boundary = std::string(buffer->begin(), buffer->begin() + frame_boundary_reference.size());
-
-                if (frame_boundary == frame_boundary_reference)
-                {
-                    frame_boundary_received = true;
-                    frame_packet_count = static_cast<size_t>(buffer->at(frame_boundary_reference.size()));
-                }
-            }
-
-            if (frame_boundary_received)
-            {
-                frame_boundary_received = false;
-
-                std::vector<char> jpg_buffer;
-
-                for (size_t i = 0; i < frame_packet_count; i ++)
-                {
-                    buffer = udp_camera_->readBuffer(ip_biped_, NetworkParameter::port_udp_camera, NetworkParameter::buffer_size_camera);
-
-                    if (!buffer)
-                    {
-                        frame_incomplete = true;
-                        break;
-                    }
-
-                    if (buffer->size() > frame_boundary_reference.size())
-                    {
-                        const std::string frame_boundary = std::string(buffer->begin(), buffer->begin() + frame_boundary_reference.size());
-
-                        if (frame_boundary == frame_boundary_reference)
-                        {
-                            frame_incomplete = true;
-                            break;
-                        }
-                    }
-
-                    jpg_buffer.insert(jpg_buffer.end(), buffer->begin(), buffer->end());
-                }
-
-                frame_packet_count = 0;
-
-                if (frame_incomplete)
-                {
-                    frame_incomplete = false;
-                    continue;
-                }
-
-                if (frame_.loadFromData(reinterpret_cast<unsigned char*>(jpg_buffer.data()), jpg_buffer.size(), "JPG"))
-                {
-                    emit frameReceived(frame_);
-                }
-            }
+            slot_oldest = &slot;
         }
     }
+
+    if (!frame_id_newest_valid_ || static_cast<int32_t>(header.frame_id - frame_id_newest_) > 0)
+    {
+        const uint32_t frame_count_missing = frame_id_newest_valid_ ? std::min(header.frame_id - frame_id_newest_ - 1, CameraDaemonParameter::frame_id_window) : 0;
+
+        feedback_.chunk_count_lost += frame_count_missing * header.chunk_count;
+        feedback_.frame_count_dropped += frame_count_missing;
+        frame_id_newest_ = header.frame_id;
+        frame_id_newest_valid_ = true;
+    }
+
+    Slot* slot = slot_free;
+
+    if (!slot)
+    {
+        /*
+         *  A chunk of a camera frame older than every reassembling one, e.g., a late chunk of an evicted camera frame,
+         *  could never complete, so it is lost rather than evicting a newer camera frame.
+         */
+        if (static_cast<int32_t>(header.frame_id - slot_oldest->statistics.frame_id) < 0)
+        {
+            feedback_.chunk_count_lost ++;
+            return nullptr;
+        }
+
+        drop(*slot_oldest);
+        slot = slot_oldest;
+    }
+
+    if (!acquireBuffer(slot->buffer))
+    {
+        return nullptr;
+    }
+
+    slot->active = true;
+    slot->chunk_received.assign(header.chunk_count, false);
+    slot->statistics = CameraFrameStatistics();
+    slot->statistics.chunk_count = header.chunk_count;
+    slot->statistics.frame_id = header.frame_id;
+    slot->statistics.frame_size = header.frame_size;
+    slot->statistics.timestamp = header.timestamp;
+
+    return slot;
+}
+
+QSize
+CameraDaemon::getScaledSize(const size_t& buffer, const size_t& frame_size) const
+{
+    /*
+     *  Only the JPG header is read here, for the camera frame size.
+     */
+    QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(buffers_[buffer].data()), static_cast<int>(frame_size));
+    QBuffer device(&data);
+    QImageReader reader(&device, "JPG");
+    const QSize size = reader.size();
+    const QSize size_display(width_display_, height_display_);
+
+    if (size.isValid() && !size_display.isEmpty() && size_display.width() < size.width() && size_display.height() < size.height())
+    {
+        return size_display;
+    }
+
+    return QSize();
+}
+
+bool
+CameraDaemon::isStale(const uint32_t& frame_id)
+{
+    if (!frame_id_last_valid_)
+    {
+        return false;
+    }
+
+    const uint32_t frame_id_behind = frame_id_last_ - frame_id;
+
+    if (frame_id_behind > CameraDaemonParameter::frame_id_window && static_cast<int32_t>(frame_id_behind) > 0)
+    {
+        frame_id_last_valid_ = false;
+        return false;
+    }
+
+    return static_cast<int32_t>(frame_id_behind) >= 0;
+}
+
+void
+CameraDaemon::post(const uint32_t& frame_id, const QImage& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_frame_);
+
+    if (frame_valid_ && static_cast<int32_t>(frame_id - frame_id_frame_) <= 0)
+    {
+        return;
+    }
+
+    const bool notify = !frame_pending_;
+
+    frame_ = frame;
+    frame_id_frame_ = frame_id;
+    frame_pending_ = true;
+    frame_valid_ = true;
+    lock.unlock();
+
+    if (notify)
+    {
+        emit frameReceived();
+    }
+}
+
+void
+CameraDaemon::reassemble(const char* datagram, const size_t& size)
+{
+    biped::firmware::CameraChunkHeader header;
+    zpp::serializer::memory_view_input_archive deserializer(reinterpret_cast<const unsigned char*>(datagram), size);
+
+    if (size <= biped::firmware::CameraChunkHeader::size || !deserializer(header) || header.frame_size > CameraDaemonParameter::frame_size_max || size - biped::firmware::CameraChunkHeader::size != header.getPayloadSize())
+    {
+        return;
+    }
+
+    if (isStale(header.frame_id))
+    {
+        return;
+    }
+
+    Slot* slot = findSlot(header);
+
+    if (!slot || slot->statistics.chunk_count != header.chunk_count || slot->statistics.frame_size != header.frame_size)
+    {
+        return;
+    }
+
+    if (slot->chunk_received[header.chunk_index])
+    {
+        slot->statistics.chunk_count_duplicate ++;
+        return;
+    }
+
+    std::memcpy(buffers_[slot->buffer].data() + header.getOffset(), datagram + biped::firmware::CameraChunkHeader::size, header.getPayloadSize());
+    slot->chunk_received[header.chunk_index] = true;
+    slot->statistics.chunk_count_received ++;
+    feedback_.byte_count += static_cast<uint32_t>(size);
+    feedback_.chunk_count_received ++;
+
+    if (slot->statistics.chunk_count_received == slot->statistics.chunk_count)
+    {
+        complete(*slot);
+    }
+}
+
+void
+CameraDaemon::releaseBuffer(const size_t& buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_buffer_);
+    buffers_free_.push_back(buffer);
+}
+
+void
+CameraDaemon::updateFeedback()
+{
+    const std::chrono::steady_clock::time_point time_point = std::chrono::steady_clock::now();
+    const auto window = std::chrono::duration_cast<std::chrono::milliseconds>(time_point - time_point_feedback_).count();
+
+    if (window < CameraDaemonParameter::period_feedback)
+    {
+        return;
+    }
+
+    feedback_.window = static_cast<uint32_t>(window);
+
+    emit feedbackUpdated(feedback_);
+
+    feedback_ = biped::firmware::CameraFeedbackMessage();
+    time_point_feedback_ = time_point;
 }
 }
 }
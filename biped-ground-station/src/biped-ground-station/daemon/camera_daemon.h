@@ -1,13 +1,42 @@
 #ifndef CAMERA_DAEMON_H
 #define CAMERA_DAEMON_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <QByteArray>
 #include <QImage>
 #include <QObject>
+#include <QSize>
+#include <thread>
+#include <vector>
+
+#include "common/parameter.h"
+#include "common/type.h"
+#include "utility/stop_token.h"
 
 namespace biped
 {
 namespace ground_station
 {
+struct CameraFrameStatistics
+{
+    uint16_t chunk_count;
+    uint16_t chunk_count_duplicate;
+    uint16_t chunk_count_received;
+    bool complete;
+    uint32_t frame_id;
+    uint32_t frame_size;
+    unsigned long long timestamp;
+
+    CameraFrameStatistics() : chunk_count(0), chunk_count_duplicate(0), chunk_count_received(0), complete(false), frame_id(0), frame_size(0), timestamp(0)
+    {
+    }
+};
+
 class CameraDaemon : public QObject
 {
     Q_OBJECT
@@ -16,6 +45,17 @@ public:
 
     explicit CameraDaemon(QObject *parent = nullptr);
 
+    ~CameraDaemon();
+
+    QImage
+    getFrame();
+
+    void
+    setDisplaySize(const QSize& size);
+
+    void
+    setRecording(const bool& recording);
+
     void
     start();
 
@@ -25,7 +65,16 @@ public:
 signals:
 
     void
-    frameReceived(const QImage& frame);
+    feedbackUpdated(const biped::firmware::CameraFeedbackMessage& message);
+
+    void
+    frameDataReceived(const QByteArray& frame, const CameraFrameStatistics& statistics);
+
+    void
+    frameReceived();
+
+    void
+    frameStatisticsUpdated(const CameraFrameStatistics& statistics);
 
 public slots:
 
@@ -34,8 +83,87 @@ public slots:
 
 private:
 
+    struct DecodeJob
+    {
+        size_t buffer;
+        uint32_t frame_id;
+        size_t frame_size;
+        QSize size_scaled;
+    };
+
+    struct Slot
+    {
+        bool active;
+        size_t buffer;
+        std::vector<bool> chunk_received;
+        CameraFrameStatistics statistics;
+
+        Slot() : active(false), buffer(0)
+        {
+        }
+    };
+
+    bool
+    acquireBuffer(size_t& buffer);
+
+    void
+    complete(Slot& slot);
+
+    void
+    decode();
+
+    void
+    decodeFrame(const DecodeJob& job);
+
+    void
+    drop(Slot& slot);
+
+    Slot*
+    findSlot(const biped::firmware::CameraChunkHeader& header);
+
+    QSize
+    getScaledSize(const size_t& buffer, const size_t& frame_size) const;
+
+    bool
+    isStale(const uint32_t& frame_id);
+
+    void
+    post(const uint32_t& frame_id, const QImage& frame);
+
+    void
+    reassemble(const char* datagram, const size_t& size);
+
+    void
+    releaseBuffer(const size_t& buffer);
+
+    void
+    updateFeedback();
+
+    std::array<std::vector<unsigned char>, CameraDaemonParameter::buffer_count> buffers_;
+    std::vector<size_t> buffers_free_;
+    std::condition_variable condition_decode_;
+    std::vector<char> datagram_;
+    std::deque<DecodeJob> decode_jobs_;
+    bool decoding_;
+    biped::firmware::CameraFeedbackMessage feedback_;
     QImage frame_;
-    bool started_;
+    uint32_t frame_id_frame_;
+    uint32_t frame_id_last_;
+    bool frame_id_last_valid_;
+    uint32_t frame_id_newest_;
+    bool frame_id_newest_valid_;
+    bool frame_pending_;
+    bool frame_valid_;
+    std::atomic<int> height_display_;
+    std::mutex mutex_buffer_;
+    std::mutex mutex_decode_;
+    std::mutex mutex_frame_;
+    std::atomic<bool> recording_;
+    std::array<Slot, CameraDaemonParameter::slot_count> slots_;
+    StopToken stop_token_;
+    std::vector<std::thread> threads_decode_;
+    std::chrono::steady_clock::time_point time_point_feedback_;
+    std::atomic<int> width_display_;
 };
 }
 }
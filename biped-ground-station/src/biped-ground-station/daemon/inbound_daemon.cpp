@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "common/global.h"
 #include "daemon/inbound_daemon.h"
 #include "common/parameter.h"
@@ -8,64 +10,117 @@ namespace biped
 {
 namespace ground_station
 {
-InboundDaemon::InboundDaemon(QObject *parent) : QObject(parent), started_(false)
+InboundDaemon::InboundDaemon(QObject *parent) : QObject(parent), parameter_received_(false)
 {
 }
 
+BipedMessageBus&
+InboundDaemon::getTelemetryBus()
+{
+    return bus_;
+}
+
+TelemetryFrameBus&
+InboundDaemon::getTelemetryFrameBus()
+{
+    return bus_frame_;
+}
+
 void
 InboundDaemon::start()
 {
-    started_ = true;
+    stop_token_.reset();
 }
 
 void
 InboundDaemon::stop()
 {
-    started_ = false;
+    stop_token_.request();
 }
 
 void
 InboundDaemon::operate()
 {
-    for (;;)
+    while (!stop_token_.requested())
     {
-        if (!started_)
-        {
-            break;
-        }
-
         if (!udp_biped_message_ || !udp_biped_message_->bound())
         {
+            stop_token_.waitFor(std::chrono::milliseconds(NetworkParameter::timeout));
             continue;
         }
 
-        std::string message = udp_biped_message_->read(ip_biped_, NetworkParameter::port_udp_biped_message, NetworkParameter::buffer_size_biped_message);
+        std::string message = udp_biped_message_->read(ip_biped_, NetworkParameter::port_udp_biped_message, std::max(NetworkParameter::buffer_size_biped_message, NetworkParameter::buffer_size_telemetry_frame));
 
         if (message == "")
         {
             continue;
         }
 
-        biped::firmware::BipedMessage message_deserialized;
         std::vector<unsigned char> message_serialized(message.begin(), message.end());
         zpp::serializer::memory_input_archive deserializer(message_serialized);
 
-        const auto result = deserializer(message_deserialized);
+        if (message_serialized.front() == static_cast<unsigned char>(biped::firmware::MessageType::telemetry_frame))
+        {
+            biped::firmware::TelemetryFrame frame;
+
+            if (!deserializer(frame))
+            {
+                if (window_)
+                {
+                    window_->logToStatusBar("Failed to deserialize telemetry frame.");
+                }
+
+                continue;
+            }
+
+            bus_frame_.publish(frame);
+            continue;
+        }
+
+        if (message_serialized.front() == static_cast<unsigned char>(biped::firmware::MessageType::parameter_message))
+        {
+            biped::firmware::ParameterMessage parameter_message;
+
+            if (!deserializer(parameter_message))
+            {
+                if (window_)
+                {
+                    window_->logToStatusBar("Failed to deserialize parameter message.");
+                }
 
-        if (!result)
+                continue;
+            }
+
+            controller_parameter_ = parameter_message.controller_parameter;
+            parameter_received_ = true;
+            continue;
+        }
+
+        biped::firmware::StatusMessage status_message;
+
+        if (!deserializer(status_message))
         {
             if (window_)
             {
-                window_->logToStatusBar("Failed to deserialize Biped message.");
+                window_->logToStatusBar("Failed to deserialize status message.");
             }
 
             continue;
         }
 
+        emit acknowledgementReceived(status_message.acknowledgement);
+
+        if (!parameter_received_)
+        {
+            continue;
+        }
+
+        biped::firmware::BipedMessage message_deserialized = status_message.getBipedMessage(controller_parameter_);
+
         message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_lower = message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_lower < -UIParameter::window_rendering_value_limit ? -UIParameter::window_rendering_value_limit : message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_lower;
         message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_upper = message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_upper > UIParameter::window_rendering_value_limit ? UIParameter::window_rendering_value_limit : message_deserialized.controller_parameter.pid_controller_saturation_position_x.input_upper;
 
-        emit messageReceived(message_deserialized);
+        bus_.publish(message_deserialized);
     }
 }
 }
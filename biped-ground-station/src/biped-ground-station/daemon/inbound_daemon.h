@@ -3,12 +3,18 @@
 
 #include <QObject>
 
+#include "common/parameter.h"
 #include "common/type.h"
+#include "utility/stop_token.h"
+#include "utility/telemetry_bus.h"
 
 namespace biped
 {
 namespace ground_station
 {
+using BipedMessageBus = TelemetryBus<biped::firmware::BipedMessage, TelemetryBusParameter::capacity, TelemetryBusParameter::consumer_count>;
+using TelemetryFrameBus = TelemetryBus<biped::firmware::TelemetryFrame, TelemetryBusParameter::capacity_frame, TelemetryBusParameter::consumer_count>;
+
 class InboundDaemon : public QObject
 {
     Q_OBJECT
@@ -17,6 +23,12 @@ public:
 
     explicit InboundDaemon(QObject *parent = nullptr);
 
+    BipedMessageBus&
+    getTelemetryBus();
+
+    TelemetryFrameBus&
+    getTelemetryFrameBus();
+
     void
     start();
 
@@ -26,7 +38,7 @@ public:
 signals:
 
     void
-    messageReceived(const biped::firmware::BipedMessage& message);
+    acknowledgementReceived(const biped::firmware::CommandAcknowledgement& acknowledgement);
 
 public slots:
 
@@ -35,7 +47,11 @@ public slots:
 
 private:
 
-    bool started_;
+    BipedMessageBus bus_;
+    TelemetryFrameBus bus_frame_;
+    biped::firmware::ControllerParameter controller_parameter_;
+    bool parameter_received_;
+    StopToken stop_token_;
 };
 }
 }
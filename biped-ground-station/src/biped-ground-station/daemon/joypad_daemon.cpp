@@ -9,7 +9,7 @@ namespace biped
 {
 namespace ground_station
 {
-JoypadDaemon::JoypadDaemon(QObject *parent) : QObject(parent), device_(-1), initialized_(false), started_(false)
+JoypadDaemon::JoypadDaemon(QObject *parent) : QObject(parent), device_(-1), initialized_(false)
 {
     openDevice(JoypadDaemonParameter::path_device_default);
 }
@@ -22,28 +22,23 @@ JoypadDaemon::~JoypadDaemon()
 void
 JoypadDaemon::start()
 {
-    started_ = true;
+    stop_token_.reset();
 }
 
 void
 JoypadDaemon::stop()
 {
-    started_ = false;
+    stop_token_.request();
 }
 
 void
 JoypadDaemon::operate()
 {
-    for (;;)
+    while (!stop_token_.requested())
     {
-        if (!started_)
+        if (!initialized_ && !openDevice(JoypadDaemonParameter::path_device_default))
         {
-            break;
-        }
-
-        if (!initialized_)
-        {
-            openDevice(JoypadDaemonParameter::path_device_default);
+            stop_token_.waitFor(std::chrono::milliseconds(JoypadDaemonParameter::period_reconnect));
             continue;
         }
 
@@ -61,13 +56,25 @@ JoypadDaemon::operate()
 
         status = select(device_ + 1, &set, NULL, NULL, &timeout);
 
-        if (status <= 0)
+        if (status == 0)
+        {
+            continue;
+        }
+
+        if (status < 0)
         {
+            closeDevice();
             continue;
         }
 
         bytes = read(device_, &event, sizeof(event));
 
+        if (bytes <= 0)
+        {
+            closeDevice();
+            continue;
+        }
+
         if (bytes != sizeof(event))
         {
             continue;
@@ -127,7 +134,11 @@ JoypadDaemon::closeDevice()
 
     if (device_ >= 0)
     {
-        if (close(device_) < 0)
+        const int device = device_;
+
+        device_ = -1;
+
+        if (close(device) < 0)
         {
             return false;
         }
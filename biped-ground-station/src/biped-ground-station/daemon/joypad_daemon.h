@@ -3,6 +3,8 @@
 
 #include <QObject>
 
+#include "utility/stop_token.h"
+
 namespace biped
 {
 namespace ground_station
@@ -46,7 +48,7 @@ private:
 
     int device_;
     bool initialized_;
-    bool started_;
+    StopToken stop_token_;
 };
 }
 }
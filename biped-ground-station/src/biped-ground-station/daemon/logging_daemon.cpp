@@ -2,8 +2,11 @@
 #include <sstream>
 
 #include "common/global.h"
+#include "daemon/inbound_daemon.h"
 #include "daemon/logging_daemon.h"
 #include "common/parameter.h"
+#include "utility/biped_message_log.h"
+#include "utility/telemetry_sample_log.h"
 #include "utility/utility.h"
 #include "ui/window.h"
 
@@ -11,7 +14,7 @@ namespace biped
 {
 namespace ground_station
 {
-LoggingDaemon::LoggingDaemon(QObject *parent) : QObject(parent), frame_count_(0), initialized_(false), started_(false)
+LoggingDaemon::LoggingDaemon(QObject *parent) : QObject(parent), consumer_(0), consumer_frame_(0), consumer_frame_subscribed_(false), consumer_subscribed_(false), initialized_camera_(false), offset_frame_(0), started_(false)
 {
 }
 
@@ -26,19 +29,19 @@ LoggingDaemon::start()
     stop();
 
     std::filesystem::path path_logging = std::filesystem::path(appendHomePath(expandHomePath(removeTrailingSeparator(LoggingDaemonParameter::path_logging, '/')))) / LoggingDaemonParameter::directory_name_logging;
+    std::filesystem::path path_logging_camera = path_logging / LoggingDaemonParameter::directory_name_logging_camera;
     std::filesystem::path path_logging_data = path_logging / LoggingDaemonParameter::directory_name_logging_data;
     std::stringstream time_start_ss;
     std::time_t time_start = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
     time_start_ss << std::put_time(std::localtime(&time_start), "%Y-%m-%d-%X");
     time_start_ = time_start_ss.str();
-    path_logging_camera_ = path_logging / LoggingDaemonParameter::directory_name_logging_camera / time_start_;
 
-    if (!std::filesystem::exists(path_logging_camera_))
+    if (!std::filesystem::exists(path_logging_camera))
     {
         try
         {
-            std::filesystem::create_directories(path_logging_camera_);
+            std::filesystem::create_directories(path_logging_camera);
         }
         catch (const std::filesystem::filesystem_error& error)
         {
@@ -60,129 +63,279 @@ LoggingDaemon::start()
         }
     }
 
-    const std::string file_name_logging_data = time_start_ + LoggingDaemonParameter::file_extension_logging_data;
+    const std::string file_name_logging_data = time_start_ + LoggingDaemonParameter::file_extension_logging_data_binary;
 
-    file_logging_data_.open(path_logging_data / file_name_logging_data, std::fstream::out | std::fstream::trunc);
-
-    if (!file_logging_data_.is_open())
+    if (!writer_logging_data_.open(path_logging_data / file_name_logging_data, biped_message_log_columns, LoggingDaemonParameter::block_size_logging_data, LoggingDaemonParameter::compression_logging_data))
     {
         window_->logToStatusBar("Failed to open file for data logging.");
         return;
     }
 
-    initialized_ = false;
+    const std::string file_name_logging_sample = time_start_ + LoggingDaemonParameter::file_name_suffix_logging_sample + LoggingDaemonParameter::file_extension_logging_data_binary;
+
+    if (!writer_logging_sample_.open(path_logging_data / file_name_logging_sample, telemetry_sample_log_columns, LoggingDaemonParameter::block_size_logging_data, LoggingDaemonParameter::compression_logging_data))
+    {
+        window_->logToStatusBar("Failed to open file for sample logging.");
+        return;
+    }
+
+    const std::string file_name_logging_camera = time_start_ + LoggingDaemonParameter::file_name_suffix_logging_camera + LoggingDaemonParameter::file_extension_logging_data;
+
+    file_logging_camera_.open(path_logging_data / file_name_logging_camera, std::fstream::out | std::fstream::trunc);
+
+    if (!file_logging_camera_.is_open())
+    {
+        window_->logToStatusBar("Failed to open file for camera frame statistics logging.");
+        return;
+    }
+
+    const std::string file_name_logging_camera_frame = time_start_ + LoggingDaemonParameter::file_extension_logging_camera;
+
+    if (!writer_logging_camera_.open(path_logging_camera / file_name_logging_camera_frame))
+    {
+        window_->logToStatusBar("Failed to open file for camera frame logging.");
+        return;
+    }
+
+    initialized_camera_ = false;
+    offset_frame_ = 0;
+    time_point_flush_ = std::chrono::steady_clock::now();
     started_ = true;
+
+    if (daemon_camera_)
+    {
+        daemon_camera_->setRecording(true);
+    }
+
+    if (daemon_inbound_)
+    {
+        consumer_subscribed_ = daemon_inbound_->getTelemetryBus().subscribe([this]()
+        {
+            QMetaObject::invokeMethod(this, &LoggingDaemon::onInboundDaemonMessagePublished, Qt::QueuedConnection);
+        }, consumer_);
+
+        if (!consumer_subscribed_)
+        {
+            window_->logToStatusBar("Failed to subscribe to Biped messages for data logging.");
+        }
+
+        consumer_frame_subscribed_ = daemon_inbound_->getTelemetryFrameBus().subscribe([this]()
+        {
+            QMetaObject::invokeMethod(this, &LoggingDaemon::onInboundDaemonFramePublished, Qt::QueuedConnection);
+        }, consumer_frame_);
+
+        if (!consumer_frame_subscribed_)
+        {
+            window_->logToStatusBar("Failed to subscribe to telemetry frames for sample logging.");
+        }
+    }
 }
 
 void
 LoggingDaemon::stop()
 {
     started_ = false;
-    initialized_ = false;
 
-    file_logging_data_.close();
+    if (daemon_camera_)
+    {
+        daemon_camera_->setRecording(false);
+    }
+
+    if (consumer_subscribed_ && daemon_inbound_)
+    {
+        const unsigned long long message_count_dropped = daemon_inbound_->getTelemetryBus().getDropCount(consumer_);
+
+        daemon_inbound_->getTelemetryBus().unsubscribe(consumer_);
+        consumer_subscribed_ = false;
+
+        if (message_count_dropped > 0 && window_)
+        {
+            window_->logToStatusBar("Dropped " + std::to_string(message_count_dropped) + " Biped messages from data logging.");
+        }
+    }
+
+    if (consumer_frame_subscribed_ && daemon_inbound_)
+    {
+        const unsigned long long frame_count_dropped = daemon_inbound_->getTelemetryFrameBus().getDropCount(consumer_frame_);
+
+        daemon_inbound_->getTelemetryFrameBus().unsubscribe(consumer_frame_);
+        consumer_frame_subscribed_ = false;
+
+        if (frame_count_dropped > 0 && window_)
+        {
+            window_->logToStatusBar("Dropped " + std::to_string(frame_count_dropped) + " telemetry frames from sample logging.");
+        }
+    }
+
+    initialized_camera_ = false;
+
+    file_logging_camera_.close();
+
+    if (writer_logging_data_.isOpen())
+    {
+        writer_logging_data_.close();
+
+        if (writer_logging_data_.failed() && window_)
+        {
+            window_->logToStatusBar("Failed to write file for data logging.");
+        }
+    }
+
+    if (writer_logging_sample_.isOpen())
+    {
+        writer_logging_sample_.close();
+
+        if (writer_logging_sample_.failed() && window_)
+        {
+            window_->logToStatusBar("Failed to write file for sample logging.");
+        }
+    }
+
+    if (writer_logging_camera_.isOpen())
+    {
+        writer_logging_camera_.close();
+
+        if (writer_logging_camera_.failed() && window_)
+        {
+            window_->logToStatusBar("Failed to write file for camera frame logging.");
+        }
+    }
+}
+
+void
+LoggingDaemon::onCameraDaemonFrameDataReceived(const QByteArray& frame, const CameraFrameStatistics& statistics)
+{
+    if (!started_ || !writer_logging_camera_.isOpen())
+    {
+        return;
+    }
+
+    const uint64_t offset_frame = writer_logging_camera_.write(frame.constData(), frame.size(), statistics.frame_id, statistics.timestamp);
+
+    if (offset_frame > 0)
+    {
+        offset_frame_ = offset_frame;
+    }
+}
+
+void
+LoggingDaemon::onCameraDaemonFrameStatisticsUpdated(const CameraFrameStatistics& statistics)
+{
+    if (!started_ || !file_logging_camera_.is_open())
+    {
+        return;
+    }
+
+    if (!initialized_camera_)
+    {
+        file_logging_camera_ << "#" << "\t"
+                             << "frame_id" << "\t"
+                             << "timestamp" << "\t"
+                             << "frame_size" << "\t"
+                             << "chunk_count" << "\t"
+                             << "chunk_count_received" << "\t"
+                             << "chunk_count_lost" << "\t"
+                             << "chunk_count_duplicate" << "\t"
+                             << "complete" << std::endl;
+
+        initialized_camera_ = true;
+    }
+
+    file_logging_camera_ << statistics.frame_id << "\t"
+                         << statistics.timestamp << "\t"
+                         << statistics.frame_size << "\t"
+                         << statistics.chunk_count << "\t"
+                         << statistics.chunk_count_received << "\t"
+                         << statistics.chunk_count - statistics.chunk_count_received << "\t"
+                         << statistics.chunk_count_duplicate << "\t"
+                         << statistics.complete << "\n";
+}
+
+void
+LoggingDaemon::onInboundDaemonFramePublished()
+{
+    if (!consumer_frame_subscribed_ || !daemon_inbound_)
+    {
+        return;
+    }
+
+    biped::firmware::TelemetryFrame frame;
+
+    while (daemon_inbound_->getTelemetryFrameBus().read(consumer_frame_, frame))
+    {
+        writeFrame(frame);
+    }
+
+    flush();
+}
+
+void
+LoggingDaemon::onInboundDaemonMessagePublished()
+{
+    if (!consumer_subscribed_ || !daemon_inbound_)
+    {
+        return;
+    }
+
+    biped::firmware::BipedMessage message;
+
+    while (daemon_inbound_->getTelemetryBus().read(consumer_, message))
+    {
+        writeMessage(message);
+    }
+
+    flush();
+}
+
+void
+LoggingDaemon::flush()
+{
+    const std::chrono::steady_clock::time_point time_point = std::chrono::steady_clock::now();
+
+    if (!started_ || std::chrono::duration_cast<std::chrono::milliseconds>(time_point - time_point_flush_).count() < LoggingDaemonParameter::period_flush_logging_data)
+    {
+        return;
+    }
+
+    /*
+     *  Hand the partially filled blocks to the I/O threads, such that the logs on disk lag by at most a flush period
+     *  rather than a full block.
+     */
+    writer_logging_data_.flush();
+    writer_logging_sample_.flush();
+    time_point_flush_ = time_point;
 }
 
 void
-LoggingDaemon::onCameraDaemonFrameReceived(const QImage& frame)
+LoggingDaemon::writeFrame(const biped::firmware::TelemetryFrame& frame)
 {
-    if (!started_ || !initialized_)
+    if (!started_ || !writer_logging_sample_.isOpen())
     {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_frame_);
-    frame_ = frame;
-    frame_count_ ++;
+    for (uint32_t i = 0; i < frame.sample_count && i < frame.capacity; i ++)
+    {
+        const TelemetrySampleLogRecord record(frame, i);
+
+        writer_logging_sample_.write(&record);
+    }
 }
 
 void
-LoggingDaemon::onInboundDaemonMessageReceived(const biped::firmware::BipedMessage& message)
+LoggingDaemon::writeMessage(const biped::firmware::BipedMessage& message)
 {
-    if (!started_ || !file_logging_data_.is_open())
+    if (!started_ || !writer_logging_data_.isOpen())
     {
         return;
     }
 
-    if (!initialized_)
-    {
-        file_logging_data_ << "#" << "\t"
-                           << "sequence" << "\t"
-                           << "timestamp" << "\t"
-                           << "camera_frame" << "\t"
-                           << "actuation_command.motor_enable" << "\t"
-                           << "actuation_command.motor_left_forward" << "\t"
-                           << "actuation_command.motor_right_forward" << "\t"
-                           << "actuation_command.motor_left_pwm" << "\t"
-                           << "actuation_command.motor_right_pwm" << "\t"
-                           << "controller_reference.attitude_y" << "\t"
-                           << "controller_reference.attitude_z" << "\t"
-                           << "controller_reference.position_x" << "\t"
-                           << "encoder_data.position_x" << "\t"
-                           << "encoder_data.steps" << "\t"
-                           << "encoder_data.steps_left" << "\t"
-                           << "encoder_data.steps_right" << "\t"
-                           << "encoder_data.velocity_x" << "\t"
-                           << "imu_data.acceleration_x" << "\t"
-                           << "imu_data.acceleration_y" << "\t"
-                           << "imu_data.acceleration_z" << "\t"
-                           << "imu_data.attitude_x" << "\t"
-                           << "imu_data.attitude_y" << "\t"
-                           << "imu_data.attitude_z" << "\t"
-                           << "imu_data.angular_velocity_x" << "\t"
-                           << "imu_data.angular_velocity_y" << "\t"
-                           << "imu_data.angular_velocity_z" << "\t"
-                           << "imu_data.compass_x" << "\t"
-                           << "imu_data.compass_y" << "\t"
-                           << "imu_data.compass_z" << "\t"
-                           << "imu_data.temperature" << "\t"
-                           << "time_of_flight_data.range_left" << "\t"
-                           << "time_of_flight_data.range_middle" << "\t"
-                           << "time_of_flight_data.range_right" << std::endl;
-
-        initialized_ = true;
-    }
-
-    std::unique_lock<std::mutex> lock(mutex_frame_);
-    QImage frame = frame_;
-    unsigned long long frame_count = frame_count_;
-    lock.unlock();
-
-    const std::string file_name_logging_camera = std::to_string(frame_count) + LoggingDaemonParameter::file_extension_logging_camera;
-    frame.save(QString::fromStdString(path_logging_camera_ / file_name_logging_camera));
-
-    file_logging_data_ << message.sequence << "\t"
-                       << message.timestamp << "\t"
-                       << file_name_logging_camera << "\t"
-                       << message.actuation_command.motor_enable << "\t"
-                       << message.actuation_command.motor_left_forward << "\t"
-                       << message.actuation_command.motor_right_forward << "\t"
-                       << message.actuation_command.motor_left_pwm << "\t"
-                       << message.actuation_command.motor_right_pwm << "\t"
-                       << message.controller_reference.attitude_y << "\t"
-                       << message.controller_reference.attitude_z << "\t"
-                       << message.controller_reference.position_x << "\t"
-                       << message.encoder_data.position_x << "\t"
-                       << message.encoder_data.steps << "\t"
-                       << message.encoder_data.steps_left << "\t"
-                       << message.encoder_data.steps_right << "\t"
-                       << message.encoder_data.velocity_x << "\t"
-                       << message.imu_data.acceleration_x << "\t"
-                       << message.imu_data.acceleration_y << "\t"
-                       << message.imu_data.acceleration_z << "\t"
-                       << message.imu_data.attitude_x << "\t"
-                       << message.imu_data.attitude_y << "\t"
-                       << message.imu_data.attitude_z << "\t"
-                       << message.imu_data.angular_velocity_x << "\t"
-                       << message.imu_data.angular_velocity_y << "\t"
-                       << message.imu_data.angular_velocity_z << "\t"
-                       << message.imu_data.compass_x << "\t"
-                       << message.imu_data.compass_y << "\t"
-                       << message.imu_data.compass_z << "\t"
-                       << message.imu_data.temperature << "\t"
-                       << message.time_of_flight_data.range_left << "\t"
-                       << message.time_of_flight_data.range_middle << "\t"
-                       << message.time_of_flight_data.range_right << std::endl;
+    BipedMessageLogRecord record;
+
+    record.camera_frame = offset_frame_;
+    record.message = message;
+
+    writer_logging_data_.write(&record);
 }
 }
 }
@@ -1,13 +1,17 @@
 #ifndef LOGGING_DAEMON_H
 #define LOGGING_DAEMON_H
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
-#include <mutex>
-#include <QImage>
+#include <QByteArray>
 #include <QObject>
 #include <filesystem> // filesystem must be included after Qt includes due to a bug in MOC: https://bugreports.qt.io/browse/QTBUG-73263
 
 #include "common/type.h"
+#include "daemon/camera_daemon.h"
+#include "utility/binary_log.h"
+#include "utility/camera_log.h"
 
 namespace biped
 {
@@ -32,21 +36,42 @@ public:
 public slots:
 
     void
-    onCameraDaemonFrameReceived(const QImage& frame);
+    onCameraDaemonFrameDataReceived(const QByteArray& frame, const CameraFrameStatistics& statistics);
 
     void
-    onInboundDaemonMessageReceived(const biped::firmware::BipedMessage& message);
+    onCameraDaemonFrameStatisticsUpdated(const CameraFrameStatistics& statistics);
+
+    void
+    onInboundDaemonFramePublished();
+
+    void
+    onInboundDaemonMessagePublished();
 
 private:
 
-    std::fstream file_logging_data_;
-    QImage frame_;
-    unsigned long long frame_count_;
-    bool initialized_;
-    std::mutex mutex_frame_;
-    std::filesystem::path path_logging_camera_;
-    bool started_;
+    void
+    flush();
+
+    void
+    writeFrame(const biped::firmware::TelemetryFrame& frame);
+
+    void
+    writeMessage(const biped::firmware::BipedMessage& message);
+
+    size_t consumer_;
+    size_t consumer_frame_;
+    bool consumer_frame_subscribed_;
+    bool consumer_subscribed_;
+
+    std::fstream file_logging_camera_;
+    bool initialized_camera_;
+    uint64_t offset_frame_;
+    std::atomic<bool> started_;
+    std::chrono::steady_clock::time_point time_point_flush_;
     std::string time_start_;
+    CameraLogWriter writer_logging_camera_;
+    BinaryLogWriter writer_logging_data_;
+    BinaryLogWriter writer_logging_sample_;
 };
 }
 }
@@ -1,3 +1,6 @@
+#include <QTimer>
+#include <random>
+
 #include "common/global.h"
 #include "daemon/outbound_daemon.h"
 #include "common/parameter.h"
@@ -8,12 +11,114 @@ namespace biped
 {
 namespace ground_station
 {
-OutboundDaemon::OutboundDaemon(QObject *parent) : QObject(parent)
+OutboundDaemon::OutboundDaemon(QObject *parent) : QObject(parent), sequence_(0), session_(0), timer_retransmission_(new QTimer(this))
 {
+    std::random_device random_device;
+
+    while (session_ == 0)
+    {
+        session_ = random_device();
+    }
+
+    connect(timer_retransmission_, &QTimer::timeout, this, &OutboundDaemon::onTimerRetransmissionTimeout);
 }
 
 void
-OutboundDaemon::operate(const biped::firmware::BipedMessage& message)
+OutboundDaemon::onInboundDaemonAcknowledgementReceived(const biped::firmware::CommandAcknowledgement& acknowledgement)
+{
+    if (commands_pending_.empty())
+    {
+        return;
+    }
+
+    if (acknowledgement.session != session_)
+    {
+        if (commands_pending_.front().sequence == 1)
+        {
+            return;
+        }
+
+        std::random_device random_device;
+        uint32_t session = 0;
+
+        while (session == 0 || session == session_)
+        {
+            session = random_device();
+        }
+
+        session_ = session;
+        sequence_ = 0;
+
+        for (auto& command : commands_pending_)
+        {
+            command.session = session_;
+            command.sequence = ++ sequence_;
+        }
+
+        if (window_)
+        {
+            window_->logToStatusBar("Restarted command session with Biped at \"" + ip_biped_ + "\".");
+        }
+
+        onTimerRetransmissionTimeout();
+        return;
+    }
+
+    while (!commands_pending_.empty() && commands_pending_.front().sequence <= acknowledgement.sequence)
+    {
+        commands_pending_.pop_front();
+    }
+
+    if (commands_pending_.empty())
+    {
+        timer_retransmission_->stop();
+
+        if (window_)
+        {
+            window_->logToStatusBar("Biped at \"" + ip_biped_ + "\" acknowledged all commands.");
+        }
+    }
+}
+
+void
+OutboundDaemon::operate(const biped::firmware::CommandMessage& message)
+{
+    biped::firmware::CommandMessage command = message;
+
+    command.session = session_;
+    command.sequence = ++ sequence_;
+    commands_pending_.push_back(command);
+
+    if (write(command) && window_)
+    {
+        window_->logToStatusBar("Sent command to Biped at \"" + ip_biped_ + "\".");
+    }
+
+    if (!timer_retransmission_->isActive())
+    {
+        timer_retransmission_->start(NetworkParameter::retransmission_period_command);
+    }
+}
+
+void
+OutboundDaemon::operateCameraFeedback(const biped::firmware::CameraFeedbackMessage& message)
+{
+    if (!udp_biped_message_ || !udp_biped_message_->bound())
+    {
+        return;
+    }
+
+    std::vector<unsigned char> message_serialized;
+    zpp::serializer::memory_output_archive serializer(message_serialized);
+
+    if (serializer(message))
+    {
+        udp_biped_message_->write(ip_biped_, NetworkParameter::port_udp_biped_message, std::string(message_serialized.begin(), message_serialized.end()));
+    }
+}
+
+void
+OutboundDaemon::operateSubscription(const biped::firmware::SubscriptionMessage& message)
 {
     if (!udp_biped_message_ || !udp_biped_message_->bound())
     {
@@ -31,16 +136,53 @@ OutboundDaemon::operate(const biped::firmware::BipedMessage& message)
 
         if (window_)
         {
-            window_->logToStatusBar("Sent Biped message to Biped at \"" + ip_biped_ + "\".");
+            window_->logToStatusBar("Sent subscription message to Biped at \"" + ip_biped_ + "\".");
         }
     }
     else
     {
         if (window_)
         {
-            window_->logToStatusBar("Failed to serialize Biped message.");
+            window_->logToStatusBar("Failed to serialize subscription message.");
+        }
+    }
+}
+
+void
+OutboundDaemon::onTimerRetransmissionTimeout()
+{
+    for (const auto& command : commands_pending_)
+    {
+        write(command);
+    }
+}
+
+bool
+OutboundDaemon::write(const biped::firmware::CommandMessage& message)
+{
+    if (!udp_biped_message_ || !udp_biped_message_->bound())
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> message_serialized;
+    zpp::serializer::memory_output_archive serializer(message_serialized);
+
+    const auto result = serializer(message);
+
+    if (!result)
+    {
+        if (window_)
+        {
+            window_->logToStatusBar("Failed to serialize command message.");
         }
+
+        return false;
     }
+
+    udp_biped_message_->write(ip_biped_, NetworkParameter::port_udp_biped_message, std::string(message_serialized.begin(), message_serialized.end()));
+
+    return true;
 }
 }
 }
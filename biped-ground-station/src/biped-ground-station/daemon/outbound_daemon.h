@@ -1,10 +1,13 @@
 #ifndef OUTBOUND_DAEMON_H
 #define OUTBOUND_DAEMON_H
 
+#include <deque>
 #include <QObject>
 
 #include "common/type.h"
 
+class QTimer;
+
 namespace biped
 {
 namespace ground_station
@@ -20,7 +23,31 @@ public:
 public slots:
 
     void
-    operate(const biped::firmware::BipedMessage& message);
+    onInboundDaemonAcknowledgementReceived(const biped::firmware::CommandAcknowledgement& acknowledgement);
+
+    void
+    operate(const biped::firmware::CommandMessage& message);
+
+    void
+    operateCameraFeedback(const biped::firmware::CameraFeedbackMessage& message);
+
+    void
+    operateSubscription(const biped::firmware::SubscriptionMessage& message);
+
+private slots:
+
+    void
+    onTimerRetransmissionTimeout();
+
+private:
+
+    bool
+    write(const biped::firmware::CommandMessage& message);
+
+    std::deque<biped::firmware::CommandMessage> commands_pending_;
+    uint32_t sequence_;
+    uint32_t session_;
+    QTimer* timer_retransmission_;
 };
 }
 }
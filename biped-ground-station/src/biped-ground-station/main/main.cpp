@@ -1,3 +1,5 @@
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <QApplication>
 
@@ -10,6 +12,8 @@
 #include "common/parameter.h"
 #include "common/type.h"
 #include "network/udp.h"
+#include "utility/binary_log.h"
+#include "utility/camera_log.h"
 #include "ui/window.h"
 
 using namespace biped::ground_station;
@@ -17,6 +21,63 @@ using namespace biped::ground_station;
 int
 main(int argc, char *argv[])
 {
+    /*
+     *  Convert a binary data log into tab-separated, or, for a .csv output file, comma-separated values, without
+     *  starting the user interface.
+     */
+    if (argc == 4 && std::string(argv[1]) == "--convert")
+    {
+        const std::filesystem::path path_output = argv[3];
+        std::ofstream file_output(path_output, std::ofstream::out | std::ofstream::trunc);
+
+        if (!file_output.is_open() || !convertBinaryLog(argv[2], file_output, path_output.extension() == ".csv" ? ',' : '\t'))
+        {
+            std::cerr << "Failed to convert " << argv[2] << " to " << argv[3] << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    /*
+     *  Extract the JPG camera frames of a camera log, named by their offsets in the camera log, the same as the
+     *  camera_frame column of the data log.
+     */
+    if (argc == 4 && std::string(argv[1]) == "--extract")
+    {
+        CameraLogReader reader;
+        std::vector<unsigned char> frame;
+        std::error_code error;
+
+        if (!reader.open(argv[2]))
+        {
+            std::cerr << "Failed to open " << argv[2] << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::filesystem::create_directories(argv[3], error);
+
+        if (error)
+        {
+            std::cerr << "Failed to create " << argv[3] << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        for (size_t i = 0; i < reader.getFrames().size(); i ++)
+        {
+            const std::string file_name_frame = std::to_string(reader.getFrames()[i].offset) + ".jpg";
+            std::ofstream file_frame(std::filesystem::path(argv[3]) / file_name_frame, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+            if (!reader.readFrame(i, frame) || !file_frame.write(reinterpret_cast<const char*>(frame.data()), frame.size()))
+            {
+                std::cerr << "Failed to extract camera frame " << i << " of " << argv[2] << "." << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        return EXIT_SUCCESS;
+    }
+
     QApplication application(argc, argv);
 
     daemon_camera_ = std::make_shared<CameraDaemon>();
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 #include "common/parameter.h"
 #include "network/udp.h"
 
@@ -5,12 +9,12 @@ namespace biped
 {
 namespace ground_station
 {
-UDP::UDP(const std::string& ip_local, const uint16_t& port) : bound_(true), socket_(thread_pool_)
+UDP::UDP(const std::string& ip_local, const uint16_t& port) : bound_(true), count_ring_(0), datagram_count_dropped_(0), datagram_count_received_(0), datagrams_(NetworkParameter::ring_size_receive + 1), head_ring_(0), port_read_(0), port_write_(0), socket_(io_context_)
 {
     open(boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string(ip_local), port));
 }
 
-UDP::UDP(const uint16_t& port) : bound_(true), socket_(thread_pool_)
+UDP::UDP(const uint16_t& port) : bound_(true), count_ring_(0), datagram_count_dropped_(0), datagram_count_received_(0), datagrams_(NetworkParameter::ring_size_receive + 1), head_ring_(0), port_read_(0), port_write_(0), socket_(io_context_)
 {
     open(boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port));
 }
@@ -29,10 +33,37 @@ UDP::bound()
 void
 UDP::close()
 {
+    std::unique_lock<std::mutex> lock(mutex_ring_);
     bound_ = false;
+    lock.unlock();
+
+    condition_ring_.notify_all();
+
+    if (thread_.joinable())
+    {
+        boost::asio::post(io_context_, [this]()
+        {
+            boost::system::error_code error;
+            socket_.close(error);
+        });
+
+        thread_.join();
+    }
+
+    boost::system::error_code error;
+    socket_.close(error);
+}
+
+unsigned long
+UDP::getDatagramCountDropped()
+{
+    return datagram_count_dropped_;
+}
 
-    thread_pool_.join();
-    socket_.close();
+unsigned long
+UDP::getDatagramCountReceived()
+{
+    return datagram_count_received_;
 }
 
 void
@@ -47,58 +78,72 @@ UDP::open(boost::asio::ip::udp::endpoint endpoint_local)
     catch (const std::exception exception)
     {
         bound_ = false;
+        return;
     }
+
+    boost::system::error_code error;
+    socket_.set_option(boost::asio::socket_base::receive_buffer_size(NetworkParameter::buffer_size_socket_receive), error);
+    socket_.non_blocking(true, error);
+
+    receive();
+
+    thread_ = std::thread([this]()
+    {
+        io_context_.run();
+    });
 }
 
 std::string
 UDP::read(const std::string& ip_remote, const uint16_t& port, const size_t& size)
 {
-    std::shared_ptr<std::vector<char>> buffer = readBuffer(ip_remote, port, size);
+    std::string data(size, '\0');
 
-    if (buffer)
-    {
-        return std::string(buffer->begin(), buffer->end());
-    }
-    else
-    {
-        return "";
-    }
+    data.resize(readBuffer(ip_remote, port, &data[0], data.size()));
+
+    return data;
 }
 
-std::shared_ptr<std::vector<char>>
-UDP::readBuffer(const std::string& ip_remote, const uint16_t& port, const size_t& size)
+size_t
+UDP::readBuffer(const std::string& ip_remote, const uint16_t& port, char* buffer, const size_t& size)
 {
-    if (!bound())
+    if (!bound() || !buffer)
     {
-        return nullptr;
+        return 0;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_read_);
+    std::lock_guard<std::mutex> lock_read(mutex_read_);
 
-    std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>(size, '0');
-    boost::asio::ip::udp::endpoint endpoint_remote;
+    const boost::asio::ip::udp::endpoint& endpoint_remote = getEndpoint(ip_remote, port, ip_read_, port_read_, endpoint_read_);
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(NetworkParameter::timeout);
+    std::unique_lock<std::mutex> lock_ring(mutex_ring_);
 
-    std::future future = socket_.async_receive_from(boost::asio::buffer(*buffer), endpoint_remote, boost::asio::use_future);
-
-    switch (future.wait_for(std::chrono::milliseconds(NetworkParameter::timeout)))
-    {
-    case std::future_status::ready:
-    {
-        break;
-    }
-    default:
+    for (;;)
     {
-        socket_.cancel();
-        return nullptr;
-    }
-    }
+        if (!condition_ring_.wait_until(lock_ring, deadline, [this]()
+        {
+            return !bound_ || count_ring_ > 0;
+        }) || !bound_)
+        {
+            return 0;
+        }
 
-    if (endpoint_remote.address().to_string() != ip_remote || endpoint_remote.port() != port)
-    {
-        return nullptr;
-    }
+        const Datagram& datagram = datagrams_[head_ring_];
+        const bool matched = datagram.endpoint_remote == endpoint_remote;
+        const size_t bytes = std::min(datagram.size, size);
+
+        if (matched)
+        {
+            std::memcpy(buffer, datagram.data.data(), bytes);
+        }
 
-    return buffer;
+        head_ring_ = (head_ring_ + 1) % datagrams_.size();
+        count_ring_ --;
+
+        if (matched)
+        {
+            return bytes;
+        }
+    }
 }
 
 size_t
@@ -110,20 +155,113 @@ UDP::write(const std::string& ip_remote, const uint16_t& port, const std::string
 size_t
 UDP::writeBuffer(const std::string& ip_remote, const uint16_t& port, const uint8_t* buffer, const size_t& size)
 {
-    size_t bytes = 0;
-
     if (!bound())
     {
-        return bytes;
+        return 0;
     }
 
     std::lock_guard<std::mutex> lock(mutex_write_);
 
-    boost::asio::ip::udp::endpoint endpoint_remote(boost::asio::ip::address::from_string(ip_remote), port);
+    boost::system::error_code error;
+    const size_t bytes = socket_.send_to(boost::asio::buffer(buffer, size), getEndpoint(ip_remote, port, ip_write_, port_write_, endpoint_write_), 0, error);
+
+    return error ? 0 : bytes;
+}
+
+void
+UDP::commit(const size_t& count)
+{
+    std::unique_lock<std::mutex> lock(mutex_ring_);
+
+    count_ring_ += count;
+    datagram_count_received_ += count;
+
+    /*
+     *  Always leave one slot free for the next receive, dropping the oldest datagram.
+     */
+    if (count_ring_ >= datagrams_.size())
+    {
+        head_ring_ = (head_ring_ + 1) % datagrams_.size();
+        count_ring_ --;
+        datagram_count_dropped_ ++;
+    }
+
+    lock.unlock();
+
+    condition_ring_.notify_all();
+}
+
+void
+UDP::drain(const size_t& slot_first)
+{
+    std::unique_lock<std::mutex> lock(mutex_ring_);
+    const size_t slot_count = std::min(NetworkParameter::batch_size_receive, datagrams_.size() - count_ring_);
+    lock.unlock();
+
+    size_t count = 1;
+
+    /*
+     *  Drain whatever else is already queued on the socket into the following free slots without
+     *  blocking, such that a burst of datagrams costs one wakeup and one commit.
+     */
+    while (count < slot_count)
+    {
+        Datagram& datagram = datagrams_[(slot_first + count) % datagrams_.size()];
+        boost::system::error_code error;
+
+        datagram.size = socket_.receive_from(boost::asio::buffer(datagram.data), datagram.endpoint_remote, 0, error);
+
+        if (error)
+        {
+            break;
+        }
+
+        count ++;
+    }
+
+    commit(count);
+}
+
+const boost::asio::ip::udp::endpoint&
+UDP::getEndpoint(const std::string& ip_remote, const uint16_t& port, std::string& ip_cached, uint16_t& port_cached, boost::asio::ip::udp::endpoint& endpoint_cached)
+{
+    if (ip_remote != ip_cached || port != port_cached)
+    {
+        boost::system::error_code error;
+        const boost::asio::ip::address address = boost::asio::ip::make_address(ip_remote, error);
+
+        endpoint_cached = error ? boost::asio::ip::udp::endpoint() : boost::asio::ip::udp::endpoint(address, port);
+        ip_cached = ip_remote;
+        port_cached = port;
+    }
+
+    return endpoint_cached;
+}
+
+void
+UDP::receive()
+{
+    std::unique_lock<std::mutex> lock(mutex_ring_);
+    const size_t slot = (head_ring_ + count_ring_) % datagrams_.size();
+    lock.unlock();
+
+    Datagram& datagram = datagrams_[slot];
+
+    socket_.async_receive_from(boost::asio::buffer(datagram.data), datagram.endpoint_remote, [this, slot](const boost::system::error_code& error, size_t bytes)
+    {
+        if (error == boost::asio::error::operation_aborted || !socket_.is_open())
+        {
+            return;
+        }
 
-    bytes = socket_.send_to(boost::asio::buffer(buffer, size), endpoint_remote);
+        if (!error)
+        {
+            datagrams_[slot].size = bytes;
+            drain(slot);
+        }
 
-    return bytes;
+        receive();
+    });
 }
 }
 }
@@ -1,9 +1,16 @@
 #ifndef UDP_H
 #define UDP_H
 
+#include <array>
+#include <atomic>
 #include <boost/asio.hpp>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/parameter.h"
 
 namespace biped
 {
@@ -25,14 +32,20 @@ public:
     void
     close();
 
+    unsigned long
+    getDatagramCountDropped();
+
+    unsigned long
+    getDatagramCountReceived();
+
     void
     open(boost::asio::ip::udp::endpoint endpoint_local);
 
     std::string
     read(const std::string& ip_remote, const uint16_t& port, const size_t& size);
 
-    std::shared_ptr<std::vector<char>>
-    readBuffer(const std::string& ip_remote, const uint16_t& port, const size_t& size);
+    size_t
+    readBuffer(const std::string& ip_remote, const uint16_t& port, char* buffer, const size_t& size);
 
     size_t
     write(const std::string& ip_remote, const uint16_t& port, const std::string& data);
@@ -42,11 +55,48 @@ public:
 
 private:
 
-    bool bound_;
+    struct Datagram
+    {
+        std::array<char, NetworkParameter::buffer_size_datagram> data;
+        boost::asio::ip::udp::endpoint endpoint_remote;
+        size_t size;
+
+        Datagram() : size(0)
+        {
+        }
+    };
+
+    void
+    commit(const size_t& count);
+
+    void
+    drain(const size_t& slot_first);
+
+    const boost::asio::ip::udp::endpoint&
+    getEndpoint(const std::string& ip_remote, const uint16_t& port, std::string& ip_cached, uint16_t& port_cached, boost::asio::ip::udp::endpoint& endpoint_cached);
+
+    void
+    receive();
+
+    std::atomic<bool> bound_;
+    std::condition_variable condition_ring_;
+    size_t count_ring_;
+    std::atomic<unsigned long> datagram_count_dropped_;
+    std::atomic<unsigned long> datagram_count_received_;
+    std::vector<Datagram> datagrams_;
+    boost::asio::ip::udp::endpoint endpoint_read_;
+    boost::asio::ip::udp::endpoint endpoint_write_;
+    size_t head_ring_;
+    boost::asio::io_context io_context_;
+    std::string ip_read_;
+    std::string ip_write_;
     std::mutex mutex_read_;
+    std::mutex mutex_ring_;
     std::mutex mutex_write_;
-    boost::asio::thread_pool thread_pool_;
+    uint16_t port_read_;
+    uint16_t port_write_;
     boost::asio::ip::udp::socket socket_;
+    std::thread thread_;
 };
 }
 }
@@ -0,0 +1,572 @@
+/**
+ *  @file   binary_log.cpp
+ *  @author Simon Yu
+ *  @date   02/08/2022
+ *  @brief  Ground station binary log harness source.
+ *
+ *  This file implements the Biped ground station binary log harness.
+ *  The harness logs a stream of synthetic Biped messages, as fast as
+ *  the logger takes them, the same way as the Biped ground station
+ *  logging daemon did before, i.e., formatting every column as text
+ *  and ending every line with std::endl, which flushes the file on
+ *  every Biped message, and then through the binary log writer, both
+ *  uncompressed and, if available, LZ4 compressed.
+ *
+ *  For each, the harness reports the time per Biped message on the
+ *  logging thread, the CPU time per Biped message across all threads,
+ *  including the I/O thread of the binary log writer, the size of the
+ *  data log, and the sustained data log throughput, in MB/s and in
+ *  Biped messages per second. It verifies that each binary data log,
+ *  converted back into tab-separated values, is identical to the text
+ *  data log.
+ *
+ *  It then logs synthetic telemetry frames into a sample log, flushing
+ *  the partially filled blocks the same way as the logging daemon, and
+ *  verifies that every sample reaches the file before the sample log is
+ *  closed, with the fields left out by the telemetry subscription as
+ *  NaN.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-binary-log [messages]
+ */
+
+/*
+ *  External headers.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "test/cpu_time.h"
+#include "utility/binary_log.h"
+#include "utility/biped_message_log.h"
+#include "utility/telemetry_sample_log.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped;
+using namespace biped::ground_station;
+
+/*
+ *  Number of distinct synthetic Biped messages, cycled through.
+ */
+static constexpr size_t record_pool_size = 4096;
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    unsigned long long byte_count = 0;  //!< Data log size, in bytes.
+    double cpu_time = 0;    //!< CPU time of the process, in seconds.
+    double cpu_time_logging = 0;    //!< CPU time of the logging thread, in seconds.
+    bool failed = false;    //!< Whether writing the data log failed.
+    double time = 0;    //!< Time from the first Biped message to the data log being closed, in seconds.
+};
+
+/**
+ *  @return Synthetic data log records.
+ *  @brief  Build a pool of synthetic data log records.
+ *
+ *  The records vary smoothly, the same way as the sensor data of a
+ *  balancing Biped, with counters and settings that rarely change.
+ */
+static std::vector<BipedMessageLogRecord>
+buildRecords()
+{
+    std::vector<BipedMessageLogRecord> records(record_pool_size);
+
+    for (size_t i = 0; i < records.size(); i ++)
+    {
+        firmware::BipedMessage& message = records[i].message;
+        const double phase = 0.01 * i;
+
+        records[i].camera_frame = i / 50;
+        message.actuation_command.motor_enable = true;
+        message.actuation_command.motor_left_forward = std::sin(phase) > 0;
+        message.actuation_command.motor_right_forward = std::sin(phase) > 0;
+        message.actuation_command.motor_left_pwm = std::round(255 * std::abs(std::sin(phase)));
+        message.actuation_command.motor_right_pwm = std::round(255 * std::abs(std::sin(phase + 0.1)));
+        message.controller_reference.attitude_y = 0;
+        message.controller_reference.attitude_z = 0.5 * std::sin(0.1 * phase);
+        message.controller_reference.position_x = 0.2 * std::floor(0.01 * i);
+        message.encoder_data.position_x = 0.1 * std::sin(0.5 * phase);
+        message.encoder_data.steps = std::round(1000 * std::sin(0.5 * phase));
+        message.encoder_data.steps_left = message.encoder_data.steps + i % 3;
+        message.encoder_data.steps_right = message.encoder_data.steps - i % 2;
+        message.encoder_data.transition_errors_left = i / 1000;
+        message.encoder_data.transition_errors_right = 0;
+        message.encoder_data.velocity_x = 0.05 * std::cos(0.5 * phase);
+        message.imu_data.acceleration_x = 0.3 * std::sin(3 * phase);
+        message.imu_data.acceleration_y = 0.01 * std::cos(7 * phase);
+        message.imu_data.acceleration_z = 9.81 + 0.2 * std::sin(5 * phase);
+        message.imu_data.attitude_x = 0.01 * std::sin(2 * phase);
+        message.imu_data.attitude_y = 0.05 * std::sin(phase);
+        message.imu_data.attitude_z = 0.5 * std::sin(0.1 * phase);
+        message.imu_data.angular_velocity_x = 0.02 * std::cos(2 * phase);
+        message.imu_data.angular_velocity_y = 0.05 * std::cos(phase);
+        message.imu_data.angular_velocity_z = 0.05 * std::cos(0.1 * phase);
+        message.imu_data.angular_velocity_bias_x = 0.001;
+        message.imu_data.angular_velocity_bias_y = -0.002;
+        message.imu_data.angular_velocity_bias_z = 0.0005;
+        message.imu_data.compass_x = 20 + std::sin(0.1 * phase);
+        message.imu_data.compass_y = -5 + std::cos(0.1 * phase);
+        message.imu_data.compass_z = 40;
+        message.imu_data.temperature = 30 + 0.001 * i;
+        message.time_of_flight_data.range_left = 0.5 + 0.1 * std::sin(0.2 * phase);
+        message.time_of_flight_data.range_middle = 0.8 + 0.1 * std::sin(0.3 * phase);
+        message.time_of_flight_data.range_right = 0.5 + 0.1 * std::cos(0.2 * phase);
+        message.telemetry.deadline_miss = i / 2000;
+        message.telemetry.interval.percentile_50 = 5000;
+        message.telemetry.interval.percentile_99 = 5000 + i % 7;
+        message.telemetry.interval.maximum = 5100 + i % 13;
+        message.telemetry.execution_time.percentile_50 = 800 + i % 5;
+        message.telemetry.execution_time.percentile_99 = 950 + i % 11;
+        message.telemetry.execution_time.maximum = 1200 + i % 17;
+        message.telemetry.camera.frame_count = i / 50;
+        message.telemetry.camera.setting.frame_size = firmware::CameraFrameSize::qvga;
+        message.telemetry.camera.setting.jpeg_quality = 12;
+        message.telemetry.camera.setting.frame_rate = 20;
+    }
+
+    return records;
+}
+
+/**
+ *  @param  file_logging_data Data log file.
+ *  @param  record Data log record.
+ *  @brief  Write a data log record the previous way.
+ *
+ *  This function formats a data log record the same way as the
+ *  logging daemon did before, writing the number of the camera frame
+ *  instead of its file name.
+ */
+static void
+writeLegacy(std::ostream& file_logging_data, const BipedMessageLogRecord& record)
+{
+    const firmware::BipedMessage& message = record.message;
+
+    file_logging_data << message.sequence << "\t"
+            << message.timestamp << "\t"
+            << record.camera_frame << "\t"
+            << message.actuation_command.motor_enable << "\t"
+            << message.actuation_command.motor_left_forward << "\t"
+            << message.actuation_command.motor_right_forward << "\t"
+            << message.actuation_command.motor_left_pwm << "\t"
+            << message.actuation_command.motor_right_pwm << "\t"
+            << message.controller_reference.attitude_y << "\t"
+            << message.controller_reference.attitude_z << "\t"
+            << message.controller_reference.position_x << "\t"
+            << message.encoder_data.position_x << "\t"
+            << message.encoder_data.steps << "\t"
+            << message.encoder_data.steps_left << "\t"
+            << message.encoder_data.steps_right << "\t"
+            << message.encoder_data.transition_errors_left << "\t"
+            << message.encoder_data.transition_errors_right << "\t"
+            << message.encoder_data.velocity_x << "\t"
+            << message.imu_data.acceleration_x << "\t"
+            << message.imu_data.acceleration_y << "\t"
+            << message.imu_data.acceleration_z << "\t"
+            << message.imu_data.attitude_x << "\t"
+            << message.imu_data.attitude_y << "\t"
+            << message.imu_data.attitude_z << "\t"
+            << message.imu_data.angular_velocity_x << "\t"
+            << message.imu_data.angular_velocity_y << "\t"
+            << message.imu_data.angular_velocity_z << "\t"
+            << message.imu_data.angular_velocity_bias_x << "\t"
+            << message.imu_data.angular_velocity_bias_y << "\t"
+            << message.imu_data.angular_velocity_bias_z << "\t"
+            << message.imu_data.compass_x << "\t"
+            << message.imu_data.compass_y << "\t"
+            << message.imu_data.compass_z << "\t"
+            << message.imu_data.temperature << "\t"
+            << message.time_of_flight_data.range_left << "\t"
+            << message.time_of_flight_data.range_middle << "\t"
+            << message.time_of_flight_data.range_right << "\t"
+            << message.telemetry.deadline_miss << "\t"
+            << message.telemetry.interval.percentile_50 << "\t"
+            << message.telemetry.interval.percentile_99 << "\t"
+            << message.telemetry.interval.maximum << "\t"
+            << message.telemetry.execution_time.percentile_50 << "\t"
+            << message.telemetry.execution_time.percentile_99 << "\t"
+            << message.telemetry.execution_time.maximum << "\t"
+            << message.telemetry.execution_time_sense_fast.percentile_50 << "\t"
+            << message.telemetry.execution_time_sense_fast.percentile_99 << "\t"
+            << message.telemetry.execution_time_sense_fast.maximum << "\t"
+            << message.telemetry.execution_time_sense_slow.percentile_50 << "\t"
+            << message.telemetry.execution_time_sense_slow.percentile_99 << "\t"
+            << message.telemetry.execution_time_sense_slow.maximum << "\t"
+            << message.telemetry.execution_time_control.percentile_50 << "\t"
+            << message.telemetry.execution_time_control.percentile_99 << "\t"
+            << message.telemetry.execution_time_control.maximum << "\t"
+            << message.telemetry.execution_time_actuate.percentile_50 << "\t"
+            << message.telemetry.execution_time_actuate.percentile_99 << "\t"
+            << message.telemetry.execution_time_actuate.maximum << "\t"
+            << message.telemetry.camera.frame_count << "\t"
+            << message.telemetry.camera.frame_count_dropped << "\t"
+            << message.telemetry.camera.execution_time_capture.percentile_50 << "\t"
+            << message.telemetry.camera.execution_time_capture.maximum << "\t"
+            << message.telemetry.camera.execution_time_encode.percentile_50 << "\t"
+            << message.telemetry.camera.execution_time_encode.maximum << "\t"
+            << message.telemetry.camera.execution_time_transmit.percentile_50 << "\t"
+            << message.telemetry.camera.execution_time_transmit.maximum << "\t"
+            << message.telemetry.camera.latency.percentile_50 << "\t"
+            << message.telemetry.camera.latency.percentile_99 << "\t"
+            << message.telemetry.camera.latency.maximum << "\t"
+            << message.telemetry.camera.budget << "\t"
+            << static_cast<unsigned>(message.telemetry.camera.setting.frame_size) << "\t"
+            << static_cast<unsigned>(message.telemetry.camera.setting.jpeg_quality) << "\t"
+            << static_cast<unsigned>(message.telemetry.camera.setting.frame_rate) << std::endl;
+}
+
+/**
+ *  @param  path Data log path.
+ *  @param  records Synthetic data log records.
+ *  @param  message_count Number of Biped messages.
+ *  @return Run result struct.
+ *  @brief  Log Biped messages the previous way.
+ */
+static Result
+runLegacy(const std::filesystem::path& path, const std::vector<BipedMessageLogRecord>& records,
+        const unsigned long long& message_count)
+{
+    Result result;
+    const double cpu_time_start = getCPUTime();
+    const double cpu_time_logging_start = getThreadCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    std::fstream file_logging_data(path, std::fstream::out | std::fstream::trunc);
+
+    file_logging_data << "#";
+
+    for (const auto& column : biped_message_log_columns)
+    {
+        file_logging_data << "\t" << column.name;
+    }
+
+    file_logging_data << std::endl;
+
+    for (unsigned long long i = 0; i < message_count; i ++)
+    {
+        BipedMessageLogRecord record = records[i % records.size()];
+
+        record.message.sequence = i;
+        record.message.timestamp = 5000 * i;
+        writeLegacy(file_logging_data, record);
+    }
+
+    result.failed = !file_logging_data;
+    file_logging_data.close();
+
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+    result.cpu_time_logging = getThreadCPUTime() - cpu_time_logging_start;
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.byte_count = std::filesystem::file_size(path);
+
+    return result;
+}
+
+/**
+ *  @param  path Data log path.
+ *  @param  records Synthetic data log records.
+ *  @param  message_count Number of Biped messages.
+ *  @param  compressed Whether to compress the data log.
+ *  @return Run result struct.
+ *  @brief  Log Biped messages through the binary log writer.
+ */
+static Result
+runBinary(const std::filesystem::path& path, const std::vector<BipedMessageLogRecord>& records,
+        const unsigned long long& message_count, const bool& compressed)
+{
+    Result result;
+    BinaryLogWriter writer;
+    const double cpu_time_start = getCPUTime();
+    const double cpu_time_logging_start = getThreadCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    if (!writer.open(path, biped_message_log_columns, LoggingDaemonParameter::block_size_logging_data,
+            compressed))
+    {
+        result.failed = true;
+        return result;
+    }
+
+    for (unsigned long long i = 0; i < message_count; i ++)
+    {
+        BipedMessageLogRecord record = records[i % records.size()];
+
+        record.message.sequence = i;
+        record.message.timestamp = 5000 * i;
+        writer.write(&record);
+    }
+
+    writer.close();
+
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+    result.cpu_time_logging = getThreadCPUTime() - cpu_time_logging_start;
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.byte_count = std::filesystem::file_size(path);
+    result.failed = writer.failed() || writer.getRecordCount() != message_count
+            || writer.getByteCount() != result.byte_count;
+
+    return result;
+}
+
+/**
+ *  @param  path File path.
+ *  @return File content.
+ *  @brief  Read a file.
+ */
+static std::string
+readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ *  @param  path Sample log path.
+ *  @return Whether the sample log holds every sample.
+ *  @brief  Log telemetry frames into a sample log, flushing on the way.
+ *
+ *  The telemetry subscription leaves out one field altogether and logs
+ *  another at every fourth tick only. The sample log is flushed after
+ *  every telemetry frame, and read back before it is closed, such that
+ *  every sample must have reached the file through a flush.
+ */
+static bool
+runSampleLog(const std::filesystem::path& path)
+{
+    constexpr size_t frame_count = 50;
+    constexpr size_t field_divided = static_cast<size_t>(firmware::TelemetryField::position_x);
+    constexpr size_t field_left_out = static_cast<size_t>(firmware::TelemetryField::range_middle);
+    const unsigned long long sample_count = frame_count * firmware::TelemetryFrame::capacity;
+    BinaryLogWriter writer;
+    firmware::TelemetryFrame frame;
+
+    frame.sample_count = frame.capacity;
+    frame.subscription.subscribe(firmware::TelemetryField::position_x, 4);
+    frame.subscription.field_mask &= ~(1ul << field_left_out);
+
+    if (!writer.open(path, telemetry_sample_log_columns, LoggingDaemonParameter::block_size_logging_data,
+            true))
+    {
+        std::cerr << "Sample log: failed to open the sample log." << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < frame_count; i ++)
+    {
+        frame.sequence = i;
+
+        for (size_t j = 0; j < frame.capacity; j ++)
+        {
+            firmware::TelemetrySample& sample = frame.samples[j];
+
+            sample.tick = i * frame.capacity + j;
+            sample.acceleration_x = sample.tick % 100;
+            sample.position_x = 0.001 * sample.tick;
+
+            const TelemetrySampleLogRecord record(frame, j);
+
+            writer.write(&record);
+        }
+
+        writer.flush();
+    }
+
+    /*
+     *  A flush is skipped while the I/O thread is busy, so keep flushing
+     *  until the I/O thread has taken the last partially filled block.
+     */
+    const auto time_point_timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    unsigned long long sample_count_flushed = 0;
+    bool passed = true;
+    BinaryLogReader reader;
+
+    while (std::chrono::steady_clock::now() < time_point_timeout)
+    {
+        writer.flush();
+        sample_count_flushed = 0;
+
+        if (reader.open(path))
+        {
+            while (reader.readChunk())
+            {
+                sample_count_flushed += reader.getRecordCount();
+            }
+        }
+
+        if (sample_count_flushed == sample_count)
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    writer.close();
+
+    if (sample_count_flushed != sample_count)
+    {
+        std::cerr << "Sample log: " << sample_count_flushed << " of " << sample_count
+                << " samples flushed before closing." << std::endl;
+        passed = false;
+    }
+
+    /*
+     *  The columns of the fields follow the tick, sequence, and overflow columns.
+     */
+    unsigned long long tick = 0;
+
+    reader.open(path);
+
+    while (reader.readChunk())
+    {
+        for (size_t i = 0; i < reader.getRecordCount(); i ++, tick ++)
+        {
+            std::ostringstream value_tick;
+            std::ostringstream value_divided;
+            std::ostringstream value_left_out;
+            std::ostringstream value_divided_expected;
+
+            value_divided_expected << (tick % 4 == 0 ? static_cast<double>(static_cast<float>(0.001 * tick))
+                    : std::nan(""));
+            reader.formatValue(value_tick, 0, i);
+            reader.formatValue(value_divided, 3 + field_divided, i);
+            reader.formatValue(value_left_out, 3 + field_left_out, i);
+
+            passed &= value_tick.str() == std::to_string(tick)
+                    && value_divided.str() == value_divided_expected.str()
+                    && value_left_out.str() == "nan";
+        }
+    }
+
+    if (tick != sample_count || !passed)
+    {
+        std::cerr << "Sample log: samples differ from the telemetry frames." << std::endl;
+        return false;
+    }
+
+    std::cout << "Sample log: " << sample_count << " samples, " << writer.getByteCount() / 1e3
+            << " kB, flushed before closing." << std::endl;
+
+    return true;
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @param  message_count Number of Biped messages.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result, const unsigned long long& message_count)
+{
+    const double count = std::max<unsigned long long>(message_count, 1);
+
+    std::cout << std::fixed << std::setprecision(2) << std::setw(18) << std::left << label
+            << std::right << std::setw(8) << result.cpu_time_logging * 1e6 / count << " us logging, "
+            << std::setw(8) << result.cpu_time * 1e6 / count << " us CPU per Biped message, "
+            << std::setw(8) << result.byte_count / 1e6 << " MB, "
+            << std::setw(8) << result.byte_count / 1e6 / result.time << " MB/s, "
+            << std::setw(10) << std::setprecision(0) << message_count / result.time
+            << " Biped messages/s." << std::endl;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Ground station binary log harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long long message_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    if (message_count == 0)
+    {
+        std::cerr << "Invalid number of Biped messages." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path()
+            / ("biped-binary-log-" + std::to_string(getpid()));
+    const std::filesystem::path path_text = path / "data.log";
+    const std::vector<BipedMessageLogRecord> records = buildRecords();
+    bool verified = true;
+
+    std::filesystem::create_directories(path);
+
+    std::cout << biped_message_log_columns.size() << " columns, " << message_count << " Biped messages, "
+            << (isBinaryLogCompressionAvailable() ? "LZ4 available." : "LZ4 not available.")
+            << std::endl;
+
+    const Result result_legacy = runLegacy(path_text, records, message_count);
+
+    report("Text", result_legacy, message_count);
+
+    if (result_legacy.failed)
+    {
+        std::cerr << "Failed to write the text data log." << std::endl;
+        verified = false;
+    }
+
+    const std::string text = readFile(path_text);
+
+    for (const bool& compressed : {false, true})
+    {
+        if (compressed && !isBinaryLogCompressionAvailable())
+        {
+            continue;
+        }
+
+        const std::string label = compressed ? "Binary, LZ4" : "Binary";
+        const std::filesystem::path path_binary = path / (compressed ? "data-lz4.bin" : "data.bin");
+        const Result result = runBinary(path_binary, records, message_count, compressed);
+
+        report(label, result, message_count);
+
+        if (result.failed)
+        {
+            std::cerr << label << ": failed to write the binary data log." << std::endl;
+            verified = false;
+            continue;
+        }
+
+        std::ostringstream converted;
+
+        if (!convertBinaryLog(path_binary, converted, '\t') || converted.str() != text)
+        {
+            std::cerr << label << ": converted binary data log differs from the text data log."
+                    << std::endl;
+            verified = false;
+        }
+    }
+
+    verified &= runSampleLog(path / "sample.bin");
+
+    std::filesystem::remove_all(path);
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,837 @@
+/**
+ *  @file   camera_decode.cpp
+ *  @author Simon Yu
+ *  @date   02/04/2022
+ *  @brief  Ground station camera decode harness source.
+ *
+ *  This file implements the Biped ground station camera decode
+ *  harness. The harness encodes synthetic 640 by 480 camera frames
+ *  into JPG using libjpeg, the JPEG library behind the Qt JPG image
+ *  plugin, and splits them into chunks the same way as the Biped
+ *  camera chunker.
+ *
+ *  It first receives the chunks the same way as the Biped ground
+ *  station camera daemon did before, i.e., allocating a buffer per
+ *  datagram, appending each chunk to a growing camera frame buffer,
+ *  decoding every camera frame at full resolution on the receiving
+ *  thread, and rescaling it smoothly to the display size, as the
+ *  camera view did on every paint.
+ *
+ *  It then receives the chunks the same way as the camera daemon
+ *  does now, i.e., into one reused datagram buffer, reassembling
+ *  them into a pool of preallocated camera frame buffers, and handing
+ *  the completed camera frames to a bounded pool of decode threads
+ *  when they are downscaled. The decode threads decode straight to
+ *  the display size using the scaled inverse DCT of libjpeg. Camera
+ *  frames at the display size are decoded on the receiving thread
+ *  instead, as the hand-over would cost more than it saves. Both post
+ *  into a latest-frame mailbox, dropping older camera frames instead
+ *  of queueing them.
+ *
+ *  For both, at a display size equal to and half of the camera frame
+ *  size, the harness reports the frame rate and the CPU time per
+ *  camera frame, across all threads. The pooled receiver is run once
+ *  waiting for the decode threads, to measure the decode capacity,
+ *  and once dropping, as the camera daemon does. It verifies that the
+ *  scaled decode matches the full decode rescaled, that no camera
+ *  frame buffer leaks, and that the mailbox ends with the newest
+ *  camera frame. It also verifies that a late chunk of an evicted
+ *  camera frame, arriving while every slot is busy, is counted as
+ *  lost rather than evicting a newer camera frame.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-camera-decode [frames] [decode threads]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csetjmp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <jpeglib.h>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "common/type.h"
+#include "test/cpu_time.h"
+#include "test/synthetic_frame.h"
+#include "utility/serializer.hpp"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::ground_station;
+using biped::firmware::CameraChunkHeader;
+
+/*
+ *  Datagram type.
+ */
+using Datagram = std::vector<uint8_t>;
+
+/*
+ *  Camera frame constants.
+ */
+constexpr size_t frame_height = 480;    //!< Camera frame height, in pixels.
+constexpr size_t frame_width = 640; //!< Camera frame width, in pixels.
+constexpr int jpeg_quality = 80;    //!< libjpeg JPEG quality, from 0 (worst) to 100 (best).
+
+/**
+ *  @brief  Image struct.
+ *
+ *  This struct contains a decoded RGB image.
+ */
+struct Image
+{
+    std::vector<uint8_t> data;  //!< RGB pixel data, row by row.
+    size_t height = 0;  //!< Height, in pixels.
+    size_t width = 0;   //!< Width, in pixels.
+};
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    unsigned long chunk_count_lost = 0; //!< Chunks of camera frames older than every reassembling one.
+    double cpu_time = 0;    //!< CPU time across all threads, in seconds.
+    unsigned long frame_count_decoded = 0;  //!< Decoded camera frames.
+    unsigned long frame_count_dropped = 0;  //!< Camera frames dropped before decoding.
+    Image frame;    //!< Last decoded camera frame.
+    uint32_t frame_id = 0;  //!< ID of the last decoded camera frame.
+    double wall_time = 0;   //!< Wall time, in seconds.
+};
+
+/**
+ *  @brief  libjpeg error manager struct.
+ *
+ *  This struct returns from a failed libjpeg call with a long jump,
+ *  rather than exiting.
+ */
+struct ErrorManager
+{
+    jpeg_error_mgr manager; //!< libjpeg error manager.
+    std::jmp_buf jump;  //!< Long jump buffer.
+};
+
+/**
+ *  @param  info libjpeg common struct pointer.
+ *  @brief  libjpeg error exit function.
+ */
+static void
+exitError(j_common_ptr info)
+{
+    std::longjmp(reinterpret_cast<ErrorManager*>(info->err)->jump, 1);
+}
+
+/**
+ *  @param  frame JPG camera frame.
+ *  @param  frame_id Camera frame ID.
+ *  @param  datagrams Datagrams to append the chunks to.
+ *  @brief  Split a JPG camera frame into chunks.
+ *
+ *  This function splits the JPG camera frame evenly into the fewest
+ *  chunks that fit the camera buffer size, each a datagram starting
+ *  with its camera chunk header, the same way as the Biped camera
+ *  chunker.
+ */
+static void
+split(const std::vector<uint8_t>& frame, const uint32_t& frame_id,
+        std::vector<Datagram>& datagrams)
+{
+    CameraChunkHeader header;
+    header.chunk_count = static_cast<uint16_t>(CameraChunkHeader::getChunkCount(frame.size(),
+            NetworkParameter::buffer_size_camera - CameraChunkHeader::size));
+    header.frame_id = frame_id;
+    header.frame_size = static_cast<uint32_t>(frame.size());
+    header.timestamp = frame_id;
+
+    for (size_t index = 0; index < header.chunk_count; index ++)
+    {
+        header.chunk_index = static_cast<uint16_t>(index);
+
+        Datagram datagram(CameraChunkHeader::size + header.getPayloadSize());
+        zpp::serializer::memory_view_output_archive serializer(datagram.data(), datagram.size());
+
+        serializer(header);
+        std::memcpy(datagram.data() + CameraChunkHeader::size, frame.data() + header.getOffset(),
+                header.getPayloadSize());
+        datagrams.push_back(std::move(datagram));
+    }
+}
+
+/**
+ *  @param  source Source image.
+ *  @param  width Destination width, in pixels.
+ *  @param  height Destination height, in pixels.
+ *  @return Rescaled image.
+ *  @brief  Rescale an image with bilinear filtering.
+ *
+ *  This function rescales the same way as a smooth pixmap transform.
+ */
+static Image
+rescale(const Image& source, const size_t& width, const size_t& height)
+{
+    Image destination;
+    destination.width = width;
+    destination.height = height;
+    destination.data.resize(width * height * 3);
+
+    for (size_t y = 0; y < height; y ++)
+    {
+        const double source_y = std::max(0.0, (y + 0.5) * source.height / height - 0.5);
+        const size_t y_0 = std::min(static_cast<size_t>(source_y), source.height - 1);
+        const size_t y_1 = std::min(y_0 + 1, source.height - 1);
+        const double weight_y = source_y - y_0;
+
+        for (size_t x = 0; x < width; x ++)
+        {
+            const double source_x = std::max(0.0, (x + 0.5) * source.width / width - 0.5);
+            const size_t x_0 = std::min(static_cast<size_t>(source_x), source.width - 1);
+            const size_t x_1 = std::min(x_0 + 1, source.width - 1);
+            const double weight_x = source_x - x_0;
+
+            for (size_t channel = 0; channel < 3; channel ++)
+            {
+                const auto pixel = [&](const size_t& pixel_x, const size_t& pixel_y)
+                {
+                    return source.data[(pixel_y * source.width + pixel_x) * 3 + channel];
+                };
+
+                const double top = pixel(x_0, y_0) * (1 - weight_x) + pixel(x_1, y_0) * weight_x;
+                const double bottom = pixel(x_0, y_1) * (1 - weight_x) + pixel(x_1, y_1) * weight_x;
+
+                destination.data[(y * width + x) * 3 + channel] = static_cast<uint8_t>(top
+                        * (1 - weight_y) + bottom * weight_y + 0.5);
+            }
+        }
+    }
+
+    return destination;
+}
+
+/**
+ *  @param  frame JPG camera frame buffer pointer.
+ *  @param  size Size of the JPG camera frame buffer, in bytes.
+ *  @param  width Display width, in pixels.
+ *  @param  height Display height, in pixels.
+ *  @return Whether the display is smaller than the camera frame.
+ *  @brief  Get whether a JPG camera frame is decoded downscaled.
+ *
+ *  This function only reads the JPG header, for the camera frame size,
+ *  the same way as the camera daemon.
+ */
+static bool
+isScaled(const uint8_t* frame, const size_t& size, const size_t& width, const size_t& height)
+{
+    jpeg_decompress_struct decompress;
+    ErrorManager error;
+
+    decompress.err = jpeg_std_error(&error.manager);
+    error.manager.error_exit = &exitError;
+
+    if (setjmp(error.jump))
+    {
+        jpeg_destroy_decompress(&decompress);
+        return false;
+    }
+
+    jpeg_create_decompress(&decompress);
+    jpeg_mem_src(&decompress, const_cast<unsigned char*>(frame), size);
+    jpeg_read_header(&decompress, TRUE);
+
+    const bool scaled = width > 0 && height > 0 && width < decompress.image_width
+            && height < decompress.image_height;
+
+    jpeg_destroy_decompress(&decompress);
+
+    return scaled;
+}
+
+/**
+ *  @param  frame JPG camera frame buffer pointer.
+ *  @param  size Size of the JPG camera frame buffer, in bytes.
+ *  @param  width Display width, in pixels, or 0 for the full resolution.
+ *  @param  height Display height, in pixels, or 0 for the full resolution.
+ *  @param  image Decoded image.
+ *  @return Whether the camera frame was decoded.
+ *  @brief  Decode a JPG camera frame.
+ *
+ *  This function decodes at the smallest libjpeg scale that still
+ *  covers the display size, and rescales the rest of the way, the
+ *  same way as the Qt JPG image plugin given a scaled size.
+ */
+static bool
+decode(const uint8_t* frame, const size_t& size, const size_t& width, const size_t& height,
+        Image& image)
+{
+    jpeg_decompress_struct decompress;
+    ErrorManager error;
+
+    decompress.err = jpeg_std_error(&error.manager);
+    error.manager.error_exit = &exitError;
+
+    if (setjmp(error.jump))
+    {
+        jpeg_destroy_decompress(&decompress);
+        return false;
+    }
+
+    jpeg_create_decompress(&decompress);
+    jpeg_mem_src(&decompress, const_cast<unsigned char*>(frame), size);
+    jpeg_read_header(&decompress, TRUE);
+    decompress.out_color_space = JCS_RGB;
+    decompress.scale_num = 1;
+    decompress.scale_denom = 1;
+
+    for (unsigned denominator = 8; width > 0 && height > 0 && denominator > 1; denominator /= 2)
+    {
+        if (decompress.image_width / denominator >= width
+                && decompress.image_height / denominator >= height)
+        {
+            decompress.scale_denom = denominator;
+            break;
+        }
+    }
+
+    jpeg_start_decompress(&decompress);
+    image.width = decompress.output_width;
+    image.height = decompress.output_height;
+    image.data.resize(image.width * image.height * 3);
+
+    while (decompress.output_scanline < decompress.output_height)
+    {
+        JSAMPROW row = &image.data[decompress.output_scanline * image.width * 3];
+        jpeg_read_scanlines(&decompress, &row, 1);
+    }
+
+    jpeg_finish_decompress(&decompress);
+    jpeg_destroy_decompress(&decompress);
+
+    if (width > 0 && height > 0 && (image.width != width || image.height != height))
+    {
+        image = rescale(image, width, height);
+    }
+
+    return true;
+}
+
+/**
+ *  @param  datagrams Datagrams of all camera frames.
+ *  @param  width Display width, in pixels.
+ *  @param  height Display height, in pixels.
+ *  @return Run result struct.
+ *  @brief  Receive and decode the camera frames the previous way.
+ */
+static Result
+runSerial(const std::vector<Datagram>& datagrams, const size_t& width, const size_t& height)
+{
+    std::vector<char> frame;
+    uint32_t frame_id = 0;
+    bool frame_valid = false;
+    Result result;
+
+    const double cpu_time_start = getCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    for (const auto& datagram : datagrams)
+    {
+        /*
+         *  Allocate a buffer per datagram, the same way as the UDP read buffer function.
+         */
+        auto buffer = std::make_shared<std::vector<char>>(NetworkParameter::buffer_size_camera);
+        std::copy(datagram.begin(), datagram.end(), buffer->begin());
+
+        CameraChunkHeader header;
+        zpp::serializer::memory_view_input_archive deserializer(
+                reinterpret_cast<const unsigned char*>(buffer->data()), datagram.size());
+
+        if (!deserializer(header))
+        {
+            continue;
+        }
+
+        if (!frame_valid || header.frame_id != frame_id)
+        {
+            frame.clear();
+            frame_id = header.frame_id;
+            frame_valid = true;
+        }
+
+        frame.insert(frame.end(), buffer->begin() + CameraChunkHeader::size,
+                buffer->begin() + datagram.size());
+
+        if (header.chunk_index + 1 != header.chunk_count)
+        {
+            continue;
+        }
+
+        Image image;
+
+        if (decode(reinterpret_cast<const uint8_t*>(frame.data()), frame.size(), 0, 0, image))
+        {
+            result.frame = image.width == width && image.height == height ? std::move(image) :
+                    rescale(image, width, height);
+            result.frame_id = frame_id;
+            result.frame_count_decoded ++;
+        }
+    }
+
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now()
+            - time_start).count();
+    result.cpu_time = getCPUTime() - cpu_time_start;
+
+    return result;
+}
+
+/**
+ *  @param  datagrams Datagrams of all camera frames.
+ *  @param  width Display width, in pixels.
+ *  @param  height Display height, in pixels.
+ *  @param  thread_count Number of decode threads.
+ *  @param  blocking Whether to wait for the decode threads instead of dropping.
+ *  @return Run result struct.
+ *  @brief  Receive and decode the camera frames the same way as the camera daemon.
+ *
+ *  With blocking, the receiving thread waits for a free decode queue
+ *  entry, and the frame rate is the decode capacity. Without it, the
+ *  datagrams arrive faster than any decoder keeps up with, and the
+ *  oldest queued camera frames are dropped, as in the camera daemon.
+ */
+static Result
+runPooled(const std::vector<Datagram>& datagrams, const size_t& width, const size_t& height,
+        const size_t& thread_count, const bool& blocking)
+{
+    struct DecodeJob
+    {
+        size_t buffer;
+        uint32_t frame_id;
+        size_t frame_size;
+    };
+
+    struct Slot
+    {
+        bool active = false;
+        size_t buffer = 0;
+        size_t chunk_count_received = 0;
+        std::vector<bool> chunk_received;
+        CameraChunkHeader header;
+    };
+
+    /*
+     *  Size the camera frame buffer pool the same way as the camera daemon, i.e.,
+     *  one per reassembly slot, plus one per queued and one per decoding camera frame.
+     */
+    const size_t buffer_count = CameraDaemonParameter::slot_count + 2 * thread_count;
+    std::vector<std::vector<uint8_t>> buffers(buffer_count,
+            std::vector<uint8_t>(CameraDaemonParameter::frame_size_max));
+    std::vector<size_t> buffers_free;
+    std::condition_variable condition_decode;
+    std::condition_variable condition_queue;
+    std::vector<uint8_t> datagram_received(NetworkParameter::buffer_size_camera);
+    std::deque<DecodeJob> decode_jobs;
+    bool decoding = true;
+    std::mutex mutex_buffer;
+    std::mutex mutex_decode;
+    std::mutex mutex_frame;
+    std::vector<Slot> slots(CameraDaemonParameter::slot_count);
+    std::vector<std::thread> threads_decode;
+    Result result;
+    bool frame_valid = false;
+
+    for (size_t buffer = 0; buffer < buffer_count; buffer ++)
+    {
+        buffers_free.push_back(buffer);
+    }
+
+    const auto release = [&](const size_t& buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_buffer);
+        buffers_free.push_back(buffer);
+    };
+
+    /*
+     *  Decode a camera frame and post it into the latest-frame mailbox.
+     */
+    const auto decodeFrame = [&](const DecodeJob& job)
+    {
+        Image image;
+        const bool decoded = decode(buffers[job.buffer].data(), job.frame_size, width, height,
+                image);
+
+        release(job.buffer);
+
+        std::lock_guard<std::mutex> lock_frame(mutex_frame);
+
+        if (decoded)
+        {
+            result.frame_count_decoded ++;
+        }
+
+        if (decoded && (!frame_valid || static_cast<int32_t>(job.frame_id - result.frame_id) > 0))
+        {
+            result.frame = std::move(image);
+            result.frame_id = job.frame_id;
+            frame_valid = true;
+        }
+    };
+
+    const double cpu_time_start = getCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < thread_count; i ++)
+    {
+        threads_decode.emplace_back([&]()
+        {
+            for (;;)
+            {
+                std::unique_lock<std::mutex> lock(mutex_decode);
+                condition_decode.wait(lock, [&]()
+                {
+                    return !decoding || !decode_jobs.empty();
+                });
+
+                if (decode_jobs.empty())
+                {
+                    break;
+                }
+
+                const DecodeJob job = decode_jobs.front();
+                decode_jobs.pop_front();
+                lock.unlock();
+
+                condition_queue.notify_one();
+
+                decodeFrame(job);
+            }
+        });
+    }
+
+    for (const auto& datagram : datagrams)
+    {
+        /*
+         *  Receive into the reused datagram buffer.
+         */
+        std::copy(datagram.begin(), datagram.end(), datagram_received.begin());
+
+        CameraChunkHeader header;
+        zpp::serializer::memory_view_input_archive deserializer(datagram_received.data(),
+                datagram.size());
+
+        if (!deserializer(header))
+        {
+            continue;
+        }
+
+        Slot* slot = nullptr;
+
+        for (auto& slot_active : slots)
+        {
+            if (slot_active.active && slot_active.header.frame_id == header.frame_id)
+            {
+                slot = &slot_active;
+            }
+        }
+
+        if (!slot)
+        {
+            Slot* slot_oldest = nullptr;
+
+            for (auto& slot_other : slots)
+            {
+                if (!slot_other.active)
+                {
+                    slot = slot ? slot : &slot_other;
+                }
+                else if (!slot_oldest || static_cast<int32_t>(slot_other.header.frame_id
+                        - slot_oldest->header.frame_id) < 0)
+                {
+                    slot_oldest = &slot_other;
+                }
+            }
+
+            /*
+             *  With every slot busy, evict the oldest camera frame, the same way as
+             *  the camera daemon, unless the chunk is of an even older camera frame,
+             *  e.g., a late chunk of an evicted one, which is lost instead.
+             */
+            if (!slot && static_cast<int32_t>(header.frame_id - slot_oldest->header.frame_id) < 0)
+            {
+                result.chunk_count_lost ++;
+                continue;
+            }
+
+            if (!slot)
+            {
+                release(slot_oldest->buffer);
+                slot_oldest->active = false;
+                result.frame_count_dropped ++;
+                slot = slot_oldest;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_buffer);
+
+            if (buffers_free.empty())
+            {
+                continue;
+            }
+
+            slot->active = true;
+            slot->buffer = buffers_free.back();
+            slot->chunk_count_received = 0;
+            slot->chunk_received.assign(header.chunk_count, false);
+            slot->header = header;
+            buffers_free.pop_back();
+        }
+
+        if (slot->chunk_received[header.chunk_index])
+        {
+            continue;
+        }
+
+        std::memcpy(buffers[slot->buffer].data() + header.getOffset(),
+                datagram_received.data() + CameraChunkHeader::size, header.getPayloadSize());
+        slot->chunk_received[header.chunk_index] = true;
+
+        if (++ slot->chunk_count_received < header.chunk_count)
+        {
+            continue;
+        }
+
+        const DecodeJob job = {slot->buffer, header.frame_id, header.frame_size};
+        slot->active = false;
+
+        /*
+         *  Without a downscale, decode the completed camera frame on the
+         *  receiving thread, the same way as the camera daemon.
+         */
+        if (!isScaled(buffers[job.buffer].data(), job.frame_size, width, height))
+        {
+            decodeFrame(job);
+            continue;
+        }
+
+        /*
+         *  Otherwise, hand it to the decode threads, dropping the oldest
+         *  queued camera frame if they fall behind.
+         */
+        std::unique_lock<std::mutex> lock(mutex_decode);
+
+        if (blocking)
+        {
+            condition_queue.wait(lock, [&]()
+            {
+                return decode_jobs.size() < thread_count;
+            });
+        }
+
+        if (decode_jobs.size() >= thread_count)
+        {
+            release(decode_jobs.front().buffer);
+            decode_jobs.pop_front();
+            result.frame_count_dropped ++;
+        }
+
+        decode_jobs.push_back(job);
+        lock.unlock();
+
+        condition_decode.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_decode);
+        decoding = false;
+    }
+
+    condition_decode.notify_all();
+
+    for (auto& thread : threads_decode)
+    {
+        thread.join();
+    }
+
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now()
+            - time_start).count();
+    result.cpu_time = getCPUTime() - cpu_time_start;
+
+    if (buffers_free.size() != buffer_count)
+    {
+        std::cerr << "Camera frame buffers leaked." << std::endl;
+        result.frame_count_decoded = 0;
+    }
+
+    return result;
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result)
+{
+    std::cout << std::fixed << std::setprecision(2) << label << ": "
+            << result.frame_count_decoded << " camera frames decoded, "
+            << result.frame_count_dropped << " dropped, "
+            << result.frame_count_decoded / result.wall_time << " frames/s, "
+            << result.cpu_time * 1000 / std::max<unsigned long>(result.frame_count_decoded, 1)
+            << " ms CPU per camera frame." << std::endl;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Camera decode harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const unsigned long frame_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    const unsigned long thread_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+
+    if (frame_count == 0 || thread_count == 0)
+    {
+        std::cerr << "Invalid number of camera frames or decode threads." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 random(431);
+    std::vector<Datagram> datagrams;
+    std::vector<std::vector<uint8_t>> frames;
+    size_t size_total = 0;
+
+    /*
+     *  Encode a few distinct camera frames, and stream them over and over.
+     */
+    for (size_t i = 0; i < std::min<unsigned long>(frame_count, 16); i ++)
+    {
+        frames.push_back(encodeSyntheticFrame(drawSyntheticFrame(i, frame_width, frame_height,
+                random), frame_width, frame_height, jpeg_quality));
+        size_total += frames.back().size();
+    }
+
+    for (size_t i = 0; i < frame_count; i ++)
+    {
+        split(frames[i % frames.size()], static_cast<uint32_t>(i), datagrams);
+    }
+
+    std::cout << "Camera frames: " << frame_width << " by " << frame_height << ", "
+            << size_total / frames.size() << " bytes on average, " << datagrams.size()
+            << " datagrams." << std::endl;
+
+    const std::vector<std::pair<size_t, size_t>> sizes_display = {
+            {frame_width, frame_height}, {frame_width / 2, frame_height / 2}};
+
+    for (const auto& size_display : sizes_display)
+    {
+        const std::string label = std::to_string(size_display.first) + " by "
+                + std::to_string(size_display.second);
+        const Result result_serial = runSerial(datagrams, size_display.first,
+                size_display.second);
+        const Result result_pooled = runPooled(datagrams, size_display.first,
+                size_display.second, thread_count, true);
+        const Result result_live = runPooled(datagrams, size_display.first,
+                size_display.second, thread_count, false);
+
+        report("Serial, " + label, result_serial);
+        report("Pooled, " + label, result_pooled);
+        report("Pooled, dropping, " + label, result_live);
+
+        if (result_serial.frame_count_decoded != frame_count
+                || result_pooled.frame_count_decoded != frame_count
+                || result_live.frame_count_decoded == 0)
+        {
+            std::cerr << "Camera frames went missing." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (result_live.frame_id != frame_count - 1 || result_pooled.frame_id != frame_count - 1
+                || result_pooled.frame.width != size_display.first
+                || result_pooled.frame.height != size_display.second)
+        {
+            std::cerr << "Latest-frame mailbox does not hold the newest camera frame." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /*
+         *  Compare the scaled decode against the full decode rescaled.
+         */
+        double difference = 0;
+
+        for (size_t i = 0; i < result_pooled.frame.data.size(); i ++)
+        {
+            difference += std::abs(static_cast<int>(result_pooled.frame.data[i])
+                    - static_cast<int>(result_serial.frame.data[i]));
+        }
+
+        difference /= result_pooled.frame.data.size();
+
+        std::cout << "Mean absolute difference to the full decode: " << difference << "."
+                << std::endl;
+
+        if (difference > 4)
+        {
+            std::cerr << "Scaled decode differs from the full decode rescaled." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    /*
+     *  Start one more camera frame than there are slots, evicting the first, and
+     *  then deliver a late chunk of the evicted camera frame while every slot is
+     *  busy, before completing the others.
+     */
+    std::vector<std::vector<Datagram>> datagrams_frame(CameraDaemonParameter::slot_count + 1);
+    std::vector<Datagram> datagrams_straggler;
+
+    for (size_t i = 0; i < datagrams_frame.size(); i ++)
+    {
+        split(frames[i % frames.size()], static_cast<uint32_t>(i), datagrams_frame[i]);
+        datagrams_straggler.push_back(datagrams_frame[i].front());
+    }
+
+    datagrams_straggler.push_back(datagrams_frame.front().back());
+
+    for (size_t i = 1; i < datagrams_frame.size(); i ++)
+    {
+        datagrams_straggler.insert(datagrams_straggler.end(), datagrams_frame[i].begin() + 1,
+                datagrams_frame[i].end());
+    }
+
+    const Result result_straggler = runPooled(datagrams_straggler, frame_width, frame_height,
+            thread_count, true);
+
+    std::cout << "Late chunk of an evicted camera frame: " << result_straggler.chunk_count_lost
+            << " chunks lost, " << result_straggler.frame_count_dropped << " camera frames evicted, "
+            << result_straggler.frame_count_decoded << " decoded." << std::endl;
+
+    if (result_straggler.chunk_count_lost != 1 || result_straggler.frame_count_dropped != 1
+            || result_straggler.frame_count_decoded != CameraDaemonParameter::slot_count
+            || result_straggler.frame_id != CameraDaemonParameter::slot_count)
+    {
+        std::cerr << "Late chunk of an evicted camera frame evicted a newer camera frame." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,328 @@
+/**
+ *  @file   camera_log.cpp
+ *  @author Simon Yu
+ *  @date   02/09/2022
+ *  @brief  Ground station camera log harness source.
+ *
+ *  This file implements the Biped ground station camera log harness.
+ *  The harness records synthetic 480 by 320 JPG camera frames at 20
+ *  frames per second along with Biped messages at 10 Hz, the rate of
+ *  the Biped status messages, as fast as the logger takes them.
+ *
+ *  It first records the same way as the Biped ground station logging
+ *  daemon did before, i.e., for every Biped message, encoding the
+ *  latest decoded camera frame into JPG again, at the default quality
+ *  of the Qt JPG image plugin, and saving it into its own file, named
+ *  by the number of camera frames received so far. It then records
+ *  through the camera log writer, appending every JPG camera frame
+ *  once, as received, into a single camera log.
+ *
+ *  For both, the harness reports the CPU time per second of recording,
+ *  the camera frames recorded, and the files and bytes written. It
+ *  verifies that the camera log reader reads back every JPG camera
+ *  frame unchanged, by its index, by its offset, and by its timestamp,
+ *  and that a camera log cut short, with no index, is indexed again
+ *  up to its last complete JPG camera frame.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-camera-log [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "test/cpu_time.h"
+#include "test/synthetic_frame.h"
+#include "utility/camera_log.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::ground_station;
+
+/*
+ *  Camera frame and Biped message constants.
+ */
+constexpr size_t frame_height = 320;    //!< Camera frame height, in pixels.
+constexpr double frame_rate = 20;   //!< Camera frame rate, in frames per second.
+constexpr size_t frame_width = 480; //!< Camera frame width, in pixels.
+constexpr int jpeg_quality = 80;    //!< libjpeg JPEG quality of the Biped camera frames.
+constexpr int jpeg_quality_save = 75;   //!< libjpeg JPEG quality of the Qt JPG image plugin by default.
+constexpr double message_rate = 10; //!< Biped message rate, in messages per second.
+constexpr size_t pool_size = 32;    //!< Number of distinct synthetic camera frames, cycled through.
+
+/**
+ *  @brief  Camera frame struct.
+ *
+ *  This struct contains a synthetic camera frame, both decoded and as
+ *  a JPG camera frame.
+ */
+struct Frame
+{
+    std::vector<uint8_t> image; //!< RGB pixel data, row by row.
+    std::vector<uint8_t> jpg;   //!< JPG camera frame.
+};
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    unsigned long long byte_count = 0;  //!< Bytes written.
+    double cpu_time = 0;    //!< CPU time of the process, in seconds.
+    unsigned long file_count = 0;   //!< Files written.
+    unsigned long frame_count = 0;  //!< Camera frames recorded.
+};
+
+/**
+ *  @return Synthetic camera frames.
+ *  @brief  Generate a pool of synthetic camera frames.
+ *
+ *  This function draws a gradient with a moving block and sensor
+ *  noise, such that the JPG camera frame size is that of a real scene.
+ */
+static std::vector<Frame>
+generate()
+{
+    std::mt19937 random(431);
+    std::vector<Frame> frames(pool_size);
+
+    for (size_t index = 0; index < frames.size(); index ++)
+    {
+        frames[index].image = drawSyntheticFrame(index, frame_width, frame_height, random);
+        frames[index].jpg = encodeSyntheticFrame(frames[index].image, frame_width, frame_height,
+                jpeg_quality);
+    }
+
+    return frames;
+}
+
+/**
+ *  @param  index Camera frame index.
+ *  @return Camera frame timestamp, in microseconds.
+ *  @brief  Get the timestamp of a camera frame.
+ *
+ *  The first camera frame is taken a second after the Biped boots.
+ */
+static unsigned long long
+getTimestamp(const size_t& index)
+{
+    return static_cast<unsigned long long>((index + frame_rate) * 1e6 / frame_rate);
+}
+
+/**
+ *  @param  path Camera frame directory path.
+ *  @param  frames Synthetic camera frames.
+ *  @param  duration Recording duration, in seconds.
+ *  @return Run result struct.
+ *  @brief  Record the previous way.
+ */
+static Result
+runLegacy(const std::filesystem::path& path, const std::vector<Frame>& frames, const double& duration)
+{
+    Result result;
+    const size_t message_count = static_cast<size_t>(duration * message_rate);
+    const double cpu_time_start = getCPUTime();
+
+    std::filesystem::create_directories(path);
+
+    for (size_t message = 0; message < message_count; message ++)
+    {
+        /*
+         *  Camera frames received by the time of the Biped message.
+         */
+        const size_t frame_count = static_cast<size_t>(message * frame_rate / message_rate) + 1;
+        const std::vector<uint8_t> jpg = encodeSyntheticFrame(frames[(frame_count - 1) % frames.size()].image,
+                frame_width, frame_height, jpeg_quality_save);
+        std::ofstream file(path / (std::to_string(frame_count) + ".jpg"),
+                std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+        file.write(reinterpret_cast<const char*>(jpg.data()), jpg.size());
+        result.byte_count += jpg.size();
+    }
+
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.file_count = std::distance(std::filesystem::directory_iterator(path),
+            std::filesystem::directory_iterator());
+    result.frame_count = result.file_count;
+
+    return result;
+}
+
+/**
+ *  @param  path Camera log path.
+ *  @param  frames Synthetic camera frames.
+ *  @param  duration Recording duration, in seconds.
+ *  @param  offsets Offsets of the recorded camera frames.
+ *  @return Run result struct.
+ *  @brief  Record through the camera log writer.
+ */
+static Result
+runCameraLog(const std::filesystem::path& path, const std::vector<Frame>& frames, const double& duration,
+        std::vector<uint64_t>& offsets)
+{
+    Result result;
+    CameraLogWriter writer;
+    const size_t frame_count = static_cast<size_t>(duration * frame_rate);
+    const double cpu_time_start = getCPUTime();
+
+    if (!writer.open(path))
+    {
+        return result;
+    }
+
+    for (size_t i = 0; i < frame_count; i ++)
+    {
+        const std::vector<uint8_t>& jpg = frames[i % frames.size()].jpg;
+
+        offsets.push_back(writer.write(jpg.data(), jpg.size(), static_cast<uint32_t>(i), getTimestamp(i)));
+    }
+
+    writer.close();
+
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.byte_count = std::filesystem::file_size(path);
+    result.file_count = 1;
+    result.frame_count = writer.failed() ? 0 : writer.getFrameCount();
+
+    return result;
+}
+
+/**
+ *  @param  path Camera log path.
+ *  @param  frames Synthetic camera frames.
+ *  @param  offsets Offsets of the recorded camera frames.
+ *  @param  frame_count Expected number of camera frames.
+ *  @param  indexed Whether the camera log is expected to have its index.
+ *  @return Whether the camera log reads back correctly.
+ *  @brief  Verify a camera log.
+ */
+static bool
+verify(const std::filesystem::path& path, const std::vector<Frame>& frames, const std::vector<uint64_t>& offsets,
+        const size_t& frame_count, const bool& indexed)
+{
+    CameraLogReader reader;
+    std::vector<unsigned char> frame;
+
+    if (!reader.open(path) || reader.isIndexed() != indexed || reader.getFrames().size() != frame_count)
+    {
+        return false;
+    }
+
+    /*
+     *  Read the camera frames out of order, the same way as seeking through a recording.
+     */
+    for (size_t step = 0; step < frame_count; step ++)
+    {
+        const size_t i = step * 7919 % frame_count;
+        const std::vector<uint8_t>& jpg = frames[i % frames.size()].jpg;
+        size_t index = frame_count;
+
+        if (!reader.readFrame(i, frame) || !std::equal(frame.begin(), frame.end(), jpg.begin(), jpg.end())
+                || reader.getFrames()[i].frame_id != i || reader.getFrames()[i].offset != offsets[i]
+                || !reader.findFrame(offsets[i], index) || index != i
+                || !reader.findFrameAt(getTimestamp(i) + 1000, index) || index != i)
+        {
+            return false;
+        }
+    }
+
+    size_t index = 0;
+
+    return !reader.findFrame(offsets.back() + 1, index) && (frame_count == 0
+            || !reader.findFrameAt(getTimestamp(0) - 1, index));
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @param  duration Recording duration, in seconds.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result, const double& duration)
+{
+    std::cout << std::fixed << std::setprecision(2) << std::setw(12) << std::left << label
+            << std::right << std::setw(8) << result.cpu_time * 1e3 / duration << " ms CPU per second, "
+            << std::setw(6) << result.frame_count << " camera frames, " << std::setw(6)
+            << result.file_count << " files, " << std::setw(8) << result.byte_count / 1e6 << " MB."
+            << std::endl;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Ground station camera log harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::strtod(argv[1], nullptr) : 30;
+
+    if (duration * frame_rate < 2)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path()
+            / ("biped-camera-log-" + std::to_string(getpid()));
+    const std::filesystem::path path_camera_log = path / "camera.mjpeg";
+    const std::vector<Frame> frames = generate();
+    std::vector<uint64_t> offsets;
+    bool verified = true;
+
+    std::filesystem::create_directories(path);
+
+    const Result result_legacy = runLegacy(path / "camera", frames, duration);
+    const Result result_camera_log = runCameraLog(path_camera_log, frames, duration, offsets);
+    const size_t frame_count = static_cast<size_t>(duration * frame_rate);
+
+    std::cout << duration << " s of recording, " << frame_count << " camera frames, "
+            << static_cast<size_t>(duration * message_rate) << " Biped messages." << std::endl;
+
+    report("Previous", result_legacy, duration);
+    report("Camera log", result_camera_log, duration);
+
+    if (result_camera_log.frame_count != frame_count
+            || !verify(path_camera_log, frames, offsets, frame_count, true))
+    {
+        std::cerr << "Camera log does not read back every camera frame." << std::endl;
+        verified = false;
+    }
+
+    /*
+     *  Cut the camera log short in the middle of its last camera frame, losing the index.
+     */
+    std::filesystem::resize_file(path_camera_log, offsets.back() + frames[(frame_count - 1) % frames.size()].jpg.size() / 2);
+    offsets.pop_back();
+
+    if (!verify(path_camera_log, frames, offsets, frame_count - 1, false))
+    {
+        std::cerr << "Camera log cut short is not indexed again." << std::endl;
+        verified = false;
+    }
+
+    std::filesystem::remove_all(path);
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,32 @@
+#ifndef CPU_TIME_H
+#define CPU_TIME_H
+
+#include <sys/resource.h>
+#include <time.h>
+
+namespace biped
+{
+namespace ground_station
+{
+inline double
+getCPUTime()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+inline double
+getThreadCPUTime()
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+}
+}
+
+#endif // CPU_TIME_H
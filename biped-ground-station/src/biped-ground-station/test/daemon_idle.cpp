@@ -0,0 +1,339 @@
+/**
+ *  @file   daemon_idle.cpp
+ *  @author Simon Yu
+ *  @date   02/06/2022
+ *  @brief  Ground station daemon idle harness source.
+ *
+ *  This file implements the Biped ground station daemon idle harness.
+ *  The harness runs the loops of the inbound, camera, and joypad
+ *  daemons against the Biped ground station UDP interface and stop
+ *  token, with no Biped sending and no joypad connected, the same
+ *  way as an idle Biped ground station. Each loop is run once with
+ *  its UDP interface bound and once unbound.
+ *
+ *  It first runs the loops the previous way, i.e., checking a plain
+ *  started flag and retrying an unbound UDP interface or a missing
+ *  joypad device right away, and then the current way, i.e., waiting
+ *  on the stop token instead. For each, it reports the CPU
+ *  utilization of the process while idle and the time from stopping
+ *  the daemons to their loops returning. It verifies that the idle
+ *  CPU utilization of the current loops stays near zero and that
+ *  they stop promptly.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-daemon-idle [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "network/udp.h"
+#include "test/cpu_time.h"
+#include "utility/stop_token.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::ground_station;
+
+/*
+ *  Loopback IP address.
+ */
+static const std::string ip_loopback = "127.0.0.1";
+
+/*
+ *  Missing joypad device path.
+ */
+static const std::string path_device_missing = "/dev/input/biped-missing-js";
+
+/*
+ *  Idle UDP ports.
+ */
+static constexpr uint16_t port_biped_message = 54441;
+static constexpr uint16_t port_camera = 54442;
+
+/*
+ *  Maximum idle CPU utilization, in percent, and maximum stop time, in milliseconds.
+ */
+static constexpr double cpu_utilization_max = 2;
+static constexpr double time_stop_max = NetworkParameter::timeout + 50;
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    double cpu_utilization = 0; //!< Idle CPU utilization of the process, in percent.
+    double time_stop = 0;   //!< Time from stopping to the loops returning, in milliseconds.
+};
+
+/**
+ *  @param  duration Idle duration, in seconds.
+ *  @param  loops Daemon loops.
+ *  @param  stop Function stopping the daemon loops.
+ *  @return Run result struct.
+ *  @brief  Run daemon loops idle, then stop them.
+ */
+static Result
+run(const double& duration, const std::vector<std::function<void()>>& loops,
+        const std::function<void()>& stop)
+{
+    std::vector<std::thread> threads;
+    Result result;
+
+    for (const auto& loop : loops)
+    {
+        threads.emplace_back(loop);
+    }
+
+    /*
+     *  Let the loops settle into their idle state before measuring.
+     */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const double cpu_time_start = getCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+
+    result.cpu_utilization = 100 * (getCPUTime() - cpu_time_start)
+            / std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count();
+
+    const auto time_stop = std::chrono::steady_clock::now();
+
+    stop();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    result.time_stop = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+            - time_stop).count();
+
+    return result;
+}
+
+/**
+ *  @param  udp UDP interface.
+ *  @param  port Remote UDP port.
+ *  @param  running Function returning whether the loop should keep running.
+ *  @param  wait Function waiting after finding the UDP interface unbound.
+ *  @brief  Inbound and camera daemon loop.
+ */
+static void
+receive(const std::shared_ptr<UDP>& udp, const uint16_t& port,
+        const std::function<bool()>& running, const std::function<void()>& wait)
+{
+    std::vector<char> buffer(NetworkParameter::buffer_size_datagram);
+
+    while (running())
+    {
+        if (!udp || !udp->bound())
+        {
+            wait();
+            continue;
+        }
+
+        udp->readBuffer(ip_loopback, port, buffer.data(), buffer.size());
+    }
+}
+
+/**
+ *  @param  running Function returning whether the loop should keep running.
+ *  @param  wait Function waiting after failing to open the joypad device.
+ *  @brief  Joypad daemon loop.
+ */
+static void
+poll(const std::function<bool()>& running, const std::function<void()>& wait)
+{
+    while (running())
+    {
+        const int device = open(path_device_missing.c_str(), O_RDONLY);
+
+        if (device < 0)
+        {
+            wait();
+            continue;
+        }
+
+        close(device);
+    }
+}
+
+/**
+ *  @param  udp_biped_message Biped message UDP interface.
+ *  @param  udp_camera Camera UDP interface.
+ *  @param  duration Idle duration, in seconds.
+ *  @return Run result struct.
+ *  @brief  Run the daemon loops the previous way.
+ */
+static Result
+runLegacy(const std::shared_ptr<UDP>& udp_biped_message, const std::shared_ptr<UDP>& udp_camera,
+        const double& duration)
+{
+    auto started = std::make_shared<std::atomic<bool>>(true);
+    const auto running = [started]()
+    {
+        return started->load();
+    };
+    const auto wait = []()
+    {
+    };
+
+    return run(duration, {
+            [&]() { receive(udp_biped_message, port_biped_message, running, wait); },
+            [&]() { receive(udp_camera, port_camera, running, wait); },
+            [&]() { poll(running, wait); } }, [started]()
+    {
+        *started = false;
+    });
+}
+
+/**
+ *  @param  udp_biped_message Biped message UDP interface.
+ *  @param  udp_camera Camera UDP interface.
+ *  @param  duration Idle duration, in seconds.
+ *  @return Run result struct.
+ *  @brief  Run the daemon loops the current way.
+ */
+static Result
+runCurrent(const std::shared_ptr<UDP>& udp_biped_message, const std::shared_ptr<UDP>& udp_camera,
+        const double& duration)
+{
+    StopToken stop_token_inbound;
+    StopToken stop_token_camera;
+    StopToken stop_token_joypad;
+
+    stop_token_inbound.reset();
+    stop_token_camera.reset();
+    stop_token_joypad.reset();
+
+    const auto running = [](StopToken& stop_token)
+    {
+        return [&stop_token]()
+        {
+            return !stop_token.requested();
+        };
+    };
+    const auto wait = [](StopToken& stop_token, const int& period)
+    {
+        return [&stop_token, period]()
+        {
+            stop_token.waitFor(std::chrono::milliseconds(period));
+        };
+    };
+
+    return run(duration, {
+            [&]()
+            {
+                receive(udp_biped_message, port_biped_message, running(stop_token_inbound),
+                        wait(stop_token_inbound, NetworkParameter::timeout));
+            },
+            [&]()
+            {
+                receive(udp_camera, port_camera, running(stop_token_camera),
+                        wait(stop_token_camera, NetworkParameter::timeout));
+            },
+            [&]()
+            {
+                poll(running(stop_token_joypad),
+                        wait(stop_token_joypad, JoypadDaemonParameter::period_reconnect));
+            } }, [&]()
+    {
+        stop_token_inbound.request();
+        stop_token_camera.request();
+        stop_token_joypad.request();
+    });
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result)
+{
+    std::cout << std::fixed << std::setprecision(1) << std::setw(20) << std::left << label
+            << std::right << std::setw(7) << result.cpu_utilization << " % CPU idle, "
+            << std::setw(7) << result.time_stop << " ms to stop." << std::endl;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Ground station daemon idle harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::strtod(argv[1], nullptr) : 1;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bool verified = true;
+
+    for (const bool& bound : {true, false})
+    {
+        auto udp_biped_message = std::make_shared<UDP>(port_biped_message);
+        auto udp_camera = std::make_shared<UDP>(port_camera);
+
+        /*
+         *  A closed UDP interface is unbound, the same as one that failed to bind its port.
+         */
+        if (!bound)
+        {
+            udp_biped_message->close();
+            udp_camera->close();
+        }
+
+        const std::string label = bound ? "bound" : "unbound";
+        const Result result_legacy = runLegacy(udp_biped_message, udp_camera, duration);
+        const Result result_current = runCurrent(udp_biped_message, udp_camera, duration);
+
+        report("Previous, " + label, result_legacy);
+        report("Current, " + label, result_current);
+
+        if (result_current.cpu_utilization > cpu_utilization_max)
+        {
+            std::cerr << "Idle daemon loops use more than " << cpu_utilization_max << " % CPU."
+                    << std::endl;
+            verified = false;
+        }
+
+        if (result_current.time_stop > time_stop_max)
+        {
+            std::cerr << "Daemon loops took more than " << time_stop_max << " ms to stop."
+                    << std::endl;
+            verified = false;
+        }
+    }
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,83 @@
+#ifndef SYNTHETIC_FRAME_H
+#define SYNTHETIC_FRAME_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <jpeglib.h>
+#include <random>
+#include <vector>
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  Draw a gradient with a moving block and sensor noise, such that the JPG camera frame size is that of a real scene.
+ */
+inline std::vector<uint8_t>
+drawSyntheticFrame(const size_t& index, const size_t& width, const size_t& height, std::mt19937& random)
+{
+    std::normal_distribution<double> distribution_noise(0, 6);
+    std::vector<uint8_t> image(width * height * 3);
+    const size_t block_x = index * 7 % (width - 120);
+    const size_t block_y = index * 3 % (height - 90);
+
+    for (size_t y = 0; y < height; y ++)
+    {
+        for (size_t x = 0; x < width; x ++)
+        {
+            const bool block = x >= block_x && x < block_x + 120 && y >= block_y && y < block_y + 90;
+            const double base[3] = {block ? 220.0 : 255.0 * x / width, block ? 40.0 : 255.0 * y / height, block ? 60.0 : 128 + 96 * std::sin((x + y + index * 4) * 0.02)};
+
+            for (size_t channel = 0; channel < 3; channel ++)
+            {
+                image[(y * width + x) * 3 + channel] = static_cast<uint8_t>(std::max(0.0, std::min(255.0, base[channel] + distribution_noise(random))));
+            }
+        }
+    }
+
+    return image;
+}
+
+/*
+ *  Encode a synthetic camera frame into JPG with libjpeg, the JPEG library behind the Qt JPG image plugin.
+ */
+inline std::vector<uint8_t>
+encodeSyntheticFrame(const std::vector<uint8_t>& image, const size_t& width, const size_t& height, const int& quality)
+{
+    jpeg_compress_struct compress;
+    jpeg_error_mgr error;
+    unsigned char* buffer = nullptr;
+    unsigned long size = 0;
+
+    compress.err = jpeg_std_error(&error);
+    jpeg_create_compress(&compress);
+    jpeg_mem_dest(&compress, &buffer, &size);
+    compress.image_width = static_cast<JDIMENSION>(width);
+    compress.image_height = static_cast<JDIMENSION>(height);
+    compress.input_components = 3;
+    compress.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&compress);
+    jpeg_set_quality(&compress, quality, TRUE);
+    jpeg_start_compress(&compress, TRUE);
+
+    while (compress.next_scanline < compress.image_height)
+    {
+        JSAMPROW row = const_cast<JSAMPROW>(&image[compress.next_scanline * width * 3]);
+        jpeg_write_scanlines(&compress, &row, 1);
+    }
+
+    jpeg_finish_compress(&compress);
+    jpeg_destroy_compress(&compress);
+
+    std::vector<uint8_t> frame(buffer, buffer + size);
+    std::free(buffer);
+
+    return frame;
+}
+}
+}
+
+#endif // SYNTHETIC_FRAME_H
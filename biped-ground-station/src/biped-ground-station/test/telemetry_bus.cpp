@@ -0,0 +1,609 @@
+/**
+ *  @file   telemetry_bus.cpp
+ *  @author Simon Yu
+ *  @date   02/07/2022
+ *  @brief  Ground station telemetry bus harness source.
+ *
+ *  This file implements the Biped ground station telemetry bus
+ *  harness. The harness publishes Biped messages from a producer
+ *  thread, standing in for the inbound daemon, to three consumer
+ *  threads, i.e., the window, which only renders the latest Biped
+ *  message, the logging daemon, which handles every Biped message,
+ *  and a slow analysis consumer, which cannot keep up at high rates.
+ *
+ *  It first delivers the Biped messages the previous way, i.e., the
+ *  same way as a Qt queued connection, copying every Biped message
+ *  into a newly allocated event in the unbounded event queue of every
+ *  consumer, and the window copying it once more under its mutex. It
+ *  then delivers them through the telemetry bus, copying every Biped
+ *  message once into the ring, and notifying each consumer at most
+ *  once until it has read the ring empty.
+ *
+ *  For each, at a few Biped message rates and unpaced, the harness
+ *  reports the producer time per Biped message, the CPU time spent
+ *  delivering each Biped message, and, for each consumer, the Biped
+ *  messages handled, dropped, and, for the event queues, the peak
+ *  queue depth. It verifies that no
+ *  consumer ever reads a torn Biped message or reads out of order,
+ *  that every Biped message is either handled or counted as dropped,
+ *  and that the logging daemon drops nothing at 1 kHz.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-telemetry-bus [duration]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "common/type.h"
+#include "test/cpu_time.h"
+#include "utility/telemetry_bus.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped;
+using biped::ground_station::getCPUTime;
+using biped::ground_station::getThreadCPUTime;
+
+/*
+ *  Biped message bus type, the same as the inbound daemon.
+ */
+using BipedMessageBus = ground_station::TelemetryBus<firmware::BipedMessage,
+        ground_station::TelemetryBusParameter::capacity,
+        ground_station::TelemetryBusParameter::consumer_count>;
+
+/*
+ *  Consumer work per Biped message, in microseconds, standing in for
+ *  formatting a log line and for an analysis slower than 10 kHz.
+ */
+static constexpr unsigned long work_analysis = 200;
+static constexpr unsigned long work_logging = 20;
+
+/*
+ *  Window rendering period, in microseconds, i.e., 60 frames per second.
+ */
+static constexpr unsigned long period_render = 16667;
+
+/**
+ *  @brief  Consumer statistics struct.
+ *
+ *  This struct contains the statistics of a consumer.
+ */
+struct Statistics
+{
+    unsigned long long count_dropped = 0;   //!< Dropped Biped messages.
+    unsigned long long count_handled = 0;   //!< Handled Biped messages.
+    size_t depth_peak = 0;  //!< Peak event queue depth.
+    bool intact = true; //!< Whether every Biped message was read intact and in order.
+    long long sequence_last = -1;   //!< Sequence number of the last Biped message.
+};
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    Statistics analysis;    //!< Analysis consumer statistics.
+    double cpu_time = 0;    //!< CPU time of the process, in seconds.
+    Statistics logging; //!< Logging daemon statistics.
+    unsigned long long message_count = 0;   //!< Published Biped messages.
+    double time_publish = 0;    //!< Producer time, in seconds.
+    Statistics window;  //!< Window statistics.
+};
+
+/**
+ *  @param  duration CPU time, in microseconds.
+ *  @brief  Busy-wait on the CPU time of the calling thread, standing
+ *          in for consumer work, such that preemption does not shorten it.
+ */
+static void
+work(const unsigned long& duration)
+{
+    const double time_end = getThreadCPUTime() + duration * 1e-6;
+
+    while (getThreadCPUTime() < time_end)
+    {
+    }
+}
+
+/**
+ *  @param  message Biped message.
+ *  @param  sequence Sequence number.
+ *  @brief  Fill a Biped message, such that a torn copy can be detected.
+ */
+static void
+fill(firmware::BipedMessage& message, const unsigned long long& sequence)
+{
+    message.sequence = sequence;
+    message.timestamp = sequence;
+    message.encoder_data.position_x = sequence;
+    message.imu_data.attitude_y = sequence;
+    message.telemetry.deadline_miss = sequence;
+    message.time_of_flight_data.range_right = sequence;
+}
+
+/**
+ *  @param  message Biped message.
+ *  @param  statistics Consumer statistics struct.
+ *  @brief  Check a Biped message for tearing and ordering.
+ */
+static void
+check(const firmware::BipedMessage& message, Statistics& statistics)
+{
+    const unsigned long long sequence = message.sequence;
+
+    if (message.timestamp != sequence || message.encoder_data.position_x != sequence
+            || message.imu_data.attitude_y != sequence || message.telemetry.deadline_miss != sequence
+            || message.time_of_flight_data.range_right != sequence
+            || static_cast<long long>(sequence) <= statistics.sequence_last)
+    {
+        statistics.intact = false;
+    }
+
+    statistics.sequence_last = sequence;
+}
+
+/**
+ *  @brief  Event queue class.
+ *
+ *  This class stands in for the Qt event queue of a consumer thread,
+ *  holding one newly allocated event per queued signal.
+ */
+class EventQueue
+{
+public:
+
+    /**
+     *  @param  message Biped message.
+     *  @brief  Post a Biped message event.
+     */
+    void
+    post(const firmware::BipedMessage& message)
+    {
+        auto event = std::make_unique<firmware::BipedMessage>(message);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(std::move(event));
+        depth_peak_ = std::max(depth_peak_, events_.size());
+        condition_.notify_one();
+    }
+
+    /**
+     *  @brief  Post a quit event.
+     */
+    void
+    quit()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(nullptr);
+        condition_.notify_one();
+    }
+
+    /**
+     *  @return Next event, or null on quit.
+     *  @brief  Wait for the next event.
+     */
+    std::unique_ptr<firmware::BipedMessage>
+    take()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return !events_.empty(); });
+        std::unique_ptr<firmware::BipedMessage> event = std::move(events_.front());
+        events_.pop_front();
+        return event;
+    }
+
+    /**
+     *  @return Peak event queue depth.
+     *  @brief  Get the peak event queue depth.
+     */
+    size_t
+    getDepthPeak() const
+    {
+        return depth_peak_;
+    }
+
+private:
+
+    std::condition_variable condition_; //!< Event condition variable.
+    size_t depth_peak_ = 0; //!< Peak event queue depth.
+    std::deque<std::unique_ptr<firmware::BipedMessage>> events_;    //!< Events.
+    std::mutex mutex_;  //!< Event mutex.
+};
+
+/**
+ *  @brief  Wakeup class.
+ *
+ *  This class stands in for a Qt event loop woken up by a queued
+ *  invocation without arguments.
+ */
+class Wakeup
+{
+public:
+
+    /**
+     *  @brief  Wake up the consumer thread.
+     */
+    void
+    notify()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+        condition_.notify_one();
+    }
+
+    /**
+     *  @brief  Wake up the consumer thread to quit.
+     */
+    void
+    quit()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+        condition_.notify_one();
+    }
+
+    /**
+     *  @return Whether to keep running.
+     *  @brief  Wait for a wakeup.
+     */
+    bool
+    wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return pending_ || quit_; });
+        const bool running = pending_ || !quit_;
+        pending_ = false;
+        return running;
+    }
+
+private:
+
+    std::condition_variable condition_; //!< Wakeup condition variable.
+    std::mutex mutex_;  //!< Wakeup mutex.
+    bool pending_ = false;  //!< Whether a wakeup is pending.
+    bool quit_ = false; //!< Whether to quit.
+};
+
+/**
+ *  @param  duration Duration, in seconds.
+ *  @param  rate Biped message rate, in messages per second, or 0 for unpaced.
+ *  @param  publish Function publishing a Biped message.
+ *  @return Number of published Biped messages and producer time, in seconds.
+ *  @brief  Publish Biped messages at the given rate.
+ */
+static std::pair<unsigned long long, double>
+produce(const double& duration, const double& rate,
+        const std::function<void(const firmware::BipedMessage&)>& publish)
+{
+    const auto time_start = std::chrono::steady_clock::now();
+    const auto time_end = time_start + std::chrono::duration<double>(duration);
+    firmware::BipedMessage message;
+    unsigned long long sequence = 0;
+    double time_publish = 0;
+
+    while (std::chrono::steady_clock::now() < time_end)
+    {
+        fill(message, sequence);
+
+        const auto time_publish_start = std::chrono::steady_clock::now();
+        publish(message);
+        time_publish += std::chrono::duration<double>(std::chrono::steady_clock::now()
+                - time_publish_start).count();
+
+        sequence ++;
+
+        if (rate > 0)
+        {
+            std::this_thread::sleep_until(time_start + std::chrono::duration<double>(sequence / rate));
+        }
+    }
+
+    return {sequence, time_publish};
+}
+
+/**
+ *  @param  duration Duration, in seconds.
+ *  @param  rate Biped message rate, in messages per second, or 0 for unpaced.
+ *  @return Run result struct.
+ *  @brief  Deliver Biped messages through Qt queued connection event queues.
+ */
+static Result
+runQueued(const double& duration, const double& rate)
+{
+    EventQueue queue_analysis;
+    EventQueue queue_logging;
+    EventQueue queue_window;
+    firmware::BipedMessage message_window;
+    std::mutex mutex_message_window;
+    Result result;
+
+    const double cpu_time_start = getCPUTime();
+
+    std::thread thread_window([&]()
+    {
+        auto time_render = std::chrono::steady_clock::now();
+
+        while (auto event = queue_window.take())
+        {
+            std::unique_lock<std::mutex> lock(mutex_message_window);
+            message_window = *event;
+            lock.unlock();
+
+            check(*event, result.window);
+            result.window.count_handled ++;
+
+            if (std::chrono::steady_clock::now() - time_render >= std::chrono::microseconds(period_render))
+            {
+                time_render = std::chrono::steady_clock::now();
+            }
+        }
+    });
+
+    std::thread thread_logging([&]()
+    {
+        while (auto event = queue_logging.take())
+        {
+            check(*event, result.logging);
+            work(work_logging);
+            result.logging.count_handled ++;
+        }
+    });
+
+    std::thread thread_analysis([&]()
+    {
+        while (auto event = queue_analysis.take())
+        {
+            check(*event, result.analysis);
+            work(work_analysis);
+            result.analysis.count_handled ++;
+        }
+    });
+
+    const auto produced = produce(duration, rate, [&](const firmware::BipedMessage& message)
+    {
+        queue_window.post(message);
+        queue_logging.post(message);
+        queue_analysis.post(message);
+    });
+
+    queue_window.quit();
+    queue_logging.quit();
+    queue_analysis.quit();
+    thread_window.join();
+    thread_logging.join();
+    thread_analysis.join();
+
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.message_count = produced.first;
+    result.time_publish = produced.second;
+    result.analysis.depth_peak = queue_analysis.getDepthPeak();
+    result.logging.depth_peak = queue_logging.getDepthPeak();
+    result.window.depth_peak = queue_window.getDepthPeak();
+
+    return result;
+}
+
+/**
+ *  @param  duration Duration, in seconds.
+ *  @param  rate Biped message rate, in messages per second, or 0 for unpaced.
+ *  @return Run result struct.
+ *  @brief  Deliver Biped messages through the telemetry bus.
+ */
+static Result
+runBus(const double& duration, const double& rate)
+{
+    auto bus = std::make_unique<BipedMessageBus>();
+    Wakeup wakeup_analysis;
+    Wakeup wakeup_logging;
+    Wakeup wakeup_window;
+    size_t consumer_analysis = 0;
+    size_t consumer_logging = 0;
+    size_t consumer_window = 0;
+    Result result;
+
+    if (!bus->subscribe([&]() { wakeup_window.notify(); }, consumer_window)
+            || !bus->subscribe([&]() { wakeup_logging.notify(); }, consumer_logging)
+            || !bus->subscribe([&]() { wakeup_analysis.notify(); }, consumer_analysis))
+    {
+        return result;
+    }
+
+    const double cpu_time_start = getCPUTime();
+
+    std::thread thread_window([&]()
+    {
+        firmware::BipedMessage message;
+        auto time_render = std::chrono::steady_clock::now();
+
+        while (wakeup_window.wait())
+        {
+            while (bus->readLatest(consumer_window, message))
+            {
+                check(message, result.window);
+                result.window.count_handled ++;
+            }
+
+            if (std::chrono::steady_clock::now() - time_render >= std::chrono::microseconds(period_render))
+            {
+                time_render = std::chrono::steady_clock::now();
+            }
+        }
+    });
+
+    const auto consume = [&](Wakeup& wakeup, const size_t& consumer, const unsigned long& work_message,
+            Statistics& statistics)
+    {
+        firmware::BipedMessage message;
+
+        while (wakeup.wait())
+        {
+            while (bus->read(consumer, message))
+            {
+                check(message, statistics);
+                work(work_message);
+                statistics.count_handled ++;
+            }
+        }
+    };
+
+    std::thread thread_logging([&]()
+    {
+        consume(wakeup_logging, consumer_logging, work_logging, result.logging);
+    });
+
+    std::thread thread_analysis([&]()
+    {
+        consume(wakeup_analysis, consumer_analysis, work_analysis, result.analysis);
+    });
+
+    const auto produced = produce(duration, rate, [&](const firmware::BipedMessage& message)
+    {
+        bus->publish(message);
+    });
+
+    /*
+     *  Let the consumers catch up with the ring before quitting.
+     */
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    wakeup_window.quit();
+    wakeup_logging.quit();
+    wakeup_analysis.quit();
+    thread_window.join();
+    thread_logging.join();
+    thread_analysis.join();
+
+    result.cpu_time = getCPUTime() - cpu_time_start;
+    result.message_count = produced.first;
+    result.time_publish = produced.second;
+    result.analysis.count_dropped = bus->getDropCount(consumer_analysis);
+    result.logging.count_dropped = bus->getDropCount(consumer_logging);
+    result.window.count_dropped = bus->getDropCount(consumer_window);
+
+    return result;
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result)
+{
+    const auto consumer = [&](const std::string& name, const Statistics& statistics)
+    {
+        std::cout << "  " << std::setw(8) << std::left << name << std::right << std::setw(8)
+                << statistics.count_handled << " handled, " << std::setw(7)
+                << statistics.count_dropped << " dropped, peak queue depth " << std::setw(6)
+                << statistics.depth_peak << "." << std::endl;
+    };
+
+    const double count = std::max<unsigned long long>(result.message_count, 1);
+
+    /*
+     *  Leave out the simulated consumer work, leaving the CPU time spent delivering the Biped messages.
+     */
+    const double cpu_time_delivery = result.cpu_time - 1e-6 * (result.logging.count_handled
+            * work_logging + result.analysis.count_handled * work_analysis);
+
+    std::cout << std::fixed << std::setprecision(2) << label << ": " << result.message_count
+            << " Biped messages, " << result.time_publish * 1e9 / count
+            << " ns to publish, " << cpu_time_delivery * 1e6 / count
+            << " us CPU per Biped message delivered." << std::endl;
+    consumer("window", result.window);
+    consumer("logging", result.logging);
+    consumer("analysis", result.analysis);
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Ground station telemetry bus harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::strtod(argv[1], nullptr) : 1;
+
+    if (duration <= 0)
+    {
+        std::cerr << "Invalid duration." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Biped message size " << sizeof(firmware::BipedMessage) << " bytes, ring of "
+            << ground_station::TelemetryBusParameter::capacity << " Biped messages." << std::endl;
+
+    bool verified = true;
+
+    for (const double& rate : {1000.0, 10000.0, 0.0})
+    {
+        /*
+         *  Keep the unpaced runs short, since the event queue of the analysis consumer grows without bound.
+         */
+        const double duration_rate = rate > 0 ? duration : duration / 5;
+        const std::string label_rate = rate > 0 ? std::to_string(static_cast<int>(rate)) + " Hz" :
+                "unpaced";
+        const Result result_queued = runQueued(duration_rate, rate);
+        const Result result_bus = runBus(duration_rate, rate);
+
+        report("Queued, " + label_rate, result_queued);
+        report("Bus, " + label_rate, result_bus);
+
+        for (const Statistics* statistics : {&result_bus.window, &result_bus.logging,
+                &result_bus.analysis})
+        {
+            if (!statistics->intact)
+            {
+                std::cerr << "Telemetry bus consumer read a torn or reordered Biped message."
+                        << std::endl;
+                verified = false;
+            }
+        }
+
+        for (const Statistics* statistics : {&result_bus.logging, &result_bus.analysis})
+        {
+            if (statistics->count_handled + statistics->count_dropped != result_bus.message_count)
+            {
+                std::cerr << "Telemetry bus consumer lost Biped messages without counting them."
+                        << std::endl;
+                verified = false;
+            }
+        }
+
+        if (rate > 0 && rate <= 1000 && result_bus.logging.count_dropped > 0)
+        {
+            std::cerr << "Logging daemon dropped Biped messages at " << label_rate << "."
+                    << std::endl;
+            verified = false;
+        }
+    }
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
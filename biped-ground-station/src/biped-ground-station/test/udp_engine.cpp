@@ -0,0 +1,436 @@
+/**
+ *  @file   udp_engine.cpp
+ *  @author Simon Yu
+ *  @date   02/05/2022
+ *  @brief  Ground station UDP engine harness source.
+ *
+ *  This file implements the Biped ground station UDP engine harness.
+ *  The harness streams datagrams over the loopback interface from a
+ *  sender thread into the Biped ground station UDP interface, and
+ *  reads them back the same way as the Biped ground station daemons.
+ *
+ *  It first receives the datagrams through the previous UDP
+ *  interface, reproduced in this file, which allocated a buffer for
+ *  every read, started a future-based asynchronous receive on a
+ *  thread pool, waited on the future, and parsed the remote IP
+ *  address on every read and write. It then receives them through
+ *  the current UDP interface, whose receiving thread keeps a receive
+ *  posted on a persistent I/O context, drains every datagram already
+ *  queued on the socket into a ring of preallocated datagram buffers,
+ *  and wakes up the reader once per batch.
+ *
+ *  Each interface is run with the sender paced at a few datagram
+ *  rates and unpaced. For each run, the harness reports the received
+ *  datagrams per second, the datagram loss, and the CPU utilization
+ *  of the process. It verifies that the paced datagrams arrive
+ *  complete and in order, that datagrams from other remote endpoints
+ *  are filtered out, and that an unread ring drops the oldest
+ *  datagrams and counts them.
+ *
+ *  The harness exits with failure if any verification fails.
+ *
+ *  Usage: biped-udp-engine [duration] [datagram size]
+ */
+
+/*
+ *  External headers.
+ */
+#include <algorithm>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Project headers.
+ */
+#include "common/parameter.h"
+#include "network/udp.h"
+#include "test/cpu_time.h"
+
+/*
+ *  Use biped namespace.
+ */
+using namespace biped::ground_station;
+
+/*
+ *  Loopback IP address.
+ */
+static const std::string ip_loopback = "127.0.0.1";
+
+/*
+ *  Receiver and sender UDP ports.
+ */
+static constexpr uint16_t port_receiver = 54431;
+static constexpr uint16_t port_sender = 54432;
+static constexpr uint16_t port_sender_other = 54433;
+
+/**
+ *  @brief  Previous UDP class.
+ *
+ *  This class reproduces the Biped ground station UDP interface
+ *  before the UDP engine, reduced to reading buffers.
+ */
+class LegacyUDP
+{
+public:
+
+    /**
+     *  @param  port UDP port.
+     *  @brief  Previous UDP class constructor.
+     */
+    LegacyUDP(const uint16_t& port) : socket_(thread_pool_)
+    {
+        socket_.open(boost::asio::ip::udp::v4());
+        socket_.bind(boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port));
+    }
+
+    /**
+     *  @brief  Previous UDP class destructor.
+     */
+    ~LegacyUDP()
+    {
+        thread_pool_.join();
+        socket_.close();
+    }
+
+    /**
+     *  @param  ip_remote Remote IP address.
+     *  @param  port Remote UDP port.
+     *  @param  size Size of the buffer, in bytes.
+     *  @return Datagram buffer, or null on timeout.
+     *  @brief  Read a datagram buffer.
+     */
+    std::shared_ptr<std::vector<char>>
+    readBuffer(const std::string& ip_remote, const uint16_t& port, const size_t& size)
+    {
+        std::lock_guard<std::mutex> lock(mutex_read_);
+
+        std::shared_ptr<std::vector<char>> buffer = std::make_shared<std::vector<char>>(size,
+                '0');
+        boost::asio::ip::udp::endpoint endpoint_remote;
+
+        std::future<size_t> future = socket_.async_receive_from(boost::asio::buffer(*buffer),
+                endpoint_remote, boost::asio::use_future);
+
+        if (future.wait_for(std::chrono::milliseconds(NetworkParameter::timeout))
+                != std::future_status::ready)
+        {
+            socket_.cancel();
+            return nullptr;
+        }
+
+        if (endpoint_remote.address().to_string() != ip_remote || endpoint_remote.port() != port)
+        {
+            return nullptr;
+        }
+
+        return buffer;
+    }
+
+private:
+
+    std::mutex mutex_read_; //!< Read mutex.
+    boost::asio::thread_pool thread_pool_;  //!< Thread pool.
+    boost::asio::ip::udp::socket socket_;   //!< UDP socket.
+};
+
+/**
+ *  @brief  Run result struct.
+ *
+ *  This struct contains the result of a run.
+ */
+struct Result
+{
+    double cpu_time = 0;    //!< CPU time of the process, in seconds.
+    unsigned long datagram_count_received = 0;  //!< Received datagrams.
+    unsigned long datagram_count_sent = 0;  //!< Sent datagrams.
+    bool ordered = true;    //!< Whether the datagrams were received in order and intact.
+    double wall_time = 0;   //!< Wall time, in seconds.
+};
+
+/**
+ *  @param  duration Duration, in seconds.
+ *  @param  rate Datagram rate, in datagrams per second, or 0 for unpaced.
+ *  @param  size Datagram size, in bytes.
+ *  @param  done Whether the sender is done.
+ *  @return Number of sent datagrams.
+ *  @brief  Send sequence-numbered datagrams to the receiver.
+ */
+static unsigned long
+send(const double& duration, const double& rate, const size_t& size, std::atomic<bool>& done)
+{
+    boost::asio::io_context io_context;
+    boost::asio::ip::udp::socket socket(io_context,
+            boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port_sender));
+    const boost::asio::ip::udp::endpoint endpoint_receiver(
+            boost::asio::ip::make_address(ip_loopback), port_receiver);
+    const auto time_start = std::chrono::steady_clock::now();
+    const auto time_end = time_start + std::chrono::duration<double>(duration);
+    std::vector<char> datagram(size);
+    uint32_t sequence = 0;
+
+    while (std::chrono::steady_clock::now() < time_end)
+    {
+        /*
+         *  Fill the datagram with its sequence number, such that the receiver can check it.
+         */
+        std::memcpy(datagram.data(), &sequence, sizeof(sequence));
+        std::fill(datagram.begin() + sizeof(sequence), datagram.end(),
+                static_cast<char>(sequence));
+
+        boost::system::error_code error;
+        socket.send_to(boost::asio::buffer(datagram), endpoint_receiver, 0, error);
+        sequence ++;
+
+        if (rate > 0)
+        {
+            std::this_thread::sleep_until(time_start
+                    + std::chrono::duration<double>(sequence / rate));
+        }
+    }
+
+    done = true;
+
+    return sequence;
+}
+
+/**
+ *  @param  datagram Datagram buffer pointer.
+ *  @param  size Size of the datagram, in bytes.
+ *  @param  size_expected Expected size of the datagram, in bytes.
+ *  @param  sequence_last Sequence number of the last datagram.
+ *  @param  result Run result struct.
+ *  @brief  Check a received datagram.
+ */
+static void
+check(const char* datagram, const size_t& size, const size_t& size_expected,
+        int64_t& sequence_last, Result& result)
+{
+    uint32_t sequence = 0;
+    std::memcpy(&sequence, datagram, sizeof(sequence));
+
+    if (size != size_expected || static_cast<int64_t>(sequence) <= sequence_last
+            || std::any_of(datagram + sizeof(sequence), datagram + size, [&](const char& byte)
+            {
+                return byte != static_cast<char>(sequence);
+            }))
+    {
+        result.ordered = false;
+    }
+
+    sequence_last = sequence;
+    result.datagram_count_received ++;
+}
+
+/**
+ *  @tparam ReceiveFunction Type of the receive function.
+ *  @param  duration Duration, in seconds.
+ *  @param  rate Datagram rate, in datagrams per second, or 0 for unpaced.
+ *  @param  size Datagram size, in bytes.
+ *  @param  receive Function reading a datagram into the given result.
+ *  @return Run result struct.
+ *  @brief  Stream datagrams into a receiver.
+ */
+template<typename ReceiveFunction>
+static Result
+run(const double& duration, const double& rate, const size_t& size, ReceiveFunction receive)
+{
+    std::atomic<bool> done(false);
+    Result result;
+    int64_t sequence_last = -1;
+
+    const double cpu_time_start = getCPUTime();
+    const auto time_start = std::chrono::steady_clock::now();
+
+    std::future<unsigned long> sender = std::async(std::launch::async, [&]()
+    {
+        return send(duration, rate, size, done);
+    });
+
+    /*
+     *  Read until the sender is done and a read times out.
+     */
+    while (receive(sequence_last, result) || !done)
+    {
+    }
+
+    result.datagram_count_sent = sender.get();
+    result.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now()
+            - time_start).count() - NetworkParameter::timeout / 1e3;
+    result.cpu_time = getCPUTime() - cpu_time_start;
+
+    return result;
+}
+
+/**
+ *  @param  label Run label.
+ *  @param  result Run result struct.
+ *  @brief  Report a run.
+ */
+static void
+report(const std::string& label, const Result& result)
+{
+    std::cout << std::fixed << std::setprecision(1) << std::setw(28) << std::left << label
+            << std::right << std::setw(10) << result.datagram_count_received / result.wall_time
+            << " datagrams/s, " << std::setw(5)
+            << 100.0 * (result.datagram_count_sent - result.datagram_count_received)
+                    / std::max<unsigned long>(result.datagram_count_sent, 1) << " % lost, "
+            << std::setw(5) << 100 * result.cpu_time / result.wall_time << " % CPU." << std::endl;
+}
+
+/**
+ *  @param  argc Number of command line arguments.
+ *  @param  argv Command line arguments.
+ *  @return Exit status.
+ *  @brief  Ground station UDP engine harness main function.
+ */
+int
+main(int argc, char** argv)
+{
+    const double duration = argc > 1 ? std::strtod(argv[1], nullptr) : 1;
+    const size_t size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) :
+            NetworkParameter::buffer_size_camera;
+
+    if (duration <= 0 || size < sizeof(uint32_t) || size > NetworkParameter::buffer_size_datagram)
+    {
+        std::cerr << "Invalid duration or datagram size." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Datagram size " << size << " bytes, " << duration << " s per run." << std::endl;
+
+    const std::vector<double> rates = {1000, 10000, 0};
+    bool verified = true;
+
+    for (const auto& rate : rates)
+    {
+        const std::string label_rate = rate > 0 ? std::to_string(static_cast<int>(rate))
+                + " datagrams/s" : "unpaced";
+        Result result_legacy;
+        Result result_engine;
+
+        {
+            LegacyUDP udp(port_receiver);
+
+            result_legacy = run(duration, rate, size, [&](int64_t& sequence_last, Result& result)
+            {
+                std::shared_ptr<std::vector<char>> buffer = udp.readBuffer(ip_loopback,
+                        port_sender, NetworkParameter::buffer_size_datagram);
+
+                if (buffer)
+                {
+                    check(buffer->data(), size, size, sequence_last, result);
+                }
+
+                return buffer != nullptr;
+            });
+        }
+
+        {
+            UDP udp(port_receiver);
+            std::vector<char> buffer(NetworkParameter::buffer_size_datagram);
+
+            result_engine = run(duration, rate, size, [&](int64_t& sequence_last, Result& result)
+            {
+                const size_t bytes = udp.readBuffer(ip_loopback, port_sender, buffer.data(),
+                        buffer.size());
+
+                if (bytes > 0)
+                {
+                    check(buffer.data(), bytes, size, sequence_last, result);
+                }
+
+                return bytes > 0;
+            });
+        }
+
+        report("Previous, " + label_rate, result_legacy);
+        report("Engine, " + label_rate, result_engine);
+
+        if (!result_engine.ordered || (rate > 0 && rate <= 1000
+                && result_engine.datagram_count_received != result_engine.datagram_count_sent))
+        {
+            std::cerr << "Engine lost, reordered, or corrupted paced datagrams." << std::endl;
+            verified = false;
+        }
+    }
+
+    /*
+     *  Datagrams from other remote endpoints are filtered out, and an unread ring drops the
+     *  oldest datagrams.
+     */
+    {
+        UDP udp(port_receiver);
+        boost::asio::io_context io_context;
+        boost::asio::ip::udp::socket socket(io_context,
+                boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port_sender_other));
+        const boost::asio::ip::udp::endpoint endpoint_receiver(
+                boost::asio::ip::make_address(ip_loopback), port_receiver);
+        const size_t datagram_count = 2 * NetworkParameter::ring_size_receive;
+        std::vector<char> buffer(NetworkParameter::buffer_size_datagram);
+
+        for (uint32_t sequence = 0; sequence < datagram_count; sequence ++)
+        {
+            socket.send_to(boost::asio::buffer(&sequence, sizeof(sequence)), endpoint_receiver);
+
+            if (sequence % 64 == 63)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+        while (udp.getDatagramCountReceived() < datagram_count
+                && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        const unsigned long datagram_count_received = udp.getDatagramCountReceived();
+        const unsigned long datagram_count_dropped = udp.getDatagramCountDropped();
+        const size_t bytes = udp.readBuffer(ip_loopback, port_sender_other, buffer.data(),
+                buffer.size());
+        uint32_t sequence = 0;
+        std::memcpy(&sequence, buffer.data(), sizeof(sequence));
+        const size_t bytes_other = udp.readBuffer(ip_loopback, port_sender, buffer.data(),
+                buffer.size());
+
+        std::cout << "Unread ring: " << datagram_count_received << " datagrams received, "
+                << datagram_count_dropped << " dropped." << std::endl;
+
+        if (datagram_count_received <= NetworkParameter::ring_size_receive
+                || datagram_count_dropped
+                        != datagram_count_received - NetworkParameter::ring_size_receive)
+        {
+            std::cerr << "Unread ring did not count the dropped datagrams." << std::endl;
+            verified = false;
+        }
+
+        if (bytes != sizeof(sequence) || sequence < datagram_count_dropped)
+        {
+            std::cerr << "Unread ring did not keep the newest datagrams." << std::endl;
+            verified = false;
+        }
+
+        if (bytes_other != 0)
+        {
+            std::cerr << "Datagram from another remote endpoint was not filtered out."
+                    << std::endl;
+            verified = false;
+        }
+    }
+
+    return verified ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,5 +1,6 @@
 #include <QPaintEvent>
 #include <QPainter>
+#include <QResizeEvent>
 
 #include "ui/camera_view.h"
 
@@ -25,10 +26,17 @@ CameraView::paintEvent(QPaintEvent *event)
 
     painter.begin(this);
 
-    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform | QPainter::LosslessImageRendering);
     painter.drawImage(event->rect(), frame_);
 
     painter.end();
 }
+
+void
+CameraView::resizeEvent(QResizeEvent *event)
+{
+    QOpenGLWidget::resizeEvent(event);
+
+    emit sizeChanged(event->size() * devicePixelRatioF());
+}
 }
 }
@@ -15,6 +15,11 @@ public:
 
     explicit CameraView(QWidget* parent = nullptr);
 
+signals:
+
+    void
+    sizeChanged(const QSize& size);
+
 public slots:
 
     void
@@ -25,6 +30,9 @@ protected:
     void
     paintEvent(QPaintEvent *event) override;
 
+    void
+    resizeEvent(QResizeEvent *event) override;
+
 private:
 
     QImage frame_;
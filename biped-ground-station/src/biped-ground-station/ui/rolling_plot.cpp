@@ -36,13 +36,28 @@ RollingPlot::addCurves(const std::vector<QPen>& pens)
 
 void
 RollingPlot::addDataPointToCurve(const size_t& index, const double& x, const double& y)
+{
+    appendDataPointToCurve(index, x, y);
+
+    replot();
+}
+
+void
+RollingPlot::appendDataPointToCurve(const size_t& index, const double& x, const double& y)
 {
     graph(index)->addData(x, y);
 
     updateAxisRangeX(index, x);
     updateAxisRangeY(y);
+}
 
-    replot();
+void
+RollingPlot::clearCurves()
+{
+    for (int index_graph = 0; index_graph < graphCount(); index_graph ++)
+    {
+        graph(index_graph)->data()->clear();
+    }
 }
 
 void
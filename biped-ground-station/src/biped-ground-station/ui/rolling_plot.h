@@ -27,6 +27,12 @@ public:
     void
     addDataPointToCurve(const size_t& index, const double& x, const double& y);
 
+    void
+    appendDataPointToCurve(const size_t& index, const double& x, const double& y);
+
+    void
+    clearCurves();
+
     void
     removeCurve(const size_t& index);
 
@@ -21,7 +21,7 @@ namespace biped
 {
 namespace ground_station
 {
-Window::Window(QWidget *parent) : QWidget(parent), controller_parameter_initialized_(false), parameter_set_pinned_count_(0), planner_parameter_initialized_(false), rendering_fps_cap_biped_message_(UIParameter::window_rendering_fps_cap_default_biped_message), rendering_fps_cap_camera_frame_(UIParameter::window_rendering_fps_cap_default_camera_frame)
+Window::Window(QWidget *parent) : QWidget(parent), consumer_(0), consumer_frame_(0), consumer_frame_subscribed_(false), consumer_subscribed_(false), controller_parameter_initialized_(false), parameter_set_pinned_count_(0), planner_parameter_initialized_(false), rendering_fps_cap_biped_message_(UIParameter::window_rendering_fps_cap_default_biped_message), rendering_fps_cap_camera_frame_(UIParameter::window_rendering_fps_cap_default_camera_frame), tick_last_(0), tick_last_valid_(false)
 {
     biped_message_.controller_parameter.pid_controller_saturation_position_x.input_lower = 0;
     biped_message_.controller_parameter.pid_controller_saturation_position_x.input_upper = 0;
@@ -83,9 +83,9 @@ Window::setRenderingFPSCapCameraFrame(const unsigned& rendering_fps_cap_camera_f
 }
 
 void
-Window::onCameraDaemonFrameReceived(const QImage& frame)
+Window::onCameraDaemonFrameReceived()
 {
-    renderCameraFrame(frame);
+    renderCameraFrame(daemon_camera_->getFrame());
 }
 
 void
@@ -111,33 +111,75 @@ Window::onControllerInputPushButtonApplyClicked()
     const biped::firmware::BipedMessage message_current = biped_message_;
     lock.unlock();
 
-    biped::firmware::BipedMessage message;
+    biped::firmware::ControllerParameter controller_parameter = message_current.controller_parameter;
 
-    message.controller_parameter.pid_controller_gain_attitude_y.proportional = ui_->controller_parameter_balance_double_spin_box_proportional->value();
-    message.controller_parameter.pid_controller_gain_attitude_y.integral = ui_->controller_parameter_balance_double_spin_box_integral->value();
-    message.controller_parameter.pid_controller_gain_attitude_y.differential = ui_->controller_parameter_balance_double_spin_box_differential->value();
-    message.controller_parameter.pid_controller_gain_attitude_y.integral_max = ui_->controller_parameter_balance_double_spin_box_integral_max->value();
+    controller_parameter.pid_controller_gain_attitude_y.proportional = ui_->controller_parameter_balance_double_spin_box_proportional->value();
+    controller_parameter.pid_controller_gain_attitude_y.integral = ui_->controller_parameter_balance_double_spin_box_integral->value();
+    controller_parameter.pid_controller_gain_attitude_y.differential = ui_->controller_parameter_balance_double_spin_box_differential->value();
+    controller_parameter.pid_controller_gain_attitude_y.integral_max = ui_->controller_parameter_balance_double_spin_box_integral_max->value();
 
-    message.controller_parameter.pid_controller_gain_position_x.proportional = ui_->controller_parameter_forward_double_spin_box_proportional->value();
-    message.controller_parameter.pid_controller_gain_position_x.integral = ui_->controller_parameter_forward_double_spin_box_integral->value();
-    message.controller_parameter.pid_controller_gain_position_x.differential = ui_->controller_parameter_forward_double_spin_box_differential->value();
-    message.controller_parameter.pid_controller_gain_position_x.integral_max = ui_->controller_parameter_forward_double_spin_box_integral_max->value();
-    message.controller_parameter.pid_controller_saturation_position_x.input_upper = ui_->controller_parameter_forward_double_spin_box_input_upper->value();
-    message.controller_parameter.pid_controller_saturation_position_x.input_lower = ui_->controller_parameter_forward_double_spin_box_input_lower->value();
+    controller_parameter.pid_controller_gain_position_x.proportional = ui_->controller_parameter_forward_double_spin_box_proportional->value();
+    controller_parameter.pid_controller_gain_position_x.integral = ui_->controller_parameter_forward_double_spin_box_integral->value();
+    controller_parameter.pid_controller_gain_position_x.differential = ui_->controller_parameter_forward_double_spin_box_differential->value();
+    controller_parameter.pid_controller_gain_position_x.integral_max = ui_->controller_parameter_forward_double_spin_box_integral_max->value();
+    controller_parameter.pid_controller_saturation_position_x.input_upper = ui_->controller_parameter_forward_double_spin_box_input_upper->value();
+    controller_parameter.pid_controller_saturation_position_x.input_lower = ui_->controller_parameter_forward_double_spin_box_input_lower->value();
 
-    message.controller_parameter.pid_controller_gain_attitude_z.proportional = ui_->controller_parameter_turning_double_spin_box_proportional->value();
-    message.controller_parameter.pid_controller_gain_attitude_z.integral = ui_->controller_parameter_turning_double_spin_box_integral->value();
-    message.controller_parameter.pid_controller_gain_attitude_z.differential = ui_->controller_parameter_turning_double_spin_box_differential->value();
-    message.controller_parameter.pid_controller_gain_attitude_z.integral_max = ui_->controller_parameter_turning_double_spin_box_integral_max->value();
-    message.controller_parameter.attitude_z_gain_open_loop = ui_->controller_parameter_turning_double_spin_box_open_loop->value();
+    controller_parameter.pid_controller_gain_attitude_z.proportional = ui_->controller_parameter_turning_double_spin_box_proportional->value();
+    controller_parameter.pid_controller_gain_attitude_z.integral = ui_->controller_parameter_turning_double_spin_box_integral->value();
+    controller_parameter.pid_controller_gain_attitude_z.differential = ui_->controller_parameter_turning_double_spin_box_differential->value();
+    controller_parameter.pid_controller_gain_attitude_z.integral_max = ui_->controller_parameter_turning_double_spin_box_integral_max->value();
+    controller_parameter.attitude_z_gain_open_loop = ui_->controller_parameter_turning_double_spin_box_open_loop->value();
+
+    std::vector<biped::firmware::CommandMessage> messages;
+
+    if (controller_parameter.pid_controller_gain_attitude_y != message_current.controller_parameter.pid_controller_gain_attitude_y)
+    {
+        biped::firmware::CommandMessage message(biped::firmware::CommandType::set_gain_attitude_y);
+        message.gain = controller_parameter.pid_controller_gain_attitude_y;
+        messages.push_back(message);
+    }
+
+    if (controller_parameter.pid_controller_gain_position_x != message_current.controller_parameter.pid_controller_gain_position_x)
+    {
+        biped::firmware::CommandMessage message(biped::firmware::CommandType::set_gain_position_x);
+        message.gain = controller_parameter.pid_controller_gain_position_x;
+        messages.push_back(message);
+    }
+
+    if (controller_parameter.pid_controller_saturation_position_x != message_current.controller_parameter.pid_controller_saturation_position_x)
+    {
+        biped::firmware::CommandMessage message(biped::firmware::CommandType::set_saturation_position_x);
+        message.saturation = controller_parameter.pid_controller_saturation_position_x;
+        messages.push_back(message);
+    }
 
-    message.controller_reference.attitude_y = message_current.controller_reference.attitude_y;
-    message.controller_reference.attitude_z = message_current.controller_reference.attitude_z;
-    message.controller_reference.position_x = message_current.controller_reference.position_x;
+    if (controller_parameter.pid_controller_gain_attitude_z != message_current.controller_parameter.pid_controller_gain_attitude_z)
+    {
+        biped::firmware::CommandMessage message(biped::firmware::CommandType::set_gain_attitude_z);
+        message.gain = controller_parameter.pid_controller_gain_attitude_z;
+        messages.push_back(message);
+    }
+
+    if (controller_parameter.attitude_z_gain_open_loop != message_current.controller_parameter.attitude_z_gain_open_loop)
+    {
+        biped::firmware::CommandMessage message(biped::firmware::CommandType::set_gain_open_loop_attitude_z);
+        message.gain_open_loop = controller_parameter.attitude_z_gain_open_loop;
+        messages.push_back(message);
+    }
+
+    if (messages.empty())
+    {
+        logToStatusBar("Controller parameters unchanged.");
+        return;
+    }
 
     logToStatusBar("Sending controller parameters...");
 
-    emit operateOutboundDaemon(message);
+    for (const auto& message : messages)
+    {
+        emit operateOutboundDaemon(message);
+    }
 }
 
 void
@@ -269,13 +311,67 @@ Window::onControllerResponsePlotPushButtonZoomToFitTurningClicked()
 }
 
 void
-Window::onInboundDaemonMessageReceived(const biped::firmware::BipedMessage& message)
+Window::onInboundDaemonFramePublished()
 {
+    if (!consumer_frame_subscribed_)
+    {
+        return;
+    }
+
+    biped::firmware::TelemetryFrame frame;
+    bool received = false;
+
+    /*
+     *  Take every telemetry frame rather than the latest, such that the controller response plots get every real-time
+     *  task tick, and only replot once per capped render.
+     */
+    while (daemon_inbound_->getTelemetryFrameBus().read(consumer_frame_, frame))
+    {
+        renderTelemetryFrame(frame);
+        received = true;
+    }
+
+    if (!received || rendering_fps_cap_biped_message_ == 0)
+    {
+        return;
+    }
+
+    const unsigned long duration_since_last_render = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - time_point_last_render_telemetry_frame_).count();
+
+    if (duration_since_last_render < fpsToMilliseconds(rendering_fps_cap_biped_message_))
+    {
+        return;
+    }
+
+    ui_->controller_response_plot_balance->replot();
+    ui_->controller_response_plot_forward->replot();
+    ui_->controller_response_plot_turning->replot();
+
+    time_point_last_render_telemetry_frame_ = std::chrono::system_clock::now();
+}
+
+void
+Window::onInboundDaemonMessagePublished()
+{
+    if (!consumer_subscribed_)
+    {
+        return;
+    }
+
+    bool received = false;
     std::unique_lock<std::mutex> lock(mutex_biped_message_);
-    biped_message_ = message;
+
+    while (daemon_inbound_->getTelemetryBus().readLatest(consumer_, biped_message_))
+    {
+        received = true;
+    }
+
     lock.unlock();
 
-    renderBipedMessage(message);
+    if (received)
+    {
+        renderBipedMessage(biped_message_);
+    }
 }
 
 void
@@ -553,29 +649,11 @@ Window::onPlannerParameterPushButtonApplyClicked()
     const biped::firmware::BipedMessage message_current = biped_message_;
     lock.unlock();
 
-    biped::firmware::BipedMessage message;
-
-    message.controller_parameter.pid_controller_gain_attitude_y.proportional = message_current.controller_parameter.pid_controller_gain_attitude_y.proportional;
-    message.controller_parameter.pid_controller_gain_attitude_y.integral = message_current.controller_parameter.pid_controller_gain_attitude_y.integral;
-    message.controller_parameter.pid_controller_gain_attitude_y.differential = message_current.controller_parameter.pid_controller_gain_attitude_y.differential;
-    message.controller_parameter.pid_controller_gain_attitude_y.integral_max = message_current.controller_parameter.pid_controller_gain_attitude_y.integral_max;
-
-    message.controller_parameter.pid_controller_gain_position_x.proportional = message_current.controller_parameter.pid_controller_gain_position_x.proportional;
-    message.controller_parameter.pid_controller_gain_position_x.integral = message_current.controller_parameter.pid_controller_gain_position_x.integral;
-    message.controller_parameter.pid_controller_gain_position_x.differential = message_current.controller_parameter.pid_controller_gain_position_x.differential;
-    message.controller_parameter.pid_controller_gain_position_x.integral_max = message_current.controller_parameter.pid_controller_gain_position_x.integral_max;
-    message.controller_parameter.pid_controller_saturation_position_x.input_upper = message_current.controller_parameter.pid_controller_saturation_position_x.input_upper;
-    message.controller_parameter.pid_controller_saturation_position_x.input_lower = message_current.controller_parameter.pid_controller_saturation_position_x.input_lower;
-
-    message.controller_parameter.pid_controller_gain_attitude_z.proportional = message_current.controller_parameter.pid_controller_gain_attitude_z.proportional;
-    message.controller_parameter.pid_controller_gain_attitude_z.integral = message_current.controller_parameter.pid_controller_gain_attitude_z.integral;
-    message.controller_parameter.pid_controller_gain_attitude_z.differential = message_current.controller_parameter.pid_controller_gain_attitude_z.differential;
-    message.controller_parameter.pid_controller_gain_attitude_z.integral_max = message_current.controller_parameter.pid_controller_gain_attitude_z.integral_max;
-    message.controller_parameter.attitude_z_gain_open_loop =  message_current.controller_parameter.attitude_z_gain_open_loop;
+    biped::firmware::CommandMessage message(biped::firmware::CommandType::set_reference);
 
-    message.controller_reference.attitude_y = message_current.controller_reference.attitude_y;
-    message.controller_reference.attitude_z = degreesToRadians(ui_->planner_parameter_double_spin_box_turning->value());
-    message.controller_reference.position_x = ui_->planner_parameter_double_spin_box_forward->value();
+    message.reference.attitude_y = message_current.controller_reference.attitude_y;
+    message.reference.attitude_z = degreesToRadians(ui_->planner_parameter_double_spin_box_turning->value());
+    message.reference.position_x = ui_->planner_parameter_double_spin_box_forward->value();
 
     logToStatusBar("Sending planner parameters...");
 
@@ -647,6 +725,51 @@ Window::onSettingsLoggingPushButtonStopClicked()
     ui_->settings_logging_push_button_stop->setEnabled(false);
 }
 
+void
+Window::onSettingsTelemetryPushButtonApplyClicked()
+{
+    biped::firmware::SubscriptionMessage message;
+
+    switch (ui_->settings_telemetry_combo_box_subscription->currentIndex())
+    {
+        case 1:
+        {
+            message.subscription.field_mask = 0;
+            message.subscription.subscribe(biped::firmware::TelemetryField::actuation_flags);
+            message.subscription.subscribe(biped::firmware::TelemetryField::angular_velocity_y);
+            message.subscription.subscribe(biped::firmware::TelemetryField::attitude_y);
+            message.subscription.subscribe(biped::firmware::TelemetryField::motor_left_pwm);
+            message.subscription.subscribe(biped::firmware::TelemetryField::motor_right_pwm);
+            message.subscription.subscribe(biped::firmware::TelemetryField::position_x, UIParameter::window_telemetry_divisor_balance_position);
+            message.subscription.subscribe(biped::firmware::TelemetryField::reference_attitude_y);
+            message.subscription.subscribe(biped::firmware::TelemetryField::timestamp);
+            break;
+        }
+        case 2:
+        {
+            message.subscription.field_mask = 0;
+            message.subscription.subscribe(biped::firmware::TelemetryField::attitude_z, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::position_x, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::range_left, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::range_middle, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::range_right, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::reference_attitude_z, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::reference_position_x, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::timestamp, UIParameter::window_telemetry_divisor_navigation);
+            message.subscription.subscribe(biped::firmware::TelemetryField::velocity_x, UIParameter::window_telemetry_divisor_navigation);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    logToStatusBar("Sending telemetry subscription...");
+
+    emit operateOutboundDaemonSubscription(message);
+}
+
 void
 Window::onSettingsThemePushButtonLoadClicked()
 {
@@ -692,13 +815,31 @@ Window::onSettingsThemePushButtonResetClicked()
     logToStatusBar("Reset to default theme.");
 }
 
+void
+Window::onTelemetryTimingPlotPushButtonZoomToFitExecutionTimeClicked()
+{
+    ui_->telemetry_timing_plot_execution_time->zoomToFit();
+}
+
+void
+Window::onTelemetryTimingPlotPushButtonZoomToFitIntervalClicked()
+{
+    ui_->telemetry_timing_plot_interval->zoomToFit();
+}
+
+void
+Window::onTelemetryTimingPlotPushButtonZoomToFitStageClicked()
+{
+    ui_->telemetry_timing_plot_stage->zoomToFit();
+}
+
 void
 Window::connectSignals()
 {
     disconnectSignals();
 
     connect(daemon_camera_.get(), &CameraDaemon::frameReceived, this, &Window::onCameraDaemonFrameReceived);
-    connect(daemon_inbound_.get(), &InboundDaemon::messageReceived, this, &Window::onInboundDaemonMessageReceived);
+    connect(ui_->camera_view, &CameraView::sizeChanged, daemon_camera_.get(), &CameraDaemon::setDisplaySize, Qt::DirectConnection);
     connect(daemon_joypad_.get(), &JoypadDaemon::xChanged, ui_->planner_joypad, &JoyPad::setX);
     connect(daemon_joypad_.get(), &JoypadDaemon::yChanged, ui_->planner_joypad, &JoyPad::setY);
     connect(ui_->controller_input_push_button_apply, &QPushButton::clicked, this, &Window::onControllerInputPushButtonApplyClicked);
@@ -716,15 +857,28 @@ Window::connectSignals()
     connect(ui_->settings_biped_ip_address_push_button_apply, &QPushButton::clicked, this, &Window::onSettingsBipedIPAddressPushButtonApplyClicked);
     connect(ui_->settings_logging_push_button_start, &QPushButton::clicked, this, &Window::onSettingsLoggingPushButtonStartClicked);
     connect(ui_->settings_logging_push_button_stop, &QPushButton::clicked, this, &Window::onSettingsLoggingPushButtonStopClicked);
+    connect(ui_->settings_telemetry_push_button_apply, &QPushButton::clicked, this, &Window::onSettingsTelemetryPushButtonApplyClicked);
     connect(ui_->settings_theme_push_button_load, &QPushButton::clicked, this, &Window::onSettingsThemePushButtonLoadClicked);
     connect(ui_->settings_theme_push_button_reset, &QPushButton::clicked, this, &Window::onSettingsThemePushButtonResetClicked);
+    connect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_execution_time, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitExecutionTimeClicked);
+    connect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_interval, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitIntervalClicked);
+    connect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_stage, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitStageClicked);
+
+    consumer_subscribed_ = daemon_inbound_->getTelemetryBus().subscribe([this]()
+    {
+        QMetaObject::invokeMethod(this, &Window::onInboundDaemonMessagePublished, Qt::QueuedConnection);
+    }, consumer_);
+    consumer_frame_subscribed_ = daemon_inbound_->getTelemetryFrameBus().subscribe([this]()
+    {
+        QMetaObject::invokeMethod(this, &Window::onInboundDaemonFramePublished, Qt::QueuedConnection);
+    }, consumer_frame_);
 }
 
 void
 Window::disconnectSignals()
 {
     disconnect(daemon_camera_.get(), &CameraDaemon::frameReceived, this, &Window::onCameraDaemonFrameReceived);
-    disconnect(daemon_inbound_.get(), &InboundDaemon::messageReceived, this, &Window::onInboundDaemonMessageReceived);
+    disconnect(ui_->camera_view, &CameraView::sizeChanged, daemon_camera_.get(), &CameraDaemon::setDisplaySize);
     disconnect(daemon_joypad_.get(), &JoypadDaemon::xChanged, ui_->planner_joypad, &JoyPad::setX);
     disconnect(daemon_joypad_.get(), &JoypadDaemon::yChanged, ui_->planner_joypad, &JoyPad::setY);
     disconnect(ui_->controller_input_push_button_apply, &QPushButton::clicked, this, &Window::onControllerInputPushButtonApplyClicked);
@@ -742,30 +896,71 @@ Window::disconnectSignals()
     disconnect(ui_->settings_biped_ip_address_push_button_apply, &QPushButton::clicked, this, &Window::onSettingsBipedIPAddressPushButtonApplyClicked);
     disconnect(ui_->settings_logging_push_button_start, &QPushButton::clicked, this, &Window::onSettingsLoggingPushButtonStartClicked);
     disconnect(ui_->settings_logging_push_button_stop, &QPushButton::clicked, this, &Window::onSettingsLoggingPushButtonStopClicked);
+    disconnect(ui_->settings_telemetry_push_button_apply, &QPushButton::clicked, this, &Window::onSettingsTelemetryPushButtonApplyClicked);
     disconnect(ui_->settings_theme_push_button_load, &QPushButton::clicked, this, &Window::onSettingsThemePushButtonLoadClicked);
     disconnect(ui_->settings_theme_push_button_reset, &QPushButton::clicked, this, &Window::onSettingsThemePushButtonResetClicked);
+    disconnect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_execution_time, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitExecutionTimeClicked);
+    disconnect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_interval, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitIntervalClicked);
+    disconnect(ui_->telemetry_timing_plot_push_button_zoom_to_fit_stage, &QPushButton::clicked, this, &Window::onTelemetryTimingPlotPushButtonZoomToFitStageClicked);
+
+    if (consumer_subscribed_)
+    {
+        daemon_inbound_->getTelemetryBus().unsubscribe(consumer_);
+        consumer_subscribed_ = false;
+    }
+
+    if (consumer_frame_subscribed_)
+    {
+        daemon_inbound_->getTelemetryFrameBus().unsubscribe(consumer_frame_);
+        consumer_frame_subscribed_ = false;
+    }
 }
 
 void
 Window::initialize()
 {
     std::vector<QPen> controller_response_plot_pens = {QPen(Qt::red, 2), QPen(Qt::green, 2)};
+    std::vector<QPen> telemetry_timing_plot_pens = {QPen(Qt::green, 2), QPen(Qt::yellow, 2), QPen(Qt::red, 2)};
+    std::vector<QPen> telemetry_timing_plot_pens_stage = {QPen(Qt::cyan, 2), QPen(Qt::magenta, 2), QPen(Qt::green, 2), QPen(Qt::red, 2)};
+    std::vector<QString> telemetry_timing_plot_names = {"p50", "p99", "max"};
+    std::vector<QString> telemetry_timing_plot_names_stage = {"sense fast", "sense slow", "control", "actuate"};
     QString regular_expression_ip_address_octet = "(?:[0-1]?[0-9]?[0-9]|2[0-4][0-9]|25[0-5])";
     QRegularExpression regular_expression_ip_address("^" + regular_expression_ip_address_octet + "(\\." + regular_expression_ip_address_octet + ")" + "(\\." + regular_expression_ip_address_octet + ")" + "(\\." + regular_expression_ip_address_octet + ")$");
     QRegularExpressionValidator *validator_ip_address = new QRegularExpressionValidator(regular_expression_ip_address, this);
 
     ui_->controller_response_plot_balance->addCurves(controller_response_plot_pens);
+    ui_->controller_response_plot_balance->setRollingWindowCapacity(UIParameter::window_controller_response_plot_rolling_window_capacity);
     ui_->controller_response_plot_balance->xAxis->grid()->setVisible(false);
     ui_->controller_response_plot_balance->xAxis->setTickLabels(false);
     ui_->controller_response_plot_balance->xAxis->setTicks(false);
     ui_->controller_response_plot_forward->addCurves(controller_response_plot_pens);
+    ui_->controller_response_plot_forward->setRollingWindowCapacity(UIParameter::window_controller_response_plot_rolling_window_capacity);
     ui_->controller_response_plot_forward->xAxis->grid()->setVisible(false);
     ui_->controller_response_plot_forward->xAxis->setTickLabels(false);
     ui_->controller_response_plot_forward->xAxis->setTicks(false);
     ui_->controller_response_plot_turning->addCurves(controller_response_plot_pens);
+    ui_->controller_response_plot_turning->setRollingWindowCapacity(UIParameter::window_controller_response_plot_rolling_window_capacity);
     ui_->controller_response_plot_turning->xAxis->grid()->setVisible(false);
     ui_->controller_response_plot_turning->xAxis->setTickLabels(false);
     ui_->controller_response_plot_turning->xAxis->setTicks(false);
+
+    for (RollingPlot* plot : {ui_->telemetry_timing_plot_interval, ui_->telemetry_timing_plot_execution_time, ui_->telemetry_timing_plot_stage})
+    {
+        const bool stage = plot == ui_->telemetry_timing_plot_stage;
+
+        plot->addCurves(stage ? telemetry_timing_plot_pens_stage : telemetry_timing_plot_pens);
+
+        for (int i = 0; i < plot->graphCount(); i ++)
+        {
+            plot->graph(i)->setName(stage ? telemetry_timing_plot_names_stage[i] : telemetry_timing_plot_names[i]);
+        }
+
+        plot->legend->setVisible(true);
+        plot->xAxis->grid()->setVisible(false);
+        plot->xAxis->setTickLabels(false);
+        plot->xAxis->setTicks(false);
+    }
+
     ui_->settings_biped_ip_address_line_edit->setValidator(validator_ip_address);
     ui_->settings_biped_ip_address_line_edit->setText(QString::fromStdString(ip_biped_));
     ui_->settings_logging_push_button_stop->setEnabled(false);
@@ -849,8 +1044,8 @@ Window::initialize()
     {
         thread_daemon_logging_ = std::make_unique<QThread>();
 
-        connect(daemon_camera_.get(), &CameraDaemon::frameReceived, daemon_logging_.get(), &LoggingDaemon::onCameraDaemonFrameReceived);
-        connect(daemon_inbound_.get(), &InboundDaemon::messageReceived, daemon_logging_.get(), &LoggingDaemon::onInboundDaemonMessageReceived);
+        connect(daemon_camera_.get(), &CameraDaemon::frameDataReceived, daemon_logging_.get(), &LoggingDaemon::onCameraDaemonFrameDataReceived);
+        connect(daemon_camera_.get(), &CameraDaemon::frameStatisticsUpdated, daemon_logging_.get(), &LoggingDaemon::onCameraDaemonFrameStatisticsUpdated);
 
         daemon_logging_->moveToThread(thread_daemon_logging_.get());
         thread_daemon_logging_->start();
@@ -865,6 +1060,9 @@ Window::initialize()
         thread_daemon_outbound_ = std::make_unique<QThread>();
 
         connect(this, &Window::operateOutboundDaemon, daemon_outbound_.get(), &OutboundDaemon::operate);
+        connect(this, &Window::operateOutboundDaemonSubscription, daemon_outbound_.get(), &OutboundDaemon::operateSubscription);
+        connect(daemon_camera_.get(), &CameraDaemon::feedbackUpdated, daemon_outbound_.get(), &OutboundDaemon::operateCameraFeedback);
+        connect(daemon_inbound_.get(), &InboundDaemon::acknowledgementReceived, daemon_outbound_.get(), &OutboundDaemon::onInboundDaemonAcknowledgementReceived);
 
         daemon_outbound_->moveToThread(thread_daemon_outbound_.get());
         thread_daemon_outbound_->start();
@@ -964,6 +1162,9 @@ Window::renderBipedMessage(const biped::firmware::BipedMessage& message)
     ui_->data_imu_data_label_value_angular_velocity_x->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_x), 'f', 5));
     ui_->data_imu_data_label_value_angular_velocity_y->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_y), 'f', 5));
     ui_->data_imu_data_label_value_angular_velocity_z->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_z), 'f', 5));
+    ui_->data_imu_data_label_value_angular_velocity_bias_x->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_bias_x), 'f', 5));
+    ui_->data_imu_data_label_value_angular_velocity_bias_y->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_bias_y), 'f', 5));
+    ui_->data_imu_data_label_value_angular_velocity_bias_z->setText(QString::number(radiansToDegrees(message.imu_data.angular_velocity_bias_z), 'f', 5));
     ui_->data_imu_data_label_value_compass_x->setText(QString::number(message.imu_data.compass_x, 'f', 5));
     ui_->data_imu_data_label_value_compass_y->setText(QString::number(message.imu_data.compass_y, 'f', 5));
     ui_->data_imu_data_label_value_compass_z->setText(QString::number(message.imu_data.compass_z, 'f', 5));
@@ -973,6 +1174,8 @@ Window::renderBipedMessage(const biped::firmware::BipedMessage& message)
     ui_->data_encoder_data_label_value_steps->setText(QString::number(message.encoder_data.steps));
     ui_->data_encoder_data_label_value_steps_left->setText(QString::number(message.encoder_data.steps_left));
     ui_->data_encoder_data_label_value_steps_right->setText(QString::number(message.encoder_data.steps_right));
+    ui_->data_encoder_data_label_value_transition_errors_left->setText(QString::number(message.encoder_data.transition_errors_left));
+    ui_->data_encoder_data_label_value_transition_errors_right->setText(QString::number(message.encoder_data.transition_errors_right));
     ui_->data_encoder_data_label_value_velocity_x->setText(QString::number(message.encoder_data.velocity_x, 'f', 5));
 
     if (message.time_of_flight_data.range_left < 10000)
@@ -1183,12 +1386,25 @@ Window::renderBipedMessage(const biped::firmware::BipedMessage& message)
         }
     }
 
-    ui_->controller_response_plot_balance->addDataPointToCurve(0, duration_since_epoch, radiansToDegrees(message.imu_data.attitude_y));
-    ui_->controller_response_plot_balance->addDataPointToCurve(1, duration_since_epoch, radiansToDegrees(message.controller_reference.attitude_y));
-    ui_->controller_response_plot_forward->addDataPointToCurve(0, duration_since_epoch, message.encoder_data.position_x);
-    ui_->controller_response_plot_forward->addDataPointToCurve(1, duration_since_epoch, message.controller_reference.position_x);
-    ui_->controller_response_plot_turning->addDataPointToCurve(0, duration_since_epoch, radiansToDegrees(message.imu_data.attitude_z));
-    ui_->controller_response_plot_turning->addDataPointToCurve(1, duration_since_epoch, radiansToDegrees(message.controller_reference.attitude_z));
+    if (message.telemetry.interval.count > 0)
+    {
+        ui_->telemetry_timing_plot_interval->addDataPointToCurve(0, duration_since_epoch, message.telemetry.interval.percentile_50);
+        ui_->telemetry_timing_plot_interval->addDataPointToCurve(1, duration_since_epoch, message.telemetry.interval.percentile_99);
+        ui_->telemetry_timing_plot_interval->addDataPointToCurve(2, duration_since_epoch, message.telemetry.interval.maximum);
+    }
+
+    if (message.telemetry.execution_time.count > 0)
+    {
+        ui_->telemetry_timing_plot_execution_time->addDataPointToCurve(0, duration_since_epoch, message.telemetry.execution_time.percentile_50);
+        ui_->telemetry_timing_plot_execution_time->addDataPointToCurve(1, duration_since_epoch, message.telemetry.execution_time.percentile_99);
+        ui_->telemetry_timing_plot_execution_time->addDataPointToCurve(2, duration_since_epoch, message.telemetry.execution_time.maximum);
+        ui_->telemetry_timing_plot_stage->addDataPointToCurve(0, duration_since_epoch, message.telemetry.execution_time_sense_fast.percentile_99);
+        ui_->telemetry_timing_plot_stage->addDataPointToCurve(1, duration_since_epoch, message.telemetry.execution_time_sense_slow.percentile_99);
+        ui_->telemetry_timing_plot_stage->addDataPointToCurve(2, duration_since_epoch, message.telemetry.execution_time_control.percentile_99);
+        ui_->telemetry_timing_plot_stage->addDataPointToCurve(3, duration_since_epoch, message.telemetry.execution_time_actuate.percentile_99);
+    }
+
+    ui_->telemetry_deadline_label_value_deadline_miss->setText(QString::number(message.telemetry.deadline_miss));
 
     if (controller_parameter_updated)
     {
@@ -1214,6 +1430,55 @@ Window::renderBipedMessage(const biped::firmware::BipedMessage& message)
     time_point_last_render_biped_message_ = std::chrono::system_clock::now();
 }
 
+void
+Window::renderTelemetryFrame(const biped::firmware::TelemetryFrame& frame)
+{
+    if (rendering_fps_cap_biped_message_ == 0)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < frame.sample_count && i < frame.capacity; i ++)
+    {
+        const biped::firmware::TelemetrySample& sample = frame.samples[i];
+
+        /*
+         *  Skip the samples of a late telemetry frame, and start over once the Biped restarts with a lower tick.
+         */
+        if (tick_last_valid_ && sample.tick <= tick_last_)
+        {
+            if (tick_last_ - sample.tick < UIParameter::window_controller_response_plot_rolling_window_capacity)
+            {
+                continue;
+            }
+
+            ui_->controller_response_plot_balance->clearCurves();
+            ui_->controller_response_plot_forward->clearCurves();
+            ui_->controller_response_plot_turning->clearCurves();
+        }
+
+        tick_last_ = sample.tick;
+        tick_last_valid_ = true;
+
+        const auto appendField = [&](RollingPlot* plot, const size_t& index, const biped::firmware::TelemetryField& field, const bool& angle)
+        {
+            if (frame.subscription.includes(static_cast<size_t>(field), sample.tick))
+            {
+                const double value = sample.getField(field);
+
+                plot->appendDataPointToCurve(index, sample.tick, angle ? radiansToDegrees(value) : value);
+            }
+        };
+
+        appendField(ui_->controller_response_plot_balance, 0, biped::firmware::TelemetryField::attitude_y, true);
+        appendField(ui_->controller_response_plot_balance, 1, biped::firmware::TelemetryField::reference_attitude_y, true);
+        appendField(ui_->controller_response_plot_forward, 0, biped::firmware::TelemetryField::position_x, false);
+        appendField(ui_->controller_response_plot_forward, 1, biped::firmware::TelemetryField::reference_position_x, false);
+        appendField(ui_->controller_response_plot_turning, 0, biped::firmware::TelemetryField::attitude_z, true);
+        appendField(ui_->controller_response_plot_turning, 1, biped::firmware::TelemetryField::reference_attitude_z, true);
+    }
+}
+
 void
 Window::resetControllerParameterLabelCurrentStyle()
 {
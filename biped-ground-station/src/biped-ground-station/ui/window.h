@@ -55,12 +55,15 @@ signals:
     operateJoypadDaemon();
 
     void
-    operateOutboundDaemon(const biped::firmware::BipedMessage& message);
+    operateOutboundDaemon(const biped::firmware::CommandMessage& message);
+
+    void
+    operateOutboundDaemonSubscription(const biped::firmware::SubscriptionMessage& message);
 
 private slots:
 
     void
-    onCameraDaemonFrameReceived(const QImage& frame);
+    onCameraDaemonFrameReceived();
 
     void
     onControllerInputPushButtonApplyClicked();
@@ -81,7 +84,10 @@ private slots:
     onControllerResponsePlotPushButtonZoomToFitTurningClicked();
 
     void
-    onInboundDaemonMessageReceived(const biped::firmware::BipedMessage& message);
+    onInboundDaemonFramePublished();
+
+    void
+    onInboundDaemonMessagePublished();
 
     void
     onParametersInputPushButtonDeleteAllClicked();
@@ -122,12 +128,24 @@ private slots:
     void
     onSettingsLoggingPushButtonStopClicked();
 
+    void
+    onSettingsTelemetryPushButtonApplyClicked();
+
     void
     onSettingsThemePushButtonLoadClicked();
 
     void
     onSettingsThemePushButtonResetClicked();
 
+    void
+    onTelemetryTimingPlotPushButtonZoomToFitExecutionTimeClicked();
+
+    void
+    onTelemetryTimingPlotPushButtonZoomToFitIntervalClicked();
+
+    void
+    onTelemetryTimingPlotPushButtonZoomToFitStageClicked();
+
 private:
 
     void
@@ -145,6 +163,9 @@ private:
     void
     renderBipedMessage(const biped::firmware::BipedMessage& message);
 
+    void
+    renderTelemetryFrame(const biped::firmware::TelemetryFrame& frame);
+
     void
     resetControllerParameterLabelCurrentStyle();
 
@@ -153,6 +174,10 @@ private:
 
     biped::firmware::BipedMessage biped_message_;
     biped::firmware::BipedMessage biped_message_render_;
+    size_t consumer_;
+    size_t consumer_frame_;
+    bool consumer_frame_subscribed_;
+    bool consumer_subscribed_;
     bool controller_parameter_initialized_;
     std::mutex mutex_biped_message_;
     std::mutex mutex_status_bar_;
@@ -166,8 +191,11 @@ private:
     std::unique_ptr<QThread> thread_daemon_joypad_;
     std::unique_ptr<QThread> thread_daemon_logging_;
     std::unique_ptr<QThread> thread_daemon_outbound_;
+    uint32_t tick_last_;
+    bool tick_last_valid_;
     std::chrono::time_point<std::chrono::system_clock> time_point_last_render_biped_message_;
     std::chrono::time_point<std::chrono::system_clock> time_point_last_render_camera_frame_;
+    std::chrono::time_point<std::chrono::system_clock> time_point_last_render_telemetry_frame_;
     std::unique_ptr<Ui::Window> ui_;
 };
 }
@@ -0,0 +1,583 @@
+#include <algorithm>
+#include <cstring>
+
+#ifdef BIPED_GROUND_STATION_LZ4
+#include <lz4.h>
+#endif
+
+#include "utility/binary_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+namespace
+{
+template<typename Type>
+void
+writeValue(std::ostream& output, const Type& value)
+{
+    output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename Type>
+bool
+readValue(std::istream& input, Type& value)
+{
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+template<typename Type>
+Type
+loadValue(const char* pointer)
+{
+    Type value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+}
+}
+
+size_t
+getBinaryLogTypeSize(const BinaryLogType& type)
+{
+    switch (type)
+    {
+        case BinaryLogType::boolean:
+        case BinaryLogType::int8:
+        case BinaryLogType::uint8:
+            return 1;
+        case BinaryLogType::int16:
+        case BinaryLogType::uint16:
+            return 2;
+        case BinaryLogType::float32:
+        case BinaryLogType::int32:
+        case BinaryLogType::uint32:
+            return 4;
+        case BinaryLogType::float64:
+        case BinaryLogType::int64:
+        case BinaryLogType::uint64:
+            return 8;
+    }
+
+    return 0;
+}
+
+bool
+isBinaryLogCompressionAvailable()
+{
+#ifdef BIPED_GROUND_STATION_LZ4
+    return true;
+#else
+    return false;
+#endif
+}
+
+BinaryLogWriter::BinaryLogWriter() : byte_count_(0), compression_(BinaryLogCompression::none), failed_(false), index_block_(0), index_block_pending_(0), open_(false), pending_(false), record_capacity_(0), record_count_(0), record_size_(0), stopping_(false)
+{
+}
+
+BinaryLogWriter::~BinaryLogWriter()
+{
+    close();
+}
+
+void
+BinaryLogWriter::close()
+{
+    if (!open_)
+    {
+        return;
+    }
+
+    if (blocks_[index_block_].record_count > 0)
+    {
+        submit();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+    lock.unlock();
+
+    condition_.notify_all();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+
+    file_.close();
+    open_ = false;
+}
+
+bool
+BinaryLogWriter::failed() const
+{
+    return failed_;
+}
+
+void
+BinaryLogWriter::flush()
+{
+    if (!open_ || blocks_[index_block_].record_count == 0)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (pending_)
+    {
+        return;
+    }
+
+    lock.unlock();
+
+    submit();
+}
+
+unsigned long long
+BinaryLogWriter::getByteCount() const
+{
+    return byte_count_;
+}
+
+unsigned long long
+BinaryLogWriter::getRecordCount() const
+{
+    return record_count_;
+}
+
+bool
+BinaryLogWriter::isOpen() const
+{
+    return open_;
+}
+
+bool
+BinaryLogWriter::open(const std::filesystem::path& path, const std::vector<BinaryLogColumn>& columns, const size_t& block_size, const bool& compressed)
+{
+    close();
+
+    columns_ = columns;
+    offsets_column_.clear();
+    record_size_ = 0;
+
+    for (const auto& column : columns_)
+    {
+        record_size_ += getBinaryLogTypeSize(column.type);
+    }
+
+    if (columns_.empty() || record_size_ == 0)
+    {
+        return false;
+    }
+
+    record_capacity_ = std::max<size_t>(block_size / record_size_, 1);
+
+    size_t offset = 0;
+
+    for (const auto& column : columns_)
+    {
+        offsets_column_.push_back(offset);
+        offset += record_capacity_ * getBinaryLogTypeSize(column.type);
+    }
+
+    for (auto& block : blocks_)
+    {
+        block.data.resize(record_capacity_ * record_size_);
+        block.record_count = 0;
+    }
+
+    compression_ = compressed && isBinaryLogCompressionAvailable() ? BinaryLogCompression::lz4 : BinaryLogCompression::none;
+
+#ifdef BIPED_GROUND_STATION_LZ4
+    if (compression_ == BinaryLogCompression::lz4)
+    {
+        buffer_compression_.resize(LZ4_compressBound(static_cast<int>(record_capacity_ * record_size_)));
+    }
+#endif
+
+    file_.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+    if (!file_.is_open())
+    {
+        return false;
+    }
+
+    file_.write(BinaryLogFormat::magic, sizeof(BinaryLogFormat::magic) - 1);
+    writeValue(file_, BinaryLogFormat::version);
+    writeValue(file_, static_cast<uint32_t>(columns_.size()));
+
+    for (const auto& column : columns_)
+    {
+        const uint16_t name_length = static_cast<uint16_t>(std::strlen(column.name));
+
+        writeValue(file_, column.type);
+        writeValue(file_, name_length);
+        file_.write(column.name, name_length);
+    }
+
+    if (!file_)
+    {
+        file_.close();
+        return false;
+    }
+
+    byte_count_ = file_.tellp();
+    failed_ = false;
+    index_block_ = 0;
+    open_ = true;
+    pending_ = false;
+    record_count_ = 0;
+    stopping_ = false;
+    thread_ = std::thread(&BinaryLogWriter::run, this);
+
+    return true;
+}
+
+void
+BinaryLogWriter::write(const void* record)
+{
+    if (!open_)
+    {
+        return;
+    }
+
+    Block& block = blocks_[index_block_];
+    const char* source = static_cast<const char*>(record);
+
+    for (size_t i = 0; i < columns_.size(); i ++)
+    {
+        const size_t size = getBinaryLogTypeSize(columns_[i].type);
+
+        std::memcpy(block.data.data() + offsets_column_[i] + block.record_count * size, source + columns_[i].offset, size);
+    }
+
+    block.record_count ++;
+    record_count_ ++;
+
+    if (block.record_count == record_capacity_)
+    {
+        submit();
+    }
+}
+
+void
+BinaryLogWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;)
+    {
+        condition_.wait(lock, [this]()
+        {
+            return pending_ || stopping_;
+        });
+
+        if (!pending_)
+        {
+            return;
+        }
+
+        Block& block = blocks_[index_block_pending_];
+        lock.unlock();
+
+        writeBlock(block);
+
+        lock.lock();
+        pending_ = false;
+        condition_.notify_all();
+    }
+}
+
+void
+BinaryLogWriter::submit()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    /*
+     *  Wait for the I/O thread to be done with the other block before handing this one over.
+     */
+    condition_.wait(lock, [this]()
+    {
+        return !pending_;
+    });
+
+    index_block_pending_ = index_block_;
+    index_block_ = 1 - index_block_;
+    blocks_[index_block_].record_count = 0;
+    pending_ = true;
+    lock.unlock();
+
+    condition_.notify_all();
+}
+
+void
+BinaryLogWriter::writeBlock(Block& block)
+{
+    const size_t record_count = block.record_count;
+    size_t size_raw = 0;
+
+    /*
+     *  Close the gaps left by a partially filled block, such that the columns lie back to back.
+     */
+    for (size_t i = 0; i < columns_.size(); i ++)
+    {
+        const size_t size = record_count * getBinaryLogTypeSize(columns_[i].type);
+
+        if (offsets_column_[i] != size_raw)
+        {
+            std::memmove(block.data.data() + size_raw, block.data.data() + offsets_column_[i], size);
+        }
+
+        size_raw += size;
+    }
+
+    BinaryLogCompression compression = BinaryLogCompression::none;
+    const char* payload = block.data.data();
+    size_t size_stored = size_raw;
+
+#ifdef BIPED_GROUND_STATION_LZ4
+    if (compression_ == BinaryLogCompression::lz4)
+    {
+        const int size_compressed = LZ4_compress_default(block.data.data(), buffer_compression_.data(), static_cast<int>(size_raw), static_cast<int>(buffer_compression_.size()));
+
+        /*
+         *  Store the chunk raw if it does not compress.
+         */
+        if (size_compressed > 0 && static_cast<size_t>(size_compressed) < size_raw)
+        {
+            compression = BinaryLogCompression::lz4;
+            payload = buffer_compression_.data();
+            size_stored = size_compressed;
+        }
+    }
+#endif
+
+    writeValue(file_, BinaryLogFormat::magic_chunk);
+    writeValue(file_, static_cast<uint32_t>(record_count));
+    writeValue(file_, compression);
+    writeValue(file_, static_cast<uint32_t>(size_raw));
+    writeValue(file_, static_cast<uint32_t>(size_stored));
+    file_.write(payload, size_stored);
+    file_.flush();
+
+    if (!file_)
+    {
+        failed_ = true;
+    }
+
+    byte_count_ += 3 * sizeof(uint32_t) + sizeof(compression) + sizeof(uint32_t) + size_stored;
+}
+
+BinaryLogReader::BinaryLogReader() : record_count_(0)
+{
+}
+
+void
+BinaryLogReader::formatValue(std::ostream& output, const size_t& column, const size_t& record) const
+{
+    const BinaryLogType type = fields_[column].type;
+    const char* pointer = chunk_.data() + offsets_field_[column] + record * getBinaryLogTypeSize(type);
+
+    switch (type)
+    {
+        case BinaryLogType::boolean:
+            output << loadValue<bool>(pointer);
+            break;
+        case BinaryLogType::float32:
+            output << loadValue<float>(pointer);
+            break;
+        case BinaryLogType::float64:
+            output << loadValue<double>(pointer);
+            break;
+        case BinaryLogType::int8:
+            output << static_cast<int>(loadValue<int8_t>(pointer));
+            break;
+        case BinaryLogType::int16:
+            output << loadValue<int16_t>(pointer);
+            break;
+        case BinaryLogType::int32:
+            output << loadValue<int32_t>(pointer);
+            break;
+        case BinaryLogType::int64:
+            output << loadValue<int64_t>(pointer);
+            break;
+        case BinaryLogType::uint8:
+            output << static_cast<unsigned>(loadValue<uint8_t>(pointer));
+            break;
+        case BinaryLogType::uint16:
+            output << loadValue<uint16_t>(pointer);
+            break;
+        case BinaryLogType::uint32:
+            output << loadValue<uint32_t>(pointer);
+            break;
+        case BinaryLogType::uint64:
+            output << loadValue<uint64_t>(pointer);
+            break;
+    }
+}
+
+const std::vector<BinaryLogField>&
+BinaryLogReader::getFields() const
+{
+    return fields_;
+}
+
+size_t
+BinaryLogReader::getRecordCount() const
+{
+    return record_count_;
+}
+
+bool
+BinaryLogReader::open(const std::filesystem::path& path)
+{
+    file_.close();
+    file_.clear();
+    fields_.clear();
+    record_count_ = 0;
+
+    file_.open(path, std::ifstream::in | std::ifstream::binary);
+
+    char magic[sizeof(BinaryLogFormat::magic) - 1];
+    uint32_t version = 0;
+    uint32_t column_count = 0;
+
+    if (!file_.is_open() || !file_.read(magic, sizeof(magic)) || std::memcmp(magic, BinaryLogFormat::magic, sizeof(magic)) != 0 || !readValue(file_, version) || version != BinaryLogFormat::version || !readValue(file_, column_count))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < column_count; i ++)
+    {
+        BinaryLogField field;
+        uint16_t name_length = 0;
+
+        if (!readValue(file_, field.type) || getBinaryLogTypeSize(field.type) == 0 || !readValue(file_, name_length))
+        {
+            return false;
+        }
+
+        field.name.resize(name_length);
+
+        if (!file_.read(field.name.data(), name_length))
+        {
+            return false;
+        }
+
+        fields_.push_back(field);
+    }
+
+    return !fields_.empty();
+}
+
+bool
+BinaryLogReader::readChunk()
+{
+    uint32_t magic = 0;
+    uint32_t record_count = 0;
+    BinaryLogCompression compression = BinaryLogCompression::none;
+    uint32_t size_raw = 0;
+    uint32_t size_stored = 0;
+
+    record_count_ = 0;
+
+    if (!readValue(file_, magic) || magic != BinaryLogFormat::magic_chunk || !readValue(file_, record_count) || !readValue(file_, compression) || !readValue(file_, size_raw) || !readValue(file_, size_stored))
+    {
+        return false;
+    }
+
+    size_t record_size = 0;
+
+    for (const auto& field : fields_)
+    {
+        record_size += getBinaryLogTypeSize(field.type);
+    }
+
+    if (static_cast<size_t>(record_count) * record_size != size_raw)
+    {
+        return false;
+    }
+
+    chunk_.resize(size_raw);
+
+    if (compression == BinaryLogCompression::none)
+    {
+        if (size_stored != size_raw || !file_.read(chunk_.data(), size_raw))
+        {
+            return false;
+        }
+    }
+#ifdef BIPED_GROUND_STATION_LZ4
+    else if (compression == BinaryLogCompression::lz4)
+    {
+        buffer_compression_.resize(size_stored);
+
+        if (!file_.read(buffer_compression_.data(), size_stored) || LZ4_decompress_safe(buffer_compression_.data(), chunk_.data(), static_cast<int>(size_stored), static_cast<int>(size_raw)) != static_cast<int>(size_raw))
+        {
+            return false;
+        }
+    }
+#endif
+    else
+    {
+        return false;
+    }
+
+    offsets_field_.clear();
+
+    size_t offset = 0;
+
+    for (const auto& field : fields_)
+    {
+        offsets_field_.push_back(offset);
+        offset += record_count * getBinaryLogTypeSize(field.type);
+    }
+
+    record_count_ = record_count;
+
+    return true;
+}
+
+bool
+convertBinaryLog(const std::filesystem::path& path, std::ostream& output, const char& separator)
+{
+    BinaryLogReader reader;
+
+    if (!reader.open(path))
+    {
+        return false;
+    }
+
+    const std::vector<BinaryLogField>& fields = reader.getFields();
+
+    if (separator == '\t')
+    {
+        output << "#" << separator;
+    }
+
+    for (size_t i = 0; i < fields.size(); i ++)
+    {
+        output << fields[i].name << (i + 1 < fields.size() ? separator : '\n');
+    }
+
+    while (reader.readChunk())
+    {
+        for (size_t record = 0; record < reader.getRecordCount(); record ++)
+        {
+            for (size_t i = 0; i < fields.size(); i ++)
+            {
+                reader.formatValue(output, i, record);
+                output << (i + 1 < fields.size() ? separator : '\n');
+            }
+        }
+    }
+
+    /*
+     *  A log cut short, e.g., by a crash, converts up to its last complete chunk.
+     */
+    return static_cast<bool>(output);
+}
+}
+}
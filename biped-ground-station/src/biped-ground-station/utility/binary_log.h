@@ -0,0 +1,209 @@
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  Binary logs are written in little-endian byte order, straight from memory.
+ */
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Binary logs require a little-endian host.");
+
+enum class BinaryLogType : uint8_t
+{
+    boolean = 0,
+    float32,
+    float64,
+    int8,
+    int16,
+    int32,
+    int64,
+    uint8,
+    uint16,
+    uint32,
+    uint64
+};
+
+enum class BinaryLogCompression : uint8_t
+{
+    none = 0,
+    lz4
+};
+
+/*
+ *  A binary log column, i.e., the name, the offset in the record, and the type of a field.
+ */
+struct BinaryLogColumn
+{
+    const char* name;
+    size_t offset;
+    BinaryLogType type;
+};
+
+/*
+ *  Binary log file layout, in little-endian byte order:
+ *
+ *  Header: magic "BIPEDLOG", uint32 version, uint32 column count, and, per column, uint8 type, uint16 name length and
+ *  the name.
+ *  Chunks: uint32 magic "CHNK", uint32 record count, uint8 compression, uint32 raw size, uint32 stored size, and the
+ *  stored payload. The raw payload holds the columns one after another, each holding the values of every record in the
+ *  chunk, such that a column compresses well and is read without touching the others.
+ */
+namespace BinaryLogFormat
+{
+constexpr char magic[] = "BIPEDLOG";
+constexpr uint32_t magic_chunk = 0x4B4E4843;
+constexpr uint32_t version = 1;
+}
+
+size_t
+getBinaryLogTypeSize(const BinaryLogType& type);
+
+bool
+isBinaryLogCompressionAvailable();
+
+/*
+ *  Buffered binary log writer. Records are copied column-wise into one of two blocks, and full blocks are compressed
+ *  and written by a dedicated I/O thread while the other block fills up, such that writing a record never formats,
+ *  compresses, or touches the file. Flushing hands a partially filled block to the I/O thread as well, unless the I/O
+ *  thread is still busy, such that a slow stream of records reaches the file without waiting for a block to fill up.
+ */
+class BinaryLogWriter
+{
+public:
+
+    BinaryLogWriter();
+
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+
+    BinaryLogWriter&
+    operator=(const BinaryLogWriter&) = delete;
+
+    void
+    close();
+
+    bool
+    failed() const;
+
+    void
+    flush();
+
+    unsigned long long
+    getByteCount() const;
+
+    unsigned long long
+    getRecordCount() const;
+
+    bool
+    isOpen() const;
+
+    bool
+    open(const std::filesystem::path& path, const std::vector<BinaryLogColumn>& columns, const size_t& block_size, const bool& compressed);
+
+    void
+    write(const void* record);
+
+private:
+
+    struct Block
+    {
+        std::vector<char> data;
+        size_t record_count;
+    };
+
+    void
+    run();
+
+    void
+    submit();
+
+    void
+    writeBlock(Block& block);
+
+    std::array<Block, 2> blocks_;
+    std::vector<char> buffer_compression_;
+    std::atomic<unsigned long long> byte_count_;
+    std::vector<BinaryLogColumn> columns_;
+    BinaryLogCompression compression_;
+    std::condition_variable condition_;
+    std::atomic<bool> failed_;
+    std::ofstream file_;
+    size_t index_block_;
+    size_t index_block_pending_;
+    std::mutex mutex_;
+    std::vector<size_t> offsets_column_;
+    bool open_;
+    bool pending_;
+    size_t record_capacity_;
+    unsigned long long record_count_;
+    size_t record_size_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+struct BinaryLogField
+{
+    std::string name;
+    BinaryLogType type;
+};
+
+/*
+ *  Binary log reader, reading one chunk at a time.
+ */
+class BinaryLogReader
+{
+public:
+
+    BinaryLogReader();
+
+    void
+    formatValue(std::ostream& output, const size_t& column, const size_t& record) const;
+
+    const std::vector<BinaryLogField>&
+    getFields() const;
+
+    size_t
+    getRecordCount() const;
+
+    bool
+    open(const std::filesystem::path& path);
+
+    bool
+    readChunk();
+
+private:
+
+    std::vector<char> buffer_compression_;
+    std::vector<char> chunk_;
+    std::vector<BinaryLogField> fields_;
+    std::ifstream file_;
+    std::vector<size_t> offsets_field_;
+    size_t record_count_;
+};
+
+/*
+ *  Convert a binary log into tab-separated or comma-separated values. Tab-separated values get the same commented
+ *  header line and value formatting as the text data log.
+ */
+bool
+convertBinaryLog(const std::filesystem::path& path, std::ostream& output, const char& separator);
+}
+}
+
+#endif // BINARY_LOG_H
@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <type_traits>
+
+#include "utility/biped_message_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+static_assert(std::is_standard_layout<BipedMessageLogRecord>::value, "Data log records must be standard layout.");
+static_assert(sizeof(biped::firmware::CameraFrameSize) == sizeof(uint8_t), "Camera frame sizes must be logged as a byte.");
+
+const std::vector<BinaryLogColumn> biped_message_log_columns = {
+        { "sequence", offsetof(BipedMessageLogRecord, message.sequence), BinaryLogType::uint64 },
+        { "timestamp", offsetof(BipedMessageLogRecord, message.timestamp), BinaryLogType::uint64 },
+        { "camera_frame", offsetof(BipedMessageLogRecord, camera_frame), BinaryLogType::uint64 },
+        { "actuation_command.motor_enable", offsetof(BipedMessageLogRecord, message.actuation_command.motor_enable), BinaryLogType::boolean },
+        { "actuation_command.motor_left_forward", offsetof(BipedMessageLogRecord, message.actuation_command.motor_left_forward), BinaryLogType::boolean },
+        { "actuation_command.motor_right_forward", offsetof(BipedMessageLogRecord, message.actuation_command.motor_right_forward), BinaryLogType::boolean },
+        { "actuation_command.motor_left_pwm", offsetof(BipedMessageLogRecord, message.actuation_command.motor_left_pwm), BinaryLogType::float64 },
+        { "actuation_command.motor_right_pwm", offsetof(BipedMessageLogRecord, message.actuation_command.motor_right_pwm), BinaryLogType::float64 },
+        { "controller_reference.attitude_y", offsetof(BipedMessageLogRecord, message.controller_reference.attitude_y), BinaryLogType::float64 },
+        { "controller_reference.attitude_z", offsetof(BipedMessageLogRecord, message.controller_reference.attitude_z), BinaryLogType::float64 },
+        { "controller_reference.position_x", offsetof(BipedMessageLogRecord, message.controller_reference.position_x), BinaryLogType::float64 },
+        { "encoder_data.position_x", offsetof(BipedMessageLogRecord, message.encoder_data.position_x), BinaryLogType::float64 },
+        { "encoder_data.steps", offsetof(BipedMessageLogRecord, message.encoder_data.steps), BinaryLogType::float64 },
+        { "encoder_data.steps_left", offsetof(BipedMessageLogRecord, message.encoder_data.steps_left), BinaryLogType::float64 },
+        { "encoder_data.steps_right", offsetof(BipedMessageLogRecord, message.encoder_data.steps_right), BinaryLogType::float64 },
+        { "encoder_data.transition_errors_left", offsetof(BipedMessageLogRecord, message.encoder_data.transition_errors_left), BinaryLogType::uint64 },
+        { "encoder_data.transition_errors_right", offsetof(BipedMessageLogRecord, message.encoder_data.transition_errors_right), BinaryLogType::uint64 },
+        { "encoder_data.velocity_x", offsetof(BipedMessageLogRecord, message.encoder_data.velocity_x), BinaryLogType::float64 },
+        { "imu_data.acceleration_x", offsetof(BipedMessageLogRecord, message.imu_data.acceleration_x), BinaryLogType::float64 },
+        { "imu_data.acceleration_y", offsetof(BipedMessageLogRecord, message.imu_data.acceleration_y), BinaryLogType::float64 },
+        { "imu_data.acceleration_z", offsetof(BipedMessageLogRecord, message.imu_data.acceleration_z), BinaryLogType::float64 },
+        { "imu_data.attitude_x", offsetof(BipedMessageLogRecord, message.imu_data.attitude_x), BinaryLogType::float64 },
+        { "imu_data.attitude_y", offsetof(BipedMessageLogRecord, message.imu_data.attitude_y), BinaryLogType::float64 },
+        { "imu_data.attitude_z", offsetof(BipedMessageLogRecord, message.imu_data.attitude_z), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_x", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_x), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_y", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_y), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_z", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_z), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_bias_x", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_bias_x), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_bias_y", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_bias_y), BinaryLogType::float64 },
+        { "imu_data.angular_velocity_bias_z", offsetof(BipedMessageLogRecord, message.imu_data.angular_velocity_bias_z), BinaryLogType::float64 },
+        { "imu_data.compass_x", offsetof(BipedMessageLogRecord, message.imu_data.compass_x), BinaryLogType::float64 },
+        { "imu_data.compass_y", offsetof(BipedMessageLogRecord, message.imu_data.compass_y), BinaryLogType::float64 },
+        { "imu_data.compass_z", offsetof(BipedMessageLogRecord, message.imu_data.compass_z), BinaryLogType::float64 },
+        { "imu_data.temperature", offsetof(BipedMessageLogRecord, message.imu_data.temperature), BinaryLogType::float64 },
+        { "time_of_flight_data.range_left", offsetof(BipedMessageLogRecord, message.time_of_flight_data.range_left), BinaryLogType::float64 },
+        { "time_of_flight_data.range_middle", offsetof(BipedMessageLogRecord, message.time_of_flight_data.range_middle), BinaryLogType::float64 },
+        { "time_of_flight_data.range_right", offsetof(BipedMessageLogRecord, message.time_of_flight_data.range_right), BinaryLogType::float64 },
+        { "telemetry.deadline_miss", offsetof(BipedMessageLogRecord, message.telemetry.deadline_miss), BinaryLogType::uint32 },
+        { "telemetry.interval.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.interval.percentile_50), BinaryLogType::float32 },
+        { "telemetry.interval.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.interval.percentile_99), BinaryLogType::float32 },
+        { "telemetry.interval.maximum", offsetof(BipedMessageLogRecord, message.telemetry.interval.maximum), BinaryLogType::float32 },
+        { "telemetry.execution_time.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.execution_time.percentile_50), BinaryLogType::float32 },
+        { "telemetry.execution_time.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.execution_time.percentile_99), BinaryLogType::float32 },
+        { "telemetry.execution_time.maximum", offsetof(BipedMessageLogRecord, message.telemetry.execution_time.maximum), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_fast.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_fast.percentile_50), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_fast.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_fast.percentile_99), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_fast.maximum", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_fast.maximum), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_slow.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_slow.percentile_50), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_slow.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_slow.percentile_99), BinaryLogType::float32 },
+        { "telemetry.execution_time_sense_slow.maximum", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_sense_slow.maximum), BinaryLogType::float32 },
+        { "telemetry.execution_time_control.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_control.percentile_50), BinaryLogType::float32 },
+        { "telemetry.execution_time_control.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_control.percentile_99), BinaryLogType::float32 },
+        { "telemetry.execution_time_control.maximum", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_control.maximum), BinaryLogType::float32 },
+        { "telemetry.execution_time_actuate.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_actuate.percentile_50), BinaryLogType::float32 },
+        { "telemetry.execution_time_actuate.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_actuate.percentile_99), BinaryLogType::float32 },
+        { "telemetry.execution_time_actuate.maximum", offsetof(BipedMessageLogRecord, message.telemetry.execution_time_actuate.maximum), BinaryLogType::float32 },
+        { "telemetry.camera.frame_count", offsetof(BipedMessageLogRecord, message.telemetry.camera.frame_count), BinaryLogType::uint32 },
+        { "telemetry.camera.frame_count_dropped", offsetof(BipedMessageLogRecord, message.telemetry.camera.frame_count_dropped), BinaryLogType::uint32 },
+        { "telemetry.camera.execution_time_capture.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_capture.percentile_50), BinaryLogType::float32 },
+        { "telemetry.camera.execution_time_capture.maximum", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_capture.maximum), BinaryLogType::float32 },
+        { "telemetry.camera.execution_time_encode.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_encode.percentile_50), BinaryLogType::float32 },
+        { "telemetry.camera.execution_time_encode.maximum", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_encode.maximum), BinaryLogType::float32 },
+        { "telemetry.camera.execution_time_transmit.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_transmit.percentile_50), BinaryLogType::float32 },
+        { "telemetry.camera.execution_time_transmit.maximum", offsetof(BipedMessageLogRecord, message.telemetry.camera.execution_time_transmit.maximum), BinaryLogType::float32 },
+        { "telemetry.camera.latency.percentile_50", offsetof(BipedMessageLogRecord, message.telemetry.camera.latency.percentile_50), BinaryLogType::float32 },
+        { "telemetry.camera.latency.percentile_99", offsetof(BipedMessageLogRecord, message.telemetry.camera.latency.percentile_99), BinaryLogType::float32 },
+        { "telemetry.camera.latency.maximum", offsetof(BipedMessageLogRecord, message.telemetry.camera.latency.maximum), BinaryLogType::float32 },
+        { "telemetry.camera.budget", offsetof(BipedMessageLogRecord, message.telemetry.camera.budget), BinaryLogType::uint32 },
+        { "telemetry.camera.setting.frame_size", offsetof(BipedMessageLogRecord, message.telemetry.camera.setting.frame_size), BinaryLogType::uint8 },
+        { "telemetry.camera.setting.jpeg_quality", offsetof(BipedMessageLogRecord, message.telemetry.camera.setting.jpeg_quality), BinaryLogType::uint8 },
+        { "telemetry.camera.setting.frame_rate", offsetof(BipedMessageLogRecord, message.telemetry.camera.setting.frame_rate), BinaryLogType::uint8 } };
+}
+}
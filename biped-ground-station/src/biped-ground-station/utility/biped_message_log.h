@@ -0,0 +1,34 @@
+#ifndef BIPED_MESSAGE_LOG_H
+#define BIPED_MESSAGE_LOG_H
+
+#include <vector>
+
+#include "common/type.h"
+#include "utility/binary_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  A data log record, i.e., a Biped message and the offset of the latest camera frame in the camera log, or zero before
+ *  the first camera frame.
+ */
+struct BipedMessageLogRecord
+{
+    unsigned long long camera_frame;
+    biped::firmware::BipedMessage message;
+
+    BipedMessageLogRecord() : camera_frame(0)
+    {
+    }
+};
+
+/*
+ *  Data log columns, in the same order and with the same names as the text data log.
+ */
+extern const std::vector<BinaryLogColumn> biped_message_log_columns;
+}
+}
+
+#endif // BIPED_MESSAGE_LOG_H
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <cstring>
+
+#include "utility/camera_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+namespace
+{
+constexpr uint64_t size_header = sizeof(CameraLogFormat::magic) - 1 + sizeof(uint32_t);
+constexpr uint64_t size_header_frame = 4 * sizeof(uint32_t) + sizeof(uint64_t);
+constexpr uint64_t size_trailer = sizeof(uint64_t) + sizeof(CameraLogFormat::magic_trailer) - 1;
+
+template<typename Type>
+void
+writeValue(std::ostream& output, const Type& value)
+{
+    output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename Type>
+bool
+readValue(std::istream& input, Type& value)
+{
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+}
+
+CameraLogWriter::CameraLogWriter() : failed_(false), offset_(0)
+{
+}
+
+CameraLogWriter::~CameraLogWriter()
+{
+    close();
+}
+
+void
+CameraLogWriter::close()
+{
+    if (!file_.is_open())
+    {
+        return;
+    }
+
+    const uint64_t offset_index = offset_;
+
+    writeValue(file_, CameraLogFormat::magic_index);
+    writeValue(file_, static_cast<uint32_t>(frames_.size()));
+
+    for (const auto& frame : frames_)
+    {
+        writeValue(file_, frame.offset);
+        writeValue(file_, static_cast<uint64_t>(frame.timestamp));
+        writeValue(file_, frame.frame_id);
+        writeValue(file_, frame.size);
+    }
+
+    writeValue(file_, offset_index);
+    file_.write(CameraLogFormat::magic_trailer, sizeof(CameraLogFormat::magic_trailer) - 1);
+
+    if (!file_)
+    {
+        failed_ = true;
+    }
+
+    file_.close();
+}
+
+bool
+CameraLogWriter::failed() const
+{
+    return failed_;
+}
+
+size_t
+CameraLogWriter::getFrameCount() const
+{
+    return frames_.size();
+}
+
+bool
+CameraLogWriter::isOpen() const
+{
+    return file_.is_open();
+}
+
+bool
+CameraLogWriter::open(const std::filesystem::path& path)
+{
+    close();
+
+    failed_ = false;
+    frames_.clear();
+
+    file_.clear();
+    file_.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+    if (!file_.is_open())
+    {
+        return false;
+    }
+
+    file_.write(CameraLogFormat::magic, sizeof(CameraLogFormat::magic) - 1);
+    writeValue(file_, CameraLogFormat::version);
+
+    if (!file_)
+    {
+        file_.close();
+        return false;
+    }
+
+    offset_ = size_header;
+
+    return true;
+}
+
+uint64_t
+CameraLogWriter::write(const void* frame, const size_t& size, const uint32_t& frame_id, const unsigned long long& timestamp)
+{
+    if (!file_.is_open() || failed_ || size == 0 || size > UINT32_MAX)
+    {
+        return 0;
+    }
+
+    CameraLogFrame entry;
+
+    entry.frame_id = frame_id;
+    entry.offset = offset_ + size_header_frame;
+    entry.size = static_cast<uint32_t>(size);
+    entry.timestamp = timestamp;
+
+    writeValue(file_, CameraLogFormat::magic_frame);
+    writeValue(file_, static_cast<uint32_t>(frames_.size()));
+    writeValue(file_, entry.frame_id);
+    writeValue(file_, static_cast<uint64_t>(entry.timestamp));
+    writeValue(file_, entry.size);
+    file_.write(static_cast<const char*>(frame), size);
+
+    if (!file_)
+    {
+        failed_ = true;
+        return 0;
+    }
+
+    offset_ = entry.offset + size;
+    frames_.push_back(entry);
+
+    return entry.offset;
+}
+
+CameraLogReader::CameraLogReader() : indexed_(false)
+{
+}
+
+bool
+CameraLogReader::findFrame(const uint64_t& offset, size_t& index) const
+{
+    const auto frame = std::lower_bound(frames_.begin(), frames_.end(), offset, [](const CameraLogFrame& frame, const uint64_t& offset)
+    {
+        return frame.offset < offset;
+    });
+
+    if (frame == frames_.end() || frame->offset != offset)
+    {
+        return false;
+    }
+
+    index = frame - frames_.begin();
+
+    return true;
+}
+
+bool
+CameraLogReader::findFrameAt(const unsigned long long& timestamp, size_t& index) const
+{
+    /*
+     *  Camera frames are appended as completed, such that their timestamps are only mostly in order, so look for the
+     *  newest camera frame not after the timestamp rather than searching.
+     */
+    bool found = false;
+
+    for (size_t i = 0; i < frames_.size(); i ++)
+    {
+        if (frames_[i].timestamp <= timestamp && (!found || frames_[i].timestamp >= frames_[index].timestamp))
+        {
+            found = true;
+            index = i;
+        }
+    }
+
+    return found;
+}
+
+const std::vector<CameraLogFrame>&
+CameraLogReader::getFrames() const
+{
+    return frames_;
+}
+
+bool
+CameraLogReader::isIndexed() const
+{
+    return indexed_;
+}
+
+bool
+CameraLogReader::open(const std::filesystem::path& path)
+{
+    file_.close();
+    file_.clear();
+    frames_.clear();
+    indexed_ = false;
+
+    std::error_code error;
+    const uint64_t size_file = std::filesystem::file_size(path, error);
+
+    if (error)
+    {
+        return false;
+    }
+
+    file_.open(path, std::ifstream::in | std::ifstream::binary);
+
+    char magic[sizeof(CameraLogFormat::magic) - 1];
+    uint32_t version = 0;
+
+    if (!file_.is_open() || !file_.read(magic, sizeof(magic)) || std::memcmp(magic, CameraLogFormat::magic, sizeof(magic)) != 0 || !readValue(file_, version) || version != CameraLogFormat::version)
+    {
+        return false;
+    }
+
+    indexed_ = readIndex(size_file);
+
+    if (!indexed_)
+    {
+        frames_.clear();
+        scan(size_file);
+    }
+
+    file_.clear();
+
+    return true;
+}
+
+bool
+CameraLogReader::readFrame(const size_t& index, std::vector<unsigned char>& frame)
+{
+    if (index >= frames_.size())
+    {
+        return false;
+    }
+
+    frame.resize(frames_[index].size);
+    file_.clear();
+    file_.seekg(frames_[index].offset);
+
+    return static_cast<bool>(file_.read(reinterpret_cast<char*>(frame.data()), frame.size()));
+}
+
+bool
+CameraLogReader::readIndex(const uint64_t& size_file)
+{
+    if (size_file < size_header + size_trailer)
+    {
+        return false;
+    }
+
+    uint64_t offset_index = 0;
+    char magic_trailer[sizeof(CameraLogFormat::magic_trailer) - 1];
+
+    file_.clear();
+    file_.seekg(size_file - size_trailer);
+
+    if (!readValue(file_, offset_index) || !file_.read(magic_trailer, sizeof(magic_trailer)) || std::memcmp(magic_trailer, CameraLogFormat::magic_trailer, sizeof(magic_trailer)) != 0 || offset_index < size_header || offset_index > size_file - size_trailer)
+    {
+        return false;
+    }
+
+    uint32_t magic_index = 0;
+    uint32_t frame_count = 0;
+
+    file_.seekg(offset_index);
+
+    if (!readValue(file_, magic_index) || magic_index != CameraLogFormat::magic_index || !readValue(file_, frame_count))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < frame_count; i ++)
+    {
+        CameraLogFrame frame;
+        uint64_t timestamp = 0;
+
+        if (!readValue(file_, frame.offset) || !readValue(file_, timestamp) || !readValue(file_, frame.frame_id) || !readValue(file_, frame.size) || frame.offset + frame.size > offset_index)
+        {
+            return false;
+        }
+
+        frame.timestamp = timestamp;
+        frames_.push_back(frame);
+    }
+
+    return true;
+}
+
+void
+CameraLogReader::scan(const uint64_t& size_file)
+{
+    uint64_t offset = size_header;
+
+    file_.clear();
+    file_.seekg(offset);
+
+    for (;;)
+    {
+        uint32_t magic = 0;
+        uint32_t index = 0;
+        uint64_t timestamp = 0;
+        CameraLogFrame frame;
+
+        if (!readValue(file_, magic) || magic != CameraLogFormat::magic_frame || !readValue(file_, index) || index != frames_.size() || !readValue(file_, frame.frame_id) || !readValue(file_, timestamp) || !readValue(file_, frame.size))
+        {
+            return;
+        }
+
+        frame.offset = offset + size_header_frame;
+        frame.timestamp = timestamp;
+
+        /*
+         *  Leave out a camera frame cut short.
+         */
+        if (frame.offset + frame.size > size_file)
+        {
+            return;
+        }
+
+        frames_.push_back(frame);
+        offset = frame.offset + frame.size;
+        file_.seekg(offset);
+    }
+}
+}
+}
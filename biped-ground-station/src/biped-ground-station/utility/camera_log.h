@@ -0,0 +1,139 @@
+#ifndef CAMERA_LOG_H
+#define CAMERA_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  Camera logs are written in little-endian byte order, straight from memory.
+ */
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Camera logs require a little-endian host.");
+
+/*
+ *  A camera log frame, i.e., the Biped camera frame ID and timestamp of a JPG camera frame, and the offset and size of
+ *  its data in the camera log.
+ */
+struct CameraLogFrame
+{
+    uint32_t frame_id;
+    uint64_t offset;
+    uint32_t size;
+    unsigned long long timestamp;
+
+    CameraLogFrame() : frame_id(0), offset(0), size(0), timestamp(0)
+    {
+    }
+};
+
+/*
+ *  Camera log file layout, an indexed motion JPG container, in little-endian byte order:
+ *
+ *  Header: magic "BIPEDCAM" and uint32 version.
+ *  Frames: uint32 magic "FRAM", uint32 index, uint32 Biped camera frame ID, uint64 timestamp, uint32 size, and the JPG
+ *  camera frame data, as received from the Biped.
+ *  Index, written on close: uint32 magic "INDX", uint32 frame count, and, per frame, uint64 offset, uint64 timestamp,
+ *  uint32 Biped camera frame ID and uint32 size, followed by the uint64 offset of the index and magic "BIPEDIDX".
+ *
+ *  A camera log cut short, e.g., by a crash, has no index, and is indexed again by walking the frames.
+ */
+namespace CameraLogFormat
+{
+constexpr char magic[] = "BIPEDCAM";
+constexpr uint32_t magic_frame = 0x4D415246;
+constexpr uint32_t magic_index = 0x58444E49;
+constexpr char magic_trailer[] = "BIPEDIDX";
+constexpr uint32_t version = 1;
+}
+
+/*
+ *  Camera log writer, appending every JPG camera frame once, as received, without decoding or encoding it.
+ */
+class CameraLogWriter
+{
+public:
+
+    CameraLogWriter();
+
+    ~CameraLogWriter();
+
+    CameraLogWriter(const CameraLogWriter&) = delete;
+
+    CameraLogWriter&
+    operator=(const CameraLogWriter&) = delete;
+
+    void
+    close();
+
+    bool
+    failed() const;
+
+    size_t
+    getFrameCount() const;
+
+    bool
+    isOpen() const;
+
+    bool
+    open(const std::filesystem::path& path);
+
+    uint64_t
+    write(const void* frame, const size_t& size, const uint32_t& frame_id, const unsigned long long& timestamp);
+
+private:
+
+    bool failed_;
+    std::ofstream file_;
+    std::vector<CameraLogFrame> frames_;
+    uint64_t offset_;
+};
+
+/*
+ *  Camera log reader, reading any JPG camera frame by its index, its offset, or its timestamp.
+ */
+class CameraLogReader
+{
+public:
+
+    CameraLogReader();
+
+    bool
+    findFrame(const uint64_t& offset, size_t& index) const;
+
+    bool
+    findFrameAt(const unsigned long long& timestamp, size_t& index) const;
+
+    const std::vector<CameraLogFrame>&
+    getFrames() const;
+
+    bool
+    isIndexed() const;
+
+    bool
+    open(const std::filesystem::path& path);
+
+    bool
+    readFrame(const size_t& index, std::vector<unsigned char>& frame);
+
+private:
+
+    bool
+    readIndex(const uint64_t& size_file);
+
+    void
+    scan(const uint64_t& size_file);
+
+    std::ifstream file_;
+    std::vector<CameraLogFrame> frames_;
+    bool indexed_;
+};
+}
+}
+
+#endif // CAMERA_LOG_H
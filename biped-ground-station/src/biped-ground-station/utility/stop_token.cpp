@@ -0,0 +1,45 @@
+#include "utility/stop_token.h"
+
+namespace biped
+{
+namespace ground_station
+{
+StopToken::StopToken() : requested_(true)
+{
+}
+
+void
+StopToken::request()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    requested_ = true;
+    lock.unlock();
+
+    condition_.notify_all();
+}
+
+bool
+StopToken::requested() const
+{
+    return requested_;
+}
+
+void
+StopToken::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    requested_ = false;
+}
+
+bool
+StopToken::waitFor(const std::chrono::milliseconds& duration)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    return condition_.wait_for(lock, duration, [this]()
+    {
+        return requested_.load();
+    });
+}
+}
+}
@@ -0,0 +1,40 @@
+#ifndef STOP_TOKEN_H
+#define STOP_TOKEN_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace biped
+{
+namespace ground_station
+{
+class StopToken
+{
+public:
+
+    StopToken();
+
+    void
+    request();
+
+    bool
+    requested() const;
+
+    void
+    reset();
+
+    bool
+    waitFor(const std::chrono::milliseconds& duration);
+
+private:
+
+    std::condition_variable condition_;
+    std::mutex mutex_;
+    std::atomic<bool> requested_;
+};
+}
+}
+
+#endif // STOP_TOKEN_H
@@ -0,0 +1,233 @@
+#ifndef TELEMETRY_BUS_H
+#define TELEMETRY_BUS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  Single-producer, multi-consumer broadcast ring. The producer copies every message once into a preallocated slot and
+ *  never waits for the consumers. Every consumer reads through its own cursor, and a consumer that falls more than the
+ *  ring behind skips the overwritten messages and counts them as dropped. Each slot carries a sequence lock style
+ *  version, such that a consumer detects a slot overwritten while being copied. Consumers are notified once, and not
+ *  again until they have read the ring empty, such that a slow consumer never piles up notifications. Consumers must
+ *  therefore read until reading fails, which rearms the notification. A consumer may still be notified once right after
+ *  unsubscribing, and must tolerate reading nothing.
+ */
+template<typename Type, size_t Capacity, size_t ConsumerCount>
+class TelemetryBus
+{
+    static_assert(std::is_trivially_copyable<Type>::value, "Telemetry bus messages must be trivially copyable.");
+    static_assert(Capacity > 1, "Telemetry bus must hold more than one message.");
+
+public:
+
+    TelemetryBus() : head_(0)
+    {
+        for (size_t i = 0; i < Capacity; i ++)
+        {
+            slots_[i].version = 0;
+        }
+
+        for (auto& consumer : consumers_)
+        {
+            consumer.active = false;
+            consumer.cursor = 0;
+            consumer.count_dropped = 0;
+            consumer.pending = false;
+        }
+    }
+
+    TelemetryBus(const TelemetryBus&) = delete;
+
+    TelemetryBus&
+    operator=(const TelemetryBus&) = delete;
+
+    unsigned long long
+    getDropCount(const size_t& consumer) const
+    {
+        return consumer < ConsumerCount ? consumers_[consumer].count_dropped.load(std::memory_order_relaxed) : 0;
+    }
+
+    unsigned long long
+    getPublishCount() const
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    void
+    publish(const Type& message)
+    {
+        const uint64_t index = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[index % Capacity];
+
+        slot.version.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.message, &message, sizeof(Type));
+        slot.version.store(2 * index + 2, std::memory_order_release);
+        head_.store(index + 1);
+
+        for (auto& consumer : consumers_)
+        {
+            if (!consumer.active.load(std::memory_order_acquire) || consumer.pending.exchange(true))
+            {
+                continue;
+            }
+
+            const std::shared_ptr<const std::function<void()>> notify = std::atomic_load(&consumer.notify);
+
+            if (notify && *notify)
+            {
+                (*notify)();
+            }
+        }
+    }
+
+    bool
+    read(const size_t& consumer, Type& message)
+    {
+        if (consumer >= ConsumerCount)
+        {
+            return false;
+        }
+
+        Consumer& reader = consumers_[consumer];
+
+        for (;;)
+        {
+            const uint64_t head = head_.load();
+
+            if (reader.cursor == head)
+            {
+                /*
+                 *  Rearm the notification before giving up, and read on if the producer published in between.
+                 */
+                reader.pending.store(false);
+
+                if (head_.load() == head)
+                {
+                    return false;
+                }
+
+                continue;
+            }
+
+            /*
+             *  The oldest slot may be being overwritten, so a consumer a full ring behind skips it as well.
+             */
+            if (head - reader.cursor > Capacity - 1)
+            {
+                reader.count_dropped.fetch_add(head - reader.cursor - (Capacity - 1), std::memory_order_relaxed);
+                reader.cursor = head - (Capacity - 1);
+            }
+
+            const Slot& slot = slots_[reader.cursor % Capacity];
+            const uint64_t version = slot.version.load(std::memory_order_acquire);
+
+            if (version == 2 * reader.cursor + 2)
+            {
+                std::memcpy(&message, &slot.message, sizeof(Type));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (slot.version.load(std::memory_order_relaxed) == version)
+                {
+                    reader.cursor ++;
+                    return true;
+                }
+            }
+
+            reader.count_dropped.fetch_add(1, std::memory_order_relaxed);
+            reader.cursor ++;
+        }
+    }
+
+    bool
+    readLatest(const size_t& consumer, Type& message)
+    {
+        if (consumer >= ConsumerCount)
+        {
+            return false;
+        }
+
+        const uint64_t head = head_.load(std::memory_order_acquire);
+
+        if (consumers_[consumer].cursor + 1 < head)
+        {
+            consumers_[consumer].cursor = head - 1;
+        }
+
+        return read(consumer, message);
+    }
+
+    bool
+    subscribe(const std::function<void()>& notify, size_t& consumer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_consumer_);
+
+        for (consumer = 0; consumer < ConsumerCount; consumer ++)
+        {
+            Consumer& reader = consumers_[consumer];
+
+            if (reader.active.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            reader.count_dropped = 0;
+            reader.cursor = head_.load(std::memory_order_acquire);
+            std::atomic_store(&reader.notify, std::make_shared<const std::function<void()>>(notify));
+            reader.pending = false;
+            reader.active.store(true, std::memory_order_release);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void
+    unsubscribe(const size_t& consumer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_consumer_);
+
+        if (consumer < ConsumerCount)
+        {
+            consumers_[consumer].active.store(false, std::memory_order_release);
+        }
+    }
+
+private:
+
+    struct Consumer
+    {
+        std::atomic<bool> active;
+        std::atomic<unsigned long long> count_dropped;
+        uint64_t cursor;
+        std::shared_ptr<const std::function<void()>> notify;
+        std::atomic<bool> pending;
+    };
+
+    struct Slot
+    {
+        Type message;
+        std::atomic<uint64_t> version;
+    };
+
+    std::array<Consumer, ConsumerCount> consumers_;
+    std::atomic<uint64_t> head_;
+    std::mutex mutex_consumer_;
+    std::array<Slot, Capacity> slots_;
+};
+}
+}
+
+#endif // TELEMETRY_BUS_H
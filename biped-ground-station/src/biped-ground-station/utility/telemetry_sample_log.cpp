@@ -0,0 +1,36 @@
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "utility/telemetry_sample_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+static_assert(std::is_standard_layout<TelemetrySampleLogRecord>::value, "Sample log records must be standard layout.");
+
+TelemetrySampleLogRecord::TelemetrySampleLogRecord(const biped::firmware::TelemetryFrame& frame, const size_t& sample) : overflow(frame.overflow), sequence(frame.sequence), tick(frame.samples[sample].tick)
+{
+    for (size_t field = 0; field < fields.size(); field ++)
+    {
+        fields[field] = frame.subscription.includes(field, tick) ? frame.samples[sample].getField(static_cast<biped::firmware::TelemetryField>(field)) : std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+const std::vector<BinaryLogColumn> telemetry_sample_log_columns = []()
+{
+    std::vector<BinaryLogColumn> columns = {
+            { "tick", offsetof(TelemetrySampleLogRecord, tick), BinaryLogType::uint32 },
+            { "frame.sequence", offsetof(TelemetrySampleLogRecord, sequence), BinaryLogType::uint64 },
+            { "frame.overflow", offsetof(TelemetrySampleLogRecord, overflow), BinaryLogType::uint32 } };
+
+    for (size_t field = 0; field < biped::firmware::TelemetrySubscription::field_count; field ++)
+    {
+        columns.push_back({ biped::firmware::telemetry_field_table[field].name, offsetof(TelemetrySampleLogRecord, fields) + field * sizeof(double), BinaryLogType::float64 });
+    }
+
+    return columns;
+}();
+}
+}
@@ -0,0 +1,39 @@
+#ifndef TELEMETRY_SAMPLE_LOG_H
+#define TELEMETRY_SAMPLE_LOG_H
+
+#include <array>
+#include <vector>
+
+#include "common/type.h"
+#include "utility/binary_log.h"
+
+namespace biped
+{
+namespace ground_station
+{
+/*
+ *  A sample log record, i.e., a telemetry sample, with its fields scaled back from their resolution, and NaN for the
+ *  fields the telemetry subscription left out, along with the sequence number and overflow of its telemetry frame.
+ */
+struct TelemetrySampleLogRecord
+{
+    std::array<double, biped::firmware::TelemetrySubscription::field_count> fields;
+    uint32_t overflow;
+    unsigned long long sequence;
+    uint32_t tick;
+
+    TelemetrySampleLogRecord() : fields(), overflow(0), sequence(0), tick(0)
+    {
+    }
+
+    TelemetrySampleLogRecord(const biped::firmware::TelemetryFrame& frame, const size_t& sample);
+};
+
+/*
+ *  Sample log columns, in the same order and with the same names as the text sample log.
+ */
+extern const std::vector<BinaryLogColumn> telemetry_sample_log_columns;
+}
+}
+
+#endif // TELEMETRY_SAMPLE_LOG_H